@@ -270,11 +270,29 @@ void Core2ForAWS_Sk6812_Clear(void) {
 
 SemaphoreHandle_t xGuiSemaphore;
 
+static TaskHandle_t gui_task_handle;
+
 static void guiTask(void *pvParameter);
+static void gui_resume(void);
+static TickType_t gui_wait_ticks(uint32_t wait_ms);
+#if LV_TICK_CUSTOM == 0
 static void lv_tick_task(void *arg);
+#endif
+
+#if LV_REFR_PARALLEL > 1
+static QueueHandle_t band_queue;
+
+static void bandTask(void *pvParameter);
+static void band_start(lv_disp_drv_t *drv, lv_refr_band_t *band);
+#endif
 
 #if CONFIG_SOFTWARE_FT6336U_SUPPORT
+static lv_indev_t *touch_indev;
+static volatile bool touch_event;
+
 static bool ft6336u_read(lv_indev_drv_t * drv, lv_indev_data_t * data);
+static void ft6336u_event(void);
+static void touch_read_update(void);
 #endif
 
 void Core2ForAWS_Display_Init(void) {
@@ -303,6 +321,16 @@ void Core2ForAWS_Display_Init(void) {
     lv_disp_drv_t disp_drv;
     lv_disp_drv_init(&disp_drv);
     disp_drv.flush_cb = disp_driver_flush;
+    disp_drv.flush_overhead = DISP_FLUSH_OVERHEAD;
+#if CONFIG_LV_DISP_FLUSH_FILTER
+    disp_drv.rounder_cb = disp_filter_rounder;
+#endif
+#if LV_REFR_PARALLEL > 1
+    /* The GUI task renders the first band of the refreshed areas on core 1, the band task the others on core 0 */
+    band_queue = xQueueCreate(LV_REFR_PARALLEL - 1, sizeof(lv_refr_band_t *));
+    xTaskCreatePinnedToCore(bandTask, "gui_band", 4096*2, NULL, 2, NULL, 0);
+    disp_drv.band_start_cb = band_start;
+#endif
 
     disp_drv.buffer = &disp_buf;
     lv_disp_drv_register(&disp_drv);
@@ -313,9 +341,11 @@ void Core2ForAWS_Display_Init(void) {
     lv_indev_drv_init(&indev_drv);
     indev_drv.read_cb = ft6336u_read;
     indev_drv.type = LV_INDEV_TYPE_POINTER;
-    lv_indev_drv_register(&indev_drv);
+    touch_indev = lv_indev_drv_register(&indev_drv);
+    FT6336U_SetEventCallback(ft6336u_event);
 #endif
 
+#if LV_TICK_CUSTOM == 0
     /* Create and start a periodic timer interrupt to call lv_tick_inc */
     const esp_timer_create_args_t periodic_timer_args = {
         .callback = &lv_tick_task,
@@ -324,10 +354,14 @@ void Core2ForAWS_Display_Init(void) {
     esp_timer_handle_t periodic_timer;
     ESP_ERROR_CHECK(esp_timer_create(&periodic_timer_args, &periodic_timer));
     ESP_ERROR_CHECK(esp_timer_start_periodic(periodic_timer, LV_TICK_PERIOD_MS * 1000));
+#endif
+
+    /* Wake up the GUI task when an LVGL task has to run earlier, e.g. after an invalidation */
+    lv_task_set_resume_cb(gui_resume);
 
     xSemaphoreGive(xGuiSemaphore);
 
-    xTaskCreatePinnedToCore(guiTask, "gui", 4096*2, NULL, 2, NULL, 1);
+    xTaskCreatePinnedToCore(guiTask, "gui", 4096*2, NULL, 2, &gui_task_handle, 1);
 }
 
 void Core2ForAWS_Display_SetBrightness(uint8_t brightness) {
@@ -354,35 +388,124 @@ static bool ft6336u_read(lv_indev_drv_t * drv, lv_indev_data_t * data) {
     data->state = valid == false ? LV_INDEV_STATE_REL : LV_INDEV_STATE_PR;
     return false;
 }
+
+/* Called by the FT6336U task when it has read new touch data */
+static void ft6336u_event(void) {
+    touch_event = true;
+    if (gui_task_handle != NULL) {
+        xTaskNotifyGive(gui_task_handle);
+    }
+}
+
+/**
+ * Poll the touch screen only while it's used. The read task is turned off
+ * when the screen is released and turned on again by the next touch event.
+ * Must be called with xGuiSemaphore taken.
+ */
+static void touch_read_update(void) {
+    lv_task_t *read_task = touch_indev->driver.read_task;
+    if (touch_event) {
+        touch_event = false;
+        lv_task_set_prio(read_task, LV_TASK_PRIO_HIGH);
+        lv_task_ready(read_task);
+    } else if (touch_indev->proc.state == LV_INDEV_STATE_REL &&
+               touch_indev->proc.types.pointer.drag_throw_vect.x == 0 &&
+               touch_indev->proc.types.pointer.drag_throw_vect.y == 0 &&
+               FT6336U_WasPressed() == false) {
+        /* The release is processed and nothing is scrolling anymore */
+        lv_task_set_prio(read_task, LV_TASK_PRIO_OFF);
+    }
+}
 #endif
 
+#if LV_TICK_CUSTOM == 0
 static void lv_tick_task(void *arg) {
     (void) arg;
     lv_tick_inc(LV_TICK_PERIOD_MS);
 }
+#endif
+
+#if LV_REFR_PARALLEL > 1
+/* Called by the GUI task to render a band on the other core */
+static void band_start(lv_disp_drv_t *drv, lv_refr_band_t *band) {
+    (void) drv;
+    xQueueSend(band_queue, &band, portMAX_DELAY);
+}
+
+/**
+ * @brief The FreeRTOS task that renders the bands started by the GUI task
+ *
+ * The GUI task waits until the band is rendered so the band task
+ * can use LVGL without taking xGuiSemaphore.
+ */
+static void bandTask(void *pvParameter) {
+    (void) pvParameter;
+
+    lv_refr_band_t *band;
+    while (1) {
+        if (xQueueReceive(band_queue, &band, portMAX_DELAY) == pdTRUE) {
+            lv_refr_band_render(band);
+        }
+    }
+
+    /* A task should NEVER return */
+    vTaskDelete(NULL);
+}
+#endif
+
+static void gui_resume(void) {
+    if (gui_task_handle != NULL) {
+        xTaskNotifyGive(gui_task_handle);
+    }
+}
+
+/* Convert the time returned by lv_task_handler to ticks to wait, at least 1 to let other tasks run */
+static TickType_t gui_wait_ticks(uint32_t wait_ms) {
+    if (wait_ms == LV_NO_TASK_READY) {
+        return portMAX_DELAY;
+    }
+    TickType_t ticks = (wait_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+    return ticks > 0 ? ticks : 1;
+}
 
 /**
- * @brief The FreeRTOS task that periodically calls lv_task_handler
+ * @brief The FreeRTOS task that calls lv_task_handler when an LVGL task is due
  * 
  * A FreeRTOS task function that calls [lv_task_handler](https://docs.lvgl.io/7.11/porting/task-handler.html)
- * after a tick (depends on task prioritization), which executes 
- * LVGL tasks to then pass to the display controller. Learn more 
- * about LVGL Tasks[https://docs.lvgl.io/7.11/overview/task.html].
+ * which executes LVGL tasks to then pass to the display controller. It sleeps
+ * until the next LVGL task is due or it's woken up by an invalidation, a new
+ * task or a touch. Learn more about LVGL Tasks[https://docs.lvgl.io/7.11/overview/task.html].
  */
 static void guiTask(void *pvParameter) {
     
     (void) pvParameter;
 
+    disp_spi_reset_stats();
 
+    uint32_t wait_ms = 0;
     while (1) {
-        /* Delay 1 tick (assumes FreeRTOS tick is 10ms */
-        vTaskDelay(pdMS_TO_TICKS(10));
+        /* Sleep until the next LVGL task is due or something wakes up the task */
+        ulTaskNotifyTake(pdTRUE, gui_wait_ticks(wait_ms));
 
         /* Try to take the semaphore, call lvgl related function on success */
         if (pdTRUE == xSemaphoreTake(xGuiSemaphore, portMAX_DELAY)) {
-            lv_task_handler();
+#if CONFIG_SOFTWARE_FT6336U_SUPPORT
+            touch_read_update();
+#endif
+            wait_ms = lv_task_handler();
             xSemaphoreGive(xGuiSemaphore);
        }
+
+        /* Log the display frame rate every 5 seconds at debug level */
+        disp_spi_stats_t stats;
+        disp_spi_get_stats(&stats);
+        int64_t elapsed_us = esp_timer_get_time() - stats.start_us;
+        if (elapsed_us >= 5000000) {
+            ESP_LOGD(TAG, "Display: %.1f fps, %u flushes, %u KB, SPI busy %u ms, wait %u ms",
+                     stats.frames * 1000000.0 / elapsed_us, stats.flushes, stats.bytes / 1024,
+                     stats.busy_us / 1000, stats.wait_us / 1000);
+            disp_spi_reset_stats();
+        }
     }
 
     /* A task should NEVER return */
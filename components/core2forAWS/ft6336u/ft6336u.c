@@ -16,6 +16,7 @@ static bool _pressed;
 static I2CDevice_t ft6336u_i2c;
 static xTaskHandle ft6336_task_handle;
 static SemaphoreHandle_t thread_mutex;
+static FT6336U_EventCallback_t event_callback;
 
 static void IRAM_ATTR FT6336U_ISRHandler(void* arg);
 static void FT6336U_UpdateTask(void *arg);
@@ -55,6 +56,10 @@ static void FT6336U_UpdateTask(void *arg) {
         press_stash = _pressed;
         xSemaphoreGive(thread_mutex);
 
+        if (event_callback != NULL) {
+            event_callback();
+        }
+
         if (press_stash == false) {
             vTaskSuspend(NULL);
         } else {
@@ -63,6 +68,10 @@ static void FT6336U_UpdateTask(void *arg) {
     }
 }
 
+void FT6336U_SetEventCallback(FT6336U_EventCallback_t callback) {
+    event_callback = callback;
+}
+
 void FT6336U_GetTouch(uint16_t* x, uint16_t* y, bool* press_down) {
     xSemaphoreTake(thread_mutex, portMAX_DELAY);
     *x = _x;
@@ -26,6 +26,24 @@
 void FT6336U_Init();
 /* @[declare_ft6336_init] */
 
+/**
+ * @brief Type of the function called when new touch data is read.
+ */
+typedef void (*FT6336U_EventCallback_t)(void);
+
+/**
+ * @brief Sets a function to call each time new touch data is read.
+ *
+ * It's called from the `FT6336Task` after a press, after every 20 ticks
+ * while the screen is pressed and once more after the release. Use it to
+ * wake up a task instead of polling the touch state.
+ *
+ * @param[in] callback The function to call or NULL.
+ */
+/* @[declare_ft6336_seteventcallback] */
+void FT6336U_SetEventCallback(FT6336U_EventCallback_t callback);
+/* @[declare_ft6336_seteventcallback] */
+
 /**
  * @brief Retrieves the most recent touch data from the FT6336U.
  * 
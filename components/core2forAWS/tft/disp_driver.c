@@ -14,6 +14,10 @@ void disp_driver_init(void) {
 }
 
 void disp_driver_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_map) {
+#if CONFIG_LV_DISP_FLUSH_FILTER
+    disp_filter_flush(drv, area, color_map, ili9341_flush_window);
+#else
     ili9341_flush(drv, area, color_map);
+#endif
 }
 
@@ -0,0 +1,155 @@
+/**
+ * @file disp_filter.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+
+#include "disp_filter.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TILE_MASK   (DISP_FILTER_TILE_SIZE - 1)
+#define TILE_COLS   ((LV_HOR_RES_MAX + TILE_MASK) / DISP_FILTER_TILE_SIZE)
+#define TILE_ROWS   ((LV_VER_RES_MAX + TILE_MASK) / DISP_FILTER_TILE_SIZE)
+
+#define HASH_UNKNOWN    0   /*The content of the tile on the display is not known*/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t hash_tile(const lv_color_t * color_p, lv_coord_t stride, lv_coord_t w, lv_coord_t h);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t tile_hash[TILE_ROWS][TILE_COLS];
+static disp_filter_stats_t filter_stats;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void disp_filter_rounder(lv_disp_drv_t * drv, lv_area_t * area)
+{
+    area->x1 &= ~TILE_MASK;
+    area->y1 &= ~TILE_MASK;
+    area->x2 = LV_MATH_MIN(area->x2 | TILE_MASK, drv->hor_res - 1);
+    area->y2 = LV_MATH_MIN(area->y2 | TILE_MASK, drv->ver_res - 1);
+}
+
+void disp_filter_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_map,
+                       disp_filter_send_cb_t send_cb)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_color_t * write_p = color_map;   /*The windows are compacted here, never after the rows to read*/
+    lv_area_t win;
+    lv_color_t * win_map = NULL;        /*The window is sent when the next one can't extend it*/
+    uint32_t px_sent = 0;
+    lv_coord_t band_y1;
+
+    for(band_y1 = area->y1; band_y1 <= area->y2; band_y1 = (band_y1 | TILE_MASK) + 1) {
+        lv_coord_t band_y2 = LV_MATH_MIN(band_y1 | TILE_MASK, area->y2);
+        lv_coord_t ty = band_y1 / DISP_FILTER_TILE_SIZE;
+        lv_coord_t changed_x1 = LV_COORD_MAX;
+        lv_coord_t changed_x2 = LV_COORD_MIN;
+        lv_coord_t tile_x1;
+
+        /*Find the changed tiles of the band*/
+        for(tile_x1 = area->x1; tile_x1 <= area->x2; tile_x1 = (tile_x1 | TILE_MASK) + 1) {
+            lv_coord_t tile_x2 = LV_MATH_MIN(tile_x1 | TILE_MASK, area->x2);
+            lv_coord_t tx = tile_x1 / DISP_FILTER_TILE_SIZE;
+
+            /*A partly flushed tile can't be compared*/
+            uint32_t hash = HASH_UNKNOWN;
+            bool full = (tile_x1 & TILE_MASK) == 0 && (band_y1 & TILE_MASK) == 0 &&
+                        (tile_x2 == (tile_x1 | TILE_MASK) || tile_x2 == drv->hor_res - 1) &&
+                        (band_y2 == (band_y1 | TILE_MASK) || band_y2 == drv->ver_res - 1);
+            if(full) {
+                hash = hash_tile(&color_map[(band_y1 - area->y1) * w + tile_x1 - area->x1], w,
+                                 tile_x2 - tile_x1 + 1, band_y2 - band_y1 + 1);
+            }
+
+            if(hash == HASH_UNKNOWN || hash != tile_hash[ty][tx]) {
+                changed_x1 = LV_MATH_MIN(changed_x1, tile_x1);
+                changed_x2 = tile_x2;
+            }
+            tile_hash[ty][tx] = hash;
+        }
+
+        if(changed_x1 > changed_x2) continue;
+
+        /*Extend the window if it's right above with the same width or start a new one*/
+        if(win_map && win.x1 == changed_x1 && win.x2 == changed_x2 && win.y2 + 1 == band_y1) {
+            win.y2 = band_y2;
+        }
+        else {
+            if(win_map) {
+                send_cb(&win, win_map, false);
+                filter_stats.windows++;
+            }
+            win.x1 = changed_x1;
+            win.x2 = changed_x2;
+            win.y1 = band_y1;
+            win.y2 = band_y2;
+            win_map = write_p;
+        }
+
+        /*Compact the rows of the window after the previous ones*/
+        lv_coord_t win_w = changed_x2 - changed_x1 + 1;
+        lv_coord_t y;
+        for(y = band_y1; y <= band_y2; y++) {
+            const lv_color_t * read_p = &color_map[(y - area->y1) * w + changed_x1 - area->x1];
+            if(read_p != write_p) memmove(write_p, read_p, win_w * sizeof(lv_color_t));
+            write_p += win_w;
+        }
+        px_sent += (uint32_t)win_w * (band_y2 - band_y1 + 1);
+    }
+
+    filter_stats.px_sent += px_sent;
+    filter_stats.px_skipped += lv_area_get_size(area) - px_sent;
+
+    if(win_map) {
+        send_cb(&win, win_map, true);
+        filter_stats.windows++;
+    }
+    else {
+        lv_disp_flush_ready(drv);
+    }
+}
+
+void disp_filter_invalidate(void)
+{
+    memset(tile_hash, 0, sizeof(tile_hash));
+}
+
+void disp_filter_get_stats(disp_filter_stats_t * stats)
+{
+    memcpy(stats, &filter_stats, sizeof(filter_stats));
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * FNV-1a hash of the pixels of a tile. Never returns `HASH_UNKNOWN`.
+ */
+static uint32_t hash_tile(const lv_color_t * color_p, lv_coord_t stride, lv_coord_t w, lv_coord_t h)
+{
+    uint32_t hash = 2166136261u;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            hash = (hash ^ color_p[x].full) * 16777619u;
+        }
+        color_p += stride;
+    }
+
+    return hash == HASH_UNKNOWN ? 1 : hash;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file disp_filter.h
+ *
+ * Flush filter which sends only the tiles that changed since they were last
+ * sent to the display. The last sent frame is remembered as a 32-bit hash per
+ * tile.
+ */
+
+#ifndef DISP_FILTER_H
+#define DISP_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdbool.h>
+
+#include "lvgl/lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define DISP_FILTER_TILE_SIZE  16   /*Has to be a power of 2*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/* Send a window of the display. `last`: the flush is done when this window is sent */
+typedef void (*disp_filter_send_cb_t)(const lv_area_t * area, lv_color_t * color_map, bool last);
+
+typedef struct _disp_filter_stats_t {
+    uint32_t px_sent;       /* Pixels sent to the display */
+    uint32_t px_skipped;    /* Pixels of the flushed areas which were not sent */
+    uint32_t windows;       /* Windows sent */
+} disp_filter_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/* Rounder callback which aligns the invalidated areas to the tiles */
+void disp_filter_rounder(lv_disp_drv_t * drv, lv_area_t * area);
+
+/* Send the changed tiles of a flushed area with `send_cb`, one window per band of tiles.
+ * The windows are compacted into `color_map`. If nothing changed the flush is ready immediately. */
+void disp_filter_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_map,
+                       disp_filter_send_cb_t send_cb);
+
+/* Forget the sent frame, e.g. when the display was written by something else */
+void disp_filter_invalidate(void);
+
+void disp_filter_get_stats(disp_filter_stats_t * stats);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*DISP_FILTER_H*/
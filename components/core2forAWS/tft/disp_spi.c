@@ -4,6 +4,7 @@
  */
 
 #include "esp_system.h"
+#include "esp_timer.h"
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
 
@@ -20,18 +21,31 @@
 
 SemaphoreHandle_t spi_mutex;
 
+static void IRAM_ATTR spi_pre (spi_transaction_t *trans);
 static void IRAM_ATTR spi_ready (spi_transaction_t *trans);
+static void disp_spi_fill_trans(spi_transaction_ext_t *t, const uint8_t *data, size_t length,
+    disp_spi_send_flag_t flags, disp_spi_read_data *out, uint64_t addr);
+static void disp_spi_wait_pending(uint8_t max_pending);
 
 static spi_host_device_t spi_host;
 static spi_device_handle_t spi;
 static volatile uint8_t spi_pending_trans = 0;
+static transaction_cb_t chained_pre_cb;
 static transaction_cb_t chained_post_cb;
 
+static int dc_gpio = -1;
+static spi_transaction_ext_t queued_batch[2][DISP_SPI_QUEUE_SIZE];
+static uint8_t queued_batch_act;
+static uint8_t queued_batch_cnt;
+static volatile bool batch_bus_held;
+static int64_t batch_start_us;
+static disp_spi_stats_t flush_stats;
+
 static uint8_t tft_used_spi_dma = 0;
 
 #define CONFIG_LV_DISP_SPI_CS   5
 
-void spi_poll() {
+void spi_poll(void) {
     if (!tft_used_spi_dma) {
         return ;
     }
@@ -48,7 +62,9 @@ void spi_poll() {
 
 void disp_spi_add_device_config(spi_host_device_t host, spi_device_interface_config_t *devcfg) {
     spi_host=host;
+    chained_pre_cb=devcfg->pre_cb;
     chained_post_cb=devcfg->post_cb;
+    devcfg->pre_cb=spi_pre;
     devcfg->post_cb=spi_ready;
     esp_err_t ret=spi_bus_add_device(host, devcfg, &spi);
     assert(ret==ESP_OK);
@@ -65,7 +81,7 @@ void disp_spi_add_device(spi_host_device_t host) {
         .mode = 0,
         .spics_io_num=CONFIG_LV_DISP_SPI_CS,              // CS pin
         .input_delay_ns=0,
-        .queue_size=1,
+        .queue_size=2 * DISP_SPI_QUEUE_SIZE,
         .pre_cb=NULL,
         .post_cb=NULL,
         .flags = SPI_DEVICE_NO_DUMMY,
@@ -84,40 +100,8 @@ void disp_spi_transaction(const uint8_t *data, size_t length,
     /* Wait for previous pending transaction results */
     disp_wait_for_pending_transactions();
 
-    spi_transaction_ext_t t = {0};
-
-    /* transaction length is in bits */
-    t.base.length = length * 8;
-
-    if (length <= 4 && data != NULL) {
-        t.base.flags = SPI_TRANS_USE_TXDATA;
-        memcpy(t.base.tx_data, data, length);
-    } else {
-        t.base.tx_buffer = data;
-    }
-
-    if (flags & DISP_SPI_RECEIVE) {
-        assert(out != NULL && (flags & (DISP_SPI_SEND_POLLING | DISP_SPI_SEND_SYNCHRONOUS)));
-        t.base.rx_buffer = out;
-        t.base.rxlength = 0; /* default, same as tx length */
-    }
-
-    if (flags & DISP_SPI_ADDRESS_8) {
-        t.address_bits = 8;
-    } else if (flags & DISP_SPI_ADDRESS_16) {
-        t.address_bits = 16;
-    } else if (flags & DISP_SPI_ADDRESS_24) {
-        t.address_bits = 24;
-    } else if (flags & DISP_SPI_ADDRESS_32) {
-        t.address_bits = 32;
-    }
-    if (t.address_bits) {
-        t.base.addr = addr;
-        t.base.flags |= SPI_TRANS_VARIABLE_ADDR;
-    }
-
-    /* Save flags for pre/post transaction processing */
-    t.base.user = (void *) flags;
+    spi_transaction_ext_t t;
+    disp_spi_fill_trans(&t, data, length, flags, out, addr);
 
     xSemaphoreTake(spi_mutex, portMAX_DELAY);
     spi_device_acquire_bus(spi, portMAX_DELAY);
@@ -137,6 +121,8 @@ void disp_spi_transaction(const uint8_t *data, size_t length,
     } else {
         static spi_transaction_ext_t queuedt;
         memcpy(&queuedt, &t, sizeof t);
+        batch_bus_held = true;
+        batch_start_us = esp_timer_get_time();
         spi_pending_trans++;
         if (spi_device_queue_trans(spi, (spi_transaction_t *) &queuedt, portMAX_DELAY) != ESP_OK) {
             spi_pending_trans--; /* Clear wait state */
@@ -144,14 +130,134 @@ void disp_spi_transaction(const uint8_t *data, size_t length,
     }
 }
 
+void disp_spi_queue_batch(const disp_spi_trans_t *trans, size_t count) {
+    spi_transaction_ext_t *batch;
+    size_t i;
+
+    assert(count > 0 && count <= DISP_SPI_QUEUE_SIZE);
+
+    /* Two sets of descriptors: the previous batch can be still on the bus while the other set is filled.
+     * The older batch which used this set is done once only the previous one is pending. */
+    disp_spi_wait_pending(queued_batch_cnt);
+    queued_batch_act ^= 1;
+    queued_batch_cnt = 0;
+    batch = queued_batch[queued_batch_act];
+
+    for (i = 0; i < count; i++) {
+        disp_spi_fill_trans(&batch[i], trans[i].data, trans[i].length, trans[i].flags, NULL, 0);
+        flush_stats.bytes += trans[i].length;
+    }
+
+    if (trans[count - 1].flags & DISP_SPI_SIGNAL_FLUSH) {
+        lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+        if (disp && lv_disp_flush_is_last(&disp->driver)) {
+            flush_stats.frames++;
+        }
+    }
+
+    /* Released by spi_ready() when the last transaction of a flush completes */
+    if (!batch_bus_held) {
+        xSemaphoreTake(spi_mutex, portMAX_DELAY);
+        spi_device_acquire_bus(spi, portMAX_DELAY);
+        gpio_set_level(CONFIG_LV_DISP_SPI_CS, 0);
+        batch_bus_held = true;
+        batch_start_us = esp_timer_get_time();
+    }
+
+    for (i = 0; i < count; i++) {
+        if (trans[i].length == 0) {
+            continue;
+        }
+        spi_pending_trans++;
+        if (spi_device_queue_trans(spi, (spi_transaction_t *) &batch[i], portMAX_DELAY) != ESP_OK) {
+            spi_pending_trans--; /* Clear wait state */
+        } else {
+            queued_batch_cnt++;
+        }
+    }
+}
+
+void disp_spi_set_dc_gpio(int gpio) {
+    dc_gpio = gpio;
+}
+
+void disp_spi_get_stats(disp_spi_stats_t *stats) {
+    memcpy(stats, &flush_stats, sizeof flush_stats);
+}
+
+void disp_spi_reset_stats(void) {
+    memset(&flush_stats, 0, sizeof flush_stats);
+    flush_stats.start_us = esp_timer_get_time();
+}
+
 void disp_wait_for_pending_transactions(void) {
+    disp_spi_wait_pending(0);
+}
+
+static void disp_spi_wait_pending(uint8_t max_pending) {
     spi_transaction_t *presult;
 
-    while (spi_pending_trans) {
+    if (spi_pending_trans <= max_pending) {
+        return;
+    }
+
+    int64_t wait_start_us = esp_timer_get_time();
+    while (spi_pending_trans > max_pending) {
         if (spi_device_get_trans_result(spi, &presult, portMAX_DELAY) == ESP_OK) {
             spi_pending_trans--;
         }
     }
+    flush_stats.wait_us += esp_timer_get_time() - wait_start_us;
+}
+
+static void disp_spi_fill_trans(spi_transaction_ext_t *t, const uint8_t *data, size_t length,
+    disp_spi_send_flag_t flags, disp_spi_read_data *out, uint64_t addr) {
+    memset(t, 0, sizeof *t);
+
+    /* transaction length is in bits */
+    t->base.length = length * 8;
+
+    if (length <= 4 && data != NULL) {
+        t->base.flags = SPI_TRANS_USE_TXDATA;
+        memcpy(t->base.tx_data, data, length);
+    } else {
+        t->base.tx_buffer = data;
+    }
+
+    if (flags & DISP_SPI_RECEIVE) {
+        assert(out != NULL && (flags & (DISP_SPI_SEND_POLLING | DISP_SPI_SEND_SYNCHRONOUS)));
+        t->base.rx_buffer = out;
+        t->base.rxlength = 0; /* default, same as tx length */
+    }
+
+    if (flags & DISP_SPI_ADDRESS_8) {
+        t->address_bits = 8;
+    } else if (flags & DISP_SPI_ADDRESS_16) {
+        t->address_bits = 16;
+    } else if (flags & DISP_SPI_ADDRESS_24) {
+        t->address_bits = 24;
+    } else if (flags & DISP_SPI_ADDRESS_32) {
+        t->address_bits = 32;
+    }
+    if (t->address_bits) {
+        t->base.addr = addr;
+        t->base.flags |= SPI_TRANS_VARIABLE_ADDR;
+    }
+
+    /* Save flags for pre/post transaction processing */
+    t->base.user = (void *) flags;
+}
+
+static void IRAM_ATTR spi_pre(spi_transaction_t *trans) {
+    disp_spi_send_flag_t flags = (disp_spi_send_flag_t) trans->user;
+
+    if (dc_gpio >= 0 && (flags & (DISP_SPI_DC_COMMAND | DISP_SPI_DC_DATA))) {
+        gpio_set_level(dc_gpio, (flags & DISP_SPI_DC_DATA) ? 1 : 0);
+    }
+
+    if (chained_pre_cb) {
+        chained_pre_cb(trans);
+    }
 }
 
 static void IRAM_ATTR spi_ready(spi_transaction_t *trans) {
@@ -159,22 +265,26 @@ static void IRAM_ATTR spi_ready(spi_transaction_t *trans) {
     int higher_priority_task_awoken = pdFALSE;
 
     if (flags & DISP_SPI_SIGNAL_FLUSH) {
+        flush_stats.flushes++;
+        flush_stats.busy_us += esp_timer_get_time() - batch_start_us;
+        tft_used_spi_dma = 1;
+
+        /* Release the bus before the next flush can start */
+        if (batch_bus_held) {
+            batch_bus_held = false;
+            gpio_set_level(CONFIG_LV_DISP_SPI_CS, 1);
+            spi_device_release_bus(spi);
+            xSemaphoreGiveFromISR(spi_mutex, &higher_priority_task_awoken);
+        }
+
         lv_disp_t * disp = NULL;
         disp = _lv_refr_get_disp_refreshing();
         lv_disp_flush_ready(&disp->driver);
-
     }
 
     if (chained_post_cb) {
         chained_post_cb(trans);
     }
 
-    if (flags & DISP_SPI_SIGNAL_FLUSH) {
-        tft_used_spi_dma = 1;
-        gpio_set_level(CONFIG_LV_DISP_SPI_CS, 1);
-        spi_device_release_bus(spi);
-        xSemaphoreGiveFromISR(spi_mutex, &higher_priority_task_awoken);
-    }
-
     if (higher_priority_task_awoken) portYIELD_FROM_ISR();
 }
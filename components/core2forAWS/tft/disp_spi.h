@@ -29,8 +29,30 @@ typedef enum _disp_spi_send_flag_t {
     DISP_SPI_MODE_DIO           = 0x00000400, /* Reserved */
     DISP_SPI_MODE_QIO           = 0x00000800, /* Reserved */
     DISP_SPI_MODE_DIOQIO_ADDR   = 0x00001000, /* Reserved */
+    DISP_SPI_DC_COMMAND         = 0x00002000, /* Drive the D/C line low before the transaction */
+    DISP_SPI_DC_DATA            = 0x00004000, /* Drive the D/C line high before the transaction */
 } disp_spi_send_flag_t;
 
+/* Number of transactions which can be queued at once, e.g. a whole flush */
+#define DISP_SPI_QUEUE_SIZE 6
+
+/* One transaction of a batch queued by disp_spi_queue_batch() */
+typedef struct _disp_spi_trans_t {
+    const uint8_t *data;
+    size_t length;
+    disp_spi_send_flag_t flags;
+} disp_spi_trans_t;
+
+/* Counters of the queued flushes since the last disp_spi_reset_stats() */
+typedef struct _disp_spi_stats_t {
+    uint32_t frames;        /* Flushes which were the last area of a refresh */
+    uint32_t flushes;       /* Completed flushes */
+    uint32_t bytes;         /* Bytes sent by the queued batches */
+    uint32_t busy_us;       /* Time from queuing a flush until its last transaction completed */
+    uint32_t wait_us;       /* Time spent waiting for the pending transactions */
+    int64_t start_us;       /* Time of the last reset */
+} disp_spi_stats_t;
+
 typedef struct _disp_spi_read_data {
     uint8_t _dummy_byte;
     union {
@@ -56,6 +78,30 @@ void disp_spi_transaction(const uint8_t *data, size_t length,
     disp_spi_send_flag_t flags, disp_spi_read_data *out, uint64_t addr);
 void disp_wait_for_pending_transactions(void);
 
+/**
+ * @brief Queues a batch of transactions without waiting for them to complete.
+ *
+ * The transactions are sent in order with the D/C line set by their
+ * DISP_SPI_DC_COMMAND or DISP_SPI_DC_DATA flag. The bus is kept for the next
+ * batches until a transaction with the DISP_SPI_SIGNAL_FLUSH flag completes:
+ * it releases the bus and calls lv_disp_flush_ready(). So the last batch of a
+ * flush has to end with such a transaction. Data up to 4 bytes is copied,
+ * longer data has to stay valid until then.
+ */
+void disp_spi_queue_batch(const disp_spi_trans_t *trans, size_t count);
+
+/**
+ * @brief Sets the GPIO used as the D/C line of the batched transactions.
+ */
+void disp_spi_set_dc_gpio(int gpio);
+
+/**
+ * @brief Reads the flush counters, e.g. to compute the frames per second as
+ * frames * 1000000 / (esp_timer_get_time() - start_us).
+ */
+void disp_spi_get_stats(disp_spi_stats_t *stats);
+void disp_spi_reset_stats(void);
+
 static inline void disp_spi_send_data(uint8_t *data, size_t length) {
     disp_spi_transaction(data, length, DISP_SPI_SEND_POLLING, NULL, 0);
 }
@@ -79,7 +125,7 @@ static inline void disp_spi_send_colors(uint8_t *data, size_t length) {
  * to repeatedly poll the SPI bus until the transaction completes.
  */
 /* @[declare_spi_poll] */
-void spi_poll();
+void spi_poll(void);
 /* @[declare_spi_poll] */
 
 
@@ -38,7 +38,6 @@ static void ili9341_set_orientation(uint8_t orientation);
 
 static void ili9341_send_cmd(uint8_t cmd);
 static void ili9341_send_data(void * data, uint16_t length);
-static void ili9341_send_color(void * data, uint16_t length);
 
 /**********************
  *  STATIC VARIABLES
@@ -85,6 +84,7 @@ void ili9341_init(void)
 	//Initialize non-SPI GPIOs
 	gpio_pad_select_gpio(ILI9341_DC);
 	gpio_set_direction(ILI9341_DC, GPIO_MODE_OUTPUT);
+	disp_spi_set_dc_gpio(ILI9341_DC);
 
 	//Reset the display
 	Axp192_SetGPIO4Level(0);
@@ -110,31 +110,29 @@ void ili9341_init(void)
 
 void ili9341_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_map)
 {
-	uint8_t data[4];
-
-	/*Column addresses*/
-	ili9341_send_cmd(0x2A);
-	data[0] = (area->x1 >> 8) & 0xFF;
-	data[1] = area->x1 & 0xFF;
-	data[2] = (area->x2 >> 8) & 0xFF;
-	data[3] = area->x2 & 0xFF;
-	ili9341_send_data(data, 4);
-
-	/*Page addresses*/
-	ili9341_send_cmd(0x2B);
-	data[0] = (area->y1 >> 8) & 0xFF;
-	data[1] = area->y1 & 0xFF;
-	data[2] = (area->y2 >> 8) & 0xFF;
-	data[3] = area->y2 & 0xFF;
-	ili9341_send_data(data, 4);
-
-	/*Memory write*/
-	ili9341_send_cmd(0x2C);
+	ili9341_flush_window(area, color_map, true);
+}
 
+void ili9341_flush_window(const lv_area_t * area, lv_color_t * color_map, bool last)
+{
+	uint8_t caset[4] = {(area->x1 >> 8) & 0xFF, area->x1 & 0xFF, (area->x2 >> 8) & 0xFF, area->x2 & 0xFF};
+	uint8_t paset[4] = {(area->y1 >> 8) & 0xFF, area->y1 & 0xFF, (area->y2 >> 8) & 0xFF, area->y2 & 0xFF};
+	uint8_t cmd[3] = {0x2A, 0x2B, 0x2C};
 
 	uint32_t size = lv_area_get_width(area) * lv_area_get_height(area);
 
-	ili9341_send_color((void*)color_map, size * 2);
+	/*Column addresses, page addresses and memory write are queued together so the
+	 *next area can be rendered while they are sent. The last one calls lv_disp_flush_ready.*/
+	disp_spi_trans_t trans[] = {
+		{&cmd[0], 1, DISP_SPI_DC_COMMAND},
+		{caset, 4, DISP_SPI_DC_DATA},
+		{&cmd[1], 1, DISP_SPI_DC_COMMAND},
+		{paset, 4, DISP_SPI_DC_DATA},
+		{&cmd[2], 1, DISP_SPI_DC_COMMAND},
+		{(uint8_t *)color_map, size * 2, DISP_SPI_DC_DATA | (last ? DISP_SPI_SIGNAL_FLUSH : 0)},
+	};
+
+	disp_spi_queue_batch(trans, sizeof(trans) / sizeof(trans[0]));
 }
 
 void ili9341_sleep_in()
@@ -170,13 +168,6 @@ static void ili9341_send_data(void * data, uint16_t length)
     disp_spi_send_data(data, length);
 }
 
-static void ili9341_send_color(void * data, uint16_t length)
-{
-    disp_wait_for_pending_transactions();
-    gpio_set_level(ILI9341_DC, 1);   /*Data mode*/
-    disp_spi_send_colors(data, length);
-}
-
 static void ili9341_set_orientation(uint8_t orientation)
 {
     // ESP_ASSERT(orientation < 4);
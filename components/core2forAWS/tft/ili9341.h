@@ -32,6 +32,8 @@ extern "C" {
 
 void ili9341_init(void);
 void ili9341_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_map);
+/*Send a window of a flush. `last`: the flush is done when this window is sent*/
+void ili9341_flush_window(const lv_area_t * area, lv_color_t * color_map, bool last);
 void ili9341_sleep_in(void);
 void ili9341_sleep_out(void);
 
@@ -101,6 +101,15 @@
  * Can be changed in the display driver (`lv_disp_drv_t`).*/
 #define LV_DISP_DEF_REFR_PERIOD CONFIG_LV_DISP_DEF_REFR_PERIOD   /*[ms]*/
 
+/* Split the refreshed areas into this many horizontal bands and render them in parallel.
+ * The display driver's `band_start_cb` needs to render the bands on an other core or thread.
+ * 0 or 1: render the areas in one piece*/
+#if defined CONFIG_LV_REFR_PARALLEL
+    #define LV_REFR_PARALLEL        CONFIG_LV_REFR_PARALLEL
+#else
+    #define LV_REFR_PARALLEL        0
+#endif
+
 /* Dot Per Inch: used to initialize default sizes.
  * E.g. a button with width = LV_DPI / 2 -> half inch wide
  * (Not so important, you can adjust it to modify default sizes and spaces)*/
@@ -128,10 +137,14 @@ typedef int16_t lv_coord_t;
  * The graphical objects and other related data are stored here. */
 
 /* 1: use custom malloc/free, 0: use the built-in `lv_mem_alloc` and `lv_mem_free` */
-#define LV_MEM_CUSTOM      1
+#if defined CONFIG_LV_MEM_TLSF
+#  define LV_MEM_CUSTOM      0
+#else
+#  define LV_MEM_CUSTOM      1
+#endif
 #if LV_MEM_CUSTOM == 0
 /* Size of the memory used by `lv_mem_alloc` in bytes (>= 2kB)*/
-#  define LV_MEM_SIZE    ( CONFIG_LV_MEM_SIZE * 1024U)
+#  define LV_MEM_SIZE    ( CONFIG_LV_MEM_SIZE_BYTES * 1024U)
 
 /* Complier prefix for a big array declaration */
 #  define LV_MEM_ATTR
@@ -142,6 +155,16 @@ typedef int16_t lv_coord_t;
 
 /* Automatically defrag. on free. Defrag. means joining the adjacent free cells. */
 #  define LV_MEM_AUTO_DEFRAG  1
+
+/* Manage the pool with the constant time TLSF allocator */
+#  define LV_MEM_TLSF         1
+
+/* Count the allocations per size class. See `lv_mem_get_class_stats()` */
+#  if defined CONFIG_LV_MEM_TLSF_STATS
+#    define LV_MEM_TLSF_STATS 1
+#  else
+#    define LV_MEM_TLSF_STATS 0
+#  endif
 #else       /*LV_MEM_CUSTOM*/
 #  define LV_MEM_CUSTOM_INCLUDE "freertos/FreeRTOS.h"   /*Header for the dynamic memory function*/
 #  define LV_MEM_CUSTOM_ALLOC   pvPortMalloc       /*Wrapper to malloc*/
@@ -187,6 +210,13 @@ typedef int16_t lv_coord_t;
 /* Gesture min velocity at release before swipe (pixels)*/
 #define LV_INDEV_DEF_GESTURE_MIN_VELOCITY CONFIG_LV_INDEV_DEF_GESTURE_MIN_VELOCITY
 
+/* Cell size of the grid used to find the pressed object [px], 0: disable */
+#if defined CONFIG_LV_INDEV_SEARCH_GRID
+    #define LV_INDEV_SEARCH_GRID          CONFIG_LV_INDEV_SEARCH_GRID
+#else
+    #define LV_INDEV_SEARCH_GRID          0
+#endif
+
 /*==================
  * Feature usage
  *==================*/
@@ -218,6 +248,14 @@ typedef void * lv_anim_user_data_t;
  * where shadow size is `shadow_width + radius`
  * Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
 #define LV_SHADOW_CACHE_SIZE    CONFIG_LV_SHADOW_CACHE_SIZE
+
+/* Bytes of static RAM for the cached corners (a corner takes `shadow size`^2 bytes).
+ * The least recently used corners are evicted to make room for new ones.*/
+#if defined CONFIG_LV_SHADOW_CACHE_BYTES
+    #define LV_SHADOW_CACHE_BYTES   CONFIG_LV_SHADOW_CACHE_BYTES
+#else
+    #define LV_SHADOW_CACHE_BYTES   (LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE)
+#endif
 #endif
 
 /* 1: Use other blend modes than normal (`LV_BLEND_MODE_...`)*/
@@ -227,6 +265,14 @@ typedef void * lv_anim_user_data_t;
     #define LV_USE_BLEND_MODES      0
 #endif
 
+/* Mix RGB565 pixels with faster kernels. The result is the same as with `lv_color_mix`.
+ * 1: two pixels in a 32-bit word (the ESP32 has no SIMD unit for it) */
+#if defined CONFIG_LV_USE_BLEND_FAST_565
+    #define LV_USE_BLEND_FAST_565   1
+#else
+    #define LV_USE_BLEND_FAST_565   0
+#endif
+
 /* 1: Use the `opa_scale` style property to set the opacity of an object and its children at once*/
 #if defined CONFIG_LV_FEATURE_USE_OPA_SCALE
     #define LV_USE_OPA_SCALE        1
@@ -292,6 +338,13 @@ typedef void * lv_fs_drv_user_data_t;
     #define LV_USE_PERF_MONITOR     0
 #endif
 
+/*Number of resolved style properties to remember (0: disable)*/
+#if defined CONFIG_LV_STYLE_CACHE_SIZE
+    #define LV_STYLE_CACHE_SIZE     CONFIG_LV_STYLE_CACHE_SIZE
+#else
+    #define LV_STYLE_CACHE_SIZE     0
+#endif
+
 /*1: Use the functions and types from the older API if possible */
 #if defined CONFIG_LV_FEATURE_USE_API_EXTENSION_V6
     #define LV_USE_API_EXTENSION_V6  1
@@ -325,6 +378,10 @@ typedef void * lv_fs_drv_user_data_t;
  * LV_IMG_CACHE_DEF_SIZE must be >= 1 */
 #define LV_IMG_CACHE_DEF_SIZE   CONFIG_LV_IMG_CACHE_DEF_SIZE
 
+/* Limit of the decoded data (in bytes) held by the cached images.
+ * 0: limit only the number of images */
+#define LV_IMG_CACHE_DEF_BYTES  CONFIG_LV_IMG_CACHE_DEF_BYTES
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_img_decoder_user_data_t;
 
@@ -353,6 +410,10 @@ typedef void * lv_img_decoder_user_data_t;
  * Uses 15-20 kB extra memory */
 #define LV_ATTRIBUTE_FAST_MEM
 
+/* Declare a variable with a separate instance in every thread.
+ * Only used with `LV_REFR_PARALLEL > 1` */
+#define LV_ATTRIBUTE_THREAD_LOCAL __thread
+
 /* Export integer constant to binding.
  * This macro is used with constants in the form of LV_<CONST> that
  * should also appear on lvgl binding API such as Micropython
@@ -554,6 +615,19 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
     #define LV_FONT_SUBPX_BGR    0
 #endif
 
+/*Number of glyphs in the glyph cache and the largest glyph (in pixels) whose decoded bitmap is cached*/
+#if defined CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+    #define LV_FONT_GLYPH_CACHE_SIZE    CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+#else
+    #define LV_FONT_GLYPH_CACHE_SIZE    0
+#endif
+
+#if defined CONFIG_LV_FONT_GLYPH_CACHE_MAX_PX
+    #define LV_FONT_GLYPH_CACHE_MAX_PX  CONFIG_LV_FONT_GLYPH_CACHE_MAX_PX
+#else
+    #define LV_FONT_GLYPH_CACHE_MAX_PX  0
+#endif
+
 /*Declare the type of the user data of fonts (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_font_user_data_t;
 
@@ -1095,6 +1169,14 @@ typedef void * lv_obj_user_data_t;
 
 #if LV_USE_CHART
 #  define LV_CHART_AXIS_TICK_LABEL_MAX_LEN    CONFIG_LV_WIDGETS_CHART_AXIS_MAX_LEN
+
+/* Draw only the first, last, min. and max. points of every pixel column of line series
+ * which have at least this many points per column. 0: don't decimate*/
+#if defined CONFIG_LV_CHART_DECIMATE
+    #define LV_CHART_DECIMATE   CONFIG_LV_CHART_DECIMATE
+#else
+    #define LV_CHART_DECIMATE   4
+#endif
 #endif
 
 /*Container (dependencies: -*/
@@ -1172,6 +1254,12 @@ typedef void * lv_obj_user_data_t;
     #define LV_LABEL_TEXT_SEL               0
 /*Store extra some info in labels (12 bytes) to speed up drawing of very long texts*/
     #define LV_LABEL_LONG_TXT_HINT          0
+/*Keep the line breaks of the text in labels to draw and measure them without measuring every letter again*/
+#if defined CONFIG_LV_LABEL_LAYOUT_CACHE
+    #define LV_LABEL_LAYOUT_CACHE           1
+#else
+    #define LV_LABEL_LAYOUT_CACHE           0
+#endif
 #endif
 
 /*LED (dependencies: -)*/
@@ -50,6 +50,11 @@
  * Can be changed in the display driver (`lv_disp_drv_t`).*/
 #define LV_DISP_DEF_REFR_PERIOD      30      /*[ms]*/
 
+/* Split the refreshed areas into this many horizontal bands and render them in parallel.
+ * The display driver's `band_start_cb` needs to render the bands on an other core or thread.
+ * 0 or 1: render the areas in one piece*/
+#define LV_REFR_PARALLEL             0
+
 /* Dot Per Inch: used to initialize default sizes.
  * E.g. a button with width = LV_DPI / 2 -> half inch wide
  * (Not so important, you can adjust it to modify default sizes and spaces)*/
@@ -94,6 +99,14 @@ typedef int16_t lv_coord_t;
 
 /* Automatically defrag. on free. Defrag. means joining the adjacent free cells. */
 #  define LV_MEM_AUTO_DEFRAG  1
+
+/* 1: Manage the pool with a TLSF (two-level segregated fit) allocator.
+ * Allocation and free take constant time and the free cells are always joined.
+ * 0: use the first-fit allocator which walks the cells of the pool. */
+#  define LV_MEM_TLSF         0
+
+/* 1: Count the allocations per size class (TLSF only). See `lv_mem_get_class_stats()` */
+#  define LV_MEM_TLSF_STATS   0
 #else       /*LV_MEM_CUSTOM*/
 #  define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
 #  define LV_MEM_CUSTOM_ALLOC   malloc       /*Wrapper to malloc*/
@@ -143,6 +156,11 @@ typedef int16_t lv_coord_t;
 /* Gesture min velocity at release before swipe (pixels)*/
 #define LV_INDEV_DEF_GESTURE_MIN_VELOCITY 3
 
+/* Size of the cells [px] of a grid which indexes the clickable objects of the screens
+ * to find the pressed object without testing every object of the screen.
+ * Uses 4 bytes per cell and 4 bytes per object and cell it covers. 0: disable*/
+#define LV_INDEV_SEARCH_GRID              32
+
 /*==================
  * Feature usage
  *==================*/
@@ -164,6 +182,9 @@ typedef void * lv_anim_user_data_t;
  * where shadow size is `shadow_width + radius`
  * Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
 #define LV_SHADOW_CACHE_SIZE    0
+/* Bytes of static RAM for the cached corners (a corner takes `shadow size`^2 bytes).
+ * The least recently used corners are evicted to make room for new ones.*/
+#define LV_SHADOW_CACHE_BYTES   (LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE)
 #endif
 
 /*1: enable outline drawing on rectangles*/
@@ -178,6 +199,12 @@ typedef void * lv_anim_user_data_t;
 /* 1: Use other blend modes than normal (`LV_BLEND_MODE_...`)*/
 #define LV_USE_BLEND_MODES      1
 
+/* Mix RGB565 pixels (LV_COLOR_DEPTH 16) with faster kernels. The result is the same as with `lv_color_mix`.
+ * 0: one pixel at a time
+ * 1: two pixels in a 32-bit word
+ * 2: SIMD (AVX2, SSE2 or NEON) if the compiler targets it, two pixels in a 32-bit word otherwise */
+#define LV_USE_BLEND_FAST_565   2
+
 /* 1: Use the `opa_scale` style property to set the opacity of an object and its children at once*/
 #define LV_USE_OPA_SCALE        1
 
@@ -223,6 +250,20 @@ typedef void * lv_fs_drv_user_data_t;
 /*1: Show CPU usage and FPS count in the right bottom corner*/
 #define LV_USE_PERF_MONITOR     0
 
+/*1: Measure the time spent in each phase of a refresh (invalidate/join, draw, blend, flush).
+ * The results can be read with `lv_refr_get_profile()`*/
+#define LV_USE_REFR_PROFILER    0
+#if LV_USE_REFR_PROFILER
+/*Expression evaluating to the current time in microseconds (uint32_t)*/
+#define LV_REFR_PROFILER_TIME_US  (lv_tick_get() * 1000)
+#endif
+
+/*Number of resolved style properties to remember (0: disable).
+ * A lookup which hits the cache doesn't walk the style lists of the object and its parents.
+ * The cache is invalidated by `lv_obj_refresh_style()`, so styles modified directly have to be reported.
+ * Every entry uses ~12 bytes of static RAM*/
+#define LV_STYLE_CACHE_SIZE     0
+
 /*1: Use the functions and types from the older API if possible */
 #define LV_USE_API_EXTENSION_V6  1
 #define LV_USE_API_EXTENSION_V7  1
@@ -245,6 +286,11 @@ typedef void * lv_fs_drv_user_data_t;
  * Set it to 0 to disable caching */
 #define LV_IMG_CACHE_DEF_SIZE       1
 
+/* Limit of the decoded data (in bytes) held by the cached images. Images whose decoder allocated
+ * a buffer are counted, the built-in decoder's variable images aren't.
+ * 0: limit only the number of images with `LV_IMG_CACHE_DEF_SIZE` */
+#define LV_IMG_CACHE_DEF_BYTES      0
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_img_decoder_user_data_t;
 
@@ -282,6 +328,10 @@ typedef void * lv_img_decoder_user_data_t;
  * Uses 15-20 kB extra memory */
 #define LV_ATTRIBUTE_FAST_MEM
 
+/* Declare a variable with a separate instance in every thread.
+ * Only used with `LV_REFR_PARALLEL > 1` */
+#define LV_ATTRIBUTE_THREAD_LOCAL __thread
+
 /* Export integer constant to binding.
  * This macro is used with constants in the form of LV_<CONST> that
  * should also appear on lvgl binding API such as Micropython
@@ -442,6 +492,14 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
 #define LV_FONT_SUBPX_BGR    0
 #endif
 
+/* Number of glyphs to cache (0: disable).
+ * The glyph IDs of the recently used letters of sparse character maps are cached. Compressed and 1/2 bpp glyphs
+ * are decoded into A8 bitmaps only once if they have at most `LV_FONT_GLYPH_CACHE_MAX_PX` pixels
+ * (0: cache only the glyph IDs). The bitmaps use SIZE * MAX_PX bytes of static RAM.
+ */
+#define LV_FONT_GLYPH_CACHE_SIZE    0
+#define LV_FONT_GLYPH_CACHE_MAX_PX  256
+
 /*Declare the type of the user data of fonts (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_font_user_data_t;
 
@@ -603,6 +661,9 @@ typedef void * lv_obj_user_data_t;
 #define LV_USE_CHART    1
 #if LV_USE_CHART
 #  define LV_CHART_AXIS_TICK_LABEL_MAX_LEN    256
+/* Draw only the first, last, min. and max. points of every pixel column of line series
+ * which have at least this many points per column. 0: don't decimate*/
+#  define LV_CHART_DECIMATE                   4
 #endif
 
 /*Container (dependencies: -*/
@@ -648,6 +709,10 @@ typedef void * lv_obj_user_data_t;
 
 /*Store extra some info in labels (12 bytes) to speed up drawing of very long texts*/
 #  define LV_LABEL_LONG_TXT_HINT          0
+
+/*Keep the line breaks of the text in labels to draw and measure them without measuring every letter again.
+ * Uses 32 bytes per label and 8 bytes per line of the text*/
+#  define LV_LABEL_LAYOUT_CACHE           1
 #endif
 
 /*LED (dependencies: -)*/
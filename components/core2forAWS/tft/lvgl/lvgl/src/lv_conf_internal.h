@@ -128,6 +128,17 @@
 #  endif
 #endif
 
+/* Split the refreshed areas into this many horizontal bands and render them in parallel.
+ * The display driver's `band_start_cb` needs to render the bands on an other core or thread.
+ * 0 or 1: render the areas in one piece*/
+#ifndef LV_REFR_PARALLEL
+#  ifdef CONFIG_LV_REFR_PARALLEL
+#    define LV_REFR_PARALLEL CONFIG_LV_REFR_PARALLEL
+#  else
+#    define  LV_REFR_PARALLEL             0
+#  endif
+#endif
+
 /* Dot Per Inch: used to initialize default sizes.
  * E.g. a button with width = LV_DPI / 2 -> half inch wide
  * (Not so important, you can adjust it to modify default sizes and spaces)*/
@@ -231,6 +242,26 @@
 #    define  LV_MEM_AUTO_DEFRAG  1
 #  endif
 #endif
+
+/* 1: Manage the pool with a TLSF (two-level segregated fit) allocator.
+ * Allocation and free take constant time and the free cells are always joined.
+ * 0: use the first-fit allocator which walks the cells of the pool. */
+#ifndef LV_MEM_TLSF
+#  ifdef CONFIG_LV_MEM_TLSF
+#    define LV_MEM_TLSF CONFIG_LV_MEM_TLSF
+#  else
+#    define  LV_MEM_TLSF         0
+#  endif
+#endif
+
+/* 1: Count the allocations per size class (TLSF only). See `lv_mem_get_class_stats()` */
+#ifndef LV_MEM_TLSF_STATS
+#  ifdef CONFIG_LV_MEM_TLSF_STATS
+#    define LV_MEM_TLSF_STATS CONFIG_LV_MEM_TLSF_STATS
+#  else
+#    define  LV_MEM_TLSF_STATS   0
+#  endif
+#endif
 #else       /*LV_MEM_CUSTOM*/
 #ifndef LV_MEM_CUSTOM_INCLUDE
 #  ifdef CONFIG_LV_MEM_CUSTOM_INCLUDE
@@ -370,6 +401,17 @@
 #  endif
 #endif
 
+/* Size of the cells [px] of a grid which indexes the clickable objects of the screens
+ * to find the pressed object without testing every object of the screen.
+ * Uses 4 bytes per cell and 4 bytes per object and cell it covers. 0: disable*/
+#ifndef LV_INDEV_SEARCH_GRID
+#  ifdef CONFIG_LV_INDEV_SEARCH_GRID
+#    define LV_INDEV_SEARCH_GRID CONFIG_LV_INDEV_SEARCH_GRID
+#  else
+#    define  LV_INDEV_SEARCH_GRID              32
+#  endif
+#endif
+
 /*==================
  * Feature usage
  *==================*/
@@ -408,6 +450,15 @@
 #    define  LV_SHADOW_CACHE_SIZE    0
 #  endif
 #endif
+/* Bytes of static RAM for the cached corners (a corner takes `shadow size`^2 bytes).
+ * The least recently used corners are evicted to make room for new ones.*/
+#ifndef LV_SHADOW_CACHE_BYTES
+#  ifdef CONFIG_LV_SHADOW_CACHE_BYTES
+#    define LV_SHADOW_CACHE_BYTES CONFIG_LV_SHADOW_CACHE_BYTES
+#  else
+#    define  LV_SHADOW_CACHE_BYTES   (LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE)
+#  endif
+#endif
 #endif
 
 /*1: enable outline drawing on rectangles*/
@@ -446,6 +497,18 @@
 #  endif
 #endif
 
+/* Mix RGB565 pixels (LV_COLOR_DEPTH 16) with faster kernels. The result is the same as with `lv_color_mix`.
+ * 0: one pixel at a time
+ * 1: two pixels in a 32-bit word
+ * 2: SIMD (AVX2, SSE2 or NEON) if the compiler targets it, two pixels in a 32-bit word otherwise */
+#ifndef LV_USE_BLEND_FAST_565
+#  ifdef CONFIG_LV_USE_BLEND_FAST_565
+#    define LV_USE_BLEND_FAST_565 CONFIG_LV_USE_BLEND_FAST_565
+#  else
+#    define  LV_USE_BLEND_FAST_565   2
+#  endif
+#endif
+
 /* 1: Use the `opa_scale` style property to set the opacity of an object and its children at once*/
 #ifndef LV_USE_OPA_SCALE
 #  ifdef CONFIG_LV_USE_OPA_SCALE
@@ -561,6 +624,38 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/*1: Measure the time spent in each phase of a refresh (invalidate/join, draw, blend, flush).
+ * The results can be read with `lv_refr_get_profile()`*/
+#ifndef LV_USE_REFR_PROFILER
+#  ifdef CONFIG_LV_USE_REFR_PROFILER
+#    define LV_USE_REFR_PROFILER CONFIG_LV_USE_REFR_PROFILER
+#  else
+#    define  LV_USE_REFR_PROFILER    0
+#  endif
+#endif
+#if LV_USE_REFR_PROFILER
+/*Expression evaluating to the current time in microseconds (uint32_t)*/
+#ifndef LV_REFR_PROFILER_TIME_US
+#  ifdef CONFIG_LV_REFR_PROFILER_TIME_US
+#    define LV_REFR_PROFILER_TIME_US CONFIG_LV_REFR_PROFILER_TIME_US
+#  else
+#    define  LV_REFR_PROFILER_TIME_US  (lv_tick_get() * 1000)
+#  endif
+#endif
+#endif
+
+/*Number of resolved style properties to remember (0: disable).
+ * A lookup which hits the cache doesn't walk the style lists of the object and its parents.
+ * The cache is invalidated by `lv_obj_refresh_style()`, so styles modified directly have to be reported.
+ * Every entry uses ~12 bytes of static RAM*/
+#ifndef LV_STYLE_CACHE_SIZE
+#  ifdef CONFIG_LV_STYLE_CACHE_SIZE
+#    define LV_STYLE_CACHE_SIZE CONFIG_LV_STYLE_CACHE_SIZE
+#  else
+#    define  LV_STYLE_CACHE_SIZE     0
+#  endif
+#endif
+
 /*1: Use the functions and types from the older API if possible */
 #ifndef LV_USE_API_EXTENSION_V6
 #  ifdef CONFIG_LV_USE_API_EXTENSION_V6
@@ -613,6 +708,17 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* Limit of the decoded data (in bytes) held by the cached images. Images whose decoder allocated
+ * a buffer are counted, the built-in decoder's variable images aren't.
+ * 0: limit only the number of images with `LV_IMG_CACHE_DEF_SIZE` */
+#ifndef LV_IMG_CACHE_DEF_BYTES
+#  ifdef CONFIG_LV_IMG_CACHE_DEF_BYTES
+#    define LV_IMG_CACHE_DEF_BYTES CONFIG_LV_IMG_CACHE_DEF_BYTES
+#  else
+#    define  LV_IMG_CACHE_DEF_BYTES      0
+#  endif
+#endif
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 
 /*=====================
@@ -697,6 +803,16 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* Declare a variable with a separate instance in every thread.
+ * Only used with `LV_REFR_PARALLEL > 1` */
+#ifndef LV_ATTRIBUTE_THREAD_LOCAL
+#  ifdef CONFIG_LV_ATTRIBUTE_THREAD_LOCAL
+#    define LV_ATTRIBUTE_THREAD_LOCAL CONFIG_LV_ATTRIBUTE_THREAD_LOCAL
+#  else
+#    define  LV_ATTRIBUTE_THREAD_LOCAL __thread
+#  endif
+#endif
+
 /* Export integer constant to binding.
  * This macro is used with constants in the form of LV_<CONST> that
  * should also appear on lvgl binding API such as Micropython
@@ -1137,6 +1253,26 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #endif
 #endif
 
+/* Number of glyphs to cache (0: disable).
+ * The glyph IDs of the recently used letters of sparse character maps are cached. Compressed and 1/2 bpp glyphs
+ * are decoded into A8 bitmaps only once if they have at most `LV_FONT_GLYPH_CACHE_MAX_PX` pixels
+ * (0: cache only the glyph IDs). The bitmaps use SIZE * MAX_PX bytes of static RAM.
+ */
+#ifndef LV_FONT_GLYPH_CACHE_SIZE
+#  ifdef CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+#    define LV_FONT_GLYPH_CACHE_SIZE CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+#  else
+#    define  LV_FONT_GLYPH_CACHE_SIZE    0
+#  endif
+#endif
+#ifndef LV_FONT_GLYPH_CACHE_MAX_PX
+#  ifdef CONFIG_LV_FONT_GLYPH_CACHE_MAX_PX
+#    define LV_FONT_GLYPH_CACHE_MAX_PX CONFIG_LV_FONT_GLYPH_CACHE_MAX_PX
+#  else
+#    define  LV_FONT_GLYPH_CACHE_MAX_PX  256
+#  endif
+#endif
+
 /*Declare the type of the user data of fonts (can be e.g. `void *`, `int`, `struct`)*/
 
 /*================
@@ -1548,6 +1684,15 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #    define  LV_CHART_AXIS_TICK_LABEL_MAX_LEN    256
 #  endif
 #endif
+/* Draw only the first, last, min. and max. points of every pixel column of line series
+ * which have at least this many points per column. 0: don't decimate*/
+#ifndef LV_CHART_DECIMATE
+#  ifdef CONFIG_LV_CHART_DECIMATE
+#    define LV_CHART_DECIMATE CONFIG_LV_CHART_DECIMATE
+#  else
+#    define  LV_CHART_DECIMATE                   4
+#  endif
+#endif
 #endif
 
 /*Container (dependencies: -*/
@@ -1677,6 +1822,16 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #    define  LV_LABEL_LONG_TXT_HINT          0
 #  endif
 #endif
+
+/*Keep the line breaks of the text in labels to draw and measure them without measuring every letter again.
+ * Uses 32 bytes per label and 8 bytes per line of the text*/
+#ifndef LV_LABEL_LAYOUT_CACHE
+#  ifdef CONFIG_LV_LABEL_LAYOUT_CACHE
+#    define LV_LABEL_LAYOUT_CACHE CONFIG_LV_LABEL_LAYOUT_CACHE
+#  else
+#    define  LV_LABEL_LAYOUT_CACHE           1
+#  endif
+#endif
 #endif
 
 /*LED (dependencies: -)*/
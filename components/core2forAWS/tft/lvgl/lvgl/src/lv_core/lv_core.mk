@@ -1,5 +1,6 @@
 CSRCS += lv_group.c
 CSRCS += lv_indev.c
+CSRCS += lv_indev_grid.c
 CSRCS += lv_disp.c
 CSRCS += lv_obj.c
 CSRCS += lv_refr.c
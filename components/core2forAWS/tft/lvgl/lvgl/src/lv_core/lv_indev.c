@@ -7,6 +7,7 @@
  *      INCLUDES
  ********************/
 #include "lv_indev.h"
+#include "lv_indev_grid.h"
 #include "lv_disp.h"
 #include "lv_obj.h"
 
@@ -65,6 +66,9 @@ static lv_obj_t * indev_obj_act = NULL;
  */
 void _lv_indev_init(void)
 {
+#if LV_INDEV_SEARCH_GRID
+    _lv_indev_grid_init();
+#endif
     lv_indev_reset(NULL, NULL); /*Reset all input devices*/
 }
 
@@ -1148,6 +1152,13 @@ lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t * point)
 {
     lv_obj_t * found_p = NULL;
 
+#if LV_INDEV_SEARCH_GRID
+    /*Look up only the objects around the point if the screen is indexed*/
+    if(lv_obj_get_parent(obj) == NULL && _lv_indev_grid_search(obj, point, &found_p)) {
+        return found_p;
+    }
+#endif
+
     /*If the point is on this object check its children too*/
     if(lv_obj_hittest(obj, point)) {
         lv_obj_t * i;
@@ -0,0 +1,321 @@
+/**
+ * @file lv_indev_grid.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_indev_grid.h"
+#include "../lv_misc/lv_debug.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_gc.h"
+
+#if LV_INDEV_SEARCH_GRID
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_indev_grid_t * grid_find(lv_obj_t * scr);
+static lv_indev_grid_t * grid_create(lv_obj_t * scr);
+static void grid_free(lv_indev_grid_t * grid);
+static bool grid_build(lv_indev_grid_t * grid);
+static void grid_add(lv_indev_grid_t * grid, lv_obj_t * obj, const lv_area_t * clip, bool fill);
+static bool obj_is_hit(lv_obj_t * obj, lv_point_t * point);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the list of the screens' grids
+ */
+void _lv_indev_grid_init(void)
+{
+    _lv_ll_init(&LV_GC_ROOT(_lv_indev_grid_ll), sizeof(lv_indev_grid_t));
+}
+
+/**
+ * Search the most top, clickable object by a point using the grid of a screen.
+ * The grid is built if the objects of the screen have changed.
+ * @param scr pointer to a screen (an object without parent)
+ * @param point pointer to a point for searching the most top child
+ * @param found store the found object or NULL here if there was no suitable object
+ * @return true: the grid was used; false: `found` is not set, the objects need to be searched one by one,
+ *         e.g. the grid is just being changed, there is not enough memory or the point is out of the screen
+ */
+bool _lv_indev_grid_search(lv_obj_t * scr, lv_point_t * point, lv_obj_t ** found)
+{
+    lv_indev_grid_t * grid = grid_find(scr);
+    if(grid == NULL) {
+        grid = grid_create(scr);
+        if(grid == NULL) return false;
+    }
+
+    if(grid->valid == 0) {
+        /*Build the grid only when the objects stopped changing to not rebuild it on every search
+         *while the screen is animated*/
+        if(grid->searched == 0) {
+            grid->searched = 1;
+            return false;
+        }
+
+        if(grid_build(grid) == false) return false;
+    }
+
+    if(_lv_area_is_point_on(&grid->area, point, 0) == false) return false;
+
+    uint32_t col = (point->x - grid->area.x1) / LV_INDEV_SEARCH_GRID;
+    uint32_t row = (point->y - grid->area.y1) / LV_INDEV_SEARCH_GRID;
+    uint32_t cell = row * grid->col_cnt + col;
+
+    /*The objects of the cell are in the order of the tree walk so the first hit is the result.
+     *The grid only tells which objects can be under the point, so test them exactly*/
+    uint32_t i;
+    for(i = grid->cell_start[cell]; i < grid->cell_start[cell + 1]; i++) {
+        if(obj_is_hit(grid->objs[i], point)) {
+            *found = grid->objs[i];
+            return true;
+        }
+    }
+
+    *found = NULL;
+    return true;
+}
+
+/**
+ * Mark the grid of an object's screen as outdated.
+ * Should be called when the object is created, deleted, moved, resized, hidden, moved to an other parent,
+ * or its z-order, clickability or hit-testing changes.
+ * @param obj pointer to an object
+ */
+void _lv_indev_grid_invalidate(lv_obj_t * obj)
+{
+    if(_lv_ll_is_empty(&LV_GC_ROOT(_lv_indev_grid_ll))) return;
+
+    lv_obj_t * scr = obj;
+    while(scr->parent) scr = scr->parent;
+
+    lv_indev_grid_t * grid = grid_find(scr);
+    if(grid) {
+        grid->valid = 0;
+        grid->searched = 0;
+    }
+}
+
+/**
+ * Free the grid of a screen. Should be called when the screen is deleted.
+ * @param scr pointer to a screen
+ */
+void _lv_indev_grid_remove(lv_obj_t * scr)
+{
+    lv_indev_grid_t * grid = grid_find(scr);
+    if(grid == NULL) return;
+
+    grid_free(grid);
+    _lv_ll_remove(&LV_GC_ROOT(_lv_indev_grid_ll), grid);
+    lv_mem_free(grid);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_indev_grid_t * grid_find(lv_obj_t * scr)
+{
+    lv_indev_grid_t * grid;
+    _LV_LL_READ(LV_GC_ROOT(_lv_indev_grid_ll), grid) {
+        if(grid->scr == scr) return grid;
+    }
+
+    return NULL;
+}
+
+/**
+ * Add an empty grid for a screen. Drop the least recently created grid if there are too many.
+ * @param scr pointer to a screen
+ * @return the new grid or NULL on out of memory
+ */
+static lv_indev_grid_t * grid_create(lv_obj_t * scr)
+{
+    if(_lv_ll_get_len(&LV_GC_ROOT(_lv_indev_grid_ll)) >= _LV_INDEV_GRID_NUM) {
+        lv_indev_grid_t * old = _lv_ll_get_tail(&LV_GC_ROOT(_lv_indev_grid_ll));
+        _lv_indev_grid_remove(old->scr);
+    }
+
+    lv_indev_grid_t * grid = _lv_ll_ins_head(&LV_GC_ROOT(_lv_indev_grid_ll));
+    LV_ASSERT_MEM(grid);
+    if(grid == NULL) return NULL;
+
+    _lv_memset_00(grid, sizeof(lv_indev_grid_t));
+    grid->scr = scr;
+
+    return grid;
+}
+
+static void grid_free(lv_indev_grid_t * grid)
+{
+    lv_mem_free(grid->objs);
+    lv_mem_free(grid->cell_start);
+    grid->objs = NULL;
+    grid->cell_start = NULL;
+    grid->objs_size = 0;
+    grid->cells_size = 0;
+    grid->valid = 0;
+}
+
+/**
+ * Collect the clickable objects of the screen into the cells of the grid
+ * @param grid pointer to a grid
+ * @return true: the grid is built; false: out of memory or the screen is too large
+ */
+static bool grid_build(lv_indev_grid_t * grid)
+{
+    lv_area_copy(&grid->area, &grid->scr->coords);
+
+    if(grid->area.x2 < grid->area.x1 || grid->area.y2 < grid->area.y1) return false;
+
+    uint32_t col_cnt = (lv_area_get_width(&grid->area) + LV_INDEV_SEARCH_GRID - 1) / LV_INDEV_SEARCH_GRID;
+    uint32_t row_cnt = (lv_area_get_height(&grid->area) + LV_INDEV_SEARCH_GRID - 1) / LV_INDEV_SEARCH_GRID;
+    if(col_cnt > UINT16_MAX || row_cnt > UINT16_MAX) return false;
+
+    grid->col_cnt = col_cnt;
+    grid->row_cnt = row_cnt;
+
+    uint32_t cell_cnt = col_cnt * row_cnt;
+    if(grid->cells_size < cell_cnt + 1) {
+        uint32_t * cell_start = lv_mem_realloc(grid->cell_start, (cell_cnt + 1) * sizeof(uint32_t));
+        if(cell_start == NULL) {
+            grid_free(grid);
+            return false;
+        }
+        grid->cell_start = cell_start;
+        grid->cells_size = cell_cnt + 1;
+    }
+
+    /*Count the objects of the cells and convert the counts to the index of the cells' first object*/
+    _lv_memset_00(grid->cell_start, (cell_cnt + 1) * sizeof(uint32_t));
+    grid_add(grid, grid->scr, &grid->area, false);
+
+    uint32_t c;
+    uint32_t sum = 0;
+    for(c = 0; c < cell_cnt; c++) {
+        uint32_t cnt = grid->cell_start[c];
+        grid->cell_start[c] = sum;
+        sum += cnt;
+    }
+    grid->cell_start[cell_cnt] = sum;
+
+    if(grid->objs_size < sum) {
+        lv_obj_t ** objs = lv_mem_realloc(grid->objs, sum * sizeof(lv_obj_t *));
+        if(objs == NULL) {
+            grid_free(grid);
+            return false;
+        }
+        grid->objs = objs;
+        grid->objs_size = sum;
+    }
+
+    /*Fill the cells. `cell_start` is used as a write index so it moves to the start of the next cell*/
+    grid_add(grid, grid->scr, &grid->area, true);
+    for(c = cell_cnt; c > 0; c--) {
+        grid->cell_start[c] = grid->cell_start[c - 1];
+    }
+    grid->cell_start[0] = 0;
+
+    grid->valid = 1;
+    return true;
+}
+
+/**
+ * Add an object and its children to the cells where they might be clicked.
+ * The objects are added in the order `lv_indev_search_obj()` visits them: the children first, top-most first.
+ * @param grid pointer to a grid
+ * @param obj pointer to an object
+ * @param clip the object can be clicked only in this area because the parents need to be hit too
+ * @param fill false: only count the objects of the cells; true: store the objects in the cells
+ */
+static void grid_add(lv_indev_grid_t * grid, lv_obj_t * obj, const lv_area_t * clip, bool fill)
+{
+    /*Neither the hidden objects nor their children can be clicked*/
+    if(obj->hidden) return;
+
+    /*The advanced hit-test can accept any point (e.g. the knob of a slider is larger than the slider)
+     *so it doesn't limit the area*/
+    lv_area_t area;
+    if(obj->adv_hittest) {
+        lv_area_copy(&area, clip);
+    }
+    else {
+        lv_area_t click_area;
+        click_area.x1 = obj->coords.x1 - lv_obj_get_ext_click_pad_left(obj);
+        click_area.x2 = obj->coords.x2 + lv_obj_get_ext_click_pad_right(obj);
+        click_area.y1 = obj->coords.y1 - lv_obj_get_ext_click_pad_top(obj);
+        click_area.y2 = obj->coords.y2 + lv_obj_get_ext_click_pad_bottom(obj);
+        if(_lv_area_intersect(&area, clip, &click_area) == false) return;
+    }
+
+    lv_obj_t * child;
+    _LV_LL_READ(obj->child_ll, child) {
+        grid_add(grid, child, &area, fill);
+    }
+
+    if(obj->click == 0) return;
+
+    uint32_t col1 = (area.x1 - grid->area.x1) / LV_INDEV_SEARCH_GRID;
+    uint32_t col2 = (area.x2 - grid->area.x1) / LV_INDEV_SEARCH_GRID;
+    uint32_t row1 = (area.y1 - grid->area.y1) / LV_INDEV_SEARCH_GRID;
+    uint32_t row2 = (area.y2 - grid->area.y1) / LV_INDEV_SEARCH_GRID;
+    uint32_t row;
+    uint32_t col;
+    for(row = row1; row <= row2; row++) {
+        uint32_t * cell_start = &grid->cell_start[row * grid->col_cnt];
+        for(col = col1; col <= col2; col++) {
+            if(fill) grid->objs[cell_start[col]] = obj;
+            cell_start[col]++;
+        }
+    }
+}
+
+/**
+ * Test an object with the same rules as `lv_indev_search_obj()`
+ * @param obj pointer to an object
+ * @param point pointer to a point
+ * @return true: `lv_indev_search_obj()` would find the object if there were no object above it
+ */
+static bool obj_is_hit(lv_obj_t * obj, lv_point_t * point)
+{
+    if(lv_obj_get_click(obj) == false) return false;
+
+    if(lv_obj_is_protected(obj, LV_PROTECT_EVENT_TO_DISABLED) == false &&
+       (lv_obj_get_state(obj, LV_OBJ_PART_MAIN) & LV_STATE_DISABLED)) {
+        return false;
+    }
+
+    /*The object and all of its parents need to be visible and under the point*/
+    lv_obj_t * i = obj;
+    while(i != NULL) {
+        if(lv_obj_get_hidden(i) || lv_obj_hittest(i, point) == false) return false;
+        i = lv_obj_get_parent(i);
+    }
+
+    return true;
+}
+
+#endif /*LV_INDEV_SEARCH_GRID*/
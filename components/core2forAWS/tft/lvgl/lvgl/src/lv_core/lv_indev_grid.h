@@ -0,0 +1,99 @@
+/**
+ * @file lv_indev_grid.h
+ *
+ */
+
+#ifndef LV_INDEV_GRID_H
+#define LV_INDEV_GRID_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj.h"
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Number of screens whose grid is kept: the system and top layer and the active screen*/
+#define _LV_INDEV_GRID_NUM  3
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Index of the clickable objects of a screen.
+ * The screen's area is divided to `LV_INDEV_SEARCH_GRID` sized cells and every cell lists
+ * the objects which might be clicked in it in the order `lv_indev_search_obj()` would find them.
+ */
+typedef struct {
+    lv_obj_t * scr;         /*The indexed screen*/
+    lv_obj_t ** objs;       /*The objects of the cells. The objects of a cell are stored together, top-most first*/
+    uint32_t * cell_start;  /*Index of the first object of every cell in `objs` and the number of objects at the end*/
+    uint32_t objs_size;     /*Allocated size of `objs` (number of objects)*/
+    uint32_t cells_size;    /*Allocated size of `cell_start` (number of cells + 1)*/
+    lv_area_t area;         /*The indexed area, the coordinates of the screen when the grid was built*/
+    uint16_t col_cnt;
+    uint16_t row_cnt;
+    uint8_t valid : 1;      /*The objects haven't changed since the grid was built*/
+    uint8_t searched : 1;   /*Searched since the objects have changed*/
+} lv_indev_grid_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_INDEV_SEARCH_GRID
+
+/**
+ * Initialize the list of the screens' grids
+ */
+void _lv_indev_grid_init(void);
+
+/**
+ * Search the most top, clickable object by a point using the grid of a screen.
+ * The grid is built if the objects of the screen have changed.
+ * @param scr pointer to a screen (an object without parent)
+ * @param point pointer to a point for searching the most top child
+ * @param found store the found object or NULL here if there was no suitable object
+ * @return true: the grid was used; false: `found` is not set, the objects need to be searched one by one,
+ *         e.g. the grid is just being changed, there is not enough memory or the point is out of the screen
+ */
+bool _lv_indev_grid_search(lv_obj_t * scr, lv_point_t * point, lv_obj_t ** found);
+
+/**
+ * Mark the grid of an object's screen as outdated.
+ * Should be called when the object is created, deleted, moved, resized, hidden, moved to an other parent,
+ * or its z-order, clickability or hit-testing changes.
+ * @param obj pointer to an object
+ */
+void _lv_indev_grid_invalidate(lv_obj_t * obj);
+
+/**
+ * Free the grid of a screen. Should be called when the screen is deleted.
+ * @param scr pointer to a screen
+ */
+void _lv_indev_grid_remove(lv_obj_t * scr);
+
+#else
+
+#define _lv_indev_grid_invalidate(obj)
+#define _lv_indev_grid_remove(scr)
+
+#endif /*LV_INDEV_SEARCH_GRID*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_INDEV_GRID_H*/
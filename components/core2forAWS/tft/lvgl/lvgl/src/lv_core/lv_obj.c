@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj.h"
 #include "lv_indev.h"
+#include "lv_indev_grid.h"
 #include "lv_refr.h"
 #include "lv_group.h"
 #include "lv_disp.h"
@@ -47,6 +48,11 @@
 #define LV_OBJ_DEF_WIDTH    (LV_DPX(100))
 #define LV_OBJ_DEF_HEIGHT   (LV_DPX(50))
 
+#if LV_STYLE_CACHE_SIZE
+#define STYLE_CACHE_SETS        ((LV_STYLE_CACHE_SIZE + 1) / 2)   /*2 entries per set*/
+#define STYLE_CACHE_MATCH(e, k) ((e)->obj == (k)->obj && (e)->prop == (k)->prop && (e)->part == (k)->part)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -104,6 +110,20 @@ typedef struct {
     uint32_t border_post : 1;
 } style_snapshot_t;
 
+#if LV_STYLE_CACHE_SIZE
+typedef struct {
+    const lv_obj_t * obj;       /*NULL: empty entry*/
+    lv_style_property_t prop;   /*With the state of the part*/
+    uint8_t part;
+    union {
+        lv_color_t _color;
+        lv_style_int_t _int;
+        lv_opa_t _opa;
+        const void * _ptr;
+    } value;
+} style_cache_entry_t;
+#endif
+
 typedef enum {
     STYLE_COMPARE_SAME,
     STYLE_COMPARE_VISUAL_DIFF,
@@ -140,6 +160,16 @@ static void obj_del_core(lv_obj_t * obj);
 static void update_style_cache(lv_obj_t * obj, uint8_t part, uint16_t prop);
 static void update_style_cache_children(lv_obj_t * obj);
 static void invalidate_style_cache(lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static lv_style_int_t get_style_int_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static lv_color_t get_style_color_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static lv_opa_t get_style_opa_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+static const void * get_style_ptr_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop);
+#if LV_STYLE_CACHE_SIZE
+static bool style_cache_lookup(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop,
+                               style_cache_entry_t * key, style_cache_entry_t ** entry);
+#endif
+static void style_cache_invalidate(const lv_obj_t * obj, lv_style_property_t prop);
+static void style_cache_remove_obj(const lv_obj_t * obj);
 static void style_snapshot(lv_obj_t * obj, uint8_t part, style_snapshot_t * shot);
 static style_snapshot_res_t style_snapshot_compare(style_snapshot_t * shot1, style_snapshot_t * shot2);
 
@@ -149,6 +179,9 @@ static style_snapshot_res_t style_snapshot_compare(style_snapshot_t * shot1, sty
 static bool lv_initialized = false;
 static lv_event_temp_data_t * event_temp_data_head;
 static const void * event_act_data;
+#if LV_STYLE_CACHE_SIZE
+static style_cache_entry_t style_cache[STYLE_CACHE_SETS * 2];
+#endif
 
 /**********************
  *      MACROS
@@ -309,6 +342,8 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         LV_ASSERT_MEM(new_obj);
         if(new_obj == NULL) return NULL;
 
+        _lv_indev_grid_invalidate(parent);
+
         _lv_memset_00(new_obj, sizeof(lv_obj_t));
 
         new_obj->parent = parent;
@@ -682,8 +717,13 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
         old_pos.x = old_par->coords.x2 - obj->coords.x2;
     }
 
+    _lv_indev_grid_invalidate(obj);
     _lv_ll_chg_list(&obj->parent->child_ll, &parent->child_ll, obj, true);
     obj->parent = parent;
+    _lv_indev_grid_invalidate(obj);
+
+    /*The inherited values come from the new parent*/
+    style_cache_invalidate(obj, LV_STYLE_PROP_ALL);
 
     if(new_base_dir != LV_BIDI_DIR_RTL) {
         lv_obj_set_pos(obj, old_pos.x, old_pos.y);
@@ -719,6 +759,7 @@ void lv_obj_move_foreground(lv_obj_t * obj)
     lv_obj_invalidate(parent);
 
     _lv_ll_chg_list(&parent->child_ll, &parent->child_ll, obj, true);
+    _lv_indev_grid_invalidate(obj);
 
     /*Notify the new parent about the child*/
     parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, obj);
@@ -742,6 +783,7 @@ void lv_obj_move_background(lv_obj_t * obj)
     lv_obj_invalidate(parent);
 
     _lv_ll_chg_list(&parent->child_ll, &parent->child_ll, obj, false);
+    _lv_indev_grid_invalidate(obj);
 
     /*Notify the new parent about the child*/
     parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, obj);
@@ -794,6 +836,7 @@ void lv_obj_set_pos(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     obj->coords.y2 += diff.y;
 
     refresh_children_position(obj, diff.x, diff.y);
+    _lv_indev_grid_invalidate(obj);
 
     /*Inform the object about its new coordinates*/
     obj->signal_cb(obj, LV_SIGNAL_COORD_CHG, &ori);
@@ -861,6 +904,7 @@ void lv_obj_set_size(lv_obj_t * obj, lv_coord_t w, lv_coord_t h)
     else {
         obj->coords.x2 = obj->coords.x1 + w - 1;
     }
+    _lv_indev_grid_invalidate(obj);
 
     /*Send a signal to the object with its new coordinates*/
     obj->signal_cb(obj, LV_SIGNAL_COORD_CHG, &ori);
@@ -1153,9 +1197,11 @@ void lv_obj_set_ext_click_area(lv_obj_t * obj, lv_coord_t left, lv_coord_t right
     obj->ext_click_pad.x2 = right;
     obj->ext_click_pad.y1 = top;
     obj->ext_click_pad.y2 = bottom;
+    _lv_indev_grid_invalidate(obj);
 #elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
     obj->ext_click_pad_hor = LV_MATH_MAX(left, right);
     obj->ext_click_pad_ver = LV_MATH_MAX(top, bottom);
+    _lv_indev_grid_invalidate(obj);
 #else
     (void)obj;    /*Unused*/
     (void)left;   /*Unused*/
@@ -1237,6 +1283,7 @@ void lv_obj_clean_style_list(lv_obj_t * obj, uint8_t part)
 #if LV_USE_ANIMATION
     trans_del(obj, part, 0xFF, NULL);
 #endif
+    style_cache_invalidate(obj, LV_STYLE_PROP_ALL);
 }
 
 /**
@@ -1357,8 +1404,10 @@ bool lv_obj_remove_style_local_prop(lv_obj_t * obj, uint8_t part, lv_style_prope
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
     lv_style_t * style = lv_obj_get_local_style(obj, part);
-    if(style) return lv_style_remove_prop(style, prop);
-    else return false;
+    if(style == NULL) return false;
+
+    style_cache_invalidate(obj, prop);
+    return lv_style_remove_prop(style, prop);
 }
 
 /**
@@ -1372,6 +1421,7 @@ void lv_obj_refresh_style(lv_obj_t * obj, uint8_t part, lv_style_property_t prop
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
     invalidate_style_cache(obj, part, prop);
+    style_cache_invalidate(obj, prop);
 
     /*If a real style refresh is required*/
     bool real_refr = false;
@@ -1496,6 +1546,7 @@ void lv_obj_set_hidden(lv_obj_t * obj, bool en)
     if(!obj->hidden) lv_obj_invalidate(obj); /*Invalidate when not hidden (hidden objects are ignored) */
 
     obj->hidden = en == false ? 0 : 1;
+    _lv_indev_grid_invalidate(obj);
 
     if(!obj->hidden) lv_obj_invalidate(obj); /*Invalidate when not hidden (hidden objects are ignored) */
 
@@ -1513,6 +1564,7 @@ void lv_obj_set_adv_hittest(lv_obj_t * obj, bool en)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
     obj->adv_hittest = en == false ? 0 : 1;
+    _lv_indev_grid_invalidate(obj);
 }
 
 /**
@@ -1525,6 +1577,7 @@ void lv_obj_set_click(lv_obj_t * obj, bool en)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
     obj->click = (en == true ? 1 : 0);
+    _lv_indev_grid_invalidate(obj);
 }
 
 /**
@@ -1726,6 +1779,9 @@ void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
 
     obj->state = new_state;
 
+    /*The state is part of the cached values' key but the children might inherit the new values*/
+    style_cache_invalidate(obj, LV_STYLE_PROP_ALL);
+
     if(cmp_res == STYLE_COMPARE_SAME) {
         return;
     }
@@ -2567,119 +2623,29 @@ lv_style_list_t * lv_obj_get_style_list(const lv_obj_t * obj, uint8_t part)
  */
 lv_style_int_t _lv_obj_get_style_int(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
-    lv_style_property_t prop_ori = prop;
-
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
-
-    lv_style_int_t value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
-        if(!list->ignore_cache && list->style_cnt > 0) {
-            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
-
-            bool def = false;
-            switch(prop  & (~LV_STYLE_STATE_MASK)) {
-                case LV_STYLE_CLIP_CORNER:
-                    if(list->clip_corner_off) def = true;
-                    break;
-                case LV_STYLE_TEXT_LETTER_SPACE:
-                case LV_STYLE_TEXT_LINE_SPACE:
-                    if(list->text_space_zero) def = true;
-                    break;
-                case LV_STYLE_TRANSFORM_ANGLE:
-                case LV_STYLE_TRANSFORM_WIDTH:
-                case LV_STYLE_TRANSFORM_HEIGHT:
-                case LV_STYLE_TRANSFORM_ZOOM:
-                    if(list->transform_all_zero) def = true;
-                    break;
-                case LV_STYLE_BORDER_WIDTH:
-                    if(list->border_width_zero) def = true;
-                    break;
-                case LV_STYLE_BORDER_SIDE:
-                    if(list->border_side_full) def = true;
-                    break;
-                case LV_STYLE_BORDER_POST:
-                    if(list->border_post_off) def = true;
-                    break;
-                case LV_STYLE_OUTLINE_WIDTH:
-                    if(list->outline_width_zero) def = true;
-                    break;
-                case LV_STYLE_RADIUS:
-                    if(list->radius_zero) def = true;
-                    break;
-                case LV_STYLE_SHADOW_WIDTH:
-                    if(list->shadow_width_zero) def = true;
-                    break;
-                case LV_STYLE_PAD_TOP:
-                case LV_STYLE_PAD_BOTTOM:
-                case LV_STYLE_PAD_LEFT:
-                case LV_STYLE_PAD_RIGHT:
-                    if(list->pad_all_zero) def = true;
-                    break;
-                case LV_STYLE_MARGIN_TOP:
-                case LV_STYLE_MARGIN_BOTTOM:
-                case LV_STYLE_MARGIN_LEFT:
-                case LV_STYLE_MARGIN_RIGHT:
-                    if(list->margin_all_zero) def = true;
-                    break;
-                case LV_STYLE_BG_BLEND_MODE:
-                case LV_STYLE_BORDER_BLEND_MODE:
-                case LV_STYLE_IMAGE_BLEND_MODE:
-                case LV_STYLE_LINE_BLEND_MODE:
-                case LV_STYLE_OUTLINE_BLEND_MODE:
-                case LV_STYLE_PATTERN_BLEND_MODE:
-                case LV_STYLE_SHADOW_BLEND_MODE:
-                case LV_STYLE_TEXT_BLEND_MODE:
-                case LV_STYLE_VALUE_BLEND_MODE:
-                    if(list->blend_mode_all_normal) def = true;
-                    break;
-                case LV_STYLE_TEXT_DECOR:
-                    if(list->text_decor_none) def = true;
-                    break;
-            }
-
-            if(def) {
-                break;
-            }
-        }
-
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_int(list, prop, &value_act);
-        if(res == LV_RES_OK) return value_act;
-
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+    _LV_REFR_PROFILE_INC(style_get);
 
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
-        }
+    lv_style_int_t value;
 
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
+    /*The bands rendered in parallel share the cache and the temporarily changed states*/
+    _lv_refr_lock();
+#if LV_STYLE_CACHE_SIZE
+    style_cache_entry_t key;
+    style_cache_entry_t * entry;
+    if(style_cache_lookup(obj, part, prop, &key, &entry)) {
+        value = entry->value._int;
     }
-
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_BORDER_SIDE:
-            return LV_BORDER_SIDE_FULL;
-        case LV_STYLE_SIZE:
-            return LV_DPI / 20;
-        case LV_STYLE_SCALE_WIDTH:
-            return LV_DPI / 8;
-        case LV_STYLE_BG_GRAD_STOP:
-            return 255;
-        case LV_STYLE_TRANSFORM_ZOOM:
-            return LV_IMG_ZOOM_NONE;
+    else {
+        key.value._int = get_style_int_core(obj, part, prop);
+        if(entry) *entry = key;
+        value = key.value._int;
     }
+#else
+    value = get_style_int_core(obj, part, prop);
+#endif
+    _lv_refr_unlock();
 
-    return 0;
+    return value;
 }
 
 /**
@@ -2698,44 +2664,28 @@ lv_style_int_t _lv_obj_get_style_int(const lv_obj_t * obj, uint8_t part, lv_styl
  */
 lv_color_t _lv_obj_get_style_color(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
-    lv_style_property_t prop_ori = prop;
-
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
-
-    lv_color_t value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
-
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_color(list, prop, &value_act);
-        if(res == LV_RES_OK) return value_act;
+    _LV_REFR_PROFILE_INC(style_get);
 
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
-        }
+    lv_color_t value;
 
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
+    _lv_refr_lock();
+#if LV_STYLE_CACHE_SIZE
+    style_cache_entry_t key;
+    style_cache_entry_t * entry;
+    if(style_cache_lookup(obj, part, prop, &key, &entry)) {
+        value = entry->value._color;
     }
-
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_BG_COLOR:
-        case LV_STYLE_BG_GRAD_COLOR:
-            return LV_COLOR_WHITE;
+    else {
+        key.value._color = get_style_color_core(obj, part, prop);
+        if(entry) *entry = key;
+        value = key.value._color;
     }
+#else
+    value = get_style_color_core(obj, part, prop);
+#endif
+    _lv_refr_unlock();
 
-    return LV_COLOR_BLACK;
+    return value;
 }
 
 /**
@@ -2754,66 +2704,28 @@ lv_color_t _lv_obj_get_style_color(const lv_obj_t * obj, uint8_t part, lv_style_
  */
 lv_opa_t _lv_obj_get_style_opa(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
-    lv_style_property_t prop_ori = prop;
-
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
-
-    lv_opa_t value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
-
-        if(!list->ignore_cache && list->style_cnt > 0) {
-            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
-            bool def = false;
-            switch(prop & (~LV_STYLE_STATE_MASK)) {
-                case LV_STYLE_OPA_SCALE:
-                    if(list->opa_scale_cover) def = true;
-                    break;
-                case LV_STYLE_BG_OPA:
-                    if(list->bg_opa_cover) return LV_OPA_COVER;     /*Special case, not the default value is used*/
-                    if(list->bg_opa_transp) def = true;
-                    break;
-                case LV_STYLE_IMAGE_RECOLOR_OPA:
-                    if(list->img_recolor_opa_transp) def = true;
-                    break;
-            }
-
-            if(def) {
-                break;
-            }
-        }
-
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_opa(list, prop, &value_act);
-        if(res == LV_RES_OK) return value_act;
-
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+    _LV_REFR_PROFILE_INC(style_get);
 
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
-        }
+    lv_opa_t value;
 
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
+    _lv_refr_lock();
+#if LV_STYLE_CACHE_SIZE
+    style_cache_entry_t key;
+    style_cache_entry_t * entry;
+    if(style_cache_lookup(obj, part, prop, &key, &entry)) {
+        value = entry->value._opa;
     }
-
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_BG_OPA:
-        case LV_STYLE_IMAGE_RECOLOR_OPA:
-        case LV_STYLE_PATTERN_RECOLOR_OPA:
-            return LV_OPA_TRANSP;
+    else {
+        key.value._opa = get_style_opa_core(obj, part, prop);
+        if(entry) *entry = key;
+        value = key.value._opa;
     }
+#else
+    value = get_style_opa_core(obj, part, prop);
+#endif
+    _lv_refr_unlock();
 
-    return LV_OPA_COVER;
+    return value;
 }
 
 /**
@@ -2832,69 +2744,29 @@ lv_opa_t _lv_obj_get_style_opa(const lv_obj_t * obj, uint8_t part, lv_style_prop
  */
 const void * _lv_obj_get_style_ptr(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
 {
-    lv_style_property_t prop_ori = prop;
-
-    lv_style_attr_t attr;
-    attr = prop_ori >> 8;
+    _LV_REFR_PROFILE_INC(style_get);
 
-    const void * value_act;
-    lv_res_t res = LV_RES_INV;
-    const lv_obj_t * parent = obj;
-    while(parent) {
-        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+    const void *value;
 
-        if(!list->ignore_cache && list->style_cnt > 0) {
-            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
-            bool def = false;
-            switch(prop  & (~LV_STYLE_STATE_MASK)) {
-                case LV_STYLE_VALUE_STR:
-                    if(list->value_txt_str) def = true;
-                    break;
-                case LV_STYLE_PATTERN_IMAGE:
-                    if(list->pattern_img_null) def = true;
-                    break;
-                case LV_STYLE_TEXT_FONT:
-                    if(list->text_font_normal) def = true;
-                    break;
-            }
+    _lv_refr_lock();
+#if LV_STYLE_CACHE_SIZE
+    style_cache_entry_t key;
+    style_cache_entry_t * entry;
+    if(style_cache_lookup(obj, part, prop, &key, &entry)) {
+        value = entry->value._ptr;
+    }
+    else {
+        key.value._ptr = get_style_ptr_core(obj, part, prop);
+        if(entry) *entry = key;
+        value = key.value._ptr;
+    }
+#else
+    value = get_style_ptr_core(obj, part, prop);
+#endif
+    _lv_refr_unlock();
 
-            if(def) {
-                break;
-            }
-        }
-
-        lv_state_t state = lv_obj_get_state(parent, part);
-        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
-
-        res = _lv_style_list_get_ptr(list, prop, &value_act);
-        if(res == LV_RES_OK)  return value_act;
-
-        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_OBJ_PART_MAIN) {
-            part = LV_OBJ_PART_MAIN;
-            continue;
-        }
-
-        /*Check the parent too.*/
-        parent = lv_obj_get_parent(parent);
-    }
-
-    /*Handle unset values*/
-    prop = prop & (~LV_STYLE_STATE_MASK);
-    switch(prop) {
-        case LV_STYLE_TEXT_FONT:
-        case LV_STYLE_VALUE_FONT:
-            return lv_theme_get_font_normal();
-#if LV_USE_ANIMATION
-        case LV_STYLE_TRANSITION_PATH:
-            return &lv_anim_path_def;
-#endif
-    }
-
-    return NULL;
-}
+    return value;
+}
 
 /**
  * Get the local style of a part of an object.
@@ -3818,11 +3690,16 @@ static void obj_del_core(lv_obj_t * obj)
     if(par == NULL) { /*It is a screen*/
         lv_disp_t * d = lv_obj_get_disp(obj);
         _lv_ll_remove(&d->scr_ll, obj);
+        _lv_indev_grid_remove(obj);
     }
     else {
+        _lv_indev_grid_invalidate(obj);
         _lv_ll_remove(&(par->child_ll), obj);
     }
 
+    /*A new object might be allocated at the same address*/
+    style_cache_remove_obj(obj);
+
     /*Delete the base objects*/
     if(obj->ext_attr != NULL) lv_mem_free(obj->ext_attr);
     lv_mem_free(obj); /*Free the object itself*/
@@ -4418,6 +4295,7 @@ static void trans_del(lv_obj_t * obj, uint8_t part, lv_style_property_t prop, lv
             lv_style_list_t * list = lv_obj_get_style_list(tr->obj, tr->part);
             lv_style_t * style_trans = _lv_style_list_get_transition_style(list);
             lv_style_remove_prop(style_trans, tr->prop);
+            style_cache_invalidate(tr->obj, tr->prop);
 
             lv_anim_del(tr, NULL);
             _lv_ll_remove(&LV_GC_ROOT(_lv_obj_style_trans_ll), tr);
@@ -4512,6 +4390,7 @@ static void trans_anim_ready_cb(lv_anim_t * a)
         lv_style_list_t * list = lv_obj_get_style_list(tr->obj, tr->part);
         lv_style_t * style_trans = _lv_style_list_get_transition_style(list);
         lv_style_remove_prop(style_trans, tr->prop);
+        style_cache_invalidate(tr->obj, tr->prop);
     }
 
     _lv_ll_remove(&LV_GC_ROOT(_lv_obj_style_trans_ll), tr);
@@ -4526,6 +4405,7 @@ static void opa_scale_anim(lv_obj_t * obj, lv_anim_value_t v)
 static void fade_in_anim_ready(lv_anim_t * a)
 {
     lv_style_remove_prop(lv_obj_get_local_style(a->var, LV_OBJ_PART_MAIN), LV_STYLE_OPA_SCALE);
+    style_cache_invalidate(a->var, LV_STYLE_OPA_SCALE);
 }
 
 #endif
@@ -4754,6 +4634,407 @@ static void invalidate_style_cache(lv_obj_t * obj, uint8_t part, lv_style_proper
     }
 }
 
+/**
+ * Get a style property by walking the style lists of the object and its parents.
+ * The parameters and return value are the same as `_lv_obj_get_style_int`'s.
+ */
+static lv_style_int_t get_style_int_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    _LV_REFR_PROFILE_INC(style_walk);
+
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    lv_style_int_t value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+        if(!list->ignore_cache && list->style_cnt > 0) {
+            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
+
+            bool def = false;
+            switch(prop  & (~LV_STYLE_STATE_MASK)) {
+                case LV_STYLE_CLIP_CORNER:
+                    if(list->clip_corner_off) def = true;
+                    break;
+                case LV_STYLE_TEXT_LETTER_SPACE:
+                case LV_STYLE_TEXT_LINE_SPACE:
+                    if(list->text_space_zero) def = true;
+                    break;
+                case LV_STYLE_TRANSFORM_ANGLE:
+                case LV_STYLE_TRANSFORM_WIDTH:
+                case LV_STYLE_TRANSFORM_HEIGHT:
+                case LV_STYLE_TRANSFORM_ZOOM:
+                    if(list->transform_all_zero) def = true;
+                    break;
+                case LV_STYLE_BORDER_WIDTH:
+                    if(list->border_width_zero) def = true;
+                    break;
+                case LV_STYLE_BORDER_SIDE:
+                    if(list->border_side_full) def = true;
+                    break;
+                case LV_STYLE_BORDER_POST:
+                    if(list->border_post_off) def = true;
+                    break;
+                case LV_STYLE_OUTLINE_WIDTH:
+                    if(list->outline_width_zero) def = true;
+                    break;
+                case LV_STYLE_RADIUS:
+                    if(list->radius_zero) def = true;
+                    break;
+                case LV_STYLE_SHADOW_WIDTH:
+                    if(list->shadow_width_zero) def = true;
+                    break;
+                case LV_STYLE_PAD_TOP:
+                case LV_STYLE_PAD_BOTTOM:
+                case LV_STYLE_PAD_LEFT:
+                case LV_STYLE_PAD_RIGHT:
+                    if(list->pad_all_zero) def = true;
+                    break;
+                case LV_STYLE_MARGIN_TOP:
+                case LV_STYLE_MARGIN_BOTTOM:
+                case LV_STYLE_MARGIN_LEFT:
+                case LV_STYLE_MARGIN_RIGHT:
+                    if(list->margin_all_zero) def = true;
+                    break;
+                case LV_STYLE_BG_BLEND_MODE:
+                case LV_STYLE_BORDER_BLEND_MODE:
+                case LV_STYLE_IMAGE_BLEND_MODE:
+                case LV_STYLE_LINE_BLEND_MODE:
+                case LV_STYLE_OUTLINE_BLEND_MODE:
+                case LV_STYLE_PATTERN_BLEND_MODE:
+                case LV_STYLE_SHADOW_BLEND_MODE:
+                case LV_STYLE_TEXT_BLEND_MODE:
+                case LV_STYLE_VALUE_BLEND_MODE:
+                    if(list->blend_mode_all_normal) def = true;
+                    break;
+                case LV_STYLE_TEXT_DECOR:
+                    if(list->text_decor_none) def = true;
+                    break;
+            }
+
+            if(def) {
+                break;
+            }
+        }
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_int(list, prop, &value_act);
+        if(res == LV_RES_OK) return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_BORDER_SIDE:
+            return LV_BORDER_SIDE_FULL;
+        case LV_STYLE_SIZE:
+            return LV_DPI / 20;
+        case LV_STYLE_SCALE_WIDTH:
+            return LV_DPI / 8;
+        case LV_STYLE_BG_GRAD_STOP:
+            return 255;
+        case LV_STYLE_TRANSFORM_ZOOM:
+            return LV_IMG_ZOOM_NONE;
+    }
+
+    return 0;
+}
+
+/**
+ * Get a style property by walking the style lists of the object and its parents.
+ * The parameters and return value are the same as `_lv_obj_get_style_color`'s.
+ */
+static lv_color_t get_style_color_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    _LV_REFR_PROFILE_INC(style_walk);
+
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    lv_color_t value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_color(list, prop, &value_act);
+        if(res == LV_RES_OK) return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_BG_COLOR:
+        case LV_STYLE_BG_GRAD_COLOR:
+            return LV_COLOR_WHITE;
+    }
+
+    return LV_COLOR_BLACK;
+}
+
+/**
+ * Get a style property by walking the style lists of the object and its parents.
+ * The parameters and return value are the same as `_lv_obj_get_style_opa`'s.
+ */
+static lv_opa_t get_style_opa_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    _LV_REFR_PROFILE_INC(style_walk);
+
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    lv_opa_t value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+
+        if(!list->ignore_cache && list->style_cnt > 0) {
+            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
+            bool def = false;
+            switch(prop & (~LV_STYLE_STATE_MASK)) {
+                case LV_STYLE_OPA_SCALE:
+                    if(list->opa_scale_cover) def = true;
+                    break;
+                case LV_STYLE_BG_OPA:
+                    if(list->bg_opa_cover) return LV_OPA_COVER;     /*Special case, not the default value is used*/
+                    if(list->bg_opa_transp) def = true;
+                    break;
+                case LV_STYLE_IMAGE_RECOLOR_OPA:
+                    if(list->img_recolor_opa_transp) def = true;
+                    break;
+            }
+
+            if(def) {
+                break;
+            }
+        }
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_opa(list, prop, &value_act);
+        if(res == LV_RES_OK) return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_BG_OPA:
+        case LV_STYLE_IMAGE_RECOLOR_OPA:
+        case LV_STYLE_PATTERN_RECOLOR_OPA:
+            return LV_OPA_TRANSP;
+    }
+
+    return LV_OPA_COVER;
+}
+
+/**
+ * Get a style property by walking the style lists of the object and its parents.
+ * The parameters and return value are the same as `_lv_obj_get_style_ptr`'s.
+ */
+static const void *get_style_ptr_core(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop)
+{
+    _LV_REFR_PROFILE_INC(style_walk);
+
+    lv_style_property_t prop_ori = prop;
+
+    lv_style_attr_t attr;
+    attr = prop_ori >> 8;
+
+    const void * value_act;
+    lv_res_t res = LV_RES_INV;
+    const lv_obj_t * parent = obj;
+    while(parent) {
+        lv_style_list_t * list = lv_obj_get_style_list(parent, part);
+
+        if(!list->ignore_cache && list->style_cnt > 0) {
+            if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
+            bool def = false;
+            switch(prop  & (~LV_STYLE_STATE_MASK)) {
+                case LV_STYLE_VALUE_STR:
+                    if(list->value_txt_str) def = true;
+                    break;
+                case LV_STYLE_PATTERN_IMAGE:
+                    if(list->pattern_img_null) def = true;
+                    break;
+                case LV_STYLE_TEXT_FONT:
+                    if(list->text_font_normal) def = true;
+                    break;
+            }
+
+            if(def) {
+                break;
+            }
+        }
+
+        lv_state_t state = lv_obj_get_state(parent, part);
+        prop = (uint16_t)prop_ori + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+        res = _lv_style_list_get_ptr(list, prop, &value_act);
+        if(res == LV_RES_OK)  return value_act;
+
+        if(LV_STYLE_ATTR_GET_INHERIT(attr) == 0) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_OBJ_PART_MAIN) {
+            part = LV_OBJ_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*Handle unset values*/
+    prop = prop & (~LV_STYLE_STATE_MASK);
+    switch(prop) {
+        case LV_STYLE_TEXT_FONT:
+        case LV_STYLE_VALUE_FONT:
+            return lv_theme_get_font_normal();
+#if LV_USE_ANIMATION
+        case LV_STYLE_TRANSITION_PATH:
+            return &lv_anim_path_def;
+#endif
+    }
+
+    return NULL;
+}
+
+#if LV_STYLE_CACHE_SIZE
+/**
+ * Find the entry of the style cache where a property of an object's part is (or will be) stored.
+ * @param obj pointer to an object
+ * @param part the part of the object
+ * @param prop the property to get (without state)
+ * @param key store the key of the property here (`obj`, `part` and `prop` with the current state)
+ * @param entry store the pointer to the entry here. `NULL` if the property can't be cached now.
+ * @return true: `entry` holds the value of the property
+ */
+static bool style_cache_lookup(const lv_obj_t * obj, uint8_t part, lv_style_property_t prop,
+                               style_cache_entry_t * key, style_cache_entry_t ** entry)
+{
+    /*The transitions and the widgets drawing in other states set these flags while
+     *they get the values of a temporal state*/
+    lv_style_list_t * list = lv_obj_get_style_list(obj, part);
+    if(list->ignore_cache || list->skip_trans) {
+        *entry = NULL;
+        return false;
+    }
+
+    lv_state_t state = lv_obj_get_state(obj, part);
+    key->obj = obj;
+    key->part = part;
+    key->prop = (prop & (~LV_STYLE_STATE_MASK)) + ((uint16_t)state << LV_STYLE_STATE_POS);
+
+    /*Mix the key to spread the objects' nearby addresses and similar property IDs*/
+    uint32_t h = (uint32_t)(lv_uintptr_t)obj ^ ((uint32_t)part << 24) ^ ((uint32_t)key->prop * 2654435761u);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+
+    /*2 way set associative: the most recently used entry of a set is the first*/
+    style_cache_entry_t * set = &style_cache[(h % STYLE_CACHE_SETS) * 2];
+    *entry = &set[0];
+    if(STYLE_CACHE_MATCH(&set[0], key)) return true;
+
+    style_cache_entry_t tmp = set[0];
+    if(STYLE_CACHE_MATCH(&set[1], key)) {
+        set[0] = set[1];
+        set[1] = tmp;
+        return true;
+    }
+
+    /*Evict the least recently used entry. The caller will fill the first one.*/
+    set[1] = tmp;
+    return false;
+}
+#endif
+
+/**
+ * Remove the cached values which might have changed when a property of an object changed.
+ * Inherited properties might change the values of the children too.
+ * @param obj pointer to an object
+ * @param prop the changed property or `LV_STYLE_PROP_ALL`
+ */
+static void style_cache_invalidate(const lv_obj_t * obj, lv_style_property_t prop)
+{
+#if LV_STYLE_CACHE_SIZE
+    lv_style_attr_t attr = (prop & (~LV_STYLE_STATE_MASK)) >> 8;
+    if((prop == LV_STYLE_PROP_ALL || LV_STYLE_ATTR_GET_INHERIT(attr)) && lv_obj_get_child(obj, NULL)) {
+        _lv_memset_00(style_cache, sizeof(style_cache));
+    }
+    else {
+        style_cache_remove_obj(obj);
+    }
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(prop);
+#endif
+}
+
+/**
+ * Remove all the cached values of an object
+ * @param obj pointer to an object
+ */
+static void style_cache_remove_obj(const lv_obj_t * obj)
+{
+#if LV_STYLE_CACHE_SIZE
+    uint32_t i;
+    for(i = 0; i < STYLE_CACHE_SETS * 2; i++) {
+        if(style_cache[i].obj == obj) style_cache[i].obj = NULL;
+    }
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
 static void style_snapshot(lv_obj_t * obj, uint8_t part, style_snapshot_t * shot)
 {
     _lv_obj_disable_style_caching(obj, true);
@@ -29,6 +29,9 @@
 /* Draw translucent random colored areas on the invalidated (redrawn) areas*/
 #define MASK_AREA_DEBUG 0
 
+/* Minimal size of a band in pixels. Rendering smaller bands in parallel doesn't pay off.*/
+#define REFR_BAND_MIN_PX 2048
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -37,13 +40,20 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static uint32_t lv_refr_area_cost(const lv_area_t * area_p);
 static void lv_refr_areas(void);
 static void lv_refr_area(const lv_area_t * area_p);
 static void lv_refr_area_part(const lv_area_t * area_p);
+static void lv_refr_mask(const lv_area_t * start_mask);
+#if LV_REFR_PARALLEL > 1
+    static bool lv_refr_bands(const lv_area_t * start_mask);
+    static void lv_refr_bands_free_bufs(void);
+#endif
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p);
 static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p);
 static void lv_refr_vdb_flush(void);
+static void lv_refr_inv_area(lv_disp_t * disp, const lv_area_t * area_p);
 
 /**********************
  *  STATIC VARIABLES
@@ -54,6 +64,16 @@ static lv_disp_t * disp_refr; /*Display being refreshed*/
     static uint32_t fps_sum_cnt;
     static uint32_t fps_sum_all;
 #endif
+#if LV_USE_REFR_PROFILER
+    lv_refr_profile_t _lv_refr_profile;
+#endif
+#if LV_REFR_PARALLEL > 1
+    static lv_refr_band_t bands[LV_REFR_PARALLEL];
+    static LV_ATTRIBUTE_THREAD_LOCAL lv_refr_band_t * band_act;   /*The band rendered by the calling thread*/
+    static bool lock_flag;
+    static lv_refr_band_t * lock_owner;
+    static uint32_t lock_depth;
+#endif
 
 /**********************
  *      MACROS
@@ -105,47 +125,9 @@ void lv_refr_now(lv_disp_t * disp)
  */
 void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
 {
-    if(!disp) disp = lv_disp_get_default();
-    if(!disp) return;
-
-    /*Clear the invalidate buffer if the parameter is NULL*/
-    if(area_p == NULL) {
-        disp->inv_p = 0;
-        return;
-    }
-
-    lv_area_t scr_area;
-    scr_area.x1 = 0;
-    scr_area.y1 = 0;
-    scr_area.x2 = lv_disp_get_hor_res(disp) - 1;
-    scr_area.y2 = lv_disp_get_ver_res(disp) - 1;
-
-    lv_area_t com_area;
-    bool suc;
-
-    suc = _lv_area_intersect(&com_area, area_p, &scr_area);
-
-    /*The area is truncated to the screen*/
-    if(suc != false) {
-        if(disp->driver.rounder_cb) disp->driver.rounder_cb(&disp->driver, &com_area);
-
-        /*Save only if this area is not in one of the saved areas*/
-        uint16_t i;
-        for(i = 0; i < disp->inv_p; i++) {
-            if(_lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
-        }
-
-        /*Save the area*/
-        if(disp->inv_p < LV_INV_BUF_SIZE) {
-            lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
-        }
-        else {   /*If no place for the area add the screen*/
-            disp->inv_p = 0;
-            lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
-        }
-        disp->inv_p++;
-        lv_task_set_prio(disp->refr_task, LV_REFR_TASK_PRIO);
-    }
+    _LV_REFR_PROFILE_START(t_inv);
+    lv_refr_inv_area(disp, area_p);
+    _LV_REFR_PROFILE_ADD(inv_us, t_inv);
 }
 
 /**
@@ -168,6 +150,36 @@ void _lv_refr_set_disp_refreshing(lv_disp_t * disp)
     disp_refr = disp;
 }
 
+#if LV_USE_REFR_PROFILER
+/**
+ * Get the phase times collected since the last reset
+ * @return pointer to the collected times
+ */
+const lv_refr_profile_t * lv_refr_get_profile(void)
+{
+    return &_lv_refr_profile;
+}
+
+/**
+ * Clear the collected phase times
+ */
+void lv_refr_reset_profile(void)
+{
+    _lv_memset_00(&_lv_refr_profile, sizeof(_lv_refr_profile));
+}
+
+#if LV_REFR_PARALLEL > 1
+/**
+ * Get where the calling thread collects the times
+ * @return pointer to the profile of the band rendered by the thread or `_lv_refr_profile`
+ */
+lv_refr_profile_t * _lv_refr_get_profile_act(void)
+{
+    return band_act ? &band_act->profile : &_lv_refr_profile;
+}
+#endif
+#endif
+
 /**
  * Called periodically to handle the refreshing
  * @param task pointer to the task itself
@@ -178,6 +190,7 @@ void _lv_disp_refr_task(lv_task_t * task)
 
     uint32_t start = lv_tick_get();
     uint32_t elaps = 0;
+    _LV_REFR_PROFILE_START(t_refr);
 
     disp_refr = task->user_data;
 
@@ -194,7 +207,9 @@ void _lv_disp_refr_task(lv_task_t * task)
         return;
     }
 
+    _LV_REFR_PROFILE_START(t_join);
     lv_refr_join_area();
+    _LV_REFR_PROFILE_ADD(join_us, t_join);
 
     lv_refr_areas();
 
@@ -263,6 +278,14 @@ void _lv_disp_refr_task(lv_task_t * task)
         _lv_memset_00(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
         disp_refr->inv_p = 0;
 
+#if LV_USE_REFR_PROFILER
+        uint32_t t_frame = (uint32_t)(LV_REFR_PROFILER_TIME_US) - t_refr;
+        _lv_refr_profile.frames++;
+        _lv_refr_profile.refr_us += t_frame;
+        if(t_frame > _lv_refr_profile.refr_max_us) _lv_refr_profile.refr_max_us = t_frame;
+        _lv_refr_profile.px_refr += px_num;
+#endif
+
         elaps = lv_tick_elaps(start);
         /*Call monitor cb if present*/
         if(disp_refr->driver.monitor_cb) {
@@ -271,6 +294,9 @@ void _lv_disp_refr_task(lv_task_t * task)
     }
 
     _lv_mem_buf_free_all();
+#if LV_REFR_PARALLEL > 1
+    lv_refr_bands_free_bufs();
+#endif
     _lv_font_clean_up_fmt_txt();
 
 #if LV_USE_PERF_MONITOR && LV_USE_LABEL
@@ -328,45 +354,189 @@ uint32_t lv_refr_get_fps_avg(void)
 }
 #endif
 
+#if LV_REFR_PARALLEL > 1
+/**
+ * Render a band passed to the display driver's `band_start_cb`.
+ * Should be called on an other core or thread than `lv_task_handler`.
+ * @param band pointer to the band to render
+ */
+void lv_refr_band_render(lv_refr_band_t * band)
+{
+    band_act = band;
+    lv_refr_mask(&band->area);
+    band_act = NULL;
+
+    /*Publish the rendered pixels before telling the band is ready*/
+    __atomic_store_n(&band->rendering, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * Get the band rendered by the calling thread
+ * @return pointer to the band or NULL if the thread isn't rendering a band
+ */
+lv_refr_band_t * _lv_refr_get_band(void)
+{
+    return band_act;
+}
+
+/**
+ * Start to use data shared with the other bands (e.g. caches or the memory pool).
+ * Can be nested. Does nothing if the calling thread isn't rendering a band.
+ */
+void _lv_refr_lock(void)
+{
+    if(band_act == NULL) return;
+
+    if(__atomic_load_n(&lock_owner, __ATOMIC_RELAXED) == band_act) {
+        lock_depth++;
+        return;
+    }
+
+    /*The locked parts are short so just spin*/
+    while(__atomic_test_and_set(&lock_flag, __ATOMIC_ACQUIRE));
+
+    __atomic_store_n(&lock_owner, band_act, __ATOMIC_RELAXED);
+    lock_depth = 1;
+}
+
+/**
+ * Finish using the data shared with the other bands.
+ */
+void _lv_refr_unlock(void)
+{
+    if(band_act == NULL) return;
+
+    lock_depth--;
+    if(lock_depth > 0) return;
+
+    __atomic_store_n(&lock_owner, NULL, __ATOMIC_RELAXED);
+    __atomic_clear(&lock_flag, __ATOMIC_RELEASE);
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
 /**
- * Join the areas which has got common parts
+ * Save an area to redraw, see `_lv_inv_area`
+ */
+static void lv_refr_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) return;
+
+    /*Clear the invalidate buffer if the parameter is NULL*/
+    if(area_p == NULL) {
+        disp->inv_p = 0;
+        return;
+    }
+
+    lv_area_t scr_area;
+    scr_area.x1 = 0;
+    scr_area.y1 = 0;
+    scr_area.x2 = lv_disp_get_hor_res(disp) - 1;
+    scr_area.y2 = lv_disp_get_ver_res(disp) - 1;
+
+    lv_area_t com_area;
+    bool suc;
+
+    suc = _lv_area_intersect(&com_area, area_p, &scr_area);
+
+    /*The area is truncated to the screen*/
+    if(suc != false) {
+        if(disp->driver.rounder_cb) disp->driver.rounder_cb(&disp->driver, &com_area);
+
+        /*Save only if this area is not in one of the saved areas*/
+        uint16_t i;
+        for(i = 0; i < disp->inv_p; i++) {
+            if(_lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
+        }
+
+        /*Save the area*/
+        if(disp->inv_p < LV_INV_BUF_SIZE) {
+            lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+        }
+        else {   /*If no place for the area add the screen*/
+            disp->inv_p = 0;
+            lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
+        }
+        disp->inv_p++;
+#if LV_USE_REFR_PROFILER
+        _lv_refr_profile.inv_cnt++;
+#endif
+        lv_task_set_prio(disp->refr_task, LV_REFR_TASK_PRIO);
+    }
+}
+
+/**
+ * Join the areas which has got common parts.
+ * With `flush_overhead` also join the separate areas if it saves enough flushes.
  */
 static void lv_refr_join_area(void)
 {
     uint32_t join_from;
     uint32_t join_in;
     lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
-
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
-            }
+    bool joined;
+    uint32_t flush_overhead = disp_refr->driver.flush_overhead;
+
+    do {
+        joined = false;
+        for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
+            if(disp_refr->inv_area_joined[join_in] != 0) continue;
+
+            /*Check all areas to join them in 'join_in'*/
+            for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
+                /*Handle only unjoined areas and ignore itself*/
+                if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
+                    continue;
+                }
 
-            /*Check if the areas are on each other*/
-            if(_lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
-            }
+                /*Without flush overhead check if the areas are on each other*/
+                if(flush_overhead == 0 &&
+                   _lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
+                    continue;
+                }
 
-            _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+                _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+                /*Join two area only if the joined area is cheaper to refresh*/
+                if(lv_refr_area_cost(&joined_area) < (lv_refr_area_cost(&disp_refr->inv_areas[join_in]) +
+                                                      lv_refr_area_cost(&disp_refr->inv_areas[join_from]))) {
+                    lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
+                    /*Mark 'join_form' is joined into 'join_in'*/
+                    disp_refr->inv_area_joined[join_from] = 1;
+                    joined = true;
+                }
             }
         }
-    }
+        /*A grown area might be worth to join with the areas checked before it*/
+    } while(joined && flush_overhead != 0);
+}
+
+/**
+ * Estimate the cost of refreshing an area: its pixels and `flush_overhead` for every flush.
+ * The area is flushed in as many parts as many times its rows fill the display buffer.
+ * These parts start at the top of the area and not at fixed bands of the screen,
+ * so the areas aren't aligned to bands: it would only split short areas crossing a band border.
+ * @param area_p pointer to an area
+ * @return the cost in pixels
+ */
+static uint32_t lv_refr_area_cost(const lv_area_t * area_p)
+{
+    uint32_t size = lv_area_get_size(area_p);
+    uint32_t flush_overhead = disp_refr->driver.flush_overhead;
+    if(flush_overhead == 0) return size;
+    if(lv_disp_is_true_double_buf(disp_refr)) return size + flush_overhead;
+
+    uint32_t w = lv_area_get_width(area_p);
+    uint32_t h = lv_area_get_height(area_p);
+    uint32_t max_row = lv_disp_get_buf(disp_refr)->size / w;
+    if(max_row == 0) max_row = 1;
+
+    return size + ((h + max_row - 1) / max_row) * flush_overhead;
 }
 
 /**
@@ -502,24 +672,49 @@ static void lv_refr_area_part(const lv_area_t * area_p)
 
     /*In non double buffered mode, before rendering the next part wait until the previous image is
      * flushed*/
+    _LV_REFR_PROFILE_START(t_wait);
     if(lv_disp_is_double_buf(disp_refr) == false) {
         while(vdb->flushing) {
             if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
         }
     }
-
-    lv_obj_t * top_act_scr = NULL;
-    lv_obj_t * top_prev_scr = NULL;
+    _LV_REFR_PROFILE_ADD(flush_us, t_wait);
+    _LV_REFR_PROFILE_START(t_draw);
 
     /*Get the new mask from the original area and the act. VDB
      It will be a part of 'area_p'*/
     lv_area_t start_mask;
     _lv_area_intersect(&start_mask, area_p, &vdb->area);
 
+#if LV_REFR_PARALLEL > 1
+    bool rendered = lv_refr_bands(&start_mask);
+#else
+    bool rendered = false;
+#endif
+    if(rendered == false) lv_refr_mask(&start_mask);
+
+    _LV_REFR_PROFILE_ADD(draw_us, t_draw);
+
+    /* In true double buffered mode flush only once when all areas were rendered.
+     * In normal mode flush after every area */
+    if(lv_disp_is_true_double_buf(disp_refr) == false) {
+        lv_refr_vdb_flush();
+    }
+}
+
+/**
+ * Draw the objects of the screens and layers on an area of the draw buffer
+ * @param start_mask pointer to the area to draw. It has to be in the draw buffer.
+ */
+static void lv_refr_mask(const lv_area_t * start_mask)
+{
+    lv_obj_t * top_act_scr = NULL;
+    lv_obj_t * top_prev_scr = NULL;
+
     /*Get the most top object which is not covered by others*/
-    top_act_scr = lv_refr_get_top_obj(&start_mask, lv_disp_get_scr_act(disp_refr));
+    top_act_scr = lv_refr_get_top_obj(start_mask, lv_disp_get_scr_act(disp_refr));
     if(disp_refr->prev_scr) {
-        top_prev_scr = lv_refr_get_top_obj(&start_mask, disp_refr->prev_scr);
+        top_prev_scr = lv_refr_get_top_obj(start_mask, disp_refr->prev_scr);
     }
 
     /*Draw a display background if there is no top object*/
@@ -534,7 +729,7 @@ static void lv_refr_area_part(const lv_area_t * area_p)
             if(res == LV_RES_OK) {
                 lv_area_t a;
                 lv_area_set(&a, 0, 0, header.w - 1, header.h - 1);
-                lv_draw_img(&a, &start_mask, disp_refr->bg_img, &dsc);
+                lv_draw_img(&a, start_mask, disp_refr->bg_img, &dsc);
             }
             else {
                 LV_LOG_WARN("Can't draw the background image")
@@ -545,7 +740,7 @@ static void lv_refr_area_part(const lv_area_t * area_p)
             lv_draw_rect_dsc_init(&dsc);
             dsc.bg_color = disp_refr->bg_color;
             dsc.bg_opa = disp_refr->bg_opa;
-            lv_draw_rect(&start_mask, &start_mask, &dsc);
+            lv_draw_rect(start_mask, start_mask, &dsc);
 
         }
     }
@@ -556,7 +751,7 @@ static void lv_refr_area_part(const lv_area_t * area_p)
             top_prev_scr = disp_refr->prev_scr;
         }
         /*Do the refreshing from the top object*/
-        lv_refr_obj_and_children(top_prev_scr, &start_mask);
+        lv_refr_obj_and_children(top_prev_scr, start_mask);
 
     }
 
@@ -564,18 +759,101 @@ static void lv_refr_area_part(const lv_area_t * area_p)
         top_act_scr = disp_refr->act_scr;
     }
     /*Do the refreshing from the top object*/
-    lv_refr_obj_and_children(top_act_scr, &start_mask);
+    lv_refr_obj_and_children(top_act_scr, start_mask);
 
     /*Also refresh top and sys layer unconditionally*/
-    lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), &start_mask);
-    lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), &start_mask);
+    lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), start_mask);
+    lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), start_mask);
+}
 
-    /* In true double buffered mode flush only once when all areas were rendered.
-     * In normal mode flush after every area */
-    if(lv_disp_is_true_double_buf(disp_refr) == false) {
-        lv_refr_vdb_flush();
+#if LV_REFR_PARALLEL > 1
+/**
+ * Split an area into horizontal bands and render them in parallel
+ * @param start_mask pointer to the area to draw. It has to be in the draw buffer.
+ * @return true: the area is rendered; false: the area should be rendered in one piece
+ */
+static bool lv_refr_bands(const lv_area_t * start_mask)
+{
+    if(disp_refr->driver.band_start_cb == NULL) return false;
+
+    /*With `set_px_cb` the rows of the draw buffer can't be separated*/
+    if(disp_refr->driver.set_px_cb) return false;
+
+    lv_coord_t h = lv_area_get_height(start_mask);
+    uint32_t band_cnt = lv_area_get_size(start_mask) / REFR_BAND_MIN_PX;
+    if(band_cnt > LV_REFR_PARALLEL) band_cnt = LV_REFR_PARALLEL;
+    if(band_cnt > (uint32_t)h) band_cnt = h;
+    if(band_cnt < 2) return false;
+
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
+    lv_coord_t vdb_w = lv_area_get_width(&vdb->area);
+
+    uint32_t i;
+    lv_coord_t y1 = start_mask->y1;
+    for(i = 0; i < band_cnt; i++) {
+        lv_refr_band_t * band = &bands[i];
+        band->disp = disp_refr;
+        band->id = i;
+        band->area.x1 = start_mask->x1;
+        band->area.x2 = start_mask->x2;
+        band->area.y1 = y1;
+        band->area.y2 = start_mask->y1 + (h * (i + 1)) / band_cnt - 1;
+        y1 = band->area.y2 + 1;
+
+        /*The band draws only its own rows of the draw buffer*/
+        _lv_memset_00(&band->buf, sizeof(band->buf));
+        band->buf.area.x1 = vdb->area.x1;
+        band->buf.area.x2 = vdb->area.x2;
+        band->buf.area.y1 = band->area.y1;
+        band->buf.area.y2 = band->area.y2;
+        band->buf.buf_act = (lv_color_t *)vdb->buf_act + (band->area.y1 - vdb->area.y1) * vdb_w;
+        band->buf.size = lv_area_get_size(&band->buf.area);
+#if LV_USE_REFR_PROFILER
+        _lv_memset_00(&band->profile, sizeof(band->profile));
+#endif
+        band->rendering = 1;
+    }
+
+    /*Start the other bands and render the first one here*/
+    for(i = 1; i < band_cnt; i++) {
+        disp_refr->driver.band_start_cb(&disp_refr->driver, &bands[i]);
+    }
+
+    lv_refr_band_render(&bands[0]);
+
+    for(i = 1; i < band_cnt; i++) {
+        while(__atomic_load_n(&bands[i].rendering, __ATOMIC_ACQUIRE)) {
+            if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
+        }
     }
+
+#if LV_USE_REFR_PROFILER
+    for(i = 0; i < band_cnt; i++) {
+        _lv_refr_profile.blend_us += bands[i].profile.blend_us;
+        _lv_refr_profile.px_blend += bands[i].profile.px_blend;
+        _lv_refr_profile.style_get += bands[i].profile.style_get;
+        _lv_refr_profile.style_walk += bands[i].profile.style_walk;
+    }
+#endif
+
+    return true;
+}
+
+/**
+ * Free the temporal buffers of the bands
+ */
+static void lv_refr_bands_free_bufs(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_REFR_PARALLEL; i++) {
+        /*`_lv_mem_buf_free_all` frees the buffers of the calling thread's band*/
+        band_act = &bands[i];
+        _lv_mem_buf_free_all();
+    }
+
+    band_act = NULL;
 }
+#endif
 
 /**
  * Search the most top object which fully covers an area
@@ -917,6 +1195,7 @@ static void lv_refr_vdb_flush(void)
 {
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
     lv_color_t * color_p = vdb->buf_act;
+    _LV_REFR_PROFILE_START(t_flush);
 
     /*In double buffered mode wait until the other buffer is flushed before flushing the current
      * one*/
@@ -950,4 +1229,5 @@ static void lv_refr_vdb_flush(void)
         else
             vdb->buf_act = vdb->buf1;
     }
+    _LV_REFR_PROFILE_ADD(flush_us, t_flush);
 }
@@ -14,6 +14,8 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "lv_obj.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_draw/lv_draw_mask.h"
 #include <stdbool.h>
 
 /*********************
@@ -26,6 +28,49 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_REFR_PROFILER
+/**
+ * Time spent in the phases of refreshing since the last `lv_refr_reset_profile()`.
+ * Times are in the units of `LV_REFR_PROFILER_TIME_US`.
+ */
+typedef struct {
+    uint32_t frames;        /*Refreshes which redrew at least one area*/
+    uint32_t refr_us;       /*Time of whole refreshes (`join_us + draw_us + flush_us` and overhead)*/
+    uint32_t refr_max_us;   /*Longest single refresh*/
+    uint32_t inv_us;        /*Time spent invalidating areas*/
+    uint32_t inv_cnt;       /*Number of invalidated areas*/
+    uint32_t join_us;       /*Time spent joining the invalidated areas*/
+    uint32_t draw_us;       /*Time spent drawing the objects, `blend_us` included*/
+    uint32_t blend_us;      /*Time spent blending into the draw buffer*/
+    uint32_t flush_us;      /*Time spent in `flush_cb`, waiting for a free buffer included*/
+    uint32_t px_refr;       /*Pixels of the refreshed areas*/
+    uint32_t px_blend;      /*Pixels written by the blend functions*/
+    uint32_t style_get;     /*Style property lookups*/
+    uint32_t style_walk;    /*Style property lookups which walked the style lists (not found in the style cache)*/
+} lv_refr_profile_t;
+
+extern lv_refr_profile_t _lv_refr_profile;
+#endif
+
+#if LV_REFR_PARALLEL > 1
+/**
+ * A horizontal band of the area being refreshed.
+ * The bands of an area are rendered in parallel into their own rows of the draw buffer.
+ */
+typedef struct _lv_refr_band_t {
+    lv_disp_t * disp;                       /*Display being refreshed*/
+    lv_area_t area;                         /*Area of the band in screen coordinates*/
+    lv_disp_buf_t buf;                      /*The rows of the draw buffer covered by the band*/
+    lv_mem_buf_arr_t mem_buf;               /*Temporal buffers of the band (instead of `_lv_mem_buf`)*/
+    _lv_draw_mask_saved_arr_t mask_list;    /*Masks of the band (instead of `_lv_draw_mask_list`)*/
+#if LV_USE_REFR_PROFILER
+    lv_refr_profile_t profile;              /*Times of the band, added to `_lv_refr_profile` when the area is ready*/
+#endif
+    uint8_t id;
+    volatile uint8_t rendering;             /*1: not rendered yet*/
+} lv_refr_band_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -38,6 +83,22 @@ extern "C" {
  *      MACROS
  **********************/
 
+#if LV_USE_REFR_PROFILER
+#if LV_REFR_PARALLEL > 1
+/*The bands count into their own profile*/
+#define _LV_REFR_PROFILE_ACT            (*_lv_refr_get_profile_act())
+#else
+#define _LV_REFR_PROFILE_ACT            _lv_refr_profile
+#endif
+#define _LV_REFR_PROFILE_START(t)       uint32_t t = LV_REFR_PROFILER_TIME_US
+#define _LV_REFR_PROFILE_ADD(field, t)  _LV_REFR_PROFILE_ACT.field += (uint32_t)(LV_REFR_PROFILER_TIME_US) - (t)
+#define _LV_REFR_PROFILE_INC(field)     _LV_REFR_PROFILE_ACT.field++
+#else
+#define _LV_REFR_PROFILE_START(t)
+#define _LV_REFR_PROFILE_ADD(field, t)
+#define _LV_REFR_PROFILE_INC(field)
+#endif
+
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
@@ -86,12 +147,62 @@ void _lv_refr_set_disp_refreshing(lv_disp_t * disp);
 uint32_t lv_refr_get_fps_avg(void);
 #endif
 
+#if LV_USE_REFR_PROFILER
+/**
+ * Get the phase times collected since the last reset
+ * @return pointer to the collected times
+ */
+const lv_refr_profile_t * lv_refr_get_profile(void);
+
+/**
+ * Clear the collected phase times
+ */
+void lv_refr_reset_profile(void);
+
+#if LV_REFR_PARALLEL > 1
+/**
+ * Get where the calling thread collects the times
+ * @return pointer to the profile of the band rendered by the thread or `_lv_refr_profile`
+ */
+lv_refr_profile_t * _lv_refr_get_profile_act(void);
+#endif
+#endif
+
 /**
  * Called periodically to handle the refreshing
  * @param task pointer to the task itself
  */
 void _lv_disp_refr_task(lv_task_t * task);
 
+#if LV_REFR_PARALLEL > 1
+/**
+ * Render a band passed to the display driver's `band_start_cb`.
+ * Should be called on an other core or thread than `lv_task_handler`.
+ * @param band pointer to the band to render
+ */
+void lv_refr_band_render(lv_refr_band_t * band);
+
+/**
+ * Get the band rendered by the calling thread
+ * @return pointer to the band or NULL if the thread isn't rendering a band
+ */
+lv_refr_band_t * _lv_refr_get_band(void);
+
+/**
+ * Start to use data shared with the other bands (e.g. caches or the memory pool).
+ * Can be nested. Does nothing if the calling thread isn't rendering a band.
+ */
+void _lv_refr_lock(void);
+
+/**
+ * Finish using the data shared with the other bands.
+ */
+void _lv_refr_unlock(void);
+#else
+#define _lv_refr_lock()
+#define _lv_refr_unlock()
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
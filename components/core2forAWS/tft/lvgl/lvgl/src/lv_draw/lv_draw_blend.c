@@ -20,15 +20,55 @@
     #include "../lv_gpu/lv_gpu_stm32_dma2d.h"
 #endif
 
+#if LV_USE_BLEND_FAST_565 == 2 && LV_COLOR_DEPTH == 16 && LV_COLOR_SCREEN_TRANSP == 0
+    #if defined(__AVX2__)
+        #include <immintrin.h>
+    #elif defined(__SSE2__)
+        #include <emmintrin.h>
+    #elif defined(__ARM_NEON)
+        #include <arm_neon.h>
+    #endif
+#endif
+#include <string.h>
+
 /*********************
  *      DEFINES
  *********************/
 #define GPU_SIZE_LIMIT      240
 
+/*Kernels to mix RGB565 pixels*/
+#define BLEND_565_SWAR      1   /*2 pixels in a 32-bit word*/
+#define BLEND_565_SSE2      2
+#define BLEND_565_AVX2      3
+#define BLEND_565_NEON      4
+
+#if LV_USE_BLEND_FAST_565 && LV_COLOR_DEPTH == 16 && LV_COLOR_SCREEN_TRANSP == 0
+    #if LV_USE_BLEND_FAST_565 == 2 && defined(__AVX2__)
+        #define BLEND_565   BLEND_565_AVX2
+    #elif LV_USE_BLEND_FAST_565 == 2 && defined(__SSE2__)
+        #define BLEND_565   BLEND_565_SSE2
+    #elif LV_USE_BLEND_FAST_565 == 2 && defined(__ARM_NEON)
+        #define BLEND_565   BLEND_565_NEON
+    #else
+        #define BLEND_565   BLEND_565_SWAR
+    #endif
+#else
+    #define BLEND_565       0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if BLEND_565 == BLEND_565_SWAR
+/*The last result of mixing a color to two pixels*/
+typedef struct {
+    uint32_t bg;
+    uint32_t mix;
+    uint32_t res;
+} mix_cache_565_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -66,6 +106,11 @@ static inline lv_color_t color_blend_true_color_additive(lv_color_t fg, lv_color
 static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
 #endif
 
+#if BLEND_565
+LV_ATTRIBUTE_FAST_MEM static void blend_565(lv_color_t * dest, const lv_color_t * src, lv_color_t color,
+                                            const lv_opa_t * mask, lv_opa_t opa, lv_opa_t mask_full, int32_t len);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -110,6 +155,77 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
     }                                                                                               \
     mask_tmp_x++;
 
+#if BLEND_565 == BLEND_565_SSE2
+typedef __m128i blend_vec_t;
+#define BLEND_VEC_LEN           8
+#define V_LOAD(p)               _mm_loadu_si128((const __m128i *)(p))
+#define V_STORE(p, v)           _mm_storeu_si128((__m128i *)(p), v)
+#define V_LOAD_MASK(p)          _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(p)), _mm_setzero_si128())
+#define V_SET1(x)               _mm_set1_epi16((short)(x))
+#define V_AND(a, b)             _mm_and_si128(a, b)
+#define V_OR(a, b)              _mm_or_si128(a, b)
+#define V_ADD(a, b)             _mm_add_epi16(a, b)
+#define V_SUB(a, b)             _mm_sub_epi16(a, b)
+#define V_MUL(a, b)             _mm_mullo_epi16(a, b)
+#define V_SHR(a, n)             _mm_srli_epi16(a, n)
+#define V_SHL(a, n)             _mm_slli_epi16(a, n)
+#define V_GT(a, b)              _mm_cmpgt_epi16(a, b)   /*Signed but the values are 0..255*/
+#define V_SELECT(c, a, b)       _mm_or_si128(_mm_and_si128(c, a), _mm_andnot_si128(c, b))
+#elif BLEND_565 == BLEND_565_AVX2
+typedef __m256i blend_vec_t;
+#define BLEND_VEC_LEN           16
+#define V_LOAD(p)               _mm256_loadu_si256((const __m256i *)(p))
+#define V_STORE(p, v)           _mm256_storeu_si256((__m256i *)(p), v)
+#define V_LOAD_MASK(p)          _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(p)))
+#define V_SET1(x)               _mm256_set1_epi16((short)(x))
+#define V_AND(a, b)             _mm256_and_si256(a, b)
+#define V_OR(a, b)              _mm256_or_si256(a, b)
+#define V_ADD(a, b)             _mm256_add_epi16(a, b)
+#define V_SUB(a, b)             _mm256_sub_epi16(a, b)
+#define V_MUL(a, b)             _mm256_mullo_epi16(a, b)
+#define V_SHR(a, n)             _mm256_srli_epi16(a, n)
+#define V_SHL(a, n)             _mm256_slli_epi16(a, n)
+#define V_GT(a, b)              _mm256_cmpgt_epi16(a, b)
+#define V_SELECT(c, a, b)       _mm256_blendv_epi8(b, a, c)
+#elif BLEND_565 == BLEND_565_NEON
+typedef uint16x8_t blend_vec_t;
+#define BLEND_VEC_LEN           8
+#define V_LOAD(p)               vld1q_u16((const uint16_t *)(p))
+#define V_STORE(p, v)           vst1q_u16((uint16_t *)(p), v)
+#define V_LOAD_MASK(p)          vmovl_u8(vld1_u8(p))
+#define V_SET1(x)               vdupq_n_u16(x)
+#define V_AND(a, b)             vandq_u16(a, b)
+#define V_OR(a, b)              vorrq_u16(a, b)
+#define V_ADD(a, b)             vaddq_u16(a, b)
+#define V_SUB(a, b)             vsubq_u16(a, b)
+#define V_MUL(a, b)             vmulq_u16(a, b)
+#define V_SHR(a, n)             vshrq_n_u16(a, n)
+#define V_SHL(a, n)             vshlq_n_u16(a, n)
+#define V_GT(a, b)              vcgtq_u16(a, b)
+#define V_SELECT(c, a, b)       vbslq_u16(c, a, b)
+#endif
+
+#if BLEND_565 && BLEND_565 != BLEND_565_SWAR
+/*x / 255 for x < 65535, the same as `LV_MATH_UDIV255`*/
+#define V_DIV255(x)             V_SHR(V_ADD(V_ADD(x, V_SET1(1)), V_SHR(x, 8)), 8)
+
+#if LV_COLOR_16_SWAP
+#define V_LOAD_PX(p)            V_SWAP(V_LOAD(p))
+#define V_STORE_PX(p, v)        V_STORE(p, V_SWAP(v))
+#define V_SWAP(v)               V_OR(V_SHL(v, 8), V_SHR(v, 8))
+#else
+#define V_LOAD_PX(p)            V_LOAD(p)
+#define V_STORE_PX(p, v)        V_STORE(p, v)
+#endif
+#endif
+
+#if BLEND_565 == BLEND_565_SWAR
+/*The same operations on the two 16-bit halves of a word*/
+#define X2(x)                   ((uint32_t)(x) * 0x00010001)
+#define DIV255_X2(x)            ((((x) + X2(1) + (((x) >> 8) & X2(0xFF))) >> 8) & X2(0xFF))
+#define SWAP_X2(x)              ((((x) & X2(0xFF)) << 8) | (((x) >> 8) & X2(0xFF)))
+#endif
+
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
@@ -148,6 +264,7 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_
     bool is_common;
     is_common = _lv_area_intersect(&draw_area, clip_area, fill_area);
     if(!is_common) return;
+    _LV_REFR_PROFILE_START(t_blend);
 
     /* Now `draw_area` has absolute coordinates.
      * Make it relative to `disp_area` to simplify draw to `disp_buf`*/
@@ -156,16 +273,17 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_
     draw_area.x2 -= disp_area->x1;
     draw_area.y2 -= disp_area->y1;
 
-    /*Round the values in the mask if anti-aliasing is disabled*/
+    /*Round the values in the mask if anti-aliasing is disabled.
+     *A changed mask has a row for every row of `draw_area`*/
 #if LV_ANTIALIAS
-    if(mask && disp->driver.antialiasing == 0)
+    if(mask && mask_res == LV_DRAW_MASK_RES_CHANGED && disp->driver.antialiasing == 0)
 #else
-    if(mask)
+    if(mask && mask_res == LV_DRAW_MASK_RES_CHANGED)
 #endif
     {
-        int32_t mask_w = lv_area_get_width(&draw_area);
-        int32_t i;
-        for(i = 0; i < mask_w; i++)  mask[i] = mask[i] > 128 ? LV_OPA_COVER : LV_OPA_TRANSP;
+        uint32_t mask_size = lv_area_get_size(&draw_area);
+        uint32_t i;
+        for(i = 0; i < mask_size; i++)  mask[i] = mask[i] > 128 ? LV_OPA_COVER : LV_OPA_TRANSP;
     }
 
     if(disp->driver.set_px_cb) {
@@ -179,6 +297,11 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_
         fill_blended(disp_area, disp_buf, &draw_area, color, opa, mask, mask_res, mode);
     }
 #endif
+
+#if LV_USE_REFR_PROFILER
+    _LV_REFR_PROFILE_ADD(blend_us, t_blend);
+    _LV_REFR_PROFILE_ACT.px_blend += lv_area_get_size(&draw_area);
+#endif
 }
 
 /**
@@ -209,6 +332,7 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
     bool is_common;
     is_common = _lv_area_intersect(&draw_area, clip_area, map_area);
     if(!is_common) return;
+    _LV_REFR_PROFILE_START(t_blend);
 
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
@@ -224,16 +348,17 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
     draw_area.x2 -= disp_area->x1;
     draw_area.y2 -= disp_area->y1;
 
-    /*Round the values in the mask if anti-aliasing is disabled*/
+    /*Round the values in the mask if anti-aliasing is disabled.
+     *A changed mask has a row for every row of `draw_area`*/
 #if LV_ANTIALIAS
-    if(mask && disp->driver.antialiasing == 0)
+    if(mask && mask_res == LV_DRAW_MASK_RES_CHANGED && disp->driver.antialiasing == 0)
 #else
-    if(mask)
+    if(mask && mask_res == LV_DRAW_MASK_RES_CHANGED)
 #endif
     {
-        int32_t mask_w = lv_area_get_width(&draw_area);
-        int32_t i;
-        for(i = 0; i < mask_w; i++)  mask[i] = mask[i] > 128 ? LV_OPA_COVER : LV_OPA_TRANSP;
+        uint32_t mask_size = lv_area_get_size(&draw_area);
+        uint32_t i;
+        for(i = 0; i < mask_size; i++)  mask[i] = mask[i] > 128 ? LV_OPA_COVER : LV_OPA_TRANSP;
     }
     if(disp->driver.set_px_cb) {
         map_set_px(disp_area, disp_buf, &draw_area, map_area, map_buf, opa, mask, mask_res);
@@ -246,6 +371,11 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
         map_blended(disp_area, disp_buf, &draw_area, map_area, map_buf, opa, mask, mask_res, mode);
     }
 #endif
+
+#if LV_USE_REFR_PROFILER
+    _LV_REFR_PROFILE_ADD(blend_us, t_blend);
+    _LV_REFR_PROFILE_ACT.px_blend += lv_area_get_size(&draw_area);
+#endif
 }
 
 /**********************
@@ -405,6 +535,12 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
                 return;
             }
 #endif
+#if BLEND_565
+            for(y = 0; y < draw_area_h; y++) {
+                blend_565(disp_buf_first, NULL, color, NULL, opa, LV_OPA_COVER, draw_area_w);
+                disp_buf_first += disp_w;
+            }
+#else
             lv_color_t last_dest_color = LV_COLOR_BLACK;
             lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
 
@@ -432,6 +568,7 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
                 }
                 disp_buf_first += disp_w;
             }
+#endif
         }
     }
     /*Masked*/
@@ -444,6 +581,15 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
         }
 #endif
 
+#if BLEND_565
+        /*Only the mask matters if `opa` is `LV_OPA_COVER`*/
+        lv_opa_t mask_opa = opa > LV_OPA_MAX ? LV_OPA_COVER : opa;
+        for(y = 0; y < draw_area_h; y++) {
+            blend_565(disp_buf_first, NULL, color, mask, mask_opa, LV_OPA_COVER, draw_area_w);
+            disp_buf_first += disp_w;
+            mask += draw_area_w;
+        }
+#else
         /*Buffer the result color to avoid recalculating the same color*/
         lv_color_t last_dest_color;
         lv_color_t last_res_color;
@@ -546,6 +692,7 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
                 mask += draw_area_w;
             }
         }
+#endif
     }
 }
 
@@ -731,7 +878,9 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
 #endif
 
+#if BLEND_565 == 0
     int32_t x;
+#endif
     int32_t y;
 
     /*Simple fill (maybe with opacity), no masking*/
@@ -841,7 +990,13 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
 #endif
 
             /*Software rendering*/
-
+#if BLEND_565
+            for(y = 0; y < draw_area_h; y++) {
+                blend_565(disp_buf_first, map_buf_first, LV_COLOR_BLACK, NULL, opa, LV_OPA_COVER, draw_area_w);
+                disp_buf_first += disp_w;
+                map_buf_first += map_w;
+            }
+#else
             for(y = 0; y < draw_area_h; y++) {
                 for(x = 0; x < draw_area_w; x++) {
 #if LV_COLOR_SCREEN_TRANSP
@@ -858,10 +1013,21 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
                 disp_buf_first += disp_w;
                 map_buf_first += map_w;
             }
+#endif
         }
     }
     /*Masked*/
     else {
+#if BLEND_565
+        /*Only the mask matters if `opa` is `LV_OPA_COVER`*/
+        lv_opa_t mask_opa = opa > LV_OPA_MAX ? LV_OPA_COVER : opa;
+        for(y = 0; y < draw_area_h; y++) {
+            blend_565(disp_buf_first, map_buf_first, LV_COLOR_BLACK, mask, mask_opa, LV_OPA_MAX, draw_area_w);
+            disp_buf_first += disp_w;
+            mask += draw_area_w;
+            map_buf_first += map_w;
+        }
+#else
         /*Only the mask matters*/
         if(opa > LV_OPA_MAX) {
             /*Go to the first pixel of the row */
@@ -947,6 +1113,7 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
                 map_buf_first += map_w;
             }
         }
+#endif
     }
 }
 #if LV_USE_BLEND_MODES
@@ -1101,3 +1268,213 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
     return lv_color_mix(fg, bg, opa);
 }
 #endif
+
+#if BLEND_565
+/**
+ * Get the mix ratio of a pixel in `blend_565`
+ */
+LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mix_ratio_565(const lv_opa_t * mask, lv_opa_t opa, lv_opa_t mask_full)
+{
+    if(mask == NULL) return opa;
+    if(opa == LV_OPA_COVER) return *mask;
+    return *mask >= mask_full ? opa : (lv_opa_t)(((uint32_t)(*mask) * opa) >> 8);
+}
+
+#if BLEND_565 == BLEND_565_SWAR
+/**
+ * Mix two pairs of RGB565 pixels stored in 32-bit words with the same ratio
+ */
+LV_ATTRIBUTE_FAST_MEM static inline uint32_t mix_565_x2(uint32_t fg, uint32_t bg, uint32_t mix)
+{
+#if LV_COLOR_16_SWAP
+    fg = SWAP_X2(fg);
+    bg = SWAP_X2(bg);
+#endif
+    uint32_t mix_inv = 255 - mix;
+    uint32_t r = ((fg >> 11) & X2(0x1F)) * mix + ((bg >> 11) & X2(0x1F)) * mix_inv + X2(LV_COLOR_MIX_ROUND_OFS);
+    uint32_t g = ((fg >> 5) & X2(0x3F)) * mix + ((bg >> 5) & X2(0x3F)) * mix_inv + X2(LV_COLOR_MIX_ROUND_OFS);
+    uint32_t b = (fg & X2(0x1F)) * mix + (bg & X2(0x1F)) * mix_inv + X2(LV_COLOR_MIX_ROUND_OFS);
+    uint32_t res = (DIV255_X2(r) << 11) | (DIV255_X2(g) << 5) | DIV255_X2(b);
+#if LV_COLOR_16_SWAP
+    res = SWAP_X2(res);
+#endif
+    return res;
+}
+
+/**
+ * Blend two pixels in a word like `blend_565`
+ * @param dest32 the pixels to mix into
+ * @param src the pixels to mix or NULL
+ * @param color the color to mix if `src == NULL`
+ * @param mask the mask of the pixels or NULL
+ * @param opa see `blend_565`
+ * @param mask_full see `blend_565`
+ * @param cache the last result with a color
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void blend_565_x2(uint32_t * dest32, const lv_color_t * src, lv_color_t color,
+                                                      const lv_opa_t * mask, lv_opa_t opa, lv_opa_t mask_full,
+                                                      mix_cache_565_t * cache)
+{
+    uint32_t mix = opa;
+    if(mask) {
+        mix = mix_ratio_565(&mask[0], opa, mask_full);
+        lv_opa_t mix2 = mix_ratio_565(&mask[1], opa, mask_full);
+        if(mix != mix2) {
+            lv_color_t * dest = (lv_color_t *)dest32;
+            dest[0] = lv_color_mix(src ? src[0] : color, dest[0], mix);
+            dest[1] = lv_color_mix(src ? src[1] : color, dest[1], mix2);
+            return;
+        }
+    }
+
+    if(mix == LV_OPA_TRANSP) return;
+
+    if(src) {
+        uint32_t fg;
+        memcpy(&fg, src, sizeof(fg));
+        *dest32 = mix == LV_OPA_COVER ? fg : mix_565_x2(fg, *dest32, mix);
+    }
+    else if(mix == LV_OPA_COVER) {
+        *dest32 = X2(color.full);
+    }
+    else {
+        /*The same background gives the same result, don't calculate it again*/
+        if(*dest32 != cache->bg || mix != cache->mix) {
+            cache->bg = *dest32;
+            cache->mix = mix;
+            cache->res = mix_565_x2(X2(color.full), cache->bg, cache->mix);
+        }
+        *dest32 = cache->res;
+    }
+}
+#else
+/**
+ * Tell if all the mask values of a vector are the same
+ * @param mask the mask values
+ * @param v 0 or UINT64_MAX
+ */
+LV_ATTRIBUTE_FAST_MEM static inline bool mask_vec_eq(const lv_opa_t * mask, uint64_t v)
+{
+    uint64_t m[BLEND_VEC_LEN / 8];
+    memcpy(m, mask, sizeof(m));
+
+    uint32_t i;
+    for(i = 0; i < BLEND_VEC_LEN / 8; i++) {
+        if(m[i] != v) return false;
+    }
+    return true;
+}
+
+/**
+ * Mix RGB565 pixels (without byte swap) in vectors
+ */
+LV_ATTRIBUTE_FAST_MEM static inline blend_vec_t mix_565_vec(blend_vec_t fg, blend_vec_t bg, blend_vec_t mix)
+{
+    blend_vec_t mix_inv = V_SUB(V_SET1(255), mix);
+    blend_vec_t ofs = V_SET1(LV_COLOR_MIX_ROUND_OFS);
+    blend_vec_t m5 = V_SET1(0x1F);
+    blend_vec_t m6 = V_SET1(0x3F);
+
+    blend_vec_t r = V_ADD(V_ADD(V_MUL(V_SHR(fg, 11), mix), V_MUL(V_SHR(bg, 11), mix_inv)), ofs);
+    blend_vec_t g = V_ADD(V_ADD(V_MUL(V_AND(V_SHR(fg, 5), m6), mix), V_MUL(V_AND(V_SHR(bg, 5), m6), mix_inv)), ofs);
+    blend_vec_t b = V_ADD(V_ADD(V_MUL(V_AND(fg, m5), mix), V_MUL(V_AND(bg, m5), mix_inv)), ofs);
+
+    return V_OR(V_OR(V_SHL(V_DIV255(r), 11), V_SHL(V_DIV255(g), 5)), V_DIV255(b));
+}
+#endif
+
+/**
+ * Mix a row of RGB565 pixels with a color or with an other row.
+ * Gives the same result as `lv_color_mix` on every pixel.
+ * @param dest the pixels to mix into
+ * @param src the pixels to mix, NULL: mix `color`
+ * @param color the color to mix if `src == NULL`
+ * @param mask the mask of the row, NULL: mix every pixel with `opa`
+ * @param opa LV_OPA_COVER: use the mask values as ratio,
+ *            else use `opa` where the mask is at least `mask_full` and `mask * opa >> 8` elsewhere
+ * @param mask_full see `opa`
+ * @param len number of pixels in the row
+ */
+LV_ATTRIBUTE_FAST_MEM static void blend_565(lv_color_t * dest, const lv_color_t * src, lv_color_t color,
+                                            const lv_opa_t * mask, lv_opa_t opa, lv_opa_t mask_full, int32_t len)
+{
+    int32_t x = 0;
+
+#if BLEND_565 == BLEND_565_SWAR
+    /*Align to words*/
+    if(len > 0 && ((lv_uintptr_t)dest & 0x3)) {
+        lv_opa_t mix = mix_ratio_565(mask, opa, mask_full);
+        dest[0] = lv_color_mix(src ? src[0] : color, dest[0], mix);
+        x = 1;
+    }
+
+    uint32_t * dest32 = (uint32_t *)&dest[x];
+    mix_cache_565_t cache;
+    cache.bg = 0;
+    cache.mix = opa;
+    cache.res = mix_565_x2(X2(color.full), cache.bg, cache.mix);
+
+    if(mask == NULL) {
+        for(; x < len - 1; x += 2, dest32++) {
+            blend_565_x2(dest32, src ? &src[x] : NULL, color, NULL, opa, mask_full, &cache);
+        }
+    }
+    else {
+        for(; x < len - 3; x += 4, dest32 += 2) {
+            /*Skip the transparent parts and copy the covered parts of the mask*/
+            uint32_t mask32;
+            memcpy(&mask32, &mask[x], sizeof(mask32));
+            if(mask32 == 0) continue;
+            if(mask32 == 0xFFFFFFFF && opa == LV_OPA_COVER) {
+                if(src) {
+                    memcpy(dest32, &src[x], 4 * sizeof(lv_color_t));
+                }
+                else {
+                    dest32[0] = X2(color.full);
+                    dest32[1] = X2(color.full);
+                }
+                continue;
+            }
+
+            blend_565_x2(dest32, src ? &src[x] : NULL, color, &mask[x], opa, mask_full, &cache);
+            blend_565_x2(dest32 + 1, src ? &src[x + 2] : NULL, color, &mask[x + 2], opa, mask_full, &cache);
+        }
+
+        if(x < len - 1) {
+            blend_565_x2(dest32, src ? &src[x] : NULL, color, &mask[x], opa, mask_full, &cache);
+            x += 2;
+        }
+    }
+#else
+    /*The same color in every lane*/
+    uint32_t c = ((uint32_t)LV_COLOR_GET_R(color) << 11) | (LV_COLOR_GET_G(color) << 5) | LV_COLOR_GET_B(color);
+    blend_vec_t fg = V_SET1(c);
+    blend_vec_t mix = V_SET1(opa);
+    blend_vec_t v_opa = V_SET1(opa);
+    blend_vec_t v_full = V_SET1(mask_full - 1);
+
+    for(; x <= len - BLEND_VEC_LEN; x += BLEND_VEC_LEN) {
+        if(mask) {
+            /*Skip the transparent parts and copy the covered parts of the mask*/
+            if(mask_vec_eq(&mask[x], 0)) continue;
+            if(opa == LV_OPA_COVER && mask_vec_eq(&mask[x], UINT64_MAX)) {
+                if(src) V_STORE(&dest[x], V_LOAD(&src[x]));
+                else V_STORE_PX(&dest[x], fg);
+                continue;
+            }
+
+            mix = V_LOAD_MASK(&mask[x]);
+            if(opa != LV_OPA_COVER) mix = V_SELECT(V_GT(mix, v_full), v_opa, V_SHR(V_MUL(mix, v_opa), 8));
+        }
+        if(src) fg = V_LOAD_PX(&src[x]);
+        V_STORE_PX(&dest[x], mix_565_vec(fg, V_LOAD_PX(&dest[x]), mix));
+    }
+#endif
+
+    /*The remaining pixels*/
+    for(; x < len; x++) {
+        lv_opa_t mix_px = mix_ratio_565(mask ? &mask[x] : NULL, opa, mask_full);
+        dest[x] = lv_color_mix(src ? src[x] : color, dest[x], mix_px);
+    }
+}
+#endif
@@ -81,8 +81,12 @@ void lv_draw_img(const lv_area_t * coords, const lv_area_t * mask, const void *
 
     if(dsc->opa <= LV_OPA_MIN) return;
 
+    /*The image cache and the decoders are shared by the bands rendered in parallel.
+     *An opened image can be closed by an other band so draw it while holding the lock.*/
     lv_res_t res;
+    _lv_refr_lock();
     res = lv_img_draw_core(coords, mask, src, dsc);
+    _lv_refr_unlock();
 
     if(res == LV_RES_INV) {
         LV_LOG_WARN("Image draw error");
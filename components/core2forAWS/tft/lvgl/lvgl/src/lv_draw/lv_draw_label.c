@@ -124,14 +124,28 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     /*No need to waste processor time if string is empty*/
     if(txt[0] == '\0')  return;
 
+#if LV_REFR_PARALLEL > 1
+    /*The bands rendered in parallel would update the same hint*/
+    if(_lv_refr_get_band()) hint = NULL;
+#endif
+
     lv_area_t clipped_area;
     bool clip_ok = _lv_area_intersect(&clipped_area, coords, mask);
     if(!clip_ok) return;
 
+    /*Use the lines laid out earlier if they belong to this text*/
+    const lv_txt_layout_t * layout = dsc->layout;
+    if(layout && !_lv_txt_layout_is_valid(layout, txt, font, dsc->letter_space, lv_area_get_width(coords), dsc->flag)) {
+        layout = NULL;
+    }
+
     if((dsc->flag & LV_TXT_FLAG_EXPAND) == 0) {
         /*Normally use the label's width as width*/
         w = lv_area_get_width(coords);
     }
+    else if(layout) {
+        w = layout->w;
+    }
     else {
         /*If EXAPND is enabled then not limit the text's width to the object's width*/
         lv_point_t p;
@@ -156,10 +170,24 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     pos.y += y_ofs;
 
     uint32_t line_start     = 0;
+    uint32_t line_end;
+    uint32_t line_id        = 0;
     int32_t last_line_start = -1;
 
+    /*With a layout jump to the first visible line*/
+    if(layout) {
+        if(pos.y + line_height_font < mask->y1) {
+            if(line_height <= 0) return;
+            line_id = (mask->y1 - pos.y - line_height_font + line_height - 1) / line_height;
+            pos.y += line_id * line_height;
+        }
+        if(line_id >= layout->line_cnt) return;
+
+        line_start = layout->lines[line_id].start;
+        line_end = _lv_txt_layout_get_line_end(layout, line_id);
+    }
     /*Check the hint to use the cached info*/
-    if(hint && y_ofs == 0 && coords->y1 < 0) {
+    else if(hint && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
         if(LV_MATH_ABS(hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
             hint->line_start = -1;
@@ -173,10 +201,12 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
         pos.y += hint->y;
     }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+    if(layout == NULL) {
+        line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+    }
 
     /*Go the first visible line*/
-    while(pos.y + line_height_font < mask->y1) {
+    while(layout == NULL && pos.y + line_height_font < mask->y1) {
         /*Go to next line*/
         line_start = line_end;
         line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
@@ -194,14 +224,16 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 
     /*Align to middle*/
     if(dsc->flag & LV_TXT_FLAG_CENTER) {
-        line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        if(layout) line_width = layout->lines[line_id].w;
+        else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(dsc->flag & LV_TXT_FLAG_RIGHT) {
-        line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        if(layout) line_width = layout->lines[line_id].w;
+        else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -244,7 +276,9 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
         i         = 0;
 #if LV_USE_BIDI
         char * bidi_txt = _lv_mem_buf_get(line_end - line_start + 1);
+        _lv_refr_lock();    /*The bracket stack of the algorithm is shared by the bands*/
         _lv_bidi_process_paragraph(txt + line_start, bidi_txt, line_end - line_start, dsc->bidi_dir, NULL, 0);
+        _lv_refr_unlock();
 #else
         const char * bidi_txt = txt + line_start;
 #endif
@@ -255,7 +289,9 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 #if LV_USE_BIDI
                 logical_char_pos = _lv_txt_encoded_get_char_id(txt, line_start);
                 uint32_t t = _lv_txt_encoded_get_char_id(bidi_txt, i);
+                _lv_refr_lock();
                 logical_char_pos += _lv_bidi_get_logical_pos(bidi_txt, NULL, line_end - line_start, dsc->bidi_dir, t, NULL);
+                _lv_refr_unlock();
 #else
                 logical_char_pos = _lv_txt_encoded_get_char_id(txt, line_start + i);
 #endif
@@ -355,21 +391,28 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        if(layout) {
+            line_id++;
+            if(line_id >= layout->line_cnt) break;
+            line_end = _lv_txt_layout_get_line_end(layout, line_id);
+        }
+        else {
+            line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(dsc->flag & LV_TXT_FLAG_CENTER) {
-            line_width =
-                _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            if(layout) line_width = layout->lines[line_id].w;
+            else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(dsc->flag & LV_TXT_FLAG_RIGHT) {
-            line_width =
-                _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            if(layout) line_width = layout->lines[line_id].w;
+            else line_width = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -433,7 +476,28 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_letter(const lv_point_t * pos_p, const
         return;
     }
 
-    const uint8_t * map_p = lv_font_get_glyph_bitmap(font_p, letter);
+    const uint8_t * map_p;
+#if LV_REFR_PARALLEL > 1
+    uint8_t * map_copy = NULL;
+    if(_lv_refr_get_band()) {
+        /*The bitmap can be in a buffer of the font which the other bands overwrite so draw a copy of it*/
+        uint32_t map_bpp = g.bpp == 3 ? 4 : g.bpp;
+        uint32_t map_size = (g.box_w * g.box_h * map_bpp + 7) >> 3;
+        _lv_refr_lock();
+        map_p = lv_font_get_glyph_bitmap(font_p, letter);
+        if(map_p) {
+            map_copy = _lv_mem_buf_get(map_size);
+            if(map_copy) _lv_memcpy(map_copy, map_p, map_size);
+            map_p = map_copy;
+        }
+        _lv_refr_unlock();
+    }
+    else {
+        map_p = lv_font_get_glyph_bitmap(font_p, letter);
+    }
+#else
+    map_p = lv_font_get_glyph_bitmap(font_p, letter);
+#endif
     if(map_p == NULL) {
         LV_LOG_WARN("lv_draw_letter: character's bitmap not found");
         return;
@@ -445,6 +509,10 @@ LV_ATTRIBUTE_FAST_MEM static void lv_draw_letter(const lv_point_t * pos_p, const
     else {
         draw_letter_normal(pos_x, pos_y, &g, clip_area, map_p, color, opa, blend_mode);
     }
+
+#if LV_REFR_PARALLEL > 1
+    if(map_copy) _lv_mem_buf_release(map_copy);
+#endif
 }
 
 LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_dsc_t * g,
@@ -487,16 +555,25 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
     static lv_opa_t opa_table[256];
     static lv_opa_t prev_opa = LV_OPA_TRANSP;
     static uint32_t prev_bpp = 0;
+#if LV_REFR_PARALLEL > 1
+    /*The bands rendered in parallel can't share the table*/
+    lv_opa_t band_opa_table[256];
+    lv_opa_t * opa_table_p = _lv_refr_get_band() ? band_opa_table : opa_table;
+#else
+    lv_opa_t * opa_table_p = opa_table;
+#endif
     if(opa < LV_OPA_MAX) {
-        if(prev_opa != opa || prev_bpp != bpp) {
+        if(opa_table_p != opa_table || prev_opa != opa || prev_bpp != bpp) {
             uint32_t i;
             for(i = 0; i < shades; i++) {
-                opa_table[i] = bpp_opa_table_p[i] == LV_OPA_COVER ? opa : ((bpp_opa_table_p[i] * opa) >> 8);
+                opa_table_p[i] = bpp_opa_table_p[i] == LV_OPA_COVER ? opa : ((bpp_opa_table_p[i] * opa) >> 8);
             }
         }
-        bpp_opa_table_p = opa_table;
-        prev_opa = opa;
-        prev_bpp = bpp;
+        bpp_opa_table_p = opa_table_p;
+        if(opa_table_p == opa_table) {
+            prev_opa = opa;
+            prev_bpp = bpp;
+        }
     }
 
     int32_t col, row;
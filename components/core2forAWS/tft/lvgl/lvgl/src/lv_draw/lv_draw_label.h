@@ -42,6 +42,7 @@ typedef struct {
     lv_txt_flag_t flag;
     lv_text_decor_t decor;
     lv_blend_mode_t blend_mode;
+    const lv_txt_layout_t * layout; /*Lines of the text laid out earlier. Used only if it's valid for the text and `flag`*/
 } lv_draw_label_dsc_t;
 
 /** Store some info to speed up drawing of very large texts
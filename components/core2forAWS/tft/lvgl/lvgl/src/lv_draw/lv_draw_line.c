@@ -16,6 +16,7 @@
 /*********************
  *      DEFINES
  *********************/
+#define POLYLINE_MAX_LEN    4096    /*Longer segments are drawn by `lv_draw_line()` to keep the fixed point math in range*/
 
 /**********************
  *      TYPEDEFS
@@ -33,6 +34,10 @@ LV_ATTRIBUTE_FAST_MEM static void draw_line_hor(const lv_point_t * point1, const
 LV_ATTRIBUTE_FAST_MEM static void draw_line_ver(const lv_point_t * point1, const lv_point_t * point2,
                                                 const lv_area_t * clip,
                                                 const lv_draw_line_dsc_t * dsc);
+static bool polyline_is_simple(const lv_draw_line_dsc_t * dsc);
+LV_ATTRIBUTE_FAST_MEM static void draw_line_aa(const lv_point_t * point1, const lv_point_t * point2,
+                                               const lv_area_t * clip, lv_disp_buf_t * vdb,
+                                               const lv_draw_line_dsc_t * dsc);
 
 /**********************
  *  STATIC VARIABLES
@@ -112,10 +117,144 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_line(const lv_point_t * point1, const lv_poin
     }
 }
 
+/**
+ * Draw a polyline.
+ * 1 and 2 px wide lines are drawn by an anti-aliased (Xiaolin Wu like) kernel directly into the draw buffer.
+ * Wider, dashed and rounded lines, other masks and blend modes fall back to `lv_draw_line()` per segment.
+ * @param points the points of the polyline
+ * @param point_cnt number of points
+ * @param clip the polyline will be drawn only in this area
+ * @param dsc pointer to an initialized `lv_draw_line_dsc_t` variable
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_draw_polyline(const lv_point_t points[], uint16_t point_cnt, const lv_area_t * clip,
+                                            const lv_draw_line_dsc_t * dsc)
+{
+    if(point_cnt < 2) return;
+    if(dsc->width == 0) return;
+    if(dsc->opa <= LV_OPA_MIN) return;
+
+    uint16_t i;
+    if(!polyline_is_simple(dsc)) {
+        for(i = 1; i < point_cnt; i++) lv_draw_line(&points[i - 1], &points[i], clip, dsc);
+        return;
+    }
+
+    lv_disp_t * disp    = _lv_refr_get_disp_refreshing();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+
+    lv_area_t clip_buf;
+    if(!_lv_area_intersect(&clip_buf, clip, &vdb->area)) return;
+
+    if(disp->driver.gpu_wait_cb) disp->driver.gpu_wait_cb(&disp->driver);
+
+    for(i = 1; i < point_cnt; i++) {
+        const lv_point_t * p1 = &points[i - 1];
+        const lv_point_t * p2 = &points[i];
+        if(LV_MATH_ABS(p2->x - p1->x) > POLYLINE_MAX_LEN || LV_MATH_ABS(p2->y - p1->y) > POLYLINE_MAX_LEN) {
+            lv_draw_line(p1, p2, clip, dsc);
+        }
+        else {
+            _LV_REFR_PROFILE_START(t_blend);
+            draw_line_aa(p1, p2, &clip_buf, vdb, dsc);
+            _LV_REFR_PROFILE_ADD(blend_us, t_blend);
+        }
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Tell whether a polyline can be drawn by `draw_line_aa()`
+ */
+static bool polyline_is_simple(const lv_draw_line_dsc_t * dsc)
+{
+#if LV_ANTIALIAS == 0 || LV_COLOR_SCREEN_TRANSP
+    LV_UNUSED(dsc);
+    return false;
+#else
+    if(dsc->width > 2) return false;
+    if(dsc->dash_width && dsc->dash_gap) return false;
+    if(dsc->round_start || dsc->round_end) return false;
+    if(dsc->blend_mode != LV_BLEND_MODE_NORMAL) return false;
+    if(lv_draw_mask_get_cnt()) return false;
+
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp->driver.set_px_cb || disp->driver.antialiasing == 0) return false;
+
+    return true;
+#endif
+}
+
+/**
+ * Draw a segment of a thin polyline directly into the draw buffer.
+ * It steps along the major axis and covers the line's thickness on the minor axis
+ * with the opacity of the covered part of each pixel (like Xiaolin Wu's algorithm, but with width).
+ * Like with `lv_draw_line()` the greater end on the major axis is left for the next segment.
+ * @param clip clip area, inside the draw buffer
+ */
+LV_ATTRIBUTE_FAST_MEM static void draw_line_aa(const lv_point_t * point1, const lv_point_t * point2,
+                                               const lv_area_t * clip, lv_disp_buf_t * vdb,
+                                               const lv_draw_line_dsc_t * dsc)
+{
+    int32_t dx = point2->x - point1->x;
+    int32_t dy = point2->y - point1->y;
+    if(dx == 0 && dy == 0) return;
+
+    /*Step on `u` (the major axis) from the smaller end and cover `v` (the minor axis)*/
+    bool x_major = LV_MATH_ABS(dx) >= LV_MATH_ABS(dy);
+    int32_t du = x_major ? dx : dy;
+    const lv_point_t * start = du > 0 ? point1 : point2;
+    int32_t u1 = x_major ? start->x : start->y;
+    int32_t v1 = x_major ? start->y : start->x;
+    int32_t u_len = LV_MATH_ABS(du);
+    int32_t dv = du > 0 ? (x_major ? dy : dx) : -(x_major ? dy : dx);
+    int32_t v_min = (x_major ? clip->y1 : clip->x1) - v1;
+    int32_t v_max = (x_major ? clip->y2 : clip->x2) - v1;
+
+    /*Limit the steps to the clip area*/
+    int32_t step = LV_MATH_MAX(0, (x_major ? clip->x1 : clip->y1) - u1);
+    int32_t step_end = LV_MATH_MIN(u_len, (x_major ? clip->x2 : clip->y2) - u1 + 1);
+    if(step >= step_end) return;
+
+    /*The coordinates of `v` are in 1/65536 px relative to `v1`.
+     *The thickness on `v` is `width / cos(angle)`. Like with `lv_draw_line()`
+     *odd widths are centered on the pixels and even widths between them,
+     *and the line runs from the start of the first step to the start of the end point's step,
+     *so it's sampled in the middle of the steps.*/
+    lv_sqrt_res_t len;
+    _lv_sqrt(dx * dx + dy * dy, &len, 0x8000);
+    int32_t thick = (((int32_t)dsc->width * ((len.i << 8) + len.f)) << 8) / u_len;
+    int32_t slope = (dv << 16) / u_len;
+    int32_t center = slope * step + slope / 2 + ((dsc->width & 1) ? 0x8000 : 0);
+
+    lv_opa_t opa = dsc->opa > LV_OPA_MAX ? LV_OPA_COVER : dsc->opa;
+    lv_color_t color = dsc->color;
+    int32_t buf_w = lv_area_get_width(&vdb->area);
+    lv_color_t * buf = vdb->buf_act;
+    int32_t u_ofs = (x_major ? vdb->area.x1 : vdb->area.y1);
+    int32_t v_ofs = (x_major ? vdb->area.y1 : vdb->area.x1) - v1;
+    int32_t u_stride = x_major ? 1 : buf_w;
+    int32_t v_stride = x_major ? buf_w : 1;
+
+    for(; step < step_end; step++, center += slope) {
+        int32_t u = u1 + step;
+        int32_t lo = center - thick / 2;
+        int32_t hi = center + thick / 2;
+        int32_t v = LV_MATH_MAX(lo >> 16, v_min);
+        int32_t v_last = LV_MATH_MIN((hi - 1) >> 16, v_max);
+        lv_color_t * px = &buf[(u - u_ofs) * u_stride + (v - v_ofs) * v_stride];
+
+        for(; v <= v_last; v++, px += v_stride) {
+            int32_t cover = LV_MATH_MIN(hi, (v + 1) << 16) - LV_MATH_MAX(lo, v << 16);
+            lv_opa_t px_opa = (cover * opa) >> 16;
+            if(px_opa >= LV_OPA_MAX) *px = color;
+            else if(px_opa > LV_OPA_MIN) *px = lv_color_mix(color, *px, px_opa);
+        }
+    }
+}
+
 LV_ATTRIBUTE_FAST_MEM static void draw_line_hor(const lv_point_t * point1, const lv_point_t * point2,
                                                 const lv_area_t * clip,
                                                 const lv_draw_line_dsc_t * dsc)
@@ -49,6 +49,18 @@ typedef struct {
 LV_ATTRIBUTE_FAST_MEM void lv_draw_line(const lv_point_t * point1, const lv_point_t * point2, const lv_area_t * clip,
                                         const lv_draw_line_dsc_t * dsc);
 
+/**
+ * Draw a polyline.
+ * 1 and 2 px wide lines are drawn by an anti-aliased (Xiaolin Wu like) kernel directly into the draw buffer.
+ * Wider, dashed and rounded lines, other masks and blend modes fall back to `lv_draw_line()` per segment.
+ * @param points the points of the polyline
+ * @param point_cnt number of points
+ * @param clip the polyline will be drawn only in this area
+ * @param dsc pointer to an initialized `lv_draw_line_dsc_t` variable
+ */
+LV_ATTRIBUTE_FAST_MEM void lv_draw_polyline(const lv_point_t points[], uint16_t point_cnt, const lv_area_t * clip,
+                                            const lv_draw_line_dsc_t * dsc);
+
 LV_ATTRIBUTE_FAST_MEM void lv_draw_line_dsc_init(lv_draw_line_dsc_t * dsc);
 
 //! @endcond
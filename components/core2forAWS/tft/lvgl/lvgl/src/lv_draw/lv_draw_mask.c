@@ -11,6 +11,7 @@
 #include "../lv_misc/lv_log.h"
 #include "../lv_misc/lv_debug.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_core/lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -57,6 +58,13 @@ LV_ATTRIBUTE_FAST_MEM static inline void sqrt_approx(lv_sqrt_res_t * q, lv_sqrt_
  *      MACROS
  **********************/
 
+#if LV_REFR_PARALLEL > 1
+/*The bands rendered in parallel have their own masks*/
+#define MASK_LIST()     (_lv_refr_get_band() ? _lv_refr_get_band()->mask_list : LV_GC_ROOT(_lv_draw_mask_list))
+#else
+#define MASK_LIST()     LV_GC_ROOT(_lv_draw_mask_list)
+#endif
+
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
@@ -69,10 +77,11 @@ LV_ATTRIBUTE_FAST_MEM static inline void sqrt_approx(lv_sqrt_res_t * q, lv_sqrt_
  */
 int16_t lv_draw_mask_add(void * param, void * custom_id)
 {
+    _lv_draw_mask_saved_t * list = MASK_LIST();
     /*Look for a free entry*/
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).param == NULL) break;
+        if(list[i].param == NULL) break;
     }
 
     if(i >= _LV_MASK_MAX_NUM) {
@@ -80,8 +89,8 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
         return LV_MASK_ID_INV;
     }
 
-    LV_GC_ROOT(_lv_draw_mask_list[i]).param = param;
-    LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id = custom_id;
+    list[i].param = param;
+    list[i].custom_id = custom_id;
 
     return i;
 }
@@ -103,7 +112,7 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf,
     bool changed = false;
     lv_draw_mask_common_dsc_t * dsc;
 
-    _lv_draw_mask_saved_t * m = LV_GC_ROOT(_lv_draw_mask_list);
+    _lv_draw_mask_saved_t * m = MASK_LIST();
 
     while(m->param) {
         dsc = m->param;
@@ -126,12 +135,13 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf,
  */
 void * lv_draw_mask_remove_id(int16_t id)
 {
+    _lv_draw_mask_saved_t * list = MASK_LIST();
     void * p = NULL;
 
     if(id != LV_MASK_ID_INV) {
-        p = LV_GC_ROOT(_lv_draw_mask_list[id]).param;
-        LV_GC_ROOT(_lv_draw_mask_list[id]).param = NULL;
-        LV_GC_ROOT(_lv_draw_mask_list[id]).custom_id = NULL;
+        p = list[id].param;
+        list[id].param = NULL;
+        list[id].custom_id = NULL;
     }
 
     return p;
@@ -145,13 +155,14 @@ void * lv_draw_mask_remove_id(int16_t id)
  */
 void * lv_draw_mask_remove_custom(void * custom_id)
 {
+    _lv_draw_mask_saved_t * list = MASK_LIST();
     void * p = NULL;
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id == custom_id) {
-            p = LV_GC_ROOT(_lv_draw_mask_list[i]).param;
-            LV_GC_ROOT(_lv_draw_mask_list[i]).param = NULL;
-            LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id = NULL;
+        if(list[i].custom_id == custom_id) {
+            p = list[i].param;
+            list[i].param = NULL;
+            list[i].custom_id = NULL;
         }
     }
     return p;
@@ -163,10 +174,11 @@ void * lv_draw_mask_remove_custom(void * custom_id)
  */
 LV_ATTRIBUTE_FAST_MEM uint8_t lv_draw_mask_get_cnt(void)
 {
+    _lv_draw_mask_saved_t * list = MASK_LIST();
     uint8_t cnt = 0;
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).param) cnt++;
+        if(list[i].param) cnt++;
     }
     return cnt;
 }
@@ -13,6 +13,7 @@
 #include "../lv_misc/lv_txt_ap.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_debug.h"
+#include <string.h>
 
 /*********************
  *      DEFINES
@@ -21,9 +22,22 @@
 #define SHADOW_ENHANCE          1
 #define SPLIT_LIMIT             50
 
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+#define SHADOW_CACHE_ENTRY_NUM  8
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+/*A blurred corner stored in `sh_cache_buf`. The entries are in the order of their corners in the buffer.*/
+typedef struct {
+    uint32_t ofs;       /*Start of the corner in `sh_cache_buf`*/
+    uint32_t life;      /*Value of `sh_cache_life` at the last use. The smallest is evicted first.*/
+    uint16_t size;      /*Width and height of the corner: `shadow_width + radius`*/
+    uint16_t r;         /*Radius of the shadow*/
+} sh_cache_entry_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -42,6 +56,11 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
 LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coords,  uint16_t * sh_buf, lv_coord_t s,
                                                          lv_coord_t r);
 LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
+#if LV_SHADOW_CACHE_SIZE
+    static int32_t shadow_cache_find(int32_t size, int32_t r);
+    static void shadow_cache_add(int32_t size, int32_t r, const lv_opa_t * sh_buf);
+    static void shadow_cache_evict(int32_t id);
+#endif
 #endif
 
 #if LV_USE_PATTERN
@@ -59,9 +78,12 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(const lv_draw_rect_dsc_t
  *  STATIC VARIABLES
  **********************/
 #if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
-    static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
+    static uint8_t sh_cache_buf[LV_SHADOW_CACHE_BYTES];
+    static sh_cache_entry_t sh_cache[SHADOW_CACHE_ENTRY_NUM];
+    static uint32_t sh_cache_cnt;
+    static uint32_t sh_cache_used;      /*Bytes of `sh_cache_buf` used by the corners*/
+    static uint32_t sh_cache_life;
+    static lv_draw_shadow_cache_stats_t sh_cache_stats;
 #endif
 
 /**********************
@@ -160,6 +182,31 @@ void lv_draw_px(const lv_point_t * point, const lv_area_t * clip_area, const lv_
     //    }
 }
 
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+/**
+ * Get the counters of the shadow corner cache.
+ * @param stats store the counters here
+ */
+void lv_draw_rect_get_shadow_cache_stats(lv_draw_shadow_cache_stats_t * stats)
+{
+    _lv_refr_lock();
+    _lv_memcpy_small(stats, &sh_cache_stats, sizeof(lv_draw_shadow_cache_stats_t));
+    stats->entries = sh_cache_cnt;
+    stats->bytes = sh_cache_used;
+    _lv_refr_unlock();
+}
+
+/**
+ * Reset the counters of the shadow corner cache. The cached corners are kept.
+ */
+void lv_draw_rect_reset_shadow_cache_stats(void)
+{
+    _lv_refr_lock();
+    _lv_memset_00(&sh_cache_stats, sizeof(sh_cache_stats));
+    _lv_refr_unlock();
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -591,21 +638,39 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
     lv_opa_t * sh_buf;
 
 #if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = _lv_mem_buf_get(corner_size * corner_size);
-        _lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
+    /*The corner depends only on its size and radius (the spread is already in `r_sh`)
+     *unless the rectangle is so small that its other sides get into the corner too*/
+    bool cacheable = corner_size <= LV_SHADOW_CACHE_SIZE &&
+                     (uint32_t)corner_size * corner_size <= LV_SHADOW_CACHE_BYTES &&
+                     lv_area_get_width(&sh_rect_area) >= corner_size &&
+                     lv_area_get_height(&sh_rect_area) >= corner_size;
+
+    sh_buf = NULL;
+    _lv_refr_lock();    /*The cache is shared by the bands rendered in parallel*/
+    sh_cache_stats.lookups++;
+    if(cacheable) {
+        int32_t id = shadow_cache_find(corner_size, r_sh);
+        if(id >= 0) {
+            sh_cache_stats.hits++;
+            sh_cache[id].life = ++sh_cache_life;
+            sh_buf = _lv_mem_buf_get(corner_size * corner_size);
+            _lv_memcpy(sh_buf, &sh_cache_buf[sh_cache[id].ofs], corner_size * corner_size);
+        }
     }
     else {
-        /*A larger buffer is required for calculation */
+        sh_cache_stats.rejections++;
+    }
+    _lv_refr_unlock();
+
+    if(sh_buf == NULL) {
+        /*A larger buffer is required for calculation. Don't block the other bands meanwhile.*/
         sh_buf = _lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
         shadow_draw_corner_buf(&sh_rect_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
 
-        /*Cache the corner if it fits into the cache size*/
-        if(corner_size * corner_size < sizeof(sh_cache)) {
-            _lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
-            sh_cache_size = corner_size;
-            sh_cache_r = r_sh;
+        if(cacheable) {
+            _lv_refr_lock();
+            shadow_cache_add(corner_size, r_sh, sh_buf);
+            _lv_refr_unlock();
         }
     }
 #else
@@ -1157,6 +1222,75 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t
     _lv_mem_buf_release(sh_ups_blur_buf);
 }
 
+#if LV_SHADOW_CACHE_SIZE
+/**
+ * Find a corner in the shadow cache
+ * @param size width and height of the corner
+ * @param r radius of the shadow
+ * @return index of the entry or -1 if not cached
+ */
+static int32_t shadow_cache_find(int32_t size, int32_t r)
+{
+    uint32_t i;
+    for(i = 0; i < sh_cache_cnt; i++) {
+        if(sh_cache[i].size == size && sh_cache[i].r == r) return i;
+    }
+
+    return -1;
+}
+
+/**
+ * Add a corner to the shadow cache. The least recently used corners are evicted until it fits.
+ * @param size width and height of the corner
+ * @param r radius of the shadow
+ * @param sh_buf the blurred corner, `size * size` opacity values
+ */
+static void shadow_cache_add(int32_t size, int32_t r, const lv_opa_t * sh_buf)
+{
+    /*An other band might have added it meanwhile*/
+    if(shadow_cache_find(size, r) >= 0) return;
+
+    uint32_t bytes = size * size;
+    while(sh_cache_cnt == SHADOW_CACHE_ENTRY_NUM || sh_cache_used + bytes > LV_SHADOW_CACHE_BYTES) {
+        uint32_t lru = 0;
+        uint32_t i;
+        for(i = 1; i < sh_cache_cnt; i++) {
+            if(sh_cache[i].life < sh_cache[lru].life) lru = i;
+        }
+        shadow_cache_evict(lru);
+    }
+
+    sh_cache_entry_t * e = &sh_cache[sh_cache_cnt];
+    e->ofs = sh_cache_used;
+    e->life = ++sh_cache_life;
+    e->size = size;
+    e->r = r;
+    _lv_memcpy(&sh_cache_buf[e->ofs], sh_buf, bytes);
+    sh_cache_used += bytes;
+    sh_cache_cnt++;
+}
+
+/**
+ * Remove a corner from the shadow cache and move the next corners to its place
+ * @param id index of the entry
+ */
+static void shadow_cache_evict(int32_t id)
+{
+    uint32_t bytes = sh_cache[id].size * sh_cache[id].size;
+    uint32_t end = sh_cache[id].ofs + bytes;
+    memmove(&sh_cache_buf[sh_cache[id].ofs], &sh_cache_buf[end], sh_cache_used - end);
+    sh_cache_used -= bytes;
+
+    uint32_t i;
+    for(i = id; i + 1 < sh_cache_cnt; i++) {
+        sh_cache[i] = sh_cache[i + 1];
+        sh_cache[i].ofs -= bytes;
+    }
+    sh_cache_cnt--;
+    sh_cache_stats.evictions++;
+}
+#endif
+
 #endif
 
 #if LV_USE_OUTLINE
@@ -81,6 +81,16 @@ typedef struct {
     lv_blend_mode_t value_blend_mode;
 } lv_draw_rect_dsc_t;
 
+/*Counters of the shadow corner cache (`LV_SHADOW_CACHE_SIZE`)*/
+typedef struct {
+    uint32_t lookups;       /*Corners looked up*/
+    uint32_t hits;          /*Lookups found in the cache*/
+    uint32_t evictions;     /*Corners dropped to make room for new ones*/
+    uint32_t rejections;    /*Corners not cached because they don't fit into the cache*/
+    uint32_t entries;       /*Corners in the cache now*/
+    uint32_t bytes;         /*Bytes of the corners in the cache now*/
+} lv_draw_shadow_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -105,6 +115,19 @@ void lv_draw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_dra
  */
 void lv_draw_px(const lv_point_t * point, const lv_area_t * clip_area, const lv_style_t * style);
 
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+/**
+ * Get the counters of the shadow corner cache.
+ * @param stats store the counters here
+ */
+void lv_draw_rect_get_shadow_cache_stats(lv_draw_shadow_cache_stats_t * stats);
+
+/**
+ * Reset the counters of the shadow corner cache. The cached corners are kept.
+ */
+void lv_draw_rect_reset_shadow_cache_stats(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -16,9 +16,6 @@
 /*********************
  *      DEFINES
  *********************/
-/*Decrement life with this value on every open*/
-#define LV_IMG_CACHE_AGING 1
-
 /*Boost life by this factor (multiply time_to_open with this value)*/
 #define LV_IMG_CACHE_LIFE_GAIN 1
 
@@ -26,6 +23,8 @@
  * "die" from very high values */
 #define LV_IMG_CACHE_LIFE_LIMIT 1000
 
+#define ENTRY_NONE  0xFFFF  /*Invalid entry index*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,17 +34,31 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static bool lv_img_cache_match(const void * src1, const void * src2);
-#endif
-
-#if LV_IMG_CACHE_DEF_SIZE == 0
-    static lv_img_cache_entry_t cache_temp;
+    static uint32_t src_hash(const void * src, lv_color_t color);
+    static uint32_t decoded_size(const lv_img_decoder_dsc_t * dsc);
+    static uint16_t index_find(const void * src, lv_color_t color, uint32_t hash);
+    static void index_insert(uint16_t id);
+    static void index_remove(uint16_t id);
+    static void lru_unlink(uint16_t id);
+    static void lru_link_front(uint16_t id);
+    static void entry_evict(uint16_t id);
+    static void temp_close(void);
 #endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_img_cache_entry_t cache_temp;     /*The images not in the cache are opened here*/
+
 #if LV_IMG_CACHE_DEF_SIZE
     static uint16_t entry_cnt;
+    static uint16_t * cache_index;          /*Open addressing hash table of the cached entries*/
+    static uint32_t index_mask;             /*Size of `cache_index` - 1*/
+    static uint16_t lru_first;              /*Most recently used entry*/
+    static uint16_t lru_last;               /*Least recently used entry*/
+    static uint16_t free_first;             /*Chain of the empty entries*/
+    static uint32_t cache_capacity = LV_IMG_CACHE_DEF_BYTES;
+    static lv_img_cache_stats_t cache_stats;
 #endif
 
 /**********************
@@ -66,7 +79,6 @@
  */
 lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
 {
-    /*Is the image cached?*/
     lv_img_cache_entry_t * cached_src = NULL;
 
 #if LV_IMG_CACHE_DEF_SIZE
@@ -77,62 +89,41 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
 
     lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
 
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
-        }
-    }
-
-    for(i = 0; i < entry_cnt; i++) {
-        if(color.full == cache[i].dec_dsc.color.full &&
-           lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            /* If opened increment its life.
-             * Image difficult to open should live longer to keep avoid frequent their recaching.
-             * Therefore increase `life` with `time_to_open`*/
-            cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
-            LV_LOG_TRACE("image draw: image found in the cache");
-            break;
+    /*Is the image cached?*/
+    uint32_t hash = src_hash(src, color);
+    uint16_t id = index_find(src, color, hash);
+    if(id != ENTRY_NONE) {
+        /* Image difficult to open should live longer to keep avoid frequent their recaching.
+         * Therefore set `life` to `time_to_open`*/
+        cached_src = &cache[id];
+        cached_src->life = cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
+        if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
+        if(id != lru_first) {
+            lru_unlink(id);
+            lru_link_front(id);
         }
+        cache_stats.hits++;
+        LV_LOG_TRACE("image draw: image found in the cache");
+        return cached_src;
     }
 
-    /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
+    cache_stats.misses++;
 
-    /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
-            cached_src = &cache[i];
-        }
-    }
+    /*Open the image in the temporary entry first. Caching it depends on its size and time to open*/
+    temp_close();
+#endif
 
-    /*Close the decoder to reuse if it was opened (has a valid source)*/
-    if(cached_src->dec_dsc.src) {
-        lv_img_decoder_close(&cached_src->dec_dsc);
-        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
-    }
-    else {
-        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
-    }
-#else
     cached_src = &cache_temp;
-#endif
+
     /*Open the image and measure the time to open*/
     uint32_t t_start  = lv_tick_get();
     lv_res_t open_res = lv_img_decoder_open(&cached_src->dec_dsc, src, color);
     if(open_res == LV_RES_INV) {
         LV_LOG_WARN("Image draw cannot open the image resource");
         _lv_memset_00(cached_src, sizeof(lv_img_cache_entry_t));
-        cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its use  */
         return NULL;
     }
 
-    cached_src->life = 0;
-
     /*If `time_to_open` was not set in the open function set it here*/
     if(cached_src->dec_dsc.time_to_open == 0) {
         cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
@@ -140,6 +131,46 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
 
     if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
 
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(src_type != LV_IMG_SRC_VARIABLE && src_type != LV_IMG_SRC_FILE) return cached_src;
+
+    uint32_t data_size = decoded_size(&cached_src->dec_dsc);
+    if(cache_capacity && data_size > cache_capacity) return cached_src;
+
+    /*Make room by closing the least recently used images unless they were harder to open*/
+    int32_t cost = (int32_t)LV_MATH_MIN(cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN,
+                                        LV_IMG_CACHE_LIFE_LIMIT);
+    while(free_first == ENTRY_NONE || (cache_capacity && cache_stats.data_size + data_size > cache_capacity)) {
+        lv_img_cache_entry_t * victim = &cache[lru_last];
+        if(victim->life > cost) {
+            victim->life -= cost;
+            cache_stats.rejections++;
+            LV_LOG_INFO("image draw: cache miss, the image is not cached");
+            return cached_src;
+        }
+
+        entry_evict(lru_last);
+        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
+    }
+
+    /*Move the opened image into a free entry*/
+    id = free_first;
+    cached_src = &cache[id];
+    free_first = cached_src->next;
+
+    _lv_memcpy_small(&cached_src->dec_dsc, &cache_temp.dec_dsc, sizeof(lv_img_decoder_dsc_t));
+    _lv_memset_00(&cache_temp, sizeof(lv_img_cache_entry_t));
+
+    cached_src->life = cost;
+    cached_src->src_hash = hash;
+    cached_src->data_size = data_size;
+    index_insert(id);
+    lru_link_front(id);
+    cache_stats.entries++;
+    cache_stats.data_size += data_size;
+#endif
+
     return cached_src;
 }
 
@@ -159,19 +190,85 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
         /*Clean the cache before free it*/
         lv_img_cache_invalidate_src(NULL);
         lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
+        LV_GC_ROOT(_lv_img_cache_array) = NULL;
     }
 
-    /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(lv_img_cache_entry_t) * new_entry_cnt);
+    entry_cnt = 0;
+    if(new_entry_cnt == 0 || new_entry_cnt == ENTRY_NONE) return;
+
+    /*The index is kept at most half full*/
+    uint32_t index_size = 1;
+    while(index_size < 2 * (uint32_t)new_entry_cnt) index_size <<= 1;
+
+    /*Reallocate the cache with the index after the entries*/
+    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(lv_img_cache_entry_t) * new_entry_cnt +
+                                                   sizeof(uint16_t) * index_size);
     LV_ASSERT_MEM(LV_GC_ROOT(_lv_img_cache_array));
     if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
-        entry_cnt = 0;
         return;
     }
     entry_cnt = new_entry_cnt;
 
     /*Clean the cache*/
-    _lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(lv_img_cache_entry_t));
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    _lv_memset_00(cache, entry_cnt * sizeof(lv_img_cache_entry_t));
+    cache_index = (uint16_t *)&cache[entry_cnt];
+    index_mask = index_size - 1;
+    _lv_memset_ff(cache_index, index_size * sizeof(uint16_t));
+
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        cache[i].next = i + 1 < entry_cnt ? i + 1 : ENTRY_NONE;
+    }
+    free_first = 0;
+    lru_first = ENTRY_NONE;
+    lru_last = ENTRY_NONE;
+#endif
+}
+
+/**
+ * Limit the size of the decoded data the cached images can hold.
+ * The least recently used images are closed if the new limit is smaller.
+ * @param bytes the limit in bytes. 0: limit only the number of images
+ */
+void lv_img_cache_set_capacity(uint32_t bytes)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(bytes);
+    LV_LOG_WARN("Can't change cache capacity because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#else
+    cache_capacity = bytes;
+    if(cache_capacity == 0) return;
+
+    while(cache_stats.data_size > cache_capacity) {
+        entry_evict(lru_last);
+    }
+#endif
+}
+
+/**
+ * Get the counters of the image cache
+ * @param stats store the counters here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    _lv_memcpy_small(stats, &cache_stats, sizeof(lv_img_cache_stats_t));
+#else
+    _lv_memset_00(stats, sizeof(lv_img_cache_stats_t));
+#endif
+}
+
+/**
+ * Reset the hit, miss, eviction and rejection counters of the image cache
+ */
+void lv_img_cache_reset_stats(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    cache_stats.hits = 0;
+    cache_stats.misses = 0;
+    cache_stats.evictions = 0;
+    cache_stats.rejections = 0;
 #endif
 }
 
@@ -183,18 +280,21 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
 void lv_img_cache_invalidate_src(const void * src)
 {
 #if LV_IMG_CACHE_DEF_SIZE
+    if(src == NULL || lv_img_cache_match(src, cache_temp.dec_dsc.src)) {
+        temp_close();
+    }
+
     lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
 
     uint16_t i;
     for(i = 0; i < entry_cnt; i++) {
+        if(cache[i].dec_dsc.src == NULL) continue;
         if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
-            }
-
-            _lv_memset_00(&cache[i], sizeof(lv_img_cache_entry_t));
+            entry_evict(i);
         }
     }
+#else
+    LV_UNUSED(src);
 #endif
 }
 
@@ -214,4 +314,137 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
         return false;
     return strcmp(src1, src2) == 0;
 }
+
+/**
+ * Hash the address of a variable or the path of a file with the color
+ */
+static uint32_t src_hash(const void * src, lv_color_t color)
+{
+    uint32_t h = 2166136261u;
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_FILE) {
+        const uint8_t * c;
+        for(c = src; *c != '\0'; c++) h = (h ^ *c) * 16777619u;
+    }
+    else {
+        h = (h ^ (uint32_t)(lv_uintptr_t)src) * 16777619u;
+        h ^= h >> 13;
+    }
+
+    h = (h ^ (uint32_t)color.full) * 16777619u;
+    return h ^ (h >> 16);
+}
+
+/**
+ * Get the size of the decoded data which was allocated by the decoder.
+ * The data of variables is used directly by the built-in decoder, it's not counted.
+ */
+static uint32_t decoded_size(const lv_img_decoder_dsc_t * dsc)
+{
+    if(dsc->img_data == NULL) return 0;
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE && dsc->img_data == ((const lv_img_dsc_t *)dsc->src)->data) return 0;
+
+    return lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf);
+}
+
+/**
+ * Find the entry of an image in the index
+ * @return index of the entry or `ENTRY_NONE` if the image is not cached
+ */
+static uint16_t index_find(const void * src, lv_color_t color, uint32_t hash)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint32_t i;
+    for(i = hash & index_mask; cache_index[i] != ENTRY_NONE; i = (i + 1) & index_mask) {
+        lv_img_cache_entry_t * e = &cache[cache_index[i]];
+        if(e->src_hash == hash && e->dec_dsc.color.full == color.full && lv_img_cache_match(src, e->dec_dsc.src)) {
+            return cache_index[i];
+        }
+    }
+
+    return ENTRY_NONE;
+}
+
+static void index_insert(uint16_t id)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint32_t i = cache[id].src_hash & index_mask;
+    while(cache_index[i] != ENTRY_NONE) i = (i + 1) & index_mask;
+    cache_index[i] = id;
+}
+
+/**
+ * Remove an entry from the index. The following slots are shifted back to keep the probe chains unbroken.
+ */
+static void index_remove(uint16_t id)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint32_t i = cache[id].src_hash & index_mask;
+    while(cache_index[i] != id) i = (i + 1) & index_mask;
+
+    uint32_t j = i;
+    while(1) {
+        j = (j + 1) & index_mask;
+        if(cache_index[j] == ENTRY_NONE) break;
+
+        /*Move the entry of `j` to the hole if its home slot is not between the hole and `j`*/
+        uint32_t home = cache[cache_index[j]].src_hash & index_mask;
+        if(((j - home) & index_mask) >= ((j - i) & index_mask)) {
+            cache_index[i] = cache_index[j];
+            i = j;
+        }
+    }
+    cache_index[i] = ENTRY_NONE;
+}
+
+static void lru_unlink(uint16_t id)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    lv_img_cache_entry_t * e = &cache[id];
+    if(e->prev != ENTRY_NONE) cache[e->prev].next = e->next;
+    else lru_first = e->next;
+
+    if(e->next != ENTRY_NONE) cache[e->next].prev = e->prev;
+    else lru_last = e->prev;
+}
+
+static void lru_link_front(uint16_t id)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    cache[id].prev = ENTRY_NONE;
+    cache[id].next = lru_first;
+    if(lru_first != ENTRY_NONE) cache[lru_first].prev = id;
+    else lru_last = id;
+    lru_first = id;
+}
+
+/**
+ * Close the image of a used entry and make the entry free
+ */
+static void entry_evict(uint16_t id)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    lv_img_cache_entry_t * e = &cache[id];
+
+    index_remove(id);
+    lru_unlink(id);
+    cache_stats.entries--;
+    cache_stats.data_size -= e->data_size;
+    cache_stats.evictions++;
+
+    lv_img_decoder_close(&e->dec_dsc);
+    _lv_memset_00(e, sizeof(lv_img_cache_entry_t));
+    e->next = free_first;
+    free_first = id;
+}
+
+/**
+ * Close the image opened in the temporary entry
+ */
+static void temp_close(void)
+{
+    if(cache_temp.dec_dsc.src) {
+        lv_img_decoder_close(&cache_temp.dec_dsc);
+        _lv_memset_00(&cache_temp, sizeof(lv_img_cache_entry_t));
+    }
+}
 #endif
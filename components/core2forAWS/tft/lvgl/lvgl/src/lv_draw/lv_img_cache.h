@@ -31,12 +31,28 @@ extern "C" {
 typedef struct {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information */
 
-    /** Count the cache entries's life. Add `time_to_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused */
+    /** The value of the entry. Set to `time_to_open` when the entry is used.
+     * An image which is cheaper to open than this doesn't evict the entry but decrements its `life`*/
     int32_t life;
+
+    uint32_t src_hash;  /**< Hash of the source and the color, the key of the entry in the index*/
+    uint32_t data_size; /**< Size of the decoded data held by the decoder*/
+    uint16_t prev;      /**< Towards the most recently used entry*/
+    uint16_t next;      /**< Towards the least recently used entry or the next free entry*/
 } lv_img_cache_entry_t;
 
+/**
+ * Counters of the image cache
+ */
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;     /**< Cached images closed to make room*/
+    uint32_t rejections;    /**< Opened images not cached because the entries to evict were more valuable*/
+    uint32_t entries;       /**< Cached images*/
+    uint32_t data_size;     /**< Decoded data held by the cached images*/
+} lv_img_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -59,6 +75,24 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color);
  */
 void lv_img_cache_set_size(uint16_t new_slot_num);
 
+/**
+ * Limit the size of the decoded data the cached images can hold.
+ * The least recently used images are closed if the new limit is smaller.
+ * @param bytes the limit in bytes. 0: limit only the number of images
+ */
+void lv_img_cache_set_capacity(uint32_t bytes);
+
+/**
+ * Get the counters of the image cache
+ * @param stats store the counters here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats);
+
+/**
+ * Reset the hit, miss, eviction and rejection counters of the image cache
+ */
+void lv_img_cache_reset_stats(void);
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
@@ -11,6 +11,7 @@
 #include "../lv_draw/lv_draw_img.h"
 #include "../lv_misc/lv_ll.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_core/lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -87,12 +88,14 @@ lv_res_t lv_img_decoder_get_info(const char * src, lv_img_header_t * header)
 
     lv_res_t res = LV_RES_INV;
     lv_img_decoder_t * d;
+    _lv_refr_lock();    /*The decoders can be called by the bands rendered in parallel*/
     _LV_LL_READ(LV_GC_ROOT(_lv_img_defoder_ll), d) {
         if(d->info_cb) {
             res = d->info_cb(d, src, header);
             if(res == LV_RES_OK) break;
         }
     }
+    _lv_refr_unlock();
 
     return res;
 }
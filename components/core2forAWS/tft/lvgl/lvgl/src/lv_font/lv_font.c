@@ -10,6 +10,7 @@
 #include "lv_font.h"
 #include "../lv_misc/lv_utils.h"
 #include "../lv_misc/lv_log.h"
+#include "../lv_core/lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -47,7 +48,12 @@
  */
 const uint8_t * lv_font_get_glyph_bitmap(const lv_font_t * font_p, uint32_t letter)
 {
-    return font_p->get_glyph_bitmap(font_p, letter);
+    /*The fonts can decompress and cache the glyphs in buffers shared by the bands rendered in parallel*/
+    _lv_refr_lock();
+    const uint8_t * bitmap = font_p->get_glyph_bitmap(font_p, letter);
+    _lv_refr_unlock();
+
+    return bitmap;
 }
 
 /**
@@ -61,7 +67,11 @@ const uint8_t * lv_font_get_glyph_bitmap(const lv_font_t * font_p, uint32_t lett
 bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
                            uint32_t letter_next)
 {
-    return font_p->get_glyph_dsc(font_p, dsc_out, letter, letter_next);
+    _lv_refr_lock();
+    bool ret = font_p->get_glyph_dsc(font_p, dsc_out, letter, letter_next);
+    _lv_refr_unlock();
+
+    return ret;
 }
 
 /**
@@ -1,6 +1,7 @@
 CSRCS += lv_font.c
 CSRCS += lv_font_fmt_txt.c
 CSRCS += lv_font_loader.c
+CSRCS += lv_font_image.c
 
 CSRCS += lv_font_dejavu_16_persian_hebrew.c
 CSRCS += lv_font_montserrat_8.c
@@ -18,6 +18,11 @@
 /*********************
  *      DEFINES
  *********************/
+#if LV_FONT_GLYPH_CACHE_SIZE
+#define GLYPH_CACHE_NONE    0xFFFF  /*Invalid entry index*/
+#endif
+#define GLYPH_ID_SPARSE     UINT32_MAX  /*The letter is in a sparse character map which wasn't searched*/
+#define GLYPH_CACHE_A8      (LV_FONT_GLYPH_CACHE_SIZE > 0 && LV_FONT_GLYPH_CACHE_MAX_PX > 0)
 
 /**********************
  *      TYPEDEFS
@@ -28,16 +33,43 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+#if LV_FONT_GLYPH_CACHE_SIZE
+typedef struct {
+    const lv_font_t * font;     /*NULL: unused entry*/
+    uint32_t letter;
+    uint32_t gid;               /*0: the letter is not in the font*/
+    uint16_t prev;              /*Towards the most recently used entry*/
+    uint16_t next;              /*Towards the least recently used entry*/
+    uint16_t hash_next;         /*Next entry in the same bucket*/
+    uint8_t bitmap_ready : 1;   /*The decoded bitmap is in `glyph_cache_bitmap`*/
+} glyph_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t find_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter, bool search_sparse);
+#if LV_FONT_GLYPH_CACHE_SIZE
+    static glyph_cache_entry_t * glyph_cache_get(const lv_font_t * font, uint32_t letter);
+    static void glyph_cache_init(void);
+    static void glyph_cache_unlink(uint16_t id);
+    static void glyph_cache_link_front(uint16_t id);
+    static void glyph_cache_hash_remove(uint16_t id);
+    static uint32_t glyph_cache_hash(const lv_font_t * font, uint32_t letter);
+#endif
+#if GLYPH_CACHE_A8
+    static bool glyph_is_cached_a8(const lv_font_t * font, const lv_font_fmt_txt_glyph_dsc_t * gdsc);
+    static void expand_to_a8(const uint8_t * in, uint8_t * out, uint32_t px_num, uint8_t bpp);
+#endif
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
 
 #if LV_USE_FONT_COMPRESSED
+    static const uint8_t * decompress_glyph(const lv_font_fmt_txt_dsc_t * fdsc,
+                                            const lv_font_fmt_txt_glyph_dsc_t * gdsc);
     static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp, bool prefilter);
     static inline void decompress_line(uint8_t * out, lv_coord_t w);
     static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len);
@@ -58,6 +90,18 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static rle_state_t rle_state;
 #endif /* LV_USE_FONT_COMPRESSED */
 
+#if LV_FONT_GLYPH_CACHE_SIZE
+    static glyph_cache_entry_t glyph_cache[LV_FONT_GLYPH_CACHE_SIZE];
+    static uint16_t glyph_cache_bucket[LV_FONT_GLYPH_CACHE_SIZE];
+    static uint16_t glyph_cache_mru;
+    static uint16_t glyph_cache_lru;
+    static bool glyph_cache_inited;
+    static lv_font_glyph_cache_stats_t glyph_cache_stats;
+#endif
+#if GLYPH_CACHE_A8
+    static uint8_t glyph_cache_bitmap[LV_FONT_GLYPH_CACHE_SIZE][LV_FONT_GLYPH_CACHE_MAX_PX]; /*A8 slot of every entry*/
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -86,43 +130,40 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
 
     const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
 
+#if GLYPH_CACHE_A8
+    /*Decode the glyph only once into an A8 bitmap*/
+    if(glyph_is_cached_a8(font, gdsc)) {
+        glyph_cache_entry_t * entry = glyph_cache_get(font, unicode_letter);
+        uint8_t * bitmap = glyph_cache_bitmap[entry - glyph_cache];
+        if(entry->bitmap_ready) return bitmap;
+
+        uint32_t px_num = gdsc->box_w * gdsc->box_h;
+        if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
+            expand_to_a8(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap, px_num, (uint8_t)fdsc->bpp);
+        }
+        else {
+#if LV_USE_FONT_COMPRESSED
+            const uint8_t * packed = decompress_glyph(fdsc, gdsc);
+            if(packed == NULL) return NULL;
+            expand_to_a8(packed, bitmap, px_num, fdsc->bpp == 3 ? 4 : (uint8_t)fdsc->bpp);
+#else
+            return NULL;
+#endif
+        }
+
+        entry->bitmap_ready = 1;
+        glyph_cache_stats.decodes++;
+        return bitmap;
+    }
+#endif
+
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
         return &fdsc->glyph_bitmap[gdsc->bitmap_index];
     }
     /*Handle compressed bitmap*/
     else {
 #if LV_USE_FONT_COMPRESSED
-        uint32_t gsize = gdsc->box_w * gdsc->box_h;
-        if(gsize == 0) return NULL;
-
-        uint32_t buf_size = gsize;
-        /*Compute memory size needed to hold decompressed glyph, rounding up*/
-        switch(fdsc->bpp) {
-            case 1:
-                buf_size = (gsize + 7) >> 3;
-                break;
-            case 2:
-                buf_size = (gsize + 3) >> 2;
-                break;
-            case 3:
-                buf_size = (gsize + 1) >> 1;
-                break;
-            case 4:
-                buf_size = (gsize + 1) >> 1;
-                break;
-        }
-
-        if(_lv_mem_get_size(LV_GC_ROOT(_lv_font_decompr_buf)) < buf_size) {
-            uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
-            LV_ASSERT_MEM(tmp);
-            if(tmp == NULL) return NULL;
-            LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
-        }
-
-        bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
-                   (uint8_t)fdsc->bpp, prefilter);
-        return LV_GC_ROOT(_lv_font_decompr_buf);
+        return decompress_glyph(fdsc, gdsc);
 #else /* !LV_USE_FONT_COMPRESSED */
         return NULL;
 #endif
@@ -177,6 +218,9 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     dsc_out->ofs_x = gdsc->ofs_x;
     dsc_out->ofs_y = gdsc->ofs_y;
     dsc_out->bpp   = (uint8_t)fdsc->bpp;
+#if GLYPH_CACHE_A8
+    if(glyph_is_cached_a8(font, gdsc)) dsc_out->bpp = 8;
+#endif
 
     if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
 
@@ -194,6 +238,62 @@ void _lv_font_clean_up_fmt_txt(void)
     }
 }
 
+#if LV_FONT_GLYPH_CACHE_SIZE
+/**
+ * Get the counters of the glyph cache.
+ * @param stats store the counters here
+ */
+void lv_font_get_glyph_cache_stats_fmt_txt(lv_font_glyph_cache_stats_t * stats)
+{
+    _lv_memcpy_small(stats, &glyph_cache_stats, sizeof(lv_font_glyph_cache_stats_t));
+
+    stats->glyphs = 0;
+    stats->bitmap_bytes = 0;
+    uint32_t i;
+    for(i = 0; i < LV_FONT_GLYPH_CACHE_SIZE; i++) {
+        if(glyph_cache[i].font == NULL) continue;
+        stats->glyphs++;
+        if(glyph_cache[i].bitmap_ready) {
+            const lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) glyph_cache[i].font->dsc;
+            const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[glyph_cache[i].gid];
+            stats->bitmap_bytes += gdsc->box_w * gdsc->box_h;
+        }
+    }
+}
+
+/**
+ * Reset the counters of the glyph cache. The cached glyphs are kept.
+ */
+void lv_font_reset_glyph_cache_stats_fmt_txt(void)
+{
+    _lv_memset_00(&glyph_cache_stats, sizeof(glyph_cache_stats));
+}
+
+/**
+ * Remove the glyphs of a font from the glyph cache. Has to be called before a font is freed.
+ * @param font pointer to a font
+ */
+void _lv_font_glyph_cache_remove_fmt_txt(const lv_font_t * font)
+{
+    if(!glyph_cache_inited) return;
+
+    uint16_t i;
+    for(i = 0; i < LV_FONT_GLYPH_CACHE_SIZE; i++) {
+        if(glyph_cache[i].font != font) continue;
+
+        /*Make it the least recently used unused entry*/
+        glyph_cache_hash_remove(i);
+        glyph_cache[i].font = NULL;
+        glyph_cache_unlink(i);
+        glyph_cache[i].prev = glyph_cache_lru;
+        glyph_cache[i].next = GLYPH_CACHE_NONE;
+        if(glyph_cache_lru != GLYPH_CACHE_NONE) glyph_cache[glyph_cache_lru].next = i;
+        else glyph_cache_mru = i;
+        glyph_cache_lru = i;
+    }
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -207,6 +307,29 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
     /*Check the cache first*/
     if(letter == fdsc->last_letter) return fdsc->last_glyph_id;
 
+#if LV_FONT_GLYPH_CACHE_SIZE
+    /*The directly indexed character maps are faster than the cache, only the sparse ones are searched through it*/
+    uint32_t glyph_id = find_glyph_dsc_id(fdsc, letter, false);
+    if(glyph_id == GLYPH_ID_SPARSE) glyph_id = glyph_cache_get(font, letter)->gid;
+#else
+    uint32_t glyph_id = find_glyph_dsc_id(fdsc, letter, true);
+#endif
+
+    /*Update the cache*/
+    fdsc->last_letter = letter;
+    fdsc->last_glyph_id = glyph_id;
+    return glyph_id;
+}
+
+/**
+ * Find the glyph ID of a letter in the character maps of a font.
+ * @param fdsc pointer to the font's descriptor
+ * @param letter an UNICODE letter code
+ * @param search_sparse false: don't search the sparse character maps but return `GLYPH_ID_SPARSE`
+ * @return the glyph ID or 0 if the letter is not in the font
+ */
+static uint32_t find_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter, bool search_sparse)
+{
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
@@ -221,6 +344,9 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             const uint8_t * gid_ofs_8 = fdsc->cmaps[i].glyph_id_ofs_list;
             glyph_id = fdsc->cmaps[i].glyph_id_start + gid_ofs_8[rcp];
         }
+        else if(!search_sparse) {
+            return GLYPH_ID_SPARSE;
+        }
         else if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
             uint16_t key = rcp;
             uint16_t * p = _lv_utils_bsearch(&key, fdsc->cmaps[i].unicode_list, fdsc->cmaps[i].list_length,
@@ -243,18 +369,153 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             }
         }
 
-        /*Update the cache*/
-        fdsc->last_letter = letter;
-        fdsc->last_glyph_id = glyph_id;
         return glyph_id;
     }
 
-    fdsc->last_letter = letter;
-    fdsc->last_glyph_id = 0;
     return 0;
+}
+
+#if LV_FONT_GLYPH_CACHE_SIZE
+/**
+ * Get the cache entry of a letter. On a miss the least recently used entry is reused for the letter.
+ * @param font pointer to a font
+ * @param letter an UNICODE letter code
+ * @return the entry of the letter, the most recently used from now
+ */
+static glyph_cache_entry_t * glyph_cache_get(const lv_font_t * font, uint32_t letter)
+{
+    if(!glyph_cache_inited) glyph_cache_init();
+
+    glyph_cache_stats.lookups++;
+
+    uint32_t b = glyph_cache_hash(font, letter);
+    uint16_t id;
+    for(id = glyph_cache_bucket[b]; id != GLYPH_CACHE_NONE; id = glyph_cache[id].hash_next) {
+        if(glyph_cache[id].font == font && glyph_cache[id].letter == letter) break;
+    }
+
+    if(id != GLYPH_CACHE_NONE) {
+        glyph_cache_stats.hits++;
+    }
+    else {
+        id = glyph_cache_lru;
+        if(glyph_cache[id].font) {
+            glyph_cache_hash_remove(id);
+            glyph_cache_stats.evictions++;
+        }
+
+        glyph_cache_entry_t * entry = &glyph_cache[id];
+        entry->font = font;
+        entry->letter = letter;
+        entry->gid = find_glyph_dsc_id(font->dsc, letter, true);
+        entry->bitmap_ready = 0;
+        entry->hash_next = glyph_cache_bucket[b];
+        glyph_cache_bucket[b] = id;
+    }
+
+    if(id != glyph_cache_mru) {
+        glyph_cache_unlink(id);
+        glyph_cache_link_front(id);
+    }
 
+    return &glyph_cache[id];
 }
 
+static void glyph_cache_init(void)
+{
+    uint16_t i;
+    for(i = 0; i < LV_FONT_GLYPH_CACHE_SIZE; i++) {
+        glyph_cache[i].font = NULL;
+        glyph_cache[i].prev = i == 0 ? GLYPH_CACHE_NONE : i - 1;
+        glyph_cache[i].next = i == LV_FONT_GLYPH_CACHE_SIZE - 1 ? GLYPH_CACHE_NONE : i + 1;
+        glyph_cache_bucket[i] = GLYPH_CACHE_NONE;
+    }
+    glyph_cache_mru = 0;
+    glyph_cache_lru = LV_FONT_GLYPH_CACHE_SIZE - 1;
+    glyph_cache_inited = true;
+}
+
+/**
+ * Remove an entry from the LRU list
+ */
+static void glyph_cache_unlink(uint16_t id)
+{
+    glyph_cache_entry_t * entry = &glyph_cache[id];
+    if(entry->prev != GLYPH_CACHE_NONE) glyph_cache[entry->prev].next = entry->next;
+    else glyph_cache_mru = entry->next;
+
+    if(entry->next != GLYPH_CACHE_NONE) glyph_cache[entry->next].prev = entry->prev;
+    else glyph_cache_lru = entry->prev;
+}
+
+/**
+ * Add an unlinked entry to the LRU list as the most recently used
+ */
+static void glyph_cache_link_front(uint16_t id)
+{
+    glyph_cache[id].prev = GLYPH_CACHE_NONE;
+    glyph_cache[id].next = glyph_cache_mru;
+    if(glyph_cache_mru != GLYPH_CACHE_NONE) glyph_cache[glyph_cache_mru].prev = id;
+    else glyph_cache_lru = id;
+    glyph_cache_mru = id;
+}
+
+/**
+ * Remove a used entry from its bucket
+ */
+static void glyph_cache_hash_remove(uint16_t id)
+{
+    uint16_t * link = &glyph_cache_bucket[glyph_cache_hash(glyph_cache[id].font, glyph_cache[id].letter)];
+    while(*link != id) link = &glyph_cache[*link].hash_next;
+    *link = glyph_cache[id].hash_next;
+}
+
+static uint32_t glyph_cache_hash(const lv_font_t * font, uint32_t letter)
+{
+    uint32_t h = ((uint32_t)(lv_uintptr_t)font >> 2) * 2654435761u + letter;
+    h ^= h >> 15;
+    return h % LV_FONT_GLYPH_CACHE_SIZE;
+}
+#endif
+
+#if GLYPH_CACHE_A8
+/**
+ * Tell whether the bitmap of a glyph is decoded to an A8 bitmap in the cache.
+ * Compressed glyphs and glyphs with less than 4 bpp are cached if they fit in a slot.
+ * It has to give the same result for `get_glyph_dsc` and `get_glyph_bitmap`.
+ */
+static bool glyph_is_cached_a8(const lv_font_t * font, const lv_font_fmt_txt_glyph_dsc_t * gdsc)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
+
+    if(font->subpx != LV_FONT_SUBPX_NONE) return false;
+    if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN && fdsc->bpp != 1 && fdsc->bpp != 2) return false;
+
+    uint32_t px_num = gdsc->box_w * gdsc->box_h;
+    return px_num > 0 && px_num <= LV_FONT_GLYPH_CACHE_MAX_PX;
+}
+
+/**
+ * Convert a packed 1, 2 or 4 bpp bitmap to A8 with the opacities used by the letter drawing.
+ * @param in the packed bitmap. The lines are not padded.
+ * @param out buffer for `px_num` bytes
+ * @param px_num number of pixels
+ * @param bpp bit per pixel of `in`
+ */
+static void expand_to_a8(const uint8_t * in, uint8_t * out, uint32_t px_num, uint8_t bpp)
+{
+    uint8_t mask = (1 << bpp) - 1;
+    uint8_t scale = 255 / mask;    /*Same as `_lv_bppX_opa_table`*/
+    uint32_t i;
+    uint32_t bit_pos = 0;
+    for(i = 0; i < px_num; i++) {
+        uint8_t v = (in[bit_pos >> 3] >> (8 - bpp - (bit_pos & 0x7))) & mask;
+        out[i] = v * scale;
+        bit_pos += bpp;
+    }
+}
+#endif
+
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
@@ -333,6 +594,47 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element)
 }
 
 #if LV_USE_FONT_COMPRESSED
+/**
+ * Decompress the bitmap of a glyph into the shared decompression buffer
+ * @param fdsc pointer to the font's descriptor
+ * @param gdsc pointer to the glyph's descriptor
+ * @return the decompressed bitmap or NULL on error or if the glyph is empty
+ */
+static const uint8_t * decompress_glyph(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc)
+{
+    uint32_t gsize = gdsc->box_w * gdsc->box_h;
+    if(gsize == 0) return NULL;
+
+    uint32_t buf_size = gsize;
+    /*Compute memory size needed to hold decompressed glyph, rounding up*/
+    switch(fdsc->bpp) {
+        case 1:
+            buf_size = (gsize + 7) >> 3;
+            break;
+        case 2:
+            buf_size = (gsize + 3) >> 2;
+            break;
+        case 3:
+            buf_size = (gsize + 1) >> 1;
+            break;
+        case 4:
+            buf_size = (gsize + 1) >> 1;
+            break;
+    }
+
+    if(_lv_mem_get_size(LV_GC_ROOT(_lv_font_decompr_buf)) < buf_size) {
+        uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
+        LV_ASSERT_MEM(tmp);
+        if(tmp == NULL) return NULL;
+        LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
+    }
+
+    bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
+    decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
+               (uint8_t)fdsc->bpp, prefilter);
+    return LV_GC_ROOT(_lv_font_decompr_buf);
+}
+
 /**
  * The compress a glyph's bitmap
  * @param in the compressed bitmap
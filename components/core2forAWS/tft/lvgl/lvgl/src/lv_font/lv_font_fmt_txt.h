@@ -192,6 +192,16 @@ typedef struct {
 
 } lv_font_fmt_txt_dsc_t;
 
+/*Counters of the glyph cache (`LV_FONT_GLYPH_CACHE_SIZE`)*/
+typedef struct {
+    uint32_t lookups;       /*Glyphs looked up by letter*/
+    uint32_t hits;          /*Lookups found in the cache*/
+    uint32_t decodes;       /*Bitmaps decoded into the cache*/
+    uint32_t evictions;     /*Glyphs dropped to make room for new ones*/
+    uint32_t glyphs;        /*Glyphs in the cache now*/
+    uint32_t bitmap_bytes;  /*Bytes of the decoded bitmaps in the cache now*/
+} lv_font_glyph_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -220,6 +230,25 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+#if LV_FONT_GLYPH_CACHE_SIZE
+/**
+ * Get the counters of the glyph cache.
+ * @param stats store the counters here
+ */
+void lv_font_get_glyph_cache_stats_fmt_txt(lv_font_glyph_cache_stats_t * stats);
+
+/**
+ * Reset the counters of the glyph cache. The cached glyphs are kept.
+ */
+void lv_font_reset_glyph_cache_stats_fmt_txt(void);
+
+/**
+ * Remove the glyphs of a font from the glyph cache. Has to be called before a font is freed.
+ * @param font pointer to a font
+ */
+void _lv_font_glyph_cache_remove_fmt_txt(const lv_font_t * font);
+#endif
+
 /**********************
  *      MACROS
  **********************/
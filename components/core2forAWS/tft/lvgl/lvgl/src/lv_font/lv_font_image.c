@@ -0,0 +1,383 @@
+/**
+ * @file lv_font_image.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include "lv_font_image.h"
+#include "lv_font_fmt_txt.h"
+#include "../lv_misc/lv_debug.h"
+#include "../lv_misc/lv_log.h"
+#include "../lv_misc/lv_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define IMAGE_MAGIC     0x4946564C  /*"LVFI" in little endian. Images of an other byte order are rejected*/
+#define IMAGE_VERSION   1
+#define IMAGE_ALIGN     4           /*Alignment of the image and its tables*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/* Layout of an image (all offsets are from the start of the image, 0 means NULL):
+ *   image_header_t
+ *   image_cmap_t[cmap_num]
+ *   image_kern_t (if `kern_ofs != 0`)
+ *   lv_font_fmt_txt_glyph_dsc_t[glyph_cnt]
+ *   the lists of the cmaps, the tables of the kerning and the glyph bitmaps, each aligned to 4 bytes
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t glyph_dsc_size;    /*`sizeof(lv_font_fmt_txt_glyph_dsc_t)` of the writer*/
+    uint32_t size;              /*Size of the whole image*/
+    int16_t line_height;
+    int16_t base_line;
+    int8_t underline_position;
+    int8_t underline_thickness;
+    uint8_t subpx;
+    uint8_t bpp;
+    uint8_t bitmap_format;
+    uint8_t kern_classes;
+    uint16_t kern_scale;
+    uint16_t cmap_num;
+    uint16_t padding;
+    uint32_t glyph_cnt;
+    uint32_t glyph_dsc_ofs;
+    uint32_t bitmap_ofs;
+    uint32_t bitmap_size;
+    uint32_t cmaps_ofs;
+    uint32_t kern_ofs;
+} image_header_t;
+
+typedef struct {
+    uint32_t range_start;
+    uint16_t range_length;
+    uint16_t glyph_id_start;
+    uint32_t unicode_list_ofs;
+    uint32_t glyph_id_ofs_list_ofs;
+    uint16_t list_length;
+    uint8_t type;
+    uint8_t padding;
+} image_cmap_t;
+
+typedef struct {
+    uint32_t values_ofs;                /*`values` of the pairs or `class_pair_values` of the classes*/
+    uint32_t glyph_ids_ofs;             /*Pairs only*/
+    uint32_t left_class_mapping_ofs;    /*Classes only*/
+    uint32_t right_class_mapping_ofs;   /*Classes only*/
+    uint32_t pair_cnt;
+    uint8_t glyph_ids_size;
+    uint8_t left_class_cnt;
+    uint8_t right_class_cnt;
+    uint8_t padding;
+} image_kern_t;
+
+/*The descriptors of a font created from an image, allocated in one piece*/
+typedef struct {
+    lv_font_t font;                     /*Has to be the first to free the descriptors by the font*/
+    lv_font_fmt_txt_dsc_t dsc;
+    union {
+        lv_font_fmt_txt_kern_pair_t pair;
+        lv_font_fmt_txt_kern_classes_t classes;
+    } kern;
+    lv_font_fmt_txt_cmap_t cmaps[];
+} image_font_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static const void * image_ptr(const image_header_t * header, uint32_t ofs, uint32_t len);
+static uint32_t table_put(uint8_t * buf, uint32_t * pos, const void * src, uint32_t len);
+static uint32_t cmap_ofs_list_size(const lv_font_fmt_txt_cmap_t * cmap);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Create a font which uses the tables of a font image in place.
+ * Only the font descriptors (a few hundred bytes) are allocated, the image is not copied
+ * so it has to be kept (mapped) until the font is freed.
+ * @param image pointer to the font image, aligned to 4 bytes.
+ *              E.g. a flash partition mapped by `esp_partition_mmap()` or a file mapped by `mmap()`.
+ * @return pointer to the font or NULL if the image is invalid, was made with an other
+ *         glyph descriptor layout (`LV_FONT_FMT_TXT_LARGE`) or there is not enough memory
+ */
+lv_font_t * lv_font_load_image(const void * image)
+{
+    const image_header_t * header = image;
+
+    if(image == NULL || ((uintptr_t)image & (IMAGE_ALIGN - 1)) != 0) {
+        LV_LOG_WARN("lv_font_load_image: the image is not aligned to 4 bytes");
+        return NULL;
+    }
+
+    if(header->magic != IMAGE_MAGIC || header->version != IMAGE_VERSION) {
+        LV_LOG_WARN("lv_font_load_image: not a font image or unknown version");
+        return NULL;
+    }
+
+    if(header->glyph_dsc_size != sizeof(lv_font_fmt_txt_glyph_dsc_t)) {
+        LV_LOG_WARN("lv_font_load_image: the image was made with an other LV_FONT_FMT_TXT_LARGE");
+        return NULL;
+    }
+
+    const image_cmap_t * img_cmaps = image_ptr(header, header->cmaps_ofs, header->cmap_num * sizeof(image_cmap_t));
+    const void * glyph_dsc = image_ptr(header, header->glyph_dsc_ofs,
+                                       header->glyph_cnt * sizeof(lv_font_fmt_txt_glyph_dsc_t));
+    const void * bitmap = image_ptr(header, header->bitmap_ofs, header->bitmap_size);
+    if(img_cmaps == NULL || glyph_dsc == NULL || bitmap == NULL) {
+        LV_LOG_WARN("lv_font_load_image: invalid table offset");
+        return NULL;
+    }
+
+    image_font_t * f = lv_mem_alloc(sizeof(image_font_t) + header->cmap_num * sizeof(lv_font_fmt_txt_cmap_t));
+    LV_ASSERT_MEM(f);
+    if(f == NULL) return NULL;
+    _lv_memset_00(f, sizeof(image_font_t) + header->cmap_num * sizeof(lv_font_fmt_txt_cmap_t));
+
+    f->font.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+    f->font.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    f->font.line_height = header->line_height;
+    f->font.base_line = header->base_line;
+    f->font.subpx = header->subpx;
+    f->font.underline_position = header->underline_position;
+    f->font.underline_thickness = header->underline_thickness;
+    f->font.dsc = &f->dsc;
+
+    f->dsc.glyph_bitmap = bitmap;
+    f->dsc.glyph_dsc = glyph_dsc;
+    f->dsc.cmaps = f->cmaps;
+    f->dsc.cmap_num = header->cmap_num;
+    f->dsc.bpp = header->bpp;
+    f->dsc.bitmap_format = header->bitmap_format;
+    f->dsc.kern_scale = header->kern_scale;
+    f->dsc.kern_classes = header->kern_classes;
+
+    bool valid = true;
+    uint32_t i;
+    for(i = 0; i < header->cmap_num; i++) {
+        const image_cmap_t * ic = &img_cmaps[i];
+        lv_font_fmt_txt_cmap_t * cmap = &f->cmaps[i];
+        cmap->range_start = ic->range_start;
+        cmap->range_length = ic->range_length;
+        cmap->glyph_id_start = ic->glyph_id_start;
+        cmap->list_length = ic->list_length;
+        cmap->type = ic->type;
+        cmap->unicode_list = image_ptr(header, ic->unicode_list_ofs, ic->list_length * sizeof(uint16_t));
+        cmap->glyph_id_ofs_list = image_ptr(header, ic->glyph_id_ofs_list_ofs, cmap_ofs_list_size(cmap));
+
+        if((ic->unicode_list_ofs && cmap->unicode_list == NULL) ||
+           (ic->glyph_id_ofs_list_ofs && cmap->glyph_id_ofs_list == NULL)) {
+            valid = false;
+        }
+    }
+
+    if(header->kern_ofs) {
+        const image_kern_t * ik = image_ptr(header, header->kern_ofs, sizeof(image_kern_t));
+        if(ik == NULL) {
+            valid = false;
+        }
+        else if(header->kern_classes) {
+            uint32_t values_size = ik->left_class_cnt * ik->right_class_cnt;
+            f->kern.classes.class_pair_values = image_ptr(header, ik->values_ofs, values_size);
+            f->kern.classes.left_class_mapping = image_ptr(header, ik->left_class_mapping_ofs, header->glyph_cnt);
+            f->kern.classes.right_class_mapping = image_ptr(header, ik->right_class_mapping_ofs, header->glyph_cnt);
+            f->kern.classes.left_class_cnt = ik->left_class_cnt;
+            f->kern.classes.right_class_cnt = ik->right_class_cnt;
+            if(f->kern.classes.class_pair_values == NULL || f->kern.classes.left_class_mapping == NULL ||
+               f->kern.classes.right_class_mapping == NULL) {
+                valid = false;
+            }
+            f->dsc.kern_dsc = &f->kern.classes;
+        }
+        else {
+            uint32_t ids_size = ik->pair_cnt * 2 * (ik->glyph_ids_size ? sizeof(uint16_t) : sizeof(uint8_t));
+            f->kern.pair.glyph_ids = image_ptr(header, ik->glyph_ids_ofs, ids_size);
+            f->kern.pair.values = image_ptr(header, ik->values_ofs, ik->pair_cnt);
+            f->kern.pair.pair_cnt = ik->pair_cnt;
+            f->kern.pair.glyph_ids_size = ik->glyph_ids_size;
+            if(f->kern.pair.glyph_ids == NULL || f->kern.pair.values == NULL) valid = false;
+            f->dsc.kern_dsc = &f->kern.pair;
+        }
+    }
+
+    if(!valid) {
+        LV_LOG_WARN("lv_font_load_image: invalid table offset");
+        lv_mem_free(f);
+        return NULL;
+    }
+
+    return &f->font;
+}
+
+/**
+ * Free a font created by `lv_font_load_image()`. The image is not touched.
+ * @param font pointer to the font
+ */
+void lv_font_free_image(lv_font_t * font)
+{
+    if(font == NULL) return;
+
+#if LV_FONT_GLYPH_CACHE_SIZE
+    _lv_font_glyph_cache_remove_fmt_txt(font);
+#endif
+
+    /*All the descriptors are in the allocation of the font*/
+    lv_mem_free(font);
+}
+
+/**
+ * Write a font in the `LV_FONT_FMT_TXT` format to a font image.
+ * The format doesn't store the number of glyphs and the size of the bitmaps so they have to be given.
+ * @param font pointer to a font
+ * @param glyph_cnt number of glyph descriptors (and entries of the kern class mappings) of the font
+ * @param bitmap_size size of the glyph bitmaps in bytes
+ * @param buf store the image here. NULL to get only its size.
+ * @return size of the image in bytes
+ */
+uint32_t lv_font_image_write(const lv_font_t * font, uint32_t glyph_cnt, uint32_t bitmap_size, void * buf)
+{
+    const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
+    uint8_t * out = buf;
+
+    /*Reserve the fix sized parts, their content is known only when the tables are placed.
+     *Their sizes are multiple of 4 so the tables after them are aligned*/
+    uint32_t pos = sizeof(image_header_t);
+    uint32_t cmaps_ofs = pos;
+    pos += dsc->cmap_num * sizeof(image_cmap_t);
+    uint32_t kern_ofs = 0;
+    if(dsc->kern_dsc) {
+        kern_ofs = pos;
+        pos += sizeof(image_kern_t);
+    }
+
+    image_header_t header;
+    _lv_memset_00(&header, sizeof(header));
+    header.magic = IMAGE_MAGIC;
+    header.version = IMAGE_VERSION;
+    header.glyph_dsc_size = sizeof(lv_font_fmt_txt_glyph_dsc_t);
+    header.line_height = font->line_height;
+    header.base_line = font->base_line;
+    header.underline_position = font->underline_position;
+    header.underline_thickness = font->underline_thickness;
+    header.subpx = font->subpx;
+    header.bpp = dsc->bpp;
+    header.bitmap_format = dsc->bitmap_format;
+    header.kern_classes = dsc->kern_classes;
+    header.kern_scale = dsc->kern_scale;
+    header.cmap_num = dsc->cmap_num;
+    header.glyph_cnt = glyph_cnt;
+    header.cmaps_ofs = cmaps_ofs;
+    header.kern_ofs = kern_ofs;
+    header.glyph_dsc_ofs = table_put(out, &pos, dsc->glyph_dsc, glyph_cnt * sizeof(lv_font_fmt_txt_glyph_dsc_t));
+
+    uint32_t i;
+    for(i = 0; i < dsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &dsc->cmaps[i];
+        image_cmap_t ic;
+        _lv_memset_00(&ic, sizeof(ic));
+        ic.range_start = cmap->range_start;
+        ic.range_length = cmap->range_length;
+        ic.glyph_id_start = cmap->glyph_id_start;
+        ic.list_length = cmap->list_length;
+        ic.type = cmap->type;
+        ic.unicode_list_ofs = table_put(out, &pos, cmap->unicode_list, cmap->list_length * sizeof(uint16_t));
+        ic.glyph_id_ofs_list_ofs = table_put(out, &pos, cmap->glyph_id_ofs_list, cmap_ofs_list_size(cmap));
+        if(out) _lv_memcpy(out + cmaps_ofs + i * sizeof(image_cmap_t), &ic, sizeof(ic));
+    }
+
+    if(dsc->kern_dsc) {
+        image_kern_t ik;
+        _lv_memset_00(&ik, sizeof(ik));
+        if(dsc->kern_classes) {
+            const lv_font_fmt_txt_kern_classes_t * kern = dsc->kern_dsc;
+            ik.left_class_cnt = kern->left_class_cnt;
+            ik.right_class_cnt = kern->right_class_cnt;
+            ik.values_ofs = table_put(out, &pos, kern->class_pair_values, kern->left_class_cnt * kern->right_class_cnt);
+            ik.left_class_mapping_ofs = table_put(out, &pos, kern->left_class_mapping, glyph_cnt);
+            ik.right_class_mapping_ofs = table_put(out, &pos, kern->right_class_mapping, glyph_cnt);
+        }
+        else {
+            const lv_font_fmt_txt_kern_pair_t * kern = dsc->kern_dsc;
+            uint32_t ids_size = kern->pair_cnt * 2 * (kern->glyph_ids_size ? sizeof(uint16_t) : sizeof(uint8_t));
+            ik.pair_cnt = kern->pair_cnt;
+            ik.glyph_ids_size = kern->glyph_ids_size;
+            ik.glyph_ids_ofs = table_put(out, &pos, kern->glyph_ids, ids_size);
+            ik.values_ofs = table_put(out, &pos, kern->values, kern->pair_cnt);
+        }
+        if(out) _lv_memcpy(out + kern_ofs, &ik, sizeof(ik));
+    }
+
+    header.bitmap_ofs = table_put(out, &pos, dsc->glyph_bitmap, bitmap_size);
+    header.bitmap_size = bitmap_size;
+    header.size = pos;
+    if(out) _lv_memcpy(out, &header, sizeof(header));
+
+    return pos;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get a table of an image
+ * @param header pointer to the header of the image
+ * @param ofs offset of the table
+ * @param len length of the table in bytes
+ * @return pointer to the table or NULL if `ofs` is 0 or the table doesn't fit into the image
+ */
+static const void * image_ptr(const image_header_t * header, uint32_t ofs, uint32_t len)
+{
+    if(ofs == 0 || ofs > header->size || len > header->size - ofs) return NULL;
+    return (const uint8_t *)header + ofs;
+}
+
+/**
+ * Place a table in the image
+ * @param buf the image or NULL if only the size is calculated
+ * @param pos the next free position of the image, moved after the table
+ * @param src the content of the table
+ * @param len length of the table in bytes
+ * @return offset of the table, 0 if `src` is NULL
+ */
+static uint32_t table_put(uint8_t * buf, uint32_t * pos, const void * src, uint32_t len)
+{
+    if(src == NULL) return 0;
+
+    uint32_t ofs = *pos;
+    if(buf) {
+        _lv_memcpy(buf + ofs, src, len);
+        _lv_memset_00(buf + ofs + len, ((len + IMAGE_ALIGN - 1) & ~(IMAGE_ALIGN - 1)) - len);
+    }
+
+    *pos += (len + IMAGE_ALIGN - 1) & ~(IMAGE_ALIGN - 1);
+    return ofs;
+}
+
+static uint32_t cmap_ofs_list_size(const lv_font_fmt_txt_cmap_t * cmap)
+{
+    switch(cmap->type) {
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL:
+            return cmap->range_length * sizeof(uint8_t);
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+            return cmap->list_length * sizeof(uint16_t);
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,69 @@
+/**
+ * @file lv_font_image.h
+ * Font images: the tables of a font in the in-memory layout of `lv_font_fmt_txt_dsc_t`.
+ * They are used in place (e.g. from a memory mapped flash partition or file) without parsing
+ * or copying the glyphs.
+ */
+
+#ifndef LV_FONT_IMAGE_H
+#define LV_FONT_IMAGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdint.h>
+#include "lv_font.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a font which uses the tables of a font image in place.
+ * Only the font descriptors (a few hundred bytes) are allocated, the image is not copied
+ * so it has to be kept (mapped) until the font is freed.
+ * @param image pointer to the font image, aligned to 4 bytes.
+ *              E.g. a flash partition mapped by `esp_partition_mmap()` or a file mapped by `mmap()`.
+ * @return pointer to the font or NULL if the image is invalid, was made with an other
+ *         glyph descriptor layout (`LV_FONT_FMT_TXT_LARGE`) or there is not enough memory
+ */
+lv_font_t * lv_font_load_image(const void * image);
+
+/**
+ * Free a font created by `lv_font_load_image()`. The image is not touched.
+ * @param font pointer to the font
+ */
+void lv_font_free_image(lv_font_t * font);
+
+/**
+ * Write a font in the `LV_FONT_FMT_TXT` format to a font image.
+ * The format doesn't store the number of glyphs and the size of the bitmaps so they have to be given.
+ * @param font pointer to a font
+ * @param glyph_cnt number of glyph descriptors (and entries of the kern class mappings) of the font
+ * @param bitmap_size size of the glyph bitmaps in bytes
+ * @param buf store the image here. NULL to get only its size.
+ * @return size of the image in bytes
+ */
+uint32_t lv_font_image_write(const lv_font_t * font, uint32_t glyph_cnt, uint32_t bitmap_size, void * buf);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_FONT_IMAGE_H*/
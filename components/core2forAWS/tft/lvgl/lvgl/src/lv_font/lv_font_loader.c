@@ -62,11 +62,17 @@ typedef struct cmap_table_bin {
     uint8_t padding;
 } cmap_table_bin_t;
 
+/*Sizes of the loaded tables which are not stored in `lv_font_fmt_txt_dsc_t`*/
+typedef struct {
+    uint32_t glyph_cnt;
+    uint32_t bitmap_size;
+} font_sizes_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp);
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font);
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, font_sizes_t * sizes);
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start);
 
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
@@ -96,7 +102,8 @@ lv_font_t * lv_font_load(const char * font_name)
     lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
 
     if(res == LV_FS_RES_OK) {
-        success = lvgl_load_font(&file, font);
+        font_sizes_t sizes;
+        success = lvgl_load_font(&file, font, &sizes);
 
         if(!success) {
             LV_LOG_WARN("Error loading font file: %s\n", font_name);
@@ -115,6 +122,43 @@ lv_font_t * lv_font_load(const char * font_name)
     return font;
 }
 
+/**
+ * Convert a binary font file to a font image which can be used in place by `lv_font_load_image()`.
+ * Typically used on the host to make the image written to a flash partition or file.
+ * @param font_name filename where the font file is located
+ * @param size store the size of the image here
+ * @return the image allocated with `lv_mem_alloc()` or NULL in case of error
+ */
+void * lv_font_convert_to_image(const char * font_name, uint32_t * size)
+{
+    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
+    memset(font, 0, sizeof(lv_font_t));
+
+    lv_fs_file_t file;
+    if(lv_fs_open(&file, font_name, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        lv_mem_free(font);
+        return NULL;
+    }
+
+    font_sizes_t sizes;
+    bool success = lvgl_load_font(&file, font, &sizes);
+    lv_fs_close(&file);
+
+    void * image = NULL;
+    if(success) {
+        *size = lv_font_image_write(font, sizes.glyph_cnt, sizes.bitmap_size, NULL);
+        image = lv_mem_alloc(*size);
+        LV_ASSERT_MEM(image);
+        if(image) lv_font_image_write(font, sizes.glyph_cnt, sizes.bitmap_size, image);
+    }
+    else {
+        LV_LOG_WARN("Error loading font file: %s\n", font_name);
+    }
+
+    lv_font_free(font);
+    return image;
+}
+
 /**
  * Frees the memory allocated by the `lv_font_load()` function
  * @param font lv_font_t object created by the lv_font_load function
@@ -122,6 +166,10 @@ lv_font_t * lv_font_load(const char * font_name)
 void lv_font_free(lv_font_t * font)
 {
     if(NULL != font) {
+#if LV_FONT_GLYPH_CACHE_SIZE
+        _lv_font_glyph_cache_remove_fmt_txt(font);
+#endif
+
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
 
         if(NULL != dsc) {
@@ -341,7 +389,8 @@ static int32_t load_cmaps(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, u
 }
 
 static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
-                          uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header)
+                          uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header,
+                          uint32_t * bitmap_size)
 {
     int32_t glyph_length = read_label(fp, start, "glyf");
     if(glyph_length < 0) {
@@ -422,6 +471,7 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
     uint8_t * glyph_bmp = (uint8_t *) lv_mem_alloc(sizeof(uint8_t) * cur_bmp_size);
 
     font_dsc->glyph_bitmap = glyph_bmp;
+    *bitmap_size = cur_bmp_size;
 
     cur_bmp_size = 0;
 
@@ -480,8 +530,10 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
  *
  * `lv_font_free` will assume that all non-null pointers are allocated and
  * should be freed.
+ *
+ * The number of glyphs and the size of the bitmaps are stored in `sizes`.
  */
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, font_sizes_t * sizes)
 {
     lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)
                                        lv_mem_alloc(sizeof(lv_font_fmt_txt_dsc_t));
@@ -562,8 +614,9 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 
     /* glyph */
     uint32_t glyph_start = loca_start + loca_length;
+    sizes->glyph_cnt = loca_count;
     int32_t glyph_length = load_glyph(
-                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
+                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header, &sizes->bitmap_size);
 
     lv_mem_free(glyph_offset);
 
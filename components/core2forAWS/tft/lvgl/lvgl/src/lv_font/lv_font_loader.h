@@ -30,6 +30,7 @@ extern "C" {
 
 lv_font_t * lv_font_load(const char * fontName);
 void lv_font_free(lv_font_t * font);
+void * lv_font_convert_to_image(const char * font_name, uint32_t * size);
 
 #endif
 
@@ -388,6 +388,12 @@ lv_disp_t * lv_disp_get_next(lv_disp_t * disp)
  */
 lv_disp_buf_t * lv_disp_get_buf(lv_disp_t * disp)
 {
+#if LV_REFR_PARALLEL > 1
+    /*A band sees only its own rows of the buffer*/
+    lv_refr_band_t * band = _lv_refr_get_band();
+    if(band && band->disp == disp) return &band->buf;
+#endif
+
     return disp->driver.buffer;
 }
 
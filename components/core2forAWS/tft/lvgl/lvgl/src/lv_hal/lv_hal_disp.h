@@ -40,6 +40,7 @@ extern "C" {
 
 struct _disp_t;
 struct _disp_drv_t;
+struct _lv_refr_band_t;
 
 /**
  * Structure for holding display buffer information.
@@ -97,6 +98,11 @@ typedef struct _disp_drv_t {
      */
     uint32_t dpi : 10;
 
+    /** OPTIONAL: Fixed cost of a `flush_cb` call (e.g. sending the commands) in the time of flushing pixels.
+     * Invalidated areas are joined if the joined area costs less than flushing them separately.
+     * 0: join only the overlapping areas when the joined area is smaller */
+    uint32_t flush_overhead;
+
     /** MANDATORY: Write the internal buffer (VDB) to the display. 'lv_disp_flush_ready()' has to be
      * called when finished */
     void (*flush_cb)(struct _disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
@@ -126,6 +132,13 @@ typedef struct _disp_drv_t {
     /** OPTIONAL: called to wait while the gpu is working */
     void (*gpu_wait_cb)(struct _disp_drv_t * disp_drv);
 
+#if LV_REFR_PARALLEL > 1
+    /** OPTIONAL: Start to render a band of the refreshed area on an other core or thread.
+     * Should call `lv_refr_band_render(band)` there and return immediately.
+     * `wait_cb` is called while waiting for the bands. NULL: render the areas in one piece */
+    void (*band_start_cb)(struct _disp_drv_t * disp_drv, struct _lv_refr_band_t * band);
+#endif
+
 #if LV_USE_GPU
 
     /** OPTIONAL: Blend two memories using opacity (GPU only)*/
@@ -11,6 +11,7 @@
 
 #include "../lv_misc/lv_debug.h"
 #include "lv_ll.h"
+#include "lv_math.h"
 #include <string.h>
 #include "lv_gc.h"
 
@@ -26,14 +27,52 @@
     #undef free
 #endif
 
+#define CACHE_NONE  UINT32_MAX  /*Free block or unknown driver position*/
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    uint32_t index;         /*Index of the block in the file (offset / block size). CACHE_NONE: free*/
+    uint32_t life;          /*Stamp of the last access for the LRU eviction*/
+    uint16_t len;           /*Number of valid bytes from the start of the block. Less at the end of the file*/
+    uint16_t dirty_start;   /*The collected writes not passed to the driver yet*/
+    uint16_t dirty_end;
+    uint8_t readable : 1;   /*1: the block holds the file's content up to `len`; 0: it has only collected writes*/
+} cache_block_t;
+
+typedef struct _lv_fs_cache_t {
+    uint32_t pos;           /*Position of the read write pointer seen by the user*/
+    uint32_t drv_pos;       /*Position of the driver's pointer. CACHE_NONE: unknown*/
+    uint32_t next_index;    /*The block after the last read ones to detect sequential reading*/
+    uint32_t life;          /*Counter for the access stamps*/
+    uint8_t ra_cnt;         /*Number of blocks read at the last sequential miss*/
+    uint8_t write : 1;      /*1: collect the writes in the blocks*/
+    cache_block_t * blocks;
+    uint8_t * buf;          /*The data of the blocks, the i-th block's at `buf + i * block size`*/
+} lv_fs_cache_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static const char * lv_fs_get_real_path(const char * path);
+static void cache_create(lv_fs_file_t * file_p, lv_fs_mode_t mode);
+static lv_fs_res_t cache_read(lv_fs_file_t * file_p, uint8_t * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t cache_write(lv_fs_file_t * file_p, const uint8_t * buf, uint32_t btw, uint32_t * bw);
+static lv_fs_res_t cache_write_through(lv_fs_file_t * file_p, const void * buf, uint32_t btw, uint32_t * bw);
+static lv_fs_res_t cache_flush(lv_fs_file_t * file_p);
+static void cache_free_all(lv_fs_file_t * file_p);
+static bool cache_is_dirty(lv_fs_file_t * file_p);
+static void cache_update_eof(lv_fs_file_t * file_p, uint32_t end, cache_block_t * except);
+static cache_block_t * block_find(lv_fs_file_t * file_p, uint32_t index);
+static uint32_t block_lru(lv_fs_file_t * file_p);
+static lv_fs_res_t block_load(lv_fs_file_t * file_p, uint32_t index, cache_block_t ** block_p);
+static lv_fs_res_t block_flush(lv_fs_file_t * file_p, cache_block_t * block);
+static uint8_t * block_data(lv_fs_file_t * file_p, cache_block_t * block);
+static lv_fs_res_t drv_seek(lv_fs_file_t * file_p, uint32_t pos);
+static lv_fs_res_t drv_read(lv_fs_file_t * file_p, uint32_t pos, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t drv_write(lv_fs_file_t * file_p, uint32_t pos, const void * buf, uint32_t btw, uint32_t * bw);
 
 /**********************
  *  STATIC VARIABLES
@@ -83,6 +122,7 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
 {
     file_p->drv    = NULL;
     file_p->file_d = NULL;
+    file_p->cache  = NULL;
 
     if(path == NULL) return LV_FS_RES_INV_PARAM;
 
@@ -110,7 +150,9 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
 
     if(file_p->drv->file_size == 0) {  /*Is file_d zero size?*/
         /*Pass file_d's address to open_cb, so the implementor can allocate memory byself*/
-        return file_p->drv->open_cb(file_p->drv, &file_p->file_d, real_path, mode);
+        lv_fs_res_t res = file_p->drv->open_cb(file_p->drv, &file_p->file_d, real_path, mode);
+        if(res == LV_FS_RES_OK) cache_create(file_p, mode);
+        return res;
     }
 
     file_p->file_d = lv_mem_alloc(file_p->drv->file_size);
@@ -127,6 +169,9 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
         file_p->file_d = NULL;
         file_p->drv    = NULL;
     }
+    else {
+        cache_create(file_p, mode);
+    }
 
     return res;
 }
@@ -146,7 +191,16 @@ lv_fs_res_t lv_fs_close(lv_fs_file_t * file_p)
         return LV_FS_RES_NOT_IMP;
     }
 
-    lv_fs_res_t res = file_p->drv->close_cb(file_p->drv, file_p->file_d);
+    lv_fs_res_t res = LV_FS_RES_OK;
+    if(file_p->cache) {
+        /*Write the collected writes but close the file even if it fails*/
+        res = cache_flush(file_p);
+        lv_mem_free(file_p->cache);
+        file_p->cache = NULL;
+    }
+
+    lv_fs_res_t close_res = file_p->drv->close_cb(file_p->drv, file_p->file_d);
+    if(res == LV_FS_RES_OK) res = close_res;
 
     lv_mem_free(file_p->file_d); /*Clean up*/
     file_p->file_d = NULL;
@@ -195,7 +249,9 @@ lv_fs_res_t lv_fs_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t
     if(file_p->drv->read_cb == NULL) return LV_FS_RES_NOT_IMP;
 
     uint32_t br_tmp = 0;
-    lv_fs_res_t res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, btr, &br_tmp);
+    lv_fs_res_t res;
+    if(file_p->cache) res = cache_read(file_p, buf, btr, &br_tmp);
+    else res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, btr, &br_tmp);
     if(br != NULL) *br = br_tmp;
 
     return res;
@@ -222,7 +278,10 @@ lv_fs_res_t lv_fs_write(lv_fs_file_t * file_p, const void * buf, uint32_t btw, u
     }
 
     uint32_t bw_tmp = 0;
-    lv_fs_res_t res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, &bw_tmp);
+    lv_fs_res_t res;
+    if(file_p->cache == NULL) res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, &bw_tmp);
+    else if(file_p->cache->write) res = cache_write(file_p, buf, btw, &bw_tmp);
+    else res = cache_write_through(file_p, buf, btw, &bw_tmp);
     if(bw != NULL) *bw = bw_tmp;
 
     return res;
@@ -244,6 +303,12 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos)
         return LV_FS_RES_NOT_IMP;
     }
 
+    /*The driver is seeked only when the cache accesses the file*/
+    if(file_p->cache) {
+        file_p->cache->pos = pos;
+        return LV_FS_RES_OK;
+    }
+
     lv_fs_res_t res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos);
 
     return res;
@@ -262,6 +327,11 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
         return LV_FS_RES_INV_PARAM;
     }
 
+    if(file_p->cache) {
+        *pos = file_p->cache->pos;
+        return LV_FS_RES_OK;
+    }
+
     if(file_p->drv->tell_cb == NULL) {
         *pos = 0;
         return LV_FS_RES_NOT_IMP;
@@ -288,6 +358,13 @@ lv_fs_res_t lv_fs_trunc(lv_fs_file_t * file_p)
         return LV_FS_RES_NOT_IMP;
     }
 
+    if(file_p->cache) {
+        lv_fs_res_t res = cache_flush(file_p);
+        if(res == LV_FS_RES_OK) res = drv_seek(file_p, file_p->cache->pos);
+        cache_free_all(file_p);
+        if(res != LV_FS_RES_OK) return res;
+    }
+
     lv_fs_res_t res = file_p->drv->trunc_cb(file_p->drv, file_p->file_d);
 
     return res;
@@ -308,6 +385,12 @@ lv_fs_res_t lv_fs_size(lv_fs_file_t * file_p, uint32_t * size)
 
     if(size == NULL) return LV_FS_RES_INV_PARAM;
 
+    /*The collected writes can make the file longer*/
+    if(file_p->cache) {
+        lv_fs_res_t res = cache_flush(file_p);
+        if(res != LV_FS_RES_OK) return res;
+    }
+
     lv_fs_res_t res = file_p->drv->size_cb(file_p->drv, file_p->file_d, size);
 
     return res;
@@ -661,4 +744,389 @@ static const char * lv_fs_get_real_path(const char * path)
     return path;
 }
 
+/**
+ * Allocate the block cache of a file if its drive has one.
+ * Without enough memory the file is used without cache.
+ * @param file_p pointer to a just opened file
+ * @param mode the mode of the file to know whether the writes can be collected
+ */
+static void cache_create(lv_fs_file_t * file_p, lv_fs_mode_t mode)
+{
+    lv_fs_drv_t * drv = file_p->drv;
+    if(drv->cache_block_size == 0 || drv->cache_block_cnt == 0 || drv->seek_cb == NULL) return;
+
+    uint32_t blocks_size = sizeof(cache_block_t) * drv->cache_block_cnt;
+    uint32_t buf_size = (uint32_t)drv->cache_block_size * drv->cache_block_cnt;
+    lv_fs_cache_t * cache = lv_mem_alloc(sizeof(lv_fs_cache_t) + blocks_size + buf_size);
+    if(cache == NULL) return;
+
+    _lv_memset_00(cache, sizeof(lv_fs_cache_t) + blocks_size);
+    cache->drv_pos = CACHE_NONE;
+    cache->next_index = CACHE_NONE;
+    cache->write = drv->cache_write && (mode & LV_FS_MODE_WR) ? 1 : 0;
+    cache->blocks = (cache_block_t *)(cache + 1);
+    cache->buf = (uint8_t *)(cache->blocks + drv->cache_block_cnt);
+
+    file_p->cache = cache;
+    cache_free_all(file_p);
+}
+
+/**
+ * Read through the cache from the current position.
+ * Whole uncached blocks are read directly to `buf`.
+ */
+static lv_fs_res_t cache_read(lv_fs_file_t * file_p, uint8_t * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_cache_t * cache = file_p->cache;
+    uint32_t block_size = file_p->drv->cache_block_size;
+    lv_fs_res_t res = LV_FS_RES_OK;
+
+    while(btr > 0) {
+        uint32_t index = cache->pos / block_size;
+        uint32_t ofs = cache->pos % block_size;
+        cache_block_t * block = block_find(file_p, index);
+
+        if(block == NULL && ofs == 0 && btr >= block_size) {
+            uint32_t cnt = 1;
+            while(cnt < btr / block_size && block_find(file_p, index + cnt) == NULL) cnt++;
+
+            uint32_t br_tmp = 0;
+            res = drv_read(file_p, cache->pos, buf, cnt * block_size, &br_tmp);
+            cache->next_index = index + cnt;
+            cache->pos += br_tmp;
+            buf += br_tmp;
+            btr -= br_tmp;
+            *br += br_tmp;
+            if(res != LV_FS_RES_OK || br_tmp < cnt * block_size) break;   /*Error or end of the file*/
+            continue;
+        }
+
+        /*A block with only the collected writes is written out and read back*/
+        if(block && !block->readable) {
+            res = block_flush(file_p, block);
+            block->index = CACHE_NONE;
+            block->life = 0;
+            block = NULL;
+            if(res != LV_FS_RES_OK) break;
+        }
+
+        if(block == NULL) {
+            res = block_load(file_p, index, &block);
+            if(res != LV_FS_RES_OK) break;
+        }
+
+        block->life = ++cache->life;
+        if(ofs >= block->len) break;    /*End of the file*/
+
+        uint32_t n = LV_MATH_MIN(btr, (uint32_t)block->len - ofs);
+        _lv_memcpy(buf, block_data(file_p, block) + ofs, n);
+        cache->pos += n;
+        buf += n;
+        btr -= n;
+        *br += n;
+    }
+
+    return res;
+}
+
+/**
+ * Collect the writes in the blocks. Only one continuous range is collected per block,
+ * whole uncached blocks are written directly.
+ */
+static lv_fs_res_t cache_write(lv_fs_file_t * file_p, const uint8_t * buf, uint32_t btw, uint32_t * bw)
+{
+    lv_fs_cache_t * cache = file_p->cache;
+    uint32_t block_size = file_p->drv->cache_block_size;
+    lv_fs_res_t res = LV_FS_RES_OK;
+
+    while(btw > 0) {
+        uint32_t index = cache->pos / block_size;
+        uint32_t ofs = cache->pos % block_size;
+        cache_block_t * block = block_find(file_p, index);
+
+        if(block == NULL && ofs == 0 && btw >= block_size) {
+            uint32_t cnt = 1;
+            while(cnt < btw / block_size && block_find(file_p, index + cnt) == NULL) cnt++;
+
+            uint32_t bw_tmp = 0;
+            res = drv_write(file_p, cache->pos, buf, cnt * block_size, &bw_tmp);
+            cache->pos += bw_tmp;
+            buf += bw_tmp;
+            btw -= bw_tmp;
+            *bw += bw_tmp;
+            cache_update_eof(file_p, cache->pos, NULL);
+            if(res != LV_FS_RES_OK || bw_tmp < cnt * block_size) break;
+            continue;
+        }
+
+        uint32_t n = LV_MATH_MIN(btw, block_size - ofs);
+
+        if(block == NULL) {
+            block = &cache->blocks[block_lru(file_p)];
+            res = block_flush(file_p, block);
+            if(res != LV_FS_RES_OK) break;
+            block->index = index;
+            block->len = 0;
+            block->readable = 0;
+        }
+        else if(block->dirty_end > block->dirty_start && (ofs > block->dirty_end || ofs + n < block->dirty_start)) {
+            res = block_flush(file_p, block);
+            if(res != LV_FS_RES_OK) break;
+        }
+
+        _lv_memcpy(block_data(file_p, block) + ofs, buf, n);
+        if(block->dirty_end > block->dirty_start) {
+            block->dirty_start = LV_MATH_MIN(block->dirty_start, ofs);
+            block->dirty_end = LV_MATH_MAX(block->dirty_end, ofs + n);
+        }
+        else {
+            block->dirty_start = ofs;
+            block->dirty_end = ofs + n;
+        }
+
+        /*The content stays readable only if there is no gap after the known part*/
+        if(block->readable) {
+            if(ofs <= block->len) block->len = LV_MATH_MAX(block->len, ofs + n);
+            else block->readable = 0;
+        }
+
+        block->life = ++cache->life;
+        cache->pos += n;
+        buf += n;
+        btw -= n;
+        *bw += n;
+        cache_update_eof(file_p, cache->pos, block);
+    }
+
+    return res;
+}
+
+/**
+ * Write directly to the driver and drop the cached copies of the written blocks
+ */
+static lv_fs_res_t cache_write_through(lv_fs_file_t * file_p, const void * buf, uint32_t btw, uint32_t * bw)
+{
+    lv_fs_cache_t * cache = file_p->cache;
+    uint32_t block_size = file_p->drv->cache_block_size;
+
+    lv_fs_res_t res = drv_write(file_p, cache->pos, buf, btw, bw);
+    if(*bw > 0) {
+        uint32_t first = cache->pos / block_size;
+        uint32_t last = (cache->pos + *bw - 1) / block_size;
+        uint32_t i;
+        for(i = 0; i < file_p->drv->cache_block_cnt; i++) {
+            cache_block_t * block = &cache->blocks[i];
+            if(block->index != CACHE_NONE && block->index >= first && block->index <= last) {
+                block->index = CACHE_NONE;
+                block->life = 0;
+            }
+        }
+    }
+
+    cache->pos += *bw;
+    cache_update_eof(file_p, cache->pos, NULL);
+
+    return res;
+}
+
+/**
+ * Pass all the collected writes to the driver
+ */
+static lv_fs_res_t cache_flush(lv_fs_file_t * file_p)
+{
+    lv_fs_res_t res = LV_FS_RES_OK;
+    uint32_t i;
+    for(i = 0; i < file_p->drv->cache_block_cnt; i++) {
+        lv_fs_res_t block_res = block_flush(file_p, &file_p->cache->blocks[i]);
+        if(res == LV_FS_RES_OK) res = block_res;
+    }
+
+    return res;
+}
+
+/**
+ * Drop all blocks. The collected writes have to be flushed before.
+ */
+static void cache_free_all(lv_fs_file_t * file_p)
+{
+    uint32_t i;
+    for(i = 0; i < file_p->drv->cache_block_cnt; i++) {
+        cache_block_t * block = &file_p->cache->blocks[i];
+        block->index = CACHE_NONE;
+        block->life = 0;
+        block->dirty_start = 0;
+        block->dirty_end = 0;
+    }
+}
+
+static bool cache_is_dirty(lv_fs_file_t * file_p)
+{
+    uint32_t i;
+    for(i = 0; i < file_p->drv->cache_block_cnt; i++) {
+        cache_block_t * block = &file_p->cache->blocks[i];
+        if(block->index != CACHE_NONE && block->dirty_end > block->dirty_start) return true;
+    }
+
+    return false;
+}
+
+/**
+ * The blocks read at the end of the file know where the file ends.
+ * If the file was written beyond it they need to be read again.
+ * @param end end of the written range
+ * @param except a block whose length is already updated by the write
+ */
+static void cache_update_eof(lv_fs_file_t * file_p, uint32_t end, cache_block_t * except)
+{
+    uint32_t block_size = file_p->drv->cache_block_size;
+    uint32_t i;
+    for(i = 0; i < file_p->drv->cache_block_cnt; i++) {
+        cache_block_t * block = &file_p->cache->blocks[i];
+        if(block == except || block->index == CACHE_NONE || !block->readable) continue;
+        if(block->len < block_size && block->index * block_size + block->len < end) block->readable = 0;
+    }
+}
+
+static cache_block_t * block_find(lv_fs_file_t * file_p, uint32_t index)
+{
+    uint32_t i;
+    for(i = 0; i < file_p->drv->cache_block_cnt; i++) {
+        if(file_p->cache->blocks[i].index == index) return &file_p->cache->blocks[i];
+    }
+
+    return NULL;
+}
+
+/**
+ * Get the least recently used block. The free blocks come first.
+ * @return the index of the block in the cache
+ */
+static uint32_t block_lru(lv_fs_file_t * file_p)
+{
+    uint32_t lru = 0;
+    uint32_t i;
+    for(i = 1; i < file_p->drv->cache_block_cnt; i++) {
+        if(file_p->cache->blocks[i].life < file_p->cache->blocks[lru].life) lru = i;
+    }
+
+    return lru;
+}
+
+/**
+ * Read a block into the cache. If the file is read sequentially the next blocks are read
+ * too in the same driver call, twice as many as at the last miss up to the number of blocks.
+ * @param index index of the block in the file. It must not be cached.
+ * @param block_p store the loaded block here
+ */
+static lv_fs_res_t block_load(lv_fs_file_t * file_p, uint32_t index, cache_block_t ** block_p)
+{
+    lv_fs_cache_t * cache = file_p->cache;
+    uint32_t block_size = file_p->drv->cache_block_size;
+    uint32_t block_cnt = file_p->drv->cache_block_cnt;
+
+    if(index == cache->next_index) cache->ra_cnt = LV_MATH_MIN(LV_MATH_MAX(cache->ra_cnt * 2, 2), block_cnt);
+    else cache->ra_cnt = 1;
+
+    uint32_t cnt = 1;
+    while(cnt < cache->ra_cnt && block_find(file_p, index + cnt) == NULL) cnt++;
+
+    /*Use neighbouring blocks from the least recently used one to read them in one piece*/
+    uint32_t first = block_lru(file_p);
+    if(first + cnt > block_cnt) first = block_cnt - cnt;
+
+    lv_fs_res_t res = LV_FS_RES_OK;
+    uint32_t i;
+    for(i = first; i < first + cnt; i++) {
+        lv_fs_res_t flush_res = block_flush(file_p, &cache->blocks[i]);
+        if(res == LV_FS_RES_OK) res = flush_res;
+        cache->blocks[i].index = CACHE_NONE;
+        cache->blocks[i].life = 0;
+    }
+    if(res != LV_FS_RES_OK) return res;
+
+    uint32_t br = 0;
+    res = drv_read(file_p, index * block_size, cache->buf + first * block_size, cnt * block_size, &br);
+    if(res != LV_FS_RES_OK) return res;
+
+    for(i = first; i < first + cnt; i++) {
+        cache_block_t * block = &cache->blocks[i];
+        block->index = index + i - first;
+        block->len = LV_MATH_MIN(br, block_size);
+        block->readable = 1;
+        block->life = cache->life;
+        br -= block->len;
+    }
+
+    cache->next_index = index + cnt;
+    *block_p = &cache->blocks[first];
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Pass the collected writes of a block to the driver
+ */
+static lv_fs_res_t block_flush(lv_fs_file_t * file_p, cache_block_t * block)
+{
+    if(block->index == CACHE_NONE || block->dirty_end <= block->dirty_start) return LV_FS_RES_OK;
+
+    uint32_t pos = block->index * file_p->drv->cache_block_size + block->dirty_start;
+    uint32_t btw = block->dirty_end - block->dirty_start;
+    uint32_t bw = 0;
+    lv_fs_res_t res = drv_write(file_p, pos, block_data(file_p, block) + block->dirty_start, btw, &bw);
+    block->dirty_start = 0;
+    block->dirty_end = 0;
+    if(res == LV_FS_RES_OK && bw < btw) res = LV_FS_RES_FULL;
+
+    return res;
+}
+
+static uint8_t * block_data(lv_fs_file_t * file_p, cache_block_t * block)
+{
+    return file_p->cache->buf + (uint32_t)(block - file_p->cache->blocks) * file_p->drv->cache_block_size;
+}
+
+/**
+ * Move the driver's pointer if it's not there already
+ */
+static lv_fs_res_t drv_seek(lv_fs_file_t * file_p, uint32_t pos)
+{
+    if(file_p->cache->drv_pos == pos) return LV_FS_RES_OK;
+
+    lv_fs_res_t res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos);
+    file_p->cache->drv_pos = res == LV_FS_RES_OK ? pos : CACHE_NONE;
+
+    return res;
+}
+
+static lv_fs_res_t drv_read(lv_fs_file_t * file_p, uint32_t pos, void * buf, uint32_t btr, uint32_t * br)
+{
+    *br = 0;
+    lv_fs_res_t res = drv_seek(file_p, pos);
+    if(res != LV_FS_RES_OK) return res;
+
+    res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, btr, br);
+    file_p->cache->drv_pos = res == LV_FS_RES_OK ? pos + *br : CACHE_NONE;
+
+    /*The end of the file is known only after writing the collected writes*/
+    if(res == LV_FS_RES_OK && *br < btr && cache_is_dirty(file_p)) {
+        res = cache_flush(file_p);
+        if(res == LV_FS_RES_OK) res = drv_read(file_p, pos, buf, btr, br);
+    }
+
+    return res;
+}
+
+static lv_fs_res_t drv_write(lv_fs_file_t * file_p, uint32_t pos, const void * buf, uint32_t btw, uint32_t * bw)
+{
+    *bw = 0;
+    lv_fs_res_t res = drv_seek(file_p, pos);
+    if(res != LV_FS_RES_OK) return res;
+
+    res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, bw);
+    file_p->cache->drv_pos = res == LV_FS_RES_OK ? pos + *bw : CACHE_NONE;
+
+    return res;
+}
+
 #endif /*LV_USE_FILESYSTEM*/
@@ -64,6 +64,16 @@ typedef struct _lv_fs_drv_t {
     char letter;
     uint16_t file_size;
     uint16_t rddir_size;
+
+    /*Block cache of the open files. Set them before `lv_fs_drv_register()`.
+     *The reads and writes go through `cache_block_cnt` buffers of `cache_block_size` bytes,
+     *aligned to the block size in the file. 0: no cache, the calls are passed to the driver.
+     *The driver needs `seek_cb` for caching.*/
+    uint16_t cache_block_size;  /**< Size of a cached block in bytes, e.g. the sector size*/
+    uint8_t cache_block_cnt;    /**< Number of cached blocks per open file*/
+    uint8_t cache_write : 1;    /**< 1: collect the writes in the blocks and write them when a block is evicted or
+                                     the file is closed; 0: write through*/
+
     bool (*ready_cb)(struct _lv_fs_drv_t * drv);
 
     lv_fs_res_t (*open_cb)(struct _lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode);
@@ -87,9 +97,12 @@ typedef struct _lv_fs_drv_t {
 #endif
 } lv_fs_drv_t;
 
+struct _lv_fs_cache_t;
+
 typedef struct {
     void * file_d;
     lv_fs_drv_t * drv;
+    struct _lv_fs_cache_t * cache;  /**< The cached blocks or NULL if the drive doesn't cache*/
 } lv_fs_file_t;
 
 typedef struct {
@@ -33,10 +33,12 @@ extern "C" {
     f(lv_ll_t, _lv_file_ll)                                        \
     f(lv_ll_t, _lv_anim_ll)                                        \
     f(lv_ll_t, _lv_group_ll)                                       \
+    f(lv_ll_t, _lv_indev_grid_ll) /*Hit-test grids of screens*/    \
     f(lv_ll_t, _lv_img_defoder_ll)                                 \
     f(lv_ll_t, _lv_obj_style_trans_ll)                             \
     f(lv_img_cache_entry_t*, _lv_img_cache_array)                  \
     f(lv_task_t*, _lv_task_act)                                    \
+    f(lv_task_t**, _lv_task_heap)  /*Running tasks by deadline*/   \
     f(lv_mem_buf_arr_t , _lv_mem_buf)                              \
     f(_lv_draw_mask_saved_arr_t , _lv_draw_mask_list)              \
     f(void * , _lv_theme_material_styles)                          \
@@ -11,6 +11,8 @@
 #include "lv_math.h"
 #include "lv_gc.h"
 #include "lv_debug.h"
+#include "../lv_core/lv_refr.h"
+#include <stddef.h>
 #include <string.h>
 
 #if LV_MEM_CUSTOM != 0
@@ -35,6 +37,9 @@
     #define MEM_UNIT uint32_t
 #endif
 
+/*Use the TLSF allocator for the built-in pool*/
+#define MEM_TLSF    (LV_MEM_CUSTOM == 0 && LV_MEM_TLSF)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -57,6 +62,17 @@ typedef struct {
 
 #endif /* LV_ENABLE_GC */
 
+#if MEM_TLSF
+/* A block of the TLSF pool. The data of a used block starts at `next_free`.
+ * `prev_phys` is the last word of the previous block's data so it's valid only if that block is free.*/
+typedef struct _tlsf_block_t {
+    struct _tlsf_block_t * prev_phys;   /*The previous block in the pool*/
+    size_t size;                        /*Size of the data (`TLSF_ALIGN` aligned) and the flags*/
+    struct _tlsf_block_t * next_free;   /*The free list of the block's size class*/
+    struct _tlsf_block_t * prev_free;
+} tlsf_block_t;
+#endif
+
 #ifdef LV_ARCH_64
     #define ALIGN_MASK 0x7
 #else
@@ -65,14 +81,62 @@ typedef struct {
 
 #define MEM_BUF_SMALL_SIZE 16
 
+#if MEM_TLSF
+/* The size classes: below `TLSF_SMALL_SIZE` there are `TLSF_SL_CNT` linear classes,
+ * above it every power of 2 range is split into `TLSF_SL_CNT` classes*/
+#define TLSF_SL_LOG2        3
+#define TLSF_SL_CNT         (1 << TLSF_SL_LOG2)
+#define TLSF_ALIGN          (ALIGN_MASK + 1)
+#ifdef LV_ARCH_64
+    #define TLSF_ALIGN_LOG2 3
+#else
+    #define TLSF_ALIGN_LOG2 2
+#endif
+#define TLSF_FL_SHIFT       (TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_SMALL_SIZE     ((size_t)1 << TLSF_FL_SHIFT)
+
+/*log2 of the largest block*/
+#if LV_MEM_SIZE <= (1UL << 16)
+#define TLSF_FL_MAX         16
+#elif LV_MEM_SIZE <= (1UL << 20)
+#define TLSF_FL_MAX         20
+#elif LV_MEM_SIZE <= (1UL << 24)
+#define TLSF_FL_MAX         24
+#else
+#define TLSF_FL_MAX         31
+#endif
+#define TLSF_FL_CNT         (TLSF_FL_MAX - TLSF_FL_SHIFT + 1)
+
+#define TLSF_FREE           0x1     /*Flag in `size`: the block is free*/
+#define TLSF_PREV_FREE      0x2     /*Flag in `size`: the previous block is free*/
+#define TLSF_OVERHEAD       sizeof(size_t)                                   /*Header of a used block*/
+#define TLSF_BLOCK_MIN      (sizeof(tlsf_block_t) - sizeof(tlsf_block_t *))  /*Smallest data size*/
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 && MEM_TLSF == 0
     static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e);
     static void * ent_alloc(lv_mem_ent_t * e, size_t size);
     static void ent_trunc(lv_mem_ent_t * e, size_t size);
 #endif
+#if MEM_TLSF
+    static void tlsf_init(uint8_t * mem, size_t bytes);
+    static void * tlsf_alloc(size_t size);
+    static void tlsf_free(void * data);
+    static bool tlsf_resize(void * data, size_t size);
+    static tlsf_block_t * tlsf_split(tlsf_block_t * b, size_t size);
+    static void tlsf_trim(tlsf_block_t * b, size_t size);
+    static void tlsf_insert(tlsf_block_t * b);
+    static void tlsf_remove(tlsf_block_t * b);
+    static void tlsf_mapping(size_t size, uint32_t * fl, uint32_t * sl);
+    static tlsf_block_t * tlsf_find_free(size_t size);
+    static void tlsf_stats_add(tlsf_block_t * b);
+    static void tlsf_stats_remove(tlsf_block_t * b);
+    static inline uint32_t tlsf_fls(uint32_t x);
+    static inline uint32_t tlsf_ffs(uint32_t x);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -87,6 +151,17 @@ static uint32_t zero_mem; /*Give the address of this variable if 0 byte should b
     static uint32_t mem_max_size; /*Tracks the maximum total size of memory ever used from the internal heap*/
 #endif
 
+#if MEM_TLSF
+    static tlsf_block_t * tlsf_lists[TLSF_FL_CNT][TLSF_SL_CNT]; /*Heads of the free lists of the size classes*/
+    static uint32_t tlsf_fl_bitmap;                 /*Bit `fl`: `tlsf_sl_bitmap[fl]` is not 0*/
+    static uint32_t tlsf_sl_bitmap[TLSF_FL_CNT];    /*Bit `sl`: `tlsf_lists[fl][sl]` is not empty*/
+    static tlsf_block_t * tlsf_first;               /*The first block of the pool*/
+    static uint32_t tlsf_used_size;                 /*Size of the used blocks with their headers*/
+#if LV_MEM_TLSF_STATS
+    static lv_mem_class_stats_t tlsf_class_stats[TLSF_FL_CNT];
+#endif
+#endif
+
 static uint8_t mem_buf1_32[MEM_BUF_SMALL_SIZE];
 static uint8_t mem_buf2_32[MEM_BUF_SMALL_SIZE];
 
@@ -99,11 +174,27 @@ static lv_mem_buf_t mem_buf_small[] = {{.p = mem_buf1_32, .size = MEM_BUF_SMALL_
  **********************/
 
 #define COPY32 *d32 = *s32; d32++; s32++;
+
+#if LV_REFR_PARALLEL > 1
+/*The bands rendered in parallel use their own buffers and not the small static ones*/
+#define MEM_BUF_ARR()           (_lv_refr_get_band() ? _lv_refr_get_band()->mem_buf : LV_GC_ROOT(_lv_mem_buf))
+#define MEM_BUF_SMALL_USABLE()  (_lv_refr_get_band() == NULL)
+#else
+#define MEM_BUF_ARR()           LV_GC_ROOT(_lv_mem_buf)
+#define MEM_BUF_SMALL_USABLE()  true
+#endif
 #define COPY8 *d8 = *s8; d8++; s8++;
 #define SET32(x) *d32 = x; d32++;
 #define SET8(x) *d8 = x; d8++;
 #define REPEAT8(expr) expr expr expr expr expr expr expr expr
 
+#if MEM_TLSF
+#define TLSF_BLOCK_SIZE(b)  ((b)->size & ~(size_t)(TLSF_FREE | TLSF_PREV_FREE))
+#define TLSF_TO_PTR(b)      ((void *)&(b)->next_free)
+#define TLSF_FROM_PTR(p)    ((tlsf_block_t *)((uint8_t *)(p) - offsetof(tlsf_block_t, next_free)))
+#define TLSF_NEXT(b)        ((tlsf_block_t *)((uint8_t *)TLSF_TO_PTR(b) + TLSF_BLOCK_SIZE(b) - TLSF_OVERHEAD))
+#endif
+
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
@@ -123,11 +214,15 @@ void _lv_mem_init(void)
     work_mem = (uint8_t *)LV_MEM_ADR;
 #endif
 
+#if MEM_TLSF
+    tlsf_init(work_mem, LV_MEM_SIZE);
+#else
     lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
     full->header.s.used = 0;
     /*The total mem size reduced by the first header and the close patterns */
     full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
 #endif
+#endif
 }
 
 /**
@@ -136,7 +231,9 @@ void _lv_mem_init(void)
  */
 void _lv_mem_deinit(void)
 {
-#if LV_MEM_CUSTOM == 0
+#if MEM_TLSF
+    tlsf_init(work_mem, LV_MEM_SIZE);
+#elif LV_MEM_CUSTOM == 0
     lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
     full->header.s.used = 0;
     /*The total mem size reduced by the first header and the close patterns */
@@ -159,7 +256,11 @@ void * lv_mem_alloc(size_t size)
     size = (size + ALIGN_MASK) & (~ALIGN_MASK);
     void * alloc = NULL;
 
-#if LV_MEM_CUSTOM == 0
+    _lv_refr_lock();
+
+#if MEM_TLSF
+    alloc = tlsf_alloc(size);
+#elif LV_MEM_CUSTOM == 0
     /*Use the built-in allocators*/
     lv_mem_ent_t * e = NULL;
 
@@ -199,7 +300,7 @@ void * lv_mem_alloc(size_t size)
         LV_LOG_WARN("Couldn't allocate memory");
     }
     else {
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 && MEM_TLSF == 0
         /* just a safety check, should always be true */
         if((uintptr_t) alloc > (uintptr_t) work_mem) {
             if((((uintptr_t) alloc - (uintptr_t) work_mem) + size) > mem_max_size) {
@@ -209,6 +310,8 @@ void * lv_mem_alloc(size_t size)
 #endif
     }
 
+    _lv_refr_unlock();
+
     return alloc;
 }
 
@@ -221,10 +324,15 @@ void lv_mem_free(const void * data)
     if(data == &zero_mem) return;
     if(data == NULL) return;
 
+    _lv_refr_lock();
+
 #if LV_MEM_ADD_JUNK
     _lv_memset((void *)data, 0xbb, _lv_mem_get_size(data));
 #endif
 
+#if MEM_TLSF
+    tlsf_free((void *)data);
+#else
 #if LV_ENABLE_GC == 0
     /*e points to the header*/
     lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data - sizeof(lv_mem_header_t));
@@ -263,6 +371,9 @@ void lv_mem_free(const void * data)
     LV_MEM_CUSTOM_FREE((void *)data);
 #endif /*LV_ENABLE_GC*/
 #endif
+#endif /*MEM_TLSF*/
+
+    _lv_refr_unlock();
 }
 
 /**
@@ -280,22 +391,44 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     /*Round the size up to ALIGN_MASK*/
     new_size = (new_size + ALIGN_MASK) & (~ALIGN_MASK);
 
+    _lv_refr_lock();
+
     /*data_p could be previously freed pointer (in this case it is invalid)*/
+#if MEM_TLSF
+    if(data_p != NULL && data_p != &zero_mem) {
+        if(TLSF_FROM_PTR(data_p)->size & TLSF_FREE) {
+            data_p = NULL;
+        }
+    }
+#else
     if(data_p != NULL) {
         lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
         if(e->header.s.used == 0) {
             data_p = NULL;
         }
     }
+#endif
 
     uint32_t old_size = _lv_mem_get_size(data_p);
-    if(old_size == new_size) return data_p; /*Also avoid reallocating the same memory*/
+    if(old_size == new_size) {
+        _lv_refr_unlock();
+        return data_p; /*Also avoid reallocating the same memory*/
+    }
 
-#if LV_MEM_CUSTOM == 0
+#if MEM_TLSF
+    /*Shrink or grow in place if the next block is free and large enough*/
+    if(data_p != NULL && data_p != &zero_mem && new_size != 0) {
+        if(tlsf_resize(data_p, new_size)) {
+            _lv_refr_unlock();
+            return data_p;
+        }
+    }
+#elif LV_MEM_CUSTOM == 0
     /* Truncate the memory if the new size is smaller. */
     if(new_size < old_size) {
         lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
         ent_trunc(e, new_size);
+        _lv_refr_unlock();
         return &e->first_data;
     }
 #endif
@@ -304,6 +437,7 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     new_p = lv_mem_alloc(new_size);
     if(new_p == NULL) {
         LV_LOG_WARN("Couldn't allocate memory");
+        _lv_refr_unlock();
         return NULL;
     }
 
@@ -315,6 +449,8 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
         lv_mem_free(data_p);
     }
 
+    _lv_refr_unlock();
+
     return new_p;
 }
 
@@ -322,7 +458,9 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
 
 void * lv_mem_realloc(void * data_p, size_t new_size)
 {
+    _lv_refr_lock();
     void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
+    _lv_refr_unlock();
     if(new_p == NULL) LV_LOG_WARN("Couldn't allocate memory");
     return new_p;
 }
@@ -334,7 +472,8 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
  */
 void lv_mem_defrag(void)
 {
-#if LV_MEM_CUSTOM == 0
+    /*The TLSF allocator joins the free blocks on free*/
+#if LV_MEM_CUSTOM == 0 && MEM_TLSF == 0
     lv_mem_ent_t * e_free;
     lv_mem_ent_t * e_next;
     e_free = ent_get_next(NULL);
@@ -375,7 +514,24 @@ void lv_mem_defrag(void)
 
 lv_res_t lv_mem_test(void)
 {
-#if LV_MEM_CUSTOM == 0
+#if MEM_TLSF
+    /*Check the chain of the blocks and the flags of the neighbors*/
+    tlsf_block_t * b = tlsf_first;
+    bool prev_free = false;
+    while(TLSF_BLOCK_SIZE(b) != 0) {
+        tlsf_block_t * next = TLSF_NEXT(b);
+        if((uint8_t *)next < (uint8_t *)b || (uint8_t *)next >= work_mem + LV_MEM_SIZE) return LV_RES_INV;
+
+        bool free = b->size & TLSF_FREE ? true : false;
+        if(prev_free != (b->size & TLSF_PREV_FREE ? true : false)) return LV_RES_INV;
+        if(free && prev_free) return LV_RES_INV;    /*Should have been joined*/
+        if(free && next->prev_phys != b) return LV_RES_INV;
+
+        prev_free = free;
+        b = next;
+    }
+    if(prev_free != (b->size & TLSF_PREV_FREE ? true : false)) return LV_RES_INV;
+#elif LV_MEM_CUSTOM == 0
     lv_mem_ent_t * e;
     e = ent_get_next(NULL);
     while(e) {
@@ -402,6 +558,22 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
     /*Init the data*/
     _lv_memset(mon_p, 0, sizeof(lv_mem_monitor_t));
 #if LV_MEM_CUSTOM == 0
+#if MEM_TLSF
+    tlsf_block_t * b;
+    for(b = tlsf_first; TLSF_BLOCK_SIZE(b) != 0; b = TLSF_NEXT(b)) {
+        uint32_t size = TLSF_BLOCK_SIZE(b);
+        if(b->size & TLSF_FREE) {
+            mon_p->free_cnt++;
+            mon_p->free_size += size;
+            if(size > mon_p->free_biggest_size) {
+                mon_p->free_biggest_size = size;
+            }
+        }
+        else {
+            mon_p->used_cnt++;
+        }
+    }
+#else
     lv_mem_ent_t * e;
 
     e = ent_get_next(NULL);
@@ -420,6 +592,7 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 
         e = ent_get_next(e);
     }
+#endif
     mon_p->total_size = LV_MEM_SIZE;
     mon_p->max_used = mem_max_size;
     mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
@@ -433,6 +606,26 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 #endif
 }
 
+#if MEM_TLSF && LV_MEM_TLSF_STATS
+/**
+ * Get the allocation counters of the size classes, the smallest class first
+ * @param stats array to store the counters of the classes
+ * @param max_cnt number of elements in `stats`
+ * @return number of classes stored in `stats`
+ */
+uint32_t lv_mem_get_class_stats(lv_mem_class_stats_t * stats, uint32_t max_cnt)
+{
+    uint32_t cnt = LV_MATH_MIN(max_cnt, TLSF_FL_CNT);
+    _lv_memcpy(stats, tlsf_class_stats, cnt * sizeof(lv_mem_class_stats_t));
+
+    uint32_t fl;
+    for(fl = 0; fl < cnt; fl++) {
+        stats[fl].size_max = (uint32_t)(TLSF_SMALL_SIZE << fl) - 1;
+    }
+    return cnt;
+}
+#endif
+
 /**
  * Give the size of an allocated memory
  * @param data pointer to an allocated memory
@@ -446,9 +639,13 @@ uint32_t _lv_mem_get_size(const void * data)
     if(data == NULL) return 0;
     if(data == &zero_mem) return 0;
 
+#if MEM_TLSF
+    return TLSF_BLOCK_SIZE(TLSF_FROM_PTR(data));
+#else
     lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data - sizeof(lv_mem_header_t));
 
     return e->header.s.d_size;
+#endif
 }
 
 #else /* LV_ENABLE_GC */
@@ -468,9 +665,11 @@ void * _lv_mem_buf_get(uint32_t size)
 {
     if(size == 0) return NULL;
 
+    lv_mem_buf_t * bufs = MEM_BUF_ARR();
+
     /*Try small static buffers first*/
     uint8_t i;
-    if(size <= MEM_BUF_SMALL_SIZE) {
+    if(size <= MEM_BUF_SMALL_SIZE && MEM_BUF_SMALL_USABLE()) {
         for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
             if(mem_buf_small[i].used == 0) {
                 mem_buf_small[i].used = 1;
@@ -482,39 +681,39 @@ void * _lv_mem_buf_get(uint32_t size)
     /*Try to find a free buffer with suitable size */
     int8_t i_guess = -1;
     for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).used == 0 && LV_GC_ROOT(_lv_mem_buf[i]).size >= size) {
-            if(LV_GC_ROOT(_lv_mem_buf[i]).size == size) {
-                LV_GC_ROOT(_lv_mem_buf[i]).used = 1;
-                return LV_GC_ROOT(_lv_mem_buf[i]).p;
+        if(bufs[i].used == 0 && bufs[i].size >= size) {
+            if(bufs[i].size == size) {
+                bufs[i].used = 1;
+                return bufs[i].p;
             }
             else if(i_guess < 0) {
                 i_guess = i;
             }
             /*If size of `i` is closer to `size` prefer it*/
-            else if(LV_GC_ROOT(_lv_mem_buf[i]).size < LV_GC_ROOT(_lv_mem_buf[i_guess]).size) {
+            else if(bufs[i].size < bufs[i_guess].size) {
                 i_guess = i;
             }
         }
     }
 
     if(i_guess >= 0) {
-        LV_GC_ROOT(_lv_mem_buf[i_guess]).used = 1;
-        return LV_GC_ROOT(_lv_mem_buf[i_guess]).p;
+        bufs[i_guess].used = 1;
+        return bufs[i_guess].p;
     }
 
     /*Reallocate a free buffer*/
     for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).used == 0) {
+        if(bufs[i].used == 0) {
             /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
-            void * buf = lv_mem_realloc(LV_GC_ROOT(_lv_mem_buf[i]).p, size);
+            void * buf = lv_mem_realloc(bufs[i].p, size);
             if(buf == NULL) {
                 LV_DEBUG_ASSERT(false, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)", 0x00);
                 return NULL;
             }
-            LV_GC_ROOT(_lv_mem_buf[i]).used = 1;
-            LV_GC_ROOT(_lv_mem_buf[i]).size = size;
-            LV_GC_ROOT(_lv_mem_buf[i]).p    = buf;
-            return LV_GC_ROOT(_lv_mem_buf[i]).p;
+            bufs[i].used = 1;
+            bufs[i].size = size;
+            bufs[i].p    = buf;
+            return bufs[i].p;
         }
     }
 
@@ -528,6 +727,7 @@ void * _lv_mem_buf_get(uint32_t size)
  */
 void _lv_mem_buf_release(void * p)
 {
+    lv_mem_buf_t * bufs = MEM_BUF_ARR();
     uint8_t i;
 
     /*Try small static buffers first*/
@@ -539,8 +739,8 @@ void _lv_mem_buf_release(void * p)
     }
 
     for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).p == p) {
-            LV_GC_ROOT(_lv_mem_buf[i]).used = 0;
+        if(bufs[i].p == p) {
+            bufs[i].used = 0;
             return;
         }
     }
@@ -549,21 +749,24 @@ void _lv_mem_buf_release(void * p)
 }
 
 /**
- * Free all memory buffers
+ * Free all memory buffers (of the band rendered by the calling thread if any)
  */
 void _lv_mem_buf_free_all(void)
 {
+    lv_mem_buf_t * bufs = MEM_BUF_ARR();
     uint8_t i;
-    for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
-        mem_buf_small[i].used = 0;
+    if(MEM_BUF_SMALL_USABLE()) {
+        for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
+            mem_buf_small[i].used = 0;
+        }
     }
 
     for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).p) {
-            lv_mem_free(LV_GC_ROOT(_lv_mem_buf[i]).p);
-            LV_GC_ROOT(_lv_mem_buf[i]).p = NULL;
-            LV_GC_ROOT(_lv_mem_buf[i]).used = 0;
-            LV_GC_ROOT(_lv_mem_buf[i]).size = 0;
+        if(bufs[i].p) {
+            lv_mem_free(bufs[i].p);
+            bufs[i].p = NULL;
+            bufs[i].used = 0;
+            bufs[i].size = 0;
         }
     }
 }
@@ -757,7 +960,7 @@ LV_ATTRIBUTE_FAST_MEM void _lv_memset_ff(void * dst, size_t len)
  *   STATIC FUNCTIONS
  **********************/
 
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 && MEM_TLSF == 0
 /**
  * Give the next entry after 'act_e'
  * @param act_e pointer to an entry
@@ -830,3 +1033,317 @@ static void ent_trunc(lv_mem_ent_t * e, size_t size)
 }
 
 #endif
+
+#if MEM_TLSF
+/**
+ * Make the whole pool one free block
+ * @param mem start of the pool
+ * @param bytes size of the pool
+ */
+static void tlsf_init(uint8_t * mem, size_t bytes)
+{
+    _lv_memset_00(tlsf_lists, sizeof(tlsf_lists));
+    _lv_memset_00(tlsf_sl_bitmap, sizeof(tlsf_sl_bitmap));
+    tlsf_fl_bitmap = 0;
+    tlsf_used_size = 0;
+    mem_max_size = 0;
+
+    lv_uintptr_t start = ((lv_uintptr_t)mem + ALIGN_MASK) & ~(lv_uintptr_t)ALIGN_MASK;
+    bytes = (bytes - (start - (lv_uintptr_t)mem)) & ~(size_t)ALIGN_MASK;
+
+    /*The first block's `prev_phys` is before the pool but it's never used.
+     *The pool is closed by an empty used block*/
+    tlsf_first = (tlsf_block_t *)(start - sizeof(tlsf_block_t *));
+    tlsf_first->size = (bytes - 2 * TLSF_OVERHEAD) | TLSF_FREE;
+    tlsf_block_t * sentinel = TLSF_NEXT(tlsf_first);
+    sentinel->prev_phys = tlsf_first;
+    sentinel->size = TLSF_PREV_FREE;
+    tlsf_insert(tlsf_first);
+}
+
+/**
+ * Allocate a block from the free list of the smallest size class which surely fits `size`
+ * @param size size of the data
+ * @return pointer to the data or NULL if there is no free block to fit `size`
+ */
+static void * tlsf_alloc(size_t size)
+{
+    size = (size + ALIGN_MASK) & ~(size_t)ALIGN_MASK;
+    if(size < TLSF_BLOCK_MIN) size = TLSF_BLOCK_MIN;
+
+    tlsf_block_t * b = tlsf_find_free(size);
+    if(b == NULL) return NULL;
+
+    tlsf_remove(b);
+    if(TLSF_BLOCK_SIZE(b) >= size + sizeof(tlsf_block_t)) {
+        tlsf_insert(tlsf_split(b, size));
+    }
+
+    b->size &= ~(size_t)TLSF_FREE;
+    TLSF_NEXT(b)->size &= ~(size_t)TLSF_PREV_FREE;
+
+    tlsf_stats_add(b);
+#if LV_MEM_TLSF_STATS
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(TLSF_BLOCK_SIZE(b), &fl, &sl);
+    tlsf_class_stats[fl].alloc_cnt++;
+#endif
+    return TLSF_TO_PTR(b);
+}
+
+/**
+ * Free a block and join it with its free neighbors
+ * @param data pointer to the data of a used block
+ */
+static void tlsf_free(void * data)
+{
+    tlsf_block_t * b = TLSF_FROM_PTR(data);
+    tlsf_stats_remove(b);
+
+    b->size |= TLSF_FREE;
+    tlsf_block_t * next = TLSF_NEXT(b);
+
+    if(b->size & TLSF_PREV_FREE) {
+        tlsf_block_t * prev = b->prev_phys;
+        tlsf_remove(prev);
+        prev->size += TLSF_BLOCK_SIZE(b) + TLSF_OVERHEAD;
+        b = prev;
+    }
+
+    if(next->size & TLSF_FREE) {
+        tlsf_remove(next);
+        b->size += TLSF_BLOCK_SIZE(next) + TLSF_OVERHEAD;
+        next = TLSF_NEXT(b);
+    }
+
+    next->prev_phys = b;
+    next->size |= TLSF_PREV_FREE;
+    tlsf_insert(b);
+}
+
+/**
+ * Change the size of a used block without moving its data.
+ * @param data pointer to the data of a used block
+ * @param size the new size of the data
+ * @return true: the block was resized; false: the next block is not free or not large enough
+ */
+static bool tlsf_resize(void * data, size_t size)
+{
+    tlsf_block_t * b = TLSF_FROM_PTR(data);
+    size = (size + ALIGN_MASK) & ~(size_t)ALIGN_MASK;
+    if(size < TLSF_BLOCK_MIN) size = TLSF_BLOCK_MIN;
+
+    if(size > TLSF_BLOCK_SIZE(b)) {
+        tlsf_block_t * next = TLSF_NEXT(b);
+        if((next->size & TLSF_FREE) == 0) return false;
+        if(TLSF_BLOCK_SIZE(b) + TLSF_BLOCK_SIZE(next) + TLSF_OVERHEAD < size) return false;
+
+        tlsf_stats_remove(b);
+        tlsf_remove(next);
+        b->size += TLSF_BLOCK_SIZE(next) + TLSF_OVERHEAD;
+        TLSF_NEXT(b)->size &= ~(size_t)TLSF_PREV_FREE;
+    }
+    else {
+        tlsf_stats_remove(b);
+    }
+
+    tlsf_trim(b, size);
+    tlsf_stats_add(b);
+    return true;
+}
+
+/**
+ * Split the end of a block to a new free block
+ * @param b pointer to a block
+ * @param size the new data size of `b`. The remaining has to be at least `sizeof(tlsf_block_t)`
+ * @return the new block after `b`. It's marked as free but not added to a free list
+ */
+static tlsf_block_t * tlsf_split(tlsf_block_t * b, size_t size)
+{
+    tlsf_block_t * rest = (tlsf_block_t *)((uint8_t *)TLSF_TO_PTR(b) + size - TLSF_OVERHEAD);
+    rest->size = (TLSF_BLOCK_SIZE(b) - size - TLSF_OVERHEAD) | TLSF_FREE;
+    if(b->size & TLSF_FREE) rest->size |= TLSF_PREV_FREE;
+    b->size = size | (b->size & (TLSF_FREE | TLSF_PREV_FREE));
+
+    tlsf_block_t * next = TLSF_NEXT(rest);
+    next->prev_phys = rest;
+    next->size |= TLSF_PREV_FREE;
+    return rest;
+}
+
+/**
+ * Give back the end of a used block to the free blocks if it's large enough
+ * @param b pointer to a used block
+ * @param size the new data size of `b`
+ */
+static void tlsf_trim(tlsf_block_t * b, size_t size)
+{
+    if(TLSF_BLOCK_SIZE(b) < size + sizeof(tlsf_block_t)) return;
+
+    tlsf_block_t * rest = tlsf_split(b, size);
+    tlsf_block_t * next = TLSF_NEXT(rest);
+    if(next->size & TLSF_FREE) {
+        tlsf_remove(next);
+        rest->size += TLSF_BLOCK_SIZE(next) + TLSF_OVERHEAD;
+        TLSF_NEXT(rest)->prev_phys = rest;
+    }
+    tlsf_insert(rest);
+}
+
+/**
+ * Add a free block to the free list of its size class
+ */
+static void tlsf_insert(tlsf_block_t * b)
+{
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(TLSF_BLOCK_SIZE(b), &fl, &sl);
+
+    tlsf_block_t * head = tlsf_lists[fl][sl];
+    b->next_free = head;
+    b->prev_free = NULL;
+    if(head) head->prev_free = b;
+    tlsf_lists[fl][sl] = b;
+
+    tlsf_fl_bitmap |= 1UL << fl;
+    tlsf_sl_bitmap[fl] |= 1UL << sl;
+}
+
+/**
+ * Remove a free block from the free list of its size class
+ */
+static void tlsf_remove(tlsf_block_t * b)
+{
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(TLSF_BLOCK_SIZE(b), &fl, &sl);
+
+    if(b->next_free) b->next_free->prev_free = b->prev_free;
+    if(b->prev_free) {
+        b->prev_free->next_free = b->next_free;
+        return;
+    }
+
+    tlsf_lists[fl][sl] = b->next_free;
+    if(b->next_free == NULL) {
+        tlsf_sl_bitmap[fl] &= ~(1UL << sl);
+        if(tlsf_sl_bitmap[fl] == 0) tlsf_fl_bitmap &= ~(1UL << fl);
+    }
+}
+
+/**
+ * Get the size class of a block size
+ * @param size size of the data of a block
+ * @param fl store the first level index (power of 2 range) here
+ * @param sl store the second level index (linear subrange) here
+ */
+static void tlsf_mapping(size_t size, uint32_t * fl, uint32_t * sl)
+{
+    if(size < TLSF_SMALL_SIZE) {
+        *fl = 0;
+        *sl = (uint32_t)size / (TLSF_SMALL_SIZE / TLSF_SL_CNT);
+    }
+    else {
+        uint32_t msb = tlsf_fls((uint32_t)size);
+        *sl = ((uint32_t)size >> (msb - TLSF_SL_LOG2)) ^ TLSF_SL_CNT;
+        *fl = msb - TLSF_FL_SHIFT + 1;
+    }
+}
+
+/**
+ * Find a free block whose every size of its class fits `size`
+ * @param size size of the data
+ * @return a free block or NULL if there is no suitable free block
+ */
+static tlsf_block_t * tlsf_find_free(size_t size)
+{
+    /*Round up to the next class to not search in the list*/
+    if(size >= TLSF_SMALL_SIZE) {
+        uint32_t msb = tlsf_fls((uint32_t)size);
+        size += ((size_t)1 << (msb - TLSF_SL_LOG2)) - 1;
+    }
+
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(size, &fl, &sl);
+    if(fl >= TLSF_FL_CNT) return NULL;
+
+    uint32_t sl_map = tlsf_sl_bitmap[fl] & (~0UL << sl);
+    if(sl_map == 0) {
+        /*Take the smallest class of a larger first level*/
+        uint32_t fl_map = fl + 1 < 32 ? tlsf_fl_bitmap & (~0UL << (fl + 1)) : 0;
+        if(fl_map == 0) return NULL;
+        fl = tlsf_ffs(fl_map);
+        sl_map = tlsf_sl_bitmap[fl];
+    }
+
+    return tlsf_lists[fl][tlsf_ffs(sl_map)];
+}
+
+/**
+ * Count a block which has become used
+ */
+static void tlsf_stats_add(tlsf_block_t * b)
+{
+    tlsf_used_size += TLSF_BLOCK_SIZE(b) + TLSF_OVERHEAD;
+    if(tlsf_used_size > mem_max_size) mem_max_size = tlsf_used_size;
+
+#if LV_MEM_TLSF_STATS
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(TLSF_BLOCK_SIZE(b), &fl, &sl);
+    lv_mem_class_stats_t * c = &tlsf_class_stats[fl];
+    c->used_cnt++;
+    if(c->used_cnt > c->used_max) c->used_max = c->used_cnt;
+#endif
+}
+
+/**
+ * Count a block which is not used anymore
+ */
+static void tlsf_stats_remove(tlsf_block_t * b)
+{
+    tlsf_used_size -= TLSF_BLOCK_SIZE(b) + TLSF_OVERHEAD;
+
+#if LV_MEM_TLSF_STATS
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(TLSF_BLOCK_SIZE(b), &fl, &sl);
+    tlsf_class_stats[fl].used_cnt--;
+#endif
+}
+
+/**
+ * Index of the most significant set bit
+ * @param x a non-zero value
+ */
+static inline uint32_t tlsf_fls(uint32_t x)
+{
+#if defined(__GNUC__)
+    return 31 - (uint32_t)__builtin_clz(x);
+#else
+    uint32_t i = 0;
+    while(x >>= 1) i++;
+    return i;
+#endif
+}
+
+/**
+ * Index of the least significant set bit
+ * @param x a non-zero value
+ */
+static inline uint32_t tlsf_ffs(uint32_t x)
+{
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_ctz(x);
+#else
+    uint32_t i = 0;
+    while((x & 1) == 0) {
+        x >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+#endif /*MEM_TLSF*/
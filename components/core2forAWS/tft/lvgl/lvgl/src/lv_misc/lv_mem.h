@@ -50,6 +50,18 @@ typedef struct {
     uint8_t frag_pct; /**< Amount of fragmentation */
 } lv_mem_monitor_t;
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF && LV_MEM_TLSF_STATS
+/**
+ * Allocation counters of a size class of the TLSF allocator.
+ */
+typedef struct {
+    uint32_t size_max;  /**< The class holds the blocks up to this size */
+    uint32_t alloc_cnt; /**< Allocations since start up */
+    uint32_t used_cnt;  /**< Blocks in use */
+    uint32_t used_max;  /**< Max. blocks in use at once */
+} lv_mem_class_stats_t;
+#endif
+
 typedef struct {
     void * p;
     uint16_t size;
@@ -114,6 +126,16 @@ lv_res_t lv_mem_test(void);
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF && LV_MEM_TLSF_STATS
+/**
+ * Get the allocation counters of the size classes, the smallest class first
+ * @param stats array to store the counters of the classes
+ * @param max_cnt number of elements in `stats`
+ * @return number of classes stored in `stats`
+ */
+uint32_t lv_mem_get_class_stats(lv_mem_class_stats_t * stats, uint32_t max_cnt);
+#endif
+
 /**
  * Give the size of an allocated memory
  * @param data pointer to an allocated memory
@@ -134,7 +156,7 @@ void * _lv_mem_buf_get(uint32_t size);
 void _lv_mem_buf_release(void * p);
 
 /**
- * Free all memory buffers
+ * Free all memory buffers (of the band rendered by the calling thread if any)
  */
 void _lv_mem_buf_free_all(void);
 
@@ -19,6 +19,7 @@
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PRIO LV_TASK_PRIO_MID
 #define DEF_PERIOD 500
+#define HEAP_MIN_CAP 8
 
 /**********************
  *      TYPEDEFS
@@ -27,8 +28,18 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void lv_task_dispatch(void);
 static bool lv_task_exec(lv_task_t * task);
 static uint32_t lv_task_time_remaining(lv_task_t * task);
+static bool heap_reserve(uint32_t cnt);
+static void heap_insert(lv_task_t * task);
+static void heap_remove(lv_task_t * task);
+static void heap_update(lv_task_t * task);
+static void heap_sift_up(uint32_t i);
+static void heap_sift_down(uint32_t i);
+static void heap_place(lv_task_t * task, uint32_t i);
+static bool deadline_before(lv_task_t * a, lv_task_t * b);
+static void resume_check(lv_task_t * task);
 
 /**********************
  *  STATIC VARIABLES
@@ -38,6 +49,13 @@ static uint8_t idle_last = 0;
 static bool task_deleted;
 static bool task_list_changed;
 static bool task_created;
+static bool handler_running;
+static uint32_t task_cnt;
+static uint32_t heap_size;
+static uint32_t heap_cap;
+static lv_task_resume_cb_t task_resume_cb;
+static uint32_t resume_tick;    /*The time `lv_task_handler` is expected to be called again*/
+static bool resume_wait;        /*`resume_tick` is valid, i.e. a task was running*/
 
 /**********************
  *      MACROS
@@ -53,6 +71,11 @@ static bool task_created;
 void _lv_task_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_task_ll), sizeof(lv_task_t));
+    LV_GC_ROOT(_lv_task_heap) = NULL;
+    task_cnt = 0;
+    heap_size = 0;
+    heap_cap = 0;
+    resume_wait = false;
 
     /*Initially enable the lv_task handling*/
     lv_task_enable(true);
@@ -67,12 +90,11 @@ LV_ATTRIBUTE_TASK_HANDLER uint32_t lv_task_handler(void)
     LV_LOG_TRACE("lv_task_handler started");
 
     /*Avoid concurrent running of the task handler*/
-    static bool already_running = false;
-    if(already_running) return 1;
-    already_running = true;
+    if(handler_running) return 1;
+    handler_running = true;
 
     if(lv_task_run == false) {
-        already_running = false; /*Release mutex*/
+        handler_running = false; /*Release mutex*/
         return 1;
     }
 
@@ -81,90 +103,14 @@ LV_ATTRIBUTE_TASK_HANDLER uint32_t lv_task_handler(void)
 
     uint32_t handler_start = lv_tick_get();
 
-    /* Run all task from the highest to the lowest priority
-     * If a lower priority task is executed check task again from the highest priority
-     * but on the priority of executed tasks don't run tasks before the executed*/
-    lv_task_t * task_interrupter = NULL;
-    lv_task_t * next;
-    bool end_flag;
-    do {
-        end_flag                 = true;
-        task_deleted             = false;
-        task_created             = false;
-        task_list_changed        = false;
-        LV_GC_ROOT(_lv_task_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_task_ll));
-        while(LV_GC_ROOT(_lv_task_act)) {
-            /* The task might be deleted if it runs only once ('once = 1')
-             * So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_task_ll), LV_GC_ROOT(_lv_task_act));
-
-            /*We reach priority of the turned off task. There is nothing more to do.*/
-            if(LV_GC_ROOT(_lv_task_act)->prio == LV_TASK_PRIO_OFF) {
-                break;
-            }
-
-            /*Here is the interrupter task. Don't execute it again.*/
-            if(LV_GC_ROOT(_lv_task_act) == task_interrupter) {
-                task_interrupter = NULL; /*From this point only task after the interrupter comes, so
-                                            the interrupter is not interesting anymore*/
-                LV_GC_ROOT(_lv_task_act) = next;
-                continue; /*Load the next task*/
-            }
-
-            /*Just try to run the tasks with highest priority.*/
-            if(LV_GC_ROOT(_lv_task_act)->prio == LV_TASK_PRIO_HIGHEST) {
-                lv_task_exec(LV_GC_ROOT(_lv_task_act));
-            }
-            /*Tasks with higher priority than the interrupted shall be run in every case*/
-            else if(task_interrupter) {
-                if(LV_GC_ROOT(_lv_task_act)->prio > task_interrupter->prio) {
-                    if(lv_task_exec(LV_GC_ROOT(_lv_task_act))) {
-                        if(!task_created && !task_deleted) {
-                            /*Check all tasks again from the highest priority */
-                            task_interrupter = LV_GC_ROOT(_lv_task_act);
-                            end_flag = false;
-                            break;
-                        }
-                    }
-                }
-            }
-            /* It is no interrupter task or we already reached it earlier.
-             * Just run the remaining tasks*/
-            else {
-                if(lv_task_exec(LV_GC_ROOT(_lv_task_act))) {
-                    if(!task_created && !task_deleted) {
-                        task_interrupter = LV_GC_ROOT(_lv_task_act); /*Check all tasks again from the highest priority */
-                        end_flag         = false;
-                        break;
-                    }
-                }
-            }
-
-            /*If a task was created or deleted then this or the next item might be corrupted*/
-            if(task_created || task_deleted) {
-                task_interrupter = NULL;
-                break;
-            }
-
-            if(task_list_changed) {
-                task_interrupter = NULL;
-                end_flag = false;
-                break;
-            }
-
-            LV_GC_ROOT(_lv_task_act) = next; /*Load the next task*/
-        }
-    } while(!end_flag);
+    /*The running tasks are in a heap by deadline so nothing is due if the first one isn't*/
+    lv_task_t * first = heap_size ? LV_GC_ROOT(_lv_task_heap)[0] : NULL;
+    if(first && lv_task_time_remaining(first) == 0) {
+        lv_task_dispatch();
+    }
 
     uint32_t time_till_next = LV_NO_TASK_READY;
-    next = _lv_ll_get_head(&LV_GC_ROOT(_lv_task_ll));
-    while(next && next->prio != LV_TASK_PRIO_OFF) {
-        uint32_t delay = lv_task_time_remaining(next);
-        if(delay < time_till_next)
-            time_till_next = delay;
-
-        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_task_ll), next); /*Find the next task*/
-    }
+    if(heap_size) time_till_next = lv_task_time_remaining(LV_GC_ROOT(_lv_task_heap)[0]);
 
     busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(idle_period_start);
@@ -175,11 +121,15 @@ LV_ATTRIBUTE_TASK_HANDLER uint32_t lv_task_handler(void)
         idle_period_start = lv_tick_get();
     }
 
-    already_running = false; /*Release the mutex*/
+    resume_wait = time_till_next != LV_NO_TASK_READY;
+    resume_tick = lv_tick_get() + time_till_next;
+
+    handler_running = false; /*Release the mutex*/
 
     LV_LOG_TRACE("lv_task_handler ready");
     return time_till_next;
 }
+
 /**
  * Create an "empty" task. It needs to initialized with at least
  * `lv_task_set_cb` and `lv_task_set_period`
@@ -205,6 +155,9 @@ lv_task_t * lv_task_create(lv_task_cb_t task_xcb, uint32_t period, lv_task_prio_
     lv_task_t * new_task = NULL;
     lv_task_t * tmp;
 
+    /*Be sure the task will fit into the heap when it's turned on*/
+    if(heap_reserve(task_cnt + 1) == false) return NULL;
+
     /*Create task lists in order of priority from high to low*/
     tmp = _lv_ll_get_head(&LV_GC_ROOT(_lv_task_ll));
 
@@ -244,6 +197,13 @@ lv_task_t * lv_task_create(lv_task_cb_t task_xcb, uint32_t period, lv_task_prio_
 
     new_task->user_data = user_data;
 
+    task_cnt++;
+    new_task->heap_id = 0;
+    if(prio != LV_TASK_PRIO_OFF) {
+        heap_insert(new_task);
+        resume_check(new_task);
+    }
+
     task_created = true;
 
     return new_task;
@@ -268,6 +228,9 @@ void lv_task_del(lv_task_t * task)
     _lv_ll_remove(&LV_GC_ROOT(_lv_task_ll), task);
     task_list_changed = true;
 
+    if(task->heap_id) heap_remove(task);
+    task_cnt--;
+
     lv_mem_free(task);
 
     if(LV_GC_ROOT(_lv_task_act) == task) task_deleted = true; /*The active task was deleted*/
@@ -297,6 +260,14 @@ void lv_task_set_prio(lv_task_t * task, lv_task_prio_t prio)
     }
     task_list_changed = true;
 
+    if(prio == LV_TASK_PRIO_OFF) {
+        heap_remove(task);
+    }
+    else if(task->prio == LV_TASK_PRIO_OFF) {
+        heap_insert(task);
+        resume_check(task);
+    }
+
     task->prio = prio;
 }
 
@@ -308,6 +279,10 @@ void lv_task_set_prio(lv_task_t * task, lv_task_prio_t prio)
 void lv_task_set_period(lv_task_t * task, uint32_t period)
 {
     task->period = period;
+    if(task->heap_id) {
+        heap_update(task);
+        resume_check(task);
+    }
 }
 
 /**
@@ -317,6 +292,10 @@ void lv_task_set_period(lv_task_t * task, uint32_t period)
 void lv_task_ready(lv_task_t * task)
 {
     task->last_run = lv_tick_get() - task->period - 1;
+    if(task->heap_id) {
+        heap_update(task);
+        resume_check(task);
+    }
 }
 
 /**
@@ -337,6 +316,7 @@ void lv_task_set_repeat_count(lv_task_t * task, int32_t repeat_count)
 void lv_task_reset(lv_task_t * task)
 {
     task->last_run = lv_tick_get();
+    if(task->heap_id) heap_update(task);
 }
 
 /**
@@ -348,6 +328,15 @@ void lv_task_enable(bool en)
     lv_task_run = en;
 }
 
+/**
+ * Set a callback to call when a task becomes ready earlier than the time returned by `lv_task_handler`.
+ * @param resume_cb the callback or NULL
+ */
+void lv_task_set_resume_cb(lv_task_resume_cb_t resume_cb)
+{
+    task_resume_cb = resume_cb;
+}
+
 /**
  * Get idle percentage
  * @return the lv_task idle in percentage
@@ -372,6 +361,87 @@ lv_task_t * lv_task_get_next(lv_task_t * task)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Run the due tasks
+ */
+static void lv_task_dispatch(void)
+{
+    /* Run all task from the highest to the lowest priority
+     * If a lower priority task is executed check task again from the highest priority
+     * but on the priority of executed tasks don't run tasks before the executed*/
+    lv_task_t * task_interrupter = NULL;
+    lv_task_t * next;
+    bool end_flag;
+    do {
+        end_flag                 = true;
+        task_deleted             = false;
+        task_created             = false;
+        task_list_changed        = false;
+        LV_GC_ROOT(_lv_task_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_task_ll));
+        while(LV_GC_ROOT(_lv_task_act)) {
+            /* The task might be deleted if it runs only once ('once = 1')
+             * So get next element until the current is surely valid*/
+            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_task_ll), LV_GC_ROOT(_lv_task_act));
+
+            /*We reach priority of the turned off task. There is nothing more to do.*/
+            if(LV_GC_ROOT(_lv_task_act)->prio == LV_TASK_PRIO_OFF) {
+                break;
+            }
+
+            /*Here is the interrupter task. Don't execute it again.*/
+            if(LV_GC_ROOT(_lv_task_act) == task_interrupter) {
+                task_interrupter = NULL; /*From this point only task after the interrupter comes, so
+                                            the interrupter is not interesting anymore*/
+                LV_GC_ROOT(_lv_task_act) = next;
+                continue; /*Load the next task*/
+            }
+
+            /*Just try to run the tasks with highest priority.*/
+            if(LV_GC_ROOT(_lv_task_act)->prio == LV_TASK_PRIO_HIGHEST) {
+                lv_task_exec(LV_GC_ROOT(_lv_task_act));
+            }
+            /*Tasks with higher priority than the interrupted shall be run in every case*/
+            else if(task_interrupter) {
+                if(LV_GC_ROOT(_lv_task_act)->prio > task_interrupter->prio) {
+                    if(lv_task_exec(LV_GC_ROOT(_lv_task_act))) {
+                        if(!task_created && !task_deleted) {
+                            /*Check all tasks again from the highest priority */
+                            task_interrupter = LV_GC_ROOT(_lv_task_act);
+                            end_flag = false;
+                            break;
+                        }
+                    }
+                }
+            }
+            /* It is no interrupter task or we already reached it earlier.
+             * Just run the remaining tasks*/
+            else {
+                if(lv_task_exec(LV_GC_ROOT(_lv_task_act))) {
+                    if(!task_created && !task_deleted) {
+                        task_interrupter = LV_GC_ROOT(_lv_task_act); /*Check all tasks again from the highest priority */
+                        end_flag         = false;
+                        break;
+                    }
+                }
+            }
+
+            /*If a task was created or deleted then this or the next item might be corrupted*/
+            if(task_created || task_deleted) {
+                task_interrupter = NULL;
+                break;
+            }
+
+            if(task_list_changed) {
+                task_interrupter = NULL;
+                end_flag = false;
+                break;
+            }
+
+            LV_GC_ROOT(_lv_task_act) = next; /*Load the next task*/
+        }
+    } while(!end_flag);
+}
+
 /**
  * Execute task if its the priority is appropriate
  * @param task pointer to lv_task
@@ -383,6 +453,7 @@ static bool lv_task_exec(lv_task_t * task)
 
     if(lv_task_time_remaining(task) == 0) {
         task->last_run = lv_tick_get();
+        if(task->heap_id) heap_update(task);
         if(task->task_cb) task->task_cb(task);
 
         /*Delete if it was a one shot lv_task*/
@@ -413,3 +484,125 @@ static uint32_t lv_task_time_remaining(lv_task_t * task)
         return 0;
     return task->period - elp;
 }
+
+/**
+ * Make room for `cnt` tasks in the heap
+ * @param cnt number of tasks
+ * @return true: success, false: out of memory
+ */
+static bool heap_reserve(uint32_t cnt)
+{
+    if(cnt <= heap_cap) return true;
+
+    uint32_t new_cap = heap_cap ? heap_cap * 2 : HEAP_MIN_CAP;
+    lv_task_t ** new_heap = lv_mem_realloc(LV_GC_ROOT(_lv_task_heap), new_cap * sizeof(lv_task_t *));
+    LV_ASSERT_MEM(new_heap);
+    if(new_heap == NULL) return false;
+
+    LV_GC_ROOT(_lv_task_heap) = new_heap;
+    heap_cap = new_cap;
+    return true;
+}
+
+/**
+ * Add a task to the heap. There is always room for it as every task has a place reserved.
+ * @param task pointer to a task
+ */
+static void heap_insert(lv_task_t * task)
+{
+    heap_size++;
+    heap_place(task, heap_size - 1);
+    heap_sift_up(heap_size - 1);
+}
+
+/**
+ * Remove a task from the heap
+ * @param task pointer to a task in the heap
+ */
+static void heap_remove(lv_task_t * task)
+{
+    uint32_t i = task->heap_id - 1;
+    task->heap_id = 0;
+    heap_size--;
+    if(i == heap_size) return;
+
+    /*Move the last task to the empty place and restore the order*/
+    heap_place(LV_GC_ROOT(_lv_task_heap)[heap_size], i);
+    heap_update(LV_GC_ROOT(_lv_task_heap)[i]);
+}
+
+/**
+ * Restore the order of the heap after the deadline of a task has changed
+ * @param task pointer to a task in the heap
+ */
+static void heap_update(lv_task_t * task)
+{
+    uint32_t i = task->heap_id - 1;
+    if(i > 0 && deadline_before(task, LV_GC_ROOT(_lv_task_heap)[(i - 1) / 2])) heap_sift_up(i);
+    else heap_sift_down(i);
+}
+
+static void heap_sift_up(uint32_t i)
+{
+    lv_task_t ** heap = LV_GC_ROOT(_lv_task_heap);
+    lv_task_t * task = heap[i];
+    while(i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if(!deadline_before(task, heap[parent])) break;
+        heap_place(heap[parent], i);
+        i = parent;
+    }
+    heap_place(task, i);
+}
+
+static void heap_sift_down(uint32_t i)
+{
+    lv_task_t ** heap = LV_GC_ROOT(_lv_task_heap);
+    lv_task_t * task = heap[i];
+    while(1) {
+        uint32_t child = 2 * i + 1;
+        if(child >= heap_size) break;
+        if(child + 1 < heap_size && deadline_before(heap[child + 1], heap[child])) child++;
+        if(!deadline_before(heap[child], task)) break;
+        heap_place(heap[child], i);
+        i = child;
+    }
+    heap_place(task, i);
+}
+
+static void heap_place(lv_task_t * task, uint32_t i)
+{
+    LV_GC_ROOT(_lv_task_heap)[i] = task;
+    task->heap_id = i + 1;
+}
+
+/**
+ * Tell if a task has to run earlier than an other.
+ * The deadlines wrap around with the tick so the periods should be shorter than ~24 days.
+ * @param a pointer to a task
+ * @param b pointer to an other task
+ * @return true: `a` has to run earlier
+ */
+static bool deadline_before(lv_task_t * a, lv_task_t * b)
+{
+    uint32_t da = a->last_run + a->period;
+    uint32_t db = b->last_run + b->period;
+    return (int32_t)(da - db) < 0;
+}
+
+/**
+ * Call the `resume_cb` if a task became the first one and has to run earlier than
+ * `lv_task_handler` told the last time.
+ * @param task pointer to a task which was added or rescheduled
+ */
+static void resume_check(lv_task_t * task)
+{
+    if(task_resume_cb == NULL || handler_running || task->heap_id != 1) return;
+
+    uint32_t deadline = task->last_run + task->period;
+    if(resume_wait && (int32_t)(deadline - resume_tick) >= 0) return;
+
+    resume_wait = true;
+    resume_tick = deadline;
+    task_resume_cb();
+}
@@ -40,6 +40,11 @@ struct _lv_task_t;
  */
 typedef void (*lv_task_cb_t)(struct _lv_task_t *);
 
+/**
+ * Called when a task has to run earlier than `lv_task_handler` told the last time.
+ */
+typedef void (*lv_task_resume_cb_t)(void);
+
 /**
  * Possible priorities for lv_tasks
  */
@@ -66,6 +71,7 @@ typedef struct _lv_task_t {
 
     int32_t repeat_count; /**< 1: Task times;  -1 : infinity;  0 : stop ;  n>0: residual times */
     uint8_t prio : 3; /**< Task priority */
+    uint16_t heap_id; /**< Position in the deadline heap + 1, 0: not scheduled (turned off) */
 } lv_task_t;
 
 /**********************
@@ -81,7 +87,8 @@ void _lv_task_core_init(void);
 
 /**
  * Call it periodically to handle lv_tasks.
- * @return time till it needs to be run next (in ms)
+ * @return time till it needs to be run next (in ms) or `LV_NO_TASK_READY` if there is no running task.
+ * Sleeping until then is safe if a `resume_cb` is set with `lv_task_set_resume_cb`.
  */
 LV_ATTRIBUTE_TASK_HANDLER uint32_t lv_task_handler(void);
 
@@ -159,6 +166,14 @@ void lv_task_reset(lv_task_t * task);
  */
 void lv_task_enable(bool en);
 
+/**
+ * Set a callback to call when a task becomes ready earlier than the time returned by `lv_task_handler`.
+ * E.g. a task is created, made ready or turned on by an invalidation or animation.
+ * It's not called from `lv_task_handler` itself. Use it to wake up the thread calling `lv_task_handler`.
+ * @param resume_cb the callback or NULL
+ */
+void lv_task_set_resume_cb(lv_task_resume_cb_t resume_cb);
+
 /**
  * Get idle percentage
  * @return the lv_task idle in percentage
@@ -17,6 +17,8 @@
  *      DEFINES
  *********************/
 #define NO_BREAK_FOUND UINT32_MAX
+#define LAYOUT_MIN_LINES 2
+#define LAYOUT_FLAGS (LV_TXT_FLAG_RECOLOR | LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)  /*Flags which change the lines*/
 
 /**********************
  *      TYPEDEFS
@@ -26,6 +28,7 @@
  *  STATIC PROTOTYPES
  **********************/
 static inline bool is_break_char(uint32_t letter);
+static uint32_t layout_get_word_start(const char * txt, uint32_t i);
 
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
     static uint8_t lv_txt_utf8_size(const char * str);
@@ -524,6 +527,185 @@ char * _lv_txt_set_text_vfmt(const char * fmt, va_list ap)
     return text;
 }
 
+/**
+ * Initialize a text layout. It has no lines until `_lv_txt_layout_update()` is called.
+ * @param layout pointer to a text layout
+ */
+void _lv_txt_layout_init(lv_txt_layout_t * layout)
+{
+    _lv_memset_00(layout, sizeof(lv_txt_layout_t));
+}
+
+/**
+ * Free the lines of a text layout
+ * @param layout pointer to a text layout
+ */
+void _lv_txt_layout_free(lv_txt_layout_t * layout)
+{
+    if(layout->lines) lv_mem_free(layout->lines);
+    _lv_txt_layout_init(layout);
+}
+
+/**
+ * Drop the lines of a text layout which can depend on a part of the text that changed.
+ * The lines before the change are kept and only the rest will be laid out by the next `_lv_txt_layout_update()`.
+ * @param layout pointer to a text layout
+ * @param txt the old or the new text. Only its first `byte_id` bytes are used which has to be the same in both.
+ * @param byte_id index of the first changed byte. 0 to drop all lines.
+ */
+void _lv_txt_layout_invalidate(lv_txt_layout_t * layout, const char * txt, uint32_t byte_id)
+{
+    layout->complete = 0;
+
+    /* To find the end of a line the next word is measured entirely with the letter after it (for kerning).
+     * So the lines ending in the word of the changed letter or in the word before it can change too.
+     * Recolor commands can hide the end of the words so lay out everything again with them.*/
+    uint32_t keep_end = 0;
+    if(byte_id > 0 && (layout->flag & LV_TXT_FLAG_RECOLOR) == 0) {
+        _lv_txt_encoded_prev(txt, &byte_id);
+        keep_end = layout_get_word_start(txt, byte_id);
+        if(keep_end > 0) keep_end = layout_get_word_start(txt, keep_end - 1);
+    }
+
+    while(layout->line_cnt > 0 && _lv_txt_layout_get_line_end(layout, layout->line_cnt - 1) >= keep_end) {
+        layout->line_cnt--;
+        layout->end = layout->lines[layout->line_cnt].start;
+    }
+}
+
+/**
+ * Lay out the lines of a text which are not laid out yet. All lines are laid out again if the parameters changed.
+ * @param layout pointer to a text layout
+ * @param txt a '\0' terminated string. Must be the same text as on the last update
+ * or its changes needs to be reported with `_lv_txt_layout_invalidate()`.
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_width max width of the text (break the lines to fit this size)
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: all lines are laid out; false: out of memory, the layout can't be used
+ */
+bool _lv_txt_layout_update(lv_txt_layout_t * layout, const char * txt, const lv_font_t * font,
+                           lv_coord_t letter_space, lv_coord_t max_width, lv_txt_flag_t flag)
+{
+    if(txt == NULL || font == NULL) return false;
+
+    /*The max. width doesn't matter if the lines are broken only at new lines*/
+    if(flag & (LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)) max_width = LV_COORD_MAX;
+    flag &= LAYOUT_FLAGS;
+
+    if(layout->font != font || layout->letter_space != letter_space || layout->max_width != max_width ||
+       layout->flag != flag) {
+        layout->font = font;
+        layout->letter_space = letter_space;
+        layout->max_width = max_width;
+        layout->flag = flag;
+        layout->line_cnt = 0;
+        layout->end = 0;
+        layout->complete = 0;
+    }
+
+    layout->txt = txt;
+    if(layout->complete) return true;
+
+    uint32_t line_start = layout->end;
+    while(txt[line_start] != '\0') {
+        if(layout->line_cnt == layout->line_cap) {
+            uint32_t new_cap = layout->line_cap ? layout->line_cap * 2 : LAYOUT_MIN_LINES;
+            lv_txt_layout_line_t * new_lines = lv_mem_realloc(layout->lines, new_cap * sizeof(lv_txt_layout_line_t));
+            if(new_lines == NULL) return false;
+            layout->lines = new_lines;
+            layout->line_cap = new_cap;
+        }
+
+        uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_width, flag);
+        lv_txt_layout_line_t * line = &layout->lines[layout->line_cnt];
+        line->start = line_start;
+        line->w = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, letter_space, flag);
+        layout->line_cnt++;
+        layout->end = line_end;
+        line_start = line_end;
+    }
+
+    /*Calc. the longest line*/
+    uint32_t i;
+    layout->w = 0;
+    for(i = 0; i < layout->line_cnt; i++) {
+        layout->w = LV_MATH_MAX(layout->w, layout->lines[i].w);
+    }
+
+    layout->complete = 1;
+    return true;
+}
+
+/**
+ * Check if a text layout is complete and was laid out with the given parameters
+ * @param layout pointer to a text layout
+ * @param txt pointer to the text
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_width max width of the text
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: the lines of the layout can be used to draw `txt`
+ */
+bool _lv_txt_layout_is_valid(const lv_txt_layout_t * layout, const char * txt, const lv_font_t * font,
+                             lv_coord_t letter_space, lv_coord_t max_width, lv_txt_flag_t flag)
+{
+    if(flag & (LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)) max_width = LV_COORD_MAX;
+
+    return layout->complete && layout->txt == txt && layout->font == font && layout->letter_space == letter_space &&
+           layout->max_width == max_width && layout->flag == (flag & LAYOUT_FLAGS);
+}
+
+/**
+ * Get the size of a laid out text. The same as `_lv_txt_get_size()` with the parameters of the layout.
+ * @param layout pointer to a complete text layout
+ * @param size_res pointer to a 'point_t' variable to store the result
+ * @param line_space line space of the text
+ */
+void _lv_txt_layout_get_size(const lv_txt_layout_t * layout, lv_point_t * size_res, lv_coord_t line_space)
+{
+    int32_t letter_height = lv_font_get_line_height(layout->font);
+    int32_t line_cnt = layout->line_cnt;
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    if(layout->end != 0 && (layout->txt[layout->end - 1] == '\n' || layout->txt[layout->end - 1] == '\r')) {
+        line_cnt++;
+    }
+
+    int32_t h = line_cnt * (letter_height + line_space);
+    if(h > LV_COORD_MAX) {
+        LV_LOG_WARN("_lv_txt_layout_get_size: integer overflow while calculating text height");
+        h = LV_COORD_MAX;
+    }
+
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    if(h == 0) h = letter_height;
+    else h -= line_space;
+
+    size_res->x = layout->w;
+    size_res->y = (lv_coord_t)h;
+}
+
+/**
+ * Get the line which contains a byte of the text
+ * @param layout pointer to a complete text layout with at least one line
+ * @param byte_id byte index in the text
+ * @return index of the line. The last line if `byte_id` is beyond the text.
+ */
+uint32_t _lv_txt_layout_get_line(const lv_txt_layout_t * layout, uint32_t byte_id)
+{
+    /*Find the last line starting before or at `byte_id`*/
+    uint32_t min = 0;
+    uint32_t max = layout->line_cnt - 1;
+    while(min < max) {
+        uint32_t mid = (min + max + 1) / 2;
+        if(layout->lines[mid].start <= byte_id) min = mid;
+        else max = mid - 1;
+    }
+
+    return min;
+}
+
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
 /*******************************
  *   UTF-8 ENCODER/DECODER
@@ -890,6 +1072,23 @@ static uint32_t lv_txt_iso8859_1_get_length(const char * txt)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the start of the word containing a byte. Words end with a break character or a new line.
+ * @param txt pointer to a text
+ * @param i byte index in `txt`
+ * @return byte index of the first character of the word
+ */
+static uint32_t layout_get_word_start(const char * txt, uint32_t i)
+{
+    while(i > 0) {
+        uint8_t c = (uint8_t)txt[i - 1];
+        if(c == '\n' || c == '\r' || is_break_char(c)) break;
+        i--;
+    }
+
+    return i;
+}
+
 /**
  * Test if char is break char or not (a text can broken here or not)
  * @param letter a letter
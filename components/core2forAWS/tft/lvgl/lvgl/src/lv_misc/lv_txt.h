@@ -56,6 +56,31 @@ enum {
 };
 typedef uint8_t lv_txt_cmd_state_t;
 
+/** A line of a text layout*/
+typedef struct {
+    uint32_t start;             /**< Byte index of the first character of the line*/
+    lv_coord_t w;               /**< Width of the line in pixels*/
+} lv_txt_layout_line_t;
+
+/**
+ * The line breaks and line widths of a text, stored to avoid measuring the letters again
+ * every time the text is drawn or a position is searched in it.
+ * The lines are laid out in order so if the text changes only the lines after the change need to be laid out again.
+ */
+typedef struct {
+    const char * txt;           /**< The text of the last update*/
+    const lv_font_t * font;
+    lv_txt_layout_line_t * lines;
+    uint32_t line_cnt;
+    uint32_t line_cap;          /**< Number of lines `lines` can store*/
+    uint32_t end;               /**< Byte index where the next line starts. The length of the text if `complete`*/
+    lv_coord_t max_width;
+    lv_coord_t letter_space;
+    lv_coord_t w;               /**< Width of the longest line. Valid if `complete`*/
+    lv_txt_flag_t flag;         /**< Only the flags which change the line breaks or widths*/
+    uint8_t complete : 1;       /**< All lines are laid out*/
+} lv_txt_layout_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -101,6 +126,81 @@ uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font, lv_coor
 lv_coord_t _lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t * font, lv_coord_t letter_space,
                              lv_txt_flag_t flag);
 
+/**
+ * Initialize a text layout. It has no lines until `_lv_txt_layout_update()` is called.
+ * @param layout pointer to a text layout
+ */
+void _lv_txt_layout_init(lv_txt_layout_t * layout);
+
+/**
+ * Free the lines of a text layout
+ * @param layout pointer to a text layout
+ */
+void _lv_txt_layout_free(lv_txt_layout_t * layout);
+
+/**
+ * Drop the lines of a text layout which can depend on a part of the text that changed.
+ * The lines before the change are kept and only the rest will be laid out by the next `_lv_txt_layout_update()`.
+ * @param layout pointer to a text layout
+ * @param txt the old or the new text. Only its first `byte_id` bytes are used which has to be the same in both.
+ * @param byte_id index of the first changed byte. 0 to drop all lines.
+ */
+void _lv_txt_layout_invalidate(lv_txt_layout_t * layout, const char * txt, uint32_t byte_id);
+
+/**
+ * Lay out the lines of a text which are not laid out yet. All lines are laid out again if the parameters changed.
+ * @param layout pointer to a text layout
+ * @param txt a '\0' terminated string. Must be the same text as on the last update
+ * or its changes needs to be reported with `_lv_txt_layout_invalidate()`.
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_width max width of the text (break the lines to fit this size)
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: all lines are laid out; false: out of memory, the layout can't be used
+ */
+bool _lv_txt_layout_update(lv_txt_layout_t * layout, const char * txt, const lv_font_t * font,
+                           lv_coord_t letter_space, lv_coord_t max_width, lv_txt_flag_t flag);
+
+/**
+ * Check if a text layout is complete and was laid out with the given parameters
+ * @param layout pointer to a text layout
+ * @param txt pointer to the text
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_width max width of the text
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return true: the lines of the layout can be used to draw `txt`
+ */
+bool _lv_txt_layout_is_valid(const lv_txt_layout_t * layout, const char * txt, const lv_font_t * font,
+                             lv_coord_t letter_space, lv_coord_t max_width, lv_txt_flag_t flag);
+
+/**
+ * Get the size of a laid out text. The same as `_lv_txt_get_size()` with the parameters of the layout.
+ * @param layout pointer to a complete text layout
+ * @param size_res pointer to a 'point_t' variable to store the result
+ * @param line_space line space of the text
+ */
+void _lv_txt_layout_get_size(const lv_txt_layout_t * layout, lv_point_t * size_res, lv_coord_t line_space);
+
+/**
+ * Get the line which contains a byte of the text
+ * @param layout pointer to a complete text layout with at least one line
+ * @param byte_id byte index in the text
+ * @return index of the line. The last line if `byte_id` is beyond the text.
+ */
+uint32_t _lv_txt_layout_get_line(const lv_txt_layout_t * layout, uint32_t byte_id);
+
+/**
+ * Get where a line of a text layout ends
+ * @param layout pointer to a complete text layout
+ * @param line_id index of a line
+ * @return the byte index where the next line starts or the end of the text
+ */
+static inline uint32_t _lv_txt_layout_get_line_end(const lv_txt_layout_t * layout, uint32_t line_id)
+{
+    return line_id + 1 < layout->line_cnt ? layout->lines[line_id + 1].start : layout->end;
+}
+
 /**
  * Check next character in a string and decide if the character is part of the command or not
  * @param state pointer to a txt_cmd_state_t variable which stores the current state of command
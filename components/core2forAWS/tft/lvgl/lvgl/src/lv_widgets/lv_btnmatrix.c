@@ -663,6 +663,9 @@ static lv_design_res_t lv_btnmatrix_design(lv_obj_t * btnm, const lv_area_t * cl
         lv_draw_rect_dsc_t draw_rect_tmp_dsc;
         lv_draw_label_dsc_t draw_label_tmp_dsc;
 
+        /*The state is temporarily changed to get the styles of the buttons
+         *so the bands rendered in parallel get them one by one*/
+        _lv_refr_lock();
         lv_state_t state_ori = btnm->state;
         _lv_obj_disable_style_caching(btnm, true);
         btnm->state = LV_STATE_DEFAULT;
@@ -673,6 +676,7 @@ static lv_design_res_t lv_btnmatrix_design(lv_obj_t * btnm, const lv_area_t * cl
         draw_label_rel_dsc.flag = txt_flag;
         btnm->state = state_ori;
         _lv_obj_disable_style_caching(btnm, false);
+        _lv_refr_unlock();
 
         bool chk_inited = false;
         bool disabled_inited = false;
@@ -720,6 +724,7 @@ static lv_design_res_t lv_btnmatrix_design(lv_obj_t * btnm, const lv_area_t * cl
             }
             else if(btn_state == LV_STATE_CHECKED) {
                 if(!chk_inited) {
+                    _lv_refr_lock();
                     btnm->state = LV_STATE_CHECKED;
                     _lv_obj_disable_style_caching(btnm, true);
                     lv_draw_rect_dsc_init(&draw_rect_chk_dsc);
@@ -729,6 +734,7 @@ static lv_design_res_t lv_btnmatrix_design(lv_obj_t * btnm, const lv_area_t * cl
                     draw_label_chk_dsc.flag = txt_flag;
                     btnm->state = state_ori;
                     _lv_obj_disable_style_caching(btnm, false);
+                    _lv_refr_unlock();
                     chk_inited = true;
                 }
                 draw_rect_dsc_act = &draw_rect_chk_dsc;
@@ -736,6 +742,7 @@ static lv_design_res_t lv_btnmatrix_design(lv_obj_t * btnm, const lv_area_t * cl
             }
             else if(btn_state == LV_STATE_DISABLED) {
                 if(!disabled_inited) {
+                    _lv_refr_lock();
                     btnm->state = LV_STATE_DISABLED;
                     _lv_obj_disable_style_caching(btnm, true);
                     lv_draw_rect_dsc_init(&draw_rect_ina_dsc);
@@ -745,6 +752,7 @@ static lv_design_res_t lv_btnmatrix_design(lv_obj_t * btnm, const lv_area_t * cl
                     draw_label_ina_dsc.flag = txt_flag;
                     btnm->state = state_ori;
                     _lv_obj_disable_style_caching(btnm, false);
+                    _lv_refr_unlock();
                     disabled_inited = true;
                 }
                 draw_rect_dsc_act = &draw_rect_ina_dsc;
@@ -752,6 +760,7 @@ static lv_design_res_t lv_btnmatrix_design(lv_obj_t * btnm, const lv_area_t * cl
             }
             /*In other cases get the styles directly without caching them*/
             else {
+                _lv_refr_lock();
                 btnm->state = btn_state;
                 _lv_obj_disable_style_caching(btnm, true);
                 lv_draw_rect_dsc_init(&draw_rect_tmp_dsc);
@@ -763,6 +772,7 @@ static lv_design_res_t lv_btnmatrix_design(lv_obj_t * btnm, const lv_area_t * cl
                 draw_label_dsc_act = &draw_label_tmp_dsc;
                 btnm->state = state_ori;
                 _lv_obj_disable_style_caching(btnm, false);
+                _lv_refr_unlock();
             }
 
             lv_style_int_t border_part_ori = draw_rect_dsc_act->border_side;
@@ -11,6 +11,7 @@
 
 #include "../lv_misc/lv_debug.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_hal/lv_hal_indev.h"
 #include "../lv_misc/lv_utils.h"
 #include "../lv_core/lv_indev.h"
@@ -416,9 +417,13 @@ static lv_design_res_t lv_calendar_design(lv_obj_t * calendar, const lv_area_t *
     else if(mode == LV_DESIGN_DRAW_MAIN) {
         ancestor_design(calendar, clip_area, mode);
 
+        /*The state of the calendar is temporarily changed while drawing the parts
+         *so the bands rendered in parallel draw them one by one*/
+        _lv_refr_lock();
         draw_header(calendar, clip_area);
         draw_day_names(calendar, clip_area);
         draw_dates(calendar, clip_area);
+        _lv_refr_unlock();
 
     }
     /*Post draw when the children are drawn*/
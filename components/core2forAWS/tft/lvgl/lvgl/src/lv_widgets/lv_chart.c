@@ -12,6 +12,7 @@
 #include "../lv_misc/lv_debug.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_draw/lv_draw_blend.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_themes/lv_theme.h"
 
@@ -29,6 +30,12 @@
 #define LV_CHART_AXIS_MINOR_TICK_LEN_COE 2 / 3
 #define LV_CHART_LABEL_ITERATOR_FORWARD 1
 #define LV_CHART_LABEL_ITERATOR_REVERSE 0
+#define LV_CHART_BUCKET_SIZE_MIN    16      /*The buckets take at most 3/16 of the memory of the points*/
+
+/*Parts of the series background for `draw_series_bg`*/
+#define LV_CHART_SERIES_BG_SCROLL   0x01    /*Background color and solid horizontal lines, they can scroll with the data*/
+#define LV_CHART_SERIES_BG_FIXED    0x02    /*Border, shadow, pattern, value, vertical and dashed horizontal lines*/
+#define LV_CHART_SERIES_BG_ALL      (LV_CHART_SERIES_BG_SCROLL | LV_CHART_SERIES_BG_FIXED)
 
 /**********************
  *      TYPEDEFS
@@ -41,6 +48,16 @@ typedef struct {
     uint8_t is_reverse_iter;
 } lv_chart_label_iterator_t;
 
+#if LV_CHART_DECIMATE
+/*Min. and max. of some points with their indices from the left*/
+typedef struct {
+    lv_coord_t min;
+    lv_coord_t max;
+    uint16_t min_id;
+    uint16_t max_id;
+} lv_chart_range_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -48,13 +65,29 @@ static lv_design_res_t lv_chart_design(lv_obj_t * chart, const lv_area_t * clip_
 static lv_res_t lv_chart_signal(lv_obj_t * chart, lv_signal_t sign, void * param);
 static lv_style_list_t * lv_chart_get_style(lv_obj_t * chart, uint8_t part);
 
-static void draw_series_bg(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * mask);
+static void draw_series_bg(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * mask, uint8_t parts);
 static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area);
 static void draw_series_column(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area);
 static void draw_cursors(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area);
 static void draw_axes(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * mask);
+static void draw_series_scroll(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area);
+static bool scroll_buf_prepare(lv_obj_t * chart, const lv_area_t * series_area);
+static void scroll_buf_capture(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * area);
+static void scroll_buf_invalidate(lv_obj_t * chart);
+static void scroll_buf_free(lv_obj_t * chart);
+static lv_coord_t get_scroll_pitch(lv_obj_t * chart, lv_coord_t w);
+static lv_coord_t get_point_x(lv_obj_t * chart, lv_coord_t w, lv_coord_t pitch, uint16_t i);
 static void invalidate_lines(lv_obj_t * chart, uint16_t i);
 static void invalidate_columns(lv_obj_t * chart, uint16_t i);
+#if LV_CHART_DECIMATE
+    static uint32_t decim_get_ids(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t w, uint16_t * ids);
+    static void bucket_calc(const lv_coord_t * points, uint16_t first, uint16_t cnt, lv_chart_bucket_t * bucket);
+    static void range_calc(const lv_chart_series_t * ser, uint16_t point_cnt, uint16_t start, uint16_t i_first,
+                           uint16_t i_end, lv_chart_range_t * range);
+    static void buckets_invalidate(lv_chart_series_t * ser, uint16_t id);
+    static void buckets_invalidate_all(lv_chart_series_t * ser);
+    static void buckets_free(lv_chart_series_t * ser);
+#endif
 static void get_next_axis_label(lv_chart_label_iterator_t * iterator, char * buf);
 static inline bool is_tick_with_label(uint8_t tick_num, lv_chart_axis_cfg_t * axis);
 static lv_chart_label_iterator_t create_axis_label_iter(const char * list, uint8_t iterator_dir);
@@ -111,6 +144,13 @@ lv_obj_t * lv_chart_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->point_cnt             = LV_CHART_PNUM_DEF;
     ext->type                  = LV_CHART_TYPE_LINE;
     ext->update_mode           = LV_CHART_UPDATE_MODE_SHIFT;
+    ext->scroll_buf            = NULL;
+    ext->scroll_dirty          = NULL;
+    ext->scroll_w              = 0;
+    ext->scroll_h              = 0;
+    ext->scroll_ofs            = 0;
+    ext->scroll_start          = 0;
+    ext->scroll_pending        = 0;
     _lv_memset_00(&ext->x_axis, sizeof(ext->x_axis));
     _lv_memset_00(&ext->y_axis, sizeof(ext->y_axis));
     _lv_memset_00(&ext->secondary_y_axis, sizeof(ext->secondary_y_axis));
@@ -197,6 +237,11 @@ lv_chart_series_t * lv_chart_add_series(lv_obj_t * chart, lv_color_t color)
     ser->ext_buf_assigned = false;
     ser->hidden = 0;
     ser->y_axis = LV_CHART_AXIS_PRIMARY_Y;
+#if LV_CHART_DECIMATE
+    ser->buckets = NULL;
+    ser->bucket_size = 0;
+    ser->bucket_cnt = 0;
+#endif
 
     uint16_t i;
     lv_coord_t * p_tmp = ser->points;
@@ -205,6 +250,8 @@ lv_chart_series_t * lv_chart_add_series(lv_obj_t * chart, lv_color_t color)
         p_tmp++;
     }
 
+    scroll_buf_invalidate(chart);
+
     return ser;
 }
 
@@ -221,10 +268,15 @@ void lv_chart_remove_series(lv_obj_t * chart, lv_chart_series_t * series)
     if(chart == NULL || series == NULL) return;
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
     if(!series->ext_buf_assigned && series->points) lv_mem_free(series->points);
+#if LV_CHART_DECIMATE
+    buckets_free(series);
+#endif
 
     _lv_ll_remove(&ext->series_ll, series);
     lv_mem_free(series);
 
+    scroll_buf_invalidate(chart);
+
     return;
 }
 
@@ -272,6 +324,9 @@ void lv_chart_clear_series(lv_obj_t * chart, lv_chart_series_t * series)
     }
 
     series->start_point = 0;
+#if LV_CHART_DECIMATE
+    buckets_invalidate_all(series);
+#endif
 }
 
 /**
@@ -309,7 +364,7 @@ void lv_chart_set_div_line_count(lv_obj_t * chart, uint8_t hdiv, uint8_t vdiv)
     ext->hdiv_cnt = hdiv;
     ext->vdiv_cnt = vdiv;
 
-    lv_obj_invalidate(chart);
+    lv_chart_refresh(chart);
 }
 
 /**
@@ -469,11 +524,16 @@ void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y)
     LV_ASSERT_NULL(ser);
 
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+#if LV_CHART_DECIMATE
+    buckets_invalidate(ser, ser->start_point);
+#endif
+
     if(ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT) {
         ser->points[ser->start_point] =
             y; /*This was the place of the former left most value, after shifting it is the rightmost*/
         ser->start_point = (ser->start_point + 1) % ext->point_cnt;
-        lv_chart_refresh(chart);
+        /*Not `lv_chart_refresh` which would recalculate the other buckets too*/
+        lv_obj_invalidate(chart);
     }
     else if(ext->update_mode == LV_CHART_UPDATE_MODE_CIRCULAR) {
         ser->points[ser->start_point] = y;
@@ -483,6 +543,16 @@ void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y)
 
         ser->start_point = (ser->start_point + 1) % ext->point_cnt; /*update the x for next incoming y*/
     }
+    else if(ext->update_mode == LV_CHART_UPDATE_MODE_SCROLL) {
+        ser->points[ser->start_point] = y;
+        ser->start_point = (ser->start_point + 1) % ext->point_cnt;
+        if(ext->scroll_pending < ext->point_cnt) ext->scroll_pending++;
+
+        /*Only the series area scrolls, the rest of the chart is unchanged*/
+        lv_area_t series_area;
+        lv_chart_get_series_area(chart, &series_area);
+        lv_obj_invalidate_area(chart, &series_area);
+    }
 }
 
 /**
@@ -498,6 +568,7 @@ void lv_chart_set_update_mode(lv_obj_t * chart, lv_chart_update_mode_t update_mo
     if(ext->update_mode == update_mode) return;
 
     ext->update_mode = update_mode;
+    if(update_mode != LV_CHART_UPDATE_MODE_SCROLL) scroll_buf_free(chart);
     lv_obj_invalidate(chart);
 }
 
@@ -649,6 +720,9 @@ void lv_chart_set_ext_array(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_
     ser->ext_buf_assigned = true;
     ser->points = array;
     ext->point_cnt = point_cnt;
+#if LV_CHART_DECIMATE
+    buckets_invalidate_all(ser);
+#endif
 }
 
 /**
@@ -668,6 +742,9 @@ void lv_chart_set_point_id(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t
     if(ext == NULL) return;
     if(id >= ext->point_cnt) return;
     ser->points[id] = value;
+#if LV_CHART_DECIMATE
+    buckets_invalidate(ser, id);
+#endif
 }
 
 /**
@@ -814,7 +891,13 @@ uint16_t lv_chart_get_nearest_index_from_coord(lv_obj_t * chart, lv_coord_t x)
 
     if(x < 0) return 0;
     if(x > w) return ext->point_cnt - 1;
-    if(ext->type == LV_CHART_TYPE_LINE) return (x * (ext->point_cnt - 1) + w / 2) / w;
+    if(ext->type == LV_CHART_TYPE_LINE) {
+        lv_coord_t pitch = get_scroll_pitch(chart, w);
+        if(pitch == 0) return (x * (ext->point_cnt - 1) + w / 2) / w;
+
+        int32_t back = (w - x + pitch / 2) / pitch;
+        return back >= ext->point_cnt ? 0 : ext->point_cnt - 1 - back;
+    }
     if(ext->type == LV_CHART_TYPE_COLUMN) return (x * ext->point_cnt) / w;
 
     return 0;
@@ -847,7 +930,7 @@ lv_coord_t lv_chart_get_x_from_index(lv_obj_t * chart, lv_chart_series_t * ser,
     lv_coord_t x = 0;
 
     if(ext->type & LV_CHART_TYPE_LINE) {
-        x = (w * id) / (ext->point_cnt - 1);
+        x = get_point_x(chart, w, get_scroll_pitch(chart, w), id);
     }
     else if(ext->type & LV_CHART_TYPE_COLUMN) {
         lv_coord_t col_w = w / ((_lv_ll_get_len(&ext->series_ll) + 1) * ext->point_cnt); /* Suppose + 1 series as separator*/
@@ -925,6 +1008,16 @@ void lv_chart_refresh(lv_obj_t * chart)
 {
     LV_ASSERT_OBJ(chart, LV_OBJX_NAME);
 
+#if LV_CHART_DECIMATE
+    /*The points might have been changed directly in the series*/
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    lv_chart_series_t * ser;
+    _LV_LL_READ_BACK(ext->series_ll, ser) {
+        buckets_invalidate_all(ser);
+    }
+#endif
+
+    scroll_buf_invalidate(chart);
     lv_obj_invalidate(chart);
 }
 
@@ -957,12 +1050,32 @@ static lv_design_res_t lv_chart_design(lv_obj_t * chart, const lv_area_t * clip_
         lv_area_t series_area;
         lv_chart_get_series_area(chart, &series_area);
 
-        draw_series_bg(chart, &series_area, clip_area);
-        draw_axes(chart, &series_area, clip_area);
-
+        /*In scroll mode new points invalidate only the series area, so the series can't be drawn out of it*/
         lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
-        if(ext->type & LV_CHART_TYPE_LINE) draw_series_line(chart, &series_area, clip_area);
-        if(ext->type & LV_CHART_TYPE_COLUMN) draw_series_column(chart, &series_area, clip_area);
+        const lv_area_t * series_clip = clip_area;
+        lv_area_t series_clip_tmp;
+        if(ext->update_mode == LV_CHART_UPDATE_MODE_SCROLL &&
+           _lv_area_intersect(&series_clip_tmp, &series_area, clip_area)) {
+            series_clip = &series_clip_tmp;
+        }
+
+        /*The scroll buffer is shared by the bands rendered in parallel*/
+        _lv_refr_lock();
+        bool scroll = series_clip != clip_area && scroll_buf_prepare(chart, &series_area);
+        _lv_refr_unlock();
+
+        if(scroll) {
+            draw_series_scroll(chart, &series_area, series_clip);
+            draw_series_bg(chart, &series_area, clip_area, LV_CHART_SERIES_BG_FIXED);
+            draw_axes(chart, &series_area, clip_area);
+        }
+        else {
+            draw_series_bg(chart, &series_area, clip_area, LV_CHART_SERIES_BG_ALL);
+            draw_axes(chart, &series_area, clip_area);
+
+            if(ext->type & LV_CHART_TYPE_LINE) draw_series_line(chart, &series_area, series_clip);
+            if(ext->type & LV_CHART_TYPE_COLUMN) draw_series_column(chart, &series_area, series_clip);
+        }
         draw_cursors(chart, &series_area, clip_area);
 
     }
@@ -998,6 +1111,9 @@ static lv_res_t lv_chart_signal(lv_obj_t * chart, lv_signal_t sign, void * param
             ser = _lv_ll_get_head(&ext->series_ll);
 
             if(!ser->ext_buf_assigned) lv_mem_free(ser->points);
+#if LV_CHART_DECIMATE
+            buckets_free(ser);
+#endif
 
             _lv_ll_remove(&ext->series_ll, ser);
             lv_mem_free(ser);
@@ -1007,6 +1123,11 @@ static lv_res_t lv_chart_signal(lv_obj_t * chart, lv_signal_t sign, void * param
         lv_obj_clean_style_list(chart, LV_CHART_PART_SERIES);
         lv_obj_clean_style_list(chart, LV_CHART_PART_CURSOR);
         lv_obj_clean_style_list(chart, LV_CHART_PART_SERIES_BG);
+
+        scroll_buf_free(chart);
+    }
+    else if(sign == LV_SIGNAL_STYLE_CHG) {
+        scroll_buf_invalidate(chart);
     }
 
     return res;
@@ -1049,13 +1170,24 @@ static lv_style_list_t * lv_chart_get_style(lv_obj_t * chart, uint8_t part)
  * Draw the division lines on chart background
  * @param chart pointer to chart object
  * @param clip_area mask, inherited from the design function
+ * @param parts which parts to draw, OR-ed values of `LV_CHART_SERIES_BG_...`
  */
-static void draw_series_bg(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area)
+static void draw_series_bg(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area, uint8_t parts)
 {
     /*Draw the background of the series*/
     lv_draw_rect_dsc_t bg_dsc;
     lv_draw_rect_dsc_init(&bg_dsc);
     lv_obj_init_draw_rect_dsc(chart, LV_CHART_PART_SERIES_BG, &bg_dsc);
+    if((parts & LV_CHART_SERIES_BG_SCROLL) == 0) {
+        bg_dsc.bg_opa = LV_OPA_TRANSP;
+    }
+    if((parts & LV_CHART_SERIES_BG_FIXED) == 0) {
+        bg_dsc.border_opa = LV_OPA_TRANSP;
+        bg_dsc.outline_opa = LV_OPA_TRANSP;
+        bg_dsc.shadow_opa = LV_OPA_TRANSP;
+        bg_dsc.pattern_opa = LV_OPA_TRANSP;
+        bg_dsc.value_opa = LV_OPA_TRANSP;
+    }
     lv_draw_rect(series_area, clip_area, &bg_dsc);
 
     lv_chart_ext_t * ext     = lv_obj_get_ext_attr(chart);
@@ -1074,7 +1206,9 @@ static void draw_series_bg(lv_obj_t * chart, const lv_area_t * series_area, cons
     lv_draw_line_dsc_init(&line_dsc);
     lv_obj_init_draw_line_dsc(chart, LV_CHART_PART_SERIES_BG, &line_dsc);
 
-    if(ext->hdiv_cnt != 0) {
+    /*The dashes are aligned to the screen so dashed lines can't scroll*/
+    uint8_t hdiv_part = line_dsc.dash_gap && line_dsc.dash_width ? LV_CHART_SERIES_BG_FIXED : LV_CHART_SERIES_BG_SCROLL;
+    if(ext->hdiv_cnt != 0 && (parts & hdiv_part)) {
         /*Draw side lines if no border*/
         if(bg_dsc.border_width != 0) {
             div_i_start = 1;
@@ -1095,7 +1229,7 @@ static void draw_series_bg(lv_obj_t * chart, const lv_area_t * series_area, cons
         }
     }
 
-    if(ext->vdiv_cnt != 0) {
+    if(ext->vdiv_cnt != 0 && (parts & LV_CHART_SERIES_BG_FIXED)) {
         /*Draw side lines if no border*/
         if(bg_dsc.border_width != 0) {
             div_i_start = 1;
@@ -1172,6 +1306,38 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
     /*Do not bother with line ending is the point will over it*/
     if(point_radius > line_dsc.width / 2) line_dsc.raw_end = 1;
 
+    /*With a scroll pitch skip the points left to the clip area (usually only the newest are drawn)*/
+    lv_coord_t pitch = get_scroll_pitch(chart, w);
+    uint16_t i_start = 0;
+    if(pitch) {
+        int32_t back = (int32_t)(x_ofs + w - (clip_area->x1 - line_dsc.width - point_radius)) / pitch;
+        if(back < 0) i_start = ext->point_cnt - 1;
+        else if(back < ext->point_cnt - 2) i_start = ext->point_cnt - 2 - back;
+    }
+    uint32_t point_cnt = ext->point_cnt - i_start;
+
+#if LV_CHART_DECIMATE
+    /*With many points per pixel draw only the first, last, min. and max. points of the columns.
+     *The points wouldn't be visible anyway.*/
+    uint16_t * ids = NULL;
+    if(pitch == 0 && w > 0 && ext->point_cnt >= (uint32_t)LV_CHART_DECIMATE * w) {
+        ids = _lv_mem_buf_get(sizeof(uint16_t) * (4 * w + 4));
+        LV_ASSERT_MEM(ids);
+        if(ids == NULL) return;
+        point_cnt = 4 * w + 4;
+        point_radius = 0;
+    }
+#endif
+
+    lv_point_t * points = _lv_mem_buf_get(sizeof(lv_point_t) * point_cnt);
+    LV_ASSERT_MEM(points);
+    if(points == NULL) {
+#if LV_CHART_DECIMATE
+        if(ids) _lv_mem_buf_release(ids);
+#endif
+        return;
+    }
+
     /*Go through all data lines*/
     _LV_LL_READ_BACK(ext->series_ll, ser) {
         if(ser->hidden) continue;
@@ -1180,35 +1346,52 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
         area_dsc.bg_color = ser->color;
         area_dsc.bg_grad_color = ser->color;
 
-        lv_coord_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
-
-        p1.x = 0 + x_ofs;
-        p2.x = 0 + x_ofs;
+        lv_coord_t start_point = ext->update_mode != LV_CHART_UPDATE_MODE_CIRCULAR ? ser->start_point : 0;
+        int32_t y_range = ext->ymax[ser->y_axis] - ext->ymin[ser->y_axis];
 
-        lv_coord_t p_act = start_point;
-        lv_coord_t p_prev = start_point;
-        int32_t y_tmp = (int32_t)((int32_t)ser->points[p_prev] - ext->ymin[ser->y_axis]) * h;
-        y_tmp = y_tmp / (ext->ymax[ser->y_axis] - ext->ymin[ser->y_axis]);
-        p2.y   = h - y_tmp + y_ofs;
+#if LV_CHART_DECIMATE
+        if(ids) point_cnt = decim_get_ids(chart, ser, w, ids);
+#endif
 
-        for(i = 0; i < ext->point_cnt; i++) {
-            p1.x = p2.x;
-            p1.y = p2.y;
+        /*Not set points are marked with `LV_CHART_POINT_DEF` in `y`*/
+        uint32_t j;
+        for(j = 0; j < point_cnt; j++) {
+            i = i_start + j;
+#if LV_CHART_DECIMATE
+            if(ids) i = ids[j];
+#endif
+            lv_coord_t p_act = (start_point + i) % ext->point_cnt;
+            points[j].x = get_point_x(chart, w, pitch, i) + x_ofs;
+            if(ser->points[p_act] == LV_CHART_POINT_DEF) {
+                points[j].y = LV_CHART_POINT_DEF;
+            }
+            else {
+                int32_t y_tmp = (int32_t)((int32_t)ser->points[p_act] - ext->ymin[ser->y_axis]) * h;
+                points[j].y = h - y_tmp / y_range + y_ofs;
+            }
+        }
 
-            p2.x = ((w * i) / (ext->point_cnt - 1)) + x_ofs;
+        /*Draw the lines between the set points in one piece*/
+        uint32_t run_start = 0;
+        for(j = 0; j <= point_cnt; j++) {
+            if(j == point_cnt || points[j].y == LV_CHART_POINT_DEF) {
+                if(j - run_start >= 2) {
+                    lv_draw_polyline(&points[run_start], j - run_start, &series_mask, &line_dsc);
+                }
+                run_start = j + 1;
+            }
+        }
 
-            p_act = (start_point + i) % ext->point_cnt;
+        p2 = points[0];
 
-            y_tmp = (int32_t)((int32_t)ser->points[p_act] - ext->ymin[ser->y_axis]) * h;
-            y_tmp = y_tmp / (ext->ymax[ser->y_axis] - ext->ymin[ser->y_axis]);
-            p2.y  = h - y_tmp + y_ofs;
+        for(j = 0; j < point_cnt; j++) {
+            p1 = p2;
+            p2 = points[j];
 
             /*Don't draw the first point. A second point is also required to draw the line*/
-            if(i != 0 && ser->points[p_prev] != LV_CHART_POINT_DEF && ser->points[p_act] != LV_CHART_POINT_DEF) {
-                lv_draw_line(&p1, &p2, &series_mask, &line_dsc);
-
+            if(has_area && j != 0 && p1.y != LV_CHART_POINT_DEF && p2.y != LV_CHART_POINT_DEF) {
                 lv_coord_t y_top = LV_MATH_MIN(p1.y, p2.y);
-                if(has_area && y_top <= clip_area->y2) {
+                if(y_top <= clip_area->y2) {
                     int16_t mask_line_id;
                     lv_draw_mask_line_param_t mask_line_p;
                     lv_draw_mask_line_points_init(&mask_line_p, p1.x, p1.y, p2.x, p2.y, LV_DRAW_MASK_LINE_SIDE_BOTTOM);
@@ -1240,13 +1423,11 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
                 point_area.y2 = point_area.y1 + point_radius;
                 point_area.y1 -= point_radius;
 
-                if(ser->points[p_act] != LV_CHART_POINT_DEF) {
+                if(p2.y != LV_CHART_POINT_DEF) {
                     /*Don't limit to `series_mask` to get full circles on the ends*/
                     lv_draw_rect(&point_area, clip_area, &point_dsc);
                 }
             }
-
-            p_prev = p_act;
         }
 
         /*Draw the last point*/
@@ -1261,12 +1442,17 @@ static void draw_series_line(lv_obj_t * chart, const lv_area_t * series_area, co
             point_area.y2 = point_area.y1 + point_radius;
             point_area.y1 -= point_radius;
 
-            if(ser->points[p_act] != LV_CHART_POINT_DEF) {
+            if(p2.y != LV_CHART_POINT_DEF) {
                 /*Don't limit to `series_mask` to get full circles on the ends*/
                 lv_draw_rect(&point_area, clip_area, &point_dsc);
             }
         }
     }
+
+    _lv_mem_buf_release(points);
+#if LV_CHART_DECIMATE
+    if(ids) _lv_mem_buf_release(ids);
+#endif
 }
 
 /**
@@ -1312,7 +1498,7 @@ static void draw_series_column(lv_obj_t * chart, const lv_area_t * series_area,
         /*Draw the current point of all data line*/
         _LV_LL_READ_BACK(ext->series_ll, ser) {
             if(ser->hidden) continue;
-            lv_coord_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+            lv_coord_t start_point = ext->update_mode != LV_CHART_UPDATE_MODE_CIRCULAR ? ser->start_point : 0;
 
             col_a.x1 = x_act;
             col_a.x2 = col_a.x1 + col_w - col_space;
@@ -1856,4 +2042,460 @@ static void invalidate_columns(lv_obj_t * chart, uint16_t i)
     _lv_inv_area(lv_obj_get_disp(chart), &col_a);
 }
 
+
+/**
+ * Draw the series area of a chart in `LV_CHART_UPDATE_MODE_SCROLL`.
+ * The columns already drawn are copied from the scroll buffer and only the rest is drawn (and saved).
+ * @param chart pointer to chart object
+ * @param series_area the series area of the chart
+ * @param clip_area the part of the series area to draw
+ */
+static void draw_series_scroll(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * clip_area)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    lv_coord_t w = ext->scroll_w;
+    lv_coord_t row;
+    lv_coord_t row_first = clip_area->y1 - series_area->y1;
+    lv_coord_t row_last = clip_area->y2 - series_area->y1;
+
+    /*Draw the columns which are dirty in any row of the area*/
+    lv_coord_t dirty = w;
+    _lv_refr_lock();
+    for(row = row_first; row <= row_last; row++) {
+        dirty = LV_MATH_MIN(dirty, ext->scroll_dirty[row]);
+    }
+    lv_coord_t ofs = ext->scroll_ofs;
+    _lv_refr_unlock();
+
+    lv_area_t draw_area;
+    lv_area_copy(&draw_area, clip_area);
+    draw_area.x1 = LV_MATH_MAX(clip_area->x1, series_area->x1 + dirty);
+    if(draw_area.x1 <= draw_area.x2) {
+        draw_series_bg(chart, series_area, &draw_area, LV_CHART_SERIES_BG_SCROLL);
+        draw_series_line(chart, series_area, &draw_area);
+
+        _lv_refr_lock();
+        scroll_buf_capture(chart, series_area, &draw_area);
+
+        /*The rows are clean if all of their dirty columns were drawn*/
+        if(draw_area.x2 == series_area->x2) {
+            for(row = row_first; row <= row_last; row++) {
+                if(draw_area.x1 <= series_area->x1 + ext->scroll_dirty[row]) ext->scroll_dirty[row] = w;
+            }
+        }
+        _lv_refr_unlock();
+    }
+
+    lv_area_t copy_area;
+    lv_area_copy(&copy_area, clip_area);
+    copy_area.x2 = LV_MATH_MIN(clip_area->x2, series_area->x1 + dirty - 1);
+    if(copy_area.x1 > copy_area.x2) return;
+
+    /*The columns from `scroll_ofs` to the end of the buffer, then the ones from its beginning.
+     *Only this band writes these rows of the buffer so they can be read without the lock.*/
+    lv_area_t map_area;
+    lv_area_t map_clip;
+    map_area.x1 = series_area->x1 - ofs;
+    map_area.x2 = map_area.x1 + w - 1;
+    map_area.y1 = series_area->y1;
+    map_area.y2 = series_area->y2;
+    if(_lv_area_intersect(&map_clip, &copy_area, &map_area)) {
+        _lv_blend_map(&map_clip, &map_area, ext->scroll_buf, NULL, LV_DRAW_MASK_RES_FULL_COVER, LV_OPA_COVER,
+                      LV_BLEND_MODE_NORMAL);
+    }
+
+    map_area.x1 += w;
+    map_area.x2 += w;
+    if(_lv_area_intersect(&map_clip, &copy_area, &map_area)) {
+        _lv_blend_map(&map_clip, &map_area, ext->scroll_buf, NULL, LV_DRAW_MASK_RES_FULL_COVER, LV_OPA_COVER,
+                      LV_BLEND_MODE_NORMAL);
+    }
+}
+
+/**
+ * Make the scroll buffer ready to draw the chart: allocate it or scroll it with the points added since the last drawing.
+ * Call it with `_lv_refr_lock()` held.
+ * @param chart pointer to chart object
+ * @param series_area the series area of the chart
+ * @return true: the series area can be drawn with `draw_series_scroll`; false: draw it normally
+ */
+static bool scroll_buf_prepare(lv_obj_t * chart, const lv_area_t * series_area)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    lv_coord_t w = lv_area_get_width(series_area);
+    lv_coord_t h = lv_area_get_height(series_area);
+    lv_coord_t pitch = get_scroll_pitch(chart, w);
+
+    if(ext->type != LV_CHART_TYPE_LINE || pitch == 0 || h <= 0) return false;
+
+    /*The buffer is read back from the display buffer, so it has to be a plain array and
+     *nothing below the series should be visible*/
+    if(_lv_refr_get_disp_refreshing()->driver.set_px_cb) return false;
+    if(lv_obj_get_style_opa_scale(chart, LV_CHART_PART_BG) < LV_OPA_MAX) return false;
+    if(lv_obj_get_style_bg_opa(chart, LV_CHART_PART_BG) < LV_OPA_MAX &&
+       lv_obj_get_style_bg_opa(chart, LV_CHART_PART_SERIES_BG) < LV_OPA_MAX) return false;
+
+    /*All visible series have to scroll together*/
+    lv_chart_series_t * ser;
+    lv_chart_series_t * ser_first = NULL;
+    _LV_LL_READ_BACK(ext->series_ll, ser) {
+        if(ser->hidden) continue;
+        if(ser_first == NULL) ser_first = ser;
+        else if(ser->start_point != ser_first->start_point) return false;
+    }
+    uint16_t start = ser_first ? ser_first->start_point : ext->scroll_start;
+
+    if(ext->scroll_buf == NULL || ext->scroll_w != w || ext->scroll_h != h) {
+        scroll_buf_free(chart);
+
+        /*Keep `scroll_buf` aligned after `scroll_dirty`*/
+        uint32_t dirty_size = (((uint32_t)h + 1) & ~1U) * sizeof(lv_coord_t);
+        ext->scroll_dirty = lv_mem_alloc(dirty_size + (uint32_t)w * h * sizeof(lv_color_t));
+        if(ext->scroll_dirty == NULL) {
+            LV_LOG_WARN("scroll_buf_prepare: no memory for the scroll buffer, redraw the whole series");
+            return false;
+        }
+
+        ext->scroll_buf = (lv_color_t *)((uint8_t *)ext->scroll_dirty + dirty_size);
+        ext->scroll_w = w;
+        ext->scroll_h = h;
+        ext->scroll_ofs = 0;
+        scroll_buf_invalidate(chart);
+    }
+    else if(ext->scroll_pending >= ext->point_cnt) {
+        /*Can't tell how many points were added, start over*/
+        scroll_buf_invalidate(chart);
+    }
+    else {
+        uint16_t shift = (start + ext->point_cnt - ext->scroll_start) % ext->point_cnt;
+        if(shift) {
+            int32_t shift_px = (int32_t)shift * pitch;
+
+            /*Redraw the new segments and the old ones reaching into them with their width and points*/
+            int32_t keep_w = w - shift_px - lv_obj_get_style_line_width(chart, LV_CHART_PART_SERIES) -
+                             lv_obj_get_style_size(chart, LV_CHART_PART_SERIES);
+            if(keep_w < 0) keep_w = 0;
+
+            lv_coord_t row;
+            for(row = 0; row < h; row++) {
+                int32_t clean_w = ext->scroll_dirty[row] - shift_px;
+                if(clean_w < 0) clean_w = 0;
+                if(clean_w > keep_w) clean_w = keep_w;
+                ext->scroll_dirty[row] = (lv_coord_t)clean_w;
+            }
+
+            ext->scroll_ofs = (lv_coord_t)((ext->scroll_ofs + shift_px) % w);
+        }
+    }
+
+    ext->scroll_start = start;
+    ext->scroll_pending = 0;
+
+    return true;
+}
+
+/**
+ * Save a freshly drawn area of the display buffer into the scroll buffer.
+ * Call it with `_lv_refr_lock()` held.
+ * @param chart pointer to chart object
+ * @param series_area the series area of the chart
+ * @param area the drawn area, inside the series area
+ */
+static void scroll_buf_capture(lv_obj_t * chart, const lv_area_t * series_area, const lv_area_t * area)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    lv_disp_buf_t * vdb = lv_disp_get_buf(_lv_refr_get_disp_refreshing());
+    lv_coord_t vdb_w = lv_area_get_width(&vdb->area);
+    lv_coord_t w = ext->scroll_w;
+
+    /*Copy until the end of the buffer, and the rest to its beginning*/
+    lv_coord_t col = (area->x1 - series_area->x1 + ext->scroll_ofs) % w;
+    uint32_t len = lv_area_get_width(area);
+    uint32_t len1 = LV_MATH_MIN(len, (uint32_t)(w - col));
+
+    lv_color_t * src = (lv_color_t *)vdb->buf_act;
+    src += (int32_t)(area->y1 - vdb->area.y1) * vdb_w + (area->x1 - vdb->area.x1);
+    lv_color_t * dst = ext->scroll_buf + (int32_t)(area->y1 - series_area->y1) * w;
+
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        _lv_memcpy(dst + col, src, len1 * sizeof(lv_color_t));
+        if(len1 < len) _lv_memcpy(dst, src + len1, (len - len1) * sizeof(lv_color_t));
+        src += vdb_w;
+        dst += w;
+    }
+}
+
+/**
+ * Mark the whole scroll buffer to be redrawn
+ * @param chart pointer to chart object
+ */
+static void scroll_buf_invalidate(lv_obj_t * chart)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(ext->scroll_dirty == NULL) return;
+
+    _lv_memset_00(ext->scroll_dirty, ext->scroll_h * sizeof(lv_coord_t));
+}
+
+/**
+ * Free the scroll buffer
+ * @param chart pointer to chart object
+ */
+static void scroll_buf_free(lv_obj_t * chart)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(ext->scroll_dirty == NULL) return;
+
+    lv_mem_free(ext->scroll_dirty);
+    ext->scroll_dirty = NULL;
+    ext->scroll_buf = NULL;
+    ext->scroll_w = 0;
+    ext->scroll_h = 0;
+}
+
+/**
+ * Get the distance of the points in `LV_CHART_UPDATE_MODE_SCROLL`.
+ * It's an integer so the drawn lines can be moved with the points.
+ * @param chart pointer to chart object
+ * @param w width of the series area
+ * @return the distance of the points in pixels or 0 if they are spread on the whole width
+ */
+static lv_coord_t get_scroll_pitch(lv_obj_t * chart, lv_coord_t w)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(ext->update_mode != LV_CHART_UPDATE_MODE_SCROLL || ext->point_cnt < 2) return 0;
+
+    return w / (ext->point_cnt - 1);
+}
+
+/**
+ * Get the x coordinate of a point of a line series with respect to the series area
+ * @param chart pointer to chart object
+ * @param w width of the series area
+ * @param pitch distance of the points from `get_scroll_pitch`
+ * @param i index of the point from the left
+ * @return the x coordinate
+ */
+static lv_coord_t get_point_x(lv_obj_t * chart, lv_coord_t w, lv_coord_t pitch, uint16_t i)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(pitch) return w - (ext->point_cnt - 1 - i) * pitch;
+
+    return (w * i) / (ext->point_cnt - 1);
+}
+
+#if LV_CHART_DECIMATE
+/**
+ * Get the points of a line series to draw when there are many points per pixel column:
+ * the first, min., max. and last points of every column. They cover the same pixels as
+ * all points of the column so the spikes remain visible.
+ * @param chart pointer to chart object
+ * @param ser pointer to a series of the chart
+ * @param w width of the series area
+ * @param ids store the indices of the points from the left here. At least `4 * w + 4` elements.
+ * @return number of indices in `ids`
+ */
+static uint32_t decim_get_ids(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t w, uint16_t * ids)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    uint16_t point_cnt = ext->point_cnt;
+
+    /*The partial buckets on the edges of the columns are read point by point.
+     *With sqrt(points per column / 2) points in a bucket the least points and buckets are read
+     *but keep the buckets much smaller than the points.*/
+    uint16_t size = LV_CHART_BUCKET_SIZE_MIN;
+    while(2 * size * size < point_cnt / w) size++;
+    uint16_t bucket_cnt = (point_cnt + size - 1) / size;
+    uint16_t b;
+
+    /*The bands rendered in parallel update the buckets one by one*/
+    _lv_refr_lock();
+
+    if(ser->bucket_size != size || ser->bucket_cnt != bucket_cnt) {
+        buckets_free(ser);
+        ser->buckets = lv_mem_alloc(sizeof(lv_chart_bucket_t) * bucket_cnt);
+        if(ser->buckets == NULL) {
+            LV_LOG_WARN("decim_get_ids: no memory for the buckets, read all points in every drawing");
+        }
+        else {
+            ser->bucket_size = size;
+            ser->bucket_cnt = bucket_cnt;
+            buckets_invalidate_all(ser);
+        }
+    }
+
+    if(ser->buckets) {
+        for(b = 0; b < bucket_cnt; b++) {
+            if(ser->buckets[b].min_id != LV_CHART_BUCKET_DIRTY) continue;
+            uint16_t first = b * size;
+            bucket_calc(ser->points, first, LV_MATH_MIN(size, point_cnt - first), &ser->buckets[b]);
+        }
+    }
+
+    _lv_refr_unlock();
+
+    uint16_t start = ext->update_mode != LV_CHART_UPDATE_MODE_CIRCULAR ? ser->start_point : 0;
+    uint32_t cnt = 0;
+    uint16_t i_first = 0;
+    lv_coord_t x;
+    for(x = 0; x <= w && i_first < point_cnt; x++) {
+        /*The points in the column: until `get_point_x` is larger than `x`*/
+        uint16_t i_end = LV_MATH_MIN(((int32_t)(x + 1) * (point_cnt - 1) + w - 1) / w, point_cnt);
+        if(i_end <= i_first) continue;
+
+        lv_chart_range_t range;
+        range_calc(ser, point_cnt, start, i_first, i_end, &range);
+
+        uint16_t col_ids[4];
+        uint32_t col_id_cnt = 0;
+        col_ids[col_id_cnt++] = i_first;
+        if(range.min != LV_CHART_POINT_DEF) {
+            col_ids[col_id_cnt++] = LV_MATH_MIN(range.min_id, range.max_id);
+            col_ids[col_id_cnt++] = LV_MATH_MAX(range.min_id, range.max_id);
+        }
+        col_ids[col_id_cnt++] = i_end - 1;
+
+        uint32_t k;
+        for(k = 0; k < col_id_cnt; k++) {
+            if(cnt == 0 || col_ids[k] != ids[cnt - 1]) ids[cnt++] = col_ids[k];
+        }
+
+        i_first = i_end;
+    }
+
+    return cnt;
+}
+
+/**
+ * Find the min. and max. of the points in a range using the buckets inside the range
+ * @param ser pointer to a series
+ * @param point_cnt number of points of the series
+ * @param start index of the left most point in `ser->points`
+ * @param i_first index of the first point from the left
+ * @param i_end index after the last point from the left
+ * @param range store the result here
+ */
+static void range_calc(const lv_chart_series_t * ser, uint16_t point_cnt, uint16_t start, uint16_t i_first,
+                       uint16_t i_end, lv_chart_range_t * range)
+{
+    range->min = LV_CHART_POINT_DEF;
+    range->max = LV_CHART_POINT_DEF;
+    range->min_id = i_first;
+    range->max_id = i_first;
+
+    uint32_t p = (uint32_t)start + i_first;
+    if(p >= point_cnt) p -= point_cnt;
+
+    uint16_t i = i_first;
+    while(i < i_end) {
+        lv_coord_t min;
+        lv_coord_t max;
+        uint16_t min_id;
+        uint16_t max_id;
+        uint16_t len;
+        if(ser->buckets && p % ser->bucket_size == 0 &&
+           i + LV_MATH_MIN(ser->bucket_size, point_cnt - p) <= i_end) {
+            const lv_chart_bucket_t * bucket = &ser->buckets[p / ser->bucket_size];
+            len = LV_MATH_MIN(ser->bucket_size, point_cnt - p);
+            min = bucket->min;
+            max = bucket->max;
+            min_id = i + bucket->min_id;
+            max_id = i + bucket->max_id;
+        }
+        else {
+            len = 1;
+            min = ser->points[p];
+            max = min;
+            min_id = i;
+            max_id = i;
+        }
+
+        if(min != LV_CHART_POINT_DEF) {
+            if(range->min == LV_CHART_POINT_DEF || min < range->min) {
+                range->min = min;
+                range->min_id = min_id;
+            }
+            if(max > range->max) {
+                range->max = max;
+                range->max_id = max_id;
+            }
+        }
+
+        i += len;
+        p += len;
+        if(p >= point_cnt) p = 0;
+    }
+}
+
+/**
+ * Find the min. and max. of some consecutive points
+ * @param points pointer to the points of a series
+ * @param first index of the first point
+ * @param cnt number of points
+ * @param bucket store the result here
+ */
+static void bucket_calc(const lv_coord_t * points, uint16_t first, uint16_t cnt, lv_chart_bucket_t * bucket)
+{
+    bucket->min = LV_CHART_POINT_DEF;
+    bucket->max = LV_CHART_POINT_DEF;
+    bucket->min_id = 0;
+    bucket->max_id = 0;
+
+    uint16_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_coord_t y = points[first + i];
+        if(y == LV_CHART_POINT_DEF) continue;
+
+        if(bucket->min == LV_CHART_POINT_DEF || y < bucket->min) {
+            bucket->min = y;
+            bucket->min_id = i;
+        }
+        if(y > bucket->max) {
+            bucket->max = y;
+            bucket->max_id = i;
+        }
+    }
+}
+
+/**
+ * Mark the bucket of a changed point to be recalculated
+ * @param ser pointer to a series
+ * @param id index of the point in `ser->points`
+ */
+static void buckets_invalidate(lv_chart_series_t * ser, uint16_t id)
+{
+    if(ser->buckets == NULL) return;
+
+    uint16_t b = id / ser->bucket_size;
+    if(b < ser->bucket_cnt) ser->buckets[b].min_id = LV_CHART_BUCKET_DIRTY;
+}
+
+/**
+ * Mark all buckets of a series to be recalculated
+ * @param ser pointer to a series
+ */
+static void buckets_invalidate_all(lv_chart_series_t * ser)
+{
+    if(ser->buckets == NULL) return;
+
+    uint16_t b;
+    for(b = 0; b < ser->bucket_cnt; b++) {
+        ser->buckets[b].min_id = LV_CHART_BUCKET_DIRTY;
+    }
+}
+
+/**
+ * Free the buckets of a series
+ * @param ser pointer to a series
+ */
+static void buckets_free(lv_chart_series_t * ser)
+{
+    lv_mem_free(ser->buckets);
+    ser->buckets = NULL;
+    ser->bucket_size = 0;
+    ser->bucket_cnt = 0;
+}
+#endif
+
 #endif
@@ -30,6 +30,9 @@ extern "C" {
 /**Automatically calculate the tick length*/
 #define LV_CHART_TICK_LENGTH_AUTO 255
 
+/**`min_id` of a bucket whose points have changed*/
+#define LV_CHART_BUCKET_DIRTY   0xFF
+
 LV_EXPORT_CONST_INT(LV_CHART_POINT_DEF);
 LV_EXPORT_CONST_INT(LV_CHART_TICK_LENGTH_AUTO);
 
@@ -49,6 +52,8 @@ typedef uint8_t lv_chart_type_t;
 enum {
     LV_CHART_UPDATE_MODE_SHIFT,     /**< Shift old data to the left and add the new one o the right*/
     LV_CHART_UPDATE_MODE_CIRCULAR,  /**< Add the new data in a circular way*/
+    LV_CHART_UPDATE_MODE_SCROLL,    /**< Like `SHIFT` but scroll the already drawn lines and draw only the new points.
+                                         The points are placed with an integer pitch aligned to the right.*/
 };
 typedef uint8_t lv_chart_update_mode_t;
 
@@ -68,6 +73,14 @@ enum {
 };
 typedef uint8_t lv_cursor_direction_t;
 
+/** Min. and max. of `bucket_size` consecutive points of a series, see `LV_CHART_DECIMATE`*/
+typedef struct {
+    lv_coord_t min;     /*`LV_CHART_POINT_DEF` if none of the points are set*/
+    lv_coord_t max;
+    uint8_t min_id;     /*Index of the min. and max. in the bucket. `LV_CHART_BUCKET_DIRTY`: recalculate*/
+    uint8_t max_id;
+} lv_chart_bucket_t;
+
 typedef struct {
     lv_coord_t * points;
     lv_color_t color;
@@ -75,6 +88,11 @@ typedef struct {
     uint8_t ext_buf_assigned : 1;
     uint8_t hidden : 1;
     lv_chart_axis_t y_axis  : 1;
+#if LV_CHART_DECIMATE
+    lv_chart_bucket_t * buckets;    /*`points` in groups of `bucket_size`, allocated when drawn decimated*/
+    uint16_t bucket_size;
+    uint16_t bucket_cnt;
+#endif
 } lv_chart_series_t;
 
 typedef struct {
@@ -117,7 +135,14 @@ typedef struct {
     lv_chart_axis_cfg_t y_axis;
     lv_chart_axis_cfg_t x_axis;
     lv_chart_axis_cfg_t secondary_y_axis;
-    uint8_t update_mode : 1;
+    uint8_t update_mode : 2;
+    lv_color_t * scroll_buf;    /*Drawn series area in `LV_CHART_UPDATE_MODE_SCROLL`, a ring buffer in x direction*/
+    lv_coord_t * scroll_dirty;  /*Per row of `scroll_buf`: the columns from here have to be redrawn*/
+    lv_coord_t scroll_w;
+    lv_coord_t scroll_h;
+    lv_coord_t scroll_ofs;      /*Column of `scroll_buf` showing the left edge of the series area*/
+    uint16_t scroll_start;      /*`start_point` of the series when `scroll_buf` was last drawn*/
+    uint16_t scroll_pending;    /*`lv_chart_set_next` calls since `scroll_buf` was last drawn*/
 } lv_chart_ext_t;
 
 /*Parts of the chart*/
@@ -245,6 +270,10 @@ void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y);
 
 /**
  * Set update mode of the chart object.
+ * `LV_CHART_UPDATE_MODE_SCROLL` allocates a buffer for the pixels of the series area.
+ * If it can't be allocated or the chart isn't an opaque line chart, it is redrawn as in `LV_CHART_UPDATE_MODE_SHIFT`.
+ * The lines and points are clipped to the series area and a few pixels of the segment which scrolled out
+ * might remain at its left edge until the next full redraw.
  * @param chart pointer to a chart object
  * @param update mode
  */
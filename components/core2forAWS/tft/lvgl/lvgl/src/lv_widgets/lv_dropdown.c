@@ -11,6 +11,7 @@
 
 #include "../lv_misc/lv_debug.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_core/lv_group.h"
 #include "../lv_core/lv_indev.h"
 #include "../lv_core/lv_disp.h"
@@ -1154,6 +1155,9 @@ static void draw_box(lv_obj_t * ddlist, const lv_area_t * clip_area, uint16_t id
 {
     lv_dropdown_ext_t * ext = lv_obj_get_ext_attr(ddlist);
     lv_obj_t * page = ext->page;
+
+    /*The state of the page is temporarily changed so the bands rendered in parallel draw the box one by one*/
+    _lv_refr_lock();
     lv_state_t state_orig = page->state;
 
     if(state != page->state) {
@@ -1184,12 +1188,15 @@ static void draw_box(lv_obj_t * ddlist, const lv_area_t * clip_area, uint16_t id
 
     page->state = state_orig;
     _lv_obj_disable_style_caching(ddlist, false);
+    _lv_refr_unlock();
 }
 
 static void draw_box_label(lv_obj_t * ddlist, const lv_area_t * clip_area, uint16_t id, lv_state_t state)
 {
     lv_dropdown_ext_t * ext = lv_obj_get_ext_attr(ddlist);
     lv_obj_t * page = ext->page;
+
+    _lv_refr_lock();
     lv_state_t state_orig = page->state;
 
     if(state != page->state) {
@@ -1205,7 +1212,10 @@ static void draw_box_label(lv_obj_t * ddlist, const lv_area_t * clip_area, uint1
                                                             LV_DROPDOWN_PART_LIST);  /*Line space should come from the page*/
 
     lv_obj_t * label = get_label(ddlist);
-    if(label == NULL) return;
+    if(label == NULL) {
+        _lv_refr_unlock();
+        return;
+    }
 
     lv_label_align_t align = lv_label_get_align(label);
 
@@ -1230,6 +1240,7 @@ static void draw_box_label(lv_obj_t * ddlist, const lv_area_t * clip_area, uint1
     }
     page->state = state_orig;
     _lv_obj_disable_style_caching(ddlist, false);
+    _lv_refr_unlock();
 }
 
 /**
@@ -11,6 +11,7 @@
 
 #include "../lv_misc/lv_debug.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_themes/lv_theme.h"
 #include "../lv_misc/lv_txt.h"
 #include "../lv_misc/lv_math.h"
@@ -442,6 +443,9 @@ static lv_design_res_t lv_gauge_design(lv_obj_t * gauge, const lv_area_t * clip_
     }
     /*Draw the object*/
     else if(mode == LV_DESIGN_DRAW_MAIN) {
+        /*The line count is temporarily changed while the scale is drawn
+         *so the bands rendered in parallel draw the gauge one by one*/
+        _lv_refr_lock();
         ancestor_design(gauge, clip_area, mode);
 
         lv_gauge_ext_t * ext           = lv_obj_get_ext_attr(gauge);
@@ -454,6 +458,7 @@ static lv_design_res_t lv_gauge_design(lv_obj_t * gauge, const lv_area_t * clip_
         ext->lmeter.line_cnt = line_cnt_tmp; /*Restore the parameters*/
 
         lv_gauge_draw_needle(gauge, clip_area);
+        _lv_refr_unlock();
     }
     /*Post draw when the children are drawn*/
     else if(mode == LV_DESIGN_DRAW_POST) {
@@ -12,6 +12,7 @@
 #include "../lv_misc/lv_debug.h"
 #include "../lv_core/lv_group.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_color.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_bidi.h"
@@ -53,6 +54,13 @@ static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
 static char * lv_label_get_dot_tmp(lv_obj_t * label);
 static void lv_label_dot_tmp_free(lv_obj_t * label);
 static void get_txt_coords(const lv_obj_t * label, lv_area_t * area);
+static void refr_text(lv_obj_t * label);
+static const lv_txt_layout_t * get_layout(const lv_obj_t * label, const lv_font_t * font, lv_coord_t letter_space,
+                                          lv_coord_t max_w, lv_txt_flag_t flag);
+static void layout_invalidate(lv_obj_t * label, const char * txt, uint32_t byte_id);
+static uint32_t get_common_prefix(const char * txt1, const char * txt2);
+static uint32_t find_line_by_y(const lv_txt_layout_t * layout, lv_coord_t y, lv_coord_t letter_height,
+                               lv_coord_t line_space);
 
 /**********************
  *  STATIC VARIABLES
@@ -119,6 +127,10 @@ lv_obj_t * lv_label_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->dot.tmp_ptr   = NULL;
     ext->dot_tmp_alloc = 0;
 
+#if LV_LABEL_LAYOUT_CACHE
+    _lv_txt_layout_init(&ext->layout);
+#endif
+
     lv_obj_set_design_cb(new_label, lv_label_design);
     lv_obj_set_signal_cb(new_label, lv_label_signal);
 
@@ -191,6 +203,7 @@ void lv_label_set_text(lv_obj_t * label, const char * text)
 
     if(ext->text == text && ext->static_txt == 0) {
         /*If set its own text then reallocate it (maybe its size changed)*/
+        layout_invalidate(label, ext->text, 0);
 #if LV_USE_ARABIC_PERSIAN_CHARS
         /*Get the size of the text and process it*/
         size_t len = _lv_txt_ap_calc_bytes_cnt(text);
@@ -208,6 +221,14 @@ void lv_label_set_text(lv_obj_t * label, const char * text)
         if(ext->text == NULL) return;
     }
     else {
+        /*Keep the lines before the first different character*/
+#if LV_USE_ARABIC_PERSIAN_CHARS
+        layout_invalidate(label, text, 0);
+#else
+        if(ext->text != NULL && ext->text != text) layout_invalidate(label, text, get_common_prefix(ext->text, text));
+        else layout_invalidate(label, text, 0);
+#endif
+
         /*Free the old text*/
         if(ext->text != NULL && ext->static_txt == 0) {
             lv_mem_free(ext->text);
@@ -238,7 +259,7 @@ void lv_label_set_text(lv_obj_t * label, const char * text)
         ext->static_txt = 0;
     }
 
-    lv_label_refr_text(label);
+    refr_text(label);
 }
 
 /**
@@ -261,18 +282,23 @@ void lv_label_set_text_fmt(lv_obj_t * label, const char * fmt, ...)
         return;
     }
 
+    va_list args;
+    va_start(args, fmt);
+    char * text = _lv_txt_set_text_vfmt(fmt, args);
+    va_end(args);
+
+    /*Keep the lines before the first different character*/
+    if(ext->text != NULL && text != NULL) layout_invalidate(label, text, get_common_prefix(ext->text, text));
+    else layout_invalidate(label, ext->text, 0);
+
     if(ext->text != NULL && ext->static_txt == 0) {
         lv_mem_free(ext->text);
-        ext->text = NULL;
     }
 
-    va_list args;
-    va_start(args, fmt);
-    ext->text = _lv_txt_set_text_vfmt(fmt, args);
-    va_end(args);
+    ext->text = text;
     ext->static_txt = 0; /*Now the text is dynamically allocated*/
 
-    lv_label_refr_text(label);
+    refr_text(label);
 }
 
 /**
@@ -333,7 +359,7 @@ void lv_label_set_long_mode(lv_obj_t * label, lv_label_long_mode_t long_mode)
     }
 
     ext->long_mode = long_mode;
-    lv_label_refr_text(label);
+    refr_text(label);
 }
 
 /**
@@ -368,8 +394,8 @@ void lv_label_set_recolor(lv_obj_t * label, bool en)
 
     ext->recolor = en == false ? 0 : 1;
 
-    lv_label_refr_text(label); /*Refresh the text because the potential color codes in text needs to
-                                  be hidden or revealed*/
+    refr_text(label); /*Refresh the text because the potential color codes in text needs to
+                         be hidden or revealed*/
 }
 
 /**
@@ -388,7 +414,7 @@ void lv_label_set_anim_speed(lv_obj_t * label, uint16_t anim_speed)
     ext->anim_speed = anim_speed;
 
     if(ext->long_mode == LV_LABEL_LONG_SROLL || ext->long_mode == LV_LABEL_LONG_SROLL_CIRC) {
-        lv_label_refr_text(label);
+        refr_text(label);
     }
 #else
     (void)label;      /*Unused*/
@@ -567,15 +593,25 @@ void lv_label_get_letter_pos(const lv_obj_t * label, uint32_t char_id, lv_point_
     if(align == LV_LABEL_ALIGN_RIGHT) flag |= LV_TXT_FLAG_RIGHT;
 
     uint32_t byte_id = _lv_txt_encoded_get_byte_id(txt, char_id);
+    uint32_t line_id = 0;
+
+    const lv_txt_layout_t * layout = get_layout(label, font, letter_space, max_w, flag);
+    if(layout) {
+        line_id = _lv_txt_layout_get_line(layout, byte_id);
+        line_start = layout->lines[line_id].start;
+        new_line_start = _lv_txt_layout_get_line_end(layout, line_id);
+        y = line_id * (letter_height + line_space);
+    }
+    else {
+        /*Search the line of the index letter */;
+        while(txt[new_line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+            if(byte_id < new_line_start || txt[new_line_start] == '\0')
+                break; /*The line of 'index' letter begins at 'line_start'*/
 
-    /*Search the line of the index letter */;
-    while(txt[new_line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
-        if(byte_id < new_line_start || txt[new_line_start] == '\0')
-            break; /*The line of 'index' letter begins at 'line_start'*/
-
-        y += letter_height + line_space;
-        line_start = new_line_start;
+            y += letter_height + line_space;
+            line_start = new_line_start;
+        }
     }
 
     /*If the last character is line break then go to the next line*/
@@ -615,17 +651,14 @@ void lv_label_get_letter_pos(const lv_obj_t * label, uint32_t char_id, lv_point_
     lv_coord_t x = _lv_txt_get_width(bidi_txt, visual_byte_pos, font, letter_space, flag);
     if(char_id != line_start) x += letter_space;
 
-    if(align == LV_LABEL_ALIGN_CENTER) {
+    if(align == LV_LABEL_ALIGN_CENTER || align == LV_LABEL_ALIGN_RIGHT) {
         lv_coord_t line_w;
-        line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
-        x += lv_area_get_width(&txt_coords) / 2 - line_w / 2;
+        /*The cached width is not valid if moved to the empty line after a trailing line break*/
+        if(layout && line_start == layout->lines[line_id].start) line_w = layout->lines[line_id].w;
+        else line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
 
-    }
-    else if(align == LV_LABEL_ALIGN_RIGHT) {
-        lv_coord_t line_w;
-        line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
-
-        x += lv_area_get_width(&txt_coords) - line_w;
+        if(align == LV_LABEL_ALIGN_CENTER) x += lv_area_get_width(&txt_coords) / 2 - line_w / 2;
+        else x += lv_area_get_width(&txt_coords) - line_w;
     }
     pos->x = x;
     pos->y = y;
@@ -675,22 +708,41 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * label, lv_point_t * pos_in)
     if(align == LV_LABEL_ALIGN_CENTER) flag |= LV_TXT_FLAG_CENTER;
     if(align == LV_LABEL_ALIGN_RIGHT) flag |= LV_TXT_FLAG_RIGHT;
 
-    /*Search the line of the index letter */;
-    while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
-
-        if(pos.y <= y + letter_height) {
-            /*The line is found (stored in 'line_start')*/
-            /* Include the NULL terminator in the last line */
-            uint32_t tmp = new_line_start;
-            uint32_t letter;
-            letter = _lv_txt_encoded_prev(txt, &tmp);
-            if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
-            break;
-        }
-        y += letter_height + line_space;
+    const lv_txt_layout_t * layout = get_layout(label, font, letter_space, max_w, flag);
+    uint32_t line_id = layout ? find_line_by_y(layout, pos.y, letter_height, line_space) : 0;
+    if(layout && line_id >= layout->line_cnt) {
+        /*Below the last line*/
+        line_start = layout->end;
+        new_line_start = layout->end;
+    }
+    else if(layout) {
+        line_start = layout->lines[line_id].start;
+        new_line_start = _lv_txt_layout_get_line_end(layout, line_id);
+
+        /* Include the NULL terminator in the last line */
+        uint32_t tmp = new_line_start;
+        uint32_t letter;
+        letter = _lv_txt_encoded_prev(txt, &tmp);
+        if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
+    }
+    else {
+        /*Search the line of the index letter */;
+        while(txt[line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+
+            if(pos.y <= y + letter_height) {
+                /*The line is found (stored in 'line_start')*/
+                /* Include the NULL terminator in the last line */
+                uint32_t tmp = new_line_start;
+                uint32_t letter;
+                letter = _lv_txt_encoded_prev(txt, &tmp);
+                if(letter != '\n' && txt[new_line_start] == '\0') new_line_start++;
+                break;
+            }
+            y += letter_height + line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
     }
 
 #if LV_USE_BIDI
@@ -704,15 +756,13 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * label, lv_point_t * pos_in)
 
     /*Calculate the x coordinate*/
     lv_coord_t x = 0;
-    if(align == LV_LABEL_ALIGN_CENTER) {
+    if(align == LV_LABEL_ALIGN_CENTER || align == LV_LABEL_ALIGN_RIGHT) {
         lv_coord_t line_w;
-        line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
-        x += lv_area_get_width(&txt_coords) / 2 - line_w / 2;
-    }
-    else if(align == LV_LABEL_ALIGN_RIGHT) {
-        lv_coord_t line_w;
-        line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
-        x += lv_area_get_width(&txt_coords) - line_w;
+        if(layout && line_id < layout->line_cnt) line_w = layout->lines[line_id].w;
+        else line_w = _lv_txt_get_width(bidi_txt, new_line_start - line_start, font, letter_space, flag);
+
+        if(align == LV_LABEL_ALIGN_CENTER) x += lv_area_get_width(&txt_coords) / 2 - line_w / 2;
+        else x += lv_area_get_width(&txt_coords) - line_w;
     }
 
     lv_txt_cmd_state_t cmd_state = LV_TXT_CMD_STATE_WAIT;
@@ -759,8 +809,8 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * label, lv_point_t * pos_in)
         logical_pos = _lv_bidi_get_logical_pos(&txt[line_start], NULL,
                                                txt_len, lv_obj_get_base_dir(label), cid, &is_rtl);
         if(is_rtl) logical_pos++;
-        _lv_mem_buf_release(bidi_txt);
     }
+    _lv_mem_buf_release(bidi_txt);
 #else
     logical_pos = _lv_txt_encoded_get_char_id(bidi_txt, i);
 #endif
@@ -836,28 +886,39 @@ bool lv_label_is_char_under_pos(const lv_obj_t * label, lv_point_t * pos)
     if(ext->long_mode == LV_LABEL_LONG_EXPAND) flag |= LV_TXT_FLAG_FIT;
     if(align == LV_LABEL_ALIGN_CENTER) flag |= LV_TXT_FLAG_CENTER;
 
-    /*Search the line of the index letter */;
-    while(txt[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+    const lv_txt_layout_t * layout = get_layout(label, font, letter_space, max_w, flag);
+    uint32_t line_id = layout ? find_line_by_y(layout, pos->y, letter_height, line_space) : 0;
+    if(layout && line_id >= layout->line_cnt) {
+        /*Below the last line*/
+        line_start = layout->end;
+        new_line_start = layout->end;
+    }
+    else if(layout) {
+        line_start = layout->lines[line_id].start;
+        new_line_start = _lv_txt_layout_get_line_end(layout, line_id);
+    }
+    else {
+        /*Search the line of the index letter */;
+        while(txt[line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
 
-        if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
-        y += letter_height + line_space;
+            if(pos->y <= y + letter_height) break; /*The line is found (stored in 'line_start')*/
+            y += letter_height + line_space;
 
-        line_start = new_line_start;
+            line_start = new_line_start;
+        }
     }
 
     /*Calculate the x coordinate*/
     lv_coord_t x      = 0;
     lv_coord_t last_x = 0;
-    if(align == LV_LABEL_ALIGN_CENTER) {
-        lv_coord_t line_w;
-        line_w = _lv_txt_get_width(&txt[line_start], new_line_start - line_start, font, letter_space, flag);
-        x += lv_area_get_width(&txt_coords) / 2 - line_w / 2;
-    }
-    else if(align == LV_LABEL_ALIGN_RIGHT) {
+    if(align == LV_LABEL_ALIGN_CENTER || align == LV_LABEL_ALIGN_RIGHT) {
         lv_coord_t line_w;
-        line_w = _lv_txt_get_width(&txt[line_start], new_line_start - line_start, font, letter_space, flag);
-        x += lv_area_get_width(&txt_coords) - line_w;
+        if(layout && line_id < layout->line_cnt) line_w = layout->lines[line_id].w;
+        else line_w = _lv_txt_get_width(&txt[line_start], new_line_start - line_start, font, letter_space, flag);
+
+        if(align == LV_LABEL_ALIGN_CENTER) x += lv_area_get_width(&txt_coords) / 2 - line_w / 2;
+        else x += lv_area_get_width(&txt_coords) - line_w;
     }
 
     lv_txt_cmd_state_t cmd_state = LV_TXT_CMD_STATE_WAIT;
@@ -945,6 +1006,9 @@ void lv_label_ins_text(lv_obj_t * label, uint32_t pos, const char * txt)
         pos = _lv_txt_get_encoded_length(ext->text);
     }
 
+    /*Only the lines from the inserted text needs to be laid out again*/
+    layout_invalidate(label, ext->text, _lv_txt_encoded_get_byte_id(ext->text, pos));
+
 #if LV_USE_BIDI
     char * bidi_buf = _lv_mem_buf_get(ins_len + 1);
     LV_ASSERT_MEM(bidi_buf);
@@ -957,7 +1021,12 @@ void lv_label_ins_text(lv_obj_t * label, uint32_t pos, const char * txt)
 #else
     _lv_txt_ins(ext->text, pos, txt);
 #endif
+
+#if LV_USE_ARABIC_PERSIAN_CHARS
     lv_label_set_text(label, NULL);
+#else
+    refr_text(label);
+#endif
 }
 
 /**
@@ -979,11 +1048,13 @@ void lv_label_cut_text(lv_obj_t * label, uint32_t pos, uint32_t cnt)
     lv_obj_invalidate(label);
 
     char * label_txt = lv_label_get_text(label);
+    layout_invalidate(label, label_txt, _lv_txt_encoded_get_byte_id(label_txt, pos));
+
     /*Delete the characters*/
     _lv_txt_cut(label_txt, pos, cnt);
 
     /*Refresh the label*/
-    lv_label_refr_text(label);
+    refr_text(label);
 }
 
 /**
@@ -994,6 +1065,24 @@ void lv_label_refr_text(lv_obj_t * label)
 {
     lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
 
+    /*The text might have been modified anywhere*/
+    layout_invalidate(label, ext->text, 0);
+    refr_text(label);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Refresh the size, the animations and the dots of the label after its text, style or long mode changed.
+ * The changes of the text needs to be reported with `layout_invalidate()` before.
+ * @param label pointer to a label object
+ */
+static void refr_text(lv_obj_t * label)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+
     if(ext->text == NULL) return;
 #if LV_LABEL_LONG_TXT_HINT
     ext->hint.line_start = -1; /*The hint is invalid if the text changes*/
@@ -1012,7 +1101,10 @@ void lv_label_refr_text(lv_obj_t * label)
     if(ext->recolor != 0) flag |= LV_TXT_FLAG_RECOLOR;
     if(ext->expand != 0) flag |= LV_TXT_FLAG_EXPAND;
     if(ext->long_mode == LV_LABEL_LONG_EXPAND) flag |= LV_TXT_FLAG_FIT;
-    _lv_txt_get_size(&size, ext->text, font, letter_space, line_space, max_w, flag);
+
+    const lv_txt_layout_t * layout = get_layout(label, font, letter_space, max_w, flag);
+    if(layout) _lv_txt_layout_get_size(layout, &size, line_space);
+    else _lv_txt_get_size(&size, ext->text, font, letter_space, line_space, max_w, flag);
 
     /*Set the full size in expand mode*/
     if(ext->long_mode == LV_LABEL_LONG_EXPAND) {
@@ -1238,6 +1330,7 @@ void lv_label_refr_text(lv_obj_t * label)
             }
 
             if(lv_label_set_dot_tmp(label, &ext->text[byte_id_ori], len)) {
+                layout_invalidate(label, ext->text, byte_id_ori);
                 for(i = 0; i < LV_LABEL_DOT_NUM; i++) {
                     ext->text[byte_id_ori + i] = '.';
                 }
@@ -1259,10 +1352,6 @@ void lv_label_refr_text(lv_obj_t * label)
     lv_obj_invalidate(label);
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-
 /**
  * Handle the drawing related tasks of the labels
  * @param label pointer to a label object
@@ -1321,14 +1410,22 @@ static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_
         label_draw_dsc.ofs_y = ext->offset.y;
         label_draw_dsc.flag = flag;
         lv_obj_init_draw_label_dsc(label, LV_LABEL_PART_MAIN, &label_draw_dsc);
+        label_draw_dsc.layout = get_layout(label, label_draw_dsc.font, label_draw_dsc.letter_space,
+                                           lv_area_get_width(&txt_coords), flag);
 
         /* In SROLL and SROLL_CIRC mode the CENTER and RIGHT are pointless so remove them.
          * (In addition they will result misalignment is this case)*/
         if((ext->long_mode == LV_LABEL_LONG_SROLL || ext->long_mode == LV_LABEL_LONG_SROLL_CIRC) &&
            (ext->align == LV_LABEL_ALIGN_CENTER || ext->align == LV_LABEL_ALIGN_RIGHT)) {
             lv_point_t size;
-            _lv_txt_get_size(&size, ext->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                             LV_COORD_MAX, flag);
+            if(label_draw_dsc.layout && _lv_txt_layout_is_valid(label_draw_dsc.layout, ext->text, label_draw_dsc.font,
+                                                                 label_draw_dsc.letter_space, LV_COORD_MAX, flag)) {
+                _lv_txt_layout_get_size(label_draw_dsc.layout, &size, label_draw_dsc.line_space);
+            }
+            else {
+                _lv_txt_get_size(&size, ext->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
+                                 LV_COORD_MAX, flag);
+            }
             if(size.x > lv_area_get_width(&txt_coords)) {
                 label_draw_dsc.flag &= ~LV_TXT_FLAG_RIGHT;
                 label_draw_dsc.flag &= ~LV_TXT_FLAG_CENTER;
@@ -1348,8 +1445,14 @@ static lv_design_res_t lv_label_design(lv_obj_t * label, const lv_area_t * clip_
 
         if(ext->long_mode == LV_LABEL_LONG_SROLL_CIRC) {
             lv_point_t size;
-            _lv_txt_get_size(&size, ext->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                             LV_COORD_MAX, flag);
+            if(label_draw_dsc.layout && _lv_txt_layout_is_valid(label_draw_dsc.layout, ext->text, label_draw_dsc.font,
+                                                                 label_draw_dsc.letter_space, LV_COORD_MAX, flag)) {
+                _lv_txt_layout_get_size(label_draw_dsc.layout, &size, label_draw_dsc.line_space);
+            }
+            else {
+                _lv_txt_get_size(&size, ext->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
+                                 LV_COORD_MAX, flag);
+            }
 
             /*Draw the text again next to the original to make an circular effect */
             if(size.x > lv_area_get_width(&txt_coords)) {
@@ -1403,17 +1506,20 @@ static lv_res_t lv_label_signal(lv_obj_t * label, lv_signal_t sign, void * param
             ext->text = NULL;
         }
         lv_label_dot_tmp_free(label);
+#if LV_LABEL_LAYOUT_CACHE
+        _lv_txt_layout_free(&ext->layout);
+#endif
     }
     else if(sign == LV_SIGNAL_STYLE_CHG) {
         /*Revert dots for proper refresh*/
         lv_label_revert_dots(label);
-        lv_label_refr_text(label);
+        refr_text(label);
     }
     else if(sign == LV_SIGNAL_COORD_CHG) {
         if(lv_area_get_width(&label->coords) != lv_area_get_width(param) ||
            lv_area_get_height(&label->coords) != lv_area_get_height(param)) {
             lv_label_revert_dots(label);
-            lv_label_refr_text(label);
+            refr_text(label);
         }
     }
     else if(sign == LV_SIGNAL_BASE_DIR_CHG) {
@@ -1432,6 +1538,7 @@ static void lv_label_revert_dots(lv_obj_t * label)
     if(ext->dot_end == LV_LABEL_DOT_END_INV) return;
     uint32_t letter_i = ext->dot_end - LV_LABEL_DOT_NUM;
     uint32_t byte_i   = _lv_txt_encoded_get_byte_id(ext->text, letter_i);
+    layout_invalidate(label, ext->text, byte_i);
 
     /*Restore the characters*/
     uint8_t i      = 0;
@@ -1538,4 +1645,87 @@ static void get_txt_coords(const lv_obj_t * label, lv_area_t * area)
     area->y2 -= bottom;
 }
 
+/**
+ * Get the line breaks of the label's text. Only the lines changed since the last call are laid out.
+ * @param label pointer to a label object
+ * @param font font of the text
+ * @param letter_space letter space of the text
+ * @param max_w width of the text area
+ * @param flag settings for the text from 'txt_flag_t' enum
+ * @return the layout of the text or NULL if the lines needs to be found letter by letter
+ */
+static const lv_txt_layout_t * get_layout(const lv_obj_t * label, const lv_font_t * font, lv_coord_t letter_space,
+                                          lv_coord_t max_w, lv_txt_flag_t flag)
+{
+#if LV_LABEL_LAYOUT_CACHE
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+
+    /*The bands rendered in parallel update the same layout. Once updated, it's only read while drawing.*/
+    _lv_refr_lock();
+    bool ok = _lv_txt_layout_update(&ext->layout, ext->text, font, letter_space, max_w, flag);
+    _lv_refr_unlock();
+    if(ok == false) return NULL;
+
+    return &ext->layout;
+#else
+    (void)label;        /*Unused*/
+    (void)font;         /*Unused*/
+    (void)letter_space; /*Unused*/
+    (void)max_w;        /*Unused*/
+    (void)flag;         /*Unused*/
+    return NULL;
+#endif
+}
+
+/**
+ * Drop the lines of the label's layout which can be affected by a change in the text
+ * @param label pointer to a label object
+ * @param txt the old or the new text. They have to be the same up to `byte_id`.
+ * @param byte_id index of the first changed byte. 0 to lay out the whole text again.
+ */
+static void layout_invalidate(lv_obj_t * label, const char * txt, uint32_t byte_id)
+{
+#if LV_LABEL_LAYOUT_CACHE
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    _lv_txt_layout_invalidate(&ext->layout, txt, byte_id);
+#else
+    (void)label;    /*Unused*/
+    (void)txt;      /*Unused*/
+    (void)byte_id;  /*Unused*/
+#endif
+}
+
+/**
+ * Find the first line of a layout whose bottom is below a y coordinate
+ * @param layout pointer to a complete text layout
+ * @param y a y coordinate relative to the text
+ * @param letter_height height of the lines
+ * @param line_space line space of the text
+ * @return index of the line or `line_cnt` if `y` is below the text
+ */
+static uint32_t find_line_by_y(const lv_txt_layout_t * layout, lv_coord_t y, lv_coord_t letter_height,
+                               lv_coord_t line_space)
+{
+    int32_t line_h = letter_height + line_space;
+    if(y <= letter_height) return 0;
+    if(line_h <= 0) return layout->line_cnt;
+
+    uint32_t line_id = (y - letter_height + line_h - 1) / line_h;
+    return LV_MATH_MIN(line_id, layout->line_cnt);
+}
+
+/**
+ * Get the number of bytes two texts start with in common
+ * @param txt1 pointer to a text
+ * @param txt2 pointer to an other text
+ * @return index of the first different byte
+ */
+static uint32_t get_common_prefix(const char * txt1, const char * txt2)
+{
+    uint32_t i = 0;
+    while(txt1[i] != '\0' && txt1[i] == txt2[i]) i++;
+
+    return i;
+}
+
 #endif
@@ -84,6 +84,10 @@ typedef struct {
     lv_draw_label_hint_t hint; /*Used to buffer info about large text*/
 #endif
 
+#if LV_LABEL_LAYOUT_CACHE
+    lv_txt_layout_t layout; /*Line breaks of the text, kept until the text or its style changes*/
+#endif
+
 #if LV_LABEL_TEXT_SEL
     uint32_t sel_start;
     uint32_t sel_end;
@@ -290,7 +294,8 @@ void lv_label_ins_text(lv_obj_t * label, uint32_t pos, const char * txt);
 void lv_label_cut_text(lv_obj_t * label, uint32_t pos, uint32_t cnt);
 
 /**
- * Refresh the label with its text stored in its extended data
+ * Refresh the label with its text stored in its extended data.
+ * Call it after modifying the text of the label directly.
  * @param label pointer to a label object
  */
 void lv_label_refr_text(lv_obj_t * label);
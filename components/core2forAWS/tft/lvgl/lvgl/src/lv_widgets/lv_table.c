@@ -10,6 +10,7 @@
 #if LV_USE_TABLE != 0
 
 #include "../lv_core/lv_indev.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_debug.h"
 #include "../lv_misc/lv_txt.h"
 #include "../lv_misc/lv_txt_ap.h"
@@ -853,13 +854,17 @@ static lv_design_res_t lv_table_design(lv_obj_t * table, const lv_area_t * clip_
         bool rtl = lv_obj_get_base_dir(table) == LV_BIDI_DIR_RTL ? true : false;
 
         cell_area.y2 = table->coords.y1 + bg_top - 1;
+
+        /*The texts of the cells are temporarily changed while drawing them
+         *so the bands rendered in parallel draw the cells one by one*/
+        _lv_refr_lock();
         for(row = 0; row < ext->row_cnt; row++) {
             lv_coord_t h_row = ext->row_h[row];
 
             cell_area.y1 = cell_area.y2 + 1;
             cell_area.y2 = cell_area.y1 + h_row - 1;
 
-            if(cell_area.y1 > clip_area->y2) return LV_DESIGN_RES_OK;
+            if(cell_area.y1 > clip_area->y2) break;
 
             if(rtl) cell_area.x1 = table->coords.x2 - bg_right - 1;
             else cell_area.x2 = table->coords.x1 + bg_left - 1;
@@ -998,6 +1003,7 @@ static lv_design_res_t lv_table_design(lv_obj_t * table, const lv_area_t * clip_
                 col += col_merge;
             }
         }
+        _lv_refr_unlock();
     }
     /*Post draw when the children are drawn*/
     else if(mode == LV_DESIGN_DRAW_POST) {
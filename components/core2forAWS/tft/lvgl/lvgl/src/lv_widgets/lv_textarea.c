@@ -417,12 +417,8 @@ void lv_textarea_del_char(lv_obj_t * ta)
     lv_res_t res = insert_handler(ta, del_buf);
     if(res != LV_RES_OK) return;
 
-    char * label_txt = lv_label_get_text(ext->label);
-
     /*Delete a character*/
-    _lv_txt_cut(label_txt, ext->cursor.pos - 1, 1);
-    /*Refresh the label*/
-    lv_label_set_text(ext->label, label_txt);
+    lv_label_cut_text(ext->label, ext->cursor.pos - 1, 1);
     lv_textarea_clear_selection(ta);
 
     /*If the textarea became empty, invalidate it to hide the placeholder*/
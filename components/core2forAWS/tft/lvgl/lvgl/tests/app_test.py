@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+
+# Build and run the host tests of the Core2 app (lv_app_test_main.c) with the
+# configuration of the Core2 display. The sources of the app are taken from APP_DIR.
+# Usage: ./app_test.py
+
+import os
+
+lvgldirname = os.path.abspath('..')
+lvgldirname = os.path.basename(lvgldirname)
+lvgldirname = '"' + lvgldirname + '"'
+
+base_defines = '"-DLV_CONF_PATH=' + lvgldirname +'/tests/lv_test_conf.h -DLV_BUILD_TEST"'
+optimization = '"-O2 -g0"'
+
+core2 = {
+  "LV_HOR_RES_MAX":320,
+  "LV_VER_RES_MAX":240,
+  "LV_COLOR_DEPTH":16,
+  "LV_COLOR_16_SWAP":1,
+  "LV_ANTIALIAS":1,
+  "LV_DPI":130,
+  "LV_MEM_SIZE":32*1024,
+  "LV_DISP_DEF_REFR_PERIOD":30,
+  "LV_TICK_CUSTOM":1,
+  "LV_TICK_CUSTOM_INCLUDE":"\\\"<stdint.h>\\\"",
+  "LV_USE_ANIMATION":1,
+  "LV_USE_GROUP":1,
+  "LV_USE_FILESYSTEM":0,
+  "LV_USE_LOG":0,
+  "LV_USE_THEME_MATERIAL":1,
+  "LV_THEME_DEFAULT_INIT": "\\\"lv_theme_material_init\\\"",
+  "LV_THEME_DEFAULT_COLOR_PRIMARY":      "\\\"LV_COLOR_RED\\\"",
+  "LV_THEME_DEFAULT_COLOR_SECONDARY":    "\\\"LV_COLOR_BLUE\\\"",
+  "LV_THEME_DEFAULT_FLAG"         :     "\\\"LV_THEME_MATERIAL_FLAG_LIGHT\\\"",
+  "LV_THEME_DEFAULT_FONT_SMALL"    :     "\\\"&lv_font_montserrat_16\\\"",
+  "LV_THEME_DEFAULT_FONT_NORMAL"   :     "\\\"&lv_font_montserrat_16\\\"",
+  "LV_THEME_DEFAULT_FONT_SUBTITLE" :     "\\\"&lv_font_montserrat_16\\\"",
+  "LV_THEME_DEFAULT_FONT_TITLE"    :     "\\\"&lv_font_montserrat_16\\\"",
+  "LV_FONT_MONTSERRAT_16":1,
+  "LV_USE_BAR":1,
+  "LV_USE_BTN":1,
+  "LV_USE_BTNM":1,
+  "LV_USE_CHART":1,
+  "LV_USE_CONT":1,
+  "LV_USE_LABEL":1,
+  "LV_USE_MBOX":1,
+  "LV_USE_PAGE":1,
+  "LV_USE_TEXTAREA":1,
+}
+
+d_all = base_defines[:-1] + " ";
+for d in core2:
+  d_all += " -D" + d + "=" + str(core2[d])
+d_all += '"'
+
+cmd = "make -j8 BIN=app_test.bin MAINSRC=./lv_app_test_main.c LVGL_DIR_NAME=" + lvgldirname + " DEFINES=" + d_all + " OPTIMIZATION=" + optimization
+
+os.system("make clean MAINSRC=./lv_app_test_main.c LVGL_DIR_NAME=" + lvgldirname)
+os.system("rm -f ./app_test.bin")
+ret = os.system(cmd)
+if(ret != 0):
+  print("BUILD ERROR! (error code " + str(ret) + ")")
+  exit(1)
+
+ret = os.system("./app_test.bin")
+if(ret != 0):
+  print("RUN ERROR! (error code " + str(ret) + ")")
+  exit(1)
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+
+# Build and run the headless refresh benchmark (lv_bench_main.c) with the
+# configuration of the Core2 display and write the results to bench.json.
+# Usage: ./bench.py [output.json] [flush_overhead] [glyph_cache] [blend_fast_565] [label_layout_cache] [refr_parallel]
+#                   [shadow_cache] [chart_decimate]
+# flush_overhead overrides the flush cost (in pixels) used to join the invalidated areas, 0 disables it
+# glyph_cache overrides the number of glyphs in the font glyph cache, 0 disables it
+# blend_fast_565 selects the RGB565 blend kernels (see LV_USE_BLEND_FAST_565), 0: one pixel at a time
+# label_layout_cache 0 disables keeping the line breaks of the labels
+# refr_parallel is the number of bands rendered in parallel by a thread pool, 1 disables it
+# shadow_cache is the RAM (in bytes) for the blurred shadow corners, 0 disables it
+# chart_decimate is the points per pixel to decimate the chart series from (see LV_CHART_DECIMATE), 0 disables it
+
+import os
+import sys
+
+lvgldirname = os.path.abspath('..')
+lvgldirname = os.path.basename(lvgldirname)
+lvgldirname = '"' + lvgldirname + '"'
+
+base_defines = '"-DLV_CONF_PATH=' + lvgldirname +'/tests/lv_test_conf.h -DLV_BUILD_TEST"'
+optimization = '"-O2 -g0"'
+out_file = sys.argv[1] if len(sys.argv) > 1 else "bench.json"
+flush_overhead = sys.argv[2] if len(sys.argv) > 2 else ""
+glyph_cache = int(sys.argv[3]) if len(sys.argv) > 3 else 64
+blend_fast_565 = int(sys.argv[4]) if len(sys.argv) > 4 else 2
+label_layout_cache = int(sys.argv[5]) if len(sys.argv) > 5 else 1
+refr_parallel = int(sys.argv[6]) if len(sys.argv) > 6 else 1
+shadow_cache = int(sys.argv[7]) if len(sys.argv) > 7 else 8192
+chart_decimate = int(sys.argv[8]) if len(sys.argv) > 8 else 4
+
+core2 = {
+  "LV_HOR_RES_MAX":320,
+  "LV_VER_RES_MAX":240,
+  "LV_COLOR_DEPTH":16,
+  "LV_COLOR_16_SWAP":1,
+  "LV_ANTIALIAS":1,
+  "LV_DPI":130,
+  "LV_MEM_SIZE":32*1024 if chart_decimate else 128*1024,   # Drawing all points of a 10k series takes 40 kB
+  "LV_DISP_DEF_REFR_PERIOD":30,
+  "LV_TICK_CUSTOM":1,
+  "LV_TICK_CUSTOM_INCLUDE":"\\\"<stdint.h>\\\"",
+  "LV_USE_REFR_PROFILER":1,
+  "LV_REFR_PROFILER_TIME_US":"\\\"custom_time_us_get()\\\"",
+  "LV_STYLE_CACHE_SIZE":256,
+  "LV_FONT_GLYPH_CACHE_SIZE":glyph_cache,
+  "LV_FONT_GLYPH_CACHE_MAX_PX":400,
+  "LV_USE_BLEND_FAST_565":blend_fast_565,
+  "LV_LABEL_LAYOUT_CACHE":label_layout_cache,
+  "LV_REFR_PARALLEL":refr_parallel,
+  "LV_SHADOW_CACHE_SIZE":64 if shadow_cache else 0,
+  "LV_SHADOW_CACHE_BYTES":shadow_cache,
+  "LV_CHART_DECIMATE":chart_decimate,
+  "LV_USE_ANIMATION":1,
+  "LV_USE_GROUP":1,
+  "LV_USE_FILESYSTEM":0,
+  "LV_USE_LOG":0,
+  "LV_USE_THEME_MATERIAL":1,
+  "LV_THEME_DEFAULT_INIT": "\\\"lv_theme_material_init\\\"",
+  "LV_THEME_DEFAULT_COLOR_PRIMARY":      "\\\"LV_COLOR_RED\\\"",
+  "LV_THEME_DEFAULT_COLOR_SECONDARY":    "\\\"LV_COLOR_BLUE\\\"",
+  "LV_THEME_DEFAULT_FLAG"         :     "\\\"LV_THEME_MATERIAL_FLAG_LIGHT\\\"",
+  "LV_THEME_DEFAULT_FONT_SMALL"    :     "\\\"&lv_font_montserrat_16\\\"",
+  "LV_THEME_DEFAULT_FONT_NORMAL"   :     "\\\"&lv_font_montserrat_16\\\"",
+  "LV_THEME_DEFAULT_FONT_SUBTITLE" :     "\\\"&lv_font_montserrat_16\\\"",
+  "LV_THEME_DEFAULT_FONT_TITLE"    :     "\\\"&lv_font_montserrat_16\\\"",
+  "LV_FONT_MONTSERRAT_14":1,
+  "LV_FONT_MONTSERRAT_16":1,
+  "LV_FONT_MONTSERRAT_28_COMPRESSED":1,
+  "LV_USE_BAR":1,
+  "LV_USE_BTN":1,
+  "LV_USE_BTNM":1,
+  "LV_USE_CHART":1,
+  "LV_USE_CONT":1,
+  "LV_USE_LABEL":1,
+  "LV_USE_MBOX":1,
+  "LV_USE_PAGE":1,
+  "LV_USE_TEXTAREA":1,
+}
+
+d_all = base_defines[:-1] + " ";
+for d in core2:
+  d_all += " -D" + d + "=" + str(core2[d])
+d_all += '"'
+
+cmd = "make -j8 BIN=bench.bin MAINSRC=./lv_bench_main.c LVGL_DIR_NAME=" + lvgldirname + " DEFINES=" + d_all + " OPTIMIZATION=" + optimization
+
+os.system("make clean MAINSRC=./lv_bench_main.c LVGL_DIR_NAME=" + lvgldirname)
+os.system("rm -f ./bench.bin")
+ret = os.system(cmd)
+if(ret != 0):
+  print("BUILD ERROR! (error code " + str(ret) + ")")
+  exit(1)
+
+ret = os.system("./bench.bin " + out_file + " " + flush_overhead)
+if(ret != 0):
+  print("RUN ERROR! (error code " + str(ret) + ")")
+  exit(1)
@@ -207,6 +207,8 @@ all_obj_minimal_features = {
 all_obj_all_features = {
   "LV_DPI":100,
   "LV_MEM_SIZE":32*1024,
+  "LV_MEM_TLSF":1,
+  "LV_MEM_TLSF_STATS":1,
   "LV_HOR_RES_MAX":480,
   "LV_VER_RES_MAX":320,
   "LV_COLOR_DEPTH":32,
@@ -300,6 +302,8 @@ advanced_features = {
   "LV_USE_API_EXTENSION_V6":1,
   "LV_USE_USER_DATA":1,
   "LV_IMG_CACHE_DEF_SIZE":32,
+  "LV_SHADOW_CACHE_SIZE":64,
+  "LV_REFR_PARALLEL":4,
   "LV_USE_LOG":1,
   "LV_USE_THEME_MATERIAL":1,
   "LV_USE_THEME_EMPTY":1,
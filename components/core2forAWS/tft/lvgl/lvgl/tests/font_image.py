@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+
+# Build the font image tool (lv_font_image_main.c), convert binary fonts (.fnt) to font images
+# which can be used in place by lv_font_load_image(), and write the load time and heap usage of
+# lv_font_load() and lv_font_load_image() to font_image.json.
+# The image of <name>.fnt is written to <name>_image.bin
+# Usage: ./font_image.py [output.json] [font.fnt ...]
+# By default the fonts of the tests are converted
+
+import os
+import sys
+
+lvgldirname = os.path.abspath('..')
+lvgldirname = os.path.basename(lvgldirname)
+lvgldirname = '"' + lvgldirname + '"'
+
+base_defines = '"-DLV_CONF_PATH=' + lvgldirname +'/tests/lv_test_conf.h -DLV_BUILD_TEST"'
+optimization = '"-O2 -g0"'
+out_file = sys.argv[1] if len(sys.argv) > 1 else "font_image.json"
+fonts = sys.argv[2:] if len(sys.argv) > 2 else ["font_1.fnt", "font_2.fnt", "font_3.fnt"]
+
+config = {
+  "LV_COLOR_DEPTH":16,
+  "LV_MEM_CUSTOM":0,
+  "LV_MEM_SIZE":1024*1024,
+  "LV_USE_FILESYSTEM":1,
+  "LV_USE_LOG":0,
+}
+
+d_all = base_defines[:-1] + " ";
+for d in config:
+  d_all += " -D" + d + "=" + str(config[d])
+d_all += '"'
+
+cmd = "make -j8 BIN=font_image.bin MAINSRC=./lv_font_image_main.c LVGL_DIR_NAME=" + lvgldirname + " DEFINES=" + d_all + " OPTIMIZATION=" + optimization
+
+os.system("make clean MAINSRC=./lv_font_image_main.c LVGL_DIR_NAME=" + lvgldirname)
+os.system("rm -f ./font_image.bin")
+ret = os.system(cmd)
+if(ret != 0):
+  print("BUILD ERROR! (error code " + str(ret) + ")")
+  exit(1)
+
+results = []
+for f in fonts:
+  image = os.path.splitext(f)[0] + "_image.bin"
+  res = os.popen("./font_image.bin " + f + " " + image).read().strip()
+  if(res == ""):
+    print("RUN ERROR! (" + f + ")")
+    exit(1)
+  print(res)
+  results.append("    " + res)
+
+with open(out_file, "w") as f:
+  f.write("[\n" + ",\n".join(results) + "\n]\n")
@@ -0,0 +1,475 @@
+/**
+ * @file lv_app_test_main.c
+ * Host tests of the Core2 app: the sources of `main/` are built against LVGL
+ * on a display configured like the Core2 (320x240, RGB565, two partial buffers
+ * of 64 lines) and driven by a virtual tick.
+ * The display driver sends the flushes to the panel simulated by `lv_test_esp.c`,
+ * without and with the flush filter.
+ * Build and run with `app_test.py`.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lvgl.h"
+#include <stdio.h>
+#include <string.h>
+#include "lv_test_assert.h"
+#include "lv_test_app/lv_test_esp.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "ui.h"
+#include "disp_spi.h"
+#include "ili9341.h"
+#include "disp_filter.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define APP_BUF_LINES       64      /*Same as `DISP_BUF_SIZE` of the Core2 display driver*/
+#define APP_SELECT_NUM      1000
+#define APP_SELECT_FIRST    (APP_SELECT_NUM / 10)   /*The range of the pool is taken from these selections*/
+#define APP_SAMPLE_NUM      101     /*Samples of a capture: the progress goes to 100, then the send button is shown*/
+#define APP_SAMPLE_MS       100     /*`vTaskDelay(10)` between two samples*/
+#define APP_SPI_SELECT_NUM  6
+#define APP_SPI_CS          5       /*`CONFIG_LV_DISP_SPI_CS` of `disp_spi.c`*/
+#define APP_TRANS_MAX       16
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    lv_test_esp_trans_t trans;
+    int flushing;       /*The flush isn't ready after the transaction*/
+} app_trans_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void hal_init(void);
+static void fb_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void fb_write(const lv_area_t * area, const lv_color_t * color_p);
+static void spi_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void spi_wait_cb(lv_disp_drv_t * disp_drv);
+static void filter_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void spi_trans_cb(const lv_test_esp_trans_t * trans);
+static void ui_selections(void);
+static void ui_select(ui_sensor_t sensor, uint32_t round);
+static void spi_init(void);
+static void spi_batch(void);
+static void spi_refresh(void);
+static void filter_refresh(void);
+static void spi_check_released(void);
+static uint32_t panel_diff(void);
+static void tick_run(uint32_t ms);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t app_buf1[LV_HOR_RES_MAX * APP_BUF_LINES];
+static lv_color_t app_buf2[LV_HOR_RES_MAX * APP_BUF_LINES];
+static uint32_t app_tick;
+static app_trans_t app_trans[APP_TRANS_MAX];
+static uint32_t app_trans_cnt;
+static uint32_t app_flush_cnt;
+
+lv_color_t test_fb[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(void)
+{
+    printf("Call lv_init...\n");
+    lv_init();
+
+    hal_init();
+
+    ui_selections();
+
+    spi_init();
+    spi_batch();
+    spi_refresh();
+    filter_refresh();
+
+    printf("Exit with success!\n");
+    return 0;
+}
+
+uint32_t custom_tick_get(void)
+{
+    return app_tick;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void hal_init(void)
+{
+    static lv_disp_buf_t disp_buf;
+    lv_disp_buf_init(&disp_buf, app_buf1, app_buf2, LV_HOR_RES_MAX * APP_BUF_LINES);
+
+    lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.buffer = &disp_buf;
+    disp_drv.flush_cb = fb_flush_cb;
+    lv_disp_drv_register(&disp_drv);
+}
+
+static void fb_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    fb_write(area, color_p);
+    lv_disp_flush_ready(disp_drv);
+}
+
+static void fb_write(const lv_area_t * area, const lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&test_fb[y * LV_HOR_RES_MAX + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+}
+
+/**
+ * Keep what was rendered in `test_fb` and send it to the panel like `disp_driver_flush()`
+ */
+static void spi_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    fb_write(area, color_p);
+    app_flush_cnt++;
+    ili9341_flush(disp_drv, area, color_p);
+}
+
+/**
+ * Keep the whole flushed area in `test_fb` like the unfiltered path and send its changed tiles
+ * like `disp_driver_flush()` with `CONFIG_LV_DISP_FLUSH_FILTER`
+ */
+static void filter_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    fb_write(area, color_p);    /*The windows are compacted into `color_p`*/
+    app_flush_cnt++;
+    disp_filter_flush(disp_drv, area, color_p, ili9341_flush_window);
+}
+
+/**
+ * The bus sends the queued transactions while LVGL waits for a flush
+ */
+static void spi_wait_cb(lv_disp_drv_t * disp_drv)
+{
+    (void) disp_drv;
+    if(!lv_test_esp_bus_step()) lv_test_error("   FAIL: Waiting for a flush while nothing is on the bus.");
+}
+
+static void spi_trans_cb(const lv_test_esp_trans_t * trans)
+{
+    if(app_trans_cnt == APP_TRANS_MAX) return;
+
+    app_trans[app_trans_cnt].trans = *trans;
+    app_trans[app_trans_cnt].flushing = lv_disp_get_buf(lv_disp_get_default())->flushing;
+    app_trans_cnt++;
+}
+
+/**
+ * Select the sensors like `main.c` does and check that the widgets are reused:
+ * the pool stays in the range of the first selections.
+ * The place of the blocks can change the free size by a few block headers between two selections.
+ */
+static void ui_selections(void)
+{
+    lv_test_print("");
+    lv_test_print("Memory of the UI across %d sensor selections:", APP_SELECT_NUM);
+    lv_test_print("------------------------------------------------");
+
+    static const ui_event_cbs_t cbs = {NULL};
+    ui_init(lv_scr_act(), &cbs);
+    tick_run(1000);
+
+    uint32_t free_min = UINT32_MAX;
+    uint32_t free_max = 0;
+    uint32_t used_min = UINT32_MAX;
+    uint32_t used_max = 0;
+    uint32_t free_first_min = 0;
+    uint32_t free_first_max = 0;
+    uint32_t used_first_max = 0;
+    uint32_t i;
+    for(i = 0; i < APP_SELECT_NUM; i++) {
+        ui_select((ui_sensor_t)(i % UI_SENSOR_NUM), i);
+
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        free_min = LV_MATH_MIN(free_min, mon.free_size);
+        free_max = LV_MATH_MAX(free_max, mon.free_size);
+        used_min = LV_MATH_MIN(used_min, mon.used_cnt);
+        used_max = LV_MATH_MAX(used_max, mon.used_cnt);
+
+        if(i == APP_SELECT_FIRST - 1) {
+            free_first_min = free_min;
+            free_first_max = free_max;
+            used_first_max = used_max;
+        }
+    }
+
+    lv_test_print("Free memory: %d..%d bytes, used blocks: %d..%d", free_min, free_max, used_min, used_max);
+    lv_test_assert_int_eq(free_first_min, free_min, "Min. free memory [bytes]");
+    lv_test_assert_int_eq(free_first_max, free_max, "Max. free memory [bytes]");
+    lv_test_assert_int_eq(used_first_max, used_max, "Max. used blocks");
+    lv_test_assert_int_eq(used_min, used_max, "Used blocks after every selection");
+}
+
+/**
+ * One selection of the app: capture the samples of a sensor, send them and go back home
+ */
+static void ui_select(ui_sensor_t sensor, uint32_t round)
+{
+    /*The sensor button of the button matrix is clicked*/
+    ui_show_capture(ui_get_sensor_by_name(ui_get_sensor_name(sensor)));
+    tick_run(APP_SAMPLE_MS);
+
+    /*The start button is clicked and the samples are added by the timer*/
+    uint32_t s;
+    for(s = 1; s <= APP_SAMPLE_NUM; s++) {
+        char text[100];
+        lv_coord_t values[UI_SERIES_MAX];
+        int32_t v = (int32_t)((round * 37 + s * 11) % 200);
+        values[0] = v;
+        values[1] = 100 - v;
+        values[2] = v / 2;
+
+        if(sensor == UI_SENSOR_GYRO) {
+            lv_snprintf(text, sizeof(text), "Roll: %3d.00\nYaw: %3d.00\nPitch: %3d.00\n", values[0], values[1], values[2]);
+        }
+        else {
+            lv_snprintf(text, sizeof(text), "%s: %3d\n--------------------\nMoving Average: %3d",
+                        ui_get_sensor_name(sensor), values[0], values[0] / 2);
+        }
+
+        if(s <= 100) ui_set_progress(s);
+        else ui_show_send_btn();
+
+        ui_add_sample(values, text);
+        tick_run(APP_SAMPLE_MS);
+    }
+
+    /*The send button is clicked, then the message box is closed*/
+    ui_show_sent_msg();
+    tick_run(1000);
+    ui_show_home();
+    tick_run(APP_SAMPLE_MS);
+}
+
+/**
+ * Initialize the display like `Core2ForAWS_Display_Init()`: the commands are polled
+ */
+static void spi_init(void)
+{
+    lv_test_print("");
+    lv_test_print("Initialize the display on the simulated SPI bus:");
+    lv_test_print("-------------------------------------------------");
+
+    lv_test_esp_set_dc_gpio(ILI9341_DC);
+    spi_mutex = xSemaphoreCreateMutex();
+    disp_spi_add_device(HSPI_HOST);
+
+    app_trans_cnt = 0;
+    lv_test_esp_set_trans_cb(spi_trans_cb);
+    ili9341_init();
+    lv_test_esp_set_trans_cb(NULL);
+
+    lv_test_assert_int_gt(0, app_trans_cnt, "Polled transactions");
+    lv_test_assert_true(app_trans[0].trans.polling, "The commands are polled");
+    lv_test_assert_int_eq(0, app_trans[0].trans.dc, "D/C line of the first command");
+    lv_test_assert_int_eq(0xCF, app_trans[0].trans.data[0], "First command");
+    lv_test_assert_int_eq(1, app_trans[1].trans.dc, "D/C line of the parameters of the first command");
+    spi_check_released();
+}
+
+/**
+ * Queue a flush and check the order of its transactions once the bus sent them
+ */
+static void spi_batch(void)
+{
+    lv_test_print("");
+    lv_test_print("Send a flush as a batch of transactions:");
+    lv_test_print("----------------------------------------");
+
+    static const uint8_t dc[] = {0, 1, 0, 1, 0, 1};
+    static const uint8_t cmd[] = {0x2A, 0, 0x2B, 0, 0x2C, 0};
+    lv_area_t area = {270, 2, 309, 9};     /*The columns and the pages have a high and a low byte*/
+    uint32_t px_cnt = lv_area_get_size(&area);
+    static lv_color_t map[40 * 8];
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) map[i].full = (uint16_t)(i * 1031);
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    _lv_refr_set_disp_refreshing(disp);     /*`spi_ready()` signals the flush to the refreshing display*/
+    disp_spi_reset_stats();
+
+    app_trans_cnt = 0;
+    lv_test_esp_set_trans_cb(spi_trans_cb);
+    vdb->flushing = 1;
+    ili9341_flush(&disp->driver, &area, map);
+    lv_test_assert_int_eq(0, app_trans_cnt, "Transactions waited for by the flush");
+    lv_test_assert_true(lv_test_esp_bus_is_acquired(), "The bus is held by the queued flush");
+
+    /*The column and page addresses were on the stack of the flush*/
+    disp_wait_for_pending_transactions();
+    lv_test_esp_set_trans_cb(NULL);
+    _lv_refr_set_disp_refreshing(NULL);
+
+    lv_test_assert_int_eq(sizeof(dc), app_trans_cnt, "Transactions of a flush");
+    bool dc_ok = true;
+    bool cmd_ok = true;
+    bool ready_ok = true;
+    for(i = 0; i < app_trans_cnt; i++) {
+        const lv_test_esp_trans_t * t = &app_trans[i].trans;
+        if(t->dc != dc[i] || t->polling) dc_ok = false;
+        if(dc[i] == 0 && (t->len != 1 || t->data[0] != cmd[i])) cmd_ok = false;
+        if(app_trans[i].flushing != (i < app_trans_cnt - 1)) ready_ok = false;
+    }
+    lv_test_assert_true(dc_ok, "Queued transactions with the D/C line of the command or the data");
+    lv_test_assert_true(cmd_ok, "Column address, page address and memory write commands");
+    lv_test_assert_true(ready_ok, "The flush is ready when its last transaction is sent");
+
+    static const uint8_t caset[] = {0x01, 0x0E, 0x01, 0x35};
+    static const uint8_t paset[] = {0x00, 0x02, 0x00, 0x09};
+    lv_test_assert_array_eq(caset, app_trans[1].trans.data, sizeof(caset), "Column addresses");
+    lv_test_assert_array_eq(paset, app_trans[3].trans.data, sizeof(paset), "Page addresses");
+    lv_test_assert_int_eq(px_cnt * 2, app_trans[5].trans.len, "Bytes of the pixels");
+
+    disp_spi_stats_t stats;
+    disp_spi_get_stats(&stats);
+    lv_test_assert_int_eq(1, stats.flushes, "Signaled flushes");
+
+    const uint8_t * panel = lv_test_esp_get_panel();
+    bool px_ok = true;
+    lv_coord_t y;
+    for(y = area.y1; y <= area.y2; y++) {
+        const uint8_t * row = &panel[(y * LV_TEST_ESP_PANEL_W + area.x1) * 2];
+        if(memcmp(row, &map[(y - area.y1) * lv_area_get_width(&area)], lv_area_get_width(&area) * 2)) px_ok = false;
+    }
+    lv_test_assert_true(px_ok, "The pixels are written to the window of the flush");
+    spi_check_released();
+}
+
+/**
+ * Refresh the UI through the batches: while a flush is on the bus the next area is rendered to the other buffer.
+ * The panel has to show what was rendered.
+ */
+static void spi_refresh(void)
+{
+    lv_test_print("");
+    lv_test_print("Refresh the UI through the SPI bus:");
+    lv_test_print("-----------------------------------");
+
+    lv_disp_t * disp = lv_disp_get_default();
+    disp->driver.flush_cb = spi_flush_cb;
+    disp->driver.wait_cb = spi_wait_cb;
+    disp_spi_reset_stats();
+    app_flush_cnt = 0;
+    lv_obj_invalidate(lv_scr_act());
+
+    uint32_t diff_max = 0;
+    uint32_t i;
+    for(i = 0; i < APP_SPI_SELECT_NUM; i++) {
+        ui_select((ui_sensor_t)(i % UI_SENSOR_NUM), i);
+
+        /*A polled command waits for the flush on the bus*/
+        ili9341_sleep_out();
+        diff_max = LV_MATH_MAX(diff_max, panel_diff());
+    }
+
+    disp->driver.flush_cb = fb_flush_cb;
+    disp->driver.wait_cb = NULL;
+
+    disp_spi_stats_t stats;
+    disp_spi_get_stats(&stats);
+    lv_test_assert_int_gt(0, app_flush_cnt, "Flushes");
+    lv_test_assert_int_eq(app_flush_cnt, stats.flushes, "Signaled flushes");
+    lv_test_assert_int_eq(0, diff_max, "Max. pixels of the panel different from the rendered ones");
+    spi_check_released();
+}
+
+/**
+ * Refresh the UI through the flush filter. The panel has to show the same as with the unfiltered flushes.
+ */
+static void filter_refresh(void)
+{
+    lv_test_print("");
+    lv_test_print("Send only the changed tiles with the flush filter:");
+    lv_test_print("--------------------------------------------------");
+
+    lv_disp_t * disp = lv_disp_get_default();
+    disp->driver.flush_cb = filter_flush_cb;
+    disp->driver.wait_cb = spi_wait_cb;
+    disp->driver.rounder_cb = disp_filter_rounder;
+    disp_filter_stats_t stats_start;
+    disp_filter_get_stats(&stats_start);
+    app_flush_cnt = 0;
+    lv_obj_invalidate(lv_scr_act());
+
+    uint32_t diff_max = 0;
+    uint32_t i;
+    for(i = 0; i < APP_SPI_SELECT_NUM; i++) {
+        ui_select((ui_sensor_t)(i % UI_SENSOR_NUM), i);
+
+        ili9341_sleep_out();
+        diff_max = LV_MATH_MAX(diff_max, panel_diff());
+    }
+
+    disp->driver.flush_cb = fb_flush_cb;
+    disp->driver.wait_cb = NULL;
+    disp->driver.rounder_cb = NULL;
+
+    disp_filter_stats_t stats;
+    disp_filter_get_stats(&stats);
+    lv_test_print("%d flushes, %d windows, %d px sent, %d px skipped", app_flush_cnt, stats.windows - stats_start.windows,
+                  stats.px_sent - stats_start.px_sent, stats.px_skipped - stats_start.px_skipped);
+    lv_test_assert_int_gt(0, stats.px_skipped - stats_start.px_skipped, "Skipped pixels");
+    lv_test_assert_int_eq(0, diff_max, "Max. pixels of the panel different from the unfiltered flushes");
+    spi_check_released();
+}
+
+/**
+ * Nothing is on the bus and it's free for the other devices
+ */
+static void spi_check_released(void)
+{
+    lv_test_assert_true(!lv_test_esp_bus_is_acquired(), "The bus is released");
+    lv_test_assert_int_eq(1, lv_test_esp_get_gpio_level(APP_SPI_CS), "CS line");
+    lv_test_assert_int_eq(0, lv_test_esp_get_taken_cnt(), "Taken mutexes");
+}
+
+/**
+ * @return the number of pixels of the panel which are not the same as in `test_fb`
+ */
+static uint32_t panel_diff(void)
+{
+    const uint8_t * panel = lv_test_esp_get_panel();
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = 0; i < LV_HOR_RES_MAX * LV_VER_RES_MAX; i++) {
+        if(memcmp(&panel[i * 2], &test_fb[i], 2)) cnt++;
+    }
+    return cnt;
+}
+
+/**
+ * Let `ms` milliseconds pass, running the tasks every display refresh period
+ */
+static void tick_run(uint32_t ms)
+{
+    uint32_t t;
+    for(t = 0; t < ms; t += LV_DISP_DEF_REFR_PERIOD) {
+        app_tick += LV_DISP_DEF_REFR_PERIOD;
+        lv_task_handler();
+    }
+}
+
+#endif
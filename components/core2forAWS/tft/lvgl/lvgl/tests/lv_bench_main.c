@@ -0,0 +1,822 @@
+/**
+ * @file lv_bench_main.c
+ * Headless refresh benchmark. Renders scripted scenes on a display configured like the
+ * Core2 (320x240, RGB565, two partial buffers of 64 lines) with a virtual tick and
+ * reports the per-phase times of `lv_refr_get_profile()` as JSON.
+ * The time of sending the flushed areas is modeled like the SPI bus of the Core2.
+ * The blend and line drawing kernels are measured separately in Mpixel/s.
+ * With `LV_REFR_PARALLEL > 1` the bands are rendered by a pool of threads.
+ * Build and run with `bench.py`.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if LV_BUILD_TEST
+#include <sys/time.h>
+#if LV_REFR_PARALLEL > 1
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if LV_USE_REFR_PROFILER == 0
+#error "The benchmark requires LV_USE_REFR_PROFILER 1"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_BUF_LINES     64      /*Same as `DISP_BUF_SIZE` of the Core2 display driver*/
+#define BENCH_TICK_STEP_MS  5       /*Virtual time between two `lv_task_handler()` calls*/
+#define BENCH_BUS_PX_NS     400     /*Sending a pixel at 40 MHz*/
+#define BENCH_BUS_FLUSH_US  60      /*Sending the commands and queuing the transactions of a flush*/
+#define BENCH_KERNEL_ROUND  400     /*Blend the whole draw buffer this many times*/
+#define BENCH_LINE_POINTS   161     /*Points of the series drawn by the line kernels*/
+#define BENCH_CHART_10K     10000   /*Points of the series of the high resolution chart*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const char * name;
+    uint32_t duration_ms;
+    uint32_t period_ms;                 /*Call `step` this often*/
+    void (*setup)(lv_obj_t * scr);
+    void (*step)(uint32_t i);
+} bench_scene_t;
+
+typedef struct {
+    const char * name;
+    uint32_t (*run)(const lv_area_t * area);   /*Return the number of drawn pixels*/
+} bench_kernel_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void hal_init(void);
+static void bench_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void run_scene(const bench_scene_t * scene, FILE * out[], uint32_t out_cnt, bool last);
+static void print_result(FILE * f, const bench_scene_t * scene, const lv_refr_profile_t * p, uint32_t updates,
+                         uint32_t update_us, bool last);
+static int32_t signal_next(void);
+static void dashboard_create(lv_obj_t * scr);
+static void chart_setup(lv_obj_t * scr);
+static void chart_scroll_setup(lv_obj_t * scr);
+static void chart_10k_setup(lv_obj_t * scr);
+static void chart_step(uint32_t i);
+static void textarea_setup(lv_obj_t * scr);
+static void textarea_step(uint32_t i);
+static void msgbox_setup(lv_obj_t * scr);
+static void msgbox_step(uint32_t i);
+static void shadow_setup(lv_obj_t * scr);
+static void shadow_step(uint32_t i);
+static void invalidate_step(uint32_t i);
+static void dashboard_setup(lv_obj_t * scr);
+static void dashboard_step(uint32_t i);
+static void label_setup(lv_obj_t * scr);
+static void label_step(uint32_t i);
+static void multiline_setup(lv_obj_t * scr);
+static void multiline_step(uint32_t i);
+static void run_kernel(const bench_kernel_t * kernel, FILE * out[], uint32_t out_cnt, bool last);
+static uint32_t kernel_fill_opa(const lv_area_t * area);
+static uint32_t kernel_fill_mask(const lv_area_t * area);
+static uint32_t kernel_fill_mask_opa(const lv_area_t * area);
+static uint32_t kernel_map_opa(const lv_area_t * area);
+static uint32_t kernel_map_mask(const lv_area_t * area);
+static uint32_t kernel_map_mask_opa(const lv_area_t * area);
+static uint32_t kernel_line_generic(const lv_area_t * area);
+static uint32_t kernel_line_polyline(const lv_area_t * area);
+static uint32_t line_px(const lv_draw_line_dsc_t * dsc);
+static void line_dsc_init(lv_draw_line_dsc_t * dsc);
+static const char * blend_kernel_name(void);
+#if LV_REFR_PARALLEL > 1
+static void * band_worker(void * arg);
+static void band_start_cb(lv_disp_drv_t * disp_drv, lv_refr_band_t * band);
+static void band_wait_cb(lv_disp_drv_t * disp_drv);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t bench_fb[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+static lv_color_t bench_buf1[LV_HOR_RES_MAX * BENCH_BUF_LINES];
+static lv_color_t bench_buf2[LV_HOR_RES_MAX * BENCH_BUF_LINES];
+static lv_color_t kernel_map[LV_HOR_RES_MAX * BENCH_BUF_LINES];
+static lv_opa_t kernel_mask[LV_HOR_RES_MAX * BENCH_BUF_LINES];
+static lv_point_t kernel_line[BENCH_LINE_POINTS];
+static uint32_t bench_tick;
+static uint32_t bench_flush_cnt;
+static uint32_t bench_flush_px;
+static uint32_t bench_flush_overhead = BENCH_BUS_FLUSH_US * 1000 / BENCH_BUS_PX_NS;
+static uint32_t signal_seed = 1;
+
+#if LV_REFR_PARALLEL > 1
+static pthread_mutex_t band_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t band_cond = PTHREAD_COND_INITIALIZER;
+static lv_refr_band_t * band_queue[LV_REFR_PARALLEL - 1];
+static uint32_t band_queue_cnt;
+#endif
+
+static lv_obj_t * chart;
+static lv_chart_series_t * chart_ser[3];
+static lv_coord_t chart_10k_points[3][BENCH_CHART_10K];    /*In the application's memory, not in `LV_MEM_SIZE`*/
+static lv_obj_t * ta;
+static lv_obj_t * mbox;
+static lv_obj_t * shadow_btns[6];
+static lv_obj_t * bars[3];
+static lv_obj_t * clock_label;
+static lv_obj_t * spots[10];
+static lv_obj_t * labels[8];
+static lv_obj_t * log_label;
+
+static const char * mbox_btns[] = {"Park", "Cancel", ""};
+
+static const bench_scene_t scenes[] = {
+    {"chart_stream_100hz",    3000, 10,  chart_setup,     chart_step},
+    {"chart_scroll_100hz",    3000, 10,  chart_scroll_setup, chart_step},
+    {"chart_10k_100hz",       3000, 10,  chart_10k_setup, chart_step},
+    {"textarea_update",       5000, 100, textarea_setup,  textarea_step},
+    {"msgbox_popup",          5000, 250, msgbox_setup,    msgbox_step},
+    {"shadow_buttons",        3000, 20,  shadow_setup,    shadow_step},
+    {"full_screen_invalidate", 3000, 30, dashboard_create, invalidate_step},
+    {"dashboard_update",      5000, 100, dashboard_setup, dashboard_step},
+    {"label_text_100hz",      3000, 10,  label_setup,     label_step},
+    {"label_multiline",       5000, 50,  multiline_setup, multiline_step},
+};
+
+static const bench_kernel_t kernels[] = {
+    {"fill_opa",        kernel_fill_opa},
+    {"fill_mask",       kernel_fill_mask},
+    {"fill_mask_opa",   kernel_fill_mask_opa},
+    {"map_opa",         kernel_map_opa},
+    {"map_mask",        kernel_map_mask},
+    {"map_mask_opa",    kernel_map_mask_opa},
+    {"line_generic",    kernel_line_generic},
+    {"line_polyline",   kernel_line_polyline},
+};
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char * argv[])
+{
+    FILE * out[2] = {stdout, NULL};
+    uint32_t out_cnt = 1;
+
+    if(argc > 2) {
+        bench_flush_overhead = (uint32_t)atoi(argv[2]);
+    }
+
+    if(argc > 1) {
+        out[1] = fopen(argv[1], "w");
+        if(out[1] == NULL) {
+            fprintf(stderr, "Can't open %s\n", argv[1]);
+            return 1;
+        }
+        out_cnt = 2;
+    }
+
+    lv_init();
+    hal_init();
+
+    uint32_t o;
+    for(o = 0; o < out_cnt; o++) {
+        fprintf(out[o], "{\n  \"config\": {\"hor_res\": %d, \"ver_res\": %d, \"color_depth\": %d, "
+                "\"buf_px\": %d, \"buf_cnt\": 2, \"refr_period_ms\": %d, \"flush_overhead\": %u, "
+                "\"style_cache\": %d, \"glyph_cache\": %d, \"blend_kernel\": \"%s\", \"label_layout_cache\": %d, "
+                "\"refr_parallel\": %d, \"shadow_cache\": %d, \"shadow_cache_bytes\": %d},\n"
+                "  \"scenes\": [\n",
+                LV_HOR_RES_MAX, LV_VER_RES_MAX, LV_COLOR_DEPTH, LV_HOR_RES_MAX * BENCH_BUF_LINES,
+                LV_DISP_DEF_REFR_PERIOD, bench_flush_overhead, LV_STYLE_CACHE_SIZE, LV_FONT_GLYPH_CACHE_SIZE,
+                blend_kernel_name(), LV_LABEL_LAYOUT_CACHE, LV_REFR_PARALLEL, LV_SHADOW_CACHE_SIZE,
+                LV_SHADOW_CACHE_BYTES);
+    }
+
+    uint32_t s;
+    uint32_t scene_cnt = sizeof(scenes) / sizeof(scenes[0]);
+    for(s = 0; s < scene_cnt; s++) {
+        run_scene(&scenes[s], out, out_cnt, s == scene_cnt - 1);
+    }
+
+    for(o = 0; o < out_cnt; o++) {
+        fprintf(out[o], "  ],\n  \"kernels\": [\n");
+    }
+
+    uint32_t k;
+    uint32_t kernel_cnt = sizeof(kernels) / sizeof(kernels[0]);
+    for(k = 0; k < kernel_cnt; k++) {
+        run_kernel(&kernels[k], out, out_cnt, k == kernel_cnt - 1);
+    }
+
+    for(o = 0; o < out_cnt; o++) {
+        fprintf(out[o], "  ]\n}\n");
+    }
+    if(out[1]) fclose(out[1]);
+
+    return 0;
+}
+
+/**
+ * Virtual tick, advanced by the benchmark so every run renders the same frames.
+ */
+uint32_t custom_tick_get(void)
+{
+    return bench_tick;
+}
+
+/**
+ * Wall clock time used to profile the refresh phases.
+ */
+uint32_t custom_time_us_get(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint32_t)((uint64_t)tv.tv_sec * 1000000 + (uint64_t)tv.tv_usec);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void hal_init(void)
+{
+    static lv_disp_buf_t disp_buf;
+    lv_disp_buf_init(&disp_buf, bench_buf1, bench_buf2, LV_HOR_RES_MAX * BENCH_BUF_LINES);
+
+    lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.buffer = &disp_buf;
+    disp_drv.flush_cb = bench_flush_cb;
+    disp_drv.flush_overhead = bench_flush_overhead;
+#if LV_REFR_PARALLEL > 1
+    disp_drv.band_start_cb = band_start_cb;
+    disp_drv.wait_cb = band_wait_cb;
+
+    uint32_t i;
+    for(i = 0; i < LV_REFR_PARALLEL - 1; i++) {
+        pthread_t thread;
+        pthread_create(&thread, NULL, band_worker, NULL);
+    }
+#endif
+    lv_disp_drv_register(&disp_drv);
+}
+
+#if LV_REFR_PARALLEL > 1
+static void * band_worker(void * arg)
+{
+    LV_UNUSED(arg);
+
+    while(1) {
+        pthread_mutex_lock(&band_mutex);
+        while(band_queue_cnt == 0) pthread_cond_wait(&band_cond, &band_mutex);
+        lv_refr_band_t * band = band_queue[--band_queue_cnt];
+        pthread_mutex_unlock(&band_mutex);
+
+        lv_refr_band_render(band);
+    }
+
+    return NULL;
+}
+
+static void band_start_cb(lv_disp_drv_t * disp_drv, lv_refr_band_t * band)
+{
+    LV_UNUSED(disp_drv);
+
+    pthread_mutex_lock(&band_mutex);
+    band_queue[band_queue_cnt++] = band;
+    pthread_cond_signal(&band_cond);
+    pthread_mutex_unlock(&band_mutex);
+}
+
+static void band_wait_cb(lv_disp_drv_t * disp_drv)
+{
+    LV_UNUSED(disp_drv);
+    sched_yield();
+}
+#endif
+
+static void bench_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+
+    bench_flush_cnt++;
+    bench_flush_px += lv_area_get_size(area);
+
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&bench_fb[y * LV_HOR_RES_MAX + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    lv_disp_flush_ready(disp_drv);
+}
+
+static void run_scene(const bench_scene_t * scene, FILE * out[], uint32_t out_cnt, bool last)
+{
+    lv_obj_t * prev_scr = lv_scr_act();
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    scene->setup(scr);
+    lv_scr_load(scr);
+    lv_refr_now(NULL);
+
+    lv_refr_reset_profile();
+#if LV_FONT_GLYPH_CACHE_SIZE
+    lv_font_reset_glyph_cache_stats_fmt_txt();
+#endif
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+    lv_draw_rect_reset_shadow_cache_stats();
+#endif
+    bench_flush_cnt = 0;
+    bench_flush_px = 0;
+    uint32_t updates = 0;
+    uint32_t update_us = 0;
+    uint32_t t;
+    for(t = 0; t < scene->duration_ms; t += BENCH_TICK_STEP_MS) {
+        if(t % scene->period_ms == 0) {
+            uint32_t t_update = custom_time_us_get();
+            scene->step(updates);
+            update_us += custom_time_us_get() - t_update;
+            updates++;
+        }
+        bench_tick += BENCH_TICK_STEP_MS;
+        lv_task_handler();
+    }
+
+    uint32_t o;
+    for(o = 0; o < out_cnt; o++) {
+        print_result(out[o], scene, lv_refr_get_profile(), updates, update_us, last);
+    }
+
+    lv_scr_load(prev_scr);
+    lv_obj_del(scr);
+    lv_refr_now(NULL);
+}
+
+static void print_result(FILE * f, const bench_scene_t * scene, const lv_refr_profile_t * p, uint32_t updates,
+                         uint32_t update_us, bool last)
+{
+    /*Time of sending the flushed areas on the bus*/
+    uint32_t bus_us = bench_flush_cnt * BENCH_BUS_FLUSH_US + (uint32_t)((uint64_t)bench_flush_px * BENCH_BUS_PX_NS / 1000);
+
+    lv_font_glyph_cache_stats_t glyph;
+#if LV_FONT_GLYPH_CACHE_SIZE
+    lv_font_get_glyph_cache_stats_fmt_txt(&glyph);
+#else
+    memset(&glyph, 0, sizeof(glyph));
+#endif
+
+    lv_draw_shadow_cache_stats_t shadow;
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+    lv_draw_rect_get_shadow_cache_stats(&shadow);
+#else
+    memset(&shadow, 0, sizeof(shadow));
+#endif
+
+    fprintf(f, "    {\"name\": \"%s\", \"frames\": %u, \"updates\": %u, \"update_us\": %u, "
+            "\"refr_us\": %u, \"refr_avg_us\": %u, \"refr_max_us\": %u, "
+            "\"inv_us\": %u, \"inv_cnt\": %u, \"join_us\": %u, \"draw_us\": %u, \"blend_us\": %u, "
+            "\"flush_us\": %u, \"px_refr\": %u, \"px_blend\": %u, \"style_get\": %u, \"style_walk\": %u, "
+            "\"glyph_get\": %u, \"glyph_hit\": %u, \"glyph_decode\": %u, \"shadow_get\": %u, \"shadow_hit\": %u, "
+            "\"flushes\": %u, \"bus_us\": %u, \"total_us\": %u}%s\n",
+            scene->name, p->frames, updates, update_us,
+            p->refr_us, p->frames ? p->refr_us / p->frames : 0, p->refr_max_us,
+            p->inv_us, p->inv_cnt, p->join_us, p->draw_us, p->blend_us,
+            p->flush_us, p->px_refr, p->px_blend, p->style_get, p->style_walk,
+            glyph.lookups, glyph.hits, glyph.decodes, shadow.lookups, shadow.hits, bench_flush_cnt, bus_us, p->refr_us + bus_us, last ? "" : ",");
+}
+
+/**
+ * Deterministic, slowly changing value in [0..100] to feed the widgets.
+ */
+static int32_t signal_next(void)
+{
+    static int32_t v = 50;
+    signal_seed = signal_seed * 1103515245 + 12345;
+    v += (int32_t)((signal_seed >> 16) % 11) - 5;
+    if(v < 0) v = 0;
+    if(v > 100) v = 100;
+    return v;
+}
+
+static void dashboard_create(lv_obj_t * scr)
+{
+    lv_obj_t * label = lv_label_create(scr, NULL);
+    lv_label_set_text(label, "Parking lot A");
+    lv_obj_align(label, NULL, LV_ALIGN_IN_TOP_MID, 0, 8);
+
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        bars[i] = lv_bar_create(scr, NULL);
+        lv_obj_set_size(bars[i], 200, 20);
+        lv_obj_align(bars[i], NULL, LV_ALIGN_IN_TOP_MID, 0, 40 + i * 40);
+        lv_bar_set_value(bars[i], (int16_t)(30 + i * 20), LV_ANIM_OFF);
+    }
+
+    lv_obj_t * btn = lv_btn_create(scr, NULL);
+    lv_obj_align(btn, NULL, LV_ALIGN_IN_BOTTOM_LEFT, 10, -10);
+    label = lv_label_create(btn, NULL);
+    lv_label_set_text(label, "Reserve");
+
+    btn = lv_btn_create(scr, btn);
+    lv_obj_align(btn, NULL, LV_ALIGN_IN_BOTTOM_RIGHT, -10, -10);
+    label = lv_label_create(btn, NULL);
+    lv_label_set_text(label, "Release");
+}
+
+/**
+ * Like the Gyro chart of the application: a small strip at the bottom with 3 series
+ */
+static void chart_setup(lv_obj_t * scr)
+{
+    chart = lv_chart_create(scr, NULL);
+    lv_obj_set_size(chart, 300, 50);
+    lv_obj_align(chart, NULL, LV_ALIGN_IN_BOTTOM_MID, 0, -5);
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_point_count(chart, 50);
+    lv_chart_set_y_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 100);
+    chart_ser[0] = lv_chart_add_series(chart, LV_COLOR_RED);
+    chart_ser[1] = lv_chart_add_series(chart, LV_COLOR_GREEN);
+    chart_ser[2] = lv_chart_add_series(chart, LV_COLOR_BLUE);
+}
+
+static void chart_scroll_setup(lv_obj_t * scr)
+{
+    chart_setup(scr);
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_SCROLL);
+}
+
+/**
+ * The same chart with 10000 points per series, e.g. a minute of 166 Hz samples of the gyro
+ */
+static void chart_10k_setup(lv_obj_t * scr)
+{
+    chart_setup(scr);
+
+    uint32_t s;
+    uint32_t i;
+    for(s = 0; s < 3; s++) {
+        for(i = 0; i < BENCH_CHART_10K; i++) chart_10k_points[s][i] = (lv_coord_t)signal_next();
+        lv_chart_set_ext_array(chart, chart_ser[s], chart_10k_points[s], BENCH_CHART_10K);
+    }
+    lv_chart_refresh(chart);
+}
+
+static void chart_step(uint32_t i)
+{
+    LV_UNUSED(i);
+    lv_chart_set_next(chart, chart_ser[0], (lv_coord_t)signal_next());
+    lv_chart_set_next(chart, chart_ser[1], (lv_coord_t)(100 - signal_next()));
+    lv_chart_set_next(chart, chart_ser[2], (lv_coord_t)(signal_next() / 2 + 25));
+}
+
+static void textarea_setup(lv_obj_t * scr)
+{
+    ta = lv_textarea_create(scr, NULL);
+    lv_obj_set_size(ta, 300, 220);
+    lv_obj_align(ta, NULL, LV_ALIGN_CENTER, 0, 0);
+    lv_textarea_set_text(ta, "");
+}
+
+static void textarea_step(uint32_t i)
+{
+    char buf[48];
+
+    /*Start over now and then to keep the text within `LV_MEM_SIZE`*/
+    if(i % 16 == 0) lv_textarea_set_text(ta, "");
+
+    lv_snprintf(buf, sizeof(buf), "t=%d spot=%d occupied=%d\n", (int)i, (int)(i % 24), (int)signal_next());
+    lv_textarea_add_text(ta, buf);
+}
+
+static void msgbox_setup(lv_obj_t * scr)
+{
+    dashboard_create(scr);
+    mbox = NULL;
+}
+
+static void msgbox_step(uint32_t i)
+{
+    if(mbox == NULL) {
+        mbox = lv_msgbox_create(lv_scr_act(), NULL);
+        lv_msgbox_set_text(mbox, "Spot 12 is free.\nPark here?");
+        lv_msgbox_add_btns(mbox, mbox_btns);
+        lv_obj_set_width(mbox, 240);
+        lv_obj_align(mbox, NULL, LV_ALIGN_CENTER, 0, 0);
+    }
+    else {
+        lv_obj_del(mbox);
+        mbox = NULL;
+    }
+
+    lv_bar_set_value(bars[i % 3], (int16_t)signal_next(), LV_ANIM_OFF);
+}
+
+/**
+ * A themed screen with raised, flat and round buttons of different shadows and a message box
+ * over the first row. Every update toggles a button so its shadow (and maybe the box's) is drawn again.
+ */
+static void shadow_setup(lv_obj_t * scr)
+{
+    static lv_style_t styles[3];
+    static const lv_coord_t radius[3] = {12, 4, LV_RADIUS_CIRCLE};
+    static const lv_coord_t shadow[3] = {20, 10, 14};
+    static const lv_coord_t ofs_y[3] = {6, 3, 4};
+
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_style_init(&styles[i]);
+        lv_style_set_radius(&styles[i], LV_STATE_DEFAULT, radius[i]);
+        lv_style_set_shadow_width(&styles[i], LV_STATE_DEFAULT, shadow[i]);
+        lv_style_set_shadow_ofs_y(&styles[i], LV_STATE_DEFAULT, ofs_y[i]);
+        lv_style_set_shadow_color(&styles[i], LV_STATE_DEFAULT, LV_COLOR_GRAY);
+    }
+
+    for(i = 0; i < 6; i++) {
+        shadow_btns[i] = lv_btn_create(scr, NULL);
+        lv_obj_add_style(shadow_btns[i], LV_BTN_PART_MAIN, &styles[i % 3]);
+        lv_obj_set_size(shadow_btns[i], 90, 40);
+        lv_obj_set_pos(shadow_btns[i], 12 + (i % 3) * 104, 110 + (i / 3) * 64);
+        lv_obj_t * label = lv_label_create(shadow_btns[i], NULL);
+        lv_label_set_text_fmt(label, "Spot %d", i + 1);
+    }
+
+    mbox = lv_msgbox_create(scr, NULL);
+    lv_msgbox_set_text(mbox, "Spot 12 is free.\nPark here?");
+    lv_msgbox_add_btns(mbox, mbox_btns);
+    lv_obj_set_width(mbox, 240);
+    lv_obj_align(mbox, NULL, LV_ALIGN_IN_TOP_MID, 0, 10);
+}
+
+static void shadow_step(uint32_t i)
+{
+    lv_btn_toggle(shadow_btns[i % 6]);
+}
+
+static void invalidate_step(uint32_t i)
+{
+    LV_UNUSED(i);
+    lv_obj_invalidate(lv_scr_act());
+}
+
+/**
+ * Many small, scattered changes: animated bars, a clock in the corner and a row of parking spots
+ */
+static void dashboard_setup(lv_obj_t * scr)
+{
+    dashboard_create(scr);
+
+    clock_label = lv_label_create(scr, NULL);
+    lv_label_set_text(clock_label, "00:00");
+    lv_obj_align(clock_label, NULL, LV_ALIGN_IN_TOP_RIGHT, -8, 8);
+
+    uint32_t i;
+    for(i = 0; i < sizeof(spots) / sizeof(spots[0]); i++) {
+        spots[i] = lv_obj_create(scr, NULL);
+        lv_obj_set_size(spots[i], 24, 24);
+        lv_obj_set_pos(spots[i], (lv_coord_t)(22 + i * 28), 148);
+    }
+}
+
+static void dashboard_step(uint32_t i)
+{
+    lv_bar_set_value(bars[i % 3], (int16_t)signal_next(), LV_ANIM_ON);
+    lv_label_set_text_fmt(clock_label, "%02d:%02d", (int)(i / 600) % 60, (int)(i / 10) % 60);
+
+    /*A few spots change at once*/
+    uint32_t s;
+    for(s = 0; s < 3; s++) {
+        lv_obj_t * spot = spots[signal_next() % (sizeof(spots) / sizeof(spots[0]))];
+        lv_obj_set_hidden(spot, !lv_obj_get_hidden(spot));
+    }
+}
+
+static void label_setup(lv_obj_t * scr)
+{
+    uint32_t l;
+    for(l = 0; l < sizeof(labels) / sizeof(labels[0]); l++) {
+        labels[l] = lv_label_create(scr, NULL);
+        lv_obj_set_pos(labels[l], 10 + (l % 2) * 150, 10 + (l / 2) * 28);
+    }
+
+#if LV_FONT_MONTSERRAT_28_COMPRESSED
+    /*The last labels show the time with a larger, compressed font*/
+    lv_obj_set_style_local_text_font(labels[6], LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, &lv_font_montserrat_28_compressed);
+    lv_obj_set_style_local_text_font(labels[7], LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, &lv_font_montserrat_28_compressed);
+    lv_obj_set_y(labels[6], 150);
+    lv_obj_set_y(labels[7], 150);
+#endif
+}
+
+static void label_step(uint32_t i)
+{
+    uint32_t l;
+    for(l = 0; l < sizeof(labels) / sizeof(labels[0]); l++) {
+        if(l < 6) lv_label_set_text_fmt(labels[l], "Spot %d: %3d%%", (int)l, (int)signal_next());
+        else lv_label_set_text_fmt(labels[l], "%02d:%02d.%02d", (int)(i / 6000) % 60, (int)(i / 100) % 60, (int)i % 100);
+    }
+}
+
+/**
+ * Wrapped, centered paragraphs under an animated bar and a log which gets a new line on every update
+ */
+static void multiline_setup(lv_obj_t * scr)
+{
+    static const char * info[] = {
+        "Parking is free on weekends and after 6 pm on weekdays. Spots marked with a green light are free, "
+        "the red ones are occupied and the blue ones are reserved for electric cars.",
+        "Please keep the lanes free and park within the lines. The exit is on the east side of the building, "
+        "the elevators are next to the pay stations on every level."
+    };
+
+    uint32_t l;
+    for(l = 0; l < 2; l++) {
+        labels[l] = lv_label_create(scr, NULL);
+        lv_label_set_long_mode(labels[l], LV_LABEL_LONG_BREAK);
+        lv_label_set_align(labels[l], LV_LABEL_ALIGN_CENTER);
+        lv_obj_set_width(labels[l], 300);
+        lv_label_set_text_static(labels[l], info[l]);
+        lv_obj_set_pos(labels[l], 10, 4 + l * 76);
+    }
+
+    /*Moves over the paragraphs so they are redrawn often*/
+    bars[0] = lv_bar_create(scr, NULL);
+    lv_obj_set_size(bars[0], 280, 12);
+    lv_obj_set_pos(bars[0], 20, 70);
+    lv_bar_set_anim_time(bars[0], 300);
+
+    log_label = lv_label_create(scr, NULL);
+    lv_label_set_long_mode(log_label, LV_LABEL_LONG_BREAK);
+    lv_obj_set_width(log_label, 300);
+    lv_obj_set_pos(log_label, 10, 156);
+    lv_label_set_text(log_label, "");
+}
+
+static void multiline_step(uint32_t i)
+{
+    char buf[48];
+
+    lv_bar_set_value(bars[0], (int16_t)signal_next(), LV_ANIM_ON);
+
+    /*Start over now and then to keep the log on the screen*/
+    if(i % 8 == 0) lv_label_set_text(log_label, "");
+
+    lv_snprintf(buf, sizeof(buf), "t=%d spot %d is %s.%s", (int)i, (int)(i % 24), signal_next() > 50 ? "free" : "taken",
+                i % 8 == 7 ? "" : " ");
+    lv_label_ins_text(log_label, LV_LABEL_POS_LAST, buf);
+}
+
+/**
+ * Blend into the whole draw buffer like during a refresh and measure the speed.
+ * The background, the image and the mask are semi-random like anti-aliased edges on a gradient.
+ */
+static void run_kernel(const bench_kernel_t * kernel, FILE * out[], uint32_t out_cnt, bool last)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    lv_area_set(&vdb->area, 0, 0, LV_HOR_RES_MAX - 1, BENCH_BUF_LINES - 1);
+    vdb->buf_act = bench_buf1;
+    _lv_refr_set_disp_refreshing(disp);
+
+    uint32_t i;
+    for(i = 0; i < LV_HOR_RES_MAX * BENCH_BUF_LINES; i++) {
+        bench_buf1[i] = lv_color_make((i * 3) & 0xFF, 0x80, (i / LV_HOR_RES_MAX) * 4);
+        kernel_map[i] = lv_color_make(i & 0xFF, (i >> 4) & 0xFF, 0x40);
+        uint32_t x = i % LV_HOR_RES_MAX;
+        kernel_mask[i] = x < 40 ? LV_OPA_TRANSP : x < 60 ? (lv_opa_t)((x - 40) * 12) : LV_OPA_COVER;
+    }
+
+    /*A noisy series across the buffer like a streaming chart*/
+    uint32_t seed = 1;
+    for(i = 0; i < BENCH_LINE_POINTS; i++) {
+        seed = seed * 1103515245 + 12345;
+        kernel_line[i].x = (lv_coord_t)(i * (LV_HOR_RES_MAX - 1) / (BENCH_LINE_POINTS - 1));
+        kernel_line[i].y = (lv_coord_t)(2 + (seed >> 16) % (BENCH_BUF_LINES - 4));
+    }
+
+    uint32_t px = 0;
+    uint32_t t = custom_time_us_get();
+    uint32_t r;
+    for(r = 0; r < BENCH_KERNEL_ROUND; r++) {
+        px += kernel->run(&vdb->area);
+    }
+    t = custom_time_us_get() - t;
+
+    _lv_refr_set_disp_refreshing(NULL);
+
+    uint32_t o;
+    for(o = 0; o < out_cnt; o++) {
+        fprintf(out[o], "    {\"name\": \"%s\", \"px\": %u, \"us\": %u, \"mpix_s\": %.1f}%s\n",
+                kernel->name, px, t, t ? (double)px / t : 0.0, last ? "" : ",");
+    }
+}
+
+static uint32_t kernel_fill_opa(const lv_area_t * area)
+{
+    _lv_blend_fill(area, area, LV_COLOR_RED, NULL, LV_DRAW_MASK_RES_FULL_COVER, LV_OPA_50, LV_BLEND_MODE_NORMAL);
+    return lv_area_get_size(area);
+}
+
+static uint32_t kernel_fill_mask(const lv_area_t * area)
+{
+    _lv_blend_fill(area, area, LV_COLOR_RED, kernel_mask, LV_DRAW_MASK_RES_CHANGED, LV_OPA_COVER,
+                   LV_BLEND_MODE_NORMAL);
+    return lv_area_get_size(area);
+}
+
+static uint32_t kernel_fill_mask_opa(const lv_area_t * area)
+{
+    _lv_blend_fill(area, area, LV_COLOR_RED, kernel_mask, LV_DRAW_MASK_RES_CHANGED, LV_OPA_70, LV_BLEND_MODE_NORMAL);
+    return lv_area_get_size(area);
+}
+
+static uint32_t kernel_map_opa(const lv_area_t * area)
+{
+    _lv_blend_map(area, area, kernel_map, NULL, LV_DRAW_MASK_RES_FULL_COVER, LV_OPA_50, LV_BLEND_MODE_NORMAL);
+    return lv_area_get_size(area);
+}
+
+static uint32_t kernel_map_mask(const lv_area_t * area)
+{
+    _lv_blend_map(area, area, kernel_map, kernel_mask, LV_DRAW_MASK_RES_CHANGED, LV_OPA_COVER, LV_BLEND_MODE_NORMAL);
+    return lv_area_get_size(area);
+}
+
+static uint32_t kernel_map_mask_opa(const lv_area_t * area)
+{
+    _lv_blend_map(area, area, kernel_map, kernel_mask, LV_DRAW_MASK_RES_CHANGED, LV_OPA_70, LV_BLEND_MODE_NORMAL);
+    return lv_area_get_size(area);
+}
+
+/**
+ * Draw the series segment by segment with the line masks of `lv_draw_line()`
+ * like the chart did before `lv_draw_polyline()`
+ */
+static uint32_t kernel_line_generic(const lv_area_t * area)
+{
+    lv_draw_line_dsc_t dsc;
+    line_dsc_init(&dsc);
+
+    uint32_t i;
+    for(i = 1; i < BENCH_LINE_POINTS; i++) {
+        lv_draw_line(&kernel_line[i - 1], &kernel_line[i], area, &dsc);
+    }
+    return line_px(&dsc);
+}
+
+static uint32_t kernel_line_polyline(const lv_area_t * area)
+{
+    lv_draw_line_dsc_t dsc;
+    line_dsc_init(&dsc);
+    lv_draw_polyline(kernel_line, BENCH_LINE_POINTS, area, &dsc);
+    return line_px(&dsc);
+}
+
+/**
+ * The pixels of the series: the length of the segments along their major axis times the width
+ */
+static uint32_t line_px(const lv_draw_line_dsc_t * dsc)
+{
+    uint32_t px = 0;
+    uint32_t i;
+    for(i = 1; i < BENCH_LINE_POINTS; i++) {
+        px += LV_MATH_MAX(LV_MATH_ABS(kernel_line[i].x - kernel_line[i - 1].x),
+                          LV_MATH_ABS(kernel_line[i].y - kernel_line[i - 1].y));
+    }
+    return px * dsc->width;
+}
+
+/**
+ * A chart series line of the material theme on the Core2
+ */
+static void line_dsc_init(lv_draw_line_dsc_t * dsc)
+{
+    lv_draw_line_dsc_init(dsc);
+    dsc->color = LV_COLOR_RED;
+    dsc->width = 2;
+}
+
+/**
+ * The kernels `lv_draw_blend.c` selects for RGB565
+ */
+static const char * blend_kernel_name(void)
+{
+#if LV_COLOR_DEPTH != 16 || LV_USE_BLEND_FAST_565 == 0
+    return "scalar";
+#elif LV_USE_BLEND_FAST_565 == 2 && defined(__AVX2__)
+    return "avx2";
+#elif LV_USE_BLEND_FAST_565 == 2 && defined(__SSE2__)
+    return "sse2";
+#elif LV_USE_BLEND_FAST_565 == 2 && defined(__ARM_NEON)
+    return "neon";
+#else
+    return "swar";
+#endif
+}
+
+#endif /*LV_BUILD_TEST*/
@@ -0,0 +1,222 @@
+/**
+ * @file lv_font_image_main.c
+ * Convert a binary font (`.fnt`) to a font image and compare the load time and the heap usage
+ * of `lv_font_load()` with using the image in place by `lv_font_load_image()` from a mapped file.
+ * Usage: font_image.bin <font.fnt> <image.bin>
+ * Reports one JSON object per font. Build and run with `font_image.py`.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if LV_BUILD_TEST
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if LV_USE_FILESYSTEM == 0 || LV_MEM_CUSTOM
+#error "The font image tool requires LV_USE_FILESYSTEM 1 and LV_MEM_CUSTOM 0"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LOAD_ROUND  50
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void fs_init(void);
+static lv_fs_res_t open_cb(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t close_cb(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t read_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t seek_cb(lv_fs_drv_t * drv, void * file_p, uint32_t pos);
+static lv_fs_res_t tell_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static uint32_t heap_used(void);
+static uint32_t now_us(void);
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char * argv[])
+{
+    if(argc < 3) {
+        fprintf(stderr, "Usage: %s <font.fnt> <image.bin>\n", argv[0]);
+        return 1;
+    }
+
+    lv_init();
+    fs_init();
+
+    char path[256];
+    snprintf(path, sizeof(path), "f:%s", argv[1]);
+
+    /*Convert*/
+    uint32_t image_size;
+    void * image = lv_font_convert_to_image(path, &image_size);
+    if(image == NULL) {
+        fprintf(stderr, "Can't convert %s\n", argv[1]);
+        return 1;
+    }
+
+    FILE * f = fopen(argv[2], "wb");
+    if(f == NULL || fwrite(image, 1, image_size, f) != image_size) {
+        fprintf(stderr, "Can't write %s\n", argv[2]);
+        return 1;
+    }
+    fclose(f);
+    lv_mem_free(image);
+
+    /*Load the binary font*/
+    uint32_t heap_start = heap_used();
+    uint32_t t = now_us();
+    uint32_t r;
+    uint32_t load_heap = 0;
+    for(r = 0; r < LOAD_ROUND; r++) {
+        lv_font_t * font = lv_font_load(path);
+        if(font == NULL) {
+            fprintf(stderr, "Can't load %s\n", argv[1]);
+            return 1;
+        }
+        load_heap = heap_used() - heap_start;
+        lv_font_free(font);
+    }
+    uint32_t load_us = (now_us() - t) / LOAD_ROUND;
+
+    /*Use the mapped image*/
+    int fd = open(argv[2], O_RDONLY);
+    struct stat st;
+    if(fd < 0 || fstat(fd, &st) != 0) {
+        fprintf(stderr, "Can't open %s\n", argv[2]);
+        return 1;
+    }
+    void * map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(map == MAP_FAILED) {
+        fprintf(stderr, "Can't map %s\n", argv[2]);
+        return 1;
+    }
+
+    heap_start = heap_used();
+    t = now_us();
+    uint32_t image_heap = 0;
+    for(r = 0; r < LOAD_ROUND; r++) {
+        lv_font_t * font = lv_font_load_image(map);
+        if(font == NULL) {
+            fprintf(stderr, "Invalid image %s\n", argv[2]);
+            return 1;
+        }
+        image_heap = heap_used() - heap_start;
+        lv_font_free_image(font);
+    }
+    uint32_t image_load_us = (now_us() - t) / LOAD_ROUND;
+
+    munmap(map, st.st_size);
+    close(fd);
+
+    struct stat fnt_st;
+    stat(argv[1], &fnt_st);
+
+    printf("{\"font\": \"%s\", \"fnt_bytes\": %u, \"image_bytes\": %u, \"load_us\": %u, \"load_heap\": %u, "
+           "\"image_load_us\": %u, \"image_heap\": %u}\n",
+           argv[1], (uint32_t)fnt_st.st_size, image_size, load_us, load_heap, image_load_us, image_heap);
+
+    return 0;
+}
+
+uint32_t custom_tick_get(void)
+{
+    return now_us() / 1000;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void fs_init(void)
+{
+    static lv_fs_drv_t drv;
+    lv_fs_drv_init(&drv);
+
+    drv.letter = 'f';
+    drv.file_size = sizeof(FILE *);
+    drv.open_cb = open_cb;
+    drv.close_cb = close_cb;
+    drv.read_cb = read_cb;
+    drv.seek_cb = seek_cb;
+    drv.tell_cb = tell_cb;
+
+    lv_fs_drv_register(&drv);
+}
+
+static lv_fs_res_t open_cb(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(mode);
+
+    FILE * fp = fopen(path, "rb");
+    *((FILE **)file_p) = fp;
+    return fp == NULL ? LV_FS_RES_UNKNOWN : LV_FS_RES_OK;
+}
+
+static lv_fs_res_t close_cb(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+
+    fclose(*((FILE **)file_p));
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t read_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+
+    *br = fread(buf, 1, btr, *((FILE **)file_p));
+    return *br == 0 ? LV_FS_RES_UNKNOWN : LV_FS_RES_OK;
+}
+
+static lv_fs_res_t seek_cb(lv_fs_drv_t * drv, void * file_p, uint32_t pos)
+{
+    LV_UNUSED(drv);
+
+    fseek(*((FILE **)file_p), pos, SEEK_SET);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t tell_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+
+    *pos_p = ftell(*((FILE **)file_p));
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Bytes allocated from the `lv_mem` pool
+ */
+static uint32_t heap_used(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+static uint32_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+#endif
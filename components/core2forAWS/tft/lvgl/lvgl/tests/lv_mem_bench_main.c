@@ -0,0 +1,207 @@
+/**
+ * @file lv_mem_bench_main.c
+ * Allocation latency benchmark of `lv_mem_alloc`/`lv_mem_free`. The pool is first fragmented
+ * by many small long living allocations, then random sized blocks are allocated and freed
+ * and widgets are created and deleted like on the sensor selection of the Core2 app.
+ * Reports one JSON object per run. Build and run with `mem_bench.py`.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if LV_BUILD_TEST
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_LIVE_NUM      160     /*Long living allocations which fragment the pool*/
+#define BENCH_SLOT_NUM      64      /*Allocations replaced randomly*/
+#define BENCH_ROUND_NUM     200000
+#define BENCH_WIDGET_ROUND  2000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint64_t sum_ns;
+    uint32_t max_ns;
+    uint32_t cnt;
+    uint32_t fail;
+} lat_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void fragment_pool(void);
+static void random_sizes(lat_t * alloc_lat, lat_t * free_lat);
+static uint32_t widgets(void);
+static void lat_add(lat_t * lat, uint32_t ns);
+static uint32_t now_ns(void);
+static uint32_t rnd(void);
+static const char * allocator_name(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static void * live[BENCH_LIVE_NUM];
+static void * slots[BENCH_SLOT_NUM];
+static uint32_t rnd_seed = 1;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(void)
+{
+    lv_init();
+
+    /*A display is required to create widgets*/
+    static lv_color_t buf[LV_HOR_RES_MAX * 10];
+    static lv_disp_buf_t disp_buf;
+    lv_disp_buf_init(&disp_buf, buf, NULL, LV_HOR_RES_MAX * 10);
+    lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.buffer = &disp_buf;
+    lv_disp_drv_register(&disp_drv);
+
+    fragment_pool();
+
+    lat_t alloc_lat = {0};
+    lat_t free_lat = {0};
+    random_sizes(&alloc_lat, &free_lat);
+    uint32_t widget_us = widgets();
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+
+    printf("{\"allocator\": \"%s\", \"alloc_avg_ns\": %u, \"alloc_max_ns\": %u, \"alloc_fail\": %u, "
+           "\"free_avg_ns\": %u, \"free_max_ns\": %u, \"widget_create_del_us\": %u, "
+           "\"free_cnt\": %u, \"frag_pct\": %u}\n",
+           allocator_name(),
+           (uint32_t)(alloc_lat.sum_ns / LV_MATH_MAX(alloc_lat.cnt, 1)), alloc_lat.max_ns, alloc_lat.fail,
+           (uint32_t)(free_lat.sum_ns / LV_MATH_MAX(free_lat.cnt, 1)), free_lat.max_ns,
+           widget_us, mon.free_cnt, mon.frag_pct);
+
+    return 0;
+}
+
+uint32_t custom_tick_get(void)
+{
+    return now_ns() / 1000000;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Allocate small blocks and free every second one to leave many holes in the pool.
+ */
+static void fragment_pool(void)
+{
+    uint32_t i;
+    for(i = 0; i < BENCH_LIVE_NUM; i++) {
+        live[i] = lv_mem_alloc(rnd() % 48 + 8);
+    }
+    for(i = 0; i < BENCH_LIVE_NUM; i += 2) {
+        lv_mem_free(live[i]);
+        live[i] = NULL;
+    }
+}
+
+/**
+ * Replace random slots with new allocations of 8..264 bytes, the typical sizes of objects,
+ * style lists and texts.
+ */
+static void random_sizes(lat_t * alloc_lat, lat_t * free_lat)
+{
+    uint32_t r;
+    for(r = 0; r < BENCH_ROUND_NUM; r++) {
+        void ** s = &slots[rnd() % BENCH_SLOT_NUM];
+        if(*s) {
+            uint32_t t = now_ns();
+            lv_mem_free(*s);
+            lat_add(free_lat, now_ns() - t);
+            *s = NULL;
+        }
+        else {
+            size_t size = rnd() % 256 + 8;
+            uint32_t t = now_ns();
+            *s = lv_mem_alloc(size);
+            lat_add(alloc_lat, now_ns() - t);
+            if(*s == NULL) alloc_lat->fail++;
+        }
+    }
+
+    for(r = 0; r < BENCH_SLOT_NUM; r++) {
+        lv_mem_free(slots[r]);
+        slots[r] = NULL;
+    }
+}
+
+/**
+ * Create and delete a button matrix with a few labels.
+ * @return the time of all the rounds in microseconds
+ */
+static uint32_t widgets(void)
+{
+    static const char * map[] = {"Temp", "Humidity", "\n", "Light", "Sound", ""};
+
+    uint32_t t = now_ns();
+    uint32_t r;
+    for(r = 0; r < BENCH_WIDGET_ROUND; r++) {
+        lv_obj_t * cont = lv_cont_create(lv_scr_act(), NULL);
+        lv_obj_t * btnm = lv_btnmatrix_create(cont, NULL);
+        lv_btnmatrix_set_map(btnm, map);
+        uint32_t i;
+        for(i = 0; i < 4; i++) {
+            lv_obj_t * label = lv_label_create(cont, NULL);
+            lv_label_set_text_fmt(label, "Sensor %d: %d", (int)i, (int)(rnd() % 100));
+        }
+        lv_obj_del(cont);
+    }
+
+    return (now_ns() - t) / 1000;
+}
+
+static void lat_add(lat_t * lat, uint32_t ns)
+{
+    lat->sum_ns += ns;
+    lat->cnt++;
+    if(ns > lat->max_ns) lat->max_ns = ns;
+}
+
+static uint32_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec);
+}
+
+/**
+ * Deterministic pseudo random numbers
+ */
+static uint32_t rnd(void)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return (rnd_seed >> 16) & 0x7FFF;
+}
+
+static const char * allocator_name(void)
+{
+#if LV_MEM_CUSTOM
+    return "libc";
+#elif LV_MEM_TLSF
+    return "tlsf";
+#else
+    return "first_fit";
+#endif
+}
+
+#endif /*LV_BUILD_TEST*/
@@ -0,0 +1,13 @@
+/**
+ * @file axp192.h
+ *
+ */
+
+#ifndef AXP192_H
+#define AXP192_H
+
+#include <stdint.h>
+
+void Axp192_SetGPIO4Level(uint8_t level);
+
+#endif /*AXP192_H*/
@@ -0,0 +1,84 @@
+/**
+ * @file spi_master.h
+ * The SPI master driver of ESP-IDF v4.2. The transactions are sent to the simulated panel of `lv_test_esp.c`.
+ */
+
+#ifndef DRIVER_SPI_MASTER_H
+#define DRIVER_SPI_MASTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+
+#define SPI_TRANS_USE_RXDATA        (1 << 2)
+#define SPI_TRANS_USE_TXDATA        (1 << 3)
+#define SPI_TRANS_VARIABLE_ADDR     (1 << 5)
+
+#define SPI_DEVICE_NO_DUMMY         (1 << 6)
+
+typedef enum {
+    SPI1_HOST,
+    SPI2_HOST,
+    SPI3_HOST,
+} spi_host_device_t;
+
+#define HSPI_HOST   SPI2_HOST
+
+typedef struct spi_transaction_t spi_transaction_t;
+typedef void (*transaction_cb_t)(spi_transaction_t * trans);
+
+struct spi_transaction_t {
+    uint32_t flags;
+    uint16_t cmd;
+    uint64_t addr;
+    size_t length;          /*In bits*/
+    size_t rxlength;
+    void * user;
+    union {
+        const void * tx_buffer;
+        uint8_t tx_data[4];
+    };
+    union {
+        void * rx_buffer;
+        uint8_t rx_data[4];
+    };
+};
+
+typedef struct {
+    spi_transaction_t base;
+    uint8_t command_bits;
+    uint8_t address_bits;
+    uint8_t dummy_bits;
+} spi_transaction_ext_t;
+
+typedef struct {
+    uint8_t command_bits;
+    uint8_t address_bits;
+    uint8_t dummy_bits;
+    uint8_t mode;
+    uint16_t duty_cycle_pos;
+    uint16_t cs_ena_pretrans;
+    uint8_t cs_ena_posttrans;
+    int clock_speed_hz;
+    int input_delay_ns;
+    int spics_io_num;
+    uint32_t flags;
+    int queue_size;
+    transaction_cb_t pre_cb;
+    transaction_cb_t post_cb;
+} spi_device_interface_config_t;
+
+typedef struct _sim_spi_device_t * spi_device_handle_t;
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t * dev_config,
+                             spi_device_handle_t * handle);
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t * trans_desc, TickType_t ticks_to_wait);
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t ** trans_desc,
+                                      TickType_t ticks_to_wait);
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t * trans_desc);
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t * trans_desc);
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, TickType_t wait);
+void spi_device_release_bus(spi_device_handle_t dev);
+
+#endif /*DRIVER_SPI_MASTER_H*/
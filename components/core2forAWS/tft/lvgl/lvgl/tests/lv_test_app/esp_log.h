@@ -0,0 +1,13 @@
+/**
+ * @file esp_log.h
+ *
+ */
+
+#ifndef ESP_LOG_H
+#define ESP_LOG_H
+
+void esp_log_write(const char * tag, const char * format, ...);
+
+#define ESP_LOGI(tag, ...) esp_log_write(tag, __VA_ARGS__)
+
+#endif /*ESP_LOG_H*/
@@ -0,0 +1,19 @@
+/**
+ * @file esp_system.h
+ * The parts of ESP-IDF used by the Core2 display driver, simulated by `lv_test_esp.c`
+ */
+
+#ifndef ESP_SYSTEM_H
+#define ESP_SYSTEM_H
+
+#include <assert.h>
+#include <stdint.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK      0
+#define ESP_FAIL    -1
+
+#define IRAM_ATTR
+
+#endif /*ESP_SYSTEM_H*/
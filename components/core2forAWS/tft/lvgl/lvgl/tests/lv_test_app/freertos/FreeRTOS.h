@@ -0,0 +1,22 @@
+/**
+ * @file FreeRTOS.h
+ *
+ */
+
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+
+#define pdFALSE             0
+#define pdTRUE              1
+#define portMAX_DELAY       0xFFFFFFFF
+#define portTICK_PERIOD_MS  10
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms) / portTICK_PERIOD_MS)
+
+#define portYIELD_FROM_ISR()    ((void)0)
+
+#endif /*FREERTOS_H*/
@@ -0,0 +1,18 @@
+/**
+ * @file semphr.h
+ * Only the mutex of the shared SPI bus. There is only one task: taking a taken mutex would block forever.
+ */
+
+#ifndef FREERTOS_SEMPHR_H
+#define FREERTOS_SEMPHR_H
+
+#include "FreeRTOS.h"
+
+typedef struct _sim_semaphore_t * SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t * higher_priority_task_woken);
+
+#endif /*FREERTOS_SEMPHR_H*/
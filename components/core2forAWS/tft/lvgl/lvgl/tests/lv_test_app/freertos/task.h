@@ -0,0 +1,13 @@
+/**
+ * @file task.h
+ *
+ */
+
+#ifndef FREERTOS_TASK_H
+#define FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+void vTaskDelay(TickType_t ticks);
+
+#endif /*FREERTOS_TASK_H*/
@@ -0,0 +1,373 @@
+/**
+ * @file lv_test_esp.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdarg.h>
+#include <string.h>
+#include "../lv_test_assert.h"
+#include "lv_test_esp.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "axp192.h"
+#include "driver/gpio.h"
+#include "driver/spi_master.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define GPIO_NUM        40
+#define QUEUE_MAX       32
+#define SEM_MAX         4
+#define BUS_BYTE_NS     200     /*40 MHz*/
+
+#define CMD_CASET       0x2A
+#define CMD_PASET       0x2B
+#define CMD_RAMWR       0x2C
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    spi_transaction_t * trans[QUEUE_MAX];
+    uint32_t first;
+    uint32_t cnt;
+} fifo_t;
+
+struct _sim_spi_device_t {
+    spi_device_interface_config_t cfg;
+    fifo_t queued;      /*Waiting for the bus*/
+    fifo_t done;        /*Sent, waiting for `spi_device_get_trans_result()`*/
+    bool acquired;
+};
+
+struct _sim_semaphore_t {
+    bool taken;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void send(spi_transaction_t * trans, bool polling);
+static void panel_write(uint8_t dc, const uint8_t * data, size_t len);
+static void fifo_push(fifo_t * fifo, spi_transaction_t * trans);
+static spi_transaction_t * fifo_pop(fifo_t * fifo);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static struct _sim_spi_device_t device;
+static bool device_added;
+static struct _sim_semaphore_t sems[SEM_MAX];
+static uint32_t sem_cnt;
+static uint32_t gpio_level[GPIO_NUM];
+static int dc_gpio = -1;
+static int64_t time_ns;
+static lv_test_esp_trans_cb_t trans_cb;
+
+static uint8_t panel[LV_TEST_ESP_PANEL_W * LV_TEST_ESP_PANEL_H * 2];
+static uint8_t panel_cmd;
+static uint32_t panel_param_cnt;
+static uint8_t panel_params[4];
+static uint16_t panel_col[2];
+static uint16_t panel_page[2];
+static uint16_t panel_x;
+static uint16_t panel_y;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_esp_set_dc_gpio(int gpio)
+{
+    dc_gpio = gpio;
+}
+
+void lv_test_esp_set_trans_cb(lv_test_esp_trans_cb_t cb)
+{
+    trans_cb = cb;
+}
+
+bool lv_test_esp_bus_step(void)
+{
+    if(device.queued.cnt == 0) return false;
+
+    spi_transaction_t * trans = fifo_pop(&device.queued);
+    send(trans, false);
+
+    /*The results are lost if they aren't fetched*/
+    if(device.done.cnt == (uint32_t)device.cfg.queue_size) {
+        lv_test_error("   FAIL: More results of the transactions than the queue size.");
+    }
+    fifo_push(&device.done, trans);
+    return true;
+}
+
+bool lv_test_esp_bus_is_acquired(void)
+{
+    return device.acquired;
+}
+
+uint32_t lv_test_esp_get_taken_cnt(void)
+{
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = 0; i < sem_cnt; i++) {
+        if(sems[i].taken) cnt++;
+    }
+    return cnt;
+}
+
+uint32_t lv_test_esp_get_gpio_level(int gpio)
+{
+    return gpio_level[gpio];
+}
+
+const uint8_t * lv_test_esp_get_panel(void)
+{
+    return panel;
+}
+
+/*ESP-IDF*/
+
+int64_t esp_timer_get_time(void)
+{
+    return time_ns / 1000;
+}
+
+void esp_log_write(const char * tag, const char * format, ...)
+{
+    (void) tag;
+    (void) format;
+}
+
+void Axp192_SetGPIO4Level(uint8_t level)
+{
+    (void) level;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    time_ns += (int64_t)ticks * portTICK_PERIOD_MS * 1000000;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    if(sem_cnt == SEM_MAX) return NULL;
+    return &sems[sem_cnt++];
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    (void) ticks;
+    /*There is no other task to give it*/
+    if(sem->taken) lv_test_error("   FAIL: Taking a taken mutex would wait forever.");
+    sem->taken = true;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    if(!sem->taken) lv_test_error("   FAIL: Giving a mutex which isn't taken.");
+    sem->taken = false;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t * higher_priority_task_woken)
+{
+    (void) higher_priority_task_woken;
+    return xSemaphoreGive(sem);
+}
+
+void gpio_pad_select_gpio(gpio_num_t gpio_num)
+{
+    (void) gpio_num;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode)
+{
+    (void) gpio_num;
+    (void) mode;
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_pull_mode(gpio_num_t gpio_num, gpio_pull_mode_t pull)
+{
+    (void) gpio_num;
+    (void) pull;
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    gpio_level[gpio_num] = level;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t * dev_config,
+                             spi_device_handle_t * handle)
+{
+    (void) host;
+    if(device_added || dev_config->queue_size > QUEUE_MAX) return ESP_FAIL;
+
+    device_added = true;
+    device.cfg = *dev_config;
+    *handle = &device;
+    return ESP_OK;
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t * trans_desc, TickType_t ticks_to_wait)
+{
+    (void) ticks_to_wait;
+    /*Another device could use the bus between the transactions*/
+    if(!handle->acquired) lv_test_error("   FAIL: Queued a transaction without acquiring the bus.");
+
+    /*Wait until the bus sends one*/
+    while(handle->queued.cnt == (uint32_t)handle->cfg.queue_size) lv_test_esp_bus_step();
+
+    fifo_push(&handle->queued, trans_desc);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t ** trans_desc,
+                                      TickType_t ticks_to_wait)
+{
+    (void) ticks_to_wait;
+    while(handle->done.cnt == 0) {
+        if(!lv_test_esp_bus_step()) lv_test_error("   FAIL: Waiting for the result of a transaction which isn't queued.");
+    }
+
+    *trans_desc = fifo_pop(&handle->done);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t * trans_desc)
+{
+    spi_device_queue_trans(handle, trans_desc, portMAX_DELAY);
+
+    spi_transaction_t * done;
+    do {
+        spi_device_get_trans_result(handle, &done, portMAX_DELAY);
+    } while(done != trans_desc);
+
+    return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t * trans_desc)
+{
+    /*It would be sent between the queued transactions*/
+    if(handle->queued.cnt) lv_test_error("   FAIL: Polling transaction while queued ones are on the bus.");
+
+    send(trans_desc, true);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_acquire_bus(spi_device_handle_t handle, TickType_t wait)
+{
+    (void) wait;
+    if(handle->acquired) lv_test_error("   FAIL: The bus is acquired twice.");
+    handle->acquired = true;
+    return ESP_OK;
+}
+
+void spi_device_release_bus(spi_device_handle_t handle)
+{
+    if(!handle->acquired) lv_test_error("   FAIL: The bus is released but it isn't acquired.");
+    handle->acquired = false;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Send a transaction to the panel like the SPI interrupt: pre callback, the data, post callback
+ */
+static void send(spi_transaction_t * trans, bool polling)
+{
+    if(device.cfg.pre_cb) device.cfg.pre_cb(trans);
+
+    lv_test_esp_trans_t sent;
+    sent.dc = dc_gpio >= 0 ? gpio_level[dc_gpio] : 0;
+    sent.cs = gpio_level[device.cfg.spics_io_num];
+    sent.polling = polling;
+    sent.len = trans->length / 8;
+    const uint8_t * data = (trans->flags & SPI_TRANS_USE_TXDATA) ? trans->tx_data : trans->tx_buffer;
+    memset(sent.data, 0, sizeof(sent.data));
+    memcpy(sent.data, data, LV_MATH_MIN(sent.len, sizeof(sent.data)));
+
+    if(sent.cs) lv_test_error("   FAIL: Sent with the CS line high.");
+    panel_write(sent.dc, data, sent.len);
+    time_ns += (int64_t)sent.len * BUS_BYTE_NS;
+
+    if(device.cfg.post_cb) device.cfg.post_cb(trans);
+    if(trans_cb) trans_cb(&sent);
+}
+
+/**
+ * Decode the commands of an ILI9341 in landscape orientation which write pixels
+ */
+static void panel_write(uint8_t dc, const uint8_t * data, size_t len)
+{
+    if(dc == 0) {
+        panel_cmd = data[len - 1];
+        panel_param_cnt = 0;
+        panel_x = panel_col[0];
+        panel_y = panel_page[0];
+        return;
+    }
+
+    size_t i;
+    for(i = 0; i < len; i++) {
+        if(panel_cmd == CMD_CASET || panel_cmd == CMD_PASET) {
+            if(panel_param_cnt >= sizeof(panel_params)) continue;
+            panel_params[panel_param_cnt++] = data[i];
+            if(panel_param_cnt < sizeof(panel_params)) continue;
+
+            uint16_t * range = panel_cmd == CMD_CASET ? panel_col : panel_page;
+            range[0] = (panel_params[0] << 8) + panel_params[1];
+            range[1] = (panel_params[2] << 8) + panel_params[3];
+        }
+        else if(panel_cmd == CMD_RAMWR) {
+            if(panel_x >= LV_TEST_ESP_PANEL_W || panel_y >= LV_TEST_ESP_PANEL_H || panel_y > panel_page[1]) {
+                lv_test_error("   FAIL: Pixel out of the window of the panel.");
+            }
+
+            panel[(panel_y * LV_TEST_ESP_PANEL_W + panel_x) * 2 + panel_param_cnt] = data[i];
+            panel_param_cnt++;
+            if(panel_param_cnt == 2) {
+                panel_param_cnt = 0;
+                panel_x++;
+                if(panel_x > panel_col[1]) {
+                    panel_x = panel_col[0];
+                    panel_y++;
+                }
+            }
+        }
+    }
+}
+
+static void fifo_push(fifo_t * fifo, spi_transaction_t * trans)
+{
+    fifo->trans[(fifo->first + fifo->cnt) % QUEUE_MAX] = trans;
+    fifo->cnt++;
+}
+
+static spi_transaction_t * fifo_pop(fifo_t * fifo)
+{
+    spi_transaction_t * trans = fifo->trans[fifo->first];
+    fifo->first = (fifo->first + 1) % QUEUE_MAX;
+    fifo->cnt--;
+    return trans;
+}
+
+#endif
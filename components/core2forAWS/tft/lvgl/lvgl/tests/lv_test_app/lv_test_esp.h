@@ -0,0 +1,83 @@
+/**
+ * @file lv_test_esp.h
+ * Simulated ESP-IDF for the host tests of the Core2 app. The queued SPI transactions are
+ * sent one by one when the driver waits for them or when `lv_test_esp_bus_step()` is called.
+ * The sent bytes are decoded like an ILI9341 which shows the written pixels.
+ */
+
+#ifndef LV_TEST_ESP_H
+#define LV_TEST_ESP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_TEST_ESP_PANEL_W     320
+#define LV_TEST_ESP_PANEL_H     240
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A transaction sent to the panel*/
+typedef struct {
+    uint8_t dc;         /*Level of the D/C line*/
+    uint8_t cs;         /*Level of the CS line*/
+    bool polling;       /*Sent by `spi_device_polling_transmit()`*/
+    size_t len;         /*In bytes*/
+    uint8_t data[4];    /*The first bytes*/
+} lv_test_esp_trans_t;
+
+/*Called when a transaction was sent, after its post callback*/
+typedef void (*lv_test_esp_trans_cb_t)(const lv_test_esp_trans_t * trans);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Set the GPIO of the D/C line of the panel
+ */
+void lv_test_esp_set_dc_gpio(int gpio);
+
+void lv_test_esp_set_trans_cb(lv_test_esp_trans_cb_t cb);
+
+/**
+ * Send the oldest queued transaction
+ * @return false if nothing is queued
+ */
+bool lv_test_esp_bus_step(void);
+
+bool lv_test_esp_bus_is_acquired(void);
+
+/**
+ * @return the number of taken mutexes
+ */
+uint32_t lv_test_esp_get_taken_cnt(void);
+
+uint32_t lv_test_esp_get_gpio_level(int gpio);
+
+/**
+ * @return the pixels of the panel as RGB565 in the byte order of the bus
+ */
+const uint8_t * lv_test_esp_get_panel(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_TEST_ESP_H*/
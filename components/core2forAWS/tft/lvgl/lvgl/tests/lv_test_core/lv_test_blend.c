@@ -0,0 +1,201 @@
+/**
+ * @file lv_test_blend.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_blend.h"
+
+#if LV_BUILD_TEST && LV_COLOR_DEPTH == 16
+
+/*********************
+ *      DEFINES
+ *********************/
+#define ROW_W       48      /*Width of the test row*/
+#define ROUND_NUM   10000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void blend_rows(bool map);
+static void row_prepare(lv_area_t * area, lv_opa_t * opa, bool * masked);
+static lv_color_t mix_ref(lv_color_t fg, lv_color_t bg, lv_opa_t opa, lv_opa_t mask, bool masked, lv_opa_t mask_full);
+static lv_color_t rnd_color(void);
+static uint32_t rnd(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t dest[ROW_W];
+static lv_color_t ref[ROW_W];
+static lv_color_t map_buf[ROW_W];
+static lv_opa_t mask_buf[ROW_W];
+static uint32_t rnd_seed = 1;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_blend(void)
+{
+    lv_test_print("");
+    lv_test_print("====================");
+    lv_test_print("Start lv_blend tests");
+    lv_test_print("====================");
+
+    blend_rows(false);
+    blend_rows(true);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Blend random rows with random opacity and masks and compare them with `lv_color_mix`
+ * @param map true: blend an image, false: fill with a color
+ */
+static void blend_rows(bool map)
+{
+    lv_test_print("");
+    if(map) {
+        lv_test_print("Blend images with opacity and mask:");
+        lv_test_print("-----------------------------------");
+    }
+    else {
+        lv_test_print("Fill with opacity and mask:");
+        lv_test_print("---------------------------");
+    }
+
+    /*Draw into the test row instead of the display buffer*/
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_t * disp_refr = _lv_refr_get_disp_refreshing();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    lv_area_t vdb_area = vdb->area;
+    void * vdb_buf = vdb->buf_act;
+
+    _lv_refr_set_disp_refreshing(disp);
+    vdb->buf_act = dest;
+    lv_area_set(&vdb->area, 0, 0, ROW_W - 1, 0);
+
+    uint32_t diff_cnt = 0;
+    uint32_t r;
+    for(r = 0; r < ROUND_NUM; r++) {
+        lv_area_t area;
+        lv_opa_t opa;
+        bool masked;
+        row_prepare(&area, &opa, &masked);
+        lv_color_t color = rnd_color();
+
+        /*The mask is changed if anti-aliasing is disabled so calculate the reference before blending*/
+        lv_coord_t x;
+        for(x = 0; x < ROW_W; x++) {
+            ref[x] = dest[x];
+            if(x < area.x1 || x > area.x2 || opa < LV_OPA_MIN) continue;
+
+            lv_opa_t mask = masked ? mask_buf[x - area.x1] : LV_OPA_COVER;
+            ref[x] = mix_ref(map ? map_buf[x - area.x1] : color, dest[x], opa, mask, masked,
+                             map ? LV_OPA_MAX : LV_OPA_COVER);
+        }
+
+        lv_draw_mask_res_t mask_res = masked ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+        if(map) {
+            _lv_blend_map(&area, &area, map_buf, masked ? mask_buf : NULL, mask_res, opa, LV_BLEND_MODE_NORMAL);
+        }
+        else {
+            _lv_blend_fill(&area, &area, color, masked ? mask_buf : NULL, mask_res, opa, LV_BLEND_MODE_NORMAL);
+        }
+
+        for(x = 0; x < ROW_W; x++) {
+            if(dest[x].full != ref[x].full) diff_cnt++;
+        }
+    }
+
+    vdb->area = vdb_area;
+    vdb->buf_act = vdb_buf;
+    _lv_refr_set_disp_refreshing(disp_refr);
+
+    lv_test_assert_int_eq(0, diff_cnt, "Pixels different from `lv_color_mix`");
+}
+
+/**
+ * Randomize the row, the drawn area, the opacity and the mask.
+ * The mask has transparent, covering and repeated values like the masks of rounded rectangles.
+ */
+static void row_prepare(lv_area_t * area, lv_opa_t * opa, bool * masked)
+{
+    uint32_t i;
+    for(i = 0; i < ROW_W; i++) {
+        /*Often the same background like on a filled rectangle*/
+        dest[i] = (rnd() % 4) ? dest[i] : rnd_color();
+        map_buf[i] = rnd_color();
+        switch(rnd() % 5) {
+            case 0:
+                mask_buf[i] = LV_OPA_TRANSP;
+                break;
+            case 1:
+                mask_buf[i] = LV_OPA_COVER;
+                break;
+            case 2:
+                mask_buf[i] = i > 0 ? mask_buf[i - 1] : LV_OPA_50;
+                break;
+            default:
+                mask_buf[i] = rnd() % 256;
+        }
+    }
+
+    area->x1 = rnd() % ROW_W;
+    area->x2 = area->x1 + rnd() % (ROW_W - area->x1);
+    area->y1 = 0;
+    area->y2 = 0;
+
+    static const lv_opa_t opas[] = {LV_OPA_TRANSP, 1, LV_OPA_MIN, LV_OPA_50, LV_OPA_MAX, LV_OPA_MAX + 1, LV_OPA_COVER};
+    *opa = rnd() % 2 ? opas[rnd() % (sizeof(opas) / sizeof(opas[0]))] : rnd() % 256;
+    *masked = rnd() % 2;
+}
+
+/**
+ * The expected result of blending a pixel
+ */
+static lv_color_t mix_ref(lv_color_t fg, lv_color_t bg, lv_opa_t opa, lv_opa_t mask, bool masked, lv_opa_t mask_full)
+{
+    lv_opa_t mix;
+    if(!masked) mix = opa;
+    else if(opa > LV_OPA_MAX) mix = mask;
+    else mix = mask >= mask_full ? opa : (lv_opa_t)(((uint32_t)mask * opa) >> 8);
+
+    if(mix == LV_OPA_TRANSP) return bg;
+    if(mix > LV_OPA_MAX && !masked) return fg;
+    if(mix == LV_OPA_COVER) return fg;
+    return lv_color_mix(fg, bg, mix);
+}
+
+static lv_color_t rnd_color(void)
+{
+    lv_color_t c;
+    c.full = rnd() & 0xFFFF;
+    return c;
+}
+
+/**
+ * Deterministic pseudo random numbers
+ */
+static uint32_t rnd(void)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return (rnd_seed >> 16) & 0x7FFF;
+}
+
+#endif
@@ -0,0 +1,350 @@
+/**
+ * @file lv_test_chart.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_chart.h"
+
+#if LV_BUILD_TEST && LV_USE_CHART && LV_CHART_DECIMATE
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BUF_W       120
+#define BUF_H       80
+#define BUF_X       10      /*Position of the draw buffer (and the chart) on the screen*/
+#define BUF_Y       20
+#if LV_MEM_CUSTOM || LV_MEM_SIZE >= 96 * 1024
+#define POINT_CNT   6000
+#else
+#define POINT_CNT   (LV_MEM_SIZE / 16)  /*The series, its buckets and the other tests have to fit into the pool*/
+#endif
+#define SPIKE_CNT   7
+#define INK_MIN     64      /*Pixels darker than this are inked*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void spikes(void);
+static void incremental(lv_chart_update_mode_t mode, const char * name);
+static void few_points(void);
+static lv_obj_t * chart_create(lv_chart_series_t ** ser);
+static void chart_draw(lv_obj_t * chart, lv_color_t * buf);
+static void all_points_draw(lv_obj_t * chart, lv_chart_series_t * ser, lv_color_t * buf);
+static void draw_start(lv_color_t * buf);
+static void draw_end(void);
+static bool column_range(const lv_color_t * buf, lv_coord_t x, lv_coord_t * y_min, lv_coord_t * y_max);
+static lv_coord_t noise(uint32_t * seed);
+static uint32_t ink(lv_color_t c);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t buf_ref[BUF_W * BUF_H];
+static lv_color_t buf_act[BUF_W * BUF_H];
+static lv_area_t buf_area = {BUF_X, BUF_Y, BUF_X + BUF_W - 1, BUF_Y + BUF_H - 1};
+static lv_area_t area_saved;
+static lv_color_t * buf_saved;
+static lv_point_t points[POINT_CNT];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_chart(void)
+{
+    lv_test_print("");
+    lv_test_print("===============================");
+    lv_test_print("Start lv_chart decimation tests");
+    lv_test_print("===============================");
+
+    if(POINT_CNT < BUF_W * LV_CHART_DECIMATE * 2) {
+        lv_test_print("SKIP: the memory pool is too small for enough points to decimate");
+        return;
+    }
+
+    spikes();
+    incremental(LV_CHART_UPDATE_MODE_SHIFT, "shift");
+    incremental(LV_CHART_UPDATE_MODE_CIRCULAR, "circular");
+    few_points();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Every column of the decimated series has to cover the same rows as drawing all points,
+ * so single point spikes are visible too.
+ */
+static void spikes(void)
+{
+    lv_test_print("");
+    lv_test_print("Compare with drawing all points:");
+    lv_test_print("--------------------------------");
+
+    lv_chart_series_t * ser;
+    lv_obj_t * chart = chart_create(&ser);
+    if(chart == NULL) return;
+
+    uint32_t seed = 3;
+    uint32_t i;
+    for(i = 0; i < POINT_CNT; i++) ser->points[i] = noise(&seed);
+
+    /*Single point spikes up and down, near the ends too*/
+    static const uint16_t spike_ids[SPIKE_CNT] = {1, POINT_CNT / 6, POINT_CNT * 5 / 12, POINT_CNT * 5 / 12 + 1,
+                                                  POINT_CNT * 11 / 16, POINT_CNT * 12 / 13, POINT_CNT - 2
+                                                 };
+    for(i = 0; i < SPIKE_CNT; i++) ser->points[spike_ids[i]] = i & 1 ? 2 : 98;
+    lv_chart_refresh(chart);
+
+    chart_draw(chart, buf_act);
+    all_points_draw(chart, ser, buf_ref);
+
+    lv_area_t series_area;
+    lv_chart_get_series_area(chart, &series_area);
+
+    uint32_t col_diff = 0;
+    uint32_t col_cnt = 0;
+    lv_coord_t x;
+    for(x = series_area.x1 - BUF_X; x <= series_area.x2 - BUF_X; x++) {
+        lv_coord_t ref_min, ref_max, act_min, act_max;
+        bool ref_inked = column_range(buf_ref, x, &ref_min, &ref_max);
+        bool act_inked = column_range(buf_act, x, &act_min, &act_max);
+        if(!ref_inked && !act_inked) continue;
+
+        col_cnt++;
+        if(ref_inked != act_inked || LV_MATH_ABS(ref_min - act_min) > 1 || LV_MATH_ABS(ref_max - act_max) > 1) {
+            col_diff++;
+        }
+    }
+
+    uint32_t spike_ok = 0;
+    lv_coord_t w = lv_area_get_width(&series_area);
+    for(i = 0; i < SPIKE_CNT; i++) {
+        x = series_area.x1 - BUF_X + (w * spike_ids[i]) / (POINT_CNT - 1);
+        lv_coord_t y_min, y_max;
+        if(!column_range(buf_act, x, &y_min, &y_max)) continue;
+
+        lv_coord_t y_spike = i & 1 ? y_max : y_min;
+        lv_coord_t y_exp = points[spike_ids[i]].y - BUF_Y;
+        if(LV_MATH_ABS(y_spike - y_exp) <= 1) spike_ok++;
+    }
+
+    lv_test_assert_true(col_cnt > 0, "Inked columns");
+    lv_test_assert_int_eq(0, col_diff, "Columns with different ink range");
+    lv_test_assert_int_eq(SPIKE_CNT, spike_ok, "Visible spikes");
+    lv_test_assert_true(ser->buckets != NULL, "Decimated");
+    lv_test_assert_true(ser->bucket_cnt * sizeof(lv_chart_bucket_t) <= POINT_CNT * sizeof(lv_coord_t) * 3 / 16,
+                        "Memory of the buckets");
+
+    lv_obj_del(chart);
+}
+
+/**
+ * The buckets updated by `lv_chart_set_next` have to give the same pixels as calculating all of them
+ */
+static void incremental(lv_chart_update_mode_t mode, const char * name)
+{
+    lv_test_print("");
+    lv_test_print("Add points one by one, %s:", name);
+    lv_test_print("-----------------------------------");
+
+    lv_chart_series_t * ser;
+    lv_obj_t * chart = chart_create(&ser);
+    if(chart == NULL) return;
+    lv_chart_set_update_mode(chart, mode);
+
+    uint32_t seed = 11;
+    uint32_t i;
+    for(i = 0; i < POINT_CNT; i++) ser->points[i] = noise(&seed);
+    lv_chart_refresh(chart);
+    chart_draw(chart, buf_act);
+
+    /*Draw sometimes to use the buckets between the new points. Add a gap too.*/
+    for(i = 0; i < 3 * POINT_CNT / 2; i++) {
+        lv_coord_t y = noise(&seed);
+        if(i % 500 == 0) y = 97;
+        if(i >= POINT_CNT / 3 && i < POINT_CNT / 3 + 40) y = LV_CHART_POINT_DEF;
+        lv_chart_set_next(chart, ser, y);
+        if(i % 333 == 0) chart_draw(chart, buf_act);
+    }
+    chart_draw(chart, buf_act);
+
+    lv_chart_refresh(chart);
+    chart_draw(chart, buf_ref);
+
+    lv_test_assert_array_eq((uint8_t *)buf_ref, (uint8_t *)buf_act, sizeof(buf_ref), "Same pixels as a full update");
+
+    lv_obj_del(chart);
+}
+
+/**
+ * Series with a few points per column are drawn point by point
+ */
+static void few_points(void)
+{
+    lv_test_print("");
+    lv_test_print("Don't decimate a few points:");
+    lv_test_print("----------------------------");
+
+    lv_chart_series_t * ser;
+    lv_obj_t * chart = chart_create(&ser);
+    if(chart == NULL) return;
+
+    lv_area_t series_area;
+    lv_chart_get_series_area(chart, &series_area);
+    lv_chart_set_point_count(chart, lv_area_get_width(&series_area) * LV_CHART_DECIMATE - 1);
+    lv_chart_init_points(chart, ser, 50);
+
+    chart_draw(chart, buf_act);
+    lv_test_assert_true(ser->buckets == NULL, "Not decimated");
+
+    lv_obj_del(chart);
+}
+
+/**
+ * Create a chart on the draw buffer with one series of `POINT_CNT` points. Only the line is drawn.
+ * @return the chart or NULL if the series couldn't be allocated
+ */
+static lv_obj_t * chart_create(lv_chart_series_t ** ser)
+{
+    lv_obj_t * chart = lv_chart_create(lv_scr_act(), NULL);
+    lv_obj_set_pos(chart, BUF_X, BUF_Y);
+    lv_obj_set_size(chart, BUF_W, BUF_H);
+    lv_obj_set_style_local_bg_opa(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, LV_OPA_TRANSP);
+    lv_obj_set_style_local_border_width(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_shadow_width(chart, LV_CHART_PART_BG, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_size(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_line_width(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 1);
+    lv_obj_set_style_local_bg_opa(chart, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, LV_OPA_TRANSP);
+    lv_chart_set_div_line_count(chart, 0, 0);
+    lv_chart_set_y_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 100);
+    lv_chart_set_point_count(chart, POINT_CNT);
+
+    *ser = lv_chart_add_series(chart, LV_COLOR_BLACK);
+    if(*ser == NULL || (*ser)->points == NULL) {
+        lv_test_error("   FAIL: Couldn't allocate a series of %d points.", POINT_CNT);
+        lv_obj_del(chart);
+        return NULL;
+    }
+
+    return chart;
+}
+
+static void chart_draw(lv_obj_t * chart, lv_color_t * buf)
+{
+    draw_start(buf);
+    lv_obj_get_design_cb(chart)(chart, &buf_area, LV_DESIGN_DRAW_MAIN);
+    draw_end();
+}
+
+/**
+ * Draw the chart as a polyline through all points of its series
+ */
+static void all_points_draw(lv_obj_t * chart, lv_chart_series_t * ser, lv_color_t * buf)
+{
+    lv_area_t series_area;
+    lv_chart_get_series_area(chart, &series_area);
+    lv_coord_t w = lv_area_get_width(&series_area);
+    lv_coord_t h = lv_area_get_height(&series_area);
+
+    uint32_t i;
+    for(i = 0; i < POINT_CNT; i++) {
+        points[i].x = series_area.x1 + (w * i) / (POINT_CNT - 1);
+        points[i].y = series_area.y1 + h - ser->points[i] * h / 100;
+    }
+
+    lv_draw_line_dsc_t dsc;
+    lv_draw_line_dsc_init(&dsc);
+    lv_obj_init_draw_line_dsc(chart, LV_CHART_PART_SERIES, &dsc);
+    dsc.color = ser->color;
+
+    lv_area_t clip;
+    _lv_area_intersect(&clip, &series_area, &buf_area);
+
+    draw_start(buf);
+    lv_chart_hide_series(chart, ser, true);
+    lv_obj_get_design_cb(chart)(chart, &buf_area, LV_DESIGN_DRAW_MAIN);
+    lv_chart_hide_series(chart, ser, false);
+    lv_draw_polyline(points, POINT_CNT, &clip, &dsc);
+    draw_end();
+}
+
+/**
+ * Draw to `buf` as the draw buffer of the display in `buf_area`
+ */
+static void draw_start(lv_color_t * buf)
+{
+    uint32_t i;
+    for(i = 0; i < BUF_W * BUF_H; i++) buf[i] = LV_COLOR_WHITE;
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    area_saved = vdb->area;
+    buf_saved = vdb->buf_act;
+    vdb->area = buf_area;
+    vdb->buf_act = buf;
+    _lv_refr_set_disp_refreshing(disp);
+}
+
+static void draw_end(void)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(lv_disp_get_default());
+    vdb->area = area_saved;
+    vdb->buf_act = buf_saved;
+    _lv_refr_set_disp_refreshing(NULL);
+}
+
+/**
+ * Get the top and bottom inked rows of a column of a buffer
+ * @return false: nothing is inked in the column
+ */
+static bool column_range(const lv_color_t * buf, lv_coord_t x, lv_coord_t * y_min, lv_coord_t * y_max)
+{
+    *y_min = BUF_H;
+    *y_max = -1;
+    lv_coord_t y;
+    for(y = 0; y < BUF_H; y++) {
+        if(ink(buf[y * BUF_W + x]) < INK_MIN) continue;
+        if(y < *y_min) *y_min = y;
+        *y_max = y;
+    }
+
+    return *y_max >= 0;
+}
+
+/**
+ * A slowly wandering signal in [30, 70] with some noise
+ */
+static lv_coord_t noise(uint32_t * seed)
+{
+    static int32_t base = 50;
+    *seed = *seed * 1103515245 + 12345;
+    base += (int32_t)((*seed >> 16) % 3) - 1;
+    base = LV_MATH_MAX(30, LV_MATH_MIN(70, base));
+    return base + (lv_coord_t)((*seed >> 20) % 5) - 2;
+}
+
+/**
+ * Darkness of a pixel drawn on white
+ */
+static uint32_t ink(lv_color_t c)
+{
+    return 255 - lv_color_brightness(c);
+}
+
+#endif
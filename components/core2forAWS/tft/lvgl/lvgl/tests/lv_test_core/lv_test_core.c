@@ -13,6 +13,16 @@
 #include "lv_test_obj.h"
 #include "lv_test_style.h"
 #include "lv_test_font_loader.h"
+#include "lv_test_mem.h"
+#include "lv_test_img_cache.h"
+#include "lv_test_blend.h"
+#include "lv_test_task.h"
+#include "lv_test_indev.h"
+#include "lv_test_refr.h"
+#include "lv_test_fs.h"
+#include "lv_test_polyline.h"
+#include "lv_test_shadow.h"
+#include "lv_test_chart.h"
 
 /*********************
  *      DEFINES
@@ -48,6 +58,32 @@ void lv_test_core(void)
     lv_test_obj();
     lv_test_style();
     lv_test_font_loader();
+#if LV_MEM_CUSTOM == 0
+    lv_test_mem();
+#endif
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_test_img_cache();
+#endif
+#if LV_COLOR_DEPTH == 16
+    lv_test_blend();
+#endif
+    lv_test_task();
+#if LV_INDEV_SEARCH_GRID && (LV_MEM_CUSTOM || LV_MEM_SIZE >= 32 * 1024)
+    lv_test_indev();
+#endif
+#if LV_REFR_PARALLEL > 1
+    lv_test_refr();
+#endif
+#if LV_USE_FILESYSTEM
+    lv_test_fs();
+#endif
+    lv_test_polyline();
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+    lv_test_shadow();
+#endif
+#if LV_USE_CHART && LV_CHART_DECIMATE
+    lv_test_chart();
+#endif
 }
 
 /**********************
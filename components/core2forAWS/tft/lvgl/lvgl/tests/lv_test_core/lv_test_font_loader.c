@@ -33,6 +33,7 @@
 
 #if LV_USE_FILESYSTEM
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2);
+static void test_font_image(lv_font_t * font_ref, const char * font_name);
 #endif
 
 /**********************
@@ -70,12 +71,43 @@ void lv_test_font_loader(void)
     lv_font_free(font_1_bin);
     lv_font_free(font_2_bin);
     lv_font_free(font_3_bin);
+
+    test_font_image(&font_1, "f:font_1.fnt");
+    test_font_image(&font_2, "f:font_2.fnt");
+    test_font_image(&font_3, "f:font_3.fnt");
 #else
     lv_test_print("SKIP: font load test because it requires LV_USE_FILESYSTEM 1 and LV_FONT_FMT_TXT_LARGE 0");
 #endif
 }
 
 #if LV_USE_FILESYSTEM
+/**
+ * Convert a binary font to an image and compare the font used from the image with the reference
+ */
+static void test_font_image(lv_font_t * font_ref, const char * font_name)
+{
+    uint32_t size;
+    uint8_t * image = lv_font_convert_to_image(font_name, &size);
+    lv_test_assert_true(image != NULL, "font image converted");
+
+    lv_font_t * font = lv_font_load_image(image);
+    compare_fonts(font_ref, font);
+
+    /*The tables are used in place*/
+    lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
+    lv_test_assert_true(dsc->glyph_bitmap > image && dsc->glyph_bitmap < image + size, "glyph bitmaps in the image");
+    lv_test_assert_true((uint8_t *)dsc->glyph_dsc > image && (uint8_t *)dsc->glyph_dsc < image + size,
+                        "glyph descriptors in the image");
+
+    lv_font_free_image(font);
+
+    /*Invalid images are rejected*/
+    image[0] ^= 0xFF;
+    lv_test_assert_true(lv_font_load_image(image) == NULL, "image with wrong magic rejected");
+
+    lv_mem_free(image);
+}
+
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
 {
     lv_test_assert_true(f1 != NULL && f2 != NULL, "font not null");
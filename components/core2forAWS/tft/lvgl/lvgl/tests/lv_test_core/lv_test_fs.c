@@ -0,0 +1,413 @@
+/**
+ * @file lv_test_fs.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_fs.h"
+
+#if LV_BUILD_TEST && LV_USE_FILESYSTEM
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define FILE_NAME   "lv_test_fs.bin"
+#define FILE_SIZE   1000
+#define BLOCK_SIZE  64
+#define BLOCK_CNT   4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint32_t read;
+    uint32_t write;
+    uint32_t seek;
+} io_cnt_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void read_sequential(void);
+static void read_random(void);
+static void write_collected(void);
+static void write_through(void);
+static void drv_init(char letter, uint8_t block_cnt, bool cache_write);
+static void file_create(void);
+static uint8_t pattern(uint32_t pos);
+static io_cnt_t * io_cnt(lv_fs_drv_t * drv);
+static lv_fs_res_t open_cb(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t close_cb(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t read_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t write_cb(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
+static lv_fs_res_t seek_cb(lv_fs_drv_t * drv, void * file_p, uint32_t pos);
+static lv_fs_res_t tell_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t size_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
+static lv_fs_res_t trunc_cb(lv_fs_drv_t * drv, void * file_p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+/*'P': plain, 'C': cached, 'W': cached with collected writes*/
+static io_cnt_t cnt_plain;
+static io_cnt_t cnt_cached;
+static io_cnt_t cnt_write;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_fs(void)
+{
+    lv_test_print("");
+    lv_test_print("=================");
+    lv_test_print("Start lv_fs tests");
+    lv_test_print("=================");
+
+    drv_init('P', 0, false);
+    drv_init('C', BLOCK_CNT, false);
+    drv_init('W', BLOCK_CNT, true);
+
+    read_sequential();
+    read_random();
+    write_collected();
+    write_through();
+
+    unlink(FILE_NAME);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void read_sequential(void)
+{
+    lv_test_print("");
+    lv_test_print("Read sequentially through the cache:");
+    lv_test_print("------------------------------------");
+
+    file_create();
+
+    static uint8_t buf_plain[FILE_SIZE];
+    static uint8_t buf_cached[FILE_SIZE];
+    uint32_t br_plain = 0;
+    uint32_t br_cached = 0;
+    uint32_t br;
+    lv_fs_file_t f_plain;
+    lv_fs_file_t f_cached;
+    lv_fs_open(&f_plain, "P:" FILE_NAME, LV_FS_MODE_RD);
+    lv_fs_open(&f_cached, "C:" FILE_NAME, LV_FS_MODE_RD);
+    lv_test_assert_true(f_cached.cache != NULL, "The file has cache");
+
+    _lv_memset_00(&cnt_plain, sizeof(cnt_plain));
+    _lv_memset_00(&cnt_cached, sizeof(cnt_cached));
+
+    /*Small reads like the font loader and the image decoders do*/
+    do {
+        lv_fs_read(&f_plain, buf_plain + br_plain, 10, &br);
+        br_plain += br;
+    } while(br > 0 && br_plain < FILE_SIZE);
+
+    do {
+        lv_fs_read(&f_cached, buf_cached + br_cached, 10, &br);
+        br_cached += br;
+    } while(br > 0 && br_cached < FILE_SIZE);
+
+    uint32_t pos;
+    lv_fs_tell(&f_cached, &pos);
+    lv_test_assert_int_eq(FILE_SIZE, pos, "Position after the end");
+    lv_fs_read(&f_cached, buf_cached, 10, &br);
+    lv_test_assert_int_eq(0, br, "No more bytes at the end");
+
+    lv_fs_close(&f_plain);
+    lv_fs_close(&f_cached);
+
+    lv_test_assert_int_eq(FILE_SIZE, br_cached, "Bytes read through the cache");
+    lv_test_assert_array_eq(buf_plain, buf_cached, FILE_SIZE, "Same content with and without cache");
+
+    /*The blocks are read by 1, 2, 4, 4... at once: 0 | 1-2 | 3-6 | 7-10 | 11-14 | 15*/
+    lv_test_assert_int_eq(100, cnt_plain.read, "Reads without cache");
+    lv_test_assert_int_eq(6, cnt_cached.read, "Reads with read-ahead");
+    lv_test_assert_int_eq(1, cnt_cached.seek, "Seeks with read-ahead");
+
+    /*Large reads go around the cache*/
+    lv_fs_open(&f_cached, "C:" FILE_NAME, LV_FS_MODE_RD);
+    _lv_memset_00(&cnt_cached, sizeof(cnt_cached));
+    lv_fs_read(&f_cached, buf_cached, 3, &br);
+    lv_fs_seek(&f_cached, BLOCK_SIZE);
+    lv_fs_read(&f_cached, buf_cached, FILE_SIZE, &br);
+    lv_fs_close(&f_cached);
+
+    lv_test_assert_int_eq(FILE_SIZE - BLOCK_SIZE, br, "Bytes read at once");
+    lv_test_assert_array_eq(buf_plain + BLOCK_SIZE, buf_cached, br, "Content read at once");
+    lv_test_assert_int_eq(2, cnt_cached.read, "Reads of a block and the rest at once");
+}
+
+static void read_random(void)
+{
+    lv_test_print("");
+    lv_test_print("Read randomly through the cache:");
+    lv_test_print("--------------------------------");
+
+    file_create();
+
+    /*Spread in the blocks 0, 2, 7 and 12*/
+    static const uint16_t pos_list[] = {470, 10, 130, 20, 780, 140, 480, 0, 790, 135, 4, 490};
+
+    lv_fs_file_t f;
+    lv_fs_open(&f, "C:" FILE_NAME, LV_FS_MODE_RD);
+    _lv_memset_00(&cnt_cached, sizeof(cnt_cached));
+
+    uint32_t mismatch = 0;
+    uint32_t i;
+    for(i = 0; i < sizeof(pos_list) / sizeof(pos_list[0]); i++) {
+        uint8_t buf[16];
+        uint32_t br;
+        lv_fs_seek(&f, pos_list[i]);
+        lv_fs_read(&f, buf, sizeof(buf), &br);
+
+        uint32_t exp_br = FILE_SIZE - pos_list[i];
+        if(exp_br > sizeof(buf)) exp_br = sizeof(buf);
+        if(br != exp_br) mismatch++;
+        uint32_t j;
+        for(j = 0; j < br; j++) {
+            if(buf[j] != pattern(pos_list[i] + j)) mismatch++;
+        }
+    }
+
+    lv_fs_close(&f);
+
+    lv_test_assert_int_eq(0, mismatch, "Content read at random positions");
+    lv_test_assert_int_eq(4, cnt_cached.read, "Every block is read once");
+    lv_test_assert_int_eq(4, cnt_cached.seek, "Seeks only to read a block");
+}
+
+static void write_collected(void)
+{
+    lv_test_print("");
+    lv_test_print("Collect the writes in the cache:");
+    lv_test_print("--------------------------------");
+
+    unlink(FILE_NAME);
+
+    lv_fs_file_t f;
+    lv_fs_res_t res = lv_fs_open(&f, "W:" FILE_NAME, LV_FS_MODE_WR | LV_FS_MODE_RD);
+    lv_test_assert_int_eq(LV_FS_RES_OK, res, "Open for writing");
+    _lv_memset_00(&cnt_write, sizeof(cnt_write));
+
+    /*Write in small pieces*/
+    uint32_t pos;
+    for(pos = 0; pos < FILE_SIZE; pos += 8) {
+        uint8_t buf[8];
+        uint32_t j;
+        for(j = 0; j < sizeof(buf); j++) buf[j] = pattern(pos + j);
+        uint32_t bw;
+        lv_fs_write(&f, buf, LV_MATH_MIN((uint32_t)sizeof(buf), FILE_SIZE - pos), &bw);
+    }
+
+    /*Read back the not written out end and overwrite a part in the middle*/
+    uint8_t buf[16];
+    uint32_t br;
+    lv_fs_seek(&f, FILE_SIZE - 8);
+    lv_fs_read(&f, buf, sizeof(buf), &br);
+    lv_test_assert_int_eq(8, br, "Bytes read back before the end");
+    lv_test_assert_int_eq(pattern(FILE_SIZE - 1), buf[7], "Last byte read back");
+
+    static const uint8_t mark[] = {0xAA, 0xBB, 0xCC};
+    lv_fs_seek(&f, 300);
+    lv_fs_write(&f, mark, sizeof(mark), NULL);
+
+    uint32_t size;
+    lv_fs_size(&f, &size);
+    lv_test_assert_int_eq(FILE_SIZE, size, "Size with collected writes");
+
+    lv_fs_close(&f);
+
+    lv_test_assert_int_lt(FILE_SIZE / 8 / 4, cnt_write.write, "Writes are collected in the blocks");
+
+    /*Check the file on the disk*/
+    static uint8_t disk[FILE_SIZE + 1];
+    int fd = open(FILE_NAME, O_RDONLY);
+    ssize_t disk_size = read(fd, disk, sizeof(disk));
+    close(fd);
+    lv_test_assert_int_eq(FILE_SIZE, disk_size, "Size on the disk");
+
+    uint32_t mismatch = 0;
+    for(pos = 0; pos < FILE_SIZE; pos++) {
+        uint8_t exp = pos >= 300 && pos < 300 + sizeof(mark) ? mark[pos - 300] : pattern(pos);
+        if(disk[pos] != exp) mismatch++;
+    }
+    lv_test_assert_int_eq(0, mismatch, "Content on the disk");
+}
+
+static void write_through(void)
+{
+    lv_test_print("");
+    lv_test_print("Write through the cache:");
+    lv_test_print("------------------------");
+
+    file_create();
+
+    lv_fs_file_t f;
+    lv_fs_open(&f, "C:" FILE_NAME, LV_FS_MODE_WR | LV_FS_MODE_RD);
+
+    /*Cache the block, change it and extend the file after the end*/
+    uint8_t buf[8];
+    uint32_t br;
+    lv_fs_seek(&f, 200);
+    lv_fs_read(&f, buf, sizeof(buf), &br);
+    lv_fs_seek(&f, FILE_SIZE - 2);
+    lv_fs_read(&f, buf, sizeof(buf), &br);
+    lv_test_assert_int_eq(2, br, "Bytes at the end");
+
+    static const uint8_t mark[] = {0x11, 0x22, 0x33, 0x44};
+    lv_fs_seek(&f, 202);
+    lv_fs_write(&f, mark, sizeof(mark), NULL);
+    lv_fs_seek(&f, FILE_SIZE);
+    lv_fs_write(&f, mark, sizeof(mark), NULL);
+
+    lv_fs_seek(&f, 200);
+    lv_fs_read(&f, buf, sizeof(buf), &br);
+    lv_test_assert_int_eq(mark[0], buf[2], "Written byte read back");
+    lv_test_assert_int_eq(pattern(206), buf[6], "Not written byte read back");
+
+    lv_fs_seek(&f, FILE_SIZE - 2);
+    lv_fs_read(&f, buf, sizeof(buf), &br);
+    lv_test_assert_int_eq(2 + sizeof(mark), br, "Bytes at the extended end");
+    lv_test_assert_int_eq(mark[3], buf[5], "Last byte of the extended file");
+
+    /*Truncate in a cached block*/
+    lv_fs_seek(&f, 500);
+    lv_fs_trunc(&f);
+    lv_fs_seek(&f, 490);
+    lv_fs_read(&f, buf, sizeof(buf), &br);
+    lv_test_assert_int_eq(sizeof(buf), br, "Bytes before the truncated end");
+    lv_fs_read(&f, buf, sizeof(buf), &br);
+    lv_test_assert_int_eq(2, br, "Bytes at the truncated end");
+
+    lv_fs_close(&f);
+}
+
+static void drv_init(char letter, uint8_t block_cnt, bool cache_write)
+{
+    lv_fs_drv_t drv;
+    lv_fs_drv_init(&drv);
+
+    drv.letter = letter;
+    drv.file_size = sizeof(int);
+    drv.cache_block_size = BLOCK_SIZE;
+    drv.cache_block_cnt = block_cnt;
+    drv.cache_write = cache_write;
+    drv.open_cb = open_cb;
+    drv.close_cb = close_cb;
+    drv.read_cb = read_cb;
+    drv.write_cb = write_cb;
+    drv.seek_cb = seek_cb;
+    drv.tell_cb = tell_cb;
+    drv.size_cb = size_cb;
+    drv.trunc_cb = trunc_cb;
+
+    lv_fs_drv_register(&drv);
+}
+
+static void file_create(void)
+{
+    static uint8_t buf[FILE_SIZE];
+    uint32_t i;
+    for(i = 0; i < FILE_SIZE; i++) buf[i] = pattern(i);
+
+    int fd = open(FILE_NAME, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(write(fd, buf, FILE_SIZE) != FILE_SIZE) lv_test_error("Can't create " FILE_NAME);
+    close(fd);
+}
+
+static uint8_t pattern(uint32_t pos)
+{
+    return (pos * 7 + pos / 256) & 0xFF;
+}
+
+static io_cnt_t * io_cnt(lv_fs_drv_t * drv)
+{
+    if(drv->letter == 'C') return &cnt_cached;
+    if(drv->letter == 'W') return &cnt_write;
+    return &cnt_plain;
+}
+
+static lv_fs_res_t open_cb(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+
+    int flags = mode == LV_FS_MODE_RD ? O_RDONLY : mode == LV_FS_MODE_WR ? O_WRONLY | O_CREAT : O_RDWR | O_CREAT;
+    int fd = open(path, flags, 0644);
+    *((int *)file_p) = fd;
+    return fd < 0 ? LV_FS_RES_NOT_EX : LV_FS_RES_OK;
+}
+
+static lv_fs_res_t close_cb(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+
+    close(*((int *)file_p));
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t read_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    io_cnt(drv)->read++;
+    ssize_t n = read(*((int *)file_p), buf, btr);
+    *br = n > 0 ? n : 0;
+    return n < 0 ? LV_FS_RES_HW_ERR : LV_FS_RES_OK;
+}
+
+static lv_fs_res_t write_cb(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw)
+{
+    io_cnt(drv)->write++;
+    ssize_t n = write(*((int *)file_p), buf, btw);
+    *bw = n > 0 ? n : 0;
+    return n < 0 ? LV_FS_RES_HW_ERR : LV_FS_RES_OK;
+}
+
+static lv_fs_res_t seek_cb(lv_fs_drv_t * drv, void * file_p, uint32_t pos)
+{
+    io_cnt(drv)->seek++;
+    return lseek(*((int *)file_p), pos, SEEK_SET) < 0 ? LV_FS_RES_HW_ERR : LV_FS_RES_OK;
+}
+
+static lv_fs_res_t tell_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+
+    *pos_p = lseek(*((int *)file_p), 0, SEEK_CUR);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t size_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p)
+{
+    LV_UNUSED(drv);
+
+    struct stat st;
+    if(fstat(*((int *)file_p), &st) != 0) return LV_FS_RES_HW_ERR;
+    *size_p = st.st_size;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t trunc_cb(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+
+    int fd = *((int *)file_p);
+    return ftruncate(fd, lseek(fd, 0, SEEK_CUR)) != 0 ? LV_FS_RES_HW_ERR : LV_FS_RES_OK;
+}
+
+#endif
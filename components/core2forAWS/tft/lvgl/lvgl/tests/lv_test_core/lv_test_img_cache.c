@@ -0,0 +1,322 @@
+/**
+ * @file lv_test_img_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_img_cache.h"
+
+#if LV_BUILD_TEST && LV_IMG_CACHE_DEF_SIZE
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define IMG_NUM     10
+#define IMG_W       16
+#define IMG_H       16
+#define IMG_SIZE    (IMG_W * IMG_H * LV_COLOR_SIZE / 8)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void hit_rate(void);
+static void lru_order(void);
+static void byte_capacity(void);
+static void admission(void);
+static void hit_latency(void);
+static void decoder_init(void);
+static void decoder_deinit(void);
+static lv_res_t test_decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
+static lv_res_t test_decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+static void test_decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+static const char * img_src(uint32_t id);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_img_decoder_t * test_decoder;
+static uint32_t open_cnt[IMG_NUM];
+static uint32_t open_cost[IMG_NUM];     /*`time_to_open` reported by the test decoder*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_img_cache(void)
+{
+    lv_test_print("");
+    lv_test_print("========================");
+    lv_test_print("Start lv_img_cache tests");
+    lv_test_print("========================");
+
+    decoder_init();
+
+    hit_rate();
+    lru_order();
+    byte_capacity();
+    admission();
+    hit_latency();
+
+    decoder_deinit();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void hit_rate(void)
+{
+    lv_test_print("");
+    lv_test_print("Open the same images repeatedly:");
+    lv_test_print("--------------------------------");
+
+    decoder_init();
+    lv_img_cache_set_size(4);
+
+    uint32_t r;
+    uint32_t i;
+    bool open_ok = true;
+    for(r = 0; r < 100; r++) {
+        for(i = 0; i < 4; i++) {
+            lv_img_cache_entry_t * e = _lv_img_cache_open(img_src(i), LV_COLOR_BLACK);
+            if(e == NULL || e->dec_dsc.img_data == NULL) open_ok = false;
+        }
+    }
+    lv_test_assert_true(open_ok, "The images are opened");
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    lv_test_assert_int_eq(4, stats.misses, "Misses");
+    lv_test_assert_int_eq(396, stats.hits, "Hits");
+    lv_test_assert_int_eq(4, stats.entries, "Cached images");
+    lv_test_assert_int_eq(4 * IMG_SIZE, stats.data_size, "Cached data size");
+    for(i = 0; i < 4; i++) lv_test_assert_int_eq(1, open_cnt[i], "Every image is opened once");
+
+    /*The color is part of the key*/
+    _lv_img_cache_open(img_src(0), LV_COLOR_RED);
+    lv_test_assert_int_eq(2, open_cnt[0], "Opened again with an other color");
+
+    lv_img_cache_invalidate_src(img_src(1));
+    _lv_img_cache_open(img_src(1), LV_COLOR_BLACK);
+    lv_test_assert_int_eq(2, open_cnt[1], "Opened again after invalidate");
+}
+
+static void lru_order(void)
+{
+    lv_test_print("");
+    lv_test_print("Evict the least recently used image:");
+    lv_test_print("------------------------------------");
+
+    decoder_init();
+    lv_img_cache_set_size(4);
+
+    uint32_t i;
+    for(i = 0; i < 4; i++) _lv_img_cache_open(img_src(i), LV_COLOR_BLACK);
+
+    /*Use the oldest image again, so the 2nd one becomes the least recently used*/
+    _lv_img_cache_open(img_src(0), LV_COLOR_BLACK);
+    _lv_img_cache_open(img_src(4), LV_COLOR_BLACK);
+
+    _lv_img_cache_open(img_src(0), LV_COLOR_BLACK);
+    lv_test_assert_int_eq(1, open_cnt[0], "The recently used image is kept");
+    _lv_img_cache_open(img_src(2), LV_COLOR_BLACK);
+    lv_test_assert_int_eq(1, open_cnt[2], "The 3rd image is kept");
+    _lv_img_cache_open(img_src(1), LV_COLOR_BLACK);
+    lv_test_assert_int_eq(2, open_cnt[1], "The least recently used image is evicted");
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    lv_test_assert_int_eq(2, stats.evictions, "Evictions");
+    lv_test_assert_int_eq(4, stats.entries, "Cached images");
+}
+
+static void byte_capacity(void)
+{
+    lv_test_print("");
+    lv_test_print("Limit the size of the decoded data:");
+    lv_test_print("-----------------------------------");
+
+    decoder_init();
+    lv_img_cache_set_size(8);
+    lv_img_cache_set_capacity(3 * IMG_SIZE + IMG_SIZE / 2);
+
+    uint32_t i;
+    for(i = 0; i < 6; i++) _lv_img_cache_open(img_src(i), LV_COLOR_BLACK);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    lv_test_assert_int_eq(3, stats.entries, "Cached images in the capacity");
+    lv_test_assert_int_eq(3 * IMG_SIZE, stats.data_size, "Cached data size");
+
+    lv_img_cache_set_capacity(IMG_SIZE);
+    lv_img_cache_get_stats(&stats);
+    lv_test_assert_int_eq(1, stats.entries, "Cached images after shrinking the capacity");
+
+    _lv_img_cache_open(img_src(5), LV_COLOR_BLACK);
+    lv_test_assert_int_eq(1, open_cnt[5], "The most recently used image is kept");
+
+    lv_img_cache_set_capacity(LV_IMG_CACHE_DEF_BYTES);
+}
+
+static void admission(void)
+{
+    lv_test_print("");
+    lv_test_print("Keep the images which are slow to open:");
+    lv_test_print("---------------------------------------");
+
+    decoder_init();
+    lv_img_cache_set_size(2);
+    open_cost[0] = 40;
+    open_cost[1] = 40;
+
+    _lv_img_cache_open(img_src(0), LV_COLOR_BLACK);
+    _lv_img_cache_open(img_src(1), LV_COLOR_BLACK);
+
+    /*Cheap images are opened only temporarily until the slow ones age*/
+    uint32_t i;
+    bool open_ok = true;
+    for(i = 0; i < 20; i++) {
+        lv_img_cache_entry_t * e = _lv_img_cache_open(img_src(2 + i % 4), LV_COLOR_BLACK);
+        if(e == NULL || e->dec_dsc.img_data == NULL) open_ok = false;
+    }
+    lv_test_assert_true(open_ok, "The cheap images are opened");
+
+    _lv_img_cache_open(img_src(0), LV_COLOR_BLACK);
+    _lv_img_cache_open(img_src(1), LV_COLOR_BLACK);
+    lv_test_assert_int_eq(1, open_cnt[0], "The 1st slow image is kept");
+    lv_test_assert_int_eq(1, open_cnt[1], "The 2nd slow image is kept");
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    lv_test_assert_int_eq(20, stats.rejections, "Rejected images");
+    lv_test_assert_int_eq(0, stats.evictions, "Evictions");
+
+    /*Once they aged enough the cheap images are cached*/
+    for(i = 0; i < 100; i++) _lv_img_cache_open(img_src(2 + i % 4), LV_COLOR_BLACK);
+    lv_img_cache_get_stats(&stats);
+    lv_test_assert_int_gt(0, stats.evictions, "The slow images are evicted after aging");
+}
+
+static void hit_latency(void)
+{
+    lv_test_print("");
+    lv_test_print("Latency of cache hits:");
+    lv_test_print("----------------------");
+
+    /*Find how many images fit into the memory pool*/
+    decoder_init();
+    lv_img_cache_set_size(IMG_NUM);
+
+    uint32_t i;
+    for(i = 0; i < IMG_NUM; i++) _lv_img_cache_open(img_src(i), LV_COLOR_BLACK);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    uint32_t img_num = stats.entries;
+    lv_test_assert_int_gt(0, img_num, "Cached images");
+
+    /*Cache only the images that fit and look up only them*/
+    decoder_init();
+    lv_img_cache_set_size(img_num);
+    for(i = 0; i < img_num; i++) _lv_img_cache_open(img_src(i), LV_COLOR_BLACK);
+    lv_img_cache_reset_stats();
+
+    uint32_t round_num = 100000;
+    clock_t t = clock();
+    for(i = 0; i < round_num; i++) _lv_img_cache_open(img_src(i % img_num), LV_COLOR_BLACK);
+    t = clock() - t;
+
+    lv_img_cache_get_stats(&stats);
+    lv_test_assert_int_eq(round_num, stats.hits, "Every lookup is a hit");
+    lv_test_print("%d ns per hit with %d images", (int)((uint64_t)t * 1000000000 / CLOCKS_PER_SEC / round_num),
+                  (int)img_num);
+}
+
+/**
+ * Register the test decoder or reset it and the cache between the tests
+ */
+static void decoder_init(void)
+{
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    lv_img_cache_reset_stats();
+
+    uint32_t i;
+    for(i = 0; i < IMG_NUM; i++) {
+        open_cnt[i] = 0;
+        open_cost[i] = 1;
+    }
+
+    if(test_decoder) return;
+
+    test_decoder = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(test_decoder, test_decoder_info);
+    lv_img_decoder_set_open_cb(test_decoder, test_decoder_open);
+    lv_img_decoder_set_close_cb(test_decoder, test_decoder_close);
+}
+
+static void decoder_deinit(void)
+{
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+    lv_img_decoder_delete(test_decoder);
+    test_decoder = NULL;
+}
+
+/**
+ * Accept the "T:img<id>" files
+ */
+static lv_res_t test_decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(decoder);
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return LV_RES_INV;
+    if(strncmp(src, "T:img", 5) != 0) return LV_RES_INV;
+
+    header->w = IMG_W;
+    header->h = IMG_H;
+    header->cf = LV_IMG_CF_TRUE_COLOR;
+    return LV_RES_OK;
+}
+
+/**
+ * Allocate the decoded image like a PNG or JPG decoder
+ */
+static lv_res_t test_decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    uint32_t id = ((const char *)dsc->src)[5] - '0';
+    dsc->img_data = lv_mem_alloc(IMG_SIZE);
+    if(dsc->img_data == NULL) return LV_RES_INV;
+
+    dsc->time_to_open = open_cost[id];
+    open_cnt[id]++;
+    return LV_RES_OK;
+}
+
+static void test_decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    lv_mem_free(dsc->img_data);
+    dsc->img_data = NULL;
+}
+
+static const char * img_src(uint32_t id)
+{
+    static const char * srcs[IMG_NUM] = {"T:img0", "T:img1", "T:img2", "T:img3", "T:img4",
+                                         "T:img5", "T:img6", "T:img7", "T:img8", "T:img9"
+                                        };
+    return srcs[id];
+}
+
+#endif
@@ -0,0 +1,384 @@
+/**
+ * @file lv_test_indev.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_indev.h"
+
+#if LV_BUILD_TEST
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define OBJ_NUM     40
+#define ROUND_NUM   300
+#define POINT_NUM   40
+#define SCR_NUM     5
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void random_ui(void);
+static void screens(void);
+static void search_latency(void);
+static void create_random_obj(lv_obj_t * scr);
+static void change_random_obj(lv_obj_t * scr, uint32_t max_cnt);
+static bool search_random_points(lv_obj_t * scr);
+static uint32_t collect_objs(lv_obj_t * obj, lv_obj_t ** objs, uint32_t cnt);
+static lv_res_t knob_signal(lv_obj_t * obj, lv_signal_t sign, void * param);
+static lv_obj_t * ref_search_obj(lv_obj_t * obj, lv_point_t * point);
+static uint32_t rnd(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t rnd_seed = 1;
+static lv_signal_cb_t ancestor_signal;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_indev(void)
+{
+    lv_test_print("");
+    lv_test_print("====================");
+    lv_test_print("Start lv_indev tests");
+    lv_test_print("====================");
+
+    random_ui();
+    screens();
+    search_latency();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void random_ui(void)
+{
+    lv_test_print("");
+    lv_test_print("Search the pressed object on a changing screen:");
+    lv_test_print("-----------------------------------------------");
+
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+
+    uint32_t i;
+    for(i = 0; i < OBJ_NUM; i++) create_random_obj(scr);
+
+    bool search_ok = search_random_points(scr);
+    lv_test_assert_true(search_ok, "Same object as the tree walk");
+
+    search_ok = true;
+    uint32_t r;
+    for(r = 0; r < ROUND_NUM; r++) {
+        /*Change more objects at once sometimes*/
+        uint32_t change_cnt = rnd() % 4 == 0 ? rnd() % 5 + 1 : 1;
+        for(i = 0; i < change_cnt; i++) change_random_obj(scr, OBJ_NUM);
+
+        if(search_random_points(scr) == false) search_ok = false;
+    }
+    lv_test_assert_true(search_ok, "Same object as the tree walk after the changes");
+
+    lv_obj_del(scr);
+}
+
+static void screens(void)
+{
+    lv_test_print("");
+    lv_test_print("Search on more screens than the grids:");
+    lv_test_print("--------------------------------------");
+
+    lv_obj_t * scrs[SCR_NUM];
+    uint32_t i;
+    uint32_t s;
+    for(s = 0; s < SCR_NUM; s++) {
+        scrs[s] = lv_obj_create(NULL, NULL);
+        for(i = 0; i < OBJ_NUM / 5; i++) create_random_obj(scrs[s]);
+    }
+
+    bool search_ok = true;
+    uint32_t r;
+    for(r = 0; r < ROUND_NUM / 4; r++) {
+        s = rnd() % SCR_NUM;
+        if(rnd() % 2) change_random_obj(scrs[s], OBJ_NUM / 4);
+        if(rnd() % 8 == 0) {
+            lv_obj_del(scrs[s]);
+            scrs[s] = lv_obj_create(NULL, NULL);
+            for(i = 0; i < OBJ_NUM / 5; i++) create_random_obj(scrs[s]);
+        }
+
+        if(search_random_points(scrs[s]) == false) search_ok = false;
+    }
+    lv_test_assert_true(search_ok, "Same object as the tree walk");
+
+    for(s = 0; s < SCR_NUM; s++) lv_obj_del(scrs[s]);
+}
+
+static void search_latency(void)
+{
+    lv_test_print("");
+    lv_test_print("Latency of searching on a keyboard-like screen:");
+    lv_test_print("-----------------------------------------------");
+
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_coord_t w = lv_obj_get_width(scr);
+    lv_coord_t h = lv_obj_get_height(scr);
+
+    /*Rows of keys in a container below a clickable background*/
+    lv_obj_t * bg = lv_obj_create(scr, NULL);
+    lv_obj_set_size(bg, w, h);
+    lv_obj_t * cont = lv_obj_create(scr, NULL);
+    lv_obj_set_size(cont, w, h / 2);
+    lv_obj_set_pos(cont, 0, h / 2);
+    lv_obj_set_click(cont, false);
+
+    uint32_t row;
+    uint32_t col;
+    uint32_t obj_cnt = 2;
+    for(row = 0; row < 5; row++) {
+        lv_obj_t * row_obj = lv_obj_create(cont, NULL);
+        lv_obj_set_size(row_obj, w, h / 10);
+        lv_obj_set_pos(row_obj, 0, row * h / 10);
+        lv_obj_set_click(row_obj, false);
+        obj_cnt++;
+        for(col = 0; col < 12; col++) {
+            lv_obj_t * key = lv_obj_create(row_obj, NULL);
+            lv_obj_set_size(key, w / 12 - 4, h / 10 - 4);
+            lv_obj_set_pos(key, col * w / 12 + 2, 2);
+            obj_cnt++;
+        }
+    }
+
+    lv_point_t points[64];
+    uint32_t i;
+    for(i = 0; i < 64; i++) {
+        points[i].x = rnd() % w;
+        points[i].y = rnd() % h;
+    }
+
+    uint32_t round_num = 50000;
+    bool search_ok = true;
+    clock_t t_ref = clock();
+    for(i = 0; i < round_num; i++) {
+        if(ref_search_obj(scr, &points[i % 64]) == NULL) search_ok = false;
+    }
+    t_ref = clock() - t_ref;
+
+    clock_t t = clock();
+    for(i = 0; i < round_num; i++) {
+        if(lv_indev_search_obj(scr, &points[i % 64]) == NULL) search_ok = false;
+    }
+    t = clock() - t;
+
+    lv_test_assert_true(search_ok, "An object is found everywhere");
+    lv_test_print("%d ns per search with %d objects (tree walk: %d ns)",
+                  (int)((uint64_t)t * 1000000000 / CLOCKS_PER_SEC / round_num), (int)obj_cnt,
+                  (int)((uint64_t)t_ref * 1000000000 / CLOCKS_PER_SEC / round_num));
+
+    lv_obj_del(scr);
+}
+
+/**
+ * Create an object with random position, size and click settings on a random parent
+ */
+static void create_random_obj(lv_obj_t * scr)
+{
+    lv_obj_t * objs[OBJ_NUM * 2];
+    uint32_t cnt = collect_objs(scr, objs, 0);
+
+    /*Prefer the screen as parent to have more overlapping siblings*/
+    lv_obj_t * par = rnd() % 3 == 0 ? scr : objs[rnd() % cnt];
+    lv_obj_t * obj = lv_obj_create(par, NULL);
+
+    lv_coord_t w = lv_obj_get_width(scr);
+    lv_coord_t h = lv_obj_get_height(scr);
+    lv_obj_set_pos(obj, (lv_coord_t)(rnd() % w) - w / 4, (lv_coord_t)(rnd() % h) - h / 4);
+    lv_obj_set_size(obj, rnd() % (w / 2) + 1, rnd() % (h / 2) + 1);
+
+    if(rnd() % 4 == 0) lv_obj_set_click(obj, false);
+    if(rnd() % 10 == 0) lv_obj_set_hidden(obj, true);
+    if(rnd() % 4 == 0) lv_obj_set_ext_click_area(obj, rnd() % 20, rnd() % 20, rnd() % 20, rnd() % 20);
+    if(rnd() % 8 == 0) lv_obj_add_state(obj, LV_STATE_DISABLED);
+    if(rnd() % 4 == 0) lv_obj_add_protect(obj, LV_PROTECT_EVENT_TO_DISABLED);
+    if(rnd() % 10 == 0) {
+        ancestor_signal = lv_obj_get_signal_cb(obj);
+        lv_obj_set_signal_cb(obj, knob_signal);
+        lv_obj_set_adv_hittest(obj, true);
+    }
+}
+
+/**
+ * Change a random object of a screen in a way which affects the searching
+ * @param max_cnt create new objects only up to this many objects
+ */
+static void change_random_obj(lv_obj_t * scr, uint32_t max_cnt)
+{
+    lv_obj_t * objs[OBJ_NUM * 2];
+    uint32_t cnt = collect_objs(scr, objs, 0);
+    if(cnt < 2) {
+        create_random_obj(scr);
+        return;
+    }
+
+    /*Don't change the screen itself*/
+    lv_obj_t * obj = objs[rnd() % (cnt - 1) + 1];
+    lv_coord_t w = lv_obj_get_width(scr);
+    lv_coord_t h = lv_obj_get_height(scr);
+
+    switch(rnd() % 11) {
+        case 0:
+            lv_obj_set_pos(obj, (lv_coord_t)(rnd() % w) - w / 4, (lv_coord_t)(rnd() % h) - h / 4);
+            break;
+        case 1:
+            lv_obj_set_size(obj, rnd() % (w / 2) + 1, rnd() % (h / 2) + 1);
+            break;
+        case 2:
+            lv_obj_set_hidden(obj, !lv_obj_get_hidden(obj));
+            break;
+        case 3:
+            lv_obj_move_foreground(obj);
+            break;
+        case 4:
+            lv_obj_move_background(obj);
+            break;
+        case 5: {
+                /*The new parent can't be a child of the object*/
+                lv_obj_t * par = objs[rnd() % cnt];
+                lv_obj_t * i = par;
+                while(i && i != obj) i = lv_obj_get_parent(i);
+                if(i == NULL) lv_obj_set_parent(obj, par);
+            }
+            break;
+        case 6:
+            lv_obj_del(obj);
+            create_random_obj(scr);
+            break;
+        case 7:
+            lv_obj_set_click(obj, !lv_obj_get_click(obj));
+            break;
+        case 8:
+            lv_obj_set_ext_click_area(obj, rnd() % 20, rnd() % 20, rnd() % 20, rnd() % 20);
+            break;
+        case 9:
+            if(lv_obj_get_state(obj, LV_OBJ_PART_MAIN) & LV_STATE_DISABLED) lv_obj_clear_state(obj, LV_STATE_DISABLED);
+            else lv_obj_add_state(obj, LV_STATE_DISABLED);
+            break;
+        case 10:
+            if(cnt < max_cnt) create_random_obj(scr);
+            break;
+    }
+}
+
+/**
+ * Compare `lv_indev_search_obj()` with the tree walk on random points, also a little out of the screen
+ * @return true: the same objects were found
+ */
+static bool search_random_points(lv_obj_t * scr)
+{
+    lv_coord_t w = lv_obj_get_width(scr);
+    lv_coord_t h = lv_obj_get_height(scr);
+
+    bool ok = true;
+    uint32_t i;
+    for(i = 0; i < POINT_NUM; i++) {
+        lv_point_t p;
+        p.x = (lv_coord_t)(rnd() % (w + 20)) - 10;
+        p.y = (lv_coord_t)(rnd() % (h + 20)) - 10;
+        if(lv_indev_search_obj(scr, &p) != ref_search_obj(scr, &p)) ok = false;
+    }
+
+    return ok;
+}
+
+/**
+ * Collect an object and all its children in the order of the tree walk
+ */
+static uint32_t collect_objs(lv_obj_t * obj, lv_obj_t ** objs, uint32_t cnt)
+{
+    if(cnt < OBJ_NUM * 2) objs[cnt++] = obj;
+
+    lv_obj_t * child;
+    _LV_LL_READ(obj->child_ll, child) {
+        cnt = collect_objs(child, objs, cnt);
+    }
+
+    return cnt;
+}
+
+/**
+ * Hit-test like a slider knob which is larger than the object
+ */
+static lv_res_t knob_signal(lv_obj_t * obj, lv_signal_t sign, void * param)
+{
+    if(sign == LV_SIGNAL_HIT_TEST) {
+        lv_hit_test_info_t * info = param;
+        lv_area_t knob;
+        lv_obj_get_coords(obj, &knob);
+        knob.x1 = knob.x2 - 10;
+        knob.x2 += 10;
+        knob.y1 -= 10;
+        knob.y2 += 10;
+        info->result = _lv_area_is_point_on(&knob, info->point, 0);
+        return LV_RES_OK;
+    }
+
+    return ancestor_signal(obj, sign, param);
+}
+
+/**
+ * Search the most top, clickable object by walking all the objects like `lv_indev_search_obj` used to
+ */
+static lv_obj_t * ref_search_obj(lv_obj_t * obj, lv_point_t * point)
+{
+    lv_obj_t * found_p = NULL;
+
+    if(lv_obj_hittest(obj, point)) {
+        lv_obj_t * i;
+        _LV_LL_READ(obj->child_ll, i) {
+            found_p = ref_search_obj(i, point);
+            if(found_p != NULL) break;
+        }
+
+        if(found_p == NULL && lv_obj_get_click(obj) != false) {
+            lv_obj_t * hidden_i = obj;
+            while(hidden_i != NULL) {
+                if(lv_obj_get_hidden(hidden_i) == true) break;
+                hidden_i = lv_obj_get_parent(hidden_i);
+            }
+            if(lv_obj_is_protected(obj, LV_PROTECT_EVENT_TO_DISABLED) == false) {
+                if(hidden_i == NULL && (lv_obj_get_state(obj, LV_OBJ_PART_MAIN) & LV_STATE_DISABLED) == false) found_p = obj;
+            }
+            else {
+                if(hidden_i == NULL) found_p = obj;
+            }
+        }
+    }
+
+    return found_p;
+}
+
+/**
+ * Deterministic pseudo random numbers
+ */
+static uint32_t rnd(void)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return (rnd_seed >> 16) & 0x7FFF;
+}
+
+#endif
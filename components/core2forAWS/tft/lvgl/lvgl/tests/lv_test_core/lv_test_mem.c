@@ -0,0 +1,209 @@
+/**
+ * @file lv_test_mem.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_mem.h"
+
+#if LV_BUILD_TEST && LV_MEM_CUSTOM == 0
+
+/*********************
+ *      DEFINES
+ *********************/
+#define SLOT_NUM    48
+#define ALLOC_SIZE_MAX   300
+#define ROUND_NUM   3000
+#define REALLOC_SIZE_MAX    LV_MATH_MIN(2048, LV_MEM_SIZE / 4)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    uint8_t * p;
+    uint32_t size;
+    uint8_t seed;
+} slot_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void fragment(void);
+static void realloc_keeps_data(void);
+static void fill(slot_t * s);
+static bool check(const slot_t * s, uint32_t size);
+static uint32_t rnd(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static slot_t slots[SLOT_NUM];
+static uint32_t rnd_seed = 1;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_mem(void)
+{
+    lv_test_print("");
+    lv_test_print("==================");
+    lv_test_print("Start lv_mem tests");
+    lv_test_print("==================");
+
+    fragment();
+    realloc_keeps_data();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void fragment(void)
+{
+    lv_test_print("");
+    lv_test_print("Allocate, reallocate and free random sizes:");
+    lv_test_print("-------------------------------------------");
+
+    lv_mem_monitor_t mon_start;
+    lv_mem_defrag();
+    lv_mem_monitor(&mon_start);
+
+    uint32_t r;
+    bool data_ok = true;
+    bool pool_ok = true;
+    for(r = 0; r < ROUND_NUM; r++) {
+        slot_t * s = &slots[rnd() % SLOT_NUM];
+        uint32_t action = rnd() % 4;
+        if(s->p && !check(s, s->size)) data_ok = false;
+
+        if(s->p == NULL) {
+            s->size = rnd() % ALLOC_SIZE_MAX + 1;
+            s->p = lv_mem_alloc(s->size);
+            fill(s);
+        }
+        else if(action == 0) {
+            /*The old content has to be kept up to the smaller size*/
+            uint32_t new_size = rnd() % ALLOC_SIZE_MAX + 1;
+            uint8_t * p = lv_mem_realloc(s->p, new_size);
+            if(p) {
+                s->p = p;
+                if(!check(s, LV_MATH_MIN(s->size, new_size))) data_ok = false;
+                s->size = new_size;
+                fill(s);
+            }
+        }
+        else {
+            lv_mem_free(s->p);
+            s->p = NULL;
+        }
+
+        if(r % 64 == 0 && lv_mem_test() != LV_RES_OK) pool_ok = false;
+    }
+
+    lv_test_assert_true(data_ok, "The content of the allocations is kept");
+    lv_test_assert_true(pool_ok, "The pool is consistent");
+
+#if LV_MEM_TLSF && LV_MEM_TLSF_STATS
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    lv_mem_class_stats_t classes[32];
+    uint32_t class_cnt = lv_mem_get_class_stats(classes, 32);
+    uint32_t used_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < class_cnt; i++) used_cnt += classes[i].used_cnt;
+    lv_test_assert_int_eq(mon.used_cnt, used_cnt, "Blocks in use in the size classes");
+#endif
+
+    uint32_t i_slot;
+    for(i_slot = 0; i_slot < SLOT_NUM; i_slot++) {
+        lv_mem_free(slots[i_slot].p);
+        slots[i_slot].p = NULL;
+    }
+
+    lv_mem_monitor_t mon_end;
+    lv_mem_defrag();
+    lv_mem_monitor(&mon_end);
+    lv_test_assert_int_eq(mon_start.free_size, mon_end.free_size, "Free size after freeing everything");
+    lv_test_assert_int_eq(mon_start.free_biggest_size, mon_end.free_biggest_size,
+                          "Biggest free block after freeing everything");
+}
+
+static void realloc_keeps_data(void)
+{
+    lv_test_print("");
+    lv_test_print("Grow and shrink an allocation:");
+    lv_test_print("------------------------------");
+
+    slot_t s = {.seed = 7, .size = 24};
+    s.p = lv_mem_alloc(s.size);
+    lv_test_assert_true(s.p != NULL, "Allocate the block to grow");
+    fill(&s);
+
+    /*Block the growing in place now and then*/
+    uint8_t * blocker = NULL;
+    bool data_ok = true;
+    uint32_t size;
+    for(size = 32; size < REALLOC_SIZE_MAX; size += size / 2) {
+        if(blocker == NULL) blocker = lv_mem_alloc(16);
+        else {
+            lv_mem_free(blocker);
+            blocker = NULL;
+        }
+
+        s.p = lv_mem_realloc(s.p, size);
+        if(s.p == NULL) break;
+        if(!check(&s, s.size)) data_ok = false;
+        s.size = size;
+        fill(&s);
+    }
+
+    lv_test_assert_true(s.p != NULL, "Grow the block");
+
+    s.p = lv_mem_realloc(s.p, 10);
+    lv_test_assert_true(s.p != NULL, "Shrink the block");
+    if(!check(&s, 10)) data_ok = false;
+
+    lv_test_assert_true(data_ok, "The content is kept on realloc");
+    lv_test_assert_int_lt(64, _lv_mem_get_size(s.p), "Size after shrink");
+    lv_test_assert_true(lv_mem_test() == LV_RES_OK, "The pool is consistent");
+
+    lv_mem_free(s.p);
+    lv_mem_free(blocker);
+}
+
+static void fill(slot_t * s)
+{
+    if(s->p == NULL) return;
+
+    s->seed++;
+    uint32_t i;
+    for(i = 0; i < s->size; i++) s->p[i] = (uint8_t)(s->seed * 31 + i);
+}
+
+static bool check(const slot_t * s, uint32_t size)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        if(s->p[i] != (uint8_t)(s->seed * 31 + i)) return false;
+    }
+    return true;
+}
+
+/**
+ * Deterministic pseudo random numbers
+ */
+static uint32_t rnd(void)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return (rnd_seed >> 16) & 0x7FFF;
+}
+#endif
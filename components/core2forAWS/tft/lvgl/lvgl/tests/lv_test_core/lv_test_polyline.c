@@ -0,0 +1,305 @@
+/**
+ * @file lv_test_polyline.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_polyline.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BUF_W       160
+#define BUF_H       60
+#define BUF_X       20      /*Position of the draw buffer on the screen*/
+#define BUF_Y       30
+#define POINT_CNT   40
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void compare_generic(lv_coord_t width, lv_opa_t opa, const char * name);
+static void axis_aligned(void);
+static void fallback(void);
+static void clipped(void);
+static void draw_start(lv_color_t * buf);
+static void draw_end(void);
+static void draw_generic(const lv_point_t * points, uint16_t point_cnt, const lv_area_t * clip,
+                         const lv_draw_line_dsc_t * dsc);
+static void series_create(lv_point_t * points, uint32_t seed);
+static uint32_t ink(lv_color_t c);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t buf_ref[BUF_W * BUF_H];
+static lv_color_t buf_act[BUF_W * BUF_H];
+static lv_area_t buf_area = {BUF_X, BUF_Y, BUF_X + BUF_W - 1, BUF_Y + BUF_H - 1};
+static lv_area_t area_saved;
+static lv_color_t * buf_saved;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_polyline(void)
+{
+    lv_test_print("");
+    lv_test_print("=======================");
+    lv_test_print("Start lv_polyline tests");
+    lv_test_print("=======================");
+
+    compare_generic(1, LV_OPA_COVER, "1 px");
+    compare_generic(2, LV_OPA_COVER, "2 px");
+#if LV_COLOR_DEPTH > 1
+    /*With 1 bit colors 50% opacity leaves the background*/
+    compare_generic(1, LV_OPA_50, "1 px, 50% opacity");
+    compare_generic(2, LV_OPA_50, "2 px, 50% opacity");
+#endif
+    axis_aligned();
+    fallback();
+    clipped();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Draw random series with both renderers and compare the pixels.
+ * They sample the line differently so the pixels aren't the same
+ * but the amount and the place of the ink should be.
+ */
+static void compare_generic(lv_coord_t width, lv_opa_t opa, const char * name)
+{
+    lv_test_print("");
+    lv_test_print("Compare with lv_draw_line, %s:", name);
+    lv_test_print("--------------------------------------------");
+
+    lv_draw_line_dsc_t dsc;
+    lv_draw_line_dsc_init(&dsc);
+    dsc.width = width;
+    dsc.opa = opa;
+    dsc.color = LV_COLOR_BLACK;
+
+    uint32_t sum_diff = 0;
+    uint32_t sum_ink = 0;
+    uint32_t max_ink_diff = 0;
+    uint32_t seed;
+    for(seed = 1; seed <= 8; seed++) {
+        lv_point_t points[POINT_CNT];
+        series_create(points, seed);
+
+        draw_start(buf_ref);
+        draw_generic(points, POINT_CNT, &buf_area, &dsc);
+        draw_end();
+
+        draw_start(buf_act);
+        lv_draw_polyline(points, POINT_CNT, &buf_area, &dsc);
+        draw_end();
+
+        uint32_t ink_ref = 0;
+        uint32_t ink_act = 0;
+        uint32_t i;
+        for(i = 0; i < BUF_W * BUF_H; i++) {
+            uint32_t a = ink(buf_ref[i]);
+            uint32_t b = ink(buf_act[i]);
+            sum_diff += a > b ? a - b : b - a;
+            ink_ref += a;
+            ink_act += b;
+        }
+        sum_ink += ink_ref;
+        uint32_t ink_diff = (ink_ref > ink_act ? ink_ref - ink_act : ink_act - ink_ref) * 100 / ink_ref;
+        if(ink_diff > max_ink_diff) max_ink_diff = ink_diff;
+    }
+
+    lv_test_assert_int_lt(5, max_ink_diff, "Difference of the total ink of a series [%]");
+    lv_test_assert_int_lt(10, sum_diff * 100 / sum_ink, "Sum of the pixel differences per total ink [%]");
+}
+
+/**
+ * Horizontal and vertical lines are drawn the same way by both renderers
+ */
+static void axis_aligned(void)
+{
+    lv_test_print("");
+    lv_test_print("Horizontal and vertical segments:");
+    lv_test_print("---------------------------------");
+
+    static const lv_point_t points[] = {
+        {BUF_X + 5, BUF_Y + 10}, {BUF_X + 30, BUF_Y + 10}, {BUF_X + 30, BUF_Y + 40}, {BUF_X + 60, BUF_Y + 40},
+        {BUF_X + 60, BUF_Y + 4}, {BUF_X + 100, BUF_Y + 4}, {BUF_X + 100, BUF_Y + 50}, {BUF_X + 90, BUF_Y + 50}
+    };
+    uint16_t point_cnt = sizeof(points) / sizeof(points[0]);
+
+    lv_draw_line_dsc_t dsc;
+    lv_draw_line_dsc_init(&dsc);
+    dsc.color = LV_COLOR_RED;
+
+    for(dsc.width = 1; dsc.width <= 2; dsc.width++) {
+        draw_start(buf_ref);
+        draw_generic(points, point_cnt, &buf_area, &dsc);
+        draw_end();
+
+        draw_start(buf_act);
+        lv_draw_polyline(points, point_cnt, &buf_area, &dsc);
+        draw_end();
+
+        lv_test_assert_array_eq((uint8_t *)buf_ref, (uint8_t *)buf_act, sizeof(buf_ref),
+                                dsc.width == 1 ? "Same pixels with 1 px" : "Same pixels with 2 px");
+    }
+}
+
+/**
+ * Wide and dashed lines are drawn by `lv_draw_line()`
+ */
+static void fallback(void)
+{
+    lv_test_print("");
+    lv_test_print("Fall back to lv_draw_line:");
+    lv_test_print("--------------------------");
+
+    lv_point_t points[POINT_CNT];
+    series_create(points, 42);
+
+    lv_draw_line_dsc_t dsc;
+    lv_draw_line_dsc_init(&dsc);
+    dsc.color = LV_COLOR_BLUE;
+    dsc.width = 3;
+
+    draw_start(buf_ref);
+    draw_generic(points, POINT_CNT, &buf_area, &dsc);
+    draw_end();
+    draw_start(buf_act);
+    lv_draw_polyline(points, POINT_CNT, &buf_area, &dsc);
+    draw_end();
+    lv_test_assert_array_eq((uint8_t *)buf_ref, (uint8_t *)buf_act, sizeof(buf_ref), "Same pixels with 3 px");
+
+    dsc.width = 1;
+    dsc.dash_width = 4;
+    dsc.dash_gap = 2;
+
+    draw_start(buf_ref);
+    draw_generic(points, POINT_CNT, &buf_area, &dsc);
+    draw_end();
+    draw_start(buf_act);
+    lv_draw_polyline(points, POINT_CNT, &buf_area, &dsc);
+    draw_end();
+    lv_test_assert_array_eq((uint8_t *)buf_ref, (uint8_t *)buf_act, sizeof(buf_ref), "Same pixels with dashes");
+}
+
+/**
+ * Only the clip area is drawn and it's drawn the same as without clipping
+ */
+static void clipped(void)
+{
+    lv_test_print("");
+    lv_test_print("Clip the polyline:");
+    lv_test_print("------------------");
+
+    lv_point_t points[POINT_CNT];
+    series_create(points, 7);
+
+    lv_draw_line_dsc_t dsc;
+    lv_draw_line_dsc_init(&dsc);
+    dsc.width = 2;
+
+    lv_area_t clip = {BUF_X + 33, BUF_Y + 12, BUF_X + 97, BUF_Y + 41};
+
+    draw_start(buf_ref);
+    lv_draw_polyline(points, POINT_CNT, &buf_area, &dsc);
+    draw_end();
+    draw_start(buf_act);
+    lv_draw_polyline(points, POINT_CNT, &clip, &dsc);
+    draw_end();
+
+    uint32_t in_diff = 0;
+    uint32_t out_drawn = 0;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < BUF_H; y++) {
+        for(x = 0; x < BUF_W; x++) {
+            uint32_t i = y * BUF_W + x;
+            lv_point_t p = {x + BUF_X, y + BUF_Y};
+            if(_lv_area_is_point_on(&clip, &p, 0)) {
+                if(buf_act[i].full != buf_ref[i].full) in_diff++;
+            }
+            else if(buf_act[i].full != LV_COLOR_WHITE.full) {
+                out_drawn++;
+            }
+        }
+    }
+
+    lv_test_assert_int_eq(0, in_diff, "Different pixels in the clip area");
+    lv_test_assert_int_eq(0, out_drawn, "Drawn pixels out of the clip area");
+}
+
+/**
+ * Draw to `buf` as the draw buffer of the display in `buf_area`
+ */
+static void draw_start(lv_color_t * buf)
+{
+    uint32_t i;
+    for(i = 0; i < BUF_W * BUF_H; i++) buf[i] = LV_COLOR_WHITE;
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    area_saved = vdb->area;
+    buf_saved = vdb->buf_act;
+    vdb->area = buf_area;
+    vdb->buf_act = buf;
+    _lv_refr_set_disp_refreshing(disp);
+}
+
+static void draw_end(void)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(lv_disp_get_default());
+    vdb->area = area_saved;
+    vdb->buf_act = buf_saved;
+    _lv_refr_set_disp_refreshing(NULL);
+}
+
+static void draw_generic(const lv_point_t * points, uint16_t point_cnt, const lv_area_t * clip,
+                         const lv_draw_line_dsc_t * dsc)
+{
+    uint16_t i;
+    for(i = 1; i < point_cnt; i++) lv_draw_line(&points[i - 1], &points[i], clip, dsc);
+}
+
+/**
+ * A chart like series with steep and flat segments, partly out of the buffer
+ */
+static void series_create(lv_point_t * points, uint32_t seed)
+{
+    uint32_t i;
+    for(i = 0; i < POINT_CNT; i++) {
+        seed = seed * 1103515245 + 12345;
+        points[i].x = BUF_X - 8 + i * (BUF_W + 16) / (POINT_CNT - 1);
+        points[i].y = BUF_Y - 5 + (seed >> 16) % (BUF_H + 10);
+    }
+}
+
+/**
+ * Darkness of a pixel drawn on white
+ */
+static uint32_t ink(lv_color_t c)
+{
+    return 255 - lv_color_brightness(c);
+}
+
+#endif
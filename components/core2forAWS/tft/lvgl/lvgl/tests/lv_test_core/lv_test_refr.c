@@ -0,0 +1,235 @@
+/**
+ * @file lv_test_refr.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_refr.h"
+
+#if LV_BUILD_TEST && LV_REFR_PARALLEL > 1
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define WORKER_NUM  (LV_REFR_PARALLEL - 1)
+#define ROUND_NUM   8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void create_scene(lv_obj_t * scr);
+static void refr_screen(lv_disp_t * disp);
+static void workers_start(void);
+static void workers_stop(void);
+static void * worker(void * arg);
+static void band_start_cb(lv_disp_drv_t * disp_drv, lv_refr_band_t * band);
+static void wait_cb(lv_disp_drv_t * disp_drv);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static pthread_t threads[WORKER_NUM];
+static pthread_mutex_t queue_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t queue_cond = PTHREAD_COND_INITIALIZER;
+static lv_refr_band_t * queue[WORKER_NUM];
+static uint32_t queue_cnt;
+static bool workers_exit;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_refr(void)
+{
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_refr tests");
+    lv_test_print("===================");
+
+    lv_test_print("");
+    lv_test_print("Render the screen in parallel bands:");
+    lv_test_print("------------------------------------");
+
+    extern lv_color_t test_fb[];
+    lv_disp_t * disp = lv_disp_get_default();
+    uint32_t px_cnt = lv_disp_get_hor_res(disp) * lv_disp_get_ver_res(disp);
+    lv_color_t * ref_fb = malloc(px_cnt * sizeof(lv_color_t));
+    LV_ASSERT_MEM(ref_fb);
+
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_obj_t * scr_ori = lv_disp_get_scr_act(disp);
+    lv_disp_load_scr(scr);
+    create_scene(scr);
+
+    /*The reference is rendered in one piece*/
+    refr_screen(disp);
+    memcpy(ref_fb, test_fb, px_cnt * sizeof(lv_color_t));
+
+    workers_start();
+    lv_disp_drv_t * drv = &disp->driver;
+    void (*wait_cb_ori)(lv_disp_drv_t *) = drv->wait_cb;
+    drv->band_start_cb = band_start_cb;
+    drv->wait_cb = wait_cb;
+
+    /*Render it many times to catch the races between the bands*/
+    uint32_t diff_cnt = 0;
+    uint32_t r;
+    for(r = 0; r < ROUND_NUM; r++) {
+        _lv_memset_00(test_fb, px_cnt * sizeof(lv_color_t));
+        refr_screen(disp);
+        if(memcmp(ref_fb, test_fb, px_cnt * sizeof(lv_color_t))) diff_cnt++;
+    }
+
+    drv->band_start_cb = NULL;
+    drv->wait_cb = wait_cb_ori;
+    workers_stop();
+
+    lv_disp_load_scr(scr_ori);
+    lv_obj_del(scr);
+    free(ref_fb);
+
+    lv_test_assert_int_eq(0, diff_cnt, "Rounds with pixels different from the serial rendering");
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Create widgets which draw with masks, shadows, texts and temporarily changed states
+ */
+static void create_scene(lv_obj_t * scr)
+{
+    static lv_style_t style_shadow;
+    lv_style_init(&style_shadow);
+    lv_style_set_radius(&style_shadow, LV_STATE_DEFAULT, 12);
+    lv_style_set_shadow_width(&style_shadow, LV_STATE_DEFAULT, 16);
+    lv_style_set_shadow_ofs_y(&style_shadow, LV_STATE_DEFAULT, 4);
+    lv_style_set_bg_grad_color(&style_shadow, LV_STATE_DEFAULT, LV_COLOR_TEAL);
+    lv_style_set_bg_grad_dir(&style_shadow, LV_STATE_DEFAULT, LV_GRAD_DIR_VER);
+
+    lv_obj_t * cont = lv_obj_create(scr, NULL);
+    lv_obj_add_style(cont, LV_OBJ_PART_MAIN, &style_shadow);
+    lv_obj_set_size(cont, 200, 140);
+    lv_obj_set_pos(cont, 10, 10);
+
+    lv_obj_t * label = lv_label_create(cont, NULL);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_BREAK);
+    lv_obj_set_width(label, 180);
+    lv_label_set_text(label, "The quick brown fox jumps over the lazy dog. "
+                      "Pack my box with five dozen liquor jugs. 0123456789");
+    lv_obj_set_pos(label, 10, 10);
+
+    static const char * map[] = {"1", "2", "3", "\n", "4", "5", "6", ""};
+    lv_obj_t * btnm = lv_btnmatrix_create(scr, NULL);
+    lv_btnmatrix_set_map(btnm, map);
+    lv_btnmatrix_set_btn_ctrl(btnm, 1, LV_BTNMATRIX_CTRL_CHECK_STATE);
+    lv_btnmatrix_set_btn_ctrl(btnm, 4, LV_BTNMATRIX_CTRL_DISABLED);
+    lv_obj_set_size(btnm, 200, 100);
+    lv_obj_set_pos(btnm, 10, 160);
+
+#if LV_USE_GAUGE
+    lv_obj_t * gauge = lv_gauge_create(scr, NULL);
+    lv_obj_set_size(gauge, 150, 150);
+    lv_obj_set_pos(gauge, 220, 10);
+    lv_gauge_set_value(gauge, 0, 42);
+#endif
+
+#if LV_USE_TABLE
+    lv_obj_t * table = lv_table_create(scr, NULL);
+    lv_table_set_col_cnt(table, 2);
+    lv_table_set_row_cnt(table, 3);
+    lv_table_set_col_width(table, 0, 60);
+    lv_table_set_col_width(table, 1, 60);
+    lv_table_set_cell_value(table, 0, 0, "Name");
+    lv_table_set_cell_value(table, 0, 1, "Value");
+    lv_table_set_cell_value(table, 1, 0, "GSR");
+    lv_table_set_cell_value(table, 1, 1, "1234");
+    lv_table_set_cell_value(table, 2, 0, "Mic");
+    lv_table_set_cell_value(table, 2, 1, "-12");
+    lv_obj_set_pos(table, 220, 170);
+#endif
+}
+
+static void refr_screen(lv_disp_t * disp)
+{
+    lv_obj_invalidate(lv_disp_get_scr_act(disp));
+    lv_refr_now(disp);
+}
+
+static void workers_start(void)
+{
+    workers_exit = false;
+    uint32_t i;
+    for(i = 0; i < WORKER_NUM; i++) {
+        pthread_create(&threads[i], NULL, worker, NULL);
+    }
+}
+
+static void workers_stop(void)
+{
+    pthread_mutex_lock(&queue_mutex);
+    workers_exit = true;
+    pthread_cond_broadcast(&queue_cond);
+    pthread_mutex_unlock(&queue_mutex);
+
+    uint32_t i;
+    for(i = 0; i < WORKER_NUM; i++) {
+        pthread_join(threads[i], NULL);
+    }
+}
+
+/**
+ * Render the started bands until the workers are stopped
+ */
+static void * worker(void * arg)
+{
+    LV_UNUSED(arg);
+
+    while(1) {
+        pthread_mutex_lock(&queue_mutex);
+        while(queue_cnt == 0 && !workers_exit) pthread_cond_wait(&queue_cond, &queue_mutex);
+        if(queue_cnt == 0) {
+            pthread_mutex_unlock(&queue_mutex);
+            return NULL;
+        }
+        lv_refr_band_t * band = queue[--queue_cnt];
+        pthread_mutex_unlock(&queue_mutex);
+
+        lv_refr_band_render(band);
+    }
+}
+
+static void band_start_cb(lv_disp_drv_t * disp_drv, lv_refr_band_t * band)
+{
+    LV_UNUSED(disp_drv);
+
+    pthread_mutex_lock(&queue_mutex);
+    queue[queue_cnt++] = band;
+    pthread_cond_signal(&queue_cond);
+    pthread_mutex_unlock(&queue_mutex);
+}
+
+static void wait_cb(lv_disp_drv_t * disp_drv)
+{
+    LV_UNUSED(disp_drv);
+    sched_yield();
+}
+
+#endif
@@ -0,0 +1,221 @@
+/**
+ * @file lv_test_shadow.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_shadow.h"
+
+#if LV_BUILD_TEST && LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BUF_W       120
+#define BUF_H       120
+#define BUF_X       10      /*Position of the draw buffer on the screen*/
+#define BUF_Y       20
+#define FLUSH_CNT   8       /*Number of entries of the shadow cache*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void hit_same_pixels(void);
+static void small_rect(void);
+static void rejections(void);
+static void lru(void);
+static void draw_shadow(lv_color_t * buf, lv_coord_t w, lv_coord_t h, lv_coord_t sw, lv_coord_t r);
+static void cache_flush(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t buf_ref[BUF_W * BUF_H];
+static lv_color_t buf_act[BUF_W * BUF_H];
+static lv_area_t buf_area = {BUF_X, BUF_Y, BUF_X + BUF_W - 1, BUF_Y + BUF_H - 1};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_shadow(void)
+{
+    lv_test_print("");
+    lv_test_print("========================");
+    lv_test_print("Start shadow cache tests");
+    lv_test_print("========================");
+
+    hit_same_pixels();
+    small_rect();
+    rejections();
+    lru();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void hit_same_pixels(void)
+{
+    lv_test_print("");
+    lv_test_print("Draw a cached corner:");
+    lv_test_print("---------------------");
+
+    cache_flush();
+    lv_draw_rect_reset_shadow_cache_stats();
+
+    draw_shadow(buf_ref, 60, 40, 10, 8);
+    draw_shadow(buf_act, 60, 40, 14, 4);
+    draw_shadow(buf_act, 60, 40, 10, 8);
+
+    lv_draw_shadow_cache_stats_t stats;
+    lv_draw_rect_get_shadow_cache_stats(&stats);
+    lv_test_assert_int_eq(3, stats.lookups, "Lookups");
+    lv_test_assert_int_eq(1, stats.hits, "Hits");
+    lv_test_assert_true(stats.entries <= FLUSH_CNT, "Cached corners");
+    lv_test_assert_true(stats.bytes <= LV_SHADOW_CACHE_BYTES, "Bytes in the budget");
+    lv_test_assert_true(memcmp(buf_ref, buf_act, sizeof(buf_ref)) == 0, "Same pixels as the computed corner");
+}
+
+/**
+ * The smallest cached rectangle has to give the same corner as a large one
+ */
+static void small_rect(void)
+{
+    lv_test_print("");
+    lv_test_print("Cache the corner of a small rectangle:");
+    lv_test_print("--------------------------------------");
+
+    cache_flush();
+    lv_draw_rect_reset_shadow_cache_stats();
+
+    draw_shadow(buf_act, 18, 18, 12, 6);
+    draw_shadow(buf_act, 80, 60, 12, 6);
+
+    lv_draw_shadow_cache_stats_t stats;
+    lv_draw_rect_get_shadow_cache_stats(&stats);
+    lv_test_assert_int_eq(1, stats.hits, "The large rectangle uses the corner of the small");
+
+    cache_flush();
+    draw_shadow(buf_ref, 80, 60, 12, 6);
+    lv_test_assert_true(memcmp(buf_ref, buf_act, sizeof(buf_ref)) == 0, "Same pixels as the own corner");
+}
+
+static void rejections(void)
+{
+    lv_test_print("");
+    lv_test_print("Don't cache the corners which don't fit:");
+    lv_test_print("----------------------------------------");
+
+    lv_draw_rect_reset_shadow_cache_stats();
+
+    /*Smaller than the corner*/
+    draw_shadow(buf_act, 16, 16, 30, 4);
+    draw_shadow(buf_act, 16, 16, 30, 4);
+
+    /*Larger than the cache*/
+    draw_shadow(buf_act, 2 * LV_SHADOW_CACHE_SIZE, 2 * LV_SHADOW_CACHE_SIZE, LV_SHADOW_CACHE_SIZE / 2 + 1,
+                LV_SHADOW_CACHE_SIZE / 2);
+
+    lv_draw_shadow_cache_stats_t stats;
+    lv_draw_rect_get_shadow_cache_stats(&stats);
+    lv_test_assert_int_eq(3, stats.rejections, "Rejections");
+    lv_test_assert_int_eq(0, stats.hits, "Hits");
+}
+
+static void lru(void)
+{
+    lv_test_print("");
+    lv_test_print("Evict the least recently used corner:");
+    lv_test_print("-------------------------------------");
+
+    /*Two corners fit into the cache but three don't*/
+    lv_coord_t size = LV_SHADOW_CACHE_SIZE;
+    while(2 * size * size > LV_SHADOW_CACHE_BYTES) size--;
+    if(3 * size * size <= LV_SHADOW_CACHE_BYTES) {
+        lv_test_print("Skip: the cache is larger than three corners");
+        return;
+    }
+
+    lv_coord_t sw = size / 2;
+    lv_coord_t r = size - sw;
+
+    cache_flush();
+    lv_draw_rect_reset_shadow_cache_stats();
+    draw_shadow(buf_act, 2 * size, 2 * size, sw, r);
+    draw_shadow(buf_act, 2 * size, 2 * size, sw + 1, r - 1);
+    draw_shadow(buf_act, 2 * size, 2 * size, sw, r);            /*Hit, now the other is the oldest*/
+    draw_shadow(buf_act, 2 * size, 2 * size, sw + 2, r - 2);    /*Evicts the second*/
+
+    lv_draw_shadow_cache_stats_t stats;
+    lv_draw_rect_get_shadow_cache_stats(&stats);
+    lv_test_assert_int_eq(1, stats.hits, "Hits");
+    lv_test_assert_true(stats.evictions > 0, "Evicted");
+    lv_test_assert_true(stats.bytes <= LV_SHADOW_CACHE_BYTES, "Bytes in the budget");
+
+    draw_shadow(buf_act, 2 * size, 2 * size, sw, r);
+    lv_draw_rect_get_shadow_cache_stats(&stats);
+    lv_test_assert_int_eq(2, stats.hits, "The recently used corner is kept");
+
+    draw_shadow(buf_act, 2 * size, 2 * size, sw + 1, r - 1);
+    lv_draw_rect_get_shadow_cache_stats(&stats);
+    lv_test_assert_int_eq(2, stats.hits, "The least recently used corner is evicted");
+}
+
+/**
+ * Draw the shadow of a rectangle at the top left of the buffer
+ */
+static void draw_shadow(lv_color_t * buf, lv_coord_t w, lv_coord_t h, lv_coord_t sw, lv_coord_t r)
+{
+    uint32_t i;
+    for(i = 0; i < BUF_W * BUF_H; i++) buf[i] = LV_COLOR_WHITE;
+
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    lv_area_t area_saved = vdb->area;
+    lv_color_t * buf_saved = vdb->buf_act;
+    vdb->area = buf_area;
+    vdb->buf_act = buf;
+    _lv_refr_set_disp_refreshing(disp);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_opa = LV_OPA_TRANSP;
+    dsc.radius = r;
+    dsc.shadow_width = sw;
+    dsc.shadow_ofs_y = 3;
+
+    lv_area_t coords = {BUF_X + 20, BUF_Y + 20, BUF_X + 20 + w - 1, BUF_Y + 20 + h - 1};
+    lv_draw_rect(&coords, &buf_area, &dsc);
+
+    vdb->area = area_saved;
+    vdb->buf_act = buf_saved;
+    _lv_refr_set_disp_refreshing(NULL);
+}
+
+/**
+ * Replace all cached corners with ones the tests don't use. Overwrites `buf_ref`.
+ */
+static void cache_flush(void)
+{
+    /*Twice as many corners as the entries so they always miss*/
+    lv_coord_t i;
+    for(i = 1; i <= 2 * FLUSH_CNT; i++) {
+        draw_shadow(buf_ref, 2 * LV_SHADOW_CACHE_SIZE, 2 * LV_SHADOW_CACHE_SIZE, i, LV_SHADOW_CACHE_SIZE - i);
+    }
+}
+
+#endif
@@ -0,0 +1,292 @@
+/**
+ * @file lv_test_task.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_task.h"
+
+#if LV_BUILD_TEST
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TASK_MEM        256     /*Pool size to reserve for a task (the task, its list node and some spare)*/
+#define TASK_NUM        LV_MATH_MIN(64, LV_MEM_SIZE / TASK_MEM)
+#define ROUND_NUM       2000
+#define IDLE_TASK_NUM   LV_MATH_MIN(100, LV_MEM_SIZE / TASK_MEM)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void time_till_next(void);
+static void ready_order(void);
+static void resume(void);
+static void random_ops(void);
+static void idle_latency(void);
+static uint32_t ref_time_till_next(void);
+static lv_task_t * task_create(uint32_t period, lv_task_prio_t prio, uint32_t * cnt);
+static void task_cb(lv_task_t * task);
+static void resume_cb(void);
+static uint32_t rnd(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_task_t * tasks[TASK_NUM];
+static uint32_t run_cnt[TASK_NUM];
+static uint32_t run_order[TASK_NUM];
+static uint32_t run_order_cnt;
+static uint32_t resume_cnt;
+static uint32_t rnd_seed = 1;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_task(void)
+{
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_task tests");
+    lv_test_print("===================");
+
+    time_till_next();
+    ready_order();
+    resume();
+    random_ops();
+    idle_latency();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void time_till_next(void)
+{
+    lv_test_print("");
+    lv_test_print("Return the time till the next task:");
+    lv_test_print("-----------------------------------");
+
+    tasks[0] = lv_task_create(task_cb, 3000, LV_TASK_PRIO_MID, &run_cnt[0]);
+    tasks[1] = lv_task_create(task_cb, 1000, LV_TASK_PRIO_LOW, &run_cnt[1]);
+    tasks[2] = lv_task_create(task_cb, 2000, LV_TASK_PRIO_HIGH, &run_cnt[2]);
+    tasks[3] = lv_task_create(task_cb, 1, LV_TASK_PRIO_OFF, &run_cnt[3]);
+
+    uint32_t t = lv_task_handler();
+    lv_test_assert_true(t == ref_time_till_next(), "The same as the nearest deadline");
+    lv_test_assert_int_gt(0, t, "Not 0 if a task is turned off");
+
+    lv_task_set_period(tasks[1], 5000);
+    t = lv_task_handler();
+    lv_test_assert_true(t == ref_time_till_next(), "Follows a longer period");
+
+    lv_task_set_prio(tasks[3], LV_TASK_PRIO_LOWEST);
+    lv_tick_inc(1);
+    lv_task_handler();
+    lv_test_assert_int_gt(0, run_cnt[3], "Runs after turned on");
+
+    uint32_t i;
+    for(i = 0; i < 4; i++) lv_task_del(tasks[i]);
+}
+
+static void ready_order(void)
+{
+    lv_test_print("");
+    lv_test_print("Run the ready tasks by priority:");
+    lv_test_print("--------------------------------");
+
+    uint32_t i;
+    for(i = 0; i < 3; i++) run_cnt[i] = 0;
+    tasks[0] = lv_task_create(task_cb, 1000, LV_TASK_PRIO_LOW, &run_cnt[0]);
+    tasks[1] = lv_task_create(task_cb, 1000, LV_TASK_PRIO_HIGH, &run_cnt[1]);
+    tasks[2] = lv_task_create(task_cb, 1000, LV_TASK_PRIO_MID, &run_cnt[2]);
+    lv_task_ready(tasks[0]);
+    lv_task_ready(tasks[1]);
+
+    run_order_cnt = 0;
+    lv_task_handler();
+    lv_test_assert_int_eq(2, run_order_cnt, "Only the ready tasks run");
+    lv_test_assert_int_eq(1, run_order[0], "The high priority task runs first");
+    lv_test_assert_int_eq(0, run_order[1], "The low priority task runs then");
+
+    lv_task_set_repeat_count(tasks[2], 1);
+    lv_task_ready(tasks[2]);
+    lv_task_handler();
+    lv_test_assert_int_eq(1, run_cnt[2], "The one shot task runs");
+    lv_test_assert_true(lv_task_get_next(NULL) != tasks[2], "The one shot task is deleted");
+
+    lv_task_del(tasks[0]);
+    lv_task_del(tasks[1]);
+}
+
+static void resume(void)
+{
+    lv_test_print("");
+    lv_test_print("Call the resume callback:");
+    lv_test_print("-------------------------");
+
+    lv_task_set_resume_cb(resume_cb);
+    resume_cnt = 0;
+
+    tasks[0] = lv_task_create(task_cb, 100000, LV_TASK_PRIO_MID, &run_cnt[0]);
+    lv_task_handler();
+
+    lv_task_ready(tasks[0]);
+    lv_test_assert_int_eq(1, resume_cnt, "Called when a task is made ready");
+    lv_task_ready(tasks[0]);
+    lv_task_reset(tasks[0]);
+    lv_test_assert_int_eq(1, resume_cnt, "Not called again until the handler runs");
+
+    lv_task_handler();
+    lv_task_set_period(tasks[0], 0);
+    lv_test_assert_int_eq(2, resume_cnt, "Called when the period is shortened");
+
+    lv_task_handler();
+    lv_task_set_prio(tasks[0], LV_TASK_PRIO_OFF);
+    lv_task_handler();
+    lv_task_set_prio(tasks[0], LV_TASK_PRIO_MID);
+    lv_test_assert_int_eq(3, resume_cnt, "Called when a task is turned on");
+
+    lv_task_handler();
+    lv_test_assert_int_eq(3, resume_cnt, "Not called by the handler");
+
+    lv_task_del(tasks[0]);
+    lv_task_set_resume_cb(NULL);
+}
+
+static void random_ops(void)
+{
+    lv_test_print("");
+    lv_test_print("Change the tasks randomly:");
+    lv_test_print("--------------------------");
+
+    uint32_t i;
+    for(i = 0; i < TASK_NUM; i++) {
+        run_cnt[i] = 0;
+        tasks[i] = task_create(rnd() % 1000 + 100, rnd() % _LV_TASK_PRIO_NUM, &run_cnt[i]);
+    }
+
+    bool time_ok = true;
+    uint32_t r;
+    for(r = 0; r < ROUND_NUM; r++) {
+        lv_task_t * task = tasks[rnd() % TASK_NUM];
+        switch(rnd() % 6) {
+            case 0:
+                lv_task_set_period(task, rnd() % 1000 + 100);
+                break;
+            case 1:
+                lv_task_set_prio(task, rnd() % _LV_TASK_PRIO_NUM);
+                break;
+            case 2:
+                lv_task_reset(task);
+                break;
+            case 3:
+                lv_task_ready(task);
+                break;
+            case 4:
+                lv_task_set_period(task, rnd() % 50 + 10);
+                break;
+            case 5:
+                i = rnd() % TASK_NUM;
+                lv_task_del(tasks[i]);
+                tasks[i] = task_create(rnd() % 1000 + 100, rnd() % _LV_TASK_PRIO_NUM, &run_cnt[i]);
+                break;
+        }
+
+        lv_tick_inc(rnd() % 20);
+        uint32_t t = lv_task_handler();
+        if(t != ref_time_till_next()) time_ok = false;
+    }
+    lv_test_assert_true(time_ok, "Always the nearest deadline");
+
+    for(i = 0; i < TASK_NUM; i++) lv_task_del(tasks[i]);
+}
+
+static void idle_latency(void)
+{
+    lv_test_print("");
+    lv_test_print("Latency of the handler if nothing is ready:");
+    lv_test_print("-------------------------------------------");
+
+    uint32_t i;
+    lv_task_t * idle_tasks[IDLE_TASK_NUM];
+    for(i = 0; i < IDLE_TASK_NUM; i++) {
+        idle_tasks[i] = task_create(100000 + i, LV_TASK_PRIO_MID, &run_cnt[0]);
+    }
+
+    uint32_t round_num = 100000;
+    clock_t t = clock();
+    for(i = 0; i < round_num; i++) lv_task_handler();
+    t = clock() - t;
+
+    lv_test_print("%d ns per call with %d tasks", (int)((uint64_t)t * 1000000000 / CLOCKS_PER_SEC / round_num),
+                  (int)IDLE_TASK_NUM);
+
+    for(i = 0; i < IDLE_TASK_NUM; i++) lv_task_del(idle_tasks[i]);
+}
+
+/**
+ * Walk all the tasks like `lv_task_handler` used to
+ */
+static uint32_t ref_time_till_next(void)
+{
+    uint32_t t = LV_NO_TASK_READY;
+    lv_task_t * task = lv_task_get_next(NULL);
+    while(task) {
+        if(task->prio != LV_TASK_PRIO_OFF) {
+            uint32_t elp = lv_tick_elaps(task->last_run);
+            uint32_t remaining = elp >= task->period ? 0 : task->period - elp;
+            if(remaining < t) t = remaining;
+        }
+        task = lv_task_get_next(task);
+    }
+    return t;
+}
+
+/**
+ * Create a task which counts its runs in `cnt`. Fails the test if it can't be allocated.
+ */
+static lv_task_t * task_create(uint32_t period, lv_task_prio_t prio, uint32_t * cnt)
+{
+    lv_task_t * task = lv_task_create(task_cb, period, prio, cnt);
+    if(task == NULL) lv_test_error("   FAIL: Couldn't create a task.");
+
+    return task;
+}
+
+static void task_cb(lv_task_t * task)
+{
+    uint32_t * cnt = task->user_data;
+    (*cnt)++;
+    if(run_order_cnt < TASK_NUM) run_order[run_order_cnt++] = cnt - run_cnt;
+}
+
+static void resume_cb(void)
+{
+    resume_cnt++;
+}
+
+/**
+ * Deterministic pseudo random numbers
+ */
+static uint32_t rnd(void)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return (rnd_seed >> 16) & 0x7FFF;
+}
+
+#endif
@@ -11,10 +11,15 @@
 #include "lv_test_label.h"
 
 #if LV_BUILD_TEST
+#include <time.h>
 
 /*********************
  *      DEFINES
  *********************/
+#define EDIT_ROUNDS     400
+#define TXT_MAX_LEN     400
+#define APPEND_NUM      LV_MATH_MIN(40, LV_MEM_SIZE / 512)   /*The text and its lines have to fit into the pool*/
+#define LAYOUT_TEST     (LV_LABEL_LAYOUT_CACHE && (LV_MEM_CUSTOM || LV_MEM_SIZE >= 8 * 1024))
 
 /**********************
  *      TYPEDEFS
@@ -24,10 +29,22 @@
  *  STATIC PROTOTYPES
  **********************/
 static void create_copy(void);
+#if LAYOUT_TEST
+static void layout_edits(void);
+static void layout_latency(void);
+static bool layout_check(lv_obj_t * label);
+static uint32_t rnd(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LAYOUT_TEST
+static uint32_t rnd_seed = 1;
+static const char * words[] = {"park", "spot ", "12,", "free.", "\n", " ", "occupied-", "x",
+                               "abcdefghijklmnopqrstuvwxyz0123456789"
+                              };
+#endif
 
 /**********************
  *      MACROS
@@ -46,6 +63,12 @@ void lv_test_label(void)
 
 #if LV_USE_LABEL
     create_copy();
+#if LAYOUT_TEST
+    layout_edits();
+    layout_latency();
+#elif LV_LABEL_LAYOUT_CACHE
+    lv_test_print("SKIP: layout tests because they require LV_MEM_SIZE >= 8 kB");
+#endif
 #else
     lv_test_print("Skip label test: LV_USE_LABEL == 0");
 #endif
@@ -66,4 +89,182 @@ static void create_copy(void)
     lv_test_assert_img_eq("lv_test_img32_label_1.png", "Create a label and leave the default settings");
 #endif
 }
+
+#if LAYOUT_TEST
+static void layout_edits(void)
+{
+    lv_test_print("");
+    lv_test_print("Lay out only the changed lines:");
+    lv_test_print("-------------------------------");
+
+    lv_obj_clean(lv_scr_act());
+
+    /*Edit a wrapped and an expanding label and compare them to labels whose text is set from scratch*/
+    lv_obj_t * labels[2];
+    lv_obj_t * refs[2];
+    labels[0] = lv_label_create(lv_scr_act(), NULL);
+    lv_label_set_long_mode(labels[0], LV_LABEL_LONG_BREAK);
+    lv_label_set_align(labels[0], LV_LABEL_ALIGN_CENTER);
+    lv_obj_set_width(labels[0], 120);
+    labels[1] = lv_label_create(lv_scr_act(), NULL);
+
+    uint32_t l;
+    for(l = 0; l < 2; l++) {
+        refs[l] = lv_label_create(lv_scr_act(), labels[l]);
+        lv_obj_set_width(refs[l], lv_obj_get_width(labels[l]));
+    }
+
+    bool lines_ok = true;
+    bool size_ok = true;
+    bool pos_ok = true;
+    bool letter_ok = true;
+    uint32_t r;
+    for(r = 0; r < EDIT_ROUNDS; r++) {
+        for(l = 0; l < 2; l++) {
+            lv_obj_t * label = labels[l];
+            const char * txt = lv_label_get_text(label);
+            uint32_t len = strlen(txt);
+            const char * word = words[rnd() % (sizeof(words) / sizeof(words[0]))];
+
+            if(len > TXT_MAX_LEN) {
+                lv_label_set_text(label, "");
+            }
+            else {
+                switch(rnd() % 4) {
+                    case 0:
+                        lv_label_ins_text(label, LV_LABEL_POS_LAST, word);
+                        break;
+                    case 1:
+                        lv_label_ins_text(label, rnd() % (len + 1), word);
+                        break;
+                    case 2:
+                        if(len) lv_label_cut_text(label, rnd() % len, rnd() % 8 + 1);
+                        break;
+                    case 3: {
+                            /*Replace the end of the text*/
+                            char buf[TXT_MAX_LEN + 64];
+                            uint32_t keep = rnd() % (len + 1);
+                            lv_snprintf(buf, sizeof(buf), "%.*s%s", (int)keep, txt, word);
+                            lv_label_set_text(label, buf);
+                            break;
+                        }
+                }
+            }
+
+            txt = lv_label_get_text(label);
+            if(txt == NULL) lv_test_error("   FAIL: Couldn't edit the text.");
+            lv_label_set_text(refs[l], txt);
+            len = strlen(txt);
+
+            if(!layout_check(label)) lines_ok = false;
+            if(lv_obj_get_width(label) != lv_obj_get_width(refs[l])) size_ok = false;
+            if(lv_obj_get_height(label) != lv_obj_get_height(refs[l])) size_ok = false;
+
+            uint32_t i;
+            for(i = 0; i < 4; i++) {
+                lv_point_t p1;
+                lv_point_t p2;
+                uint32_t char_id = len ? rnd() % (len + 1) : 0;
+                lv_label_get_letter_pos(label, char_id, &p1);
+                lv_label_get_letter_pos(refs[l], char_id, &p2);
+                if(p1.x != p2.x || p1.y != p2.y) pos_ok = false;
+
+                p1.x = (lv_coord_t)(rnd() % (lv_obj_get_width(label) + 1));
+                p1.y = (lv_coord_t)(rnd() % (lv_obj_get_height(label) + 20));
+                p2 = p1;
+                if(lv_label_get_letter_on(label, &p1) != lv_label_get_letter_on(refs[l], &p2)) letter_ok = false;
+            }
+        }
+    }
+
+    lv_test_assert_true(lines_ok, "The lines are the same as found letter by letter");
+    lv_test_assert_true(size_ok, "The size is the same as with a new text");
+    lv_test_assert_true(pos_ok, "The letter positions are the same as with a new text");
+    lv_test_assert_true(letter_ok, "The letters on points are the same as with a new text");
+
+    lv_obj_clean(lv_scr_act());
+}
+
+static void layout_latency(void)
+{
+    lv_test_print("");
+    lv_test_print("Latency of getting the position of the last letter:");
+    lv_test_print("----------------------------------------------------");
+
+    lv_obj_t * label = lv_label_create(lv_scr_act(), NULL);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_BREAK);
+    lv_obj_set_width(label, 200);
+    lv_label_set_text(label, "");
+
+    char buf[64];
+    uint32_t i;
+    for(i = 0; i < APPEND_NUM; i++) {
+        lv_snprintf(buf, sizeof(buf), "t=%d spot=%d occupied=%d\n", (int)i, (int)(i % 24), (int)(i * 7 % 100));
+        lv_label_ins_text(label, LV_LABEL_POS_LAST, buf);
+        if(lv_label_get_text(label) == NULL) lv_test_error("   FAIL: Couldn't append to the text.");
+    }
+
+    lv_test_assert_true(layout_check(label), "The lines of the appended text are the same as found letter by letter");
+
+    uint32_t char_id = _lv_txt_get_encoded_length(lv_label_get_text(label));
+    uint32_t round_num = 10000;
+    lv_point_t p;
+    clock_t t = clock();
+    for(i = 0; i < round_num; i++) lv_label_get_letter_pos(label, char_id, &p);
+    t = clock() - t;
+
+    /*The last letter is at the start of the empty line after the trailing line break*/
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+    lv_coord_t max_w = lv_obj_get_width(label) - lv_obj_get_style_pad_left(label, LV_LABEL_PART_MAIN) -
+                       lv_obj_get_style_pad_right(label, LV_LABEL_PART_MAIN);
+    lv_point_t size;
+    _lv_txt_get_size(&size, lv_label_get_text(label), font, lv_obj_get_style_text_letter_space(label, LV_LABEL_PART_MAIN),
+                     lv_obj_get_style_text_line_space(label, LV_LABEL_PART_MAIN), max_w, LV_TXT_FLAG_NONE);
+
+    lv_test_assert_int_eq(size.y - lv_font_get_line_height(font), p.y, "Position of the last letter");
+    lv_test_print("%d ns per lv_label_get_letter_pos on the last line",
+                  (int)((uint64_t)t * 1000000000 / CLOCKS_PER_SEC / round_num));
+
+    lv_obj_del(label);
+}
+
+/**
+ * Compare the cached lines of a label to the lines found letter by letter
+ */
+static bool layout_check(lv_obj_t * label)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    const lv_txt_layout_t * layout = &ext->layout;
+    if(!layout->complete || layout->txt != ext->text) return false;
+
+    const char * txt = ext->text;
+    lv_txt_flag_t flag = LV_TXT_FLAG_NONE;
+    if(ext->expand) flag |= LV_TXT_FLAG_EXPAND;
+    if(ext->long_mode == LV_LABEL_LONG_EXPAND) flag |= LV_TXT_FLAG_FIT;
+    lv_coord_t max_w = lv_obj_get_width(label) - lv_obj_get_style_pad_left(label, LV_LABEL_PART_MAIN) -
+                       lv_obj_get_style_pad_right(label, LV_LABEL_PART_MAIN);
+    if(flag & (LV_TXT_FLAG_EXPAND | LV_TXT_FLAG_FIT)) max_w = LV_COORD_MAX;
+    const lv_font_t * font = lv_obj_get_style_text_font(label, LV_LABEL_PART_MAIN);
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(label, LV_LABEL_PART_MAIN);
+
+    uint32_t line_start = 0;
+    uint32_t line_id = 0;
+    while(txt[line_start] != '\0') {
+        uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+        lv_coord_t w = _lv_txt_get_width(&txt[line_start], line_end - line_start, font, letter_space, flag);
+        if(line_id >= layout->line_cnt) return false;
+        if(layout->lines[line_id].start != line_start || layout->lines[line_id].w != w) return false;
+        line_start = line_end;
+        line_id++;
+    }
+
+    return line_id == layout->line_cnt && layout->end == line_start;
+}
+
+static uint32_t rnd(void)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return (rnd_seed >> 16) & 0x7FFF;
+}
+#endif
 #endif
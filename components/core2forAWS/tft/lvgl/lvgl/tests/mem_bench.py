@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+
+# Build and run the allocation benchmark (lv_mem_bench_main.c) with the first-fit and the
+# TLSF allocator of lv_mem and with libc malloc, and write the results to mem_bench.json.
+# Usage: ./mem_bench.py [output.json]
+
+import os
+import sys
+
+lvgldirname = os.path.abspath('..')
+lvgldirname = os.path.basename(lvgldirname)
+lvgldirname = '"' + lvgldirname + '"'
+
+base_defines = '"-DLV_CONF_PATH=' + lvgldirname +'/tests/lv_test_conf.h -DLV_BUILD_TEST"'
+optimization = '"-O2 -g0"'
+out_file = sys.argv[1] if len(sys.argv) > 1 else "mem_bench.json"
+
+core2 = {
+  "LV_HOR_RES_MAX":320,
+  "LV_VER_RES_MAX":240,
+  "LV_COLOR_DEPTH":16,
+  "LV_MEM_SIZE":32*1024,
+  "LV_USE_LOG":0,
+}
+
+allocators = [
+  {"LV_MEM_CUSTOM":0, "LV_MEM_TLSF":0},
+  {"LV_MEM_CUSTOM":0, "LV_MEM_TLSF":1},
+  {"LV_MEM_CUSTOM":1},
+]
+
+results = []
+for a in allocators:
+  defines = dict(core2)
+  defines.update(a)
+  d_all = base_defines[:-1] + " ";
+  for d in defines:
+    d_all += " -D" + d + "=" + str(defines[d])
+  d_all += '"'
+
+  cmd = "make -j8 BIN=mem_bench.bin MAINSRC=./lv_mem_bench_main.c LVGL_DIR_NAME=" + lvgldirname + " DEFINES=" + d_all + " OPTIMIZATION=" + optimization
+
+  os.system("make clean MAINSRC=./lv_mem_bench_main.c LVGL_DIR_NAME=" + lvgldirname)
+  os.system("rm -f ./mem_bench.bin")
+  ret = os.system(cmd)
+  if(ret != 0):
+    print("BUILD ERROR! (error code " + str(ret) + ")")
+    exit(1)
+
+  res = os.popen("./mem_bench.bin").read().strip()
+  if(res == ""):
+    print("RUN ERROR!")
+    exit(1)
+  print(res)
+  results.append("    " + res)
+
+with open(out_file, "w") as f:
+  f.write("[\n" + ",\n".join(results) + "\n]\n")
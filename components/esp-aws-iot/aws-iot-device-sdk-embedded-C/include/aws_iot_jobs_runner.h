@@ -0,0 +1,283 @@
+/*
+ * Copyright 2015-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ * http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file aws_iot_jobs_runner.h
+ * @brief Executes AWS IoT Jobs delivered to a thing.
+ *
+ * The runner subscribes to the notify-next and start-next/accepted topics of a thing and
+ * keeps the executions it receives in a fixed size queue. Worker threads (or the main loop)
+ * call #aws_iot_jobs_runner_work to take a queued execution and run the handler registered
+ * for the "operation" of its job document. Up to \c maxConcurrentJobs executions run at the
+ * same time.
+ *
+ * Handlers never talk to MQTT. Progress they report is stored in their execution slot and
+ * #aws_iot_jobs_runner_process, called from the thread that owns the MQTT client, publishes
+ * it: at most one IN_PROGRESS update per coalescing window, a heartbeat when nothing was
+ * reported for a while, and the final status as soon as the handler returns.
+ *
+ * All state lives in the AwsIotJobsRunner structure, nothing is allocated once it is
+ * initialized.
+ */
+#ifndef AWS_IOT_JOBS_RUNNER_H_
+#define AWS_IOT_JOBS_RUNNER_H_
+
+#ifdef DISABLE_IOT_JOBS
+#error "Jobs API is disabled"
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "aws_iot_config.h"
+#include "aws_iot_mqtt_client_interface.h"
+#include "aws_iot_jobs_topics.h"
+#include "aws_iot_jobs_types.h"
+#include "aws_iot_error.h"
+#include "timer_interface.h"
+#include "jsmn.h"
+
+#ifdef _ENABLE_THREAD_SUPPORT_
+#include "threads_interface.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef JOBS_RUNNER_QUEUE_LENGTH
+#define JOBS_RUNNER_QUEUE_LENGTH 4 ///< Executions that can be queued or running at the same time
+#endif
+
+#ifndef JOBS_RUNNER_MAX_CONCURRENT_JOBS
+#define JOBS_RUNNER_MAX_CONCURRENT_JOBS 2 ///< Default for AwsIotJobsRunnerParams.maxConcurrentJobs
+#endif
+
+#ifndef JOBS_RUNNER_MAX_HANDLERS
+#define JOBS_RUNNER_MAX_HANDLERS 4 ///< Operations that can be registered
+#endif
+
+#ifndef JOBS_RUNNER_MAX_DOCUMENT_LENGTH
+#define JOBS_RUNNER_MAX_DOCUMENT_LENGTH 512 ///< Largest job document that can be executed, excluding the NULL terminator
+#endif
+
+#ifndef JOBS_RUNNER_MAX_STATUS_DETAILS_LENGTH
+#define JOBS_RUNNER_MAX_STATUS_DETAILS_LENGTH 128 ///< Largest statusDetails object a handler can report, excluding the NULL terminator
+#endif
+
+#define JOBS_RUNNER_MAX_OPERATION_LENGTH 32 ///< Longest operation name, excluding the NULL terminator
+
+/**
+ * Topic buffer size for any topic of one job, sized from the topic cache limits
+ */
+#define JOBS_RUNNER_TOPIC_BUFFER_LENGTH (JOB_TOPIC_CACHE_PREFIX_MAX_LENGTH + MAX_SIZE_OF_JOB_ID + 1 + JOB_TOPIC_CACHE_TAIL_MAX_LENGTH + 1)
+
+/**
+ * Update request size: the fixed keys, an int64 execution number and the status details
+ */
+#define JOBS_RUNNER_MESSAGE_BUFFER_LENGTH (JOBS_RUNNER_MAX_STATUS_DETAILS_LENGTH + 96)
+
+typedef struct AwsIotJobsRunner AwsIotJobsRunner;
+typedef struct AwsIotJobsRunnerExecution AwsIotJobsRunnerExecution;
+
+/**
+ * @brief Executes one job
+ *
+ * Called from #aws_iot_jobs_runner_work. The job document is available in
+ * \c pExecution->document for the whole call. Long running handlers should call
+ * #aws_iot_jobs_runner_report_progress, the runner keeps the job IN_PROGRESS on its own.
+ *
+ * \return the terminal status to report: JOB_EXECUTION_SUCCEEDED, JOB_EXECUTION_FAILED
+ *   or JOB_EXECUTION_REJECTED. Anything else is reported as JOB_EXECUTION_FAILED.
+ */
+typedef JobExecutionStatus (*AwsIotJobsRunnerHandler)(AwsIotJobsRunnerExecution *pExecution, void *pHandlerData);
+
+typedef enum {
+	JOBS_RUNNER_SLOT_FREE = 0,  ///< Unused
+	JOBS_RUNNER_SLOT_QUEUED,    ///< Waiting for a worker
+	JOBS_RUNNER_SLOT_RUNNING,   ///< Handler executing in a worker
+	JOBS_RUNNER_SLOT_DONE       ///< Terminal status waiting to be published
+} AwsIotJobsRunnerSlotState;
+
+/**
+ * @brief One queued or running job execution
+ *
+ * Only \c jobId, \c document, \c documentLength and \c executionNumber are meant to be read by
+ * handlers, the rest is owned by the runner.
+ */
+struct AwsIotJobsRunnerExecution {
+	char jobId[MAX_SIZE_OF_JOB_ID + 1];                            ///< Id of the job
+	char document[JOBS_RUNNER_MAX_DOCUMENT_LENGTH + 1];            ///< Job document, NULL terminated JSON object
+	uint16_t documentLength;                                       ///< Length of document
+	int64_t executionNumber;                                       ///< Execution number from the service, 0 if unknown
+	AwsIotJobsRunner *pRunner;                                     ///< Runner the execution belongs to
+	AwsIotJobsRunnerSlotState state;                               ///< Position in the execution lifecycle
+	int8_t handlerIndex;                                           ///< Index into the registered handlers, -1 if none
+	uint32_t sequence;                                             ///< Arrival order, workers take the oldest queued execution
+	JobExecutionStatus status;                                     ///< Status to publish
+	char statusDetails[JOBS_RUNNER_MAX_STATUS_DETAILS_LENGTH + 1]; ///< Latest statusDetails object, empty if none
+	bool updatePending;                                            ///< Status or details changed since the last publish
+	bool published;                                                ///< At least one update for this execution was published
+	Timer coalesceTimer;                                           ///< No IN_PROGRESS update before this expires
+	Timer heartbeatTimer;                                          ///< Publish IN_PROGRESS again when this expires
+};
+
+/**
+ * @brief Runner tuning
+ *
+ * @note Always use the \c JobsRunnerParamsDefault to initialize this struct
+ */
+typedef struct {
+	QoS qos;                     ///< QoS of subscriptions and published updates
+	uint8_t maxConcurrentJobs;   ///< Executions that may run at the same time, at most JOBS_RUNNER_QUEUE_LENGTH
+	uint32_t coalesceWindowMs;   ///< Minimum time between two IN_PROGRESS updates of one execution
+	uint32_t heartbeatIntervalMs; ///< IN_PROGRESS is republished after this long without an update, 0 disables heartbeats
+} AwsIotJobsRunnerParams;
+
+/**
+ * @brief Default runner parameters
+ *
+ * QOS0, JOBS_RUNNER_MAX_CONCURRENT_JOBS, one second coalescing window and a one minute heartbeat.
+ *
+ * \relates AwsIotJobsRunnerParams
+ */
+extern const AwsIotJobsRunnerParams JobsRunnerParamsDefault;
+
+typedef struct {
+	char operation[JOBS_RUNNER_MAX_OPERATION_LENGTH + 1];
+	uint8_t operationLength;
+	AwsIotJobsRunnerHandler pHandler;
+	void *pHandlerData;
+} AwsIotJobsRunnerHandlerEntry;
+
+/**
+ * @brief Runner state
+ *
+ * Initialize with #aws_iot_jobs_runner_init. All fields are private to the implementation.
+ */
+struct AwsIotJobsRunner {
+	AWS_IoT_Client *pClient;
+	AwsIotJobsRunnerParams params;
+	char thingName[MAX_SIZE_OF_THING_NAME + 1];
+	AwsIotJobsRunnerHandlerEntry handlers[JOBS_RUNNER_MAX_HANDLERS];
+	uint8_t handlerCount;
+	AwsIotJobsRunnerExecution executions[JOBS_RUNNER_QUEUE_LENGTH];
+	uint32_t nextSequence;
+	uint8_t runningCount;
+	bool startNextWanted;
+	jsmntok_t tokens[MAX_JOB_JSON_TOKEN_EXPECTED];
+	char notifyNextTopic[JOBS_RUNNER_TOPIC_BUFFER_LENGTH];
+	char startNextTopic[JOBS_RUNNER_TOPIC_BUFFER_LENGTH];
+	char topicBuffer[JOBS_RUNNER_TOPIC_BUFFER_LENGTH];
+	char messageBuffer[JOBS_RUNNER_MESSAGE_BUFFER_LENGTH];
+	char jobIdScratch[MAX_SIZE_OF_JOB_ID + 1];
+	char statusDetailsScratch[JOBS_RUNNER_MAX_STATUS_DETAILS_LENGTH + 1];
+#ifdef _ENABLE_THREAD_SUPPORT_
+	IoT_Mutex_t lock;
+#endif
+};
+
+/**
+ * @brief Prepare a runner for a thing
+ *
+ * \param pRunner the runner to initialize
+ * \param pClient a connected MQTT client, used only from #aws_iot_jobs_runner_start and
+ *   #aws_iot_jobs_runner_process
+ * \param thingName the thing to execute jobs for, copied into the runner
+ * \param pParams tuning, see \c JobsRunnerParamsDefault
+ * \return SUCCESS, NULL_VALUE_ERROR, MAX_SIZE_ERROR for a thing name longer than
+ *   MAX_SIZE_OF_THING_NAME or LIMIT_EXCEEDED_ERROR for an invalid maxConcurrentJobs
+ */
+IoT_Error_t aws_iot_jobs_runner_init(AwsIotJobsRunner *pRunner, AWS_IoT_Client *pClient,
+		const char *thingName, const AwsIotJobsRunnerParams *pParams);
+
+/**
+ * @brief Register the handler for one job operation
+ *
+ * Jobs are dispatched by the "operation" string of their job document. Executions with an
+ * operation that has no handler are reported as REJECTED. Register all handlers before
+ * calling #aws_iot_jobs_runner_start.
+ *
+ * \param pRunner the runner
+ * \param operation the operation name
+ * \param pHandler the handler
+ * \param pHandlerData passed to the handler on every call
+ * \return SUCCESS, NULL_VALUE_ERROR, MAX_SIZE_ERROR for a long operation name or
+ *   LIMIT_EXCEEDED_ERROR when JOBS_RUNNER_MAX_HANDLERS are already registered
+ */
+IoT_Error_t aws_iot_jobs_runner_register_handler(AwsIotJobsRunner *pRunner, const char *operation,
+		AwsIotJobsRunnerHandler pHandler, void *pHandlerData);
+
+/**
+ * @brief Subscribe to the job topics of the thing and ask for the next pending execution
+ *
+ * \param pRunner the runner
+ * \return the result of the subscriptions and of the start-next publish
+ */
+IoT_Error_t aws_iot_jobs_runner_start(AwsIotJobsRunner *pRunner);
+
+/**
+ * @brief Unsubscribe from the job topics
+ *
+ * Executions that are still queued are dropped, running handlers are not interrupted.
+ *
+ * \param pRunner the runner
+ * \return the result of the unsubscriptions
+ */
+IoT_Error_t aws_iot_jobs_runner_stop(AwsIotJobsRunner *pRunner);
+
+/**
+ * @brief Run the oldest queued execution, if the concurrency limit allows it
+ *
+ * Safe to call from several worker threads when the SDK is built with _ENABLE_THREAD_SUPPORT_,
+ * each call runs at most one handler to completion.
+ *
+ * \param pRunner the runner
+ * \return true if a handler was run
+ */
+bool aws_iot_jobs_runner_work(AwsIotJobsRunner *pRunner);
+
+/**
+ * @brief Publish pending status updates
+ *
+ * Must be called regularly from the thread that owns the MQTT client, typically right after
+ * aws_iot_mqtt_yield. Publishes the terminal status of finished executions and frees their
+ * slots, publishes IN_PROGRESS updates whose coalescing window has passed and heartbeats,
+ * and asks for the next pending execution when a slot has become free.
+ *
+ * \param pRunner the runner
+ * \return SUCCESS or the first publish error, updates that failed are retried on the next call
+ */
+IoT_Error_t aws_iot_jobs_runner_process(AwsIotJobsRunner *pRunner);
+
+/**
+ * @brief Report the progress of a running execution
+ *
+ * Only stores the details, the update is published by #aws_iot_jobs_runner_process once the
+ * coalescing window of the execution has passed. Reports made in between replace each other.
+ *
+ * \param pExecution the execution passed to the handler
+ * \param statusDetails a JSON object of string values, or NULL to keep the previous details
+ * \return SUCCESS, NULL_VALUE_ERROR or MAX_SIZE_ERROR if the details do not fit
+ *   JOBS_RUNNER_MAX_STATUS_DETAILS_LENGTH
+ */
+IoT_Error_t aws_iot_jobs_runner_report_progress(AwsIotJobsRunnerExecution *pExecution, const char *statusDetails);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AWS_IOT_JOBS_RUNNER_H_ */
@@ -29,6 +29,8 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "aws_iot_config.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -81,6 +83,68 @@ int aws_iot_jobs_get_api_topic(char *buffer, size_t bufferSize,
 		AwsIotJobExecutionTopicType topicType, AwsIotJobExecutionTopicReplyType replyType,
 		const char* thingName, const char* jobId);
 
+/** Length of "$aws/things/{thingName}/jobs/" for the longest thing name */
+#define JOB_TOPIC_CACHE_PREFIX_MAX_LENGTH (sizeof("$aws/things/") - 1 + MAX_SIZE_OF_THING_NAME + sizeof("/jobs/") - 1)
+
+/** Longest topic tail that does not contain a job id */
+#define JOB_TOPIC_CACHE_TAIL_MAX_LENGTH (sizeof("start-next/accepted") - 1)
+
+/** Number of topics that do not contain a job id: get and start-next with every reply type, notify, notify-next, # */
+#define JOB_TOPIC_CACHE_ENTRIES 11
+
+/**
+ * Every Jobs topic of one thing, formatted once.
+ *
+ * Topics without a job id are stored complete. Topics with a job id are spliced together
+ * from the stored prefix, the job id and a constant tail.
+ */
+typedef struct {
+	char thingName[MAX_SIZE_OF_THING_NAME + 1];
+	uint16_t prefixLength;
+	uint16_t topicLengths[JOB_TOPIC_CACHE_ENTRIES];
+	char topics[JOB_TOPIC_CACHE_ENTRIES][JOB_TOPIC_CACHE_PREFIX_MAX_LENGTH + JOB_TOPIC_CACHE_TAIL_MAX_LENGTH + 1];
+} AwsIotJobTopicCache;
+
+/**
+ * @brief Format every topic of a thing into the cache.
+ *
+ * \param cache the cache to fill
+ * \param thingName the name of the thing in the topics
+ * \return 0 on success, -1 if the thing name is NULL or longer than MAX_SIZE_OF_THING_NAME
+ */
+int aws_iot_jobs_topic_cache_init(AwsIotJobTopicCache *cache, const char *thingName);
+
+/**
+ * @brief Check whether the cache holds the topics of a thing.
+ *
+ * \param cache an initialized cache
+ * \param thingName the name of the thing
+ * \return true if the cache was initialized for thingName
+ */
+bool aws_iot_jobs_topic_cache_matches(const AwsIotJobTopicCache *cache, const char *thingName);
+
+/**
+ * @brief Get a topic from the cache.
+ *
+ * Accepts the same combinations as aws_iot_jobs_get_api_topic. Topics without a job id are
+ * returned from the cache and the buffer is not touched. Topics with a job id are spliced into
+ * the buffer if it is large enough.
+ *
+ * \param cache an initialized cache
+ * \param topicType the type of the topic
+ * \param replyType the reply type of the topic
+ * \param jobId the name of the job id in the topic
+ * \param topic set to the null terminated topic on success
+ * \param buffer the buffer for topics with a job id
+ * \param bufferSize the size of the buffer
+ * \return the number of characters in the topic excluding the null terminator, -1 on invalid
+ *   arguments. A return value of bufferSize or more for a topic with a job id means that the
+ *   buffer was too small and topic was not set.
+ */
+int aws_iot_jobs_topic_cache_get(const AwsIotJobTopicCache *cache,
+		AwsIotJobExecutionTopicType topicType, AwsIotJobExecutionTopicReplyType replyType,
+		const char *jobId, const char **topic, char *buffer, size_t bufferSize);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2015-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ * http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file aws_iot_json_scan.h
+ * @brief Word-parallel JSON tokenizer producing jsmn tokens.
+ *
+ * A drop-in replacement for jsmn_parse that finds the end of strings and runs of whitespace
+ * several bytes at a time: SWAR on 32/64-bit words everywhere, SSE2 or NEON when the host
+ * compiler provides them. Structural handling follows jsmn exactly, including JSMN_STRICT and
+ * JSMN_PARENT_LINKS, so the tokens, return value and parser state after a call are identical
+ * to those of jsmn_parse for the same input.
+ *
+ * Shadow parsing uses it when AWS_IOT_JSON_FAST_SCAN is defined in aws_iot_config.h.
+ */
+
+#ifndef AWS_IOT_SDK_SRC_JSON_SCAN_H_
+#define AWS_IOT_SDK_SRC_JSON_SCAN_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+
+#include "jsmn.h"
+
+/**
+ * @brief Tokenize a JSON document
+ *
+ * Same contract as jsmn_parse: the parser must be initialized with jsmn_init, parsing stops at
+ * len or the first NUL byte, and a NULL token array only counts the tokens.
+ *
+ * @param pParser jsmn parser state
+ * @param pJson JSON document
+ * @param len length of the document
+ * @param pTokens token array to fill, or NULL
+ * @param numTokens number of entries in pTokens
+ * @return number of tokens, or one of JSMN_ERROR_NOMEM, JSMN_ERROR_INVAL, JSMN_ERROR_PART
+ */
+int aws_iot_json_scan_parse(jsmn_parser *pParser, const char *pJson, size_t len,
+							jsmntok_t *pTokens, unsigned int numTokens);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AWS_IOT_SDK_SRC_JSON_SCAN_H_ */
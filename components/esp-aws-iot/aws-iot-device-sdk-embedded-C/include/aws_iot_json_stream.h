@@ -0,0 +1,116 @@
+/*
+ * Copyright 2015-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at
+ *
+ * http://aws.amazon.com/apache2.0
+ *
+ * or in the "license" file accompanying this file. This file is distributed
+ * on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file aws_iot_json_stream.h
+ * @brief Resumable JSON tokenizer for documents that arrive in pieces.
+ *
+ * Wraps the Jasmine parser so a document can be tokenized while it is still being received.
+ * Chunks must be appended to one contiguous receive buffer, the tokens index into it the same
+ * way they index into a fully buffered document, so no second copy of the payload is needed.
+ *
+ * Only complete tokens are ever handed to jsmn: the stream tracks string and nesting state
+ * for every received byte and holds back a string or primitive that is cut by the end of
+ * a chunk until the rest of it arrives.
+ */
+
+#ifndef AWS_IOT_SDK_SRC_JSON_STREAM_H_
+#define AWS_IOT_SDK_SRC_JSON_STREAM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "jsmn.h"
+
+/**
+ * @brief Incremental tokenizer state
+ *
+ * Initialize with \c aws_iot_json_stream_init. All fields are private to the implementation.
+ */
+typedef struct {
+	jsmn_parser parser;          ///< Parser filling the caller's token array
+	jsmn_parser countParser;     ///< Parser that only counts tokens once the token array is full
+	jsmntok_t *pTokens;          ///< Caller provided token array
+	unsigned int maxTokens;      ///< Number of entries in pTokens
+	bool countOnOverflow;        ///< Keep counting the needed tokens instead of failing with JSMN_ERROR_NOMEM
+	bool overflowed;             ///< pTokens ran out, countParser is in use
+	unsigned int tokensNeeded;   ///< Tokens the document needs, valid once overflowed
+	const char *pJson;           ///< Start of the receive buffer
+	size_t receivedLen;          ///< Bytes received so far
+	size_t parsedLen;            ///< Bytes handed to jsmn, always ends on a token boundary
+	uint16_t depth;              ///< Current object/array nesting outside of strings
+	bool inString;               ///< Last received byte is inside a string
+	bool escaped;                ///< Last received byte is a backslash inside a string
+	bool complete;               ///< The top level value has been closed
+	int error;                   ///< First jsmn error, reported by every later call
+} AwsIotJsonStream;
+
+/**
+ * @brief Prepare a stream for a new document
+ *
+ * @param pStream stream to initialize
+ * @param pJson start of the buffer the document is received into
+ * @param pTokens token array to fill
+ * @param maxTokens number of entries in pTokens
+ * @param countOnOverflow when true, running out of tokens does not fail the stream, the remaining
+ *        input is only counted and the total is reported by \c aws_iot_json_stream_tokens_needed
+ */
+void aws_iot_json_stream_init(AwsIotJsonStream *pStream, const char *pJson, jsmntok_t *pTokens,
+							  unsigned int maxTokens, bool countOnOverflow);
+
+/**
+ * @brief Tokenize the next received chunk
+ *
+ * The chunk must directly follow the bytes passed on previous calls in the receive buffer.
+ *
+ * @param pStream stream to feed
+ * @param pChunk start of the newly received bytes
+ * @param chunkLen number of newly received bytes
+ * @return number of tokens once the top level object or array is complete,
+ *         JSMN_ERROR_PART while more input is expected,
+ *         JSMN_ERROR_INVAL on malformed JSON or a chunk that is not contiguous,
+ *         JSMN_ERROR_NOMEM when the token array is too small (and countOnOverflow is false,
+ *         or once the document is complete if it is true)
+ */
+int aws_iot_json_stream_feed(AwsIotJsonStream *pStream, const char *pChunk, size_t chunkLen);
+
+/**
+ * @brief Signal the end of the input
+ *
+ * Flushes a held back top level primitive, then reports the final result.
+ *
+ * @param pStream stream to finish
+ * @return same values as \c aws_iot_json_stream_feed, JSMN_ERROR_PART if the document is truncated
+ */
+int aws_iot_json_stream_finish(AwsIotJsonStream *pStream);
+
+/**
+ * @brief Tokens required to hold the whole document
+ *
+ * @param pStream stream in count-on-overflow mode
+ * @return the number of tokens the document needs, as far as it has been received
+ */
+unsigned int aws_iot_json_stream_tokens_needed(const AwsIotJsonStream *pStream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AWS_IOT_SDK_SRC_JSON_STREAM_H_ */
@@ -73,6 +73,7 @@ typedef struct {
 	const char *pMqttClientId; ///< Currently the Shadow uses MQTT to connect and it is important to ensure we have unique client id
 	uint16_t mqttClientIdLen; ///< Currently the Shadow uses MQTT to connect and it is important to ensure we have unique client id
 	pApplicationHandler_t deleteActionHandler;	///< Callback to be invoked when Thing shadow for this device is deleted
+	bool enableWildcardAckSubscription; ///< Subscribe once to $aws/things/{thingName}/shadow/+/+ at connect and route every accepted/rejected response by client token, instead of subscribing and un-subscribing around each action on this Thing Name
 } ShadowConnectParameters_t;
 
 /*!
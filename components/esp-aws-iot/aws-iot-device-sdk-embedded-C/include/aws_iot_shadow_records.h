@@ -38,12 +38,14 @@ void initializeRecords(AWS_IoT_Client *pClient);
 bool isSubscriptionPresent(const char *pThingName, ShadowActions_t action);
 IoT_Error_t subscribeToShadowActionAcks(const char *pThingName, ShadowActions_t action, bool isSticky);
 void incrementSubscriptionCnt(const char *pThingName, ShadowActions_t action, bool isSticky);
+IoT_Error_t subscribeToShadowWildcardAcks(const char *pThingName);
 
 IoT_Error_t publishToShadowAction(const char *pThingName, ShadowActions_t action, const char *pJsonDocumentToBeSent);
 void addToAckWaitList(uint8_t indexAckWaitList, const char *pThingName, ShadowActions_t action,
 					  const char *pExtractedClientToken, fpActionCallback_t callback, void *pCallbackContext,
 					  uint32_t timeout_seconds);
 bool getNextFreeIndexOfAckWaitList(uint8_t *pIndex);
+bool getNextFreeIndexOfAckWaitListForToken(const char *pClientToken, uint8_t *pIndex);
 void HandleExpiredResponseCallbacks(void);
 void initDeltaTokens(void);
 IoT_Error_t registerJsonTokenOnDelta(jsonStruct_t *pStruct);
@@ -29,6 +29,24 @@ extern "C" {
 		return LIMIT_EXCEEDED_ERROR; \
 	}
 
+/* Topics of the last thing the API was used with, rebuilt when the thing changes */
+static AwsIotJobTopicCache _topic_cache;
+static bool _topic_cache_valid = false;
+
+static int _get_topic(AwsIotJobExecutionTopicType topicType, AwsIotJobExecutionTopicReplyType replyType,
+		const char *thingName, const char *jobId, char *topicBuffer, uint16_t topicBufferSize, const char **topic)
+{
+	if (!_topic_cache_valid || !aws_iot_jobs_topic_cache_matches(&_topic_cache, thingName)) {
+		_topic_cache_valid = (aws_iot_jobs_topic_cache_init(&_topic_cache, thingName) == 0);
+	}
+
+	if (!_topic_cache_valid) {
+		*topic = topicBuffer;
+		return aws_iot_jobs_get_api_topic(topicBuffer, topicBufferSize, topicType, replyType, thingName, jobId);
+	}
+
+	return aws_iot_jobs_topic_cache_get(&_topic_cache, topicType, replyType, jobId, topic, topicBuffer, topicBufferSize);
+}
 
 IoT_Error_t aws_iot_jobs_subscribe_to_job_messages(
 		AWS_IoT_Client *pClient, QoS qos,
@@ -41,10 +59,16 @@ IoT_Error_t aws_iot_jobs_subscribe_to_job_messages(
 		char *topicBuffer,
 		uint16_t topicBufferSize)
 {
-	int requiredSize = aws_iot_jobs_get_api_topic(topicBuffer, topicBufferSize, topicType, replyType, thingName, jobId);
+	const char *topic;
+	int requiredSize = _get_topic(topicType, replyType, thingName, jobId, topicBuffer, topicBufferSize, &topic);
 	CHECK_GENERATE_STRING_RESULT(requiredSize, topicBufferSize);
 
-	return aws_iot_mqtt_subscribe(pClient, topicBuffer, (uint16_t)strlen(topicBuffer), qos, pApplicationHandler, pApplicationHandlerData);
+	/* The MQTT client keeps the topic pointer, it has to be the caller's buffer */
+	if (topic != topicBuffer) {
+		memcpy(topicBuffer, topic, (size_t) requiredSize + 1);
+	}
+
+	return aws_iot_mqtt_subscribe(pClient, topicBuffer, (uint16_t) requiredSize, qos, pApplicationHandler, pApplicationHandlerData);
 }
 
 IoT_Error_t aws_iot_jobs_subscribe_to_all_job_messages(
@@ -81,7 +105,8 @@ IoT_Error_t aws_iot_jobs_send_query(
 		return NULL_VALUE_ERROR;
 	}
 
-	int neededSize = aws_iot_jobs_get_api_topic(topicBuffer, topicBufferSize, topicType, JOB_REQUEST_TYPE, thingName, jobId);
+	const char *topic;
+	int neededSize = _get_topic(topicType, JOB_REQUEST_TYPE, thingName, jobId, topicBuffer, topicBufferSize, &topic);
 	CHECK_GENERATE_STRING_RESULT(neededSize, topicBufferSize);
 	uint16_t topicSize = (uint16_t) neededSize;
 
@@ -104,7 +129,7 @@ IoT_Error_t aws_iot_jobs_send_query(
 	publishParams.payload = messageBuffer;
 	publishParams.payloadLen = messageLength;
 
-	return aws_iot_mqtt_publish(pClient, topicBuffer, topicSize, &publishParams);
+	return aws_iot_mqtt_publish(pClient, topic, topicSize, &publishParams);
 }
 
 IoT_Error_t aws_iot_jobs_start_next(
@@ -120,7 +145,8 @@ IoT_Error_t aws_iot_jobs_start_next(
 		return NULL_VALUE_ERROR;
 	}
 
-	int neededSize = aws_iot_jobs_get_api_topic(topicBuffer, topicBufferSize, JOB_START_NEXT_TOPIC, JOB_REQUEST_TYPE, thingName, NULL);
+	const char *topic;
+	int neededSize = _get_topic(JOB_START_NEXT_TOPIC, JOB_REQUEST_TYPE, thingName, NULL, topicBuffer, topicBufferSize, &topic);
 	CHECK_GENERATE_STRING_RESULT(neededSize, topicBufferSize);
 	uint16_t topicSize = (uint16_t) neededSize;
 
@@ -135,7 +161,7 @@ IoT_Error_t aws_iot_jobs_start_next(
 	publishParams.payload = messageBuffer;
 	publishParams.payloadLen = (size_t) serializeResult;
 
-	return aws_iot_mqtt_publish(pClient, topicBuffer, topicSize, &publishParams);
+	return aws_iot_mqtt_publish(pClient, topic, topicSize, &publishParams);
 }
 
 IoT_Error_t aws_iot_jobs_describe(
@@ -152,7 +178,8 @@ IoT_Error_t aws_iot_jobs_describe(
 		return NULL_VALUE_ERROR;
 	}
 
-	int neededSize = aws_iot_jobs_get_api_topic(topicBuffer, topicBufferSize, JOB_DESCRIBE_TOPIC, JOB_REQUEST_TYPE, thingName, jobId);
+	const char *topic;
+	int neededSize = _get_topic(JOB_DESCRIBE_TOPIC, JOB_REQUEST_TYPE, thingName, jobId, topicBuffer, topicBufferSize, &topic);
 	CHECK_GENERATE_STRING_RESULT(neededSize, topicBufferSize);
 	uint16_t topicSize = (uint16_t) neededSize;
 
@@ -175,7 +202,7 @@ IoT_Error_t aws_iot_jobs_describe(
 	publishParams.payload = messageBuffer;
 	publishParams.payloadLen = messageLength;
 
-	return aws_iot_mqtt_publish(pClient, topicBuffer, topicSize, &publishParams);
+	return aws_iot_mqtt_publish(pClient, topic, topicSize, &publishParams);
 }
 
 IoT_Error_t aws_iot_jobs_send_update(
@@ -192,7 +219,8 @@ IoT_Error_t aws_iot_jobs_send_update(
 		return NULL_VALUE_ERROR;
 	}
 
-	int neededSize = aws_iot_jobs_get_api_topic(topicBuffer, topicBufferSize, JOB_UPDATE_TOPIC, JOB_REQUEST_TYPE, thingName, jobId);
+	const char *topic;
+	int neededSize = _get_topic(JOB_UPDATE_TOPIC, JOB_REQUEST_TYPE, thingName, jobId, topicBuffer, topicBufferSize, &topic);
 	CHECK_GENERATE_STRING_RESULT(neededSize, topicBufferSize);
 	uint16_t topicSize = (uint16_t) neededSize;
 
@@ -207,7 +235,7 @@ IoT_Error_t aws_iot_jobs_send_update(
 	publishParams.payload = messageBuffer;
 	publishParams.payloadLen = (size_t) serializeResult;
 
-	return aws_iot_mqtt_publish(pClient, topicBuffer, topicSize, &publishParams);
+	return aws_iot_mqtt_publish(pClient, topic, topicSize, &publishParams);
 }
 
 #ifdef __cplusplus
@@ -22,8 +22,6 @@ extern "C" {
 #include <stdbool.h>
 #include <stdlib.h>
 #include <stddef.h>
-#include <stdio.h>
-#include <stdarg.h>
 
 #include "jsmn.h"
 #include "aws_iot_jobs_json.h"
@@ -34,54 +32,76 @@ struct _SerializeState {
 	size_t remaingSize;
 };
 
-static void _printToBuffer(struct _SerializeState *state, const char *fmt, ...) {
+/**
+ * Append len bytes with the same truncation and termination rules as snprintf, without
+ * going through the format parser for what are always literal keys and values.
+ */
+static void _appendToBuffer(struct _SerializeState *state, const char *str, size_t len) {
 	if (state->totalSize == -1) return;
 
-	va_list vl;
-	va_start(vl, fmt);
-	int len = vsnprintf(state->nextPtr, state->remaingSize, fmt, vl);
-	if (len < 0) {
-		state->totalSize = -1;
-	} else {
-		state->totalSize += len;
-		if (state->nextPtr != NULL) {
-			if (state->remaingSize > (size_t) len) {
-				state->remaingSize -= (size_t) len;
-				state->nextPtr += len;
-			} else {
-				state->remaingSize = 0;
-				state->nextPtr = NULL;
-			}
+	state->totalSize += (int) len;
+	if (state->nextPtr != NULL && state->remaingSize > 0) {
+		if (state->remaingSize > len) {
+			memcpy(state->nextPtr, str, len);
+			state->nextPtr += len;
+			state->remaingSize -= len;
+			*state->nextPtr = '\0';
+		} else {
+			memcpy(state->nextPtr, str, state->remaingSize - 1);
+			state->nextPtr[state->remaingSize - 1] = '\0';
+			state->remaingSize = 0;
+			state->nextPtr = NULL;
 		}
 	}
-	va_end(vl);
+}
+
+#define _appendLiteral(state, literal) _appendToBuffer((state), (literal), sizeof(literal) - 1)
+
+static void _printString(struct _SerializeState *state, const char *str) {
+	_appendToBuffer(state, str, strlen(str));
 }
 
 static void _printKey(struct _SerializeState *state, bool first, const char *key) {
 	if (first) {
-		_printToBuffer(state, "{\"%s\":", key);
+		_appendLiteral(state, "{\"");
 	} else {
-		_printToBuffer(state, ",\"%s\":", key);
+		_appendLiteral(state, ",\"");
 	}
+	_printString(state, key);
+	_appendLiteral(state, "\":");
 }
 
 static void _printStringValue(struct _SerializeState *state, const char *value) {
 	if (value == NULL) {
-		_printToBuffer(state, "null");
+		_appendLiteral(state, "null");
 	} else {
-		_printToBuffer(state, "\"%s\"", value);
+		_appendLiteral(state, "\"");
+		_printString(state, value);
+		_appendLiteral(state, "\"");
 	}
 }
 
 static void _printLongValue(struct _SerializeState *state, int64_t value) {
-	_printToBuffer(state, "%lld", value);
+	char digits[21];
+	char *pDigit = digits + sizeof(digits);
+	uint64_t magnitude = (value < 0) ? (0 - (uint64_t) value) : (uint64_t) value;
+
+	do {
+		*--pDigit = (char) ('0' + (magnitude % 10));
+		magnitude /= 10;
+	} while (magnitude != 0);
+	if (value < 0) {
+		*--pDigit = '-';
+	}
+
+	_appendToBuffer(state, pDigit, (size_t) (digits + sizeof(digits) - pDigit));
 }
 
 static void _printBooleanValue(struct _SerializeState *state, bool value) {
 	if(value) {
-		_printToBuffer(state, "true");
+		_appendLiteral(state, "true");
 	} else {
-		_printToBuffer(state, "false");
+		_appendLiteral(state, "false");
 	}
 }
 
@@ -98,7 +118,7 @@ int aws_iot_jobs_json_serialize_update_job_execution_request(
 	_printStringValue(&state, statusStr);
 	if (request->statusDetails != NULL) {
 		_printKey(&state, false, "statusDetails");
-		_printToBuffer(&state, "%s", request->statusDetails);
+		_printString(&state, request->statusDetails);
 	}
 	if (request->executionNumber != 0) {
 		_printKey(&state, false, "executionNumber");
@@ -121,7 +141,7 @@ int aws_iot_jobs_json_serialize_update_job_execution_request(
 		_printStringValue(&state, request->clientToken);
 	}
 
-	_printToBuffer(&state, "}");
+	_appendLiteral(&state, "}");
 
 	return state.totalSize;
 }
@@ -133,7 +153,7 @@ int aws_iot_jobs_json_serialize_client_token_only_request(
 	struct _SerializeState state = { 0, requestBuffer, bufferSize };
 	_printKey(&state, true, "clientToken");
 	_printStringValue(&state, clientToken);
-	_printToBuffer(&state, "}");
+	_appendLiteral(&state, "}");
 
 	return state.totalSize;
 }
@@ -162,7 +182,7 @@ int aws_iot_jobs_json_serialize_describe_job_execution_request(
 		_printBooleanValue(&state, request->includeJobDocument);
 	}
 
-	_printToBuffer(&state, "}");
+	_appendLiteral(&state, "}");
 
 	return state.totalSize;
 }
@@ -175,7 +195,7 @@ int aws_iot_jobs_json_serialize_start_next_job_execution_request(
 	struct _SerializeState state = { 0, requestBuffer, bufferSize };
 	if (request->statusDetails != NULL) {
 		_printKey(&state, true, "statusDetails");
-		_printToBuffer(&state, "%s", request->statusDetails);
+		_printString(&state, request->statusDetails);
 	}
 	if (request->clientToken != NULL) {
 		if(request->statusDetails != NULL) {
@@ -186,9 +206,9 @@ int aws_iot_jobs_json_serialize_start_next_job_execution_request(
 		_printStringValue(&state, request->clientToken);
 	}
 	if (request->clientToken == NULL && request->statusDetails == NULL) {
-		_printToBuffer(&state, "{");
+		_appendLiteral(&state, "{");
 	}
-	_printToBuffer(&state, "}");
+	_appendLiteral(&state, "}");
 	return state.totalSize;
 }
 
@@ -0,0 +1,504 @@
+/*
+* Copyright 2015-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+* http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+
+#include "aws_iot_jobs_runner.h"
+#include "aws_iot_jobs_interface.h"
+#include "aws_iot_log.h"
+
+#define UNSUPPORTED_OPERATION_DETAILS "{\"reason\":\"unsupported operation\"}"
+#define DOCUMENT_TOO_LARGE_DETAILS "{\"reason\":\"job document too large\"}"
+
+const AwsIotJobsRunnerParams JobsRunnerParamsDefault = {QOS0, JOBS_RUNNER_MAX_CONCURRENT_JOBS, 1000, 60000};
+
+static void _lock(AwsIotJobsRunner *pRunner) {
+#ifdef _ENABLE_THREAD_SUPPORT_
+	IoT_Error_t rc = aws_iot_thread_mutex_lock(&pRunner->lock);
+	IOT_UNUSED(rc);
+#else
+	IOT_UNUSED(pRunner);
+#endif
+}
+
+static void _unlock(AwsIotJobsRunner *pRunner) {
+#ifdef _ENABLE_THREAD_SUPPORT_
+	IoT_Error_t rc = aws_iot_thread_mutex_unlock(&pRunner->lock);
+	IOT_UNUSED(rc);
+#else
+	IOT_UNUSED(pRunner);
+#endif
+}
+
+static bool _token_equals(const char *json, const jsmntok_t *pToken, const char *str, size_t strLength) {
+	return pToken->type == JSMN_STRING && (size_t) (pToken->end - pToken->start) == strLength
+			&& memcmp(json + pToken->start, str, strLength) == 0;
+}
+
+/**
+ * Index of the value of key in the object at objectIndex, or -1. Nested values are skipped
+ * by offset so a key deeper in the tree never matches.
+ */
+static int _find_member(const char *json, const jsmntok_t *pTokens, int tokenCount, int objectIndex, const char *key) {
+	size_t keyLength = strlen(key);
+	int objectEnd = pTokens[objectIndex].end;
+	int i = objectIndex + 1;
+
+	if (pTokens[objectIndex].type != JSMN_OBJECT) {
+		return -1;
+	}
+
+	while (i + 1 < tokenCount && pTokens[i].start < objectEnd) {
+		int valueIndex = i + 1;
+		if (_token_equals(json, &pTokens[i], key, keyLength)) {
+			return valueIndex;
+		}
+		i = valueIndex + 1;
+		while (i < tokenCount && pTokens[i].start < pTokens[valueIndex].end) {
+			i++;
+		}
+	}
+
+	return -1;
+}
+
+static bool _parse_int64(const char *json, const jsmntok_t *pToken, int64_t *pValue) {
+	const char *p = json + pToken->start;
+	const char *end = json + pToken->end;
+	bool negative = false;
+	int64_t value = 0;
+
+	if (pToken->type != JSMN_PRIMITIVE || p == end) {
+		return false;
+	}
+	if (*p == '-') {
+		negative = true;
+		p++;
+	}
+	if (p == end) {
+		return false;
+	}
+	for (; p < end; p++) {
+		if (*p < '0' || *p > '9') {
+			return false;
+		}
+		value = value * 10 + (*p - '0');
+	}
+
+	*pValue = negative ? -value : value;
+	return true;
+}
+
+static int8_t _find_handler(const AwsIotJobsRunner *pRunner, const char *json, const jsmntok_t *pToken) {
+	uint8_t i;
+
+	for (i = 0; i < pRunner->handlerCount; i++) {
+		if (_token_equals(json, pToken, pRunner->handlers[i].operation, pRunner->handlers[i].operationLength)) {
+			return (int8_t) i;
+		}
+	}
+	return -1;
+}
+
+static AwsIotJobsRunnerExecution *_claim_slot(AwsIotJobsRunner *pRunner, const char *jobId, size_t jobIdLength,
+		bool *pDuplicate) {
+	AwsIotJobsRunnerExecution *pFree = NULL;
+	size_t i;
+
+	*pDuplicate = false;
+	for (i = 0; i < JOBS_RUNNER_QUEUE_LENGTH; i++) {
+		AwsIotJobsRunnerExecution *pExecution = &pRunner->executions[i];
+		if (pExecution->state == JOBS_RUNNER_SLOT_FREE) {
+			if (pFree == NULL) {
+				pFree = pExecution;
+			}
+		} else if (strlen(pExecution->jobId) == jobIdLength && memcmp(pExecution->jobId, jobId, jobIdLength) == 0) {
+			/* notify-next and start-next both report an execution until it is terminal */
+			*pDuplicate = true;
+			return NULL;
+		}
+	}
+	return pFree;
+}
+
+static void _enqueue_execution(AwsIotJobsRunner *pRunner, const char *json, int tokenCount, int executionIndex) {
+	const jsmntok_t *pTokens = pRunner->tokens;
+	int jobIdIndex = _find_member(json, pTokens, tokenCount, executionIndex, "jobId");
+	int documentIndex = _find_member(json, pTokens, tokenCount, executionIndex, "jobDocument");
+	int executionNumberIndex = _find_member(json, pTokens, tokenCount, executionIndex, "executionNumber");
+	int operationIndex = -1;
+	AwsIotJobsRunnerExecution *pExecution;
+	bool duplicate;
+	size_t jobIdLength;
+	size_t documentLength = 0;
+
+	if (jobIdIndex < 0 || pTokens[jobIdIndex].type != JSMN_STRING) {
+		IOT_WARN("Jobs runner: execution without a jobId");
+		return;
+	}
+	jobIdLength = (size_t) (pTokens[jobIdIndex].end - pTokens[jobIdIndex].start);
+	if (jobIdLength == 0 || jobIdLength > MAX_SIZE_OF_JOB_ID) {
+		IOT_WARN("Jobs runner: jobId longer than MAX_SIZE_OF_JOB_ID");
+		return;
+	}
+	if (documentIndex >= 0) {
+		documentLength = (size_t) (pTokens[documentIndex].end - pTokens[documentIndex].start);
+		operationIndex = _find_member(json, pTokens, tokenCount, documentIndex, "operation");
+	}
+
+	_lock(pRunner);
+	pExecution = _claim_slot(pRunner, json + pTokens[jobIdIndex].start, jobIdLength, &duplicate);
+	if (pExecution == NULL) {
+		if (!duplicate) {
+			/* Dropped, it is asked for again with start-next once a slot is free */
+			IOT_WARN("Jobs runner: queue full, dropping execution");
+			pRunner->startNextWanted = true;
+		}
+		_unlock(pRunner);
+		return;
+	}
+
+	memset(pExecution, 0, sizeof(AwsIotJobsRunnerExecution));
+	pExecution->pRunner = pRunner;
+	memcpy(pExecution->jobId, json + pTokens[jobIdIndex].start, jobIdLength);
+	pExecution->jobId[jobIdLength] = '\0';
+	if (executionNumberIndex < 0 || !_parse_int64(json, &pTokens[executionNumberIndex], &pExecution->executionNumber)) {
+		pExecution->executionNumber = 0;
+	}
+	pExecution->handlerIndex = (operationIndex >= 0) ? _find_handler(pRunner, json, &pTokens[operationIndex]) : -1;
+	pExecution->sequence = pRunner->nextSequence++;
+	init_timer(&pExecution->coalesceTimer);
+	init_timer(&pExecution->heartbeatTimer);
+
+	if (documentLength > JOBS_RUNNER_MAX_DOCUMENT_LENGTH) {
+		pExecution->status = JOB_EXECUTION_FAILED;
+		memcpy(pExecution->statusDetails, DOCUMENT_TOO_LARGE_DETAILS, sizeof(DOCUMENT_TOO_LARGE_DETAILS));
+		pExecution->updatePending = true;
+		pExecution->state = JOBS_RUNNER_SLOT_DONE;
+	} else if (pExecution->handlerIndex < 0) {
+		pExecution->status = JOB_EXECUTION_REJECTED;
+		memcpy(pExecution->statusDetails, UNSUPPORTED_OPERATION_DETAILS, sizeof(UNSUPPORTED_OPERATION_DETAILS));
+		pExecution->updatePending = true;
+		pExecution->state = JOBS_RUNNER_SLOT_DONE;
+	} else {
+		memcpy(pExecution->document, json + pTokens[documentIndex].start, documentLength);
+		pExecution->document[documentLength] = '\0';
+		pExecution->documentLength = (uint16_t) documentLength;
+		pExecution->status = JOB_EXECUTION_QUEUED;
+		pExecution->state = JOBS_RUNNER_SLOT_QUEUED;
+	}
+	_unlock(pRunner);
+}
+
+/**
+ * Handler for notify-next and start-next/accepted, both carry the execution as "execution"
+ * and leave it out when nothing is pending.
+ */
+static void _execution_message_handler(AWS_IoT_Client *pClient, char *topicName, uint16_t topicNameLen,
+		IoT_Publish_Message_Params *params, void *pData) {
+	AwsIotJobsRunner *pRunner = (AwsIotJobsRunner *) pData;
+	const char *json = (const char *) params->payload;
+	jsmn_parser parser;
+	int tokenCount;
+	int executionIndex;
+
+	IOT_UNUSED(pClient);
+	IOT_UNUSED(topicName);
+	IOT_UNUSED(topicNameLen);
+
+	jsmn_init(&parser);
+	tokenCount = jsmn_parse(&parser, json, params->payloadLen, pRunner->tokens, MAX_JOB_JSON_TOKEN_EXPECTED);
+	if (tokenCount < 1 || pRunner->tokens[0].type != JSMN_OBJECT) {
+		IOT_WARN("Jobs runner: failed to parse execution message, jsmn returned %d", tokenCount);
+		return;
+	}
+
+	executionIndex = _find_member(json, pRunner->tokens, tokenCount, 0, "execution");
+	if (executionIndex < 0 || pRunner->tokens[executionIndex].type != JSMN_OBJECT) {
+		return;
+	}
+
+	_enqueue_execution(pRunner, json, tokenCount, executionIndex);
+}
+
+IoT_Error_t aws_iot_jobs_runner_init(AwsIotJobsRunner *pRunner, AWS_IoT_Client *pClient,
+		const char *thingName, const AwsIotJobsRunnerParams *pParams) {
+	size_t thingNameLength;
+
+	if (pRunner == NULL || pClient == NULL || thingName == NULL || pParams == NULL) {
+		return NULL_VALUE_ERROR;
+	}
+	thingNameLength = strlen(thingName);
+	if (thingNameLength > MAX_SIZE_OF_THING_NAME) {
+		return MAX_SIZE_ERROR;
+	}
+	if (pParams->maxConcurrentJobs == 0 || pParams->maxConcurrentJobs > JOBS_RUNNER_QUEUE_LENGTH) {
+		return LIMIT_EXCEEDED_ERROR;
+	}
+
+	memset(pRunner, 0, sizeof(AwsIotJobsRunner));
+	pRunner->pClient = pClient;
+	pRunner->params = *pParams;
+	memcpy(pRunner->thingName, thingName, thingNameLength + 1);
+
+#ifdef _ENABLE_THREAD_SUPPORT_
+	return aws_iot_thread_mutex_init(&pRunner->lock);
+#else
+	return SUCCESS;
+#endif
+}
+
+IoT_Error_t aws_iot_jobs_runner_register_handler(AwsIotJobsRunner *pRunner, const char *operation,
+		AwsIotJobsRunnerHandler pHandler, void *pHandlerData) {
+	AwsIotJobsRunnerHandlerEntry *pEntry;
+	size_t operationLength;
+
+	if (pRunner == NULL || operation == NULL || pHandler == NULL) {
+		return NULL_VALUE_ERROR;
+	}
+	operationLength = strlen(operation);
+	if (operationLength == 0 || operationLength > JOBS_RUNNER_MAX_OPERATION_LENGTH) {
+		return MAX_SIZE_ERROR;
+	}
+	if (pRunner->handlerCount >= JOBS_RUNNER_MAX_HANDLERS) {
+		return LIMIT_EXCEEDED_ERROR;
+	}
+
+	pEntry = &pRunner->handlers[pRunner->handlerCount];
+	memcpy(pEntry->operation, operation, operationLength + 1);
+	pEntry->operationLength = (uint8_t) operationLength;
+	pEntry->pHandler = pHandler;
+	pEntry->pHandlerData = pHandlerData;
+	pRunner->handlerCount++;
+
+	return SUCCESS;
+}
+
+static IoT_Error_t _request_next_execution(AwsIotJobsRunner *pRunner) {
+	AwsIotStartNextPendingJobExecutionRequest request = {NULL, NULL};
+
+	return aws_iot_jobs_start_next(pRunner->pClient, pRunner->params.qos, pRunner->thingName, &request,
+			pRunner->topicBuffer, sizeof(pRunner->topicBuffer),
+			pRunner->messageBuffer, sizeof(pRunner->messageBuffer));
+}
+
+IoT_Error_t aws_iot_jobs_runner_start(AwsIotJobsRunner *pRunner) {
+	IoT_Error_t rc;
+
+	if (pRunner == NULL || pRunner->pClient == NULL) {
+		return NULL_VALUE_ERROR;
+	}
+
+	rc = aws_iot_jobs_subscribe_to_job_messages(pRunner->pClient, pRunner->params.qos, pRunner->thingName, NULL,
+			JOB_NOTIFY_NEXT_TOPIC, JOB_REQUEST_TYPE, _execution_message_handler, pRunner,
+			pRunner->notifyNextTopic, sizeof(pRunner->notifyNextTopic));
+	if (rc != SUCCESS) {
+		return rc;
+	}
+
+	rc = aws_iot_jobs_subscribe_to_job_messages(pRunner->pClient, pRunner->params.qos, pRunner->thingName, NULL,
+			JOB_START_NEXT_TOPIC, JOB_ACCEPTED_REPLY_TYPE, _execution_message_handler, pRunner,
+			pRunner->startNextTopic, sizeof(pRunner->startNextTopic));
+	if (rc != SUCCESS) {
+		return rc;
+	}
+
+	return _request_next_execution(pRunner);
+}
+
+IoT_Error_t aws_iot_jobs_runner_stop(AwsIotJobsRunner *pRunner) {
+	IoT_Error_t rc;
+	IoT_Error_t startNextRc;
+	size_t i;
+
+	if (pRunner == NULL || pRunner->pClient == NULL) {
+		return NULL_VALUE_ERROR;
+	}
+
+	rc = aws_iot_jobs_unsubscribe_from_job_messages(pRunner->pClient, pRunner->notifyNextTopic);
+	startNextRc = aws_iot_jobs_unsubscribe_from_job_messages(pRunner->pClient, pRunner->startNextTopic);
+
+	_lock(pRunner);
+	for (i = 0; i < JOBS_RUNNER_QUEUE_LENGTH; i++) {
+		if (pRunner->executions[i].state == JOBS_RUNNER_SLOT_QUEUED) {
+			pRunner->executions[i].state = JOBS_RUNNER_SLOT_FREE;
+		}
+	}
+	_unlock(pRunner);
+
+	return (rc != SUCCESS) ? rc : startNextRc;
+}
+
+bool aws_iot_jobs_runner_work(AwsIotJobsRunner *pRunner) {
+	AwsIotJobsRunnerExecution *pExecution = NULL;
+	const AwsIotJobsRunnerHandlerEntry *pEntry;
+	JobExecutionStatus status;
+	size_t i;
+
+	if (pRunner == NULL) {
+		return false;
+	}
+
+	_lock(pRunner);
+	if (pRunner->runningCount < pRunner->params.maxConcurrentJobs) {
+		for (i = 0; i < JOBS_RUNNER_QUEUE_LENGTH; i++) {
+			AwsIotJobsRunnerExecution *pCandidate = &pRunner->executions[i];
+			if (pCandidate->state == JOBS_RUNNER_SLOT_QUEUED
+					&& (pExecution == NULL || (int32_t) (pCandidate->sequence - pExecution->sequence) < 0)) {
+				pExecution = pCandidate;
+			}
+		}
+	}
+	if (pExecution == NULL) {
+		_unlock(pRunner);
+		return false;
+	}
+	pExecution->state = JOBS_RUNNER_SLOT_RUNNING;
+	pExecution->status = JOB_EXECUTION_IN_PROGRESS;
+	pExecution->updatePending = true;
+	pRunner->runningCount++;
+	pEntry = &pRunner->handlers[pExecution->handlerIndex];
+	_unlock(pRunner);
+
+	status = pEntry->pHandler(pExecution, pEntry->pHandlerData);
+	if (status != JOB_EXECUTION_SUCCEEDED && status != JOB_EXECUTION_REJECTED) {
+		status = JOB_EXECUTION_FAILED;
+	}
+
+	_lock(pRunner);
+	pExecution->status = status;
+	pExecution->updatePending = true;
+	pExecution->state = JOBS_RUNNER_SLOT_DONE;
+	pRunner->runningCount--;
+	_unlock(pRunner);
+
+	return true;
+}
+
+IoT_Error_t aws_iot_jobs_runner_report_progress(AwsIotJobsRunnerExecution *pExecution, const char *statusDetails) {
+	size_t detailsLength = 0;
+
+	if (pExecution == NULL || pExecution->pRunner == NULL) {
+		return NULL_VALUE_ERROR;
+	}
+	if (statusDetails != NULL) {
+		detailsLength = strlen(statusDetails);
+		if (detailsLength > JOBS_RUNNER_MAX_STATUS_DETAILS_LENGTH) {
+			return MAX_SIZE_ERROR;
+		}
+	}
+
+	_lock(pExecution->pRunner);
+	if (statusDetails != NULL) {
+		memcpy(pExecution->statusDetails, statusDetails, detailsLength + 1);
+	}
+	pExecution->updatePending = true;
+	_unlock(pExecution->pRunner);
+
+	return SUCCESS;
+}
+
+static bool _update_due(const AwsIotJobsRunner *pRunner, AwsIotJobsRunnerExecution *pExecution) {
+	if (pExecution->state == JOBS_RUNNER_SLOT_DONE) {
+		return pExecution->updatePending;
+	}
+	if (pExecution->state != JOBS_RUNNER_SLOT_RUNNING) {
+		return false;
+	}
+	/* left_ms instead of has_timer_expired, the FreeRTOS port sleeps when it is polled twice in a tick */
+	if (pExecution->updatePending && left_ms(&pExecution->coalesceTimer) == 0) {
+		return true;
+	}
+	return pExecution->published && pRunner->params.heartbeatIntervalMs > 0
+			&& left_ms(&pExecution->heartbeatTimer) == 0;
+}
+
+IoT_Error_t aws_iot_jobs_runner_process(AwsIotJobsRunner *pRunner) {
+	AwsIotJobExecutionUpdateRequest request;
+	IoT_Error_t rc = SUCCESS;
+	bool slotFree = false;
+	size_t i;
+
+	if (pRunner == NULL || pRunner->pClient == NULL) {
+		return NULL_VALUE_ERROR;
+	}
+
+	for (i = 0; i < JOBS_RUNNER_QUEUE_LENGTH; i++) {
+		AwsIotJobsRunnerExecution *pExecution = &pRunner->executions[i];
+		IoT_Error_t publishRc;
+		bool terminal;
+
+		/* Snapshot under the lock, handlers keep reporting while the update is published */
+		_lock(pRunner);
+		if (!_update_due(pRunner, pExecution)) {
+			slotFree = slotFree || pExecution->state == JOBS_RUNNER_SLOT_FREE;
+			_unlock(pRunner);
+			continue;
+		}
+		terminal = (pExecution->state == JOBS_RUNNER_SLOT_DONE);
+		memcpy(pRunner->jobIdScratch, pExecution->jobId, sizeof(pRunner->jobIdScratch));
+		memcpy(pRunner->statusDetailsScratch, pExecution->statusDetails, sizeof(pRunner->statusDetailsScratch));
+		request.status = pExecution->status;
+		request.executionNumber = pExecution->executionNumber;
+		pExecution->updatePending = false;
+		_unlock(pRunner);
+
+		request.expectedVersion = 0;
+		request.statusDetails = (pRunner->statusDetailsScratch[0] != '\0') ? pRunner->statusDetailsScratch : NULL;
+		request.includeJobExecutionState = false;
+		request.includeJobDocument = false;
+		request.clientToken = NULL;
+
+		publishRc = aws_iot_jobs_send_update(pRunner->pClient, pRunner->params.qos, pRunner->thingName,
+				pRunner->jobIdScratch, &request, pRunner->topicBuffer, sizeof(pRunner->topicBuffer),
+				pRunner->messageBuffer, sizeof(pRunner->messageBuffer));
+
+		_lock(pRunner);
+		if (publishRc != SUCCESS) {
+			IOT_WARN("Jobs runner: update of %s failed, error %d", pRunner->jobIdScratch, publishRc);
+			pExecution->updatePending = true;
+			if (rc == SUCCESS) {
+				rc = publishRc;
+			}
+		} else if (terminal) {
+			pExecution->state = JOBS_RUNNER_SLOT_FREE;
+			slotFree = true;
+		} else {
+			pExecution->published = true;
+			countdown_ms(&pExecution->coalesceTimer, pRunner->params.coalesceWindowMs);
+			countdown_ms(&pExecution->heartbeatTimer, pRunner->params.heartbeatIntervalMs);
+		}
+		_unlock(pRunner);
+	}
+
+	if (pRunner->startNextWanted && slotFree) {
+		IoT_Error_t startNextRc = _request_next_execution(pRunner);
+		if (startNextRc == SUCCESS) {
+			pRunner->startNextWanted = false;
+		} else if (rc == SUCCESS) {
+			rc = startNextRc;
+		}
+	}
+
+	return rc;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -124,6 +124,159 @@ int aws_iot_jobs_get_api_topic(char *buffer, size_t bufferSize,
 	}
 }
 
+typedef struct {
+	const char *text;
+	uint16_t length;
+} _TopicPart;
+
+#define TOPIC_PART(text) { text, (uint16_t) (sizeof(text) - 1) }
+
+/* Tails of the cached topics, in cache index order */
+static const _TopicPart _cached_tails[JOB_TOPIC_CACHE_ENTRIES] = {
+	TOPIC_PART(GET_OPERATION),
+	TOPIC_PART(GET_OPERATION "/" ACCEPTED_REPLY),
+	TOPIC_PART(GET_OPERATION "/" REJECTED_REPLY),
+	TOPIC_PART(GET_OPERATION "/" WILDCARD_REPLY),
+	TOPIC_PART(START_NEXT_OPERATION),
+	TOPIC_PART(START_NEXT_OPERATION "/" ACCEPTED_REPLY),
+	TOPIC_PART(START_NEXT_OPERATION "/" REJECTED_REPLY),
+	TOPIC_PART(START_NEXT_OPERATION "/" WILDCARD_REPLY),
+	TOPIC_PART(NOTIFY_OPERATION),
+	TOPIC_PART(NOTIFY_NEXT_OPERATION),
+	TOPIC_PART("#")
+};
+
+/* Operation and reply suffix following the job id, indexed by reply type */
+static const _TopicPart _update_tails[] = {
+	TOPIC_PART(""),
+	TOPIC_PART("/" UPDATE_OPERATION),
+	TOPIC_PART("/" UPDATE_OPERATION "/" ACCEPTED_REPLY),
+	TOPIC_PART("/" UPDATE_OPERATION "/" REJECTED_REPLY),
+	TOPIC_PART("/" UPDATE_OPERATION "/" WILDCARD_REPLY)
+};
+
+static const _TopicPart _describe_tails[] = {
+	TOPIC_PART(""),
+	TOPIC_PART("/" GET_OPERATION),
+	TOPIC_PART("/" GET_OPERATION "/" ACCEPTED_REPLY),
+	TOPIC_PART("/" GET_OPERATION "/" REJECTED_REPLY),
+	TOPIC_PART("/" GET_OPERATION "/" WILDCARD_REPLY)
+};
+
+static const _TopicPart _wildcard_tails[] = {
+	TOPIC_PART(""),
+	TOPIC_PART("/" WILDCARD_OPERATION),
+	TOPIC_PART("/" WILDCARD_OPERATION "/" ACCEPTED_REPLY),
+	TOPIC_PART("/" WILDCARD_OPERATION "/" REJECTED_REPLY),
+	TOPIC_PART("/" WILDCARD_OPERATION "/" WILDCARD_REPLY)
+};
+
+/* Index into the cached topics, -1 for topics that contain a job id */
+static int _cache_index(AwsIotJobExecutionTopicType topicType, AwsIotJobExecutionTopicReplyType replyType, const char *jobId) {
+	switch (topicType) {
+	case JOB_GET_PENDING_TOPIC:
+		return (int) replyType - JOB_REQUEST_TYPE;
+	case JOB_START_NEXT_TOPIC:
+		return 4 + (int) replyType - JOB_REQUEST_TYPE;
+	case JOB_NOTIFY_TOPIC:
+		return 8;
+	case JOB_NOTIFY_NEXT_TOPIC:
+		return 9;
+	case JOB_WILDCARD_TOPIC:
+		return (jobId == NULL) ? 10 : -1;
+	default:
+		return -1;
+	}
+}
+
+int aws_iot_jobs_topic_cache_init(AwsIotJobTopicCache *cache, const char *thingName) {
+	size_t thingNameLength;
+	int i;
+
+	if (cache == NULL || thingName == NULL) {
+		return -1;
+	}
+
+	thingNameLength = strlen(thingName);
+	if (thingNameLength > MAX_SIZE_OF_THING_NAME) {
+		return -1;
+	}
+
+	memcpy(cache->thingName, thingName, thingNameLength + 1);
+	cache->prefixLength = (uint16_t) (sizeof(BASE_THINGS_TOPIC) - 1 + thingNameLength + sizeof("/jobs/") - 1);
+
+	for (i = 0; i < JOB_TOPIC_CACHE_ENTRIES; i++) {
+		char *topic = cache->topics[i];
+		memcpy(topic, BASE_THINGS_TOPIC, sizeof(BASE_THINGS_TOPIC) - 1);
+		topic += sizeof(BASE_THINGS_TOPIC) - 1;
+		memcpy(topic, thingName, thingNameLength);
+		topic += thingNameLength;
+		memcpy(topic, "/jobs/", sizeof("/jobs/") - 1);
+		topic += sizeof("/jobs/") - 1;
+		memcpy(topic, _cached_tails[i].text, (size_t) _cached_tails[i].length + 1);
+		cache->topicLengths[i] = (uint16_t) (cache->prefixLength + _cached_tails[i].length);
+	}
+
+	return 0;
+}
+
+bool aws_iot_jobs_topic_cache_matches(const AwsIotJobTopicCache *cache, const char *thingName) {
+	return cache != NULL && thingName != NULL && strcmp(cache->thingName, thingName) == 0;
+}
+
+int aws_iot_jobs_topic_cache_get(const AwsIotJobTopicCache *cache,
+		AwsIotJobExecutionTopicType topicType, AwsIotJobExecutionTopicReplyType replyType,
+		const char *jobId, const char **topic, char *buffer, size_t bufferSize)
+{
+	const _TopicPart *tail;
+	size_t jobIdLength;
+	size_t topicLength;
+	int index;
+
+	if (cache == NULL || topic == NULL) {
+		return -1;
+	}
+
+	/* Same validation as aws_iot_jobs_get_api_topic */
+	if ((topicType == JOB_NOTIFY_TOPIC || topicType == JOB_NOTIFY_NEXT_TOPIC) && replyType != JOB_REQUEST_TYPE) {
+		return -1;
+	}
+	if (jobId == NULL && _base_topic_requires_job_id(topicType)) {
+		return -1;
+	}
+	if (_get_operation_for_base_topic(topicType) == NULL || _get_suffix_for_topic_type(replyType) == NULL) {
+		return -1;
+	}
+
+	index = _cache_index(topicType, replyType, jobId);
+	if (index >= 0) {
+		*topic = cache->topics[index];
+		return cache->topicLengths[index];
+	}
+
+	if (topicType == JOB_UPDATE_TOPIC) {
+		tail = &_update_tails[replyType];
+	} else if (topicType == JOB_DESCRIBE_TOPIC) {
+		tail = &_describe_tails[replyType];
+	} else {
+		tail = &_wildcard_tails[replyType];
+	}
+
+	jobIdLength = strlen(jobId);
+	topicLength = cache->prefixLength + jobIdLength + tail->length;
+	if (buffer == NULL || topicLength >= bufferSize) {
+		return (int) topicLength;
+	}
+
+	/* The prefix is the start of any cached topic */
+	memcpy(buffer, cache->topics[0], cache->prefixLength);
+	memcpy(buffer + cache->prefixLength, jobId, jobIdLength);
+	memcpy(buffer + cache->prefixLength + jobIdLength, tail->text, (size_t) tail->length + 1);
+	*topic = buffer;
+
+	return (int) topicLength;
+}
+
 #ifdef __cplusplus
 }
 #endif
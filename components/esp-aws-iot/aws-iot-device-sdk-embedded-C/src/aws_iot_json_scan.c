@@ -0,0 +1,433 @@
+/*
+* Copyright 2015-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+* http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "aws_iot_json_scan.h"
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define JSON_SCAN_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define JSON_SCAN_NEON
+#endif
+
+#if UINTPTR_MAX > 0xFFFFFFFFu
+typedef uint64_t scan_word_t;
+#else
+typedef uint32_t scan_word_t;
+#endif
+
+#define SCAN_WORD_SIZE sizeof(scan_word_t)
+#define SCAN_ONES ((scan_word_t) -1 / 0xFF)
+#define SCAN_HIGHS (SCAN_ONES * 0x80)
+#define SCAN_LOW7 (SCAN_ONES * 0x7F)
+#define SCAN_BYTES(c) (SCAN_ONES * (uint8_t) (c))
+
+/* Non-zero if any byte of v is zero */
+#define SCAN_HAS_ZERO(v) (((v) - SCAN_ONES) & ~(v) & SCAN_HIGHS)
+
+/* High bit set in exactly the bytes of v that are zero */
+#define SCAN_ZERO_BYTES(v) (~((((v) & SCAN_LOW7) + SCAN_LOW7) | (v)) & SCAN_HIGHS)
+
+#define IS_JSON_WHITESPACE(c) ((c) == ' ' || (c) == '\t' || (c) == '\r' || (c) == '\n')
+#define IS_STRING_SPECIAL(c) ((c) == '\"' || (c) == '\\' || (c) == '\0')
+
+static inline scan_word_t _load_aligned_word(const char *p) {
+	scan_word_t w;
+#ifdef __GNUC__
+	memcpy(&w, __builtin_assume_aligned(p, SCAN_WORD_SIZE), SCAN_WORD_SIZE);
+#else
+	memcpy(&w, p, SCAN_WORD_SIZE);
+#endif
+	return w;
+}
+
+static inline size_t _align_distance(const char *p) {
+	return (SCAN_WORD_SIZE - ((uintptr_t) p & (SCAN_WORD_SIZE - 1))) & (SCAN_WORD_SIZE - 1);
+}
+
+/**
+ * Index of the first quote, backslash or NUL at or after pos, or len if there is none.
+ */
+static size_t _find_string_special(const char *js, size_t pos, size_t len) {
+	size_t head;
+
+#if defined(JSON_SCAN_SSE2)
+	const __m128i quote = _mm_set1_epi8('\"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i zero = _mm_setzero_si128();
+	while (pos + 16 <= len) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (js + pos));
+		__m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+								   _mm_cmpeq_epi8(v, zero));
+		int mask = _mm_movemask_epi8(hit);
+		if (mask != 0) {
+			return pos + (size_t) __builtin_ctz((unsigned int) mask);
+		}
+		pos += 16;
+	}
+#elif defined(JSON_SCAN_NEON)
+	const uint8x16_t quote = vdupq_n_u8('\"');
+	const uint8x16_t backslash = vdupq_n_u8('\\');
+	while (pos + 16 <= len) {
+		uint8x16_t v = vld1q_u8((const uint8_t *) (js + pos));
+		uint8x16_t hit = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)), vceqzq_u8(v));
+		if (vmaxvq_u8(hit) != 0) {
+			break;
+		}
+		pos += 16;
+	}
+#endif
+
+	/* Bytewise up to the next word boundary, then a word at a time */
+	head = _align_distance(js + pos);
+	for (; head > 0 && pos < len; head--, pos++) {
+		if (IS_STRING_SPECIAL(js[pos])) {
+			return pos;
+		}
+	}
+	while (pos + SCAN_WORD_SIZE <= len) {
+		scan_word_t w = _load_aligned_word(js + pos);
+		if (SCAN_HAS_ZERO(w ^ SCAN_BYTES('\"')) | SCAN_HAS_ZERO(w ^ SCAN_BYTES('\\')) | SCAN_HAS_ZERO(w)) {
+			break;
+		}
+		pos += SCAN_WORD_SIZE;
+	}
+	for (; pos < len; pos++) {
+		if (IS_STRING_SPECIAL(js[pos])) {
+			break;
+		}
+	}
+	return pos;
+}
+
+/**
+ * Index of the first byte at or after pos that is not JSON whitespace, or len.
+ */
+static size_t _skip_whitespace(const char *js, size_t pos, size_t len) {
+	size_t head = _align_distance(js + pos);
+
+	for (; head > 0 && pos < len; head--, pos++) {
+		if (!IS_JSON_WHITESPACE(js[pos])) {
+			return pos;
+		}
+	}
+	while (pos + SCAN_WORD_SIZE <= len) {
+		scan_word_t w = _load_aligned_word(js + pos);
+		scan_word_t ws = SCAN_ZERO_BYTES(w ^ SCAN_BYTES(' ')) | SCAN_ZERO_BYTES(w ^ SCAN_BYTES('\t')) |
+						 SCAN_ZERO_BYTES(w ^ SCAN_BYTES('\r')) | SCAN_ZERO_BYTES(w ^ SCAN_BYTES('\n'));
+		if (ws != SCAN_HIGHS) {
+			break;
+		}
+		pos += SCAN_WORD_SIZE;
+	}
+	for (; pos < len; pos++) {
+		if (!IS_JSON_WHITESPACE(js[pos])) {
+			break;
+		}
+	}
+	return pos;
+}
+
+static jsmntok_t *_alloc_token(jsmn_parser *parser, jsmntok_t *tokens, size_t numTokens) {
+	jsmntok_t *tok;
+	if (parser->toknext >= numTokens) {
+		return NULL;
+	}
+	tok = &tokens[parser->toknext++];
+	tok->start = tok->end = -1;
+	tok->size = 0;
+#ifdef JSMN_PARENT_LINKS
+	tok->parent = -1;
+#endif
+	return tok;
+}
+
+static void _fill_token(jsmntok_t *token, jsmntype_t type, int start, int end) {
+	token->type = type;
+	token->start = start;
+	token->end = end;
+	token->size = 0;
+}
+
+static int _parse_primitive(jsmn_parser *parser, const char *js, size_t len, jsmntok_t *tokens, size_t numTokens) {
+	jsmntok_t *token;
+	int start = parser->pos;
+
+	for (; parser->pos < len && js[parser->pos] != '\0'; parser->pos++) {
+		switch (js[parser->pos]) {
+#ifndef JSMN_STRICT
+		case ':':
+#endif
+		case '\t': case '\r': case '\n': case ' ':
+		case ',': case ']': case '}':
+			goto found;
+		}
+		if (js[parser->pos] < 32 || js[parser->pos] >= 127) {
+			parser->pos = start;
+			return JSMN_ERROR_INVAL;
+		}
+	}
+#ifdef JSMN_STRICT
+	parser->pos = start;
+	return JSMN_ERROR_PART;
+#endif
+
+found:
+	if (tokens == NULL) {
+		parser->pos--;
+		return 0;
+	}
+	token = _alloc_token(parser, tokens, numTokens);
+	if (token == NULL) {
+		parser->pos = start;
+		return JSMN_ERROR_NOMEM;
+	}
+	_fill_token(token, JSMN_PRIMITIVE, start, parser->pos);
+#ifdef JSMN_PARENT_LINKS
+	token->parent = parser->toksuper;
+#endif
+	parser->pos--;
+	return 0;
+}
+
+static int _parse_string(jsmn_parser *parser, const char *js, size_t len, jsmntok_t *tokens, size_t numTokens) {
+	jsmntok_t *token;
+	int start = parser->pos;
+	size_t pos = parser->pos + 1;
+	int i;
+
+	for (;;) {
+		pos = _find_string_special(js, pos, len);
+		if (pos >= len || js[pos] == '\0') {
+			break;
+		}
+
+		if (js[pos] == '\"') {
+			parser->pos = pos;
+			if (tokens == NULL) {
+				return 0;
+			}
+			token = _alloc_token(parser, tokens, numTokens);
+			if (token == NULL) {
+				parser->pos = start;
+				return JSMN_ERROR_NOMEM;
+			}
+			_fill_token(token, JSMN_STRING, start + 1, parser->pos);
+#ifdef JSMN_PARENT_LINKS
+			token->parent = parser->toksuper;
+#endif
+			return 0;
+		}
+
+		/* Backslash: same escape validation as jsmn */
+		if (pos + 1 < len) {
+			pos++;
+			switch (js[pos]) {
+			case '\"': case '/': case '\\': case 'b':
+			case 'f': case 'r': case 'n': case 't':
+				break;
+			case 'u':
+				pos++;
+				for (i = 0; i < 4 && pos < len && js[pos] != '\0'; i++) {
+					if (!((js[pos] >= '0' && js[pos] <= '9') ||
+						  (js[pos] >= 'A' && js[pos] <= 'F') ||
+						  (js[pos] >= 'a' && js[pos] <= 'f'))) {
+						parser->pos = start;
+						return JSMN_ERROR_INVAL;
+					}
+					pos++;
+				}
+				pos--;
+				break;
+			default:
+				parser->pos = start;
+				return JSMN_ERROR_INVAL;
+			}
+		}
+		pos++;
+	}
+
+	parser->pos = start;
+	return JSMN_ERROR_PART;
+}
+
+int aws_iot_json_scan_parse(jsmn_parser *pParser, const char *pJson, size_t len,
+							jsmntok_t *pTokens, unsigned int numTokens) {
+	int r;
+	int i;
+	jsmntok_t *token;
+	int count = pParser->toknext;
+
+	for (; pParser->pos < len && pJson[pParser->pos] != '\0'; pParser->pos++) {
+		char c;
+		jsmntype_t type;
+
+		c = pJson[pParser->pos];
+		switch (c) {
+		case '{': case '[':
+			count++;
+			if (pTokens == NULL) {
+				break;
+			}
+			token = _alloc_token(pParser, pTokens, numTokens);
+			if (token == NULL) {
+				return JSMN_ERROR_NOMEM;
+			}
+			if (pParser->toksuper != -1) {
+				pTokens[pParser->toksuper].size++;
+#ifdef JSMN_PARENT_LINKS
+				token->parent = pParser->toksuper;
+#endif
+			}
+			token->type = (c == '{' ? JSMN_OBJECT : JSMN_ARRAY);
+			token->start = pParser->pos;
+			pParser->toksuper = pParser->toknext - 1;
+			break;
+		case '}': case ']':
+			if (pTokens == NULL) {
+				break;
+			}
+			type = (c == '}' ? JSMN_OBJECT : JSMN_ARRAY);
+#ifdef JSMN_PARENT_LINKS
+			if (pParser->toknext < 1) {
+				return JSMN_ERROR_INVAL;
+			}
+			token = &pTokens[pParser->toknext - 1];
+			for (;;) {
+				if (token->start != -1 && token->end == -1) {
+					if (token->type != type) {
+						return JSMN_ERROR_INVAL;
+					}
+					token->end = pParser->pos + 1;
+					pParser->toksuper = token->parent;
+					break;
+				}
+				if (token->parent == -1) {
+					if (token->type != type || pParser->toksuper == -1) {
+						return JSMN_ERROR_INVAL;
+					}
+					break;
+				}
+				token = &pTokens[token->parent];
+			}
+#else
+			for (i = pParser->toknext - 1; i >= 0; i--) {
+				token = &pTokens[i];
+				if (token->start != -1 && token->end == -1) {
+					if (token->type != type) {
+						return JSMN_ERROR_INVAL;
+					}
+					pParser->toksuper = -1;
+					token->end = pParser->pos + 1;
+					break;
+				}
+			}
+			if (i == -1) {
+				return JSMN_ERROR_INVAL;
+			}
+			for (; i >= 0; i--) {
+				token = &pTokens[i];
+				if (token->start != -1 && token->end == -1) {
+					pParser->toksuper = i;
+					break;
+				}
+			}
+#endif
+			break;
+		case '\"':
+			r = _parse_string(pParser, pJson, len, pTokens, numTokens);
+			if (r < 0) {
+				return r;
+			}
+			count++;
+			if (pParser->toksuper != -1 && pTokens != NULL) {
+				pTokens[pParser->toksuper].size++;
+			}
+			break;
+		case '\t': case '\r': case '\n': case ' ':
+			/* Leave pos on the last whitespace byte, the loop steps past it */
+			pParser->pos = _skip_whitespace(pJson, pParser->pos + 1, len) - 1;
+			break;
+		case ':':
+			pParser->toksuper = pParser->toknext - 1;
+			break;
+		case ',':
+			if (pTokens != NULL && pParser->toksuper != -1 &&
+				pTokens[pParser->toksuper].type != JSMN_ARRAY &&
+				pTokens[pParser->toksuper].type != JSMN_OBJECT) {
+#ifdef JSMN_PARENT_LINKS
+				pParser->toksuper = pTokens[pParser->toksuper].parent;
+#else
+				for (i = pParser->toknext - 1; i >= 0; i--) {
+					if (pTokens[i].type == JSMN_ARRAY || pTokens[i].type == JSMN_OBJECT) {
+						if (pTokens[i].start != -1 && pTokens[i].end == -1) {
+							pParser->toksuper = i;
+							break;
+						}
+					}
+				}
+#endif
+			}
+			break;
+#ifdef JSMN_STRICT
+		case '-': case '0': case '1': case '2': case '3': case '4':
+		case '5': case '6': case '7': case '8': case '9':
+		case 't': case 'f': case 'n':
+			if (pTokens != NULL && pParser->toksuper != -1) {
+				jsmntok_t *t = &pTokens[pParser->toksuper];
+				if (t->type == JSMN_OBJECT || (t->type == JSMN_STRING && t->size != 0)) {
+					return JSMN_ERROR_INVAL;
+				}
+			}
+#else
+		default:
+#endif
+			r = _parse_primitive(pParser, pJson, len, pTokens, numTokens);
+			if (r < 0) {
+				return r;
+			}
+			count++;
+			if (pParser->toksuper != -1 && pTokens != NULL) {
+				pTokens[pParser->toksuper].size++;
+			}
+			break;
+#ifdef JSMN_STRICT
+		default:
+			return JSMN_ERROR_INVAL;
+#endif
+		}
+	}
+
+	if (pTokens != NULL) {
+		for (i = pParser->toknext - 1; i >= 0; i--) {
+			if (pTokens[i].start != -1 && pTokens[i].end == -1) {
+				return JSMN_ERROR_PART;
+			}
+		}
+	}
+
+	return count;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,202 @@
+/*
+* Copyright 2015-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+* http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "aws_iot_json_stream.h"
+#include <string.h>
+
+/**
+ * Advance the string/nesting state over the newly received bytes and return the length of the
+ * longest prefix that ends on a token boundary. jsmn finalizes a primitive that touches the end
+ * of its input and drops the token count of a string cut in half, so it is never given more.
+ */
+static size_t _scan_received(AwsIotJsonStream *pStream, size_t from, size_t to) {
+	const char *pJson = pStream->pJson;
+	size_t safeLen = pStream->parsedLen;
+	size_t i;
+
+	for (i = from; i < to; i++) {
+		char c = pJson[i];
+
+		if (pStream->inString) {
+			if (pStream->escaped) {
+				pStream->escaped = false;
+			} else if (c == '\\') {
+				pStream->escaped = true;
+			} else if (c == '\"') {
+				pStream->inString = false;
+				if (pStream->depth == 0) {
+					pStream->complete = true;
+				}
+				safeLen = i + 1;
+			}
+			continue;
+		}
+
+		switch (c) {
+		case '\"':
+			pStream->inString = true;
+			break;
+		case '{': case '[':
+			pStream->depth++;
+			safeLen = i + 1;
+			break;
+		case '}': case ']':
+			if (pStream->depth > 0) {
+				pStream->depth--;
+			}
+			if (pStream->depth == 0) {
+				pStream->complete = true;
+			}
+			safeLen = i + 1;
+			break;
+		case ',': case ':':
+		case '\t': case '\r': case '\n': case ' ':
+			safeLen = i + 1;
+			break;
+		default:
+			/* Part of a primitive, it only ends at the next delimiter */
+			break;
+		}
+	}
+
+	return safeLen;
+}
+
+/**
+ * Hand the bytes up to parseTo to jsmn, switching to counting once the token array is full.
+ */
+static int _parse_to(AwsIotJsonStream *pStream, size_t parseTo) {
+	int rc;
+
+	if (parseTo <= pStream->parsedLen) {
+		return 0;
+	}
+
+	if (!pStream->overflowed) {
+		rc = jsmn_parse(&pStream->parser, pStream->pJson, parseTo, pStream->pTokens, pStream->maxTokens);
+		if (rc != JSMN_ERROR_NOMEM) {
+			pStream->parsedLen = parseTo;
+			return (rc == JSMN_ERROR_PART) ? 0 : rc;
+		}
+		if (!pStream->countOnOverflow) {
+			return JSMN_ERROR_NOMEM;
+		}
+
+		/* jsmn leaves pos at the start of the token it could not store, count from there on */
+		pStream->overflowed = true;
+		pStream->tokensNeeded = pStream->parser.toknext;
+		jsmn_init(&pStream->countParser);
+		pStream->countParser.pos = pStream->parser.pos;
+	}
+
+	rc = jsmn_parse(&pStream->countParser, pStream->pJson, parseTo, NULL, 0);
+	if (rc < 0) {
+		return rc;
+	}
+	pStream->tokensNeeded += (unsigned int) rc;
+	pStream->parsedLen = parseTo;
+	return 0;
+}
+
+static int _result(AwsIotJsonStream *pStream) {
+	if (pStream->error != 0) {
+		return pStream->error;
+	}
+	if (!pStream->complete || pStream->depth > 0 || pStream->inString) {
+		return JSMN_ERROR_PART;
+	}
+	if (pStream->overflowed) {
+		return JSMN_ERROR_NOMEM;
+	}
+	return (int) pStream->parser.toknext;
+}
+
+void aws_iot_json_stream_init(AwsIotJsonStream *pStream, const char *pJson, jsmntok_t *pTokens,
+							  unsigned int maxTokens, bool countOnOverflow) {
+	memset(pStream, 0, sizeof(AwsIotJsonStream));
+	jsmn_init(&pStream->parser);
+	pStream->pJson = pJson;
+	pStream->pTokens = pTokens;
+	pStream->maxTokens = maxTokens;
+	pStream->countOnOverflow = countOnOverflow;
+}
+
+int aws_iot_json_stream_feed(AwsIotJsonStream *pStream, const char *pChunk, size_t chunkLen) {
+	size_t safeLen;
+	int rc;
+
+	if (pStream == NULL || (pChunk == NULL && chunkLen > 0)) {
+		return JSMN_ERROR_INVAL;
+	}
+	if (pStream->error != 0) {
+		return pStream->error;
+	}
+	if (chunkLen > 0 && pChunk != pStream->pJson + pStream->receivedLen) {
+		pStream->error = JSMN_ERROR_INVAL;
+		return pStream->error;
+	}
+
+	safeLen = _scan_received(pStream, pStream->receivedLen, pStream->receivedLen + chunkLen);
+	pStream->receivedLen += chunkLen;
+
+	rc = _parse_to(pStream, safeLen);
+	if (rc < 0) {
+		pStream->error = rc;
+		return rc;
+	}
+
+	return _result(pStream);
+}
+
+int aws_iot_json_stream_finish(AwsIotJsonStream *pStream) {
+	int rc;
+
+	if (pStream == NULL) {
+		return JSMN_ERROR_INVAL;
+	}
+	if (pStream->error != 0) {
+		return pStream->error;
+	}
+	if (pStream->inString) {
+		return JSMN_ERROR_PART;
+	}
+
+	/* A trailing primitive can only be a complete token now that no more input follows */
+	if (pStream->depth == 0 && pStream->receivedLen > pStream->parsedLen) {
+		pStream->complete = true;
+	}
+	rc = _parse_to(pStream, pStream->receivedLen);
+	if (rc < 0) {
+		pStream->error = rc;
+		return rc;
+	}
+
+	return _result(pStream);
+}
+
+unsigned int aws_iot_json_stream_tokens_needed(const AwsIotJsonStream *pStream) {
+	if (pStream->overflowed) {
+		return pStream->tokensNeeded;
+	}
+	return pStream->parser.toknext;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -47,7 +47,7 @@ IoT_Error_t aws_iot_shadow_internal_action(const char *pThingName, ShadowActions
 	isClientTokenPresent = extractClientToken(pJsonDocumentToBeSent, jsonSize, extractedClientToken, MAX_SIZE_CLIENT_ID_WITH_SEQUENCE );
 
 	if(isClientTokenPresent && (NULL != callback)) {
-		if(getNextFreeIndexOfAckWaitList(&indexAckWaitList)) {
+		if(getNextFreeIndexOfAckWaitListForToken(extractedClientToken, &indexAckWaitList)) {
 			isAckWaitListFree = true;
 		}
 
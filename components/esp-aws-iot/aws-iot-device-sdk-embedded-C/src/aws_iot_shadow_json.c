@@ -32,6 +32,13 @@ extern "C" {
 #include "aws_iot_shadow_key.h"
 #include "aws_iot_config.h"
 
+#ifdef AWS_IOT_JSON_FAST_SCAN
+#include "aws_iot_json_scan.h"
+#define SHADOW_JSON_PARSE aws_iot_json_scan_parse
+#else
+#define SHADOW_JSON_PARSE jsmn_parse
+#endif
+
 extern char mqttClientID[MAX_SIZE_OF_UNIQUE_CLIENT_ID_BYTES];
 #define AWS_IOT_SHADOW_CLIENT_TOKEN_KEY "{\"clientToken\":\""
 static uint32_t clientTokenNum = 0;
@@ -383,7 +390,7 @@ bool isJsonValidAndParse(const char *pJsonDocument, size_t jsonSize, void *pJson
 
 	jsmn_init(&shadowJsonParser);
 
-	tokenCount = jsmn_parse(&shadowJsonParser, pJsonDocument, jsonSize, jsonTokenStruct,
+	tokenCount = SHADOW_JSON_PARSE(&shadowJsonParser, pJsonDocument, jsonSize, jsonTokenStruct,
 							sizeof(jsonTokenStruct) / sizeof(jsonTokenStruct[0]));
 
 	if(tokenCount < 0) {
@@ -482,7 +489,7 @@ bool isReceivedJsonValid(const char *pJsonDocument, size_t jsonSize ) {
 
 	jsmn_init(&shadowJsonParser);
 
-	tokenCount = jsmn_parse(&shadowJsonParser, pJsonDocument, jsonSize, jsonTokenStruct,
+	tokenCount = SHADOW_JSON_PARSE(&shadowJsonParser, pJsonDocument, jsonSize, jsonTokenStruct,
 							sizeof(jsonTokenStruct) / sizeof(jsonTokenStruct[0]));
 
 	if(tokenCount < 0) {
@@ -504,7 +511,7 @@ bool extractClientToken(const char *pJsonDocument, size_t jsonSize, char *pExtra
 	jsmntok_t ClientJsonToken;
 	jsmn_init(&shadowJsonParser);
 
-	tokenCount = jsmn_parse(&shadowJsonParser, pJsonDocument, jsonSize, jsonTokenStruct,
+	tokenCount = SHADOW_JSON_PARSE(&shadowJsonParser, pJsonDocument, jsonSize, jsonTokenStruct,
 							sizeof(jsonTokenStruct) / sizeof(jsonTokenStruct[0]));
 
 	if(tokenCount < 0) {
@@ -35,6 +35,7 @@ extern "C" {
 
 typedef struct {
 	char clientTokenID[MAX_SIZE_CLIENT_ID_WITH_SEQUENCE];
+	uint32_t clientTokenHash;
 	char thingName[MAX_SIZE_OF_THING_NAME];
 	ShadowActions_t action;
 	fpActionCallback_t callback;
@@ -52,6 +53,7 @@ typedef struct {
 
 typedef struct {
 	char Topic[MAX_SHADOW_TOPIC_LENGTH_BYTES];
+	uint16_t TopicLen;
 	uint8_t count;
 	bool isFree;
 	bool isSticky;
@@ -61,6 +63,14 @@ typedef enum {
 	SHADOW_ACCEPTED, SHADOW_REJECTED, SHADOW_ACTION
 } ShadowAckTopicTypes_t;
 
+#define SHADOW_TOPIC_ACTIONS (SHADOW_DELETE + 1)
+#define SHADOW_TOPIC_ACK_TYPES (SHADOW_ACTION + 1)
+
+typedef struct {
+	char Topic[MAX_SHADOW_TOPIC_LENGTH_BYTES];
+	uint16_t TopicLen;
+} ShadowTopic_t;
+
 ToBeReceivedAckRecord_t AckWaitList[MAX_ACKS_TO_COMEIN_AT_ANY_GIVEN_TIME];
 
 AWS_IoT_Client *pMqttClient;
@@ -69,16 +79,22 @@ char myThingName[MAX_SIZE_OF_THING_NAME];
 char mqttClientID[MAX_SIZE_OF_UNIQUE_CLIENT_ID_BYTES];
 
 char shadowDeltaTopic[MAX_SHADOW_TOPIC_LENGTH_BYTES];
+char shadowWildcardAckTopic[MAX_SHADOW_TOPIC_LENGTH_BYTES];
 
 #define MAX_TOPICS_AT_ANY_GIVEN_TIME 2*MAX_THINGNAME_HANDLED_AT_ANY_GIVEN_TIME
 SubscriptionRecord_t SubscriptionList[MAX_TOPICS_AT_ANY_GIVEN_TIME];
 
+// Every action/ack topic of myThingName, formatted once in initializeRecords
+static ShadowTopic_t myThingTopics[SHADOW_TOPIC_ACTIONS][SHADOW_TOPIC_ACK_TYPES];
+static bool myThingTopicsReady = false;
+
 #define SUBSCRIBE_SETTLING_TIME 2
 char shadowRxBuf[SHADOW_MAX_SIZE_OF_RX_BUFFER];
 
 static JsonTokenTable_t tokenTable[MAX_JSON_TOKEN_EXPECTED];
 static uint32_t tokenTableIndex = 0;
 static bool deltaTopicSubscribedFlag = false;
+static bool wildcardAckSubscribedFlag = false;
 uint32_t shadowJsonVersionNum = 0;
 bool shadowDiscardOldDeltaFlag = true;
 
@@ -89,13 +105,18 @@ static void AckStatusCallback(AWS_IoT_Client *pClient, char *topicName,
 static void shadow_delta_callback(AWS_IoT_Client *pClient, char *topicName,
 								  uint16_t topicNameLen, IoT_Publish_Message_Params *params, void *pData);
 
-static void topicNameFromThingAndAction(char *pTopic, const char *pThingName, ShadowActions_t action,
+static uint16_t topicNameFromThingAndAction(char *pTopic, const char *pThingName, ShadowActions_t action,
+											ShadowAckTopicTypes_t ackType);
+
+static const ShadowTopic_t *shadowTopic(ShadowTopic_t *pScratch, const char *pThingName, ShadowActions_t action,
 										ShadowAckTopicTypes_t ackType);
 
 static int16_t getNextFreeIndexOfSubscriptionList(void);
 
 static void unsubscribeFromAcceptedAndRejected(uint8_t index);
 
+static bool isWildcardAckSubscriptionPresent(const char *pThingName);
+
 void initDeltaTokens(void) {
 	uint32_t i;
 	for(i = 0; i < MAX_JSON_TOKEN_EXPECTED; i++) {
@@ -140,32 +161,111 @@ static int16_t getNextFreeIndexOfSubscriptionList(void) {
 	return -1;
 }
 
-static void topicNameFromThingAndAction(char *pTopic, const char *pThingName, ShadowActions_t action,
-										ShadowAckTopicTypes_t ackType) {
+static uint16_t topicNameFromThingAndAction(char *pTopic, const char *pThingName, ShadowActions_t action,
+											ShadowAckTopicTypes_t ackType) {
 
-	char actionBuf[10];
-	char ackTypeBuf[10];
+	static const char *const actionNames[SHADOW_TOPIC_ACTIONS] = {"get", "update", "delete"};
+	static const char *const ackTypeSuffixes[SHADOW_TOPIC_ACK_TYPES] = {"/accepted", "/rejected", ""};
+	int len;
 
-	if(SHADOW_GET == action) {
-		strncpy(actionBuf, "get", 10);
-	} else if(SHADOW_UPDATE == action) {
-		strncpy(actionBuf, "update", 10);
-	} else if(SHADOW_DELETE == action) {
-		strncpy(actionBuf, "delete", 10);
+	len = snprintf(pTopic, MAX_SHADOW_TOPIC_LENGTH_BYTES, "$aws/things/%s/shadow/%s%s", pThingName,
+				   actionNames[action], ackTypeSuffixes[ackType]);
+	if(len < 0) {
+		pTopic[0] = '\0';
+		return 0;
+	}
+	if(len >= MAX_SHADOW_TOPIC_LENGTH_BYTES) {
+		return MAX_SHADOW_TOPIC_LENGTH_BYTES - 1;
 	}
+	return (uint16_t) len;
+}
 
-	if(SHADOW_ACCEPTED == ackType) {
-		strncpy(ackTypeBuf, "accepted", 10);
-	} else if(SHADOW_REJECTED == ackType) {
-		strncpy(ackTypeBuf, "rejected", 10);
+static bool isMyThingTopicCached(const char *pThingName) {
+	return myThingTopicsReady && (pThingName == myThingName || strcmp(pThingName, myThingName) == 0);
+}
+
+// Topics of myThingName come from the table built at connect, other things are formatted into pScratch
+static const ShadowTopic_t *shadowTopic(ShadowTopic_t *pScratch, const char *pThingName, ShadowActions_t action,
+										ShadowAckTopicTypes_t ackType) {
+	if(isMyThingTopicCached(pThingName)) {
+		return &myThingTopics[action][ackType];
+	}
+	pScratch->TopicLen = topicNameFromThingAndAction(pScratch->Topic, pThingName, action, ackType);
+	return pScratch;
+}
+
+static void initializeMyThingTopics(void) {
+	uint8_t action;
+	uint8_t ackType;
+
+	for(action = 0; action < SHADOW_TOPIC_ACTIONS; action++) {
+		for(ackType = 0; ackType < SHADOW_TOPIC_ACK_TYPES; ackType++) {
+			myThingTopics[action][ackType].TopicLen = topicNameFromThingAndAction(
+					myThingTopics[action][ackType].Topic, myThingName, (ShadowActions_t) action,
+					(ShadowAckTopicTypes_t) ackType);
+		}
 	}
+	myThingTopicsReady = true;
+}
+
+static bool isSameTopic(const SubscriptionRecord_t *pRecord, const ShadowTopic_t *pTopic) {
+	return pRecord->TopicLen == pTopic->TopicLen && memcmp(pRecord->Topic, pTopic->Topic, pTopic->TopicLen) == 0;
+}
 
-	if(SHADOW_ACTION == ackType) {
-		snprintf(pTopic, MAX_SHADOW_TOPIC_LENGTH_BYTES, "$aws/things/%s/shadow/%s", pThingName, actionBuf);
+static void copyShadowTopic(SubscriptionRecord_t *pRecord, const char *pThingName, ShadowActions_t action,
+							ShadowAckTopicTypes_t ackType) {
+	if(isMyThingTopicCached(pThingName)) {
+		memcpy(pRecord->Topic, myThingTopics[action][ackType].Topic, myThingTopics[action][ackType].TopicLen + 1u);
+		pRecord->TopicLen = myThingTopics[action][ackType].TopicLen;
 	} else {
-		snprintf(pTopic, MAX_SHADOW_TOPIC_LENGTH_BYTES, "$aws/things/%s/shadow/%s/%s", pThingName, actionBuf,
-				 ackTypeBuf);
+		pRecord->TopicLen = topicNameFromThingAndAction(pRecord->Topic, pThingName, action, ackType);
+	}
+}
+
+// FNV-1a, used to place and look up client tokens in the AckWaitList
+static uint32_t clientTokenHash(const char *pClientToken) {
+	uint32_t hash = 2166136261u;
+	while(*pClientToken != '\0') {
+		hash ^= (uint8_t) *pClientToken++;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static bool findIndexOfAckWaitList(const char *pClientToken, uint8_t *pIndex) {
+	uint32_t hash = clientTokenHash(pClientToken);
+	uint8_t i;
+	uint8_t index = (uint8_t) (hash % MAX_ACKS_TO_COMEIN_AT_ANY_GIVEN_TIME);
+
+	for(i = 0; i < MAX_ACKS_TO_COMEIN_AT_ANY_GIVEN_TIME; i++) {
+		if(!AckWaitList[index].isFree && AckWaitList[index].clientTokenHash == hash
+		   && strcmp(AckWaitList[index].clientTokenID, pClientToken) == 0) {
+			*pIndex = index;
+			return true;
+		}
+		index = (uint8_t) ((index + 1) % MAX_ACKS_TO_COMEIN_AT_ANY_GIVEN_TIME);
+	}
+	return false;
+}
+
+// Only ".../accepted" and ".../rejected" carry responses, the wildcard subscription also delivers delta and documents
+static bool ackStatusFromTopic(const char *pTopicName, uint16_t topicNameLen, Shadow_Ack_Status_t *pStatus) {
+	static const char acceptedSuffix[] = "/accepted";
+	static const char rejectedSuffix[] = "/rejected";
+	const uint16_t suffixLen = (uint16_t) (sizeof(acceptedSuffix) - 1);
+
+	if(topicNameLen < suffixLen) {
+		return false;
+	}
+	if(strncmp(pTopicName + topicNameLen - suffixLen, acceptedSuffix, suffixLen) == 0) {
+		*pStatus = SHADOW_ACK_ACCEPTED;
+		return true;
+	}
+	if(strncmp(pTopicName + topicNameLen - suffixLen, rejectedSuffix, suffixLen) == 0) {
+		*pStatus = SHADOW_ACK_REJECTED;
+		return true;
 	}
+	return false;
 }
 
 static bool isValidShadowVersionUpdate(const char *pTopicName) {
@@ -183,11 +283,15 @@ static void AckStatusCallback(AWS_IoT_Client *pClient, char *topicName, uint16_t
 	uint8_t i;
 	void *pJsonHandler = NULL;
 	char temporaryClientToken[MAX_SIZE_CLIENT_TOKEN_CLIENT_SEQUENCE];
+	Shadow_Ack_Status_t status;
 
 	IOT_UNUSED(pClient);
-	IOT_UNUSED(topicNameLen);
 	IOT_UNUSED(pData);
 
+	if(!ackStatusFromTopic(topicName, topicNameLen, &status)) {
+		return;
+	}
+
 	if(params->payloadLen >= SHADOW_MAX_SIZE_OF_RX_BUFFER) {
 		IOT_WARN("Payload larger than RX Buffer");
 		return;
@@ -211,35 +315,22 @@ static void AckStatusCallback(AWS_IoT_Client *pClient, char *topicName, uint16_t
 	}
 
 	if(extractClientToken(shadowRxBuf, SHADOW_MAX_SIZE_OF_RX_BUFFER, temporaryClientToken, MAX_SIZE_CLIENT_TOKEN_CLIENT_SEQUENCE)) {
-		for(i = 0; i < MAX_ACKS_TO_COMEIN_AT_ANY_GIVEN_TIME; i++) {
-			if(!AckWaitList[i].isFree) {
-				if(strcmp(AckWaitList[i].clientTokenID, temporaryClientToken) == 0) {
-					Shadow_Ack_Status_t status = SHADOW_ACK_REJECTED;
-					if(strstr(topicName, "accepted") != NULL) {
-						status = SHADOW_ACK_ACCEPTED;
-					} else if(strstr(topicName, "rejected") != NULL) {
-						status = SHADOW_ACK_REJECTED;
-					}
-					if(status == SHADOW_ACK_ACCEPTED || status == SHADOW_ACK_REJECTED) {
-						if(AckWaitList[i].callback != NULL) {
-							AckWaitList[i].callback(AckWaitList[i].thingName, AckWaitList[i].action, status,
-													shadowRxBuf, AckWaitList[i].pCallbackContext);
-						}
-						unsubscribeFromAcceptedAndRejected(i);
-						AckWaitList[i].isFree = true;
-						return;
-					}
-				}
+		if(findIndexOfAckWaitList(temporaryClientToken, &i)) {
+			if(AckWaitList[i].callback != NULL) {
+				AckWaitList[i].callback(AckWaitList[i].thingName, AckWaitList[i].action, status,
+										shadowRxBuf, AckWaitList[i].pCallbackContext);
 			}
+			unsubscribeFromAcceptedAndRejected(i);
+			AckWaitList[i].isFree = true;
 		}
 	}
 }
 
-static int16_t findIndexOfSubscriptionList(const char *pTopic) {
+static int16_t findIndexOfSubscriptionList(const ShadowTopic_t *pTopic) {
 	uint8_t i;
 	for(i = 0; i < MAX_TOPICS_AT_ANY_GIVEN_TIME; i++) {
 		if(!SubscriptionList[i].isFree) {
-			if((strcmp(pTopic, SubscriptionList[i].Topic) == 0)) {
+			if(isSameTopic(&SubscriptionList[i], pTopic)) {
 				return i;
 			}
 		}
@@ -249,22 +340,28 @@ static int16_t findIndexOfSubscriptionList(const char *pTopic) {
 
 static void unsubscribeFromAcceptedAndRejected(uint8_t index) {
 
-	char TemporaryTopicNameAccepted[MAX_SHADOW_TOPIC_LENGTH_BYTES];
-	char TemporaryTopicNameRejected[MAX_SHADOW_TOPIC_LENGTH_BYTES];
+	ShadowTopic_t scratchAccepted;
+	ShadowTopic_t scratchRejected;
+	const ShadowTopic_t *pTopicAccepted;
+	const ShadowTopic_t *pTopicRejected;
 	IoT_Error_t ret_val = SUCCESS;
 
 	int16_t indexSubList;
 
-	topicNameFromThingAndAction(TemporaryTopicNameAccepted, AckWaitList[index].thingName, AckWaitList[index].action,
-								SHADOW_ACCEPTED);
-	topicNameFromThingAndAction(TemporaryTopicNameRejected, AckWaitList[index].thingName, AckWaitList[index].action,
-								SHADOW_REJECTED);
+	if(isWildcardAckSubscriptionPresent(AckWaitList[index].thingName)) {
+		return;
+	}
+
+	pTopicAccepted = shadowTopic(&scratchAccepted, AckWaitList[index].thingName, AckWaitList[index].action,
+								 SHADOW_ACCEPTED);
+	pTopicRejected = shadowTopic(&scratchRejected, AckWaitList[index].thingName, AckWaitList[index].action,
+								 SHADOW_REJECTED);
 
-	indexSubList = findIndexOfSubscriptionList(TemporaryTopicNameAccepted);
+	indexSubList = findIndexOfSubscriptionList(pTopicAccepted);
 	if((indexSubList >= 0)) {
 		if(!SubscriptionList[indexSubList].isSticky && (SubscriptionList[indexSubList].count == 1)) {
-			ret_val = aws_iot_mqtt_unsubscribe(pMqttClient, TemporaryTopicNameAccepted,
-											   (uint16_t) strlen(TemporaryTopicNameAccepted));
+			ret_val = aws_iot_mqtt_unsubscribe(pMqttClient, SubscriptionList[indexSubList].Topic,
+											   SubscriptionList[indexSubList].TopicLen);
 			if(ret_val == SUCCESS) {
 				SubscriptionList[indexSubList].isFree = true;
 			}
@@ -273,11 +370,11 @@ static void unsubscribeFromAcceptedAndRejected(uint8_t index) {
 		}
 	}
 
-	indexSubList = findIndexOfSubscriptionList(TemporaryTopicNameRejected);
+	indexSubList = findIndexOfSubscriptionList(pTopicRejected);
 	if((indexSubList >= 0)) {
 		if(!SubscriptionList[indexSubList].isSticky && (SubscriptionList[indexSubList].count == 1)) {
-			ret_val = aws_iot_mqtt_unsubscribe(pMqttClient, TemporaryTopicNameRejected,
-											   (uint16_t) strlen(TemporaryTopicNameRejected));
+			ret_val = aws_iot_mqtt_unsubscribe(pMqttClient, SubscriptionList[indexSubList].Topic,
+											   SubscriptionList[indexSubList].TopicLen);
 			if(ret_val == SUCCESS) {
 				SubscriptionList[indexSubList].isFree = true;
 			}
@@ -297,26 +394,61 @@ void initializeRecords(AWS_IoT_Client *pClient) {
 		SubscriptionList[i].count = 0;
 		SubscriptionList[i].isSticky = false;
 	}
+	wildcardAckSubscribedFlag = false;
+	initializeMyThingTopics();
 
 	pMqttClient = pClient;
 }
 
+static bool isWildcardAckSubscriptionPresent(const char *pThingName) {
+	return wildcardAckSubscribedFlag && (strcmp(pThingName, myThingName) == 0);
+}
+
+IoT_Error_t subscribeToShadowWildcardAcks(const char *pThingName) {
+	IoT_Error_t ret_val;
+	Timer subSettlingtimer;
+
+	if(NULL == pThingName) {
+		return NULL_VALUE_ERROR;
+	}
+
+	snprintf(shadowWildcardAckTopic, MAX_SHADOW_TOPIC_LENGTH_BYTES, "$aws/things/%s/shadow/+/+", pThingName);
+	ret_val = aws_iot_mqtt_subscribe(pMqttClient, shadowWildcardAckTopic, (uint16_t) strlen(shadowWildcardAckTopic),
+									 QOS0, AckStatusCallback, NULL);
+	if(ret_val == SUCCESS) {
+		wildcardAckSubscribedFlag = true;
+
+		// wait for SUBSCRIBE_SETTLING_TIME seconds once, instead of before every action
+		init_timer(&subSettlingtimer);
+		countdown_sec(&subSettlingtimer, SUBSCRIBE_SETTLING_TIME);
+		while(!has_timer_expired(&subSettlingtimer));
+	}
+
+	return ret_val;
+}
+
 bool isSubscriptionPresent(const char *pThingName, ShadowActions_t action) {
 
 	uint8_t i = 0;
 	bool isAcceptedPresent = false;
 	bool isRejectedPresent = false;
-	char TemporaryTopicNameAccepted[MAX_SHADOW_TOPIC_LENGTH_BYTES];
-	char TemporaryTopicNameRejected[MAX_SHADOW_TOPIC_LENGTH_BYTES];
+	ShadowTopic_t scratchAccepted;
+	ShadowTopic_t scratchRejected;
+	const ShadowTopic_t *pTopicAccepted;
+	const ShadowTopic_t *pTopicRejected;
 
-	topicNameFromThingAndAction(TemporaryTopicNameAccepted, pThingName, action, SHADOW_ACCEPTED);
-	topicNameFromThingAndAction(TemporaryTopicNameRejected, pThingName, action, SHADOW_REJECTED);
+	if(isWildcardAckSubscriptionPresent(pThingName)) {
+		return true;
+	}
+
+	pTopicAccepted = shadowTopic(&scratchAccepted, pThingName, action, SHADOW_ACCEPTED);
+	pTopicRejected = shadowTopic(&scratchRejected, pThingName, action, SHADOW_REJECTED);
 
 	for(i = 0; i < MAX_TOPICS_AT_ANY_GIVEN_TIME; i++) {
 		if(!SubscriptionList[i].isFree) {
-			if((strcmp(TemporaryTopicNameAccepted, SubscriptionList[i].Topic) == 0)) {
+			if(isSameTopic(&SubscriptionList[i], pTopicAccepted)) {
 				isAcceptedPresent = true;
-			} else if((strcmp(TemporaryTopicNameRejected, SubscriptionList[i].Topic) == 0)) {
+			} else if(isSameTopic(&SubscriptionList[i], pTopicRejected)) {
 				isRejectedPresent = true;
 			}
 		}
@@ -340,17 +472,17 @@ IoT_Error_t subscribeToShadowActionAcks(const char *pThingName, ShadowActions_t
 	indexRejectedSubList = getNextFreeIndexOfSubscriptionList();
 
 	if(indexAcceptedSubList >= 0 && indexRejectedSubList >= 0) {
-		topicNameFromThingAndAction(SubscriptionList[indexAcceptedSubList].Topic, pThingName, action, SHADOW_ACCEPTED);
+		// The record keeps its own copy, the MQTT client holds on to the topic pointer
+		copyShadowTopic(&SubscriptionList[indexAcceptedSubList], pThingName, action, SHADOW_ACCEPTED);
 		ret_val = aws_iot_mqtt_subscribe(pMqttClient, SubscriptionList[indexAcceptedSubList].Topic,
-										 (uint16_t) strlen(SubscriptionList[indexAcceptedSubList].Topic), QOS0,
+										 SubscriptionList[indexAcceptedSubList].TopicLen, QOS0,
 										 AckStatusCallback, NULL);
 		if(ret_val == SUCCESS) {
 			SubscriptionList[indexAcceptedSubList].count = 1;
 			SubscriptionList[indexAcceptedSubList].isSticky = isSticky;
-			topicNameFromThingAndAction(SubscriptionList[indexRejectedSubList].Topic, pThingName, action,
-										SHADOW_REJECTED);
+			copyShadowTopic(&SubscriptionList[indexRejectedSubList], pThingName, action, SHADOW_REJECTED);
 			ret_val = aws_iot_mqtt_subscribe(pMqttClient, SubscriptionList[indexRejectedSubList].Topic,
-											 (uint16_t) strlen(SubscriptionList[indexRejectedSubList].Topic), QOS0,
+											 SubscriptionList[indexRejectedSubList].TopicLen, QOS0,
 											 AckStatusCallback, NULL);
 			if(ret_val == SUCCESS) {
 				SubscriptionList[indexRejectedSubList].count = 1;
@@ -372,7 +504,7 @@ IoT_Error_t subscribeToShadowActionAcks(const char *pThingName, ShadowActions_t
 			
 			if(SubscriptionList[indexAcceptedSubList].count == 1) {
 			    aws_iot_mqtt_unsubscribe(pMqttClient, SubscriptionList[indexAcceptedSubList].Topic,
-				(uint16_t) strlen(SubscriptionList[indexAcceptedSubList].Topic));
+				SubscriptionList[indexAcceptedSubList].TopicLen);
 		    }
 		}
 		if(indexRejectedSubList >= 0) {
@@ -385,16 +517,22 @@ IoT_Error_t subscribeToShadowActionAcks(const char *pThingName, ShadowActions_t
 }
 
 void incrementSubscriptionCnt(const char *pThingName, ShadowActions_t action, bool isSticky) {
-	char TemporaryTopicNameAccepted[MAX_SHADOW_TOPIC_LENGTH_BYTES];
-	char TemporaryTopicNameRejected[MAX_SHADOW_TOPIC_LENGTH_BYTES];
+	ShadowTopic_t scratchAccepted;
+	ShadowTopic_t scratchRejected;
+	const ShadowTopic_t *pTopicAccepted;
+	const ShadowTopic_t *pTopicRejected;
 	uint8_t i;
-	topicNameFromThingAndAction(TemporaryTopicNameAccepted, pThingName, action, SHADOW_ACCEPTED);
-	topicNameFromThingAndAction(TemporaryTopicNameRejected, pThingName, action, SHADOW_REJECTED);
+
+	if(isWildcardAckSubscriptionPresent(pThingName)) {
+		return;
+	}
+
+	pTopicAccepted = shadowTopic(&scratchAccepted, pThingName, action, SHADOW_ACCEPTED);
+	pTopicRejected = shadowTopic(&scratchRejected, pThingName, action, SHADOW_REJECTED);
 
 	for(i = 0; i < MAX_TOPICS_AT_ANY_GIVEN_TIME; i++) {
 		if(!SubscriptionList[i].isFree) {
-			if((strcmp(TemporaryTopicNameAccepted, SubscriptionList[i].Topic) == 0)
-			   || (strcmp(TemporaryTopicNameRejected, SubscriptionList[i].Topic) == 0)) {
+			if(isSameTopic(&SubscriptionList[i], pTopicAccepted) || isSameTopic(&SubscriptionList[i], pTopicRejected)) {
 				SubscriptionList[i].count++;
 				SubscriptionList[i].isSticky = isSticky;
 			}
@@ -404,20 +542,21 @@ void incrementSubscriptionCnt(const char *pThingName, ShadowActions_t action, bo
 
 IoT_Error_t publishToShadowAction(const char *pThingName, ShadowActions_t action, const char *pJsonDocumentToBeSent) {
 	IoT_Error_t ret_val = SUCCESS;
-	char TemporaryTopicName[MAX_SHADOW_TOPIC_LENGTH_BYTES];
+	ShadowTopic_t scratchTopic;
+	const ShadowTopic_t *pTopic;
 	IoT_Publish_Message_Params msgParams;
 
 	if(NULL == pThingName || NULL == pJsonDocumentToBeSent) {
 		return NULL_VALUE_ERROR;
 	}
 
-	topicNameFromThingAndAction(TemporaryTopicName, pThingName, action, SHADOW_ACTION);
+	pTopic = shadowTopic(&scratchTopic, pThingName, action, SHADOW_ACTION);
 
 	msgParams.qos = QOS0;
 	msgParams.isRetained = 0;
 	msgParams.payloadLen = strlen(pJsonDocumentToBeSent);
 	msgParams.payload = (char *) pJsonDocumentToBeSent;
-	ret_val = aws_iot_mqtt_publish(pMqttClient, TemporaryTopicName, (uint16_t) strlen(TemporaryTopicName), &msgParams);
+	ret_val = aws_iot_mqtt_publish(pMqttClient, pTopic->Topic, pTopic->TopicLen, &msgParams);
 
 	return ret_val;
 }
@@ -441,11 +580,33 @@ bool getNextFreeIndexOfAckWaitList(uint8_t *pIndex) {
 	return rc;
 }
 
+bool getNextFreeIndexOfAckWaitListForToken(const char *pClientToken, uint8_t *pIndex) {
+	uint8_t i;
+	uint8_t index;
+
+	if(NULL == pClientToken || NULL == pIndex) {
+		return false;
+	}
+
+	// open addressing: start at the token's home slot so the ack lookup usually hits on the first probe
+	index = (uint8_t) (clientTokenHash(pClientToken) % MAX_ACKS_TO_COMEIN_AT_ANY_GIVEN_TIME);
+	for(i = 0; i < MAX_ACKS_TO_COMEIN_AT_ANY_GIVEN_TIME; i++) {
+		if(AckWaitList[index].isFree) {
+			*pIndex = index;
+			return true;
+		}
+		index = (uint8_t) ((index + 1) % MAX_ACKS_TO_COMEIN_AT_ANY_GIVEN_TIME);
+	}
+
+	return false;
+}
+
 void addToAckWaitList(uint8_t indexAckWaitList, const char *pThingName, ShadowActions_t action,
 					  const char *pExtractedClientToken, fpActionCallback_t callback, void *pCallbackContext,
 					  uint32_t timeout_seconds) {
 	AckWaitList[indexAckWaitList].callback = callback;
 	memcpy(AckWaitList[indexAckWaitList].clientTokenID, pExtractedClientToken, MAX_SIZE_CLIENT_ID_WITH_SEQUENCE);
+	AckWaitList[indexAckWaitList].clientTokenHash = clientTokenHash(AckWaitList[indexAckWaitList].clientTokenID);
 	memcpy(AckWaitList[indexAckWaitList].thingName, pThingName, MAX_SIZE_OF_THING_NAME);
 	AckWaitList[indexAckWaitList].pCallbackContext = pCallbackContext;
 	AckWaitList[indexAckWaitList].action = action;
@@ -0,0 +1,85 @@
+/*
+* Copyright 2015-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+* http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+/**
+ * @file aws_iot_tests_unit_json_corpus.h
+ * @brief IoT Client Unit Testing - JSON documents as the device receives and sends them
+ *
+ * Shadow, Jobs and telemetry payloads used for differential testing and benchmarking of the
+ * JSON tokenizers.
+ */
+
+#ifndef IOT_TESTS_UNIT_JSON_CORPUS_H_
+#define IOT_TESTS_UNIT_JSON_CORPUS_H_
+
+static const char *const jsonCorpus[] = {
+	/* Shadow delta */
+	"{\"version\":219,\"timestamp\":1596144470,\"state\":{\"occupied\":true,\"spot\":\"B-12\","
+	"\"reservedUntil\":null},\"metadata\":{\"occupied\":{\"timestamp\":1596144470},"
+	"\"spot\":{\"timestamp\":1596144470},\"reservedUntil\":{\"timestamp\":1596144470}},"
+	"\"clientToken\":\"ParkIt-Core2-0001-17\"}",
+
+	/* Shadow get accepted */
+	"{\"state\":{\"desired\":{\"led\":\"off\",\"brightness\":80,\"threshold\":{\"gsr\":1200,\"mic\":45.5}},"
+	"\"reported\":{\"led\":\"on\",\"brightness\":75,\"threshold\":{\"gsr\":1100,\"mic\":40.25},"
+	"\"firmware\":\"v1.4.2-rc1\",\"uptime\":86400}},\"metadata\":{\"desired\":{\"led\":{\"timestamp\":1596140000},"
+	"\"brightness\":{\"timestamp\":1596140000},\"threshold\":{\"gsr\":{\"timestamp\":1596140000},"
+	"\"mic\":{\"timestamp\":1596140000}}},\"reported\":{\"led\":{\"timestamp\":1596144000},"
+	"\"brightness\":{\"timestamp\":1596144000}}},\"version\":220,\"timestamp\":1596144471,"
+	"\"clientToken\":\"ParkIt-Core2-0001-18\"}",
+
+	/* Shadow update rejected */
+	"{\"code\":409,\"message\":\"Version conflict\",\"timestamp\":1596144472,"
+	"\"clientToken\":\"ParkIt-Core2-0001-19\"}",
+
+	/* Jobs notify-next */
+	"{\"timestamp\":1596144500,\"execution\":{\"jobId\":\"ota-2020-07-30\",\"status\":\"QUEUED\","
+	"\"queuedAt\":1596144499,\"lastUpdatedAt\":1596144499,\"versionNumber\":1,\"executionNumber\":1,"
+	"\"jobDocument\":{\"operation\":\"download\",\"files\":[{\"fileName\":\"parkit.bin\",\"fileVersion\":\"1.4.3\","
+	"\"fileSource\":{\"url\":\"https://example-bucket.s3.amazonaws.com/firmware/parkit-1.4.3.bin?X-Amz-Algorithm="
+	"AWS4-HMAC-SHA256&X-Amz-Credential=EXAMPLE%2F20200730%2Fus-east-1%2Fs3%2Faws4_request\"},"
+	"\"checksum\":\"9f86d081884c7d659a2feaa0c55ad015a3bf4f1b2b0b822cd15d6c15b0f00a08\"}]}}}",
+
+	/* Jobs get accepted */
+	"{\"clientToken\":\"ParkIt-jobs-3\",\"timestamp\":1596144510,\"inProgressJobs\":[{\"jobId\":\"ota-2020-07-30\","
+	"\"queuedAt\":1596144499,\"lastUpdatedAt\":1596144505,\"startedAt\":1596144505,\"executionNumber\":1,"
+	"\"versionNumber\":2}],\"queuedJobs\":[{\"jobId\":\"reboot-2020-07-31\",\"queuedAt\":1596144509,"
+	"\"lastUpdatedAt\":1596144509,\"executionNumber\":1,\"versionNumber\":1},{\"jobId\":\"calibrate-imu\","
+	"\"queuedAt\":1596144509,\"lastUpdatedAt\":1596144509,\"executionNumber\":3,\"versionNumber\":1}]}",
+
+	/* Jobs update with status details */
+	"{\"status\":\"IN_PROGRESS\",\"statusDetails\":{\"step\":\"verifying\",\"progress\":\"62%\"},"
+	"\"expectedVersion\":2,\"executionNumber\":1,\"includeJobExecutionState\":true,\"clientToken\":\"ParkIt-jobs-4\"}",
+
+	/* Telemetry */
+	"{\"id\":\"7f3a9c2e-1b44-4d2a-9a55-0c1e2f3a4b5c\",\"measurementValue\":1234,\"measurementType\":\"GSR\","
+	"\"clientID\":\"0123EE5E1D3BA40A01\"}",
+	"{\"id\":\"7f3a9c2e-1b44-4d2a-9a55-0c1e2f3a4b5d\",\"measurementValue\":-12,\"measurementType\":\"Roll\","
+	"\"clientID\":\"0123EE5E1D3BA40A01\"}",
+
+	/* Pretty printed */
+	"{\n    \"state\": {\n        \"reported\": {\n            \"occupied\": false,\n"
+	"            \"readings\": [ 1, 2.5, -3e2, true, null ]\n        }\n    },\n"
+	"\t\"version\" : 221\r\n}\n",
+
+	/* Escapes and long strings */
+	"{\"message\":\"quote \\\" backslash \\\\ slash \\/ controls \\b\\f\\n\\r\\t unicode \\u00e9\\u20AC\","
+	"\"path\":\"C:\\\\parkit\\\\logs\\\\2020-07-30\\\\device-0001.log\",\"note\":\"The quick brown fox jumps over "
+	"the lazy dog while the parking sensor reports every spot on level two as occupied\"}",
+};
+
+#define JSON_CORPUS_SIZE (sizeof(jsonCorpus) / sizeof(jsonCorpus[0]))
+
+#endif /* IOT_TESTS_UNIT_JSON_CORPUS_H_ */
@@ -49,6 +49,10 @@ TEST_GROUP_C_WRAPPER(JobsTopicsTests, GenerateValidTopics)
 TEST_GROUP_C_WRAPPER(JobsTopicsTests, GenerateWithMissingJobId)
 TEST_GROUP_C_WRAPPER(JobsTopicsTests, GenerateWithInvalidTopicOrReplyType)
 TEST_GROUP_C_WRAPPER(JobsTopicsTests, GenerateWithInvalidCombinations)
+TEST_GROUP_C_WRAPPER(JobsTopicsTests, TopicCacheMatchesGeneratedTopics)
+TEST_GROUP_C_WRAPPER(JobsTopicsTests, TopicCacheRejectsInvalidTopicOrReplyType)
+TEST_GROUP_C_WRAPPER(JobsTopicsTests, TopicCacheSplicesJobIdIntoBuffer)
+TEST_GROUP_C_WRAPPER(JobsTopicsTests, TopicCacheRejectsInvalidThingName)
 
 TEST_GROUP_C(JobsInterfaceTest) {
 	TEST_GROUP_C_SETUP_WRAPPER(JobsInterfaceTest)
@@ -58,3 +62,19 @@ TEST_GROUP_C(JobsInterfaceTest) {
 TEST_GROUP_C_WRAPPER(JobsInterfaceTest, TestSubscribeAndUnsubscribe)
 TEST_GROUP_C_WRAPPER(JobsInterfaceTest, TestSendQuery)
 TEST_GROUP_C_WRAPPER(JobsInterfaceTest, TestSendUpdate)
+
+TEST_GROUP_C(JobsRunnerTest) {
+  TEST_GROUP_C_SETUP_WRAPPER(JobsRunnerTest)
+  TEST_GROUP_C_TEARDOWN_WRAPPER(JobsRunnerTest)
+};
+
+TEST_GROUP_C_WRAPPER(JobsRunnerTest, InitRejectsInvalidParameters)
+TEST_GROUP_C_WRAPPER(JobsRunnerTest, RegisterHandlerLimits)
+TEST_GROUP_C_WRAPPER(JobsRunnerTest, StartSubscribesAndRequestsNextExecution)
+TEST_GROUP_C_WRAPPER(JobsRunnerTest, ExecutesJobFromNotifyNext)
+TEST_GROUP_C_WRAPPER(JobsRunnerTest, IgnoresDuplicateExecution)
+TEST_GROUP_C_WRAPPER(JobsRunnerTest, RejectsUnsupportedOperation)
+TEST_GROUP_C_WRAPPER(JobsRunnerTest, CoalescesProgressReports)
+TEST_GROUP_C_WRAPPER(JobsRunnerTest, HeartbeatRepublishesInProgress)
+TEST_GROUP_C_WRAPPER(JobsRunnerTest, RunsConcurrentJobsUpToLimit)
+TEST_GROUP_C_WRAPPER(JobsRunnerTest, FullQueueRequestsNextWhenSlotFrees)
@@ -0,0 +1,382 @@
+/*
+* Copyright 2015-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+* http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <aws_iot_jobs_runner.h>
+#include <aws_iot_jobs_interface.h>
+
+#include "aws_iot_tests_unit_mock_tls_params.h"
+#include "aws_iot_tests_unit_helper_functions.h"
+#include "aws_iot_config.h"
+#include <CppUTest/TestHarness_c.h>
+#include <aws_iot_log.h>
+
+static AWS_IoT_Client client;
+static IoT_Client_Connect_Params connectParams;
+static IoT_Client_Init_Params mqttInitParams;
+
+static AwsIotJobsRunner runner;
+static AwsIotJobsRunnerParams runnerParams;
+
+static const char *THING_NAME = "T1";
+
+static int handlerCalls;
+static char handledJobIds[JOBS_RUNNER_QUEUE_LENGTH + 1][MAX_SIZE_OF_JOB_ID + 1];
+static char lastDocument[JOBS_RUNNER_MAX_DOCUMENT_LENGTH + 1];
+static int64_t lastExecutionNumber;
+static int nestedWorkCalls;
+static bool nestedWorkResult[2];
+static char inProgressPayloads[3][256];
+
+static void clearLastPublish(void) {
+	LastPublishMessageTopic[0] = 0;
+	lastPublishMessageTopicLen = 0;
+	LastPublishMessagePayload[0] = 0;
+	lastPublishMessagePayloadLen = 0;
+}
+
+static void expectLastPublish(AwsIotJobExecutionTopicType topicType, const char *jobId, const char *payload) {
+	char expectedTopic[MAX_JOB_TOPIC_LENGTH_BYTES + 1];
+
+	aws_iot_jobs_get_api_topic(expectedTopic, sizeof(expectedTopic), topicType, JOB_REQUEST_TYPE, THING_NAME, jobId);
+	CHECK_EQUAL_C_STRING(expectedTopic, LastPublishMessageTopic);
+	CHECK_EQUAL_C_STRING(payload, LastPublishMessagePayload);
+}
+
+static void deliverExecution(AwsIotJobExecutionTopicType topicType, AwsIotJobExecutionTopicReplyType replyType,
+		const char *jobId, int executionNumber, const char *operation) {
+	char topic[MAX_JOB_TOPIC_LENGTH_BYTES + 1];
+	char message[256];
+	IoT_Publish_Message_Params params;
+
+	int topicLen = aws_iot_jobs_get_api_topic(topic, sizeof(topic), topicType, replyType, THING_NAME, NULL);
+	snprintf(message, sizeof(message),
+			"{\"timestamp\":1,\"execution\":{\"jobId\":\"%s\",\"status\":\"QUEUED\",\"queuedAt\":1,"
+			"\"lastUpdatedAt\":1,\"versionNumber\":1,\"executionNumber\":%d,"
+			"\"jobDocument\":{\"operation\":\"%s\",\"args\":{\"operation\":\"nested\"}}}}",
+			jobId, executionNumber, operation);
+
+	params.payload = message;
+	params.payloadLen = strlen(message);
+	params.qos = QOS0;
+
+	setTLSRxBufferWithMsgOnSubscribedTopic(topic, (size_t) topicLen, QOS0, params, message);
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_mqtt_yield(&client, 100));
+}
+
+static void deliverNotifyNext(const char *jobId, int executionNumber, const char *operation) {
+	deliverExecution(JOB_NOTIFY_NEXT_TOPIC, JOB_REQUEST_TYPE, jobId, executionNumber, operation);
+}
+
+static void startRunner(void) {
+	IoT_Publish_Message_Params unused;
+
+	setTLSRxBufferForDoubleSuback(NULL, 0, QOS0, unused);
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_start(&runner));
+	clearLastPublish();
+}
+
+static JobExecutionStatus recordingHandler(AwsIotJobsRunnerExecution *pExecution, void *pHandlerData) {
+	IOT_UNUSED(pHandlerData);
+
+	strcpy(handledJobIds[handlerCalls], pExecution->jobId);
+	strcpy(lastDocument, pExecution->document);
+	lastExecutionNumber = pExecution->executionNumber;
+	handlerCalls++;
+	return JOB_EXECUTION_SUCCEEDED;
+}
+
+static JobExecutionStatus progressHandler(AwsIotJobsRunnerExecution *pExecution, void *pHandlerData) {
+	IOT_UNUSED(pHandlerData);
+	handlerCalls++;
+
+	/* First report is published right away */
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_report_progress(pExecution, "{\"step\":\"1\"}"));
+	clearLastPublish();
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_process(&runner));
+	strcpy(inProgressPayloads[0], LastPublishMessagePayload);
+
+	/* Inside the coalescing window reports only replace each other */
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_report_progress(pExecution, "{\"step\":\"2\"}"));
+	clearLastPublish();
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_process(&runner));
+	strcpy(inProgressPayloads[1], LastPublishMessagePayload);
+
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_report_progress(pExecution, "{\"step\":\"3\"}"));
+	return JOB_EXECUTION_SUCCEEDED;
+}
+
+static JobExecutionStatus heartbeatHandler(AwsIotJobsRunnerExecution *pExecution, void *pHandlerData) {
+	IOT_UNUSED(pExecution);
+	IOT_UNUSED(pHandlerData);
+	handlerCalls++;
+
+	clearLastPublish();
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_process(&runner));
+	strcpy(inProgressPayloads[0], LastPublishMessagePayload);
+
+	clearLastPublish();
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_process(&runner));
+	strcpy(inProgressPayloads[1], LastPublishMessagePayload);
+
+	usleep(20 * 1000);
+	clearLastPublish();
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_process(&runner));
+	strcpy(inProgressPayloads[2], LastPublishMessagePayload);
+
+	return JOB_EXECUTION_FAILED;
+}
+
+/* Stands in for a second worker thread picking up work while this handler is running */
+static JobExecutionStatus nestingHandler(AwsIotJobsRunnerExecution *pExecution, void *pHandlerData) {
+	IOT_UNUSED(pHandlerData);
+
+	strcpy(handledJobIds[handlerCalls], pExecution->jobId);
+	handlerCalls++;
+	if (nestedWorkCalls < 2) {
+		int call = nestedWorkCalls++;
+		nestedWorkResult[call] = aws_iot_jobs_runner_work(&runner);
+	}
+	return JOB_EXECUTION_SUCCEEDED;
+}
+
+TEST_GROUP_C_SETUP(JobsRunnerTest) {
+	IoT_Error_t ret_val = SUCCESS;
+
+	InitMQTTParamsSetup(&mqttInitParams, AWS_IOT_MQTT_HOST, AWS_IOT_MQTT_PORT, false, NULL);
+	ret_val = aws_iot_mqtt_init(&client, &mqttInitParams);
+	CHECK_EQUAL_C_INT(SUCCESS, ret_val);
+
+	ConnectMQTTParamsSetup(&connectParams, (char *) AWS_IOT_MQTT_CLIENT_ID, (uint16_t) strlen(AWS_IOT_MQTT_CLIENT_ID));
+	setTLSRxBufferForConnack(&connectParams, 0, 0);
+	ret_val = aws_iot_mqtt_connect(&client, &connectParams);
+	CHECK_EQUAL_C_INT(SUCCESS, ret_val);
+
+	ResetTLSBuffer();
+	clearLastPublish();
+	lastSubscribeMsgLen = 0;
+
+	runnerParams = JobsRunnerParamsDefault;
+	runnerParams.coalesceWindowMs = 10000;
+	runnerParams.heartbeatIntervalMs = 0;
+
+	handlerCalls = 0;
+	memset(handledJobIds, 0, sizeof(handledJobIds));
+	lastDocument[0] = 0;
+	lastExecutionNumber = 0;
+	nestedWorkCalls = 0;
+	nestedWorkResult[0] = nestedWorkResult[1] = false;
+	memset(inProgressPayloads, 0, sizeof(inProgressPayloads));
+}
+
+TEST_GROUP_C_TEARDOWN(JobsRunnerTest) {
+	IoT_Error_t rc = aws_iot_mqtt_disconnect(&client);
+	IOT_UNUSED(rc);
+}
+
+TEST_C(JobsRunnerTest, InitRejectsInvalidParameters) {
+	char longThingName[MAX_SIZE_OF_THING_NAME + 2];
+
+	memset(longThingName, 'x', sizeof(longThingName) - 1);
+	longThingName[sizeof(longThingName) - 1] = 0;
+
+	CHECK_EQUAL_C_INT(NULL_VALUE_ERROR, aws_iot_jobs_runner_init(NULL, &client, THING_NAME, &runnerParams));
+	CHECK_EQUAL_C_INT(NULL_VALUE_ERROR, aws_iot_jobs_runner_init(&runner, &client, NULL, &runnerParams));
+	CHECK_EQUAL_C_INT(MAX_SIZE_ERROR, aws_iot_jobs_runner_init(&runner, &client, longThingName, &runnerParams));
+
+	runnerParams.maxConcurrentJobs = 0;
+	CHECK_EQUAL_C_INT(LIMIT_EXCEEDED_ERROR, aws_iot_jobs_runner_init(&runner, &client, THING_NAME, &runnerParams));
+	runnerParams.maxConcurrentJobs = JOBS_RUNNER_QUEUE_LENGTH + 1;
+	CHECK_EQUAL_C_INT(LIMIT_EXCEEDED_ERROR, aws_iot_jobs_runner_init(&runner, &client, THING_NAME, &runnerParams));
+}
+
+TEST_C(JobsRunnerTest, RegisterHandlerLimits) {
+	char longOperation[JOBS_RUNNER_MAX_OPERATION_LENGTH + 2];
+	char operation[8];
+	int i;
+
+	memset(longOperation, 'o', sizeof(longOperation) - 1);
+	longOperation[sizeof(longOperation) - 1] = 0;
+
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_init(&runner, &client, THING_NAME, &runnerParams));
+	CHECK_EQUAL_C_INT(NULL_VALUE_ERROR, aws_iot_jobs_runner_register_handler(&runner, "op", NULL, NULL));
+	CHECK_EQUAL_C_INT(MAX_SIZE_ERROR, aws_iot_jobs_runner_register_handler(&runner, longOperation, recordingHandler, NULL));
+
+	for (i = 0; i < JOBS_RUNNER_MAX_HANDLERS; i++) {
+		snprintf(operation, sizeof(operation), "op%d", i);
+		CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_register_handler(&runner, operation, recordingHandler, NULL));
+	}
+	CHECK_EQUAL_C_INT(LIMIT_EXCEEDED_ERROR, aws_iot_jobs_runner_register_handler(&runner, "extra", recordingHandler, NULL));
+}
+
+TEST_C(JobsRunnerTest, StartSubscribesAndRequestsNextExecution) {
+	char expectedTopic[MAX_JOB_TOPIC_LENGTH_BYTES + 1];
+	IoT_Publish_Message_Params unused;
+
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_init(&runner, &client, THING_NAME, &runnerParams));
+	setTLSRxBufferForDoubleSuback(NULL, 0, QOS0, unused);
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_start(&runner));
+
+	aws_iot_jobs_get_api_topic(expectedTopic, sizeof(expectedTopic), JOB_START_NEXT_TOPIC, JOB_ACCEPTED_REPLY_TYPE, THING_NAME, NULL);
+	CHECK_EQUAL_C_STRING(expectedTopic, LastSubscribeMessage);
+	expectLastPublish(JOB_START_NEXT_TOPIC, NULL, "{}");
+}
+
+TEST_C(JobsRunnerTest, ExecutesJobFromNotifyNext) {
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_init(&runner, &client, THING_NAME, &runnerParams));
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_register_handler(&runner, "install", recordingHandler, NULL));
+	startRunner();
+
+	deliverNotifyNext("J1", 7, "install");
+
+	/* Queued executions are not reported until a worker picks them up */
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_process(&runner));
+	CHECK_EQUAL_C_INT(0, (int) lastPublishMessagePayloadLen);
+
+	CHECK_C(aws_iot_jobs_runner_work(&runner));
+	CHECK_EQUAL_C_INT(1, handlerCalls);
+	CHECK_EQUAL_C_STRING("J1", handledJobIds[0]);
+	CHECK_EQUAL_C_STRING("{\"operation\":\"install\",\"args\":{\"operation\":\"nested\"}}", lastDocument);
+	CHECK_C(lastExecutionNumber == 7);
+
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_process(&runner));
+	expectLastPublish(JOB_UPDATE_TOPIC, "J1", "{\"status\":\"SUCCEEDED\",\"executionNumber\":7}");
+
+	/* The slot is free again and nothing is left to run or report */
+	clearLastPublish();
+	CHECK_C(!aws_iot_jobs_runner_work(&runner));
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_process(&runner));
+	CHECK_EQUAL_C_INT(0, (int) lastPublishMessagePayloadLen);
+}
+
+TEST_C(JobsRunnerTest, IgnoresDuplicateExecution) {
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_init(&runner, &client, THING_NAME, &runnerParams));
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_register_handler(&runner, "install", recordingHandler, NULL));
+	startRunner();
+
+	deliverNotifyNext("J1", 1, "install");
+	deliverExecution(JOB_START_NEXT_TOPIC, JOB_ACCEPTED_REPLY_TYPE, "J1", 1, "install");
+	deliverNotifyNext("J1", 1, "install");
+
+	CHECK_C(aws_iot_jobs_runner_work(&runner));
+	CHECK_C(!aws_iot_jobs_runner_work(&runner));
+	CHECK_EQUAL_C_INT(1, handlerCalls);
+}
+
+TEST_C(JobsRunnerTest, RejectsUnsupportedOperation) {
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_init(&runner, &client, THING_NAME, &runnerParams));
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_register_handler(&runner, "install", recordingHandler, NULL));
+	startRunner();
+
+	deliverNotifyNext("J2", 3, "reboot");
+
+	CHECK_C(!aws_iot_jobs_runner_work(&runner));
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_process(&runner));
+	expectLastPublish(JOB_UPDATE_TOPIC, "J2",
+			"{\"status\":\"REJECTED\",\"statusDetails\":{\"reason\":\"unsupported operation\"},\"executionNumber\":3}");
+	CHECK_EQUAL_C_INT(0, handlerCalls);
+}
+
+TEST_C(JobsRunnerTest, CoalescesProgressReports) {
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_init(&runner, &client, THING_NAME, &runnerParams));
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_register_handler(&runner, "install", progressHandler, NULL));
+	startRunner();
+
+	deliverNotifyNext("J1", 1, "install");
+	CHECK_C(aws_iot_jobs_runner_work(&runner));
+	CHECK_EQUAL_C_INT(1, handlerCalls);
+
+	CHECK_EQUAL_C_STRING("{\"status\":\"IN_PROGRESS\",\"statusDetails\":{\"step\":\"1\"},\"executionNumber\":1}",
+			inProgressPayloads[0]);
+	CHECK_EQUAL_C_STRING("", inProgressPayloads[1]);
+
+	/* The terminal status does not wait for the window and carries the latest details */
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_process(&runner));
+	expectLastPublish(JOB_UPDATE_TOPIC, "J1",
+			"{\"status\":\"SUCCEEDED\",\"statusDetails\":{\"step\":\"3\"},\"executionNumber\":1}");
+}
+
+TEST_C(JobsRunnerTest, HeartbeatRepublishesInProgress) {
+	runnerParams.coalesceWindowMs = 0;
+	runnerParams.heartbeatIntervalMs = 10;
+
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_init(&runner, &client, THING_NAME, &runnerParams));
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_register_handler(&runner, "install", heartbeatHandler, NULL));
+	startRunner();
+
+	deliverNotifyNext("J1", 1, "install");
+	CHECK_C(aws_iot_jobs_runner_work(&runner));
+
+	CHECK_EQUAL_C_STRING("{\"status\":\"IN_PROGRESS\",\"executionNumber\":1}", inProgressPayloads[0]);
+	CHECK_EQUAL_C_STRING("", inProgressPayloads[1]);
+	CHECK_EQUAL_C_STRING("{\"status\":\"IN_PROGRESS\",\"executionNumber\":1}", inProgressPayloads[2]);
+
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_process(&runner));
+	expectLastPublish(JOB_UPDATE_TOPIC, "J1", "{\"status\":\"FAILED\",\"executionNumber\":1}");
+}
+
+TEST_C(JobsRunnerTest, RunsConcurrentJobsUpToLimit) {
+	runnerParams.maxConcurrentJobs = 2;
+
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_init(&runner, &client, THING_NAME, &runnerParams));
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_register_handler(&runner, "install", nestingHandler, NULL));
+	startRunner();
+
+	deliverNotifyNext("J1", 1, "install");
+	deliverNotifyNext("J2", 1, "install");
+	deliverNotifyNext("J3", 1, "install");
+
+	/* J1 starts J2 as a second worker would, J2 cannot start J3 past the limit */
+	CHECK_C(aws_iot_jobs_runner_work(&runner));
+	CHECK_EQUAL_C_INT(2, handlerCalls);
+	CHECK_EQUAL_C_STRING("J1", handledJobIds[0]);
+	CHECK_EQUAL_C_STRING("J2", handledJobIds[1]);
+	CHECK_C(nestedWorkResult[0]);
+	CHECK_C(!nestedWorkResult[1]);
+
+	CHECK_C(aws_iot_jobs_runner_work(&runner));
+	CHECK_EQUAL_C_STRING("J3", handledJobIds[2]);
+	CHECK_C(!aws_iot_jobs_runner_work(&runner));
+}
+
+TEST_C(JobsRunnerTest, FullQueueRequestsNextWhenSlotFrees) {
+	char jobId[8];
+	int i;
+
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_init(&runner, &client, THING_NAME, &runnerParams));
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_register_handler(&runner, "install", recordingHandler, NULL));
+	startRunner();
+
+	for (i = 0; i <= JOBS_RUNNER_QUEUE_LENGTH; i++) {
+		snprintf(jobId, sizeof(jobId), "J%d", i);
+		deliverNotifyNext(jobId, 1, "install");
+	}
+
+	/* No slot is free yet, the dropped execution cannot be asked for */
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_process(&runner));
+	CHECK_EQUAL_C_INT(0, (int) lastPublishMessagePayloadLen);
+
+	CHECK_C(aws_iot_jobs_runner_work(&runner));
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_process(&runner));
+	expectLastPublish(JOB_START_NEXT_TOPIC, NULL, "{}");
+
+	/* Only once */
+	clearLastPublish();
+	CHECK_EQUAL_C_INT(SUCCESS, aws_iot_jobs_runner_process(&runner));
+	CHECK_EQUAL_C_INT(0, (int) lastPublishMessagePayloadLen);
+}
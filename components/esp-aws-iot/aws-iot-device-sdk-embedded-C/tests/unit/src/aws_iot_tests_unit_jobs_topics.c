@@ -156,6 +156,105 @@ TEST_C(JobsTopicsTests, GenerateWithInvalidCombinations) {
 	CHECK_EQUAL_C_INT(-1, generateTopicForTestThing(NULL, 0, JOB_NOTIFY_NEXT_TOPIC, JOB_WILDCARD_REPLY_TYPE));
 }
 
+static void checkTopicCacheMatchesGeneratedTopic(const AwsIotJobTopicCache *cache,
+		AwsIotJobExecutionTopicType topicType, AwsIotJobExecutionTopicReplyType replyType, const char *jobId)
+{
+	char expected[1024];
+	char buffer[1024];
+	const char *topic = NULL;
+	int expectedSize = aws_iot_jobs_get_api_topic(expected, sizeof(expected), topicType, replyType, TEST_THING_NAME, jobId);
+	int cachedSize = aws_iot_jobs_topic_cache_get(cache, topicType, replyType, jobId, &topic, buffer, sizeof(buffer));
+
+	CHECK_EQUAL_C_INT(expectedSize, cachedSize);
+	if (expectedSize >= 0) {
+		CHECK_C(topic != NULL);
+		if (topic == NULL) {
+			return;
+		}
+		CHECK_EQUAL_C_INT(expectedSize, (int) strlen(topic));
+		CHECK_EQUAL_C_STRING(expected, topic);
+	}
+}
+
+TEST_C(JobsTopicsTests, TopicCacheMatchesGeneratedTopics) {
+	AwsIotJobTopicCache cache;
+	int topicType, replyType;
+
+	IOT_DEBUG("\n-->Running Jobs Topics Tests - topic cache matches generated topics \n");
+
+	CHECK_EQUAL_C_INT(0, aws_iot_jobs_topic_cache_init(&cache, TEST_THING_NAME));
+	CHECK_C(aws_iot_jobs_topic_cache_matches(&cache, TEST_THING_NAME));
+	CHECK_C(!aws_iot_jobs_topic_cache_matches(&cache, "OtherThing"));
+
+	for (topicType = JOB_UNRECOGNIZED_TOPIC; topicType <= JOB_WILDCARD_TOPIC; topicType++) {
+		for (replyType = JOB_REQUEST_TYPE; replyType <= JOB_WILDCARD_REPLY_TYPE; replyType++) {
+			checkTopicCacheMatchesGeneratedTopic(&cache, topicType, replyType, NULL);
+			checkTopicCacheMatchesGeneratedTopic(&cache, topicType, replyType, TEST_JOB_ID);
+			checkTopicCacheMatchesGeneratedTopic(&cache, topicType, replyType, TEST_NEXT_JOB_ID);
+		}
+	}
+}
+
+TEST_C(JobsTopicsTests, TopicCacheRejectsInvalidTopicOrReplyType) {
+	AwsIotJobTopicCache cache;
+	char buffer[1024];
+	const char *topic = NULL;
+
+	IOT_DEBUG("\n-->Running Jobs Topics Tests - topic cache rejects invalid topic or reply type \n");
+
+	CHECK_EQUAL_C_INT(0, aws_iot_jobs_topic_cache_init(&cache, TEST_THING_NAME));
+
+	CHECK_EQUAL_C_INT(-1, aws_iot_jobs_topic_cache_get(&cache, JOB_UNRECOGNIZED_TOPIC, JOB_REQUEST_TYPE, NULL, &topic, buffer, sizeof(buffer)));
+	CHECK_EQUAL_C_INT(-1, aws_iot_jobs_topic_cache_get(&cache, -1, JOB_REQUEST_TYPE, NULL, &topic, buffer, sizeof(buffer)));
+	CHECK_EQUAL_C_INT(-1, aws_iot_jobs_topic_cache_get(&cache, JOB_GET_PENDING_TOPIC, JOB_UNRECOGNIZED_TOPIC_TYPE, NULL, &topic, buffer, sizeof(buffer)));
+	CHECK_EQUAL_C_INT(-1, aws_iot_jobs_topic_cache_get(&cache, JOB_UPDATE_TOPIC, JOB_UNRECOGNIZED_TOPIC_TYPE, TEST_JOB_ID, &topic, buffer, sizeof(buffer)));
+	CHECK_EQUAL_C_INT(-1, aws_iot_jobs_topic_cache_get(&cache, JOB_WILDCARD_TOPIC, -1, NULL, &topic, buffer, sizeof(buffer)));
+	CHECK_C(topic == NULL);
+}
+
+TEST_C(JobsTopicsTests, TopicCacheSplicesJobIdIntoBuffer) {
+	AwsIotJobTopicCache cache;
+	char buffer[sizeof(TEST_TOPIC_W_JOB_PREFIX "/update/accepted")];
+	const char *topic = NULL;
+
+	IOT_DEBUG("\n-->Running Jobs Topics Tests - topic cache splices job id into buffer \n");
+
+	CHECK_EQUAL_C_INT(0, aws_iot_jobs_topic_cache_init(&cache, TEST_THING_NAME));
+
+	/* One byte short of the terminator: length is reported, buffer and topic are left alone */
+	buffer[0] = 'x';
+	CHECK_EQUAL_C_INT((int) sizeof(buffer) - 1, aws_iot_jobs_topic_cache_get(&cache, JOB_UPDATE_TOPIC,
+			JOB_ACCEPTED_REPLY_TYPE, TEST_JOB_ID, &topic, buffer, sizeof(buffer) - 1));
+	CHECK_C(topic == NULL);
+	CHECK_EQUAL_C_CHAR('x', buffer[0]);
+
+	CHECK_EQUAL_C_INT((int) sizeof(buffer) - 1, aws_iot_jobs_topic_cache_get(&cache, JOB_UPDATE_TOPIC,
+			JOB_ACCEPTED_REPLY_TYPE, TEST_JOB_ID, &topic, buffer, sizeof(buffer)));
+	CHECK_C(topic == buffer);
+	CHECK_EQUAL_C_STRING(TEST_TOPIC_W_JOB_PREFIX "/update/accepted", buffer);
+
+	/* Topics without a job id never need the buffer */
+	topic = NULL;
+	CHECK_EQUAL_C_INT((int) strlen(TEST_TOPIC_PREFIX "/notify-next"), aws_iot_jobs_topic_cache_get(&cache,
+			JOB_NOTIFY_NEXT_TOPIC, JOB_REQUEST_TYPE, NULL, &topic, NULL, 0));
+	CHECK_EQUAL_C_STRING(TEST_TOPIC_PREFIX "/notify-next", topic);
+}
+
+TEST_C(JobsTopicsTests, TopicCacheRejectsInvalidThingName) {
+	AwsIotJobTopicCache cache;
+	char longName[MAX_SIZE_OF_THING_NAME + 2];
+
+	IOT_DEBUG("\n-->Running Jobs Topics Tests - topic cache rejects invalid thing name \n");
+
+	memset(longName, 'a', sizeof(longName) - 1);
+	longName[sizeof(longName) - 1] = '\0';
+
+	CHECK_EQUAL_C_INT(-1, aws_iot_jobs_topic_cache_init(&cache, NULL));
+	CHECK_EQUAL_C_INT(-1, aws_iot_jobs_topic_cache_init(&cache, longName));
+	longName[sizeof(longName) - 2] = '\0';
+	CHECK_EQUAL_C_INT(0, aws_iot_jobs_topic_cache_init(&cache, longName));
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,36 @@
+/*
+* Copyright 2015-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+* http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+/**
+ * @file aws_iot_tests_unit_json_scan.cpp
+ * @brief IoT Client Unit Testing - Word-parallel JSON Tokenizer Tests
+ */
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <CppUTest/TestHarness_c.h>
+
+TEST_GROUP_C(JsonScan) {
+  TEST_GROUP_C_SETUP_WRAPPER(JsonScan)
+  TEST_GROUP_C_TEARDOWN_WRAPPER(JsonScan)
+};
+
+TEST_GROUP_C_WRAPPER(JsonScan, CorpusMatchesJsmn)
+TEST_GROUP_C_WRAPPER(JsonScan, CorpusCountOnlyMatchesJsmn)
+TEST_GROUP_C_WRAPPER(JsonScan, CorpusPrefixesMatchJsmn)
+TEST_GROUP_C_WRAPPER(JsonScan, CorpusSmallTokenArraysMatchJsmn)
+TEST_GROUP_C_WRAPPER(JsonScan, CorpusUnalignedMatchesJsmn)
+TEST_GROUP_C_WRAPPER(JsonScan, CorruptedCorpusMatchesJsmn)
+TEST_GROUP_C_WRAPPER(JsonScan, EmbeddedNulMatchesJsmn)
+TEST_GROUP_C_WRAPPER(JsonScan, ThroughputAgainstJsmn)
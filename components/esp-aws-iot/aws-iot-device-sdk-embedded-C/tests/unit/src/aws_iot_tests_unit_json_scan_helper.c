@@ -0,0 +1,209 @@
+/*
+* Copyright 2015-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+* http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+/**
+ * @file aws_iot_tests_unit_json_scan_helper.c
+ * @brief IoT Client Unit Testing - Word-parallel JSON Tokenizer Tests helper
+ *
+ * Every test runs the scalar jsmn parser and the word-parallel scanner over the same input and
+ * requires identical return values, tokens and parser state.
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <CppUTest/TestHarness_c.h>
+
+#include "aws_iot_json_scan.h"
+#include "aws_iot_tests_unit_json_corpus.h"
+#include "aws_iot_log.h"
+
+#define TEST_TOKEN_COUNT (160)
+#define TEST_BUFFER_LENGTH (1024)
+#define BENCHMARK_ITERATIONS (2000)
+
+static jsmn_parser scalarParser;
+static jsmn_parser scanParser;
+static jsmntok_t scalarTokens[TEST_TOKEN_COUNT];
+static jsmntok_t scanTokens[TEST_TOKEN_COUNT];
+static char buffer[TEST_BUFFER_LENGTH + 16];
+
+static void checkParsersAgree(const char *pJson, size_t len, unsigned int numTokens, bool countOnly) {
+	int scalarResult, scanResult, i;
+
+	memset(scalarTokens, 0xA5, sizeof(scalarTokens));
+	memset(scanTokens, 0xA5, sizeof(scanTokens));
+	jsmn_init(&scalarParser);
+	jsmn_init(&scanParser);
+
+	scalarResult = jsmn_parse(&scalarParser, pJson, len, countOnly ? NULL : scalarTokens, numTokens);
+	scanResult = aws_iot_json_scan_parse(&scanParser, pJson, len, countOnly ? NULL : scanTokens, numTokens);
+
+	CHECK_EQUAL_C_INT(scalarResult, scanResult);
+	CHECK_EQUAL_C_INT(scalarParser.pos, scanParser.pos);
+	CHECK_EQUAL_C_INT(scalarParser.toknext, scanParser.toknext);
+	CHECK_EQUAL_C_INT(scalarParser.toksuper, scanParser.toksuper);
+	for (i = 0; i < (int) scalarParser.toknext; i++) {
+		CHECK_EQUAL_C_INT(scalarTokens[i].type, scanTokens[i].type);
+		CHECK_EQUAL_C_INT(scalarTokens[i].start, scanTokens[i].start);
+		CHECK_EQUAL_C_INT(scalarTokens[i].end, scanTokens[i].end);
+		CHECK_EQUAL_C_INT(scalarTokens[i].size, scanTokens[i].size);
+	}
+}
+
+TEST_GROUP_C_SETUP(JsonScan) {
+	memset(buffer, 0, sizeof(buffer));
+}
+
+TEST_GROUP_C_TEARDOWN(JsonScan) {
+
+}
+
+TEST_C(JsonScan, CorpusMatchesJsmn) {
+	size_t i;
+
+	IOT_DEBUG("\n-->Running Json Scan Tests - Corpus matches jsmn \n");
+
+	for (i = 0; i < JSON_CORPUS_SIZE; i++) {
+		checkParsersAgree(jsonCorpus[i], strlen(jsonCorpus[i]), TEST_TOKEN_COUNT, false);
+		CHECK_C(scanParser.toknext > 0);
+	}
+}
+
+TEST_C(JsonScan, CorpusCountOnlyMatchesJsmn) {
+	size_t i;
+
+	IOT_DEBUG("\n-->Running Json Scan Tests - Counting corpus matches jsmn \n");
+
+	for (i = 0; i < JSON_CORPUS_SIZE; i++) {
+		checkParsersAgree(jsonCorpus[i], strlen(jsonCorpus[i]), 0, true);
+	}
+}
+
+TEST_C(JsonScan, CorpusPrefixesMatchJsmn) {
+	size_t i, len;
+
+	IOT_DEBUG("\n-->Running Json Scan Tests - Corpus prefixes match jsmn \n");
+
+	for (i = 0; i < JSON_CORPUS_SIZE; i++) {
+		for (len = 0; len < strlen(jsonCorpus[i]); len++) {
+			checkParsersAgree(jsonCorpus[i], len, TEST_TOKEN_COUNT, false);
+			checkParsersAgree(jsonCorpus[i], len, 0, true);
+		}
+	}
+}
+
+TEST_C(JsonScan, CorpusSmallTokenArraysMatchJsmn) {
+	size_t i;
+	unsigned int numTokens;
+
+	IOT_DEBUG("\n-->Running Json Scan Tests - Small token arrays match jsmn \n");
+
+	for (i = 0; i < JSON_CORPUS_SIZE; i++) {
+		for (numTokens = 0; numTokens < 64; numTokens++) {
+			checkParsersAgree(jsonCorpus[i], strlen(jsonCorpus[i]), numTokens, false);
+		}
+	}
+}
+
+TEST_C(JsonScan, CorpusUnalignedMatchesJsmn) {
+	size_t i, offset, len;
+
+	IOT_DEBUG("\n-->Running Json Scan Tests - Unaligned corpus matches jsmn \n");
+
+	for (i = 0; i < JSON_CORPUS_SIZE; i++) {
+		len = strlen(jsonCorpus[i]);
+		CHECK_C(len < TEST_BUFFER_LENGTH);
+		for (offset = 0; offset < 16; offset++) {
+			memset(buffer, 'x', sizeof(buffer));
+			memcpy(buffer + offset, jsonCorpus[i], len);
+			checkParsersAgree(buffer + offset, len, TEST_TOKEN_COUNT, false);
+		}
+	}
+}
+
+TEST_C(JsonScan, CorruptedCorpusMatchesJsmn) {
+	static const char replacements[] = { '\"', '\\', '{', '}', '[', ']', ':', ',', ' ', 'u', '0', 'x', '\x01', '\x80' };
+	size_t i, pos, r, len;
+
+	IOT_DEBUG("\n-->Running Json Scan Tests - Corrupted corpus matches jsmn \n");
+
+	for (i = 0; i < JSON_CORPUS_SIZE; i++) {
+		len = strlen(jsonCorpus[i]);
+		for (pos = 0; pos < len; pos++) {
+			for (r = 0; r < sizeof(replacements); r++) {
+				memcpy(buffer, jsonCorpus[i], len);
+				buffer[pos] = replacements[r];
+				checkParsersAgree(buffer, len, TEST_TOKEN_COUNT, false);
+			}
+		}
+	}
+}
+
+TEST_C(JsonScan, EmbeddedNulMatchesJsmn) {
+	size_t i, pos, len;
+
+	IOT_DEBUG("\n-->Running Json Scan Tests - Embedded NUL matches jsmn \n");
+
+	for (i = 0; i < JSON_CORPUS_SIZE; i++) {
+		len = strlen(jsonCorpus[i]);
+		for (pos = 0; pos < len; pos += 3) {
+			memcpy(buffer, jsonCorpus[i], len);
+			buffer[pos] = '\0';
+			checkParsersAgree(buffer, len, TEST_TOKEN_COUNT, false);
+			checkParsersAgree(buffer, len, 0, true);
+		}
+	}
+}
+
+TEST_C(JsonScan, ThroughputAgainstJsmn) {
+	size_t i, totalBytes = 0;
+	int n, scalarTokensSeen = 0, scanTokensSeen = 0;
+	clock_t begin;
+	double scalarSeconds, scanSeconds;
+
+	IOT_DEBUG("\n-->Running Json Scan Tests - Throughput against jsmn \n");
+
+	for (i = 0; i < JSON_CORPUS_SIZE; i++) {
+		totalBytes += strlen(jsonCorpus[i]);
+	}
+
+	begin = clock();
+	for (n = 0; n < BENCHMARK_ITERATIONS; n++) {
+		for (i = 0; i < JSON_CORPUS_SIZE; i++) {
+			jsmn_init(&scalarParser);
+			scalarTokensSeen += jsmn_parse(&scalarParser, jsonCorpus[i], strlen(jsonCorpus[i]), scalarTokens,
+										   TEST_TOKEN_COUNT);
+		}
+	}
+	scalarSeconds = (double) (clock() - begin) / CLOCKS_PER_SEC;
+
+	begin = clock();
+	for (n = 0; n < BENCHMARK_ITERATIONS; n++) {
+		for (i = 0; i < JSON_CORPUS_SIZE; i++) {
+			jsmn_init(&scanParser);
+			scanTokensSeen += aws_iot_json_scan_parse(&scanParser, jsonCorpus[i], strlen(jsonCorpus[i]), scanTokens,
+													  TEST_TOKEN_COUNT);
+		}
+	}
+	scanSeconds = (double) (clock() - begin) / CLOCKS_PER_SEC;
+
+	CHECK_EQUAL_C_INT(scalarTokensSeen, scanTokensSeen);
+
+	printf("\nJSON corpus, %u bytes x %d: jsmn %.3f s, scan %.3f s\n", (unsigned int) totalBytes,
+		   BENCHMARK_ITERATIONS, scalarSeconds, scanSeconds);
+}
@@ -0,0 +1,212 @@
+/*
+* Copyright 2015-2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License").
+* You may not use this file except in compliance with the License.
+* A copy of the License is located at
+*
+* http://aws.amazon.com/apache2.0
+*
+* or in the "license" file accompanying this file. This file is distributed
+* on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+* express or implied. See the License for the specific language governing
+* permissions and limitations under the License.
+*/
+
+/**
+ * @file aws_iot_tests_unit_json_stream_helper.c
+ * @brief IoT Client Unit Testing - Incremental JSON Tokenizer Tests helper
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <CppUTest/TestHarness_c.h>
+
+#include "aws_iot_json_stream.h"
+#include "aws_iot_log.h"
+
+#define TEST_TOKEN_COUNT (32)
+
+static const char *shadowDocument =
+		"{\"state\":{\"reported\":{\"temp\":23.5,\"on\":true,\"name\":\"spot \\\"A\\\" \\u00e9\"}},"
+		"\"metadata\":{\"list\":[1,-2,3e4,null]},\"version\":17,\"clientToken\":\"tok-1\"}";
+
+static AwsIotJsonStream stream;
+static jsmn_parser referenceParser;
+static jsmntok_t tokens[TEST_TOKEN_COUNT];
+static jsmntok_t referenceTokens[TEST_TOKEN_COUNT];
+
+static void checkTokensMatchReference(int count) {
+	int i;
+	for (i = 0; i < count; i++) {
+		CHECK_EQUAL_C_INT(referenceTokens[i].type, tokens[i].type);
+		CHECK_EQUAL_C_INT(referenceTokens[i].start, tokens[i].start);
+		CHECK_EQUAL_C_INT(referenceTokens[i].end, tokens[i].end);
+		CHECK_EQUAL_C_INT(referenceTokens[i].size, tokens[i].size);
+	}
+}
+
+static int referenceParse(const char *pJson) {
+	jsmn_init(&referenceParser);
+	return jsmn_parse(&referenceParser, pJson, strlen(pJson), referenceTokens, TEST_TOKEN_COUNT);
+}
+
+TEST_GROUP_C_SETUP(JsonStream) {
+	memset(tokens, 0, sizeof(tokens));
+	memset(referenceTokens, 0, sizeof(referenceTokens));
+}
+
+TEST_GROUP_C_TEARDOWN(JsonStream) {
+
+}
+
+TEST_C(JsonStream, SingleChunkMatchesJsmn) {
+	int expected, r;
+
+	IOT_DEBUG("\n-->Running Json Stream Tests - Single chunk matches jsmn \n");
+
+	expected = referenceParse(shadowDocument);
+	CHECK_C(expected > 0);
+
+	aws_iot_json_stream_init(&stream, shadowDocument, tokens, TEST_TOKEN_COUNT, false);
+	r = aws_iot_json_stream_feed(&stream, shadowDocument, strlen(shadowDocument));
+
+	CHECK_EQUAL_C_INT(expected, r);
+	checkTokensMatchReference(expected);
+	CHECK_EQUAL_C_INT(expected, aws_iot_json_stream_finish(&stream));
+}
+
+TEST_C(JsonStream, ByteByByteMatchesJsmn) {
+	int expected, r = JSMN_ERROR_PART;
+	size_t i, len = strlen(shadowDocument);
+
+	IOT_DEBUG("\n-->Running Json Stream Tests - Byte by byte matches jsmn \n");
+
+	expected = referenceParse(shadowDocument);
+
+	aws_iot_json_stream_init(&stream, shadowDocument, tokens, TEST_TOKEN_COUNT, false);
+	for (i = 0; i < len; i++) {
+		r = aws_iot_json_stream_feed(&stream, shadowDocument + i, 1);
+		if (i + 1 < len) {
+			CHECK_EQUAL_C_INT(JSMN_ERROR_PART, r);
+		}
+	}
+
+	CHECK_EQUAL_C_INT(expected, r);
+	checkTokensMatchReference(expected);
+}
+
+TEST_C(JsonStream, PartialUntilTopLevelClosed) {
+	const char *json = "{\"a\":{\"b\":[1,2]}}";
+
+	IOT_DEBUG("\n-->Running Json Stream Tests - Partial until top level closed \n");
+
+	aws_iot_json_stream_init(&stream, json, tokens, TEST_TOKEN_COUNT, false);
+	CHECK_EQUAL_C_INT(JSMN_ERROR_PART, aws_iot_json_stream_feed(&stream, json, 15));
+	CHECK_EQUAL_C_INT(JSMN_ERROR_PART, aws_iot_json_stream_feed(&stream, json + 15, 1));
+	CHECK_EQUAL_C_INT(7, aws_iot_json_stream_feed(&stream, json + 16, 1));
+	CHECK_EQUAL_C_INT(0, tokens[0].start);
+	CHECK_EQUAL_C_INT(17, tokens[0].end);
+}
+
+TEST_C(JsonStream, StringWithEscapesSplitAcrossChunks) {
+	const char *json = "{\"k\":\"x\\\\\\\"y\\u0041z\"}";
+	size_t cut;
+
+	IOT_DEBUG("\n-->Running Json Stream Tests - String with escapes split across chunks \n");
+
+	CHECK_EQUAL_C_INT(3, referenceParse(json));
+
+	/* Cut inside every escape sequence of the value */
+	for (cut = 6; cut < strlen(json) - 2; cut++) {
+		aws_iot_json_stream_init(&stream, json, tokens, TEST_TOKEN_COUNT, false);
+		CHECK_EQUAL_C_INT(JSMN_ERROR_PART, aws_iot_json_stream_feed(&stream, json, cut));
+		CHECK_EQUAL_C_INT(3, aws_iot_json_stream_feed(&stream, json + cut, strlen(json) - cut));
+		checkTokensMatchReference(3);
+	}
+}
+
+TEST_C(JsonStream, PrimitiveSplitAcrossChunksIsNotTruncated) {
+	const char *json = "{\"version\":123456}";
+
+	IOT_DEBUG("\n-->Running Json Stream Tests - Primitive split across chunks \n");
+
+	aws_iot_json_stream_init(&stream, json, tokens, TEST_TOKEN_COUNT, false);
+	CHECK_EQUAL_C_INT(JSMN_ERROR_PART, aws_iot_json_stream_feed(&stream, json, 13));
+	CHECK_EQUAL_C_INT(3, aws_iot_json_stream_feed(&stream, json + 13, strlen(json) - 13));
+	CHECK_EQUAL_C_INT(JSMN_PRIMITIVE, tokens[2].type);
+	CHECK_EQUAL_C_INT(11, tokens[2].start);
+	CHECK_EQUAL_C_INT(17, tokens[2].end);
+}
+
+TEST_C(JsonStream, TopLevelPrimitiveCompletedByFinish) {
+	const char *json = "4096";
+
+	IOT_DEBUG("\n-->Running Json Stream Tests - Top level primitive completed by finish \n");
+
+	aws_iot_json_stream_init(&stream, json, tokens, TEST_TOKEN_COUNT, false);
+	CHECK_EQUAL_C_INT(JSMN_ERROR_PART, aws_iot_json_stream_feed(&stream, json, 2));
+	CHECK_EQUAL_C_INT(JSMN_ERROR_PART, aws_iot_json_stream_feed(&stream, json + 2, 2));
+	CHECK_EQUAL_C_INT(1, aws_iot_json_stream_finish(&stream));
+	CHECK_EQUAL_C_INT(JSMN_PRIMITIVE, tokens[0].type);
+	CHECK_EQUAL_C_INT(4, tokens[0].end);
+}
+
+TEST_C(JsonStream, TruncatedDocumentIsPartialOnFinish) {
+	IOT_DEBUG("\n-->Running Json Stream Tests - Truncated document is partial on finish \n");
+
+	aws_iot_json_stream_init(&stream, shadowDocument, tokens, TEST_TOKEN_COUNT, false);
+	CHECK_EQUAL_C_INT(JSMN_ERROR_PART, aws_iot_json_stream_feed(&stream, shadowDocument, 40));
+	CHECK_EQUAL_C_INT(JSMN_ERROR_PART, aws_iot_json_stream_finish(&stream));
+}
+
+TEST_C(JsonStream, InvalidJsonIsSticky) {
+	const char *json = "{\"a\":\"\\q\",\"b\":1}";
+
+	IOT_DEBUG("\n-->Running Json Stream Tests - Invalid JSON is sticky \n");
+
+	aws_iot_json_stream_init(&stream, json, tokens, TEST_TOKEN_COUNT, false);
+	CHECK_EQUAL_C_INT(JSMN_ERROR_INVAL, aws_iot_json_stream_feed(&stream, json, 10));
+	CHECK_EQUAL_C_INT(JSMN_ERROR_INVAL, aws_iot_json_stream_feed(&stream, json + 10, strlen(json) - 10));
+	CHECK_EQUAL_C_INT(JSMN_ERROR_INVAL, aws_iot_json_stream_finish(&stream));
+}
+
+TEST_C(JsonStream, NonContiguousChunkIsInvalid) {
+	const char *json = "{\"a\":1}";
+
+	IOT_DEBUG("\n-->Running Json Stream Tests - Non contiguous chunk is invalid \n");
+
+	aws_iot_json_stream_init(&stream, json, tokens, TEST_TOKEN_COUNT, false);
+	CHECK_EQUAL_C_INT(JSMN_ERROR_PART, aws_iot_json_stream_feed(&stream, json, 3));
+	CHECK_EQUAL_C_INT(JSMN_ERROR_INVAL, aws_iot_json_stream_feed(&stream, json + 4, 3));
+}
+
+TEST_C(JsonStream, NoMemWithoutCountOnOverflow) {
+	IOT_DEBUG("\n-->Running Json Stream Tests - No memory without count on overflow \n");
+
+	aws_iot_json_stream_init(&stream, shadowDocument, tokens, 4, false);
+	CHECK_EQUAL_C_INT(JSMN_ERROR_NOMEM, aws_iot_json_stream_feed(&stream, shadowDocument, strlen(shadowDocument)));
+	CHECK_EQUAL_C_INT(JSMN_ERROR_NOMEM, aws_iot_json_stream_finish(&stream));
+}
+
+TEST_C(JsonStream, CountOnOverflowReportsTokensNeeded) {
+	int expected, r = JSMN_ERROR_PART;
+	size_t i, len = strlen(shadowDocument);
+
+	IOT_DEBUG("\n-->Running Json Stream Tests - Count on overflow reports tokens needed \n");
+
+	expected = referenceParse(shadowDocument);
+
+	aws_iot_json_stream_init(&stream, shadowDocument, tokens, 4, true);
+	for (i = 0; i < len; i += 7) {
+		size_t chunk = (len - i < 7) ? len - i : 7;
+		r = aws_iot_json_stream_feed(&stream, shadowDocument + i, chunk);
+		if (i + chunk < len) {
+			CHECK_EQUAL_C_INT(JSMN_ERROR_PART, r);
+		}
+	}
+
+	CHECK_EQUAL_C_INT(JSMN_ERROR_NOMEM, r);
+	CHECK_EQUAL_C_INT(expected, (int) aws_iot_json_stream_tokens_needed(&stream));
+}
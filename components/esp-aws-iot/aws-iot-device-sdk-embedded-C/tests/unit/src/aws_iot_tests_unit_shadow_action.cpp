@@ -49,3 +49,5 @@ TEST_GROUP_C_WRAPPER(ShadowActionTests, NoCallbackForShadowAction)
 TEST_GROUP_C_WRAPPER(ShadowActionTests, GetAndDeleteRequest)
 TEST_GROUP_C_WRAPPER(ShadowActionTests, ExtractClientToken)
 TEST_GROUP_C_WRAPPER(ShadowActionTests, IsReceivedJsonValid)
+TEST_GROUP_C_WRAPPER(ShadowActionTests, WildcardAckSubscriptionSkipsPerActionSubscribe)
+TEST_GROUP_C_WRAPPER(ShadowActionTests, WildcardAckSubscriptionIgnoresNonAckTopics)
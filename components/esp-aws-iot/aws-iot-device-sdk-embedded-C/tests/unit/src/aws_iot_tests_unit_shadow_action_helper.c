@@ -942,3 +942,94 @@ TEST_C(ShadowActionTests, NoCallbackForShadowAction) {
 
 	IOT_DEBUG("-->Success - No callback for shadow action");
 }
+
+static void reconnectWithWildcardAckSubscription(void) {
+	IoT_Error_t ret_val;
+
+	ret_val = aws_iot_shadow_disconnect(&client);
+	CHECK_EQUAL_C_INT(SUCCESS, ret_val);
+
+	lastSubscribeMsgLen = 11;
+	snprintf(LastSubscribeMessage, lastSubscribeMsgLen, "No Message");
+
+	shadowConnectParams.enableWildcardAckSubscription = true;
+	setTLSRxBufferForConnackAndSuback(&connectParams, 0, WILDCARD_ACK_TOPIC, strlen(WILDCARD_ACK_TOPIC), QOS0);
+	ret_val = aws_iot_shadow_connect(&client, &shadowConnectParams);
+	shadowConnectParams.enableWildcardAckSubscription = false;
+	CHECK_EQUAL_C_INT(SUCCESS, ret_val);
+	CHECK_EQUAL_C_STRING(WILDCARD_ACK_TOPIC, LastSubscribeMessage);
+}
+
+TEST_C(ShadowActionTests, WildcardAckSubscriptionSkipsPerActionSubscribe) {
+	IoT_Error_t ret_val = SUCCESS;
+	char getRequestJson[TEST_JSON_SIZE];
+	IoT_Publish_Message_Params params;
+
+	IOT_DEBUG("-->Running Shadow Action Tests - Wildcard ack subscription skips per action subscribe \n");
+
+	reconnectWithWildcardAckSubscription();
+
+	lastSubscribeMsgLen = 11;
+	snprintf(LastSubscribeMessage, lastSubscribeMsgLen, "No Message");
+	lastUnsubscribeMsgLen = 11;
+	snprintf(LastUnsubscribeMessage, lastUnsubscribeMsgLen, "No Message");
+
+	aws_iot_shadow_internal_get_request_json(getRequestJson, TEST_JSON_SIZE);
+	ret_val = aws_iot_shadow_internal_action(AWS_IOT_MY_THING_NAME, SHADOW_GET, getRequestJson, TEST_JSON_SIZE, actionCallback, NULL, 4,
+											 false);
+	CHECK_EQUAL_C_INT(SUCCESS, ret_val);
+	CHECK_EQUAL_C_STRING("No Message", LastSubscribeMessage);
+
+	params.payloadLen = strlen(TEST_JSON_RESPONSE_FULL_DOCUMENT);
+	params.payload = TEST_JSON_RESPONSE_FULL_DOCUMENT;
+	params.qos = QOS0;
+	setTLSRxBufferWithMsgOnSubscribedTopic(GET_ACCEPTED_TOPIC, strlen(GET_ACCEPTED_TOPIC), QOS0, params,
+										   params.payload);
+	ret_val = aws_iot_shadow_yield(&client, 200);
+
+	CHECK_EQUAL_C_INT(SUCCESS, ret_val);
+	CHECK_EQUAL_C_STRING(TEST_JSON_RESPONSE_FULL_DOCUMENT, jsonFullDocument);
+	CHECK_EQUAL_C_INT(SHADOW_GET, actionRx);
+	CHECK_EQUAL_C_INT(SHADOW_ACK_ACCEPTED, ackStatusRx);
+	CHECK_EQUAL_C_STRING("No Message", LastUnsubscribeMessage);
+
+	IOT_DEBUG("-->Success - Wildcard ack subscription skips per action subscribe \n");
+}
+
+TEST_C(ShadowActionTests, WildcardAckSubscriptionIgnoresNonAckTopics) {
+	IoT_Error_t ret_val = SUCCESS;
+	char updateRequestJson[SIZE_OF_UPDATE_DOCUMENT];
+	IoT_Publish_Message_Params params;
+
+	IOT_DEBUG("-->Running Shadow Action Tests - Wildcard ack subscription ignores non ack topics \n");
+
+	reconnectWithWildcardAckSubscription();
+
+	snprintf(updateRequestJson, SIZE_OF_UPDATE_DOCUMENT, "{\"state\":{\"reported\":{\"sensor1\":98}}, \"clientToken\":\"%s-0\"}",
+			 AWS_IOT_MQTT_CLIENT_ID);
+	ret_val = aws_iot_shadow_internal_action(AWS_IOT_MY_THING_NAME, SHADOW_UPDATE, updateRequestJson, SIZE_OF_UPDATE_DOCUMENT,
+											 actionCallback, NULL, 4, false);
+	CHECK_EQUAL_C_INT(SUCCESS, ret_val);
+
+	snprintf(jsonFullDocument, 200, "NOT_VISITED");
+
+	// update/documents carries the same client token but is not a response to the request
+	params.payloadLen = strlen(TEST_JSON_RESPONSE_UPDATE_DOCUMENT);
+	params.payload = TEST_JSON_RESPONSE_UPDATE_DOCUMENT;
+	params.qos = QOS0;
+	setTLSRxBufferWithMsgOnSubscribedTopic(UPDATE_DOCUMENTS_TOPIC, strlen(UPDATE_DOCUMENTS_TOPIC), QOS0, params,
+										   params.payload);
+	ret_val = aws_iot_shadow_yield(&client, 200);
+	CHECK_EQUAL_C_INT(SUCCESS, ret_val);
+	CHECK_EQUAL_C_STRING("NOT_VISITED", jsonFullDocument);
+
+	setTLSRxBufferWithMsgOnSubscribedTopic(UPDATE_REJECTED_TOPIC, strlen(UPDATE_REJECTED_TOPIC), QOS0, params,
+										   params.payload);
+	ret_val = aws_iot_shadow_yield(&client, 200);
+	CHECK_EQUAL_C_INT(SUCCESS, ret_val);
+	CHECK_EQUAL_C_STRING(TEST_JSON_RESPONSE_UPDATE_DOCUMENT, jsonFullDocument);
+	CHECK_EQUAL_C_INT(SHADOW_UPDATE, actionRx);
+	CHECK_EQUAL_C_INT(SHADOW_ACK_REJECTED, ackStatusRx);
+
+	IOT_DEBUG("-->Success - Wildcard ack subscription ignores non ack topics \n");
+}
@@ -58,6 +58,21 @@
 #define MAX_SIZE_OF_THING_NAME CONFIG_AWS_IOT_SHADOW_MAX_SIZE_OF_THING_NAME ///< The Thing Name should not be bigger than this value. Modify this if the Thing Name needs to be bigger
 #define MAX_SHADOW_TOPIC_LENGTH_BYTES (MAX_SHADOW_TOPIC_LENGTH_WITHOUT_THINGNAME + MAX_SIZE_OF_THING_NAME) ///< This size includes the length of topic with Thing Name
 
+// Job specific configs
+#define MAX_SIZE_OF_JOB_ID CONFIG_AWS_IOT_JOBS_MAX_SIZE_OF_JOB_ID ///< The Job ID should not be bigger than this value
+#define MAX_JOB_JSON_TOKEN_EXPECTED CONFIG_AWS_IOT_JOBS_MAX_JSON_TOKEN_EXPECTED ///< Max tokens expected in a received Jobs message, including the job document
+#define MAX_SIZE_OF_JOB_REQUEST AWS_IOT_MQTT_TX_BUF_LEN
+#define MAX_JOB_TOPIC_LENGTH_WITHOUT_JOB_ID_OR_THING_NAME 40
+#define MAX_JOB_TOPIC_LENGTH_BYTES MAX_JOB_TOPIC_LENGTH_WITHOUT_JOB_ID_OR_THING_NAME + MAX_SIZE_OF_THING_NAME + MAX_SIZE_OF_JOB_ID + 2
+#define JOBS_RUNNER_QUEUE_LENGTH CONFIG_AWS_IOT_JOBS_RUNNER_QUEUE_LENGTH ///< Job executions the jobs runner holds, queued or running
+#define JOBS_RUNNER_MAX_CONCURRENT_JOBS CONFIG_AWS_IOT_JOBS_RUNNER_MAX_CONCURRENT_JOBS ///< Default number of job executions running at the same time
+#define JOBS_RUNNER_MAX_DOCUMENT_LENGTH CONFIG_AWS_IOT_JOBS_RUNNER_MAX_DOCUMENT_LENGTH ///< Largest job document the jobs runner executes
+
+// JSON parsing
+#ifdef CONFIG_AWS_IOT_JSON_FAST_SCAN
+#define AWS_IOT_JSON_FAST_SCAN ///< Tokenize Shadow documents with aws_iot_json_scan_parse instead of jsmn_parse
+#endif
+
 // Auto Reconnect specific config
 #define AWS_IOT_MQTT_MIN_RECONNECT_WAIT_INTERVAL CONFIG_AWS_IOT_MQTT_MIN_RECONNECT_WAIT_INTERVAL ///< Minimum time before the First reconnect attempt is made as part of the exponential back-off algorithm
 #define AWS_IOT_MQTT_MAX_RECONNECT_WAIT_INTERVAL CONFIG_AWS_IOT_MQTT_MAX_RECONNECT_WAIT_INTERVAL ///< Maximum time interval after which exponential back-off will stop attempting to reconnect.
@@ -0,0 +1,63 @@
+/*
+ * Park It! - Core2 for AWS IoT EduKit
+ * ui.h
+ *
+ * The widgets of the app are created once by ui_init() and reused.
+ * Selecting a sensor binds the capture view (bar, buttons, chart and text area)
+ * to the sensor's template instead of creating new widgets.
+ */
+
+#ifndef UI_H
+#define UI_H
+
+#include "lvgl/lvgl.h"
+
+/* Maximal number of chart series of a sensor */
+#define UI_SERIES_MAX 3
+
+typedef enum
+{
+    UI_SENSOR_GSR = 0,
+    UI_SENSOR_MIC,
+    UI_SENSOR_GYRO,
+    UI_SENSOR_NUM,
+} ui_sensor_t;
+
+/* Event callbacks of the app's widgets */
+typedef struct
+{
+    lv_event_cb_t home_cb;   /* "Park It!" button */
+    lv_event_cb_t sensor_cb; /* Sensor button matrix */
+    lv_event_cb_t start_cb;  /* "Start" button */
+    lv_event_cb_t send_cb;   /* "Send" button */
+    lv_event_cb_t mbox_cb;   /* Message box shown after sending */
+} ui_event_cbs_t;
+
+/* Create all the widgets of the app on a screen and show the home view */
+void ui_init(lv_obj_t *scr, const ui_event_cbs_t *cbs);
+
+/* Show the sensor selector and hide the capture view */
+void ui_show_home(void);
+
+/* Show the capture view of a sensor with an empty chart */
+void ui_show_capture(ui_sensor_t sensor);
+
+/* Show the "Send" button when the capture is finished */
+void ui_show_send_btn(void);
+
+/* Show the message box about the sent data */
+void ui_show_sent_msg(void);
+
+/* Set the value of the capture's progress bar (0..100) */
+void ui_set_progress(int16_t value);
+
+/* Add the next values of the active sensor's series to the chart and show a text about them */
+void ui_add_sample(const lv_coord_t *values, const char *text);
+
+/* Get the sensor of a button text of the sensor selector. UI_SENSOR_NUM if unknown. */
+ui_sensor_t ui_get_sensor_by_name(const char *name);
+
+/* Get the name of a sensor, also used as the measurement type */
+const char *ui_get_sensor_name(ui_sensor_t sensor);
+
+#endif /* UI_H */
@@ -21,6 +21,7 @@
 #include "core2forAWS.h"
 
 #include "wifi.h"
+#include "ui.h"
 
 void disconnect_callback_handler(AWS_IoT_Client *pClient, void *data);
 static void publisher(AWS_IoT_Client *client, char *base_topic, uint16_t base_topic_len);
@@ -35,24 +36,6 @@ static void send_btn_event_handler(lv_obj_t *obj, lv_event_t event);
 
 TaskHandle_t barTimerHandler_handle;
 
-lv_obj_t *sensor_btnm;
-lv_obj_t *gsr_chart;
-lv_obj_t *gsr_text_area;
-lv_obj_t *timer_bar;
-lv_obj_t *start_btn;
-lv_chart_series_t *gsr_ser1;
-lv_obj_t *home_btn;
-lv_obj_t *send_btn;
-lv_obj_t *mbox1;
-lv_obj_t *mic_chart;
-lv_chart_series_t *mic_ser1;
-lv_obj_t *mic_text_area;
-lv_obj_t *gyro_chart;
-lv_chart_series_t *gyro_ser1;
-lv_chart_series_t *gyro_ser2;
-lv_chart_series_t *gyro_ser3;
-lv_obj_t *gyro_text_area;
-
 bool isBarTimerComplete = true;
 
 int gsr = 0;
@@ -97,17 +80,14 @@ void app_main()
 
     Core2ForAWS_Sk6812_Show();
 
-    home_btn = lv_btn_create(lv_scr_act(), NULL);
-    lv_obj_align(home_btn, NULL, LV_ALIGN_IN_TOP_MID, 0, 10);
-    lv_obj_set_style_local_value_str(home_btn, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, "Park It!");
-    lv_obj_set_event_cb(home_btn, home_btn_event_handler);
-
-    static const char *sensor_btnm_map[] = {"GSR", "Mic", "Gyro", ""};
-
-    sensor_btnm = lv_btnmatrix_create(lv_scr_act(), NULL);
-    lv_btnmatrix_set_map(sensor_btnm, sensor_btnm_map);
-    lv_obj_align(sensor_btnm, NULL, LV_ALIGN_CENTER, 5, 10);
-    lv_obj_set_event_cb(sensor_btnm, sensor_btnm_event_handler);
+    static const ui_event_cbs_t ui_cbs = {
+        .home_cb = home_btn_event_handler,
+        .sensor_cb = sensor_btnm_event_handler,
+        .start_cb = start_btn_event_handler,
+        .send_cb = send_btn_event_handler,
+        .mbox_cb = mbox_event_cb,
+    };
+    ui_init(lv_scr_act(), &ui_cbs);
 
     initialise_wifi();
 
@@ -216,35 +196,17 @@ static void publisher(AWS_IoT_Client *client, char *base_topic, uint16_t base_to
         }
     }
 
-    static const char *btns[] = {"Continue", ""};
-
-    mbox1 = lv_msgbox_create(lv_scr_act(), NULL);
-    lv_msgbox_set_text(mbox1, "Open the Park It! website to view the updated data");
-    lv_msgbox_add_btns(mbox1, btns);
-    lv_obj_set_width(mbox1, 200);
-    lv_obj_set_event_cb(mbox1, mbox_event_cb);
-    lv_obj_align(mbox1, NULL, LV_ALIGN_CENTER, 0, 0);
     Core2ForAWS_Motor_SetStrength(50);
-    lv_obj_set_hidden(mbox1, false);
+    ui_show_sent_msg();
 }
 
 static void mbox_event_cb(lv_obj_t *obj, lv_event_t evt)
 {
     if (evt == LV_EVENT_VALUE_CHANGED)
     {
-        lv_obj_set_hidden(gsr_chart, true);
-        lv_obj_set_hidden(gsr_text_area, true);
-        lv_obj_set_hidden(mic_chart, true);
-        lv_obj_set_hidden(mic_text_area, true);
-        lv_obj_set_hidden(gyro_chart, true);
-        lv_obj_set_hidden(gyro_text_area, true);
-        lv_obj_set_hidden(timer_bar, true);
-        lv_obj_set_hidden(start_btn, true);
-        lv_obj_set_hidden(send_btn, true);
-        lv_obj_set_hidden(mbox1, true);
+        ui_show_home();
         listCounter = 0;
         isBarTimerComplete = true;
-        lv_obj_set_hidden(sensor_btnm, false);
         Core2ForAWS_Motor_SetStrength(0);
     }
 }
@@ -394,17 +356,17 @@ void barTimerHandler(void *param)
                 getGsrInput(NULL);
                 if (counter <= 100)
                 {
-                    lv_bar_set_value(timer_bar, counter, LV_ANIM_ON);
+                    ui_set_progress(counter);
                 }
                 else
                 {
                     isBarTimerComplete = true;
-                    lv_obj_set_hidden(send_btn, false);
+                    ui_show_send_btn();
                 }
                 char gsr_text[100];
                 sprintf(gsr_text, "GSR: %d\n--------------------\nMoving Average: %d", gsr, gsr_avg);
-                lv_chart_set_next(gsr_chart, gsr_ser1, gsr);
-                lv_textarea_set_text(gsr_text_area, gsr_text);
+                lv_coord_t gsr_values[] = {gsr};
+                ui_add_sample(gsr_values, gsr_text);
                 vTaskDelay(10);
             }
             else if (strcmp(listType, "Mic") == 0)
@@ -412,17 +374,17 @@ void barTimerHandler(void *param)
                 getMicInput(NULL);
                 if (counter <= 100)
                 {
-                    lv_bar_set_value(timer_bar, counter, LV_ANIM_ON);
+                    ui_set_progress(counter);
                 }
                 else
                 {
                     isBarTimerComplete = true;
-                    lv_obj_set_hidden(send_btn, false);
+                    ui_show_send_btn();
                 }
                 char mic_text[100];
                 sprintf(mic_text, "Mic: %d\n--------------------\nMoving Average: %d", mic, mic_avg);
-                lv_chart_set_next(mic_chart, mic_ser1, mic);
-                lv_textarea_set_text(mic_text_area, mic_text);
+                lv_coord_t mic_values[] = {mic};
+                ui_add_sample(mic_values, mic_text);
                 vTaskDelay(10);
             }
             else
@@ -430,19 +392,17 @@ void barTimerHandler(void *param)
                 getGyroInput(NULL);
                 if (counter <= 100)
                 {
-                    lv_bar_set_value(timer_bar, counter, LV_ANIM_ON);
+                    ui_set_progress(counter);
                 }
                 else
                 {
                     isBarTimerComplete = true;
-                    lv_obj_set_hidden(send_btn, false);
+                    ui_show_send_btn();
                 }
                 char gyro_text[100];
                 sprintf(gyro_text, "Roll: %.2f\nYaw: %.2f\nPitch: %.2f\n", roll, yaw, pitch);
-                lv_chart_set_next(gyro_chart, gyro_ser1, roll);
-                lv_chart_set_next(gyro_chart, gyro_ser2, yaw);
-                lv_chart_set_next(gyro_chart, gyro_ser3, pitch);
-                lv_textarea_set_text(gyro_text_area, gyro_text);
+                lv_coord_t gyro_values[] = {roll, yaw, pitch};
+                ui_add_sample(gyro_values, gyro_text);
                 vTaskDelay(10);
             }
         }
@@ -482,144 +442,16 @@ static void sensor_btnm_event_handler(lv_obj_t *obj, lv_event_t event)
 {
     if (event == LV_EVENT_VALUE_CHANGED)
     {
-        lv_obj_set_hidden(sensor_btnm, true);
         const char *txt = lv_btnmatrix_get_active_btn_text(obj);
-        timer_bar = lv_bar_create(lv_scr_act(), NULL);
-        lv_obj_set_hidden(timer_bar, true);
-        lv_obj_set_size(timer_bar, 147, 15);
-        lv_obj_align(timer_bar, NULL, LV_ALIGN_IN_RIGHT_MID, -10, 40);
-        lv_bar_set_anim_time(timer_bar, 2000);
-        static lv_style_t style_halo;
-        lv_style_init(&style_halo);
-        lv_style_set_transition_time(&style_halo, LV_STATE_PRESSED, 400);
-        lv_style_set_transition_time(&style_halo, LV_STATE_DEFAULT, 0);
-        lv_style_set_transition_delay(&style_halo, LV_STATE_DEFAULT, 200);
-        lv_style_set_outline_width(&style_halo, LV_STATE_DEFAULT, 0);
-        lv_style_set_outline_width(&style_halo, LV_STATE_PRESSED, 20);
-        lv_style_set_outline_opa(&style_halo, LV_STATE_DEFAULT, LV_OPA_COVER);
-        lv_style_set_outline_opa(&style_halo, LV_STATE_FOCUSED, LV_OPA_COVER);
-        lv_style_set_outline_opa(&style_halo, LV_STATE_PRESSED, LV_OPA_TRANSP);
-        lv_style_set_transition_prop_1(&style_halo, LV_STATE_DEFAULT, LV_STYLE_OUTLINE_OPA);
-        lv_style_set_transition_prop_2(&style_halo, LV_STATE_DEFAULT, LV_STYLE_OUTLINE_WIDTH);
-        start_btn = lv_btn_create(lv_scr_act(), NULL);
-        lv_obj_set_hidden(start_btn, true);
-        lv_obj_align(start_btn, NULL, LV_ALIGN_IN_RIGHT_MID, -25, 10);
-        lv_obj_set_size(start_btn, 140, 35);
-        lv_obj_add_style(start_btn, LV_BTN_PART_MAIN, &style_halo);
-        lv_obj_set_style_local_value_str(start_btn, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, "Start");
-        lv_obj_set_event_cb(start_btn, start_btn_event_handler);
-        send_btn = lv_btn_create(lv_scr_act(), NULL);
-        lv_obj_align(send_btn, NULL, LV_ALIGN_IN_RIGHT_MID, -25, -30);
-        lv_obj_add_style(send_btn, LV_BTN_PART_MAIN, &style_halo);
-        lv_obj_set_size(send_btn, 140, 35);
-        lv_obj_set_style_local_value_str(send_btn, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, "Send");
-        lv_obj_set_event_cb(send_btn, send_btn_event_handler);
-        lv_obj_set_hidden(send_btn, true);
-        gsr_chart = lv_chart_create(lv_scr_act(), NULL);
-        lv_obj_set_hidden(gsr_chart, true);
-        gsr_text_area = lv_textarea_create(lv_scr_act(), NULL);
-        lv_obj_set_hidden(gsr_text_area, true);
-        mic_chart = lv_chart_create(lv_scr_act(), NULL);
-        lv_obj_set_hidden(mic_chart, true);
-        mic_text_area = lv_textarea_create(lv_scr_act(), NULL);
-        lv_obj_set_hidden(mic_text_area, true);
-        gyro_chart = lv_chart_create(lv_scr_act(), NULL);
-        lv_obj_set_hidden(gyro_chart, true);
-        gyro_text_area = lv_textarea_create(lv_scr_act(), NULL);
-        lv_obj_set_hidden(gyro_text_area, true);
-        if (strcmp(txt, "GSR") == 0)
-        {
-            lv_obj_set_hidden(mic_chart, true);
-            lv_obj_set_hidden(mic_text_area, true);
-            lv_obj_set_hidden(gyro_chart, true);
-            lv_obj_set_hidden(gyro_text_area, true);
-            lv_obj_set_hidden(start_btn, false);
-            lv_obj_set_hidden(timer_bar, false);
-
-            listType = "GSR";
-
-            lv_obj_set_hidden(gsr_text_area, false);
-            lv_obj_set_size(gsr_text_area, 147, 100);
-            lv_obj_align(gsr_text_area, NULL, LV_ALIGN_IN_LEFT_MID, 10, 0);
-            lv_textarea_set_cursor_hidden(gsr_text_area, true);
-            char gsr_text[100];
-            sprintf(gsr_text, "GSR:  \n--------------------\nMoving Average:  ");
-            lv_textarea_set_text(gsr_text_area, gsr_text);
-
-            lv_obj_set_hidden(gsr_chart, false);
-            lv_obj_set_size(gsr_chart, 300, 50);
-            lv_obj_align(gsr_chart, NULL, LV_ALIGN_IN_BOTTOM_MID, 0, -5);
-            lv_chart_set_type(gsr_chart, LV_CHART_TYPE_LINE);
-            lv_chart_set_range(gsr_chart, 0, 4095);
-
-            gsr_ser1 = lv_chart_add_series(gsr_chart, LV_COLOR_RED);
-
-            lv_chart_refresh(gsr_chart);
-        }
-        else if (strcmp(txt, "Mic") == 0)
-        {
-            lv_obj_set_hidden(gsr_chart, true);
-            lv_obj_set_hidden(gsr_text_area, true);
-            lv_obj_set_hidden(gyro_chart, true);
-            lv_obj_set_hidden(gyro_text_area, true);
-            lv_obj_set_hidden(start_btn, false);
-            lv_obj_set_hidden(timer_bar, false);
-
-            listType = "Mic";
-
-            lv_obj_set_hidden(mic_text_area, false);
-            lv_obj_set_size(mic_text_area, 147, 100);
-            lv_obj_align(mic_text_area, NULL, LV_ALIGN_IN_LEFT_MID, 10, 0);
-            lv_textarea_set_cursor_hidden(mic_text_area, true);
-            char mic_text[100];
-            sprintf(mic_text, "Mic:  \n--------------------\nMoving Average:  ");
-            lv_textarea_set_text(mic_text_area, mic_text);
-
-            lv_obj_set_hidden(mic_chart, false);
-            lv_obj_set_size(mic_chart, 300, 50);
-            lv_obj_align(mic_chart, NULL, LV_ALIGN_IN_BOTTOM_MID, 0, -5);
-            lv_chart_set_type(mic_chart, LV_CHART_TYPE_LINE);
-            lv_chart_set_range(mic_chart, -35, 0);
-
-            mic_ser1 = lv_chart_add_series(mic_chart, LV_COLOR_RED);
-
-            lv_chart_refresh(mic_chart);
-        }
-        else if (strcmp(txt, "Gyro") == 0)
-        {
-            lv_obj_set_hidden(gsr_chart, true);
-            lv_obj_set_hidden(gsr_text_area, true);
-            lv_obj_set_hidden(mic_chart, true);
-            lv_obj_set_hidden(mic_text_area, true);
-            lv_obj_set_hidden(start_btn, false);
-            lv_obj_set_hidden(timer_bar, false);
-
-            listType = "Gyro";
-
-            lv_obj_set_hidden(gyro_text_area, false);
-            lv_obj_set_size(gyro_text_area, 147, 100);
-            lv_obj_align(gyro_text_area, NULL, LV_ALIGN_IN_LEFT_MID, 10, 0);
-            lv_textarea_set_cursor_hidden(gyro_text_area, true);
-            char gyro_text[100];
-            sprintf(gyro_text, "Roll: \nYaw: \nPitch: \n");
-            lv_textarea_set_text(gyro_text_area, gyro_text);
-
-            lv_obj_set_hidden(gyro_chart, false);
-            lv_obj_set_size(gyro_chart, 300, 50);
-            lv_obj_align(gyro_chart, NULL, LV_ALIGN_IN_BOTTOM_MID, 0, -5);
-            lv_chart_set_type(gyro_chart, LV_CHART_TYPE_LINE);
-            lv_chart_set_range(gyro_chart, -200, 200);
-
-            gyro_ser1 = lv_chart_add_series(gyro_chart, LV_COLOR_RED);
-            gyro_ser2 = lv_chart_add_series(gyro_chart, LV_COLOR_GREEN);
-            gyro_ser3 = lv_chart_add_series(gyro_chart, LV_COLOR_BLUE);
-
-            lv_chart_refresh(gyro_chart);
-        }
-        else
+        ui_sensor_t sensor = txt ? ui_get_sensor_by_name(txt) : UI_SENSOR_NUM;
+        if (sensor == UI_SENSOR_NUM)
         {
             printf("Type not detected\n");
+            return;
         }
+
+        listType = (char *)ui_get_sensor_name(sensor);
+        ui_show_capture(sensor);
     }
 }
 
@@ -627,16 +459,7 @@ static void home_btn_event_handler(lv_obj_t *obj, lv_event_t event)
 {
     if (event == LV_EVENT_CLICKED)
     {
-        lv_obj_set_hidden(sensor_btnm, false);
-        lv_obj_set_hidden(gsr_chart, true);
-        lv_obj_set_hidden(gsr_text_area, true);
-        lv_obj_set_hidden(mic_chart, true);
-        lv_obj_set_hidden(mic_text_area, true);
-        lv_obj_set_hidden(gyro_chart, true);
-        lv_obj_set_hidden(gyro_text_area, true);
-        lv_obj_set_hidden(timer_bar, true);
-        lv_obj_set_hidden(start_btn, true);
-        lv_obj_set_hidden(send_btn, true);
+        ui_show_home();
         listCounter = 0;
 
         isBarTimerComplete = true;
@@ -0,0 +1,212 @@
+/*
+ * Park It! - Core2 for AWS IoT EduKit
+ * ui.c
+ *
+ * The widgets of the app are created once by ui_init() and reused.
+ * Selecting a sensor binds the capture view (bar, buttons, chart and text area)
+ * to the sensor's template instead of creating new widgets.
+ */
+
+#include <string.h>
+
+#include "ui.h"
+
+/* Template of a sensor's capture view */
+typedef struct
+{
+    const char *name;       /* Button text and measurement type */
+    const char *empty_text; /* Text of the text area before the first sample */
+    lv_coord_t y_min;
+    lv_coord_t y_max;
+    uint8_t series_cnt;
+    uint32_t series_colors[UI_SERIES_MAX];
+} ui_sensor_view_t;
+
+static const ui_sensor_view_t sensor_views[UI_SENSOR_NUM] = {
+    [UI_SENSOR_GSR] = {"GSR", "GSR:  \n--------------------\nMoving Average:  ", 0, 4095, 1, {0xFF0000}},
+    [UI_SENSOR_MIC] = {"Mic", "Mic:  \n--------------------\nMoving Average:  ", -35, 0, 1, {0xFF0000}},
+    [UI_SENSOR_GYRO] = {"Gyro", "Roll: \nYaw: \nPitch: \n", -200, 200, 3, {0xFF0000, 0x008000, 0x0000FF}},
+};
+
+static lv_obj_t *home_btn;
+static lv_obj_t *sensor_btnm;
+static lv_obj_t *timer_bar;
+static lv_obj_t *start_btn;
+static lv_obj_t *send_btn;
+static lv_obj_t *chart;
+static lv_obj_t *text_area;
+static lv_obj_t *mbox;
+
+/* The series of every sensor are added once, only the active sensor's series are shown */
+static lv_chart_series_t *series[UI_SENSOR_NUM][UI_SERIES_MAX];
+static ui_sensor_t active_sensor = UI_SENSOR_GSR;
+
+static lv_style_t style_halo;
+
+static void set_capture_hidden(bool hidden);
+
+void ui_init(lv_obj_t *scr, const ui_event_cbs_t *cbs)
+{
+    home_btn = lv_btn_create(scr, NULL);
+    lv_obj_align(home_btn, NULL, LV_ALIGN_IN_TOP_MID, 0, 10);
+    lv_obj_set_style_local_value_str(home_btn, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, "Park It!");
+    lv_obj_set_event_cb(home_btn, cbs->home_cb);
+
+    static const char *sensor_btnm_map[UI_SENSOR_NUM + 1];
+    for (int s = 0; s < UI_SENSOR_NUM; s++)
+    {
+        sensor_btnm_map[s] = sensor_views[s].name;
+    }
+    sensor_btnm_map[UI_SENSOR_NUM] = "";
+
+    sensor_btnm = lv_btnmatrix_create(scr, NULL);
+    lv_btnmatrix_set_map(sensor_btnm, sensor_btnm_map);
+    lv_obj_align(sensor_btnm, NULL, LV_ALIGN_CENTER, 5, 10);
+    lv_obj_set_event_cb(sensor_btnm, cbs->sensor_cb);
+
+    timer_bar = lv_bar_create(scr, NULL);
+    lv_obj_set_size(timer_bar, 147, 15);
+    lv_obj_align(timer_bar, NULL, LV_ALIGN_IN_RIGHT_MID, -10, 40);
+    lv_bar_set_anim_time(timer_bar, 2000);
+
+    lv_style_init(&style_halo);
+    lv_style_set_transition_time(&style_halo, LV_STATE_PRESSED, 400);
+    lv_style_set_transition_time(&style_halo, LV_STATE_DEFAULT, 0);
+    lv_style_set_transition_delay(&style_halo, LV_STATE_DEFAULT, 200);
+    lv_style_set_outline_width(&style_halo, LV_STATE_DEFAULT, 0);
+    lv_style_set_outline_width(&style_halo, LV_STATE_PRESSED, 20);
+    lv_style_set_outline_opa(&style_halo, LV_STATE_DEFAULT, LV_OPA_COVER);
+    lv_style_set_outline_opa(&style_halo, LV_STATE_FOCUSED, LV_OPA_COVER);
+    lv_style_set_outline_opa(&style_halo, LV_STATE_PRESSED, LV_OPA_TRANSP);
+    lv_style_set_transition_prop_1(&style_halo, LV_STATE_DEFAULT, LV_STYLE_OUTLINE_OPA);
+    lv_style_set_transition_prop_2(&style_halo, LV_STATE_DEFAULT, LV_STYLE_OUTLINE_WIDTH);
+
+    start_btn = lv_btn_create(scr, NULL);
+    lv_obj_align(start_btn, NULL, LV_ALIGN_IN_RIGHT_MID, -25, 10);
+    lv_obj_set_size(start_btn, 140, 35);
+    lv_obj_add_style(start_btn, LV_BTN_PART_MAIN, &style_halo);
+    lv_obj_set_style_local_value_str(start_btn, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, "Start");
+    lv_obj_set_event_cb(start_btn, cbs->start_cb);
+
+    send_btn = lv_btn_create(scr, NULL);
+    lv_obj_align(send_btn, NULL, LV_ALIGN_IN_RIGHT_MID, -25, -30);
+    lv_obj_add_style(send_btn, LV_BTN_PART_MAIN, &style_halo);
+    lv_obj_set_size(send_btn, 140, 35);
+    lv_obj_set_style_local_value_str(send_btn, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, "Send");
+    lv_obj_set_event_cb(send_btn, cbs->send_cb);
+
+    chart = lv_chart_create(scr, NULL);
+    lv_obj_set_size(chart, 300, 50);
+    lv_obj_align(chart, NULL, LV_ALIGN_IN_BOTTOM_MID, 0, -5);
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    for (int s = 0; s < UI_SENSOR_NUM; s++)
+    {
+        for (int i = 0; i < sensor_views[s].series_cnt; i++)
+        {
+            series[s][i] = lv_chart_add_series(chart, lv_color_hex(sensor_views[s].series_colors[i]));
+        }
+    }
+
+    text_area = lv_textarea_create(scr, NULL);
+    lv_obj_set_size(text_area, 147, 100);
+    lv_obj_align(text_area, NULL, LV_ALIGN_IN_LEFT_MID, 10, 0);
+    lv_textarea_set_cursor_hidden(text_area, true);
+
+    static const char *mbox_btns[] = {"Continue", ""};
+
+    mbox = lv_msgbox_create(scr, NULL);
+    lv_msgbox_set_text(mbox, "Open the Park It! website to view the updated data");
+    lv_msgbox_add_btns(mbox, mbox_btns);
+    lv_obj_set_width(mbox, 200);
+    lv_obj_set_event_cb(mbox, cbs->mbox_cb);
+    lv_obj_align(mbox, NULL, LV_ALIGN_CENTER, 0, 0);
+
+    ui_show_home();
+}
+
+void ui_show_home(void)
+{
+    set_capture_hidden(true);
+    lv_obj_set_hidden(mbox, true);
+    lv_obj_set_hidden(sensor_btnm, false);
+}
+
+void ui_show_capture(ui_sensor_t sensor)
+{
+    const ui_sensor_view_t *view = &sensor_views[sensor];
+    active_sensor = sensor;
+
+    /* Bind the chart to the sensor: show only its series, emptied */
+    for (int s = 0; s < UI_SENSOR_NUM; s++)
+    {
+        for (int i = 0; i < sensor_views[s].series_cnt; i++)
+        {
+            lv_chart_hide_series(chart, series[s][i], (ui_sensor_t)s != sensor);
+            if ((ui_sensor_t)s == sensor)
+            {
+                lv_chart_clear_series(chart, series[s][i]);
+            }
+        }
+    }
+    lv_chart_set_y_range(chart, LV_CHART_AXIS_PRIMARY_Y, view->y_min, view->y_max);
+    lv_chart_refresh(chart);
+
+    lv_textarea_set_text(text_area, view->empty_text);
+    lv_bar_set_value(timer_bar, 0, LV_ANIM_OFF);
+
+    lv_obj_set_hidden(sensor_btnm, true);
+    lv_obj_set_hidden(mbox, true);
+    set_capture_hidden(false);
+    lv_obj_set_hidden(send_btn, true);
+}
+
+void ui_show_send_btn(void)
+{
+    lv_obj_set_hidden(send_btn, false);
+}
+
+void ui_show_sent_msg(void)
+{
+    lv_obj_set_hidden(mbox, false);
+}
+
+void ui_set_progress(int16_t value)
+{
+    lv_bar_set_value(timer_bar, value, LV_ANIM_ON);
+}
+
+void ui_add_sample(const lv_coord_t *values, const char *text)
+{
+    for (int i = 0; i < sensor_views[active_sensor].series_cnt; i++)
+    {
+        lv_chart_set_next(chart, series[active_sensor][i], values[i]);
+    }
+    lv_textarea_set_text(text_area, text);
+}
+
+ui_sensor_t ui_get_sensor_by_name(const char *name)
+{
+    int s;
+    for (s = 0; s < UI_SENSOR_NUM; s++)
+    {
+        if (strcmp(name, sensor_views[s].name) == 0)
+        {
+            break;
+        }
+    }
+    return (ui_sensor_t)s;
+}
+
+const char *ui_get_sensor_name(ui_sensor_t sensor)
+{
+    return sensor_views[sensor].name;
+}
+
+static void set_capture_hidden(bool hidden)
+{
+    lv_obj_set_hidden(timer_bar, hidden);
+    lv_obj_set_hidden(start_btn, hidden);
+    lv_obj_set_hidden(send_btn, hidden);
+    lv_obj_set_hidden(chart, hidden);
+    lv_obj_set_hidden(text_area, hidden);
+}